@@ -59,6 +59,15 @@
         //#define LV_MEM_POOL_ALLOC   your_alloc          /* Uncomment if using an external allocator*/
     #endif
 
+    /*Serve the small allocations from free lists of fixed size blocks (slabs) to keep the often created and deleted
+     *objects, styles, animations, timers and texts from fragmenting the pool.
+     *The blocks are reserved from the pool in `lv_mem_init()`. If a class is full the pool is used.*/
+    #define LV_MEM_SLAB 0
+    #if LV_MEM_SLAB
+        /*{block size [bytes], number of blocks} of the size classes in increasing block size*/
+        #define LV_MEM_SLAB_CLASSES {{16, 32}, {32, 32}, {48, 32}, {64, 16}, {128, 8}}
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
     #define LV_MEM_CUSTOM_ALLOC   malloc
@@ -66,9 +75,10 @@
     #define LV_MEM_CUSTOM_REALLOC realloc
 #endif     /*LV_MEM_CUSTOM*/
 
-/*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
- *You will see an error log message if there wasn't enough buffers. */
-#define LV_MEM_BUF_MAX_NUM 16
+/*Size of the scratch arena of each rendering thread for the temporal buffers of `lv_mem_buf_get()` [bytes].
+ *It's allocated once from the heap. The buffers which don't fit are allocated from the heap one by one.
+ *`lv_mem_buf_monitor()` tells the size really needed.*/
+#define LV_MEM_BUF_SIZE (2U * 1024U)
 
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
@@ -127,10 +137,66 @@
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Memory budget of the cached images in bytes: the memory allocated by the decoders (e.g. the decoded pixels)
+     *and about 100 bytes per image. Images which don't fit are opened for every draw.
+     *0: no limit, only the number of images is limited*/
+    #define LV_IMG_CACHE_MEM_SIZE 0
+#endif
+
+/*Decompress the whole image of the compressed color formats (`LV_IMG_CF_TRUE_COLOR_ALPHA_RLE/LZ4`) when it's opened.
+ *It needs `w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes per opened image but the image can be rotated and zoomed
+ *and it's decompressed only once while it's in the image cache.
+ *0: decompress only the lines being drawn (`w * lines per block` pixels per opened image)*/
+#define LV_IMG_DECOMPRESS_FULL 0
 
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Estimated cost of redrawing and flushing one more area (e.g. sending CASET/RASET and setting up the transfer)
+ *expressed in number of pixels. Invalidated areas are merged if redrawing them together is cheaper.
+ *0: merge only if the joined area is smaller than the two areas together*/
+#define LV_INV_AREA_OVERHEAD 256
+
+/*Skip drawing the objects which are fully covered by opaque objects above them.
+ *The results of the cover checks are cached in the objects until they are invalidated.*/
+#define LV_USE_OCCLUSION_CULLING 1
+
+/*Cache the style properties found in the styles of the objects (per part and state)
+ *to not search them in every style again and again while drawing.
+ *The cache of an object is cleared when its styles change and freed when it's deleted.*/
+#define LV_USE_OBJ_STYLE_CACHE 1
+#if LV_USE_OBJ_STYLE_CACHE
+    /*Number of cached properties per object. Must be a power of 2. An entry is 8 bytes on 32 bit systems.*/
+    #define LV_OBJ_STYLE_CACHE_SIZE 32
+
+    /*Memory used by the caches of all objects together [bytes]. No more caches are allocated above it.
+     *0: no limit*/
+    #define LV_OBJ_STYLE_CACHE_MEM_MAX (4U * 1024U)
+#endif
+
+/*Render the areas in horizontal tiles on more threads (e.g. on both cores of an ESP32).
+ *Everything which is modified while drawing (e.g. the mask list, `lv_mem_buf_get`) is thread local then.
+ *Event callbacks of drawing events have to be thread safe too.*/
+#define LV_USE_PARALLEL_RENDER 0
+#if LV_USE_PARALLEL_RENDER
+    /*Number of additional render threads. The thread calling `lv_timer_handler()` renders a tile too.*/
+    #define LV_PARALLEL_RENDER_WORKERS 1
+
+    /*Areas lower than twice of this are not split into tiles*/
+    #define LV_PARALLEL_RENDER_MIN_ROWS 8
+
+    /*Stack size of the render threads in bytes*/
+    #define LV_PARALLEL_RENDER_STACK_SIZE (8 * 1024)
+
+    /*Thread API to use: LV_OS_PTHREAD or LV_OS_FREERTOS*/
+    #define LV_PARALLEL_RENDER_OS LV_OS_PTHREAD
+#endif
+
+/*Blend with SSE2 or NEON instructions if the compiler supports them (with 16 and 32 bit colors).
+ *Otherwise more color channels are mixed in one integer.*/
+#define LV_USE_DRAW_SW_SIMD 1
+
 /*-------------
  * GPU
  *-----------*/
@@ -233,6 +299,23 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Measure the time of the refresh phases and draw operations in the last frames.
+ *See `lv_prof_get_frame()` and `lv_prof_dump()`*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+    /*Number of frames kept in the ring buffer*/
+    #define LV_PROFILER_FRAME_CNT 16
+
+    /*1: Use a custom counter to measure the time.
+     *Else the CPU cycle counter is used on ESP32, `clock_gettime()` on POSIX systems and `lv_tick_get()` otherwise*/
+    #define LV_PROFILER_TIME_CUSTOM 0
+    #if LV_PROFILER_TIME_CUSTOM
+        #define LV_PROFILER_TIME_CUSTOM_INCLUDE <stdint.h>      /*Header for the counter function*/
+        #define LV_PROFILER_TIME_CUSTOM_EXPR (my_cycle_cnt())   /*Expression evaluating to a free running uint32_t counter*/
+        #define LV_PROFILER_TIME_CUSTOM_FREQ 1000000            /*Frequency of the counter in Hz*/
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -347,6 +430,15 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Memory for the decompressed glyph bitmaps [bytes]. The least recently used glyphs are dropped above it.
+     *0: decompress the glyphs every time they are drawn*/
+    #define LV_FONT_BITMAP_CACHE_SIZE (8U * 1024U)
+#endif
+
+/*Number of code point -> glyph ID pairs cached by the fonts with sparse character maps (e.g. CJK fonts).
+ *Must be a power of 2 and at least 32. It's 4 bytes per entry in the cache of every font. 0: disable*/
+#define LV_FONT_GLYPH_ID_CACHE_SIZE 64
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -557,6 +649,12 @@
 
 /*PNG decoder library*/
 #define LV_USE_PNG 0
+#if LV_USE_PNG
+    /*1: Decode the rows when they are drawn. Needs the window of the inflater (max. 32 kB) and 2 rows
+     *instead of the whole file and 4 bytes per pixel but the images can't be rotated or zoomed.
+     *Can be changed with `lv_png_set_stream()`*/
+    #define LV_PNG_STREAM 1
+#endif
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -564,9 +662,24 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_SJPG 0
+#if LV_USE_SJPG
+    /*Memory of the decoded fragments of all JPG and SJPG images in bytes (allocated with `lv_mem_alloc()`).
+     *The least recently used fragments are freed to stay below it but the fragments read by the opened images are kept.
+     *0: keep only those fragments*/
+    #define LV_SJPG_CACHE_SIZE (32 * 1024)
+
+    /*1: Decode the next fragment of the SJPG variables in advance on an other thread (e.g. on the other core).
+     *Requires LV_USE_PARALLEL_RENDER*/
+    #define LV_SJPG_DECODE_AHEAD 0
+#endif
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
+#if LV_USE_GIF
+    /*Keep the LZW code table of the GIFs allocated instead of allocating it for every frame.
+     *Up to 16 kB per GIF (4 bytes per pixel for small GIFs)*/
+    #define LV_GIF_CACHE_DECODE_DATA 0
+#endif
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
@@ -609,6 +722,16 @@
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
 
+/*1: Draw the objects with `LV_OBJ_FLAG_LAYER_CACHE` and their children from an image
+ *which is rendered again only if something changes in them. Requires `LV_USE_SNAPSHOT`*/
+#define LV_USE_LAYER_CACHE 0
+#if LV_USE_LAYER_CACHE
+    /*Memory of the images of the layers in bytes (allocated with `lv_mem_alloc()`).
+     *The least recently drawn layers are dropped to stay below it. The layers which don't fit are drawn normally.
+     *Can be changed with `lv_layer_cache_set_size()`*/
+    #define LV_LAYER_CACHE_SIZE (16 * 1024)
+#endif
+
 /*==================
 * EXAMPLES
 *==================*/
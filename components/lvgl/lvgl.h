@@ -29,6 +29,7 @@ extern "C" {
 #include "src/misc/lv_async.h"
 #include "src/misc/lv_anim_timeline.h"
 #include "src/misc/lv_printf.h"
+#include "src/misc/lv_prof.h"
 
 #include "src/hal/lv_hal.h"
 
@@ -60,6 +61,7 @@ extern "C" {
 #include "src/widgets/lv_switch.h"
 
 #include "src/draw/lv_draw.h"
+#include "src/draw/sw/lv_draw_sw.h"
 
 #include "src/lv_api_map.h"
 
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+
+import argparse
+from argparse import RawTextHelpFormatter
+import os
+import re
+import sys
+
+# Must be the same as the LV_ANIMIMG_DELTA_OP_... values in src/extra/widgets/animimg/lv_animimg.h
+OP_COPY = 0
+OP_FILL = 1
+OP_SKIP = 2
+CNT_MAX = 0xFFFF
+
+parser = argparse.ArgumentParser(description="""Convert an image sequence of lv_img_dsc_t C files to an `lv_animimg_delta_dsc_t` for `lv_animimg_set_delta_src()`.
+The keyframes are stored as a whole, the other frames only with the area changed since the previous frame.
+The pixels are compressed with run-length encoding and the unchanged pixels of the changed area are skipped.
+The input files have to be created by LVGL's image converter with the same size and color format.
+Example: python animimg_delta_conv.py ../src/bmp/SPACE_{1..18}.c -n space_anim -o ../src/bmp/space_anim.c""", formatter_class=RawTextHelpFormatter)
+parser.add_argument('input',
+					nargs='+',
+					metavar='file',
+					help='The frames in the order of the animation')
+parser.add_argument('-n', '--name',
+					required=True,
+					metavar='name',
+					help='Name of the created variable')
+parser.add_argument('-o', '--output',
+					metavar='file',
+					help='Output file. Default: <name>.c')
+parser.add_argument('-k', '--keyframe',
+					type=int,
+					default=0,
+					metavar='interval',
+					help='Store every n-th frame as a keyframe to make seeking faster. Default: 0 (only the first frame)')
+
+args = parser.parse_args()
+
+def frame_load(path):
+	with open(path, 'r', encoding='utf-8') as f:
+		src = f.read()
+
+	dsc = re.search(r'const lv_img_dsc_t (\w+) = \{(.*?)\};', src, re.S)
+	if dsc is None:
+		print("No lv_img_dsc_t in " + path)
+		sys.exit(1)
+
+	fields = dsc.group(2)
+	w = int(re.search(r'\.header\.w = (\d+)', fields).group(1))
+	h = int(re.search(r'\.header\.h = (\d+)', fields).group(1))
+	cf = re.search(r'\.header\.cf = (\w+)', fields).group(1)
+
+	# The pixels of every color depth are in an `#if LV_COLOR_DEPTH ...` block
+	array = re.search(r'_map\[\] = \{(.*?)\n\};', src, re.S).group(1)
+	blocks = {}
+	for block in re.finditer(r'^(#if .*?)\n(.*?)^#endif', array, re.S | re.M):
+		body = re.sub(r'/\*.*?\*/', '', block.group(2), flags=re.S)
+		data = bytes(int(v, 0) for v in body.replace('\n', ' ').split(',') if v.strip())
+		if len(data) % (w * h):
+			print("Unexpected data size in " + path)
+			sys.exit(1)
+		blocks[block.group(1)] = data
+
+	return {'w': w, 'h': h, 'cf': cf, 'blocks': blocks}
+
+def changed_area(prev, act, w, h, px_size):
+	"""Bounding box (x, y, w, h) of the different pixels"""
+	x1, y1, x2, y2 = w, h, -1, -1
+	stride = w * px_size
+	for y in range(h):
+		row = y * stride
+		if prev[row:row + stride] == act[row:row + stride]: continue
+		y1 = min(y1, y)
+		y2 = y
+		for x in range(w):
+			p = row + x * px_size
+			if prev[p:p + px_size] != act[p:p + px_size]:
+				x1 = min(x1, x)
+				x2 = max(x2, x)
+	if y2 < 0: return (0, 0, 0, 0)
+	return (x1, y1, x2 - x1 + 1, y2 - y1 + 1)
+
+def op_add(out, op, cnt):
+	if cnt < 64:
+		out.append((op << 6) | cnt)
+	else:
+		out.extend([op << 6, cnt & 0xFF, cnt >> 8])
+
+def encode(act, prev, area, w, px_size):
+	"""Encode the pixels of `area` row by row. Pixels same as in `prev` are skipped if `prev` is given"""
+	ax, ay, aw, ah = area
+	px = []
+	for y in range(ay, ay + ah):
+		for x in range(ax, ax + aw):
+			p = (y * w + x) * px_size
+			px.append((act[p:p + px_size], prev[p:p + px_size] if prev else None))
+
+	out = bytearray()
+	i = 0
+	lit = []
+	def lit_flush():
+		while lit:
+			n = min(len(lit), CNT_MAX)
+			op_add(out, OP_COPY, n)
+			for v in lit[:n]: out.extend(v)
+			del lit[:n]
+
+	while i < len(px):
+		n = 1
+		if px[i][0] == px[i][1]:
+			while i + n < len(px) and n < CNT_MAX and px[i + n][0] == px[i + n][1]: n += 1
+			if n >= 2 or not lit:
+				lit_flush()
+				op_add(out, OP_SKIP, n)
+				i += n
+				continue
+		n = 1
+		while i + n < len(px) and n < CNT_MAX and px[i + n][0] == px[i][0]: n += 1
+		if n >= 3:
+			lit_flush()
+			op_add(out, OP_FILL, n)
+			out.extend(px[i][0])
+			i += n
+		else:
+			lit.append(px[i][0])
+			i += 1
+	lit_flush()
+	return out
+
+frames = [frame_load(p) for p in args.input]
+w = frames[0]['w']
+h = frames[0]['h']
+cf = frames[0]['cf']
+for p, f in zip(args.input, frames):
+	if f['w'] != w or f['h'] != h or f['cf'] != cf or f['blocks'].keys() != frames[0]['blocks'].keys():
+		print(p + " has a different size or color format than " + args.input[0])
+		sys.exit(1)
+
+name = args.name
+out = []
+out.append('#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+out.append('#if LV_USE_ANIMIMG\n\n')
+out.append('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n')
+attr = 'LV_ATTRIBUTE_IMG_' + name.upper()
+out.append('#ifndef ' + attr + '\n#define ' + attr + '\n#endif\n\n')
+out.append('/*Created by animimg_delta_conv.py from ' + os.path.basename(args.input[0]) + ' ... ' + os.path.basename(args.input[-1]) + '*/\n\n')
+
+for cond in frames[0]['blocks']:
+	data = bytearray()
+	table = []
+	frame_num = len(frames)
+	px_size = len(frames[0]['blocks'][cond]) // (w * h)
+	for i in range(frame_num):
+		act = frames[i]['blocks'][cond]
+		prev = frames[i - 1]['blocks'][cond]
+		# The area of the first frame is compared to the last to redraw only the changes when the animation repeats
+		area = changed_area(prev, act, w, h, px_size)
+		keyframe = i == 0 or (args.keyframe > 0 and i % args.keyframe == 0)
+		table.append((len(data), area, keyframe))
+		if keyframe: data += encode(act, None, (0, 0, w, h), w, px_size)
+		else: data += encode(act, prev, area, w, px_size)
+
+	out.append(cond + '\n')
+	out.append('static const LV_ATTRIBUTE_MEM_ALIGN ' + attr + ' uint8_t ' + name + '_data[] = {\n')
+	for i in range(0, len(data), 32):
+		out.append('  ' + ', '.join('0x%02x' % v for v in data[i:i + 32]) + ',\n')
+	out.append('};\n\n')
+	out.append('static const lv_animimg_delta_frame_t ' + name + '_frames[] = {\n')
+	for ofs, (x, y, fw, fh), keyframe in table:
+		out.append('  {.data_ofs = %d, .x = %d, .y = %d, .w = %d, .h = %d, .keyframe = %d},\n' % (ofs, x, y, fw, fh, keyframe))
+	out.append('};\n')
+	out.append('#endif\n')
+	print("%s: %d bytes (%d bytes uncompressed)" % (cond, len(data), len(frames) * w * h * px_size))
+
+out.append('\nconst lv_animimg_delta_dsc_t ' + name + ' = {\n')
+out.append('  .header.always_zero = 0,\n')
+out.append('  .header.w = %d,\n' % w)
+out.append('  .header.h = %d,\n' % h)
+out.append('  .header.cf = ' + cf + ',\n')
+out.append('  .frame_cnt = %d,\n' % len(frames))
+out.append('  .frames = ' + name + '_frames,\n')
+out.append('  .data_size = sizeof(' + name + '_data),\n')
+out.append('  .data = ' + name + '_data,\n')
+out.append('};\n\n')
+out.append('#endif /*LV_USE_ANIMIMG*/\n')
+
+with open(args.output if args.output else name + '.c', 'w', encoding='utf-8') as f:
+	f.write(''.join(out))
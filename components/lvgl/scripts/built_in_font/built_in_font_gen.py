@@ -40,6 +40,8 @@ parser.add_argument('--compressed', action='store_true',
 					help='Compress the bitmaps')
 parser.add_argument('--subpx', action='store_true',
 					help='3 times wider letters for sub pixel rendering')
+parser.add_argument('--cmap-index', action='store_true',
+					help='Index the sparse character maps to find the glyphs faster (for large CJK fonts)')
 
 args = parser.parse_args()
 
@@ -60,3 +62,6 @@ syms = "61441,61448,61451,61452,61452,61453,61457,61459,61461,61465,61468,61473,
 #Run the command (Add degree and bullet symbol)
 cmd = "lv_font_conv {} {} --bpp {} --size {} --font {} -r {} {} --font FontAwesome5-Solid+Brands+Regular.woff -r {} --format lvgl -o {} --force-fast-kern-format".format(subpx, compr, args.bpp, args.size, args.font, args.range[0], args.symbols[0], syms, args.output)
 os.system(cmd)
+
+if args.cmap_index:
+	os.system("python3 {} {}".format(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "font_cmap_index.py"), args.output))
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+
+import argparse
+from argparse import RawTextHelpFormatter
+import re
+import sys
+
+# Must be the same as LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT in src/font/lv_font_fmt_txt.h
+INDEX_SHIFT = 8
+
+parser = argparse.ArgumentParser(description="""Add a `unicode_list_index` to the sparse character maps of a font converted by lv_font_conv.
+With the index only the code points of a 256 wide range are searched when a glyph is looked up.
+It's useful for large CJK fonts. The index takes about 2 bytes per 256 code points of the character map.
+Example: python font_cmap_index.py ../src/font/lv_font_simsun_16_cjk.c""", formatter_class=RawTextHelpFormatter)
+parser.add_argument('input',
+					metavar = 'file',
+					help='A font .c file in LVGL\'s format. It is modified in place.')
+parser.add_argument('-o', '--output',
+					nargs='?',
+					metavar='file',
+					help='Write the result here instead of modifying the input')
+
+args = parser.parse_args()
+
+with open(args.input, 'r', encoding='utf-8') as f:
+	src = f.read()
+
+if 'unicode_list_index' in src:
+	print("The character maps of " + args.input + " are already indexed")
+	sys.exit(0)
+
+lists = {}
+for m in re.finditer(r'static const uint16_t (unicode_list_\d+)\[\] = \{(.*?)\};\n', src, re.S):
+	lists[m.group(1)] = (m.end(), [int(v, 0) for v in m.group(2).replace('\n', ' ').split(',') if v.strip()])
+
+cmaps = re.search(r'static const lv_font_fmt_txt_cmap_t cmaps\[\] =\s*\{(.*?)\n\};', src, re.S)
+if cmaps is None:
+	print("No character maps found in " + args.input)
+	sys.exit(1)
+
+# (start, end, new text) of the changes. They are applied from the end to keep the positions valid
+edits = []
+cmaps_src = cmaps.group(1)
+cmaps_new = cmaps_src
+for cmap in re.finditer(r'\{([^{}]*)\}', cmaps_src):
+	fields = cmap.group(1)
+	name = re.search(r'\.unicode_list = (\w+)', fields)
+	if name is None or name.group(1) not in lists: continue
+
+	name = name.group(1)
+	range_length = int(re.search(r'\.range_length = (\w+)', fields).group(1), 0)
+	list_end, codes = lists[name]
+
+	index = []
+	pos = 0
+	for b in range((range_length >> INDEX_SHIFT) + 2):
+		while pos < len(codes) and codes[pos] < (b << INDEX_SHIFT): pos += 1
+		index.append(pos)
+
+	index_name = name.replace('unicode_list_', 'unicode_list_index_')
+	lines = []
+	for i in range(0, len(index), 8):
+		lines.append('    ' + ', '.join(str(v) for v in index[i:i + 8]))
+	edits.append((list_end, list_end, '\n/*Number of `' + name + '` elements below every ' + str(1 << INDEX_SHIFT) + ' code points*/\n' +
+					'static const uint16_t ' + index_name + '[] = {\n' + ',\n'.join(lines) + '\n};\n'))
+
+	fields_new = re.sub(r'(\.type = \w+)', r'\1, .unicode_list_index = ' + index_name, fields)
+	cmaps_new = cmaps_new.replace(fields, fields_new, 1)
+
+if len(edits) == 0:
+	print("No sparse character maps in " + args.input)
+	sys.exit(0)
+
+edits.append((cmaps.start(1), cmaps.end(1), cmaps_new))
+for start, end, text in sorted(edits, reverse=True):
+	src = src[:start] + text + src[end:]
+
+with open(args.output if args.output else args.input, 'w', encoding='utf-8') as f:
+	f.write(src)
+
+print(str(len(edits) - 1) + " character map(s) indexed")
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+
+import argparse
+from argparse import RawTextHelpFormatter
+import os
+import re
+import struct
+import sys
+
+# Must be the same as LV_IMG_CF_TRUE_COLOR_ALPHA_RLE/LZ4 in src/draw/lv_img_buf.h
+CF = {'rle': 15, 'lz4': 16}
+RLE_CNT_MAX = 128
+LZ4_MIN_MATCH = 4
+LZ4_OFS_MAX = 0xFFFF
+LZ4_HASH_BITS = 12
+LZ4_CHAIN_MAX = 16
+
+BIN_DEPTHS = {
+	'8': '#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8',
+	'16': '#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0',
+	'16_swap': '#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP != 0',
+	'32': '#if LV_COLOR_DEPTH == 32',
+}
+
+parser = argparse.ArgumentParser(description="""Compress LV_IMG_CF_TRUE_COLOR_ALPHA lv_img_dsc_t C files to LV_IMG_CF_TRUE_COLOR_ALPHA_RLE or _LZ4.
+The lines are compressed in blocks so the built-in decoder can decompress only the lines being drawn.
+More lines per block compress better (LZ4 can refer to the previous lines) but need a larger buffer when drawing:
+`w * lines * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes.
+The input files have to be created by LVGL's image converter. All the color depths in them are compressed.
+Example: python img_compress_conv.py ../src/img/sunny.c ../src/img/rain.c -f lz4 -d out""", formatter_class=RawTextHelpFormatter)
+parser.add_argument('input',
+					nargs='+',
+					metavar='file',
+					help='The images to compress')
+parser.add_argument('-f', '--format',
+					choices=['rle', 'lz4'],
+					default='lz4',
+					help='Compression. Default: lz4')
+parser.add_argument('-l', '--lines',
+					type=int,
+					default=8,
+					metavar='lines',
+					help='Lines per block. Default: 8')
+parser.add_argument('-n', '--name',
+					metavar='name',
+					help='Name of the created variable if there is only one input. Default: <input>_<format>')
+parser.add_argument('-d', '--dir',
+					default='.',
+					metavar='dir',
+					help='Output directory. The files are named <name>.c. Default: current directory')
+parser.add_argument('-b', '--bin',
+					choices=BIN_DEPTHS.keys(),
+					metavar='depth',
+					help='Write a <name>.bin file for the file system with the given color depth (' + ', '.join(BIN_DEPTHS.keys()) + ') instead of a C file')
+
+args = parser.parse_args()
+
+if args.lines < 1 or args.lines > 0xFFFF:
+	print("The lines per block should be 1..65535")
+	sys.exit(1)
+
+if args.name and len(args.input) > 1:
+	print("--name can be used only with one input")
+	sys.exit(1)
+
+def img_load(path):
+	with open(path, 'r', encoding='utf-8') as f:
+		src = f.read()
+
+	dsc = re.search(r'const lv_img_dsc_t (\w+) = \{(.*?)\};', src, re.S)
+	if dsc is None:
+		print("No lv_img_dsc_t in " + path)
+		sys.exit(1)
+
+	fields = dsc.group(2)
+	w = int(re.search(r'\.header\.w = (\d+)', fields).group(1))
+	h = int(re.search(r'\.header\.h = (\d+)', fields).group(1))
+	cf = re.search(r'\.header\.cf = (\w+)', fields).group(1)
+	if cf != 'LV_IMG_CF_TRUE_COLOR_ALPHA':
+		print(path + " is " + cf + ", only LV_IMG_CF_TRUE_COLOR_ALPHA can be compressed")
+		sys.exit(1)
+
+	# The pixels of every color depth are in an `#if LV_COLOR_DEPTH ...` block
+	array = re.search(r'_map\[\] = \{(.*?)\n\};', src, re.S).group(1)
+	blocks = {}
+	for block in re.finditer(r'^(#if .*?)\n(.*?)^#endif', array, re.S | re.M):
+		body = re.sub(r'/\*.*?\*/', '', block.group(2), flags=re.S)
+		data = bytes(int(v, 0) for v in body.replace('\n', ' ').split(',') if v.strip())
+		if len(data) % (w * h):
+			print("Unexpected data size in " + path)
+			sys.exit(1)
+		blocks[block.group(1)] = data
+
+	return {'name': dsc.group(1), 'w': w, 'h': h, 'blocks': blocks}
+
+def rle_encode(data, px_size):
+	"""Runs of at least 2 same pixels are stored once, the other pixels as they are"""
+	px = [data[i:i + px_size] for i in range(0, len(data), px_size)]
+	out = bytearray()
+	i = 0
+	lit = 0
+	def lit_flush(end):
+		nonlocal lit
+		while lit:
+			n = min(lit, RLE_CNT_MAX)
+			out.append(n - 1)
+			for p in px[end - lit:end - lit + n]: out.extend(p)
+			lit -= n
+
+	while i < len(px):
+		n = 1
+		while i + n < len(px) and n < RLE_CNT_MAX and px[i + n] == px[i]: n += 1
+		if n >= 2:
+			lit_flush(i)
+			out.append(0x80 | (n - 1))
+			out.extend(px[i])
+			i += n
+		else:
+			lit += 1
+			i += 1
+	lit_flush(i)
+	return out
+
+def lz4_hash(data, i):
+	v = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | (data[i + 3] << 24)
+	return ((v * 2654435761) & 0xFFFFFFFF) >> (32 - LZ4_HASH_BITS)
+
+def lz4_len_add(out, n):
+	while n >= 255:
+		out.append(255)
+		n -= 255
+	out.append(n)
+
+def lz4_encode(data):
+	"""Greedy LZ4 block: the longest of the last LZ4_CHAIN_MAX positions with the same hash"""
+	n = len(data)
+	head = [-1] * (1 << LZ4_HASH_BITS)
+	prev = [-1] * n
+	out = bytearray()
+
+	def insert(i):
+		h = lz4_hash(data, i)
+		prev[i] = head[h]
+		head[h] = i
+
+	def seq_add(lit, match_len, ofs):
+		token = min(len(lit), 15) << 4
+		if match_len: token |= min(match_len - LZ4_MIN_MATCH, 15)
+		out.append(token)
+		if len(lit) >= 15: lz4_len_add(out, len(lit) - 15)
+		out.extend(lit)
+		if match_len:
+			out.extend([ofs & 0xFF, ofs >> 8])
+			if match_len - LZ4_MIN_MATCH >= 15: lz4_len_add(out, match_len - LZ4_MIN_MATCH - 15)
+
+	anchor = 0
+	i = 0
+	while i + LZ4_MIN_MATCH <= n:
+		best_len = 0
+		best_ofs = 0
+		c = head[lz4_hash(data, i)]
+		steps = 0
+		while c >= 0 and steps < LZ4_CHAIN_MAX and i - c <= LZ4_OFS_MAX:
+			l = 0
+			while i + l < n and data[c + l] == data[i + l]: l += 1
+			if l > best_len:
+				best_len = l
+				best_ofs = i - c
+			c = prev[c]
+			steps += 1
+
+		insert(i)
+		if best_len >= LZ4_MIN_MATCH:
+			seq_add(data[anchor:i], best_len, best_ofs)
+			for j in range(i + 1, min(i + best_len, n - LZ4_MIN_MATCH + 1)): insert(j)
+			i += best_len
+			anchor = i
+		else:
+			i += 1
+
+	seq_add(data[anchor:], 0, 0)
+	return out
+
+def compress(data, w, h, px_size):
+	"""The stream of the compressed color formats: lines per block, offsets of the blocks, blocks"""
+	block_size = w * args.lines * px_size
+	blocks = bytearray()
+	ofs = []
+	for i in range(0, len(data), block_size):
+		ofs.append(len(blocks))
+		if args.format == 'rle': blocks += rle_encode(data[i:i + block_size], px_size)
+		else: blocks += lz4_encode(data[i:i + block_size])
+	ofs.append(len(blocks))
+	return struct.pack('<HH', args.lines, 0) + struct.pack('<%dI' % len(ofs), *ofs) + blocks
+
+os.makedirs(args.dir, exist_ok=True)
+
+for path in args.input:
+	img = img_load(path)
+	w = img['w']
+	h = img['h']
+	name = args.name if args.name else img['name'] + '_' + args.format
+
+	if args.bin:
+		cond = BIN_DEPTHS[args.bin]
+		if cond not in img['blocks']:
+			print("No " + cond + " in " + path)
+			sys.exit(1)
+		data = img['blocks'][cond]
+		stream = compress(data, w, h, len(data) // (w * h))
+		header = CF[args.format] | (w << 10) | (h << 21)
+		with open(os.path.join(args.dir, name + '.bin'), 'wb') as f:
+			f.write(struct.pack('<I', header) + stream)
+		print("%s: %d bytes (%d bytes uncompressed)" % (name, len(stream), len(data)))
+		continue
+
+	attr = 'LV_ATTRIBUTE_IMG_' + name.upper()
+	out = []
+	out.append('#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+	out.append('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n')
+	out.append('#ifndef ' + attr + '\n#define ' + attr + '\n#endif\n\n')
+	out.append('/*Created by img_compress_conv.py from ' + os.path.basename(path) + ' with %d lines per block*/\n\n' % args.lines)
+	out.append('const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST ' + attr + ' uint8_t ' + name + '_map[] = {\n')
+	for cond, data in img['blocks'].items():
+		stream = compress(data, w, h, len(data) // (w * h))
+		out.append(cond + '\n')
+		for i in range(0, len(stream), 32):
+			out.append('  ' + ', '.join('0x%02x' % v for v in stream[i:i + 32]) + ',\n')
+		out.append('#endif\n')
+		print("%s %s: %d bytes (%d bytes uncompressed)" % (name, cond, len(stream), len(data)))
+	out.append('};\n\n')
+
+	out.append('const lv_img_dsc_t ' + name + ' = {\n')
+	out.append('  .header.always_zero = 0,\n')
+	out.append('  .header.w = %d,\n' % w)
+	out.append('  .header.h = %d,\n' % h)
+	out.append('  .data_size = sizeof(' + name + '_map),\n')
+	out.append('  .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA_' + args.format.upper() + ',\n')
+	out.append('  .data = ' + name + '_map,\n')
+	out.append('};\n')
+
+	with open(os.path.join(args.dir, name + '.c'), 'w', encoding='utf-8') as f:
+		f.write(''.join(out))
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+import argparse
+from argparse import RawTextHelpFormatter
+import os
+import re
+import struct
+import sys
+
+# Must be the same as LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT in src/draw/lv_img_buf.h
+CF_PREMULT = 17
+
+# The channels of the pixels of every color depth: (shift, bits) of red, green and blue in the color value
+# and the byte order of the color value
+DEPTHS = {
+	'#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8': {'bin': '8', 'size': 1, 'swap': False,
+		'ch': [(5, 3), (2, 3), (0, 2)]},
+	'#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0': {'bin': '16', 'size': 2, 'swap': False,
+		'ch': [(11, 5), (5, 6), (0, 5)]},
+	'#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP != 0': {'bin': '16_swap', 'size': 2, 'swap': True,
+		'ch': [(11, 5), (5, 6), (0, 5)]},
+	'#if LV_COLOR_DEPTH == 32': {'bin': '32', 'size': 3, 'swap': False,
+		'ch': [(16, 8), (8, 8), (0, 8)]},
+}
+
+parser = argparse.ArgumentParser(description="""Convert LV_IMG_CF_TRUE_COLOR_ALPHA lv_img_dsc_t C files to LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT.
+The color channels are multiplied by the alpha byte the same way as lv_img_buf_premultiply() does it,
+so the software renderer can blend the pixels with one multiplication per channel.
+The input files have to be created by LVGL's image converter. All the color depths in them are converted.
+Example: python img_premult_conv.py ../src/img/sunny.c ../src/img/rain.c -d out""", formatter_class=RawTextHelpFormatter)
+parser.add_argument('input',
+					nargs='+',
+					metavar='file',
+					help='The images to convert')
+parser.add_argument('-n', '--name',
+					metavar='name',
+					help='Name of the created variable if there is only one input. Default: <input>_premult')
+parser.add_argument('-d', '--dir',
+					default='.',
+					metavar='dir',
+					help='Output directory. The files are named <name>.c. Default: current directory')
+parser.add_argument('-b', '--bin',
+					choices=[d['bin'] for d in DEPTHS.values()],
+					metavar='depth',
+					help='Write a <name>.bin file for the file system with the given color depth (' + ', '.join(d['bin'] for d in DEPTHS.values()) + ') instead of a C file')
+
+args = parser.parse_args()
+
+if args.name and len(args.input) > 1:
+	print("--name can be used only with one input")
+	sys.exit(1)
+
+def img_load(path):
+	with open(path, 'r', encoding='utf-8') as f:
+		src = f.read()
+
+	dsc = re.search(r'const lv_img_dsc_t (\w+) = \{(.*?)\};', src, re.S)
+	if dsc is None:
+		print("No lv_img_dsc_t in " + path)
+		sys.exit(1)
+
+	fields = dsc.group(2)
+	w = int(re.search(r'\.header\.w = (\d+)', fields).group(1))
+	h = int(re.search(r'\.header\.h = (\d+)', fields).group(1))
+	cf = re.search(r'\.header\.cf = (\w+)', fields).group(1)
+	if cf != 'LV_IMG_CF_TRUE_COLOR_ALPHA':
+		print(path + " is " + cf + ", only LV_IMG_CF_TRUE_COLOR_ALPHA can be converted")
+		sys.exit(1)
+
+	# The pixels of every color depth are in an `#if LV_COLOR_DEPTH ...` block
+	array = re.search(r'_map\[\] = \{(.*?)\n\};', src, re.S).group(1)
+	blocks = {}
+	for block in re.finditer(r'^(#if .*?)\n(.*?)^#endif', array, re.S | re.M):
+		if block.group(1) not in DEPTHS:
+			print("Unknown color depth in " + path + ": " + block.group(1))
+			sys.exit(1)
+		body = re.sub(r'/\*.*?\*/', '', block.group(2), flags=re.S)
+		data = bytes(int(v, 0) for v in body.replace('\n', ' ').split(',') if v.strip())
+		if len(data) != w * h * (DEPTHS[block.group(1)]['size'] + 1):
+			print("Unexpected data size in " + path)
+			sys.exit(1)
+		blocks[block.group(1)] = data
+
+	return {'name': dsc.group(1), 'w': w, 'h': h, 'blocks': blocks}
+
+def udiv255(x):
+	"""The same as LV_UDIV255()"""
+	return (x * 0x8081) >> 23
+
+def premultiply(data, depth):
+	"""Multiply the channels like _lv_img_buf_premult_color(): (channel * alpha + 127) / 255"""
+	size = depth['size']
+	out = bytearray(data)
+	for i in range(0, len(data), size + 1):
+		a = data[i + size]
+		if a == 255: continue
+		px = data[i:i + size]
+		if depth['swap']: px = px[::-1]
+		c = int.from_bytes(px, 'little')
+		res = 0
+		for shift, bits in depth['ch']:
+			v = (c >> shift) & ((1 << bits) - 1)
+			res |= udiv255(v * a + 127) << shift
+		px = res.to_bytes(size, 'little')
+		if depth['swap']: px = px[::-1]
+		out[i:i + size] = px
+	return out
+
+os.makedirs(args.dir, exist_ok=True)
+
+for path in args.input:
+	img = img_load(path)
+	w = img['w']
+	h = img['h']
+	name = args.name if args.name else img['name'] + '_premult'
+
+	if args.bin:
+		cond = next((c for c, d in DEPTHS.items() if d['bin'] == args.bin), None)
+		if cond not in img['blocks']:
+			print("No " + cond + " in " + path)
+			sys.exit(1)
+		data = premultiply(img['blocks'][cond], DEPTHS[cond])
+		header = CF_PREMULT | (w << 10) | (h << 21)
+		with open(os.path.join(args.dir, name + '.bin'), 'wb') as f:
+			f.write(struct.pack('<I', header) + data)
+		print("%s: %d bytes" % (name, len(data)))
+		continue
+
+	attr = 'LV_ATTRIBUTE_IMG_' + name.upper()
+	out = []
+	out.append('#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+	out.append('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n')
+	out.append('#ifndef ' + attr + '\n#define ' + attr + '\n#endif\n\n')
+	out.append('/*Created by img_premult_conv.py from ' + os.path.basename(path) + '*/\n\n')
+	out.append('const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST ' + attr + ' uint8_t ' + name + '_map[] = {\n')
+	for cond, data in img['blocks'].items():
+		data = premultiply(data, DEPTHS[cond])
+		out.append(cond + '\n')
+		line = w * (DEPTHS[cond]['size'] + 1)
+		for i in range(0, len(data), line):
+			out.append('  ' + ', '.join('0x%02x' % v for v in data[i:i + line]) + ',\n')
+		out.append('#endif\n')
+	out.append('};\n\n')
+
+	out.append('const lv_img_dsc_t ' + name + ' = {\n')
+	out.append('  .header.always_zero = 0,\n')
+	out.append('  .header.w = %d,\n' % w)
+	out.append('  .header.h = %d,\n' % h)
+	out.append('  .data_size = %d * LV_IMG_PX_SIZE_ALPHA_BYTE,\n' % (w * h))
+	out.append('  .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT,\n')
+	out.append('  .data = ' + name + '_map,\n')
+	out.append('};\n')
+
+	with open(os.path.join(args.dir, name + '.c'), 'w', encoding='utf-8') as f:
+		f.write(''.join(out))
+	print("%s: %d pixels" % (name, w * h))
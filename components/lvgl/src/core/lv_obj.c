@@ -21,8 +21,10 @@
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../font/lv_font_fmt_txt.h"
 #include "../hal/lv_hal.h"
 #include "../extra/lv_extra.h"
+#include "../extra/others/layer_cache/lv_layer_cache.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -125,6 +127,7 @@ void lv_init(void)
 #endif
 
     _lv_obj_style_init();
+    _lv_font_fmt_txt_init();
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
@@ -222,6 +225,12 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     if(f & LV_OBJ_FLAG_HIDDEN) lv_obj_invalidate(obj);
 
     obj->flags |= f;
+#if LV_USE_OCCLUSION_CULLING
+    obj->cover_cache = 0;
+#endif
+#if LV_USE_LAYER_CACHE
+    if(f & LV_OBJ_FLAG_LAYER_CACHE) _lv_layer_cache_update_obj(obj);
+#endif
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
@@ -253,6 +262,12 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
     }
 
     obj->flags &= (~f);
+#if LV_USE_OCCLUSION_CULLING
+    obj->cover_cache = 0;
+#endif
+#if LV_USE_LAYER_CACHE
+    if(f & LV_OBJ_FLAG_LAYER_CACHE) _lv_layer_cache_update_obj(obj);
+#endif
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
@@ -433,6 +448,12 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+#if LV_USE_OBJ_STYLE_CACHE
+    _lv_obj_style_cache_free(obj);
+#endif
+#if LV_USE_LAYER_CACHE
+    _lv_layer_cache_remove_obj(obj);
+#endif
 
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
@@ -911,7 +932,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
         lv_obj_invalidate(obj);
     }
     else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_LAYOUT) {
-        lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
+        _lv_obj_refresh_style_state(obj);
     }
     else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD) {
         lv_obj_invalidate(obj);
@@ -105,6 +105,7 @@ enum {
     LV_OBJ_FLAG_ADV_HITTEST     = (1L << 15), /**< Allow performing more accurate hit (click) test. E.g. consider rounded corners.*/
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 16), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 17), /**< Do not scroll the object when the parent scrolls and ignore layout*/
+    LV_OBJ_FLAG_LAYER_CACHE     = (1L << 18), /**< Draw the object with its children from an image rendered when they change. Requires `LV_USE_LAYER_CACHE`*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -169,6 +170,12 @@ typedef struct _lv_obj_t {
     struct _lv_obj_t * parent;
     _lv_obj_spec_attr_t * spec_attr;
     _lv_obj_style_t * styles;
+#if LV_USE_OBJ_STYLE_CACHE
+    struct _lv_obj_style_cache_t * style_cache;     /**< Properties found in `styles`. Allocated on the first use*/
+#endif
+#if LV_USE_LAYER_CACHE
+    struct _lv_layer_cache_entry_t * layer_cache;   /**< The rendered image if `LV_OBJ_FLAG_LAYER_CACHE` is set*/
+#endif
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -181,6 +188,11 @@ typedef struct _lv_obj_t {
     uint16_t style_cnt  : 6;
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
+#if LV_USE_OCCLUSION_CULLING
+    uint16_t cover_cache : 2;   /**< 0: unknown; else `lv_cover_res_t` + 1 of the area inside the radius.
+                                     Reset when the object is invalidated.*/
+    uint16_t culled : 1;        /**< Covered by other objects in the area being refreshed*/
+#endif
 } lv_obj_t;
 
 
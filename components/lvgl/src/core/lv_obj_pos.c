@@ -10,15 +10,24 @@
 #include "lv_disp.h"
 #include "lv_refr.h"
 #include "../misc/lv_gc.h"
+#include "../extra/others/layer_cache/lv_layer_cache.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+/*At most this many areas are collected in an invalidation batch*/
+#define INV_BATCH_MAX 16
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    const lv_obj_t * obj;   /*Only to find the areas of the same object. It might be deleted meanwhile.*/
+    lv_disp_t * disp;
+    lv_area_t area;
+} inv_batch_area_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -26,11 +35,16 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void inv_batch_add(const lv_obj_t * obj, const lv_area_t * area);
+static void inv_batch_flush(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+static inv_batch_area_t inv_batch[INV_BATCH_MAX];
+static uint32_t inv_batch_cnt;
+static uint32_t inv_batch_depth;
 
 /**********************
  *      MACROS
@@ -796,11 +810,22 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_USE_OCCLUSION_CULLING
+    /*Something has changed on the object so check again if it covers its area*/
+    ((lv_obj_t *)obj)->cover_cache = 0;
+#endif
+#if LV_USE_LAYER_CACHE
+    /*Render the layers containing the object again*/
+    _lv_layer_cache_obj_changed(obj);
+#endif
+
     lv_area_t area_tmp;
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
+    if(!visible) return;
 
-    if(visible) _lv_inv_area(lv_obj_get_disp(obj), &area_tmp);
+    if(inv_batch_depth) inv_batch_add(obj, &area_tmp);
+    else _lv_inv_area(lv_obj_get_disp(obj), &area_tmp);
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
@@ -820,6 +845,19 @@ void lv_obj_invalidate(const lv_obj_t * obj)
 
 }
 
+void _lv_obj_inv_batch_begin(void)
+{
+    inv_batch_depth++;
+}
+
+void _lv_obj_inv_batch_end(void)
+{
+    if(inv_batch_depth == 0) return;
+
+    inv_batch_depth--;
+    if(inv_batch_depth == 0) inv_batch_flush();
+}
+
 bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
@@ -1096,3 +1134,48 @@ static void layout_update_core(lv_obj_t * obj)
         }
     }
 }
+
+/**
+ * Save an invalidated area of an object in the batch.
+ * Join it with the last area of the same object if the joined area is not larger than the two areas.
+ * @param obj       pointer to an object
+ * @param area      the visible part of the invalidated area
+ */
+static void inv_batch_add(const lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+
+    uint32_t i;
+    for(i = inv_batch_cnt; i > 0; i--) {
+        inv_batch_area_t * b = &inv_batch[i - 1];
+        if(b->obj != obj) continue;
+
+        lv_area_t joined;
+        _lv_area_join(&joined, &b->area, area);
+        if(lv_area_get_size(&joined) <= lv_area_get_size(&b->area) + lv_area_get_size(area)) {
+            b->area = joined;
+            if(disp) disp->inv_stats.batch_join_cnt++;
+            return;
+        }
+        break;
+    }
+
+    if(inv_batch_cnt == INV_BATCH_MAX) inv_batch_flush();
+
+    inv_batch[inv_batch_cnt].obj = obj;
+    inv_batch[inv_batch_cnt].disp = disp;
+    inv_batch[inv_batch_cnt].area = *area;
+    inv_batch_cnt++;
+}
+
+/**
+ * Add the areas of the batch to their displays
+ */
+static void inv_batch_flush(void)
+{
+    uint32_t i;
+    for(i = 0; i < inv_batch_cnt; i++) {
+        _lv_inv_area(inv_batch[i].disp, &inv_batch[i].area);
+    }
+    inv_batch_cnt = 0;
+}
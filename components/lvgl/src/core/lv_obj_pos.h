@@ -362,6 +362,18 @@ void lv_obj_invalidate_area(const struct _lv_obj_t * obj, const lv_area_t * area
  */
 void lv_obj_invalidate(const struct _lv_obj_t * obj);
 
+/**
+ * Collect the invalidated areas of the objects instead of adding them to the display one by one.
+ * The areas of the same object are joined if it's not more to redraw.
+ * Used by the animations to invalidate an object changed by more animations only once. Can be nested.
+ */
+void _lv_obj_inv_batch_begin(void);
+
+/**
+ * Add the areas collected since `_lv_obj_inv_batch_begin()` to the displays
+ */
+void _lv_obj_inv_batch_end(void);
+
 /**
  * Tell whether an area of an object is visible (even partially) now or not
  * @param obj       pointer to an object
@@ -9,12 +9,29 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_prof.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_USE_OBJ_STYLE_CACHE
+#if LV_OBJ_STYLE_CACHE_SIZE < 2 || (LV_OBJ_STYLE_CACHE_SIZE & (LV_OBJ_STYLE_CACHE_SIZE - 1)) != 0
+    #error "LV_OBJ_STYLE_CACHE_SIZE must be a power of 2"
+#endif
+
+/*Layout of the keys in the style cache: | valid (1) | found (1) | state (16) | part (4) | property ID (10) |*/
+#define STYLE_CACHE_KEY_VALID   0x80000000
+#define STYLE_CACHE_KEY_FOUND   0x40000000  /*The property is set in a style. Else the default value is used*/
+#define STYLE_CACHE_STATE_SHIFT 14
+#define STYLE_CACHE_PART_SHIFT  10
+#define STYLE_CACHE_PART_MASK   0xF
+#define STYLE_CACHE_ID_MASK     0x3FF
+
+#endif /*LV_USE_OBJ_STYLE_CACHE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +52,22 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_USE_OBJ_STYLE_CACHE
+typedef struct {
+    uint32_t key;
+    lv_style_value_t value;
+} style_cache_entry_t;
+
+/*The render threads read the caches while the others might store new properties in them.
+ *`seq` of a cache is a sequence lock: it's odd while the cache is written
+ *and the readers drop what they have read if `seq` has changed meanwhile.*/
+typedef struct _lv_obj_style_cache_t {
+    uint32_t seq;               /*Odd while the entries are written*/
+    uint32_t gen;               /*The entries are invalid if it's not `style_cache_gen`*/
+    style_cache_entry_t entries[LV_OBJ_STYLE_CACHE_SIZE];
+} style_cache_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,8 +78,15 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+#if LV_USE_OBJ_STYLE_CACHE
+    static bool get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+    static style_cache_t * style_cache_alloc(lv_obj_t * obj);
+    static void style_cache_store(style_cache_t * cache, uint32_t idx, uint32_t key, lv_style_value_t value);
+    static void style_cache_invalidate(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#endif
 static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part, lv_style_value_t v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
 static void trans_anim_cb(void * _tr, int32_t v);
@@ -60,6 +100,19 @@ static void fade_in_anim_ready(lv_anim_t * a);
  **********************/
 static bool style_refr = true;
 
+/*Set by `_lv_obj_style_set_state_override()`. Thread local as more threads might draw the same object.*/
+static LV_THREAD_LOCAL const lv_obj_t * state_ovr_obj;
+static LV_THREAD_LOCAL lv_state_t state_ovr;
+
+#if LV_USE_OBJ_STYLE_CACHE
+    static bool style_cache_en = true;
+    static uint32_t style_cache_gen;    /*Incremented to invalidate all caches*/
+    static uint32_t style_cache_mem;
+    static uint32_t style_cache_obj_cnt;
+    static LV_THREAD_LOCAL uint32_t style_cache_hit_cnt;
+    static LV_THREAD_LOCAL uint32_t style_cache_miss_cnt;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -152,7 +205,13 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
-    if(!style_refr) return;
+    if(!style_refr) {
+#if LV_USE_OBJ_STYLE_CACHE
+        /*The objects using the style are not visited, so drop every cached property*/
+        style_cache_gen++;
+#endif
+        return;
+    }
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -168,38 +227,21 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
-
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
-    if(prop & LV_STYLE_PROP_LAYOUT_REFR) {
-        if(part == LV_PART_ANY ||
-           part == LV_PART_MAIN ||
-           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
-           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
-            lv_event_send(obj, LV_EVENT_STYLE_CHANGED, NULL);
-            lv_obj_mark_layout_as_dirty(obj);
-        }
-    }
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY ||
-                                                         (prop & LV_STYLE_PROP_PARENT_LAYOUT_REFR))) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
-    }
+#if LV_USE_OBJ_STYLE_CACHE
+    /*Even if refreshing is disabled the cache has to follow the styles*/
+    style_cache_invalidate(obj, part, prop);
+#endif
 
-    if(prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_EXT_DRAW)) {
-        lv_obj_refresh_ext_draw_size(obj);
-    }
-    lv_obj_invalidate(obj);
+    refresh_style_core(obj, part, prop);
+}
 
-    if(prop == LV_STYLE_PROP_ANY ||
-       ((prop & LV_STYLE_PROP_INHERIT) && ((prop & LV_STYLE_PROP_EXT_DRAW) || (prop & LV_STYLE_PROP_LAYOUT_REFR)))) {
-        if(part != LV_PART_SCROLLBAR) {
-            refresh_children_style(obj);
-        }
-    }
+void _lv_obj_refresh_style_state(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    refresh_style_core(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
 }
 
 void lv_obj_enable_style_refresh(bool en)
@@ -207,8 +249,61 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+#if LV_USE_OBJ_STYLE_CACHE
+
+void lv_obj_enable_style_cache(bool en)
+{
+    /*The caches were not updated while disabled*/
+    if(en && !style_cache_en) style_cache_gen++;
+    style_cache_en = en;
+}
+
+void lv_obj_get_style_cache_stats(lv_obj_style_cache_stats_t * stats)
+{
+    stats->hit_cnt = style_cache_hit_cnt;
+    stats->miss_cnt = style_cache_miss_cnt;
+    stats->obj_cnt = style_cache_obj_cnt;
+    stats->mem_used = style_cache_mem;
+}
+
+void lv_obj_reset_style_cache_stats(void)
+{
+    style_cache_hit_cnt = 0;
+    style_cache_miss_cnt = 0;
+}
+
+void _lv_obj_style_cache_free(lv_obj_t * obj)
+{
+    if(obj->style_cache == NULL) return;
+
+    lv_mem_free(obj->style_cache);
+    obj->style_cache = NULL;
+    style_cache_mem -= sizeof(style_cache_t);
+    style_cache_obj_cnt--;
+}
+
+#if LV_USE_PARALLEL_RENDER
+void _lv_obj_style_cache_thread_take(lv_obj_style_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_obj_style_cache_stats_t));
+    stats->hit_cnt = style_cache_hit_cnt;
+    stats->miss_cnt = style_cache_miss_cnt;
+    style_cache_hit_cnt = 0;
+    style_cache_miss_cnt = 0;
+}
+
+void _lv_obj_style_cache_merge(const lv_obj_style_cache_stats_t * stats)
+{
+    style_cache_hit_cnt += stats->hit_cnt;
+    style_cache_miss_cnt += stats->miss_cnt;
+}
+#endif
+
+#endif /*LV_USE_OBJ_STYLE_CACHE*/
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
+    LV_PROF_BEGIN(prof);
     lv_style_value_t value_act;
     bool inherit = prop & LV_STYLE_PROP_INHERIT ? true : false;
     bool filter = prop & LV_STYLE_PROP_FILTER ? true : false;
@@ -217,7 +312,11 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     }
     bool found = false;
     while(obj) {
+#if LV_USE_OBJ_STYLE_CACHE
+        found = get_prop_cached(obj, part, prop, &value_act);
+#else
         found = get_prop_core(obj, part, prop, &value_act);
+#endif
         if(found) break;
         if(!inherit) break;
 
@@ -251,6 +350,7 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
         }
     }
     if(filter) value_act = apply_color_filter(obj, part, value_act);
+    LV_PROF_END(LV_PROF_STYLE, prof);
     return value_act;
 }
 
@@ -293,7 +393,17 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     /*The style is not found*/
     if(i == obj->style_cnt) return false;
 
-    return lv_style_remove_prop(obj->styles[i].style, prop);
+    bool removed = lv_style_remove_prop(obj->styles[i].style, prop);
+#if LV_USE_OBJ_STYLE_CACHE
+    if(removed) style_cache_invalidate(obj, lv_obj_style_get_selector_part(selector), prop);
+#endif
+    return removed;
+}
+
+void _lv_obj_style_set_state_override(const lv_obj_t * obj, lv_state_t state)
+{
+    state_ovr_obj = obj;
+    state_ovr = state;
 }
 
 void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t prev_state, lv_state_t new_state,
@@ -316,6 +426,9 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+#if LV_USE_OBJ_STYLE_CACHE
+    style_cache_invalidate(obj, part, tr_dsc->prop);
+#endif
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -539,9 +652,13 @@ static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t
     uint8_t group = 1 << _lv_style_get_prop_group(prop);
     int32_t weight = -1;
     lv_state_t state = obj->state;
+    bool skip_trans = obj->skip_trans;
+    if(obj == state_ovr_obj) {
+        state = state_ovr;
+        skip_trans = true;
+    }
     lv_state_t state_inv = ~state;
     lv_style_value_t value_tmp;
-    bool skip_trans = obj->skip_trans;
     uint32_t i;
     bool found;
     for(i = 0; i < obj->style_cnt; i++) {
@@ -596,6 +713,142 @@ static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t
     else return false;
 }
 
+#if LV_USE_OBJ_STYLE_CACHE
+
+/**
+ * Look up a property in the cache of the object and search it in the styles if it's not cached yet.
+ * The entries are keyed by the current state, so the cached values remain valid when the state changes.
+ * @param obj   pointer to an object
+ * @param part  the part of the object
+ * @param prop  the property to get
+ * @param v     store the value here if found
+ * @return      true: the property is set in a style; false: it's not set (the default or an inherited value is used)
+ */
+static bool get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
+{
+    /*When `skip_trans` is set or the state is overridden the transitions are ignored, so don't use the cache*/
+    if(!style_cache_en || obj->skip_trans || obj == state_ovr_obj) return get_prop_core(obj, part, prop, v);
+
+    uint32_t key = STYLE_CACHE_KEY_VALID | ((uint32_t)obj->state << STYLE_CACHE_STATE_SHIFT) |
+                   (((part >> 16) & STYLE_CACHE_PART_MASK) << STYLE_CACHE_PART_SHIFT) | (prop & STYLE_CACHE_ID_MASK);
+
+    /*Mix the state and the part into the bits of the property ID. The entry can be at `idx` or at `idx ^ 1`*/
+    uint32_t idx = (key ^ (key >> STYLE_CACHE_PART_SHIFT) ^ (key >> (STYLE_CACHE_STATE_SHIFT + 3))) &
+                   (LV_OBJ_STYLE_CACHE_SIZE - 1);
+
+    style_cache_t * cache = LV_ATOMIC_LOAD_ACQ(&obj->style_cache);
+    if(cache) {
+        uint32_t seq = LV_ATOMIC_LOAD_ACQ(&cache->seq);
+        if((seq & 1) == 0 && cache->gen == style_cache_gen) {
+            const style_cache_entry_t * e = &cache->entries[idx];
+            if((e->key & ~STYLE_CACHE_KEY_FOUND) != key) e = &cache->entries[idx ^ 1];
+            uint32_t e_key = e->key;
+            lv_style_value_t e_value = e->value;
+
+            /*Use the entry only if it wasn't modified while it was read*/
+            LV_ATOMIC_FENCE_ACQ();
+            if((e_key & ~STYLE_CACHE_KEY_FOUND) == key && LV_ATOMIC_LOAD(&cache->seq) == seq) {
+                style_cache_hit_cnt++;
+                if(e_key & STYLE_CACHE_KEY_FOUND) {
+                    *v = e_value;
+                    return true;
+                }
+                return false;
+            }
+        }
+    }
+
+    style_cache_miss_cnt++;
+    lv_style_value_t value;
+    bool found = get_prop_core(obj, part, prop, &value);
+    if(found) *v = value;
+    else value.num = 0;
+
+    if(cache == NULL) cache = style_cache_alloc((lv_obj_t *)obj);
+    if(cache) style_cache_store(cache, idx, found ? key | STYLE_CACHE_KEY_FOUND : key, value);
+
+    return found;
+}
+
+static style_cache_t * style_cache_alloc(lv_obj_t * obj)
+{
+#if LV_USE_PARALLEL_RENDER
+    /*Only the main thread allocates to not create more caches for the same object*/
+    if(lv_thread_is_worker()) return NULL;
+#endif
+
+    if(LV_OBJ_STYLE_CACHE_MEM_MAX && style_cache_mem + sizeof(style_cache_t) > LV_OBJ_STYLE_CACHE_MEM_MAX) return NULL;
+
+    style_cache_t * cache = lv_mem_alloc(sizeof(style_cache_t));
+    if(cache == NULL) return NULL;
+
+    lv_memset_00(cache, sizeof(style_cache_t));
+    cache->gen = style_cache_gen;
+    style_cache_mem += sizeof(style_cache_t);
+    style_cache_obj_cnt++;
+
+    /*Publish the cache only when it's initialized*/
+    LV_ATOMIC_STORE_REL(&obj->style_cache, cache);
+    return cache;
+}
+
+static void style_cache_store(style_cache_t * cache, uint32_t idx, uint32_t key, lv_style_value_t value)
+{
+    /*Don't wait if an other thread is writing the cache. The property will be stored next time.*/
+    uint32_t seq = LV_ATOMIC_LOAD(&cache->seq);
+    if(seq & 1) return;
+    if(!LV_ATOMIC_CAS(&cache->seq, &seq, seq + 1)) return;
+    LV_ATOMIC_FENCE_REL();
+
+    if(cache->gen != style_cache_gen) {
+        lv_memset_00(cache->entries, sizeof(cache->entries));
+        cache->gen = style_cache_gen;
+    }
+
+    /*Keep the entry at `idx` if the other place is free*/
+    if((cache->entries[idx].key & STYLE_CACHE_KEY_VALID) && (cache->entries[idx ^ 1].key & STYLE_CACHE_KEY_VALID) == 0) {
+        idx ^= 1;
+    }
+
+    cache->entries[idx].key = key;
+    cache->entries[idx].value = value;
+
+    LV_ATOMIC_STORE_REL(&cache->seq, seq + 2);
+}
+
+/**
+ * Remove the cached properties of an object which might have been changed.
+ * @param obj   pointer to an object
+ * @param part  the part whose style was changed or `LV_PART_ANY`
+ * @param prop  the changed property or `LV_STYLE_PROP_ANY`. `LV_STYLE_PROP_INV` also removes all properties.
+ */
+static void style_cache_invalidate(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    style_cache_t * cache = obj->style_cache;
+    if(cache == NULL) return;
+
+    /*The styles are not modified while rendering, but be sure no render thread is writing the cache*/
+    uint32_t seq = LV_ATOMIC_LOAD(&cache->seq);
+    while((seq & 1) || !LV_ATOMIC_CAS(&cache->seq, &seq, seq + 1)) {
+        seq = LV_ATOMIC_LOAD(&cache->seq);
+    }
+    LV_ATOMIC_FENCE_REL();
+
+    bool all_prop = prop == LV_STYLE_PROP_ANY || prop == LV_STYLE_PROP_INV;
+    uint32_t part_idx = (part >> 16) & STYLE_CACHE_PART_MASK;
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_CACHE_SIZE; i++) {
+        uint32_t key = cache->entries[i].key;
+        if(part != LV_PART_ANY && ((key >> STYLE_CACHE_PART_SHIFT) & STYLE_CACHE_PART_MASK) != part_idx) continue;
+        if(!all_prop && (key & STYLE_CACHE_ID_MASK) != (prop & STYLE_CACHE_ID_MASK)) continue;
+        cache->entries[i].key = 0;
+    }
+
+    LV_ATOMIC_STORE_REL(&cache->seq, seq + 2);
+}
+
+#endif /*LV_USE_OBJ_STYLE_CACHE*/
+
 static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part, lv_style_value_t v)
 {
     if(obj == NULL) return v;
@@ -607,6 +860,46 @@ static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part,
     return v;
 }
 
+/**
+ * Invalidate the object, update its layout and refresh its children after its style has changed.
+ * @param obj   pointer to an object
+ * @param part  the part whose style was changed or `LV_PART_ANY`
+ * @param prop  the changed property or `LV_STYLE_PROP_ANY`
+ */
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    if(!style_refr) return;
+
+    lv_obj_invalidate(obj);
+
+    if(prop & LV_STYLE_PROP_LAYOUT_REFR) {
+        if(part == LV_PART_ANY ||
+           part == LV_PART_MAIN ||
+           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
+           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
+            lv_event_send(obj, LV_EVENT_STYLE_CHANGED, NULL);
+            lv_obj_mark_layout_as_dirty(obj);
+        }
+    }
+    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY ||
+                                                         (prop & LV_STYLE_PROP_PARENT_LAYOUT_REFR))) {
+        lv_obj_t * parent = lv_obj_get_parent(obj);
+        if(parent) lv_obj_mark_layout_as_dirty(parent);
+    }
+
+    if(prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_EXT_DRAW)) {
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    lv_obj_invalidate(obj);
+
+    if(prop == LV_STYLE_PROP_ANY ||
+       ((prop & LV_STYLE_PROP_INHERIT) && ((prop & LV_STYLE_PROP_EXT_DRAW) || (prop & LV_STYLE_PROP_LAYOUT_REFR)))) {
+        if(part != LV_PART_SCROLLBAR) {
+            refresh_children_style(obj);
+        }
+    }
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -675,6 +968,9 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
             for(i = 0; i < obj->style_cnt; i++) {
                 if(obj->styles[i].is_trans && (part == LV_PART_ANY || obj->styles[i].selector == part)) {
                     lv_style_remove_prop(obj->styles[i].style, tr->prop);
+#if LV_USE_OBJ_STYLE_CACHE
+                    style_cache_invalidate(obj, lv_obj_style_get_selector_part(obj->styles[i].selector), tr->prop);
+#endif
                     lv_anim_del(tr, NULL);
                     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
                     lv_mem_free(tr);
@@ -769,6 +1065,9 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+#if LV_USE_OBJ_STYLE_CACHE
+    style_cache_invalidate(tr->obj, part, tr->prop);
+#endif
 
 }
 
@@ -799,6 +1098,9 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+#if LV_USE_OBJ_STYLE_CACHE
+                style_cache_invalidate(obj, lv_obj_style_get_selector_part(obj_style->selector), prop);
+#endif
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
@@ -54,6 +54,15 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_USE_OBJ_STYLE_CACHE
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of properties read from the caches*/
+    uint32_t miss_cnt;      /**< Number of properties searched in the styles*/
+    uint32_t obj_cnt;       /**< Number of objects having a cache*/
+    uint32_t mem_used;      /**< Memory used by the caches in bytes*/
+} lv_obj_style_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -111,6 +120,13 @@ void lv_obj_report_style_change(lv_style_t * style);
  */
 void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+/**
+ * Refresh an object after its state has changed. The same as `lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY)`
+ * but the styles are not changed, so the cached style properties (which are stored per state) are kept.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_refresh_style_state(struct _lv_obj_t * obj);
+
 /**
  * Enable or disable automatic style refreshing when a new style is added/removed to/from an object
  * or any other style change happens.
@@ -118,6 +134,49 @@ void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_
  */
 void lv_obj_enable_style_refresh(bool en);
 
+#if LV_USE_OBJ_STYLE_CACHE
+
+/**
+ * Enable or disable caching the style properties in the objects.
+ * The caches are cleared when it's enabled again.
+ * @param en        true: use the caches; false: always search the properties in the styles
+ */
+void lv_obj_enable_style_cache(bool en);
+
+/**
+ * Get the statistics of the style caches
+ * @param stats     store the statistics here
+ */
+void lv_obj_get_style_cache_stats(lv_obj_style_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the style caches
+ */
+void lv_obj_reset_style_cache_stats(void);
+
+/**
+ * Free the style cache of an object. Called when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_cache_free(struct _lv_obj_t * obj);
+
+#if LV_USE_PARALLEL_RENDER
+/**
+ * Move the hit and miss counters of the calling thread to `stats` and clear them.
+ * Used to hand over the counters of the render threads to the main thread.
+ * @param stats     pointer to a variable to store the counters
+ */
+void _lv_obj_style_cache_thread_take(lv_obj_style_cache_stats_t * stats);
+
+/**
+ * Add the hit and miss counters taken from an other thread to the counters of the calling thread
+ * @param stats     the counters of an other thread
+ */
+void _lv_obj_style_cache_merge(const lv_obj_style_cache_stats_t * stats);
+#endif
+
+#endif /*LV_USE_OBJ_STYLE_CACHE*/
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -163,6 +222,15 @@ bool lv_obj_remove_local_style_prop(struct _lv_obj_t * obj, lv_style_prop_t prop
 void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_state_t prev_state,
                                      lv_state_t new_state, const _lv_obj_style_transition_dsc_t * tr);
 
+/**
+ * Get the style properties of an object in an other state on the calling thread until it's called with `NULL`.
+ * The transitions are ignored meanwhile. Used to get the styles of the parts of a widget in their own state
+ * (e.g. the buttons of a button matrix) without changing the object, which other render threads might draw too.
+ * @param obj   pointer to an object or `NULL` to use the real state again
+ * @param state the state to use
+ */
+void _lv_obj_style_set_state_override(const struct _lv_obj_t * obj, lv_state_t state);
+
 /**
  * Used internally to compare the appearance of an object in 2 states
  * @param obj
@@ -16,7 +16,11 @@
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "../font/lv_font_fmt_txt.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_prof.h"
+#include "../extra/others/layer_cache/lv_layer_cache.h"
 
 #if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
     #include "../widgets/lv_label.h"
@@ -25,6 +29,23 @@
 /*********************
  *      DEFINES
  *********************/
+/*The rotation uses two buffers which share `LV_DISP_ROT_MAX_BUF`*/
+#define ROT_BUF_SIZE    (LV_DISP_ROT_MAX_BUF / 2)
+
+/*Size of the tiles (in pixels) in which the 90 and 270 degree rotation is done*/
+#define ROT_TILE_SIZE   16
+
+/*Max. number of objects per refreshed area which can be skipped if they are covered*/
+#define OCCLUSION_NODE_MAX      64
+
+/*Max. number of opaque areas collected per refreshed area*/
+#define OCCLUSION_OCCLUDER_MAX  16
+
+/*Max. number of area pieces to test when checking if an object is covered*/
+#define OCCLUSION_TEST_MAX      64
+
+/*If the invalidated areas overflow, an area is joined only with this many neighbours in the order of `y1`*/
+#define INV_OVERFLOW_NEIGHBOURS 4
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +56,10 @@ typedef struct {
     uint32_t    frame_cnt;
     uint32_t    fps_sum_cnt;
     uint32_t    fps_sum_all;
+#if LV_USE_OCCLUSION_CULLING
+    uint32_t    culled_sum;     /*Number of culled objects since the last update*/
+    uint32_t    refr_cnt;       /*Number of refreshes since the last update*/
+#endif
 #if LV_USE_LABEL
     lv_obj_t  * perf_label;
 #endif
@@ -47,17 +72,87 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_OCCLUSION_CULLING
+/*An object which is drawn in the area being refreshed*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;     /*The area where the object can draw in the refreshed area*/
+    uint32_t order;     /*Index of the object in the drawing order*/
+    uint32_t end;       /*Index of the first object after the children*/
+} refr_occl_node_t;
+
+/*An opaque area of an object*/
+typedef struct {
+    lv_area_t area;
+    uint32_t order;     /*Index of the object in the drawing order*/
+} refr_occluder_t;
+#endif
+
+#if LV_USE_PARALLEL_RENDER
+typedef enum {
+    REFR_JOB_DRAW,
+    REFR_JOB_CLEANUP,
+} refr_job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t start;     /*Signaled by the main thread when there is a new job*/
+    lv_thread_sync_t done;      /*Signaled by the worker when the job is ready*/
+    refr_job_t job;
+    lv_draw_ctx_t * draw_ctx;   /*Copy of the display's draw context with its own clip area*/
+    size_t draw_ctx_size;
+    lv_area_t clip_area;
+    bool dirty;                 /*Drew something since the last clean up*/
+#if LV_USE_PROFILER
+    lv_prof_frame_t prof;       /*Measurements of the last job*/
+#endif
+#if LV_USE_OBJ_STYLE_CACHE
+    lv_obj_style_cache_stats_t style_cache_stats;   /*Hits and misses of the last job*/
+#endif
+} refr_worker_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_refr_join_area(void);
+static void inv_area_add(lv_disp_t * disp, const lv_area_t * area_p);
+static bool inv_area_join_is_cheaper(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static uint32_t inv_area_join_waste(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static uint16_t inv_area_find(const lv_disp_t * disp, int32_t y1);
+static void inv_area_insert(lv_disp_t * disp, const lv_area_t * area_p);
+static void inv_area_remove(lv_disp_t * disp, uint16_t idx);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_part_draw(lv_draw_ctx_t * draw_ctx);
+#if LV_USE_PARALLEL_RENDER
+    static void parallel_render_init(void);
+    static bool refr_area_part_parallel(lv_draw_ctx_t * draw_ctx);
+    static void refr_workers_cleanup(void);
+    static void refr_worker_cb(void * user_data);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static lv_cover_res_t refr_cover_check(lv_obj_t * obj, const lv_area_t * area_p);
+#if LV_USE_OCCLUSION_CULLING
+    static void occlusion_cull(const lv_area_t * area_p);
+    static void occlusion_collect(lv_obj_t * obj, const lv_area_t * clip_p, const lv_area_t * occl_clip_p,
+                                  uint32_t * order);
+    static void occlusion_add_occluder(const lv_area_t * area_p, uint32_t order);
+    static bool occlusion_is_covered(const lv_area_t * area_p, uint32_t first, uint32_t * budget);
+    static void occlusion_clear(void);
+    static lv_cover_res_t cover_cache_update(lv_obj_t * obj, lv_area_t * core_p);
+    static bool get_cover_core(lv_obj_t * obj, lv_area_t * core_p);
+#endif
 static void lv_refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
+static void draw_buf_wait_act(lv_disp_t * disp);
+static void draw_buf_wait_flag(lv_disp_t * disp, volatile uint32_t * flushing);
+static void draw_buf_free_rot_bufs(lv_disp_t * disp);
+static void draw_buf_wait_flushing(lv_disp_t * disp, uint32_t max_cnt);
+static void draw_buf_flush_start(lv_disp_t * disp, volatile uint32_t * flushing, const lv_area_t * area,
+                                 lv_color_t * color_p);
+static void draw_buf_next(lv_disp_draw_buf_t * draw_buf);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
 #if LV_USE_PERF_MONITOR
@@ -81,6 +176,20 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_USE_OCCLUSION_CULLING
+    static refr_occl_node_t occl_nodes[OCCLUSION_NODE_MAX];
+    static uint32_t occl_node_cnt;
+    static refr_occluder_t occluders[OCCLUSION_OCCLUDER_MAX];
+    static uint32_t occluder_cnt;
+    static uint32_t culled_num;     /*Number of objects not drawn in the current refresh*/
+#endif
+
+#if LV_USE_PARALLEL_RENDER
+    static refr_worker_t refr_workers[LV_PARALLEL_RENDER_WORKERS];
+    static uint32_t refr_worker_cnt;     /*Number of successfully started workers*/
+    static bool parallel_render_en = true;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -105,6 +214,9 @@ void _lv_refr_init(void)
 #if LV_USE_MEM_MONITOR
     mem_monitor_init(&mem_monitor);
 #endif
+#if LV_USE_PARALLEL_RENDER
+    parallel_render_init();
+#endif
 }
 
 void lv_refr_now(lv_disp_t * disp)
@@ -129,6 +241,11 @@ void lv_refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+#if LV_USE_OCCLUSION_CULLING
+    /*Do not refresh the objects covered by others*/
+    if(obj->culled) return;
+#endif
+
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
     lv_area_t obj_coords_ext;
     lv_area_t obj_ext_clip_coords;
@@ -139,6 +256,14 @@ void lv_refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
     draw_ctx->clip_area = &obj_ext_clip_coords;
 
+#if LV_USE_LAYER_CACHE
+    /*Draw the object and its children from the cached image*/
+    if(_lv_layer_cache_draw(draw_ctx, obj)) {
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+#endif
+
     /*Redraw the object*/
     lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
     lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
@@ -203,6 +328,13 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         return;
     }
 
+    /*The areas are redrawn directly from `inv_areas` so they can't be modified while rendering.
+     *Anyway, everything invalidated during rendering would be cleared at the end of the refresh.*/
+    if(disp->rendering_in_progress) {
+        LV_LOG_WARN("detected modifying dirty areas in render");
+        return;
+    }
+
     lv_area_t scr_area;
     scr_area.x1 = 0;
     scr_area.y1 = 0;
@@ -215,6 +347,8 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     suc = _lv_area_intersect(&com_area, area_p, &scr_area);
     if(suc == false)  return; /*Out of the screen*/
 
+    disp->inv_stats.inv_px += lv_area_get_size(&com_area);
+
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->driver->full_refresh) {
         disp->inv_areas[0] = scr_area;
@@ -225,24 +359,60 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 
     if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
 
-    /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
-    for(i = 0; i < disp->inv_p; i++) {
-        if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
-    }
+    inv_area_add(disp, &com_area);
+    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+}
 
-    /*Save the area*/
-    if(disp->inv_p < LV_INV_BUF_SIZE) {
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+void lv_refr_get_inv_stats(lv_disp_t * disp, lv_disp_inv_stats_t * stats)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        lv_memset_00(stats, sizeof(lv_disp_inv_stats_t));
+        return;
     }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+
+    lv_memcpy(stats, &disp->inv_stats, sizeof(lv_disp_inv_stats_t));
+}
+
+void lv_refr_reset_inv_stats(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    lv_memset_00(&disp->inv_stats, sizeof(lv_disp_inv_stats_t));
+}
+
+void lv_refr_get_flush_stats(lv_disp_t * disp, lv_disp_flush_stats_t * stats)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        lv_memset_00(stats, sizeof(lv_disp_flush_stats_t));
+        return;
     }
-    disp->inv_p++;
-    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+
+    lv_memcpy(stats, &disp->flush_stats, sizeof(lv_disp_flush_stats_t));
 }
 
+void lv_refr_reset_flush_stats(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    lv_memset_00(&disp->flush_stats, sizeof(lv_disp_flush_stats_t));
+}
+
+#if LV_USE_PARALLEL_RENDER
+void lv_refr_set_parallel_render(bool en)
+{
+    parallel_render_en = en;
+}
+
+bool lv_refr_get_parallel_render(void)
+{
+    return parallel_render_en;
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -271,6 +441,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 {
     REFR_TRACE("begin");
 
+    LV_PROF_BEGIN(prof_frame);
     uint32_t start = lv_tick_get();
     volatile uint32_t elaps = 0;
 
@@ -289,23 +460,32 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 
     /*Refresh the screen's layout if required*/
+    LV_PROF_BEGIN(prof_layout);
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    LV_PROF_END(LV_PROF_LAYOUT, prof_layout);
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
+#if LV_USE_PROFILER
+        _lv_prof_frame_end(false);
+#endif
         return;
     }
 
-    lv_refr_join_area();
+#if LV_USE_PROFILER
+    bool prof_save = disp_refr->inv_p != 0;
+#endif
 
+    disp_refr->rendering_in_progress = 1;
     lv_refr_areas();
+    disp_refr->rendering_in_progress = 0;
 
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
@@ -313,9 +493,14 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
             draw_buf_flush(disp_refr);
         }
 
+        disp_refr->inv_stats.refr_px += px_num;
+        disp_refr->inv_stats.refr_area_cnt += disp_refr->inv_p;
+#if LV_USE_OCCLUSION_CULLING
+        disp_refr->inv_stats.culled_cnt += culled_num;
+#endif
+
         /*Clean up*/
         lv_memset_00(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-        lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
         elaps = lv_tick_elaps(start);
@@ -325,6 +510,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         }
     }
 
+    draw_buf_free_rot_bufs(disp_refr);
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
@@ -332,6 +518,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     _lv_draw_mask_cleanup();
 #endif
 
+#if LV_USE_PARALLEL_RENDER
+    refr_workers_cleanup();
+#endif
+
+    /*Keep the measurements only if something was redrawn*/
+    LV_PROF_END(LV_PROF_FRAME, prof_frame);
+#if LV_USE_PROFILER
+    _lv_prof_frame_end(prof_save);
+#endif
+
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
     if(perf_label == NULL) {
@@ -349,6 +545,13 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.perf_label = perf_label;
     }
 
+#if LV_USE_OCCLUSION_CULLING
+    if(px_num) {
+        perf_monitor.culled_sum += culled_num;
+        perf_monitor.refr_cnt++;
+    }
+#endif
+
     if(lv_tick_elaps(perf_monitor.perf_last_time) < 300) {
         if(px_num > 5000) {
             perf_monitor.elaps_sum += elaps;
@@ -378,7 +581,15 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.fps_sum_all += fps;
         perf_monitor.fps_sum_cnt ++;
         uint32_t cpu = 100 - lv_timer_get_idle();
+#if LV_USE_OCCLUSION_CULLING
+        /*Average number of not drawn objects per refresh*/
+        uint32_t culled = perf_monitor.refr_cnt ? perf_monitor.culled_sum / perf_monitor.refr_cnt : 0;
+        perf_monitor.culled_sum = 0;
+        perf_monitor.refr_cnt = 0;
+        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU\n%"LV_PRIu32" culled", fps, cpu, culled);
+#else
         lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+#endif
     }
 #endif
 
@@ -436,74 +647,206 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Save an area among the invalidated areas.
+ * The saved areas are always kept merged: an area is joined with the others as long as
+ * redrawing them together is cheaper than redrawing them separately.
+ * The areas are sorted by `y1` so only the areas in the rows around the new area are tested:
+ * if there are `g` rows between two areas, their union has at least `g * width` needless pixels,
+ * so it can't be cheaper if `g >= LV_INV_AREA_OVERHEAD / width`.
+ * If there is no free place the two closest neighbours are merged instead of invalidating the whole screen.
+ * @param disp pointer to a display
+ * @param area_p pointer to the area to save (already clipped to the screen and rounded)
  */
-static void lv_refr_join_area(void)
+static void inv_area_add(lv_disp_t * disp, const lv_area_t * area_p)
 {
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
+    lv_area_t area;
+    lv_area_copy(&area, area_p);
+
+    /*The tallest saved area tells how far above the new area a saved one can start and still be close.
+     *Removing areas can only make it smaller so it's enough to measure it once.*/
+    int32_t h_max = 0;
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        h_max = LV_MAX(h_max, lv_area_get_height(&disp->inv_areas[i]));
+    }
+
+    while(1) {
+        /*Absorb every close saved area which is cheaper to redraw together with the new one.
+         *The new area can grow on every join so search its rows again after it.*/
+        bool joined = true;
+        while(joined) {
+            joined = false;
+            int32_t reach = (LV_INV_AREA_OVERHEAD + lv_area_get_width(&area) - 1) / lv_area_get_width(&area);
+            for(i = inv_area_find(disp, area.y1 - reach - h_max + 1); i < disp->inv_p; i++) {
+                if(disp->inv_areas[i].y1 > area.y2 + reach) break;
+                if(inv_area_join_is_cheaper(&area, &disp->inv_areas[i])) {
+                    _lv_area_join(&area, &area, &disp->inv_areas[i]);
+                    inv_area_remove(disp, i);
+                    disp->inv_stats.merge_cnt++;
+                    joined = true;
+                    break;
+                }
             }
+        }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+        if(disp->inv_p < LV_INV_BUF_SIZE) break;
+
+        /*No free place: join the pair of neighbours which wastes the least pixels.
+         *`LV_INV_BUF_SIZE` means the new area itself.*/
+        uint16_t best_a = 0;
+        uint16_t best_b = LV_INV_BUF_SIZE;
+        uint32_t best_waste = UINT32_MAX;
+        uint16_t pos = inv_area_find(disp, area.y1);
+        uint16_t j;
+        for(i = pos > INV_OVERFLOW_NEIGHBOURS ? pos - INV_OVERFLOW_NEIGHBOURS : 0;
+            i < disp->inv_p && i < pos + INV_OVERFLOW_NEIGHBOURS; i++) {
+            uint32_t waste = inv_area_join_waste(&disp->inv_areas[i], &area);
+            if(waste < best_waste) {
+                best_waste = waste;
+                best_a = i;
             }
+        }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+        for(i = 0; i < disp->inv_p; i++) {
+            for(j = i + 1; j < disp->inv_p && j <= i + INV_OVERFLOW_NEIGHBOURS; j++) {
+                uint32_t waste = inv_area_join_waste(&disp->inv_areas[i], &disp->inv_areas[j]);
+                if(waste < best_waste) {
+                    best_waste = waste;
+                    best_a = i;
+                    best_b = j;
+                }
+            }
+        }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+        disp->inv_stats.overflow_cnt++;
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
+        if(best_b == LV_INV_BUF_SIZE) {
+            _lv_area_join(&area, &area, &disp->inv_areas[best_a]);
+            inv_area_remove(disp, best_a);
+        }
+        else {
+            /*Save the new area in place of the joined ones and continue with the joined area
+             *as it might be cheaper to join with others now*/
+            lv_area_t joined_area;
+            _lv_area_join(&joined_area, &disp->inv_areas[best_a], &disp->inv_areas[best_b]);
+            inv_area_remove(disp, best_b);  /*best_b > best_a so remove it first*/
+            inv_area_remove(disp, best_a);
+            inv_area_insert(disp, &area);
+            h_max = LV_MAX(h_max, lv_area_get_height(&area));
+            lv_area_copy(&area, &joined_area);
         }
     }
+
+    inv_area_insert(disp, &area);
 }
 
 /**
- * Refresh the joined areas
+ * Tell if it's cheaper to redraw two areas as one.
+ * Redrawing an area costs its pixels plus `LV_INV_AREA_OVERHEAD` (flush command, transfer setup, etc).
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an other area
+ * @return true: the joined area is cheaper to redraw
+ */
+static bool inv_area_join_is_cheaper(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined;
+    _lv_area_join(&joined, a1_p, a2_p);
+    return lv_area_get_size(&joined) < lv_area_get_size(a1_p) + lv_area_get_size(a2_p) + LV_INV_AREA_OVERHEAD;
+}
+
+/**
+ * Get the number of pixels which would be redrawn needlessly if two areas were joined.
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an other area
+ * @return the number of extra pixels in the joined area (0 if the areas cover it)
+ */
+static uint32_t inv_area_join_waste(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined;
+    _lv_area_join(&joined, a1_p, a2_p);
+    uint32_t joined_size = lv_area_get_size(&joined);
+    uint32_t sum_size = lv_area_get_size(a1_p) + lv_area_get_size(a2_p);
+    return joined_size > sum_size ? joined_size - sum_size : 0;
+}
+
+/**
+ * Find the first saved area whose `y1` is not less than a value.
+ * @param disp pointer to a display
+ * @param y1 the `y1` coordinate to look for
+ * @return index of the area or `disp->inv_p` if all areas start above `y1`
+ */
+static uint16_t inv_area_find(const lv_disp_t * disp, int32_t y1)
+{
+    uint16_t lo = 0;
+    uint16_t hi = disp->inv_p;
+    while(lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if(disp->inv_areas[mid].y1 < y1) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Save an area among the invalidated areas keeping them sorted by `y1`. There must be a free place.
+ * @param disp pointer to a display
+ * @param area_p pointer to the area to save
+ */
+static void inv_area_insert(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    uint16_t idx = inv_area_find(disp, area_p->y1);
+    uint16_t i;
+    for(i = disp->inv_p; i > idx; i--) {
+        lv_area_copy(&disp->inv_areas[i], &disp->inv_areas[i - 1]);
+    }
+    lv_area_copy(&disp->inv_areas[idx], area_p);
+    disp->inv_p++;
+}
+
+/**
+ * Remove an invalidated area keeping the others sorted.
+ * @param disp pointer to a display
+ * @param idx index of the area to remove
+ */
+static void inv_area_remove(lv_disp_t * disp, uint16_t idx)
+{
+    disp->inv_p--;
+    uint16_t i;
+    for(i = idx; i < disp->inv_p; i++) {
+        lv_area_copy(&disp->inv_areas[i], &disp->inv_areas[i + 1]);
+    }
+}
+
+/**
+ * Refresh the invalidated areas
  */
 static void lv_refr_areas(void)
 {
     px_num = 0;
+#if LV_USE_OCCLUSION_CULLING
+    culled_num = 0;
+#endif
 
     if(disp_refr->inv_p == 0) return;
 
-    /*Find the last area which will be drawn*/
+#if LV_USE_LAYER_CACHE
+    /*Render the changed layers before drawing as they are only read while drawing*/
+    _lv_layer_cache_prepare(disp_refr);
+#endif
+
+    /*The areas are already merged so simply draw all of them*/
     int32_t i;
-    int32_t last_i = 0;
-    for(i = disp_refr->inv_p - 1; i >= 0; i--) {
-        if(disp_refr->inv_area_joined[i] == 0) {
-            last_i = i;
-            break;
-        }
-    }
+    int32_t last_i = disp_refr->inv_p - 1;
 
     disp_refr->driver->draw_buf->last_area = 0;
     disp_refr->driver->draw_buf->last_part = 0;
 
     for(i = 0; i < disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i] == 0) {
-
-            if(i == last_i) disp_refr->driver->draw_buf->last_area = 1;
-            disp_refr->driver->draw_buf->last_part = 0;
-            lv_refr_area(&disp_refr->inv_areas[i]);
+        if(i == last_i) disp_refr->driver->draw_buf->last_area = 1;
+        disp_refr->driver->draw_buf->last_part = 0;
+        lv_refr_area(&disp_refr->inv_areas[i]);
 
-            px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
-        }
+        px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
     }
 }
 
@@ -580,23 +923,47 @@ static void lv_refr_area(const lv_area_t * area_p)
 
 static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
 {
-    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
-
     /* Below the `area_p` area will be redrawn into the draw buffer.
-     * In single buffered mode wait here until the buffer is freed.*/
-    if(draw_buf->buf1 && !draw_buf->buf2) {
-        while(draw_buf->flushing) {
-            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-        }
+     * Wait here until the buffer is freed (typically in single buffered mode or if all buffers of the ring are flushed).*/
+    draw_buf_wait_act(disp_refr);
+
+#if LV_USE_OCCLUSION_CULLING
+    /*Mark the covered objects before drawing. The helper threads only read the marks.*/
+    occlusion_cull(draw_ctx->clip_area);
+#endif
+
+    LV_PROF_BEGIN(prof_render);
+#if LV_USE_PARALLEL_RENDER
+    if(!refr_area_part_parallel(draw_ctx)) refr_area_part_draw(draw_ctx);
+#else
+    refr_area_part_draw(draw_ctx);
+#endif
+    LV_PROF_END(LV_PROF_RENDER, prof_render);
+
+#if LV_USE_OCCLUSION_CULLING
+    occlusion_clear();
+#endif
+
+    /*In true double buffered mode flush only once when all areas were rendered.
+     *In normal mode flush after every area*/
+    if(disp_refr->driver->full_refresh == false) {
+        draw_buf_flush(disp_refr);
     }
+}
 
+/**
+ * Draw the screens and layers in the clip area of a draw context
+ * @param draw_ctx pointer to a draw context. Its `clip_area` is redrawn.
+ */
+static void refr_area_part_draw(lv_draw_ctx_t * draw_ctx)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top_act_scr = lv_refr_get_top_obj(draw_ctx->clip_area, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        top_prev_scr = lv_refr_get_top_obj(draw_ctx->clip_area, disp_refr->prev_scr);
     }
 
     /*Draw a display background if there is no top object*/
@@ -608,7 +975,7 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
             dsc.bg_img_opa = disp_refr->bg_opa;
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
-            draw_ctx->draw_bg(draw_ctx, &dsc, draw_ctx->buf_area);
+            draw_ctx->draw_bg(draw_ctx, &dsc, draw_ctx->clip_area);
         }
         else if(disp_refr->bg_img) {
             lv_img_header_t header;
@@ -631,7 +998,7 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
             lv_draw_rect_dsc_init(&dsc);
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
-            lv_draw_rect(draw_ctx, &dsc, draw_ctx->buf_area);
+            lv_draw_rect(draw_ctx, &dsc, draw_ctx->clip_area);
         }
     }
     /*Refresh the previous screen if any*/
@@ -647,13 +1014,158 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
 
-    /*In true double buffered mode flush only once when all areas were rendered.
-     *In normal mode flush after every area*/
-    if(disp_refr->driver->full_refresh == false) {
-        draw_buf_flush(disp_refr);
+    /*All the temporal buffers of drawing should be released here.
+     *Reset the scratch arena of the thread so that a forgotten buffer doesn't remain there.*/
+    lv_mem_buf_free_all();
+}
+
+#if LV_USE_PARALLEL_RENDER
+
+static void parallel_render_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_PARALLEL_RENDER_WORKERS; i++) {
+        refr_worker_t * w = &refr_workers[refr_worker_cnt];
+        lv_memset_00(w, sizeof(refr_worker_t));
+        if(lv_thread_sync_init(&w->start) != LV_RES_OK) break;
+        if(lv_thread_sync_init(&w->done) != LV_RES_OK) break;
+        if(lv_thread_init(&w->thread, refr_worker_cb, LV_PARALLEL_RENDER_STACK_SIZE, w) != LV_RES_OK) break;
+        refr_worker_cnt++;
+    }
+
+    if(refr_worker_cnt < LV_PARALLEL_RENDER_WORKERS) {
+        LV_LOG_WARN("only %d of %d render threads could be started", (int)refr_worker_cnt, LV_PARALLEL_RENDER_WORKERS);
     }
 }
 
+/**
+ * Split the clip area of a draw context into horizontal bands and draw them on the helper threads
+ * and on the calling thread at the same time. All bands are ready when the function returns.
+ * @param draw_ctx pointer to the display's draw context
+ * @return true: the area was drawn; false: the area can't be split, draw it normally
+ */
+static bool refr_area_part_parallel(lv_draw_ctx_t * draw_ctx)
+{
+    if(!parallel_render_en || refr_worker_cnt == 0) return false;
+
+    /*The helper threads share the draw buffer so only the software renderer can be used*/
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(drv->draw_ctx_init != lv_draw_sw_init_ctx) return false;
+
+    const lv_area_t * clip_ori = draw_ctx->clip_area;
+    lv_coord_t h = lv_area_get_height(clip_ori);
+    uint32_t tile_cnt = LV_MIN(refr_worker_cnt + 1, (uint32_t)(h / LV_PARALLEL_RENDER_MIN_ROWS));
+    if(tile_cnt < 2) return false;
+
+    /*Prepare the draw contexts of the workers. The tiles of the workers are below the first one*/
+    lv_coord_t tile_h = h / tile_cnt;
+    lv_coord_t y = clip_ori->y1 + tile_h;
+    uint32_t i;
+    for(i = 0; i < tile_cnt - 1; i++) {
+        refr_worker_t * w = &refr_workers[i];
+        if(w->draw_ctx_size < drv->draw_ctx_size) {
+            lv_mem_free(w->draw_ctx);
+            w->draw_ctx = lv_mem_alloc(drv->draw_ctx_size);
+            LV_ASSERT_MALLOC(w->draw_ctx);
+            w->draw_ctx_size = w->draw_ctx ? drv->draw_ctx_size : 0;
+            if(w->draw_ctx == NULL) break;
+        }
+
+        /*Copy the display's context to use the same buffer and callbacks*/
+        lv_memcpy(w->draw_ctx, draw_ctx, drv->draw_ctx_size);
+        w->clip_area.x1 = clip_ori->x1;
+        w->clip_area.x2 = clip_ori->x2;
+        w->clip_area.y1 = y;
+        w->clip_area.y2 = i == tile_cnt - 2 ? clip_ori->y2 : y + tile_h - 1;
+        w->draw_ctx->clip_area = &w->clip_area;
+        y += tile_h;
+    }
+
+    /*Not enough memory for the contexts. Continue with less workers*/
+    uint32_t started_cnt = i;
+    if(started_cnt < tile_cnt - 1) {
+        if(started_cnt == 0) return false;
+        refr_workers[started_cnt - 1].clip_area.y2 = clip_ori->y2;
+    }
+
+    for(i = 0; i < started_cnt; i++) {
+        refr_workers[i].job = REFR_JOB_DRAW;
+        refr_workers[i].dirty = true;
+        lv_thread_sync_signal(&refr_workers[i].start);
+    }
+
+    /*Draw the first tile meanwhile*/
+    lv_area_t clip_first;
+    lv_area_copy(&clip_first, clip_ori);
+    clip_first.y2 = clip_ori->y1 + tile_h - 1;
+    draw_ctx->clip_area = &clip_first;
+    refr_area_part_draw(draw_ctx);
+    draw_ctx->clip_area = clip_ori;
+
+    /*The buffer can be flushed only if all tiles are ready*/
+    for(i = 0; i < started_cnt; i++) {
+        lv_thread_sync_wait(&refr_workers[i].done);
+#if LV_USE_PROFILER
+        _lv_prof_merge(&refr_workers[i].prof);
+#endif
+#if LV_USE_OBJ_STYLE_CACHE
+        _lv_obj_style_cache_merge(&refr_workers[i].style_cache_stats);
+#endif
+    }
+
+    return true;
+}
+
+/**
+ * Free the temporal buffers of the workers (like the main thread does it at the end of a refresh)
+ */
+static void refr_workers_cleanup(void)
+{
+    uint32_t i;
+    for(i = 0; i < refr_worker_cnt; i++) {
+        if(!refr_workers[i].dirty) continue;
+        refr_workers[i].job = REFR_JOB_CLEANUP;
+        lv_thread_sync_signal(&refr_workers[i].start);
+    }
+
+    for(i = 0; i < refr_worker_cnt; i++) {
+        if(!refr_workers[i].dirty) continue;
+        lv_thread_sync_wait(&refr_workers[i].done);
+        refr_workers[i].dirty = false;
+    }
+}
+
+static void refr_worker_cb(void * user_data)
+{
+    refr_worker_t * w = user_data;
+    while(1) {
+        lv_thread_sync_wait(&w->start);
+
+        if(w->job == REFR_JOB_DRAW) {
+            refr_area_part_draw(w->draw_ctx);
+            if(w->draw_ctx->wait_for_finish) w->draw_ctx->wait_for_finish(w->draw_ctx);
+#if LV_USE_PROFILER
+            /*Handed over to the main thread as the measurements are thread local*/
+            _lv_prof_thread_take(&w->prof);
+#endif
+#if LV_USE_OBJ_STYLE_CACHE
+            _lv_obj_style_cache_thread_take(&w->style_cache_stats);
+#endif
+        }
+        else {
+            lv_mem_buf_free_all();
+            _lv_font_clean_up_fmt_txt();
+#if LV_DRAW_COMPLEX
+            _lv_draw_mask_cleanup();
+#endif
+        }
+
+        lv_thread_sync_signal(&w->done);
+    }
+}
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -666,14 +1178,15 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
     /*If this object is fully cover the draw area check the children too*/
     if(_lv_area_is_in(area_p, &obj->coords, 0) && lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == false) {
-        lv_cover_check_info_t info;
-        info.res = LV_COVER_RES_COVER;
-        info.area = area_p;
-        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
-        if(info.res == LV_COVER_RES_MASKED) return NULL;
+        lv_cover_res_t res = refr_cover_check(obj, area_p);
+        if(res == LV_COVER_RES_MASKED) return NULL;
 
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+#if LV_USE_LAYER_CACHE
+        /*Don't start drawing inside a cached layer as the layer is drawn as a whole*/
+        if(_lv_layer_cache_is_ready(obj)) child_cnt = 0;
+#endif
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
             found_p = lv_refr_get_top_obj(area_p, child);
@@ -686,7 +1199,7 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
         /*If no better children use this object*/
         if(found_p == NULL) {
-            if(info.res == LV_COVER_RES_COVER) {
+            if(res == LV_COVER_RES_COVER) {
                 found_p = obj;
             }
         }
@@ -695,6 +1208,33 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     return found_p;
 }
 
+/**
+ * Check if an object covers an area. Use the cached result of the object if possible.
+ * @param obj       pointer to an object
+ * @param area_p    the area to check
+ * @return          the result of the cover check
+ */
+static lv_cover_res_t refr_cover_check(lv_obj_t * obj, const lv_area_t * area_p)
+{
+#if LV_USE_OCCLUSION_CULLING
+    /*Not covering the inner area (e.g. because of opacity) is a good enough reason to not cover the area
+     *as it's safe to draw more than needed.*/
+    if(obj->cover_cache) {
+        lv_cover_res_t res = obj->cover_cache - 1;
+        if(res != LV_COVER_RES_COVER) return res;
+
+        lv_area_t core;
+        if(get_cover_core(obj, &core) && _lv_area_is_in(area_p, &core, 0)) return LV_COVER_RES_COVER;
+    }
+#endif
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = area_p;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res;
+}
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -746,6 +1286,214 @@ static void lv_refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_ob
     }
 }
 
+#if LV_USE_OCCLUSION_CULLING
+
+/**
+ * Mark the objects which are fully covered by opaque objects drawn later in an area.
+ * The marked objects are skipped by `lv_refr_obj()`.
+ * @param area_p the area which will be refreshed
+ */
+static void occlusion_cull(const lv_area_t * area_p)
+{
+    occl_node_cnt = 0;
+    occluder_cnt = 0;
+
+    /*Collect the objects and the opaque areas in drawing order*/
+    uint32_t order = 0;
+    if(disp_refr->prev_scr) occlusion_collect(disp_refr->prev_scr, area_p, area_p, &order);
+    occlusion_collect(disp_refr->act_scr, area_p, area_p, &order);
+    occlusion_collect(lv_disp_get_layer_top(disp_refr), area_p, area_p, &order);
+    occlusion_collect(lv_disp_get_layer_sys(disp_refr), area_p, area_p, &order);
+
+    if(occluder_cnt == 0) return;
+
+    /*An object can be covered only by objects drawn after it and after its children.
+     *The occluders are in drawing order so they are searched only from the first one after the object.*/
+    uint32_t i = 0;
+    while(i < occl_node_cnt) {
+        refr_occl_node_t * node = &occl_nodes[i];
+        i++;
+
+        uint32_t occl_i = 0;
+        while(occl_i < occluder_cnt && occluders[occl_i].order < node->end) occl_i++;
+        if(occl_i == occluder_cnt) continue;
+
+        uint32_t budget = OCCLUSION_TEST_MAX;
+        if(occlusion_is_covered(&node->area, occl_i, &budget)) {
+            node->obj->culled = 1;
+            culled_num += node->end - node->order;
+
+            /*Skip the children, they are not drawn either*/
+            while(i < occl_node_cnt && occl_nodes[i].order < node->end) i++;
+        }
+    }
+}
+
+/**
+ * Walk the objects in drawing order and save the ones drawn in an area and their opaque parts.
+ * @param obj           the object to start from
+ * @param clip_p        the area where `obj` can draw
+ * @param occl_clip_p   the area where `obj` can cover the others. NULL if it can't (e.g. a parent is masked).
+ * @param order         counter of the objects in drawing order
+ */
+static void occlusion_collect(lv_obj_t * obj, const lv_area_t * clip_p, const lv_area_t * occl_clip_p,
+                              uint32_t * order)
+{
+    if(obj == NULL) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*Use the same areas as `lv_refr_obj()`*/
+    lv_area_t obj_ext_clip;
+    lv_obj_get_coords(obj, &obj_ext_clip);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_ext_clip, ext_draw_size, ext_draw_size);
+    if(!_lv_area_intersect(&obj_ext_clip, &obj_ext_clip, clip_p)) return;
+
+    uint32_t node_i = occl_node_cnt;
+    if(node_i < OCCLUSION_NODE_MAX) {
+        occl_nodes[node_i].obj = obj;
+        occl_nodes[node_i].area = obj_ext_clip;
+        occl_nodes[node_i].order = *order;
+        occl_node_cnt++;
+    }
+    uint32_t obj_order = *order;
+    (*order)++;
+
+    lv_area_t core;
+    lv_cover_res_t res = cover_cache_update(obj, &core);
+    if(res == LV_COVER_RES_COVER && occl_clip_p) {
+        if(_lv_area_intersect(&core, &core, occl_clip_p)) occlusion_add_occluder(&core, obj_order);
+    }
+
+    /*The children are clipped to the object*/
+    lv_area_t child_clip;
+    if(_lv_area_intersect(&child_clip, clip_p, &obj->coords)) {
+        lv_area_t child_occl_clip;
+        const lv_area_t * child_occl_clip_p = NULL;
+        if(occl_clip_p && res != LV_COVER_RES_MASKED) {
+            if(_lv_area_intersect(&child_occl_clip, occl_clip_p, &obj->coords)) child_occl_clip_p = &child_occl_clip;
+        }
+
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+        for(i = 0; i < child_cnt; i++) {
+            occlusion_collect(obj->spec_attr->children[i], &child_clip, child_occl_clip_p, order);
+        }
+    }
+
+    if(node_i < OCCLUSION_NODE_MAX) occl_nodes[node_i].end = *order;
+}
+
+/**
+ * Save an opaque area. If there is no more space replace the smallest one.
+ * @param area_p    the opaque area
+ * @param order     index of its object in the drawing order
+ */
+static void occlusion_add_occluder(const lv_area_t * area_p, uint32_t order)
+{
+    uint32_t i;
+    if(occluder_cnt == OCCLUSION_OCCLUDER_MAX) {
+        uint32_t min_i = 0;
+        for(i = 1; i < occluder_cnt; i++) {
+            if(lv_area_get_size(&occluders[i].area) < lv_area_get_size(&occluders[min_i].area)) min_i = i;
+        }
+        if(lv_area_get_size(&occluders[min_i].area) >= lv_area_get_size(area_p)) return;
+
+        /*Keep the drawing order*/
+        for(i = min_i; i + 1 < occluder_cnt; i++) occluders[i] = occluders[i + 1];
+        occluder_cnt--;
+    }
+
+    occluders[occluder_cnt].area = *area_p;
+    occluders[occluder_cnt].order = order;
+    occluder_cnt++;
+}
+
+/**
+ * Check if an area is fully covered by the union of the occluders
+ * @param area_p    the area to check
+ * @param first     index of the first occluder to use
+ * @param budget    max. number of area pieces to check. If it runs out the area is considered not covered.
+ * @return          true: the area is covered
+ */
+static bool occlusion_is_covered(const lv_area_t * area_p, uint32_t first, uint32_t * budget)
+{
+    if(*budget == 0) return false;
+    (*budget)--;
+
+    uint32_t i;
+    for(i = first; i < occluder_cnt; i++) {
+        const lv_area_t * occl = &occluders[i].area;
+        if(!_lv_area_is_on(area_p, occl)) continue;
+        if(_lv_area_is_in(area_p, occl, 0)) return true;
+
+        /*Check if the remaining parts are covered by the other occluders*/
+        lv_area_t parts[4];
+        uint32_t part_cnt = _lv_area_diff(parts, area_p, occl);
+        uint32_t p;
+        for(p = 0; p < part_cnt; p++) {
+            if(!occlusion_is_covered(&parts[p], i + 1, budget)) return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Remove the marks of the covered objects
+ */
+static void occlusion_clear(void)
+{
+    uint32_t i;
+    for(i = 0; i < occl_node_cnt; i++) {
+        occl_nodes[i].obj->culled = 0;
+    }
+    occl_node_cnt = 0;
+}
+
+/**
+ * Get the cover check result of the inner area of an object. Run the check if it's not cached yet.
+ * @param obj       pointer to an object
+ * @param core_p    store the inner area here
+ * @return          the result of the cover check
+ */
+static lv_cover_res_t cover_cache_update(lv_obj_t * obj, lv_area_t * core_p)
+{
+    bool core_ok = get_cover_core(obj, core_p);
+    if(obj->cover_cache == 0) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_NOT_COVER;
+        if(core_ok) {
+            info.res = LV_COVER_RES_COVER;
+            info.area = core_p;
+            lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        }
+        obj->cover_cache = info.res + 1;
+    }
+
+    return obj->cover_cache - 1;
+}
+
+/**
+ * Get the area of an object which is not affected by the rounded corners
+ * @param obj       pointer to an object
+ * @param core_p    store the area here
+ * @return          false: the area is empty
+ */
+static bool get_cover_core(lv_obj_t * obj, lv_area_t * core_p)
+{
+    lv_area_copy(core_p, &obj->coords);
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    lv_coord_t short_side = LV_MIN(lv_area_get_width(core_p), lv_area_get_height(core_p));
+    if(r > short_side >> 1) r = short_side >> 1;
+    lv_area_increase(core_p, -r, -r);
+
+    return core_p->x1 <= core_p->x2 && core_p->y1 <= core_p->y2;
+}
+
+#endif /*LV_USE_OCCLUSION_CULLING*/
+
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
     int32_t max_row = (uint32_t)disp->driver->draw_buf->size / area_w;
@@ -808,22 +1556,48 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     area->x1 = drv->hor_res - tmp_coord - 1;
 }
 
+/**
+ * Rotate an image by 90 or 270 degrees into an other buffer.
+ * The image is processed in `ROT_TILE_SIZE` x `ROT_TILE_SIZE` tiles
+ * so the read and written lines of a tile stay in the cache.
+ * @param invert_i      true: rotate by 270 degrees; false: rotate by 90 degrees
+ * @param area_w        width of the source image
+ * @param area_h        height of the source image
+ * @param orig_color_p  the source image
+ * @param rot_buf       store the rotated image here (`area_h` wide and `area_w` high)
+ */
 static LV_ATTRIBUTE_FAST_MEM void draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
-                                                     lv_color_t * orig_color_p, lv_color_t * rot_buf)
+                                                     const lv_color_t * orig_color_p, lv_color_t * rot_buf)
 {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
+    lv_coord_t tile_y;
+    for(tile_y = 0; tile_y < area_h; tile_y += ROT_TILE_SIZE) {
+        lv_coord_t y_end = LV_MIN(tile_y + ROT_TILE_SIZE, area_h);
+        lv_coord_t tile_x;
+        for(tile_x = 0; tile_x < area_w; tile_x += ROT_TILE_SIZE) {
+            lv_coord_t x_end = LV_MIN(tile_x + ROT_TILE_SIZE, area_w);
+            lv_coord_t y;
+            for(y = tile_y; y < y_end; y++) {
+                const lv_color_t * src = &orig_color_p[(int32_t)y * area_w + tile_x];
+                lv_coord_t x;
+                if(invert_i) {
+                    /*(x;y) goes to column (area_h - 1 - y) of row x*/
+                    lv_color_t * dst = &rot_buf[(int32_t)tile_x * area_h + (area_h - 1 - y)];
+                    for(x = tile_x; x < x_end; x++) {
+                        *dst = *src;
+                        src++;
+                        dst += area_h;
+                    }
+                }
+                else {
+                    /*(x;y) goes to column y of row (area_w - 1 - x)*/
+                    lv_color_t * dst = &rot_buf[(int32_t)(area_w - 1 - tile_x) * area_h + y];
+                    for(x = tile_x; x < x_end; x++) {
+                        *dst = *src;
+                        src++;
+                        dst -= area_h;
+                    }
+                }
+            }
         }
     }
 }
@@ -873,27 +1647,45 @@ static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color
 }
 
 /**
- * Rotate the draw_buf to the display's native orientation.
+ * Get the ping-pong buffers of the rotation. Allocate them on the first call in a refresh.
+ * @param draw_buf  pointer to a draw buffer
+ * @return          number of available buffers (0, 1 or 2)
+ */
+static uint32_t draw_buf_get_rot_bufs(lv_disp_draw_buf_t * draw_buf)
+{
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(draw_buf->rot_buf[i] == NULL) {
+            draw_buf->rot_buf[i] = lv_mem_alloc(ROT_BUF_SIZE);
+            if(draw_buf->rot_buf[i] == NULL) break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * Rotate the draw_buf to the display's native orientation and flush it.
+ * 90 and 270 degrees are rotated in chunks into two buffers by turns:
+ * a chunk is rotated while the previous one is being flushed.
  */
 static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
 {
     lv_disp_drv_t * drv = disp_refr->driver;
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
     if(disp_refr->driver->full_refresh && drv->sw_rotate) {
         LV_LOG_ERROR("cannot rotate a full refreshed display!");
         return;
     }
     if(drv->rotated == LV_DISP_ROT_180) {
         draw_buf_rotate_180(drv, area, color_p);
-        call_flush_cb(drv, area, color_p);
+        draw_buf_flush_start(disp_refr, &draw_buf->ring_flushing[draw_buf->ring_act], area, color_p);
     }
     else if(drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
-        /*Allocate a temporary buffer to store rotated image*/
-        lv_color_t * rot_buf = NULL;
-        lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
         lv_coord_t area_w = lv_area_get_width(area);
         lv_coord_t area_h = lv_area_get_height(area);
         /*Determine the maximum number of rows that can be rotated at a time*/
-        lv_coord_t max_row = LV_MIN((lv_coord_t)((LV_DISP_ROT_MAX_BUF / sizeof(lv_color_t)) / area_w), area_h);
+        lv_coord_t max_row = LV_MIN((lv_coord_t)((ROT_BUF_SIZE / sizeof(lv_color_t)) / area_w), area_h);
         lv_coord_t init_y_off;
         init_y_off = area->y1;
         if(drv->rotated == LV_DISP_ROT_90) {
@@ -905,11 +1697,15 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             area->y2 = area->y1 + area_w - 1;
         }
 
+        uint32_t rot_buf_cnt = 0;
+        uint32_t rot_buf_i = 0;
+
         /*Rotate the screen in chunks, flushing after each one*/
         lv_coord_t row = 0;
         while(row < area_h) {
             lv_coord_t height = LV_MIN(max_row, area_h - row);
-            draw_buf->flushing = 1;
+            lv_color_t * flush_p;
+            volatile uint32_t * flushing;
             if((row == 0) && (area_h >= area_w)) {
                 /*Rotate the initial area as a square*/
                 height = area_w;
@@ -922,11 +1718,25 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
                     area->x2 = drv->hor_res - 1 - init_y_off;
                     area->x1 = area->x2 - area_w + 1;
                 }
+                flush_p = color_p;
+                flushing = &draw_buf->ring_flushing[draw_buf->ring_act];
             }
             else {
-                /*Rotate other areas using a maximum buffer size*/
-                if(rot_buf == NULL) rot_buf = lv_mem_buf_get(LV_DISP_ROT_MAX_BUF);
-                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, rot_buf);
+                /*Rotate other areas into the rotation buffer which is not being flushed*/
+                if(rot_buf_cnt == 0) {
+                    rot_buf_cnt = draw_buf_get_rot_bufs(draw_buf);
+                    if(rot_buf_cnt == 0) {
+                        LV_LOG_ERROR("couldn't allocate the rotation buffer");
+                        return;
+                    }
+                }
+
+                flushing = &draw_buf->rot_flushing[rot_buf_i];
+                draw_buf_wait_flag(disp_refr, flushing);
+
+                flush_p = draw_buf->rot_buf[rot_buf_i];
+                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, flush_p);
+                rot_buf_i = (rot_buf_i + 1) % rot_buf_cnt;
 
                 if(drv->rotated == LV_DISP_ROT_90) {
                     area->x1 = init_y_off + row;
@@ -947,17 +1757,11 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
                 draw_buf->flushing_last = 0;
             }
 
-            /*Flush the completed area to the display*/
-            call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
-            /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
-            while(draw_buf->flushing) {
-                if(drv->wait_cb) drv->wait_cb(drv);
-            }
+            /*Flush the completed area to the display. Don't wait here, the next chunk is rotated meanwhile.*/
+            draw_buf_flush_start(disp_refr, flushing, area, flush_p);
             color_p += area_w * height;
             row += height;
         }
-        /*Free the allocated buffer at the end if necessary*/
-        if(rot_buf != NULL) lv_mem_buf_release(rot_buf);
     }
 }
 
@@ -972,16 +1776,6 @@ static void draw_buf_flush(lv_disp_t * disp)
     lv_draw_ctx_t * draw_ctx = disp->driver->draw_ctx;
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
-    /* In double buffered mode wait until the other buffer is freed
-     * and driver is ready to receive the new buffer */
-    if(draw_buf->buf1 && draw_buf->buf2) {
-        while(draw_buf->flushing) {
-            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-        }
-    }
-
-    draw_buf->flushing = 1;
-
     if(disp_refr->driver->draw_buf->last_area && disp_refr->driver->draw_buf->last_part) draw_buf->flushing_last = 1;
     else draw_buf->flushing_last = 0;
 
@@ -991,18 +1785,143 @@ static void draw_buf_flush(lv_disp_t * disp)
             draw_buf_rotate(draw_ctx->buf_area, draw_ctx->buf);
         }
         else {
-            call_flush_cb(disp->driver, draw_ctx->buf_area, draw_ctx->buf);
+            draw_buf_flush_start(disp, &draw_buf->ring_flushing[draw_buf->ring_act], draw_ctx->buf_area, draw_ctx->buf);
         }
     }
-    /*If there are 2 buffers swap them. With direct mode swap only on the last area*/
-    if(draw_buf->buf1 && draw_buf->buf2 && (!disp->driver->direct_mode || draw_buf->flushing_last)) {
-        if(draw_buf->buf_act == draw_buf->buf1)
-            draw_buf->buf_act = draw_buf->buf2;
-        else
-            draw_buf->buf_act = draw_buf->buf1;
+    /*If there are more buffers use the next one. With direct mode change only on the last area*/
+    if(draw_buf->ring_cnt > 1 && (!disp->driver->direct_mode || draw_buf->flushing_last)) {
+        draw_buf_next(draw_buf);
     }
 }
 
+/**
+ * Wait until the active draw buffer is not flushed anymore
+ * @param disp pointer to a display
+ */
+static void draw_buf_wait_act(lv_disp_t * disp)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    draw_buf_wait_flag(disp, &draw_buf->ring_flushing[draw_buf->ring_act]);
+}
+
+/**
+ * Wait until a buffer is not flushed anymore
+ * @param disp      pointer to a display
+ * @param flushing  the flushing flag of the buffer (an item of `ring_flushing` or `rot_flushing`)
+ */
+static void draw_buf_wait_flag(lv_disp_t * disp, volatile uint32_t * flushing)
+{
+    if(*flushing == 0) return;
+
+    LV_PROF_BEGIN(prof_wait);
+    uint32_t t_start = lv_tick_get();
+    while(*flushing) {
+        if(disp->driver->wait_cb) disp->driver->wait_cb(disp->driver);
+    }
+    LV_PROF_END(LV_PROF_FLUSH_WAIT, prof_wait);
+
+    uint32_t t = lv_tick_elaps(t_start);
+    disp->flush_stats.wait_cnt++;
+    disp->flush_stats.wait_time += t;
+    if(t > disp->flush_stats.wait_time_max) disp->flush_stats.wait_time_max = t;
+}
+
+/**
+ * Free the ping-pong buffers of the rotation when their flushes are ready.
+ * They are used only while refreshing so they don't take the memory between the refreshes.
+ * @param disp      pointer to a display
+ */
+static void draw_buf_free_rot_bufs(lv_disp_t * disp)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(draw_buf->rot_buf[i] == NULL) continue;
+        draw_buf_wait_flag(disp, &draw_buf->rot_flushing[i]);
+        lv_mem_free(draw_buf->rot_buf[i]);
+        draw_buf->rot_buf[i] = NULL;
+    }
+}
+
+/**
+ * Wait until at most `max_cnt` buffers are being flushed
+ * @param disp      pointer to a display
+ * @param max_cnt   number of flushes which can remain in progress
+ */
+static void draw_buf_wait_flushing(lv_disp_t * disp, uint32_t max_cnt)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    LV_PROF_BEGIN(prof_wait);
+    uint32_t t_start = lv_tick_get();
+    bool waited = false;
+    while(1) {
+        uint32_t cnt = 0;
+        uint32_t i;
+        for(i = 0; i < draw_buf->ring_cnt; i++) {
+            if(draw_buf->ring_flushing[i]) cnt++;
+        }
+        if(draw_buf->rot_flushing[0]) cnt++;
+        if(draw_buf->rot_flushing[1]) cnt++;
+        if(cnt <= max_cnt) break;
+
+        waited = true;
+        if(disp->driver->wait_cb) disp->driver->wait_cb(disp->driver);
+    }
+
+    if(waited) {
+        LV_PROF_END(LV_PROF_FLUSH_WAIT, prof_wait);
+        uint32_t t = lv_tick_elaps(t_start);
+        disp->flush_stats.wait_cnt++;
+        disp->flush_stats.wait_time += t;
+        if(t > disp->flush_stats.wait_time_max) disp->flush_stats.wait_time_max = t;
+    }
+}
+
+/**
+ * Wait until the driver is ready to receive a new buffer, mark the buffer as being flushed and flush it.
+ * In double buffered mode it means waiting until the other buffer is freed. With a ring more flushes can be queued.
+ * @param disp      pointer to a display
+ * @param flushing  the flushing flag of the buffer (an item of `ring_flushing` or `rot_flushing`)
+ * @param area      the area to flush
+ * @param color_p   the pixels to flush
+ */
+static void draw_buf_flush_start(lv_disp_t * disp, volatile uint32_t * flushing, const lv_area_t * area,
+                                 lv_color_t * color_p)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    draw_buf_wait_flushing(disp, draw_buf->flush_max - 1);
+
+    draw_buf->flush_seq++;
+    if(draw_buf->flush_seq == 0) draw_buf->flush_seq = 1;  /*0 means not flushing*/
+    *flushing = draw_buf->flush_seq;
+    draw_buf->flushing = 1;
+    disp->flush_stats.flush_cnt++;
+
+    call_flush_cb(disp->driver, area, color_p);
+}
+
+/**
+ * Activate the next buffer of the ring. Prefer a buffer which is not flushed anymore
+ * as the flushes might be completed in any order.
+ * @param draw_buf pointer to a draw buffer
+ */
+static void draw_buf_next(lv_disp_draw_buf_t * draw_buf)
+{
+    uint32_t next = (draw_buf->ring_act + 1) % draw_buf->ring_cnt;
+    uint32_t i;
+    for(i = 0; i < draw_buf->ring_cnt; i++) {
+        uint32_t idx = (draw_buf->ring_act + 1 + i) % draw_buf->ring_cnt;
+        if(idx == draw_buf->ring_act) continue;
+        if(draw_buf->ring_flushing[idx] == 0) {
+            next = idx;
+            break;
+        }
+    }
+
+    draw_buf->ring_act = next;
+    draw_buf->buf_act = draw_buf->ring[next];
+}
+
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
 {
     REFR_TRACE("Calling flush_cb on (%d;%d)(%d;%d) area with %p image pointer", area->x1, area->y1, area->x2, area->y2,
@@ -1015,7 +1934,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    LV_PROF_BEGIN(prof_flush);
     drv->flush_cb(drv, &offset_area, color_p);
+    LV_PROF_END(LV_PROF_FLUSH, prof_flush);
 }
 
 #if LV_USE_PERF_MONITOR
@@ -1027,6 +1948,10 @@ static void perf_monitor_init(perf_monitor_t * _perf_monitor)
     _perf_monitor->fps_sum_cnt = 0;
     _perf_monitor->frame_cnt = 0;
     _perf_monitor->perf_last_time = 0;
+#if LV_USE_OCCLUSION_CULLING
+    _perf_monitor->culled_sum = 0;
+    _perf_monitor->refr_cnt = 0;
+#endif
     _perf_monitor->perf_label = NULL;
 }
 #endif
@@ -85,6 +85,47 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Get the counters of the invalidated and redrawn areas of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stats store the counters here
+ */
+void lv_refr_get_inv_stats(lv_disp_t * disp, lv_disp_inv_stats_t * stats);
+
+/**
+ * Reset the counters of the invalidated and redrawn areas
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_inv_stats(lv_disp_t * disp);
+
+/**
+ * Get the counters of waiting for the flushing of the draw buffers
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stats store the counters here
+ */
+void lv_refr_get_flush_stats(lv_disp_t * disp, lv_disp_flush_stats_t * stats);
+
+/**
+ * Reset the counters of waiting for the flushing of the draw buffers
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_flush_stats(lv_disp_t * disp);
+
+#if LV_USE_PARALLEL_RENDER
+/**
+ * Enable or disable splitting the rendering among the helper threads.
+ * It's enabled by default if `LV_USE_PARALLEL_RENDER` is enabled.
+ * @param en true: render on more threads; false: render only on the thread calling `lv_timer_handler()`
+ */
+void lv_refr_set_parallel_render(bool en);
+
+/**
+ * Tell if the rendering is split among the helper threads
+ * @return true: parallel rendering is enabled
+ */
+bool lv_refr_get_parallel_render(void);
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
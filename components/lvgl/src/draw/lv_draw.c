@@ -39,6 +39,12 @@
 
 void lv_draw_init(void)
 {
+    _lv_draw_img_init();
+
+#if LV_DRAW_SW_BLEND_KERNELS
+    _lv_draw_sw_blend_kernels_init();
+#endif
+
     //    backend_head = NULL;
     //    lv_draw_sw_init();
     //
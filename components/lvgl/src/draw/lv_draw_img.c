@@ -13,6 +13,8 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -30,10 +32,16 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
+#if LV_USE_PARALLEL_RENDER
+    static bool decode_needs_lock(const void * src);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_PARALLEL_RENDER
+    static lv_mutex_t decoder_mutex;
+#endif
 
 /**********************
  *      MACROS
@@ -43,6 +51,17 @@ static void draw_cleanup(_lv_img_cache_entry_t * cache);
  *   GLOBAL FUNCTIONS
  **********************/
 
+void _lv_draw_img_init(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    static bool inited = false;
+    if(!inited) {
+        lv_mutex_init(&decoder_mutex);
+        inited = true;
+    }
+#endif
+}
+
 void lv_draw_img_dsc_init(lv_draw_img_dsc_t * dsc)
 {
     lv_memset_00(dsc, sizeof(lv_draw_img_dsc_t));
@@ -71,10 +90,20 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     lv_res_t res;
     if(draw_ctx->draw_img) {
+        LV_PROF_BEGIN(prof);
         res = draw_ctx->draw_img(draw_ctx, dsc, coords, src);
+        LV_PROF_END(LV_PROF_DRAW_IMG, prof);
     }
     else {
+#if LV_USE_PARALLEL_RENDER
+        /*The image cache and the decoders of files are shared by the rendering threads*/
+        bool lock = decode_needs_lock(src);
+        if(lock) lv_mutex_lock(&decoder_mutex);
+        res = decode_and_draw(draw_ctx, dsc, coords, src);
+        if(lock) lv_mutex_unlock(&decoder_mutex);
+#else
         res = decode_and_draw(draw_ctx, dsc, coords, src);
+#endif
     }
 
     if(res == LV_RES_INV) {
@@ -103,6 +132,7 @@ uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
             px_size = LV_COLOR_SIZE;
             break;
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT:
             px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3;
             break;
         case LV_IMG_CF_INDEXED_1BIT:
@@ -176,6 +206,9 @@ bool lv_img_cf_has_alpha(lv_img_cf_t cf)
         case LV_IMG_CF_ALPHA_2BIT:
         case LV_IMG_CF_ALPHA_4BIT:
         case LV_IMG_CF_ALPHA_8BIT:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_RLE:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT:
             has_alpha = true;
             break;
         default:
@@ -224,7 +257,9 @@ void lv_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc
 {
     if(draw_ctx->draw_img_decoded == NULL) return;
 
+    LV_PROF_BEGIN(prof);
     draw_ctx->draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+    LV_PROF_END(LV_PROF_DRAW_IMG, prof);
 }
 
 /**********************
@@ -243,6 +278,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
 
     lv_img_cf_t cf;
     if(lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf)) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    else if(cdsc->dec_dsc.header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT) cf = LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT;
     else if(lv_img_cf_has_alpha(cdsc->dec_dsc.header.cf)) cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
     else cf = LV_IMG_CF_TRUE_COLOR;
 
@@ -319,7 +355,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
                 return LV_RES_INV;
             }
 
+            /*Draw only the line. The draw function reads the pixels of the clip area*/
+            const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+            draw_ctx->clip_area = &mask_line;
             lv_draw_img_decoded(draw_ctx, draw_dsc, &line, buf, cf);
+            draw_ctx->clip_area = clip_area_ori;
             line.y1++;
             line.y2++;
             y++;
@@ -344,12 +384,21 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
-static void draw_cleanup(_lv_img_cache_entry_t * cache)
+#if LV_USE_PARALLEL_RENDER
+static bool decode_needs_lock(const void * src)
 {
-    /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
+#if LV_IMG_CACHE_DEF_SIZE
+    LV_UNUSED(src);
+    return true;
 #else
-    LV_UNUSED(cache);
+    /*Every thread has its own cache entry and the built-in decoder keeps its state in it*/
+    return lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE;
+#endif
+}
 #endif
+
+static void draw_cleanup(_lv_img_cache_entry_t * cache)
+{
+    /*Automatically close images with no caching or which didn't fit in the cache*/
+    _lv_img_cache_cleanup(cache);
 }
@@ -51,6 +51,11 @@ struct _lv_draw_ctx_t;
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the image drawing module. Called by `lv_draw_init()`.
+ */
+void _lv_draw_img_init(void);
+
 void lv_draw_img_dsc_init(lv_draw_img_dsc_t * dsc);
 /**
  * Draw an image
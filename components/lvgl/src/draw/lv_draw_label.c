@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -364,7 +365,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                     uint32_t letter)
 {
+    LV_PROF_BEGIN(prof);
     draw_ctx->draw_letter(draw_ctx, dsc, pos_p, letter);
+    LV_PROF_END(LV_PROF_DRAW_LETTER, prof);
 }
 
 
@@ -10,6 +10,7 @@
 #include "lv_draw_triangle.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -38,13 +39,16 @@
 void lv_draw_polygon(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t points[],
                      uint16_t point_cnt)
 {
+    LV_PROF_BEGIN(prof);
     draw_ctx->draw_polygon(draw_ctx, draw_dsc, points, point_cnt);
+    LV_PROF_END(LV_PROF_DRAW_POLYGON, prof);
 }
 
 void lv_draw_triangle(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t points[])
 {
-
+    LV_PROF_BEGIN(prof);
     draw_ctx->draw_polygon(draw_ctx, draw_dsc, points, 3);
+    LV_PROF_END(LV_PROF_DRAW_POLYGON, prof);
 }
 
 /**********************
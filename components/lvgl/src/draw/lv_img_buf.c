@@ -17,6 +17,19 @@
 /*********************
  *      DEFINES
  *********************/
+/*The kinds of source pixels `_lv_img_buf_transform_line()` has separate functions for*/
+#define TRANSFORM_PX_TRUE_COLOR         0
+#define TRANSFORM_PX_TRUE_COLOR_ALPHA   1
+#define TRANSFORM_PX_CHROMA_KEYED       2
+#define TRANSFORM_PX_OTHER              3   /*Read by `lv_img_buf_get_px_color/alpha()`*/
+
+/*Inline the line transformation into the functions of the kinds of pixels to
+ *have the checks of the kind removed by the compiler*/
+#if defined(__GNUC__)
+    #define TRANSFORM_INLINE static inline __attribute__((always_inline))
+#else
+    #define TRANSFORM_INLINE static inline
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -25,6 +38,16 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_COMPLEX
+LV_ATTRIBUTE_FAST_MEM static void transform_line_true_color(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                            lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf);
+LV_ATTRIBUTE_FAST_MEM static void transform_line_true_color_alpha(lv_img_transform_dsc_t * dsc, lv_coord_t x,
+                                                                  lv_coord_t y, lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf);
+LV_ATTRIBUTE_FAST_MEM static void transform_line_chroma_keyed(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                              lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf);
+static void transform_line_other(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                 lv_color_t * cbuf, lv_opa_t * abuf);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -54,7 +77,7 @@ lv_color_t lv_img_buf_get_px_color(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t
     uint8_t * buf_u8 = (uint8_t *)dsc->data;
 
     if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED ||
-       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT) {
         uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
         uint32_t px     = dsc->header.w * y * px_size + x * px_size;
         lv_memcpy_small(&p_color, &buf_u8[px], sizeof(lv_color_t));
@@ -119,7 +142,7 @@ lv_opa_t lv_img_buf_get_px_alpha(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y)
 {
     uint8_t * buf_u8 = (uint8_t *)dsc->data;
 
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT) {
         uint32_t px = dsc->header.w * y * LV_IMG_PX_SIZE_ALPHA_BYTE + x * LV_IMG_PX_SIZE_ALPHA_BYTE;
         return buf_u8[px + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
     }
@@ -182,7 +205,7 @@ void lv_img_buf_set_px_alpha(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_
 {
     uint8_t * buf_u8 = (uint8_t *)dsc->data;
 
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT) {
         uint8_t px_size          = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
         uint32_t px              = dsc->header.w * y * px_size + x * px_size;
         buf_u8[px + px_size - 1] = opa;
@@ -246,7 +269,7 @@ void lv_img_buf_set_px_color(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_
         uint32_t px     = dsc->header.w * y * px_size + x * px_size;
         lv_memcpy_small(&buf_u8[px], &c, px_size);
     }
-    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT) {
         uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
         uint32_t px     = dsc->header.w * y * px_size + x * px_size;
         lv_memcpy_small(&buf_u8[px], &c, px_size - 1); /*-1 to not overwrite the alpha value*/
@@ -386,6 +409,7 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
         case LV_IMG_CF_TRUE_COLOR:
             return LV_IMG_BUF_SIZE_TRUE_COLOR(w, h);
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT:
             return LV_IMG_BUF_SIZE_TRUE_COLOR_ALPHA(w, h);
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
             return LV_IMG_BUF_SIZE_TRUE_COLOR_CHROMA_KEYED(w, h);
@@ -410,6 +434,73 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
     }
 }
 
+/**
+ * Multiply the color channels of an `LV_IMG_CF_TRUE_COLOR_ALPHA` image by the alpha bytes in place
+ * and change its color format to `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT`.
+ * Other color formats are not changed.
+ * @param dsc pointer to an image descriptor whose pixels are in RAM
+ */
+void lv_img_buf_premultiply(lv_img_dsc_t * dsc)
+{
+    if(dsc->header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA) return;
+
+    uint8_t * px = (uint8_t *)dsc->data;
+    uint32_t px_cnt = (uint32_t)dsc->header.w * dsc->header.h;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++, px += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+        lv_opa_t a = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        if(a == LV_OPA_COVER) continue;
+
+        lv_color_t c;
+        lv_memcpy_small(&c, px, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+        c = _lv_img_buf_premult_color(c, a);
+        lv_memcpy_small(px, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+    }
+
+    dsc->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT;
+}
+
+/**
+ * Multiply the channels of a color by an opacity the way `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` images store it
+ * @param c a color
+ * @param a the opacity of the color
+ * @return the pre-multiplied color
+ */
+lv_color_t _lv_img_buf_premult_color(lv_color_t c, lv_opa_t a)
+{
+    if(a == LV_OPA_COVER) return c;
+
+    /*Rounded to keep `src + dest * (255 - a) / 255` in range when blending (the latter is rounded down).
+     *Read every channel first: with `LV_COLOR_16_SWAP` setting green reads it again.*/
+    uint32_t r = LV_UDIV255((uint32_t)LV_COLOR_GET_R(c) * a + 127);
+    uint32_t g = LV_UDIV255((uint32_t)LV_COLOR_GET_G(c) * a + 127);
+    uint32_t b = LV_UDIV255((uint32_t)LV_COLOR_GET_B(c) * a + 127);
+    LV_COLOR_SET_R(c, r);
+    LV_COLOR_SET_G(c, g);
+    LV_COLOR_SET_B(c, b);
+    return c;
+}
+
+/**
+ * Restore the color of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` pixel (the lost precision can't be restored)
+ * @param c a pre-multiplied color
+ * @param a the opacity of the pixel
+ * @return the color before the pre-multiplication
+ */
+lv_color_t _lv_img_buf_unpremult_color(lv_color_t c, lv_opa_t a)
+{
+    if(a == LV_OPA_COVER || a == LV_OPA_TRANSP) return c;
+
+    lv_color_t max = lv_color_white();
+    uint32_t r = ((uint32_t)LV_COLOR_GET_R(c) * 255 + (a >> 1)) / a;
+    uint32_t g = ((uint32_t)LV_COLOR_GET_G(c) * 255 + (a >> 1)) / a;
+    uint32_t b = ((uint32_t)LV_COLOR_GET_B(c) * 255 + (a >> 1)) / a;
+    LV_COLOR_SET_R(c, LV_MIN(r, (uint32_t)LV_COLOR_GET_R(max)));
+    LV_COLOR_SET_G(c, LV_MIN(g, (uint32_t)LV_COLOR_GET_G(max)));
+    LV_COLOR_SET_B(c, LV_MIN(b, (uint32_t)LV_COLOR_GET_B(max)));
+    return c;
+}
+
 #if LV_DRAW_COMPLEX
 /**
  * Initialize a descriptor to transform an image
@@ -440,7 +531,7 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
     dsc->tmp.chroma_keyed = lv_img_cf_is_chroma_keyed(dsc->cfg.cf) ? 1 : 0;
     dsc->tmp.has_alpha = lv_img_cf_has_alpha(dsc->cfg.cf) ? 1 : 0;
     if(dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR || dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ||
-       dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+       dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT || dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
         dsc->tmp.native_color = 1;
     }
     else {
@@ -457,6 +548,17 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
      * + dsc->cfg.zoom / 2 for rounding*/
     dsc->tmp.zoom_inv = (((256 * 256) << _LV_ZOOM_INV_UPSCALE) + dsc->cfg.zoom / 2) / dsc->cfg.zoom;
 
+    /*With multiples of 90 degrees every pixel can be copied from one source pixel.
+     *Integer zoom too but only without anti-aliasing because it's expected to smooth the enlarged pixels.*/
+    dsc->tmp.exact = 0;
+    if(dsc->cfg.angle % 900 == 0 && dsc->cfg.zoom >= LV_IMG_ZOOM_NONE && dsc->cfg.zoom % LV_IMG_ZOOM_NONE == 0) {
+        if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE || dsc->cfg.antialias == false) {
+            dsc->tmp.exact = 1;
+            dsc->tmp.exact_rot = (dsc->cfg.angle / 900) & 0x3;
+            dsc->tmp.exact_zoom = dsc->cfg.zoom / LV_IMG_ZOOM_NONE;
+        }
+    }
+
     dsc->res.opa = LV_OPA_COVER;
     dsc->res.color = dsc->cfg.color;
 }
@@ -766,7 +868,337 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Get which color and opa would come to a line of pixels if they were rotated.
+ * Gives the same result as `_lv_img_buf_transform()` for every pixel but steps the source coordinates along the line.
+ * If the angle is 0, 90, 180 or 270 degrees and there is no zoom (or an integer zoom without anti-aliasing)
+ * the source pixels are copied without anti-aliasing.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` if the rotated pixel was out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    if(dsc->tmp.native_color == 0) transform_line_other(dsc, x, y, len, cbuf, abuf);
+    else if(dsc->tmp.has_alpha) transform_line_true_color_alpha(dsc, x, y, len, cbuf, abuf);
+    else if(dsc->tmp.chroma_keyed) transform_line_chroma_keyed(dsc, x, y, len, cbuf, abuf);
+    else transform_line_true_color(dsc, x, y, len, cbuf, abuf);
+}
 #endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_DRAW_COMPLEX
+
+/*Read the color of a pixel of `LV_IMG_CF_TRUE_COLOR/_ALPHA/_CHROMA_KEYED`*/
+TRANSFORM_INLINE lv_color_t transform_px_color(const uint8_t * px)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+    c.full = px[0];
+#elif LV_COLOR_DEPTH == 16
+    c.full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+    c.full = px[0] + (px[1] << 8) + (px[2] << 16) + 0xFF000000;
+#endif
+    return c;
+}
+
+/*Read a pixel of the source. The coordinates need to be on the image.
+ *`px` is the pixel in the source if it's in a native color format.*/
+TRANSFORM_INLINE lv_color_t transform_px_get(lv_img_transform_dsc_t * dsc, const uint8_t * px, int32_t x, int32_t y,
+                                             lv_opa_t * opa, const uint8_t px_kind)
+{
+    if(px_kind == TRANSFORM_PX_OTHER) {
+        *opa = lv_img_buf_get_px_alpha(&dsc->tmp.img_dsc, x, y);
+        return lv_img_buf_get_px_color(&dsc->tmp.img_dsc, x, y, dsc->cfg.color);
+    }
+
+    *opa = px_kind == TRANSFORM_PX_TRUE_COLOR_ALPHA ? px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] : LV_OPA_COVER;
+    return transform_px_color(px);
+}
+
+/*The same as `_lv_img_buf_transform_anti_alias()` with the pixels read directly.
+ *`c00` and `a00` are the color and opa of the pixel at `xs_int`, `ys_int` (`px` in the source).*/
+TRANSFORM_INLINE bool transform_anti_alias(lv_img_transform_dsc_t * dsc, const uint8_t * px, int32_t xs, int32_t ys,
+                                           lv_color_t c00, lv_opa_t a00, lv_color_t * c_res, lv_opa_t * a_res,
+                                           const uint8_t px_kind)
+{
+    int32_t xs_int = xs >> 8;
+    int32_t ys_int = ys >> 8;
+    int32_t xs_fract = xs & 0xff;
+    int32_t ys_fract = ys & 0xff;
+    int32_t xn;
+    lv_opa_t xr;
+    if(xs_fract < 0x70) {
+        xn = xs_int > 0 ? -1 : 0;
+        xr = xs_fract + 0x80;
+    }
+    else if(xs_fract > 0x90) {
+        xn = xs_int + 1 < dsc->cfg.src_w ? 1 : 0;
+        xr = (0xFF - xs_fract) + 0x80;
+    }
+    else {
+        xn = 0;
+        xr = 0xFF;
+    }
+
+    int32_t yn;
+    lv_opa_t yr;
+    if(ys_fract < 0x70) {
+        yn = ys_int > 0 ? -1 : 0;
+        yr = ys_fract + 0x80;
+    }
+    else if(ys_fract > 0x90) {
+        yn = ys_int + 1 < dsc->cfg.src_h ? 1 : 0;
+        yr = (0xFF - ys_fract) + 0x80;
+    }
+    else {
+        yn = 0;
+        yr = 0xFF;
+    }
+
+    /*The neighbor in x direction, in y direction and the diagonal one*/
+    lv_opa_t a10;
+    lv_opa_t a01;
+    lv_opa_t a11;
+    const int32_t px_size = px_kind == TRANSFORM_PX_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    int32_t x_ofs = xn * px_size;
+    int32_t y_ofs = yn * dsc->cfg.src_w * px_size;
+    lv_color_t c01 = transform_px_get(dsc, px + x_ofs, xs_int + xn, ys_int, &a10, px_kind);
+    lv_color_t c10 = transform_px_get(dsc, px + y_ofs, xs_int, ys_int + yn, &a01, px_kind);
+    lv_color_t c11 = transform_px_get(dsc, px + x_ofs + y_ofs, xs_int + xn, ys_int + yn, &a11, px_kind);
+
+    lv_opa_t xr0 = xr;
+    lv_opa_t xr1 = xr;
+    if(dsc->tmp.has_alpha) {
+        lv_opa_t a0 = (a00 * xr + (a10 * (255 - xr))) >> 8;
+        lv_opa_t a1 = (a01 * xr + (a11 * (255 - xr))) >> 8;
+        *a_res = (a0 * yr + (a1 * (255 - yr))) >> 8;
+
+        if(a0 <= LV_OPA_MIN && a1 <= LV_OPA_MIN) return false;
+        if(a0 <= LV_OPA_MIN) yr = LV_OPA_TRANSP;
+        if(a1 <= LV_OPA_MIN) yr = LV_OPA_COVER;
+        if(a00 <= LV_OPA_MIN) xr0 = LV_OPA_TRANSP;
+        if(a10 <= LV_OPA_MIN) xr0 = LV_OPA_COVER;
+        if(a01 <= LV_OPA_MIN) xr1 = LV_OPA_TRANSP;
+        if(a11 <= LV_OPA_MIN) xr1 = LV_OPA_COVER;
+    }
+    else {
+        *a_res = LV_OPA_COVER;
+    }
+
+    lv_color_t c0;
+    if(xr0 == LV_OPA_TRANSP) c0 = c01;
+    else if(xr0 == LV_OPA_COVER) c0 = c00;
+    else c0 = lv_color_mix(c00, c01, xr0);
+
+    lv_color_t c1;
+    if(xr1 == LV_OPA_TRANSP) c1 = c11;
+    else if(xr1 == LV_OPA_COVER) c1 = c10;
+    else c1 = lv_color_mix(c10, c11, xr1);
+
+    if(yr == LV_OPA_TRANSP) *c_res = c1;
+    else if(yr == LV_OPA_COVER) *c_res = c0;
+    else *c_res = lv_color_mix(c0, c1, yr);
+
+    return true;
+}
+
+/*Copy the source pixels of a rotation by 90 degree steps and integer zoom*/
+TRANSFORM_INLINE void transform_line_exact(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                           lv_color_t * cbuf, lv_opa_t * abuf, const uint8_t px_kind)
+{
+    int32_t zoom = dsc->tmp.exact_zoom;
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+
+    /*Zoom by rounding down the coordinates relative to the pivot*/
+    int32_t xz = xt >= 0 ? xt / zoom : -((-xt + zoom - 1) / zoom);
+    int32_t yz = yt >= 0 ? yt / zoom : -((-yt + zoom - 1) / zoom);
+    int32_t zoom_cnt = xt - xz * zoom;   /*Pixels already drawn from the first source pixel*/
+
+    /*The source pixel and the step to the next one*/
+    int32_t xs;
+    int32_t ys;
+    int32_t xs_step;
+    int32_t ys_step;
+    switch(dsc->tmp.exact_rot) {
+        case 0:
+            xs = xz;
+            ys = yz;
+            xs_step = 1;
+            ys_step = 0;
+            break;
+        case 1:
+            xs = yz;
+            ys = -xz;
+            xs_step = 0;
+            ys_step = -1;
+            break;
+        case 2:
+            xs = -xz;
+            ys = -yz;
+            xs_step = -1;
+            ys_step = 0;
+            break;
+        default:
+            xs = -yz;
+            ys = xz;
+            xs_step = 0;
+            ys_step = 1;
+            break;
+    }
+    xs += dsc->cfg.pivot_x;
+    ys += dsc->cfg.pivot_y;
+
+    /*Step the pointer of the source pixel too (it's not used if the pixel is not native)*/
+    const int32_t px_size = px_kind == TRANSFORM_PX_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    const uint8_t * px = (const uint8_t *)dsc->cfg.src + (dsc->cfg.src_w * ys + xs) * px_size;
+    int32_t px_step = (dsc->cfg.src_w * ys_step + xs_step) * px_size;
+
+    bool chroma_keyed = px_kind == TRANSFORM_PX_CHROMA_KEYED || (px_kind == TRANSFORM_PX_OTHER && dsc->tmp.chroma_keyed);
+    lv_color_t chroma_key = LV_COLOR_CHROMA_KEY;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        if(xs < 0 || xs >= dsc->cfg.src_w || ys < 0 || ys >= dsc->cfg.src_h) {
+            abuf[i] = LV_OPA_TRANSP;
+        }
+        else {
+            cbuf[i] = transform_px_get(dsc, px, xs, ys, &abuf[i], px_kind);
+            if(chroma_keyed && cbuf[i].full == chroma_key.full) abuf[i] = LV_OPA_TRANSP;
+        }
+
+        zoom_cnt++;
+        if(zoom_cnt == zoom) {
+            zoom_cnt = 0;
+            xs += xs_step;
+            ys += ys_step;
+            px += px_step;
+        }
+    }
+}
+
+/*The source coordinates are stepped along the line with the same rounding as `_lv_img_buf_transform()`*/
+TRANSFORM_INLINE void transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                     lv_color_t * cbuf, lv_opa_t * abuf, const uint8_t px_kind)
+{
+    if(dsc->tmp.exact) {
+        transform_line_exact(dsc, x, y, len, cbuf, abuf, px_kind);
+        return;
+    }
+
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+    int32_t sinma = dsc->tmp.sinma;
+    int32_t cosma = dsc->tmp.cosma;
+
+    /*Without rotation and zoom together the source coordinates (in 1/256 pixels) are `(acc >> shift) + pivot`
+     *where `acc` changes the same amount on every pixel. The wrapping of the unsigned `acc` is the same as
+     *the overflow of the multiplications in `_lv_img_buf_transform()`.*/
+    bool rotate_zoom = false;
+    uint32_t xs_acc;
+    uint32_t ys_acc;
+    uint32_t xs_step;
+    uint32_t ys_step;
+    uint32_t shift;
+    int32_t yz_sin = 0;
+    int32_t yz_cos = 0;
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        xs_acc = cosma * xt - sinma * yt;
+        ys_acc = sinma * xt + cosma * yt;
+        xs_step = cosma;
+        ys_step = sinma;
+        shift = _LV_TRANSFORM_TRIGO_SHIFT - 8;
+    }
+    else {
+        /*With rotation too the zoomed x is stepped and rotated on every pixel*/
+        xs_acc = (uint32_t)xt * dsc->tmp.zoom_inv;
+        ys_acc = (uint32_t)yt * dsc->tmp.zoom_inv;
+        xs_step = dsc->tmp.zoom_inv;
+        ys_step = 0;
+        shift = _LV_ZOOM_INV_UPSCALE;
+        if(dsc->cfg.angle != 0) {
+            int32_t yz = (int32_t)ys_acc >> _LV_ZOOM_INV_UPSCALE;
+            rotate_zoom = true;
+            yz_sin = sinma * yz;
+            yz_cos = cosma * yz;
+        }
+    }
+
+    bool chroma_keyed = px_kind == TRANSFORM_PX_CHROMA_KEYED || (px_kind == TRANSFORM_PX_OTHER && dsc->tmp.chroma_keyed);
+    lv_color_t chroma_key = LV_COLOR_CHROMA_KEY;
+    const int32_t px_size = px_kind == TRANSFORM_PX_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    const uint8_t * src = dsc->cfg.src;
+    int32_t src_w = dsc->cfg.src_w;
+    int32_t src_h = dsc->cfg.src_h;
+    lv_coord_t i;
+    for(i = 0; i < len; i++, xs_acc += xs_step, ys_acc += ys_step) {
+        int32_t xs;
+        int32_t ys;
+        if(rotate_zoom) {
+            int32_t xz = (int32_t)xs_acc >> _LV_ZOOM_INV_UPSCALE;
+            xs = ((cosma * xz - yz_sin) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_x_256;
+            ys = ((sinma * xz + yz_cos) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_y_256;
+        }
+        else {
+            xs = ((int32_t)xs_acc >> shift) + dsc->tmp.pivot_x_256;
+            ys = ((int32_t)ys_acc >> shift) + dsc->tmp.pivot_y_256;
+        }
+
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
+        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
+            abuf[i] = LV_OPA_TRANSP;
+            continue;
+        }
+
+        lv_opa_t a00;
+        const uint8_t * px = src + (src_w * ys_int + xs_int) * px_size;
+        lv_color_t c00 = transform_px_get(dsc, px, xs_int, ys_int, &a00, px_kind);
+        if(chroma_keyed && c00.full == chroma_key.full) {
+            abuf[i] = LV_OPA_TRANSP;
+            continue;
+        }
+
+        if(dsc->cfg.antialias == false) {
+            cbuf[i] = c00;
+            abuf[i] = a00;
+        }
+        else if(transform_anti_alias(dsc, px, xs, ys, c00, a00, &cbuf[i], &abuf[i], px_kind) == false) {
+            abuf[i] = LV_OPA_TRANSP;
+        }
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void transform_line_true_color(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                            lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    transform_line(dsc, x, y, len, cbuf, abuf, TRANSFORM_PX_TRUE_COLOR);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void transform_line_true_color_alpha(lv_img_transform_dsc_t * dsc, lv_coord_t x,
+                                                                  lv_coord_t y, lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    transform_line(dsc, x, y, len, cbuf, abuf, TRANSFORM_PX_TRUE_COLOR_ALPHA);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void transform_line_chroma_keyed(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                              lv_coord_t len, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    transform_line(dsc, x, y, len, cbuf, abuf, TRANSFORM_PX_CHROMA_KEYED);
+}
+
+static void transform_line_other(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                 lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    transform_line(dsc, x, y, len, cbuf, abuf, TRANSFORM_PX_OTHER);
+}
+
+#endif /*LV_DRAW_COMPLEX*/
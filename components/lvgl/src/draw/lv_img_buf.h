@@ -77,9 +77,12 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use.*/
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use.*/
-    LV_IMG_CF_RESERVED_17,              /**< Reserved for further use.*/
+    LV_IMG_CF_TRUE_COLOR_ALPHA_RLE,     /**< `LV_IMG_CF_TRUE_COLOR_ALPHA` compressed in blocks of lines with
+                                           run-length encoding*/
+    LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4,     /**< `LV_IMG_CF_TRUE_COLOR_ALPHA` compressed in blocks of lines with
+                                           the LZ4 block format*/
+    LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT, /**< Same as `LV_IMG_CF_TRUE_COLOR_ALPHA` but the color channels are
+                                           multiplied by the alpha byte (see `lv_img_buf_premultiply()`)*/
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use.*/
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use.*/
     LV_IMG_CF_RESERVED_20,              /**< Reserved for further use.*/
@@ -167,6 +170,9 @@ typedef struct {
         uint8_t chroma_keyed : 1;
         uint8_t has_alpha : 1;
         uint8_t native_color : 1;
+        uint8_t exact : 1;          /*Every pixel comes from exactly one source pixel (see `_lv_img_buf_transform_line`)*/
+        uint8_t exact_rot : 2;      /*Rotation of the exact transformation in 90 degree steps*/
+        uint8_t exact_zoom;         /*Integer zoom of the exact transformation*/
 
         uint32_t zoom_inv;
 
@@ -202,7 +208,7 @@ lv_img_dsc_t * lv_img_buf_alloc(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf);
  * @param color the color of the image. In case of `LV_IMG_CF_ALPHA_1/2/4/8` this color is used.
  * Not used in other cases.
  * @param safe true: check out of bounds
- * @return color of the point
+ * @return color of the point (pre-multiplied in case of `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT`)
  */
 lv_color_t lv_img_buf_get_px_color(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_color_t color);
 
@@ -263,6 +269,30 @@ void lv_img_buf_free(lv_img_dsc_t * dsc);
  */
 uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf);
 
+/**
+ * Multiply the color channels of an `LV_IMG_CF_TRUE_COLOR_ALPHA` image by the alpha bytes in place
+ * and change its color format to `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT`.
+ * Other color formats are not changed.
+ * @param dsc pointer to an image descriptor whose pixels are in RAM
+ */
+void lv_img_buf_premultiply(lv_img_dsc_t * dsc);
+
+/**
+ * Multiply the channels of a color by an opacity the way `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` images store it
+ * @param c a color
+ * @param a the opacity of the color
+ * @return the pre-multiplied color
+ */
+lv_color_t _lv_img_buf_premult_color(lv_color_t c, lv_opa_t a);
+
+/**
+ * Restore the color of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` pixel (the lost precision can't be restored)
+ * @param c a pre-multiplied color
+ * @param a the opacity of the pixel
+ * @return the color before the pre-multiplication
+ */
+lv_color_t _lv_img_buf_unpremult_color(lv_color_t c, lv_opa_t a);
+
 #if LV_DRAW_COMPLEX
 /**
  * Initialize a descriptor to rotate an image
@@ -286,6 +316,21 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc);
  */
 bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y);
 
+/**
+ * Get which color and opa would come to a line of pixels if they were rotated.
+ * Gives the same result as `_lv_img_buf_transform()` for every pixel but steps the source coordinates along the line.
+ * If the angle is 0, 90, 180 or 270 degrees and there is no zoom (or an integer zoom without anti-aliasing)
+ * the source pixels are copied without anti-aliasing.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` if the rotated pixel was out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf);
+
 #endif
 /**
  * Get the area of a rectangle if its rotated and scaled
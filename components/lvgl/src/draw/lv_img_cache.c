@@ -12,28 +12,45 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_lru.h"
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
+/*Keep an entry longer by this many opens of other images for every ms of its `time_to_open`*/
 #define LV_IMG_CACHE_LIFE_GAIN 1
 
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
+/*Don't keep an entry longer than this many opens of other images because of its `time_to_open`
+ *because it would require a lot of time to "die"*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Keys of the file names shorter than this are not allocated*/
+#define LV_IMG_CACHE_KEY_BUF_SIZE 64
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+/*The beginning of the keys. It's followed by the pointer of variables or the path of files.*/
+typedef struct {
+    int32_t frame_id;
+    uint32_t color;
+    uint32_t src_type;
+} key_head_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_res_t img_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_color_t color, int32_t frame_id);
 #if LV_IMG_CACHE_DEF_SIZE
+    static void cache_create(void);
+    static uint8_t * key_create(uint8_t * buf, const void * src, lv_color_t color, int32_t frame_id, size_t * len);
+    static void key_free(uint8_t * key, uint8_t * buf);
+    static void entry_store(_lv_img_cache_entry_t * entry, const uint8_t * key, size_t key_len);
+    static void entry_free_cb(void * v);
+    static uint32_t entry_priority_cb(void * v);
+    static bool entry_match_cb(void * v, void * src);
     static bool lv_img_cache_match(const void * src1, const void * src2);
 #endif
 
@@ -42,6 +59,9 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t entry_max;
+    static uint32_t mem_max = LV_IMG_CACHE_MEM_SIZE;
+    static lv_img_cache_stats_t cache_stats;
 #endif
 
 /**********************
@@ -55,89 +75,84 @@
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
- * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * The image is closed if a new image needs its place in the cache.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @return pointer to the cache entry or NULL if can open the image
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
 {
+#if LV_IMG_CACHE_DEF_SIZE
     /*Is the image cached?*/
-    _lv_img_cache_entry_t * cached_src = NULL;
+    uint8_t key_buf[LV_IMG_CACHE_KEY_BUF_SIZE];
+    size_t key_len;
+    uint8_t * key = key_create(key_buf, src, color, frame_id, &key_len);
+    if(key == NULL) return NULL;
 
-#if LV_IMG_CACHE_DEF_SIZE
-    if(entry_cnt == 0) {
-        LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
-        return NULL;
+    void * cached = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_img_cache_lru), key, key_len, &cached);
+    if(cached) {
+        LV_LOG_TRACE("image source found in the cache");
+        cache_stats.hit_cnt++;
+        key_free(key, key_buf);
+        return cached;
     }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
+    /*The image is not cached then cache it now*/
+    cache_stats.miss_cnt++;
+    _lv_img_cache_entry_t * cached_src = lv_mem_alloc(sizeof(_lv_img_cache_entry_t));
+    LV_ASSERT_MALLOC(cached_src);
+    if(cached_src == NULL) {
+        key_free(key, key_buf);
+        return NULL;
     }
+    lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
-            break;
-        }
+    if(img_open(&cached_src->dec_dsc, src, color, frame_id) != LV_RES_OK) {
+        lv_mem_free(cached_src);
+        key_free(key, key_buf);
+        return NULL;
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+    /*Charge the decoded data if it was allocated and not only the data of the variable was given*/
+    uint32_t decoded_size = cached_src->dec_dsc.decoded_size;
+    if(decoded_size == 0 && cached_src->dec_dsc.img_data &&
+       (cached_src->dec_dsc.src_type != LV_IMG_SRC_VARIABLE ||
+        cached_src->dec_dsc.img_data != ((const lv_img_dsc_t *)src)->data)) {
+        lv_img_header_t * header = &cached_src->dec_dsc.header;
+        decoded_size = lv_img_buf_get_img_size(header->w, header->h, header->cf);
     }
+    cached_src->mem_size = sizeof(_lv_img_cache_entry_t) + sizeof(lruc_item) + key_len + decoded_size;
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
+    entry_store(cached_src, key, key_len);
+    key_free(key, key_buf);
+    return cached_src;
 #else
-    cached_src = &LV_GC_ROOT(_lv_img_cache_single);
-#endif
-    /*Open the image and measure the time to open*/
-    uint32_t t_start  = lv_tick_get();
-    lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
-    if(open_res == LV_RES_INV) {
-        LV_LOG_WARN("Image draw cannot open the image resource");
+    _lv_img_cache_entry_t * cached_src = &LV_GC_ROOT(_lv_img_cache_single);
+    if(img_open(&cached_src->dec_dsc, src, color, frame_id) != LV_RES_OK) {
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
         return NULL;
     }
 
-    cached_src->life = 0;
+    return cached_src;
+#endif
+}
 
-    /*If `time_to_open` was not set in the open function set it here*/
-    if(cached_src->dec_dsc.time_to_open == 0) {
-        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+/**
+ * Release an entry returned by `_lv_img_cache_open`. The image is closed if it's not cached.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_cleanup(_lv_img_cache_entry_t * entry)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry->temp) {
+        lv_img_decoder_close(&entry->dec_dsc);
+        lv_mem_free(entry);
     }
-
-    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
-
-    return cached_src;
+#else
+    /*Automatically close images with no caching*/
+    lv_img_decoder_close(&entry->dec_dsc);
+#endif
 }
 
 /**
@@ -152,23 +167,23 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
-    if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
-        /*Clean the cache before free it*/
-        lv_img_cache_invalidate_src(NULL);
-        lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
-    }
-
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
-        return;
-    }
-    entry_cnt = new_entry_cnt;
+    entry_max = new_entry_cnt;
+    cache_create();
+#endif
+}
 
-    /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+/**
+ * Set the memory budget of the cached images.
+ * @param mem_size the memory allocated by the decoders and the cache entries in bytes. 0: no limit
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(mem_size);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    mem_max = mem_size;
+    cache_create();
 #endif
 }
 
@@ -181,18 +196,90 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_lru_remove_if(LV_GC_ROOT(_lv_img_cache_lru), entry_match_cb, (void *)src);
+#endif
+}
 
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+/**
+ * Open an image and keep it in the cache until `lv_img_cache_unpin`.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor of the image as drawn
+ * @param frame_id the index of the frame
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: couldn't open the image or it doesn't fit in the cache
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color, int32_t frame_id)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_img_cache_entry_t * cached_src = _lv_img_cache_open(src, color, frame_id);
+    if(cached_src == NULL) return LV_RES_INV;
 
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
-        }
+    if(cached_src->temp) {
+        LV_LOG_WARN("lv_img_cache_pin: the image doesn't fit in the cache");
+        _lv_img_cache_cleanup(cached_src);
+        return LV_RES_INV;
     }
+
+    cached_src->pin_cnt++;
+    return LV_RES_OK;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_UNUSED(frame_id);
+    LV_LOG_WARN("Can't pin images because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Let a pinned image be closed again to make room for other images
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the same as in `lv_img_cache_pin`
+ * @param frame_id the same as in `lv_img_cache_pin`
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color, int32_t frame_id)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    uint8_t key_buf[LV_IMG_CACHE_KEY_BUF_SIZE];
+    size_t key_len;
+    uint8_t * key = key_create(key_buf, src, color, frame_id, &key_len);
+    if(key == NULL) return;
+
+    void * cached = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_img_cache_lru), key, key_len, &cached);
+    _lv_img_cache_entry_t * cached_src = cached;
+    if(cached_src && cached_src->pin_cnt > 0) cached_src->pin_cnt--;
+
+    key_free(key, key_buf);
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_UNUSED(frame_id);
+#endif
+}
+
+/**
+ * Get the counters of the image cache
+ * @param stats store the counters here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    *stats = cache_stats;
+    stats->entry_cnt = entry_cnt;
+    lv_lru_t * lru = LV_GC_ROOT(_lv_img_cache_lru);
+    stats->mem_used = lru ? lru->total_memory - lru->free_memory : 0;
+#else
+    lv_memset_00(stats, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stats(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_memset_00(&cache_stats, sizeof(cache_stats));
 #endif
 }
 
@@ -200,7 +287,132 @@ void lv_img_cache_invalidate_src(const void * src)
  *   STATIC FUNCTIONS
  **********************/
 
+/*Open the image and measure the time to open*/
+static lv_res_t img_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_color_t color, int32_t frame_id)
+{
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(dsc, src, color, frame_id);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        return LV_RES_INV;
+    }
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(dsc->time_to_open == 0) {
+        dsc->time_to_open = lv_tick_elaps(t_start);
+    }
+
+    if(dsc->time_to_open == 0) dsc->time_to_open = 1;
+
+    return LV_RES_OK;
+}
+
 #if LV_IMG_CACHE_DEF_SIZE
+static void cache_create(void)
+{
+    /*Free the cache with the opened images*/
+    if(LV_GC_ROOT(_lv_img_cache_lru) != NULL) {
+        lv_lru_free(LV_GC_ROOT(_lv_img_cache_lru));
+        LV_GC_ROOT(_lv_img_cache_lru) = NULL;
+    }
+    entry_cnt = 0;
+
+    if(entry_max == 0) return;
+
+    /*One hash table slot for every entry*/
+    uint32_t mem_size = mem_max ? mem_max : UINT32_MAX;
+    LV_GC_ROOT(_lv_img_cache_lru) = lv_lru_new(mem_size, mem_size / entry_max, entry_free_cb, NULL);
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_lru));
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL) return;
+
+    lv_lru_set_priority_cb(LV_GC_ROOT(_lv_img_cache_lru), entry_priority_cb);
+}
+
+/*The key is the frame, the color, and the pointer of variables or the path of files.
+ *It's created in `buf` if it fits else allocated.*/
+static uint8_t * key_create(uint8_t * buf, const void * src, lv_color_t color, int32_t frame_id, size_t * len)
+{
+    key_head_t head;
+    head.frame_id = frame_id;
+    head.color = color.full;
+    head.src_type = lv_img_src_get_type(src);
+
+    const void * id;
+    size_t id_len;
+    if(head.src_type == LV_IMG_SRC_VARIABLE) {
+        id = &src;
+        id_len = sizeof(src);
+    }
+    else {
+        id = src;
+        id_len = strlen(src);
+    }
+
+    *len = sizeof(key_head_t) + id_len;
+    uint8_t * key = *len <= LV_IMG_CACHE_KEY_BUF_SIZE ? buf : lv_mem_alloc(*len);
+    LV_ASSERT_MALLOC(key);
+    if(key == NULL) return NULL;
+
+    lv_memcpy(key, &head, sizeof(key_head_t));
+    lv_memcpy(key + sizeof(key_head_t), id, id_len);
+    return key;
+}
+
+static void key_free(uint8_t * key, uint8_t * buf)
+{
+    if(key != buf) lv_mem_free(key);
+}
+
+/*Add an opened image to the cache. If it doesn't fit it's marked as temporary.*/
+static void entry_store(_lv_img_cache_entry_t * entry, const uint8_t * key, size_t key_len)
+{
+    entry->temp = 1;
+
+    lv_lru_t * lru = LV_GC_ROOT(_lv_img_cache_lru);
+    if(lru == NULL) return;
+
+    uint16_t cnt_prev = entry_cnt;
+    lruc_error res = LV_LRU_NO_ERROR;
+    if(entry_cnt >= entry_max) res = lv_lru_remove_lru(lru);
+    if(res == LV_LRU_NO_ERROR) res = lv_lru_set(lru, key, key_len, entry, entry->mem_size);
+
+    if(res == LV_LRU_NO_ERROR) {
+        entry->temp = 0;
+        entry_cnt++;
+        LV_LOG_INFO("image draw: cache miss, cached the image");
+    }
+    else {
+        LV_LOG_INFO("image draw: cache miss, the image doesn't fit in the cache");
+    }
+
+    /*The closed entries decremented `entry_cnt`*/
+    cache_stats.evict_cnt += cnt_prev + (entry->temp ? 0 : 1) - entry_cnt;
+}
+
+static void entry_free_cb(void * v)
+{
+    _lv_img_cache_entry_t * entry = v;
+    lv_img_decoder_close(&entry->dec_dsc);
+    lv_mem_free(entry);
+    entry_cnt--;
+}
+
+/*Images difficult to open should live longer to avoid their frequent recaching*/
+static uint32_t entry_priority_cb(void * v)
+{
+    _lv_img_cache_entry_t * entry = v;
+    if(entry->pin_cnt) return LV_LRU_PINNED;
+
+    uint32_t life = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    return LV_MIN(life, LV_IMG_CACHE_LIFE_LIMIT);
+}
+
+static bool entry_match_cb(void * v, void * src)
+{
+    _lv_img_cache_entry_t * entry = v;
+    return src == NULL || lv_img_cache_match(src, entry->dec_dsc.src);
+}
+
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
     lv_img_src_t src_type = lv_img_src_get_type(src1);
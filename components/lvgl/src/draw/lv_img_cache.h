@@ -31,12 +31,27 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    /** Memory charged to the cache for the entry: `dec_dsc.decoded_size` and the entry itself [bytes]*/
+    uint32_t mem_size;
+
+    /** Pinned entries are not closed to make room for other images. See ::lv_img_cache_pin*/
+    uint16_t pin_cnt;
+
+    /** The image doesn't fit in the cache. It's closed by ::_lv_img_cache_cleanup*/
+    uint8_t temp : 1;
 } _lv_img_cache_entry_t;
 
+/**
+ * Counters of the image cache. Can be used to tune `LV_IMG_CACHE_DEF_SIZE` and `LV_IMG_CACHE_MEM_SIZE`.
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of images found in the cache*/
+    uint32_t miss_cnt;      /**< Number of images opened because they were not cached*/
+    uint32_t evict_cnt;     /**< Number of cached images closed to make room for other images*/
+    uint32_t entry_cnt;     /**< Number of currently cached images*/
+    uint32_t mem_used;      /**< Memory used by the currently cached images [bytes]*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -44,7 +59,8 @@ typedef struct {
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
- * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * The image is closed if a new image needs its place in the cache.
+ * Call ::_lv_img_cache_cleanup when the returned entry is not used anymore.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
@@ -53,20 +69,64 @@ typedef struct {
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id);
 
 /**
- * Set the number of images to be cached.
+ * Release an entry returned by ::_lv_img_cache_open. The image is closed if it's not cached.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_cleanup(_lv_img_cache_entry_t * entry);
+
+/**
+ * Set the number of images to be cached. The cached images are closed.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the memory budget of the cached images. The cached images are closed.
+ * Images which don't fit are opened for every draw.
+ * @param mem_size the memory allocated by the decoders and the cache entries in bytes. 0: no limit
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * Pinned images are invalidated too and are not pinned anymore.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Open an image and keep it in the cache until ::lv_img_cache_unpin, even if other images need its place.
+ * Useful to avoid reopening large or slow to open images (e.g. a PNG background).
+ * Pins are counted: an image pinned twice needs to be unpinned twice.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor of the image as drawn (`lv_color_black()` if it's not recolored)
+ * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: couldn't open the image or it doesn't fit in the cache
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color, int32_t frame_id);
+
+/**
+ * Let a pinned image be closed again to make room for other images
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the same as in ::lv_img_cache_pin
+ * @param frame_id the same as in ::lv_img_cache_pin
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color, int32_t frame_id);
+
+/**
+ * Get the counters of the image cache
+ * @param stats store the counters here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -16,7 +16,12 @@
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT
+
+/*The compressed formats start with the number of lines per block (uint16_t) and a reserved uint16_t.
+ *Then the offset of every block and the end of the last block follow (uint32_t, relative to the end of the offsets).
+ *The integers are little endian.*/
+#define COMPRESSED_HEADER_SIZE  4
 
 /**********************
  *      TYPEDEFS
@@ -26,6 +31,10 @@ typedef struct {
     lv_fs_file_t f;
     lv_color_t * palette;
     lv_opa_t * opa;
+    uint8_t * pixels;       /*Decompressed lines of a block or the whole image (compressed formats)*/
+    uint8_t * block_ofs;    /*Offsets of the blocks read from the file (compressed formats)*/
+    int32_t block_act;      /*The block in `pixels` or -1*/
+    uint16_t block_lines;
 } lv_img_decoder_built_in_data_t;
 
 /**********************
@@ -37,6 +46,13 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_line_compressed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                        lv_coord_t len, uint8_t * buf);
+static lv_res_t compressed_open(lv_img_decoder_dsc_t * dsc);
+static lv_res_t compressed_block_decode(lv_img_decoder_dsc_t * dsc, uint32_t block_id, uint8_t * out);
+static bool rle_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size);
+static bool lz4_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size);
+static uint32_t get_u32(const uint8_t * p);
 
 /**********************
  *  STATIC VARIABLES
@@ -156,6 +172,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->decoded_size = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -351,6 +368,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         lv_memcpy_small(&user_data->f, &f, sizeof(f));
+        dsc->decoded_size = sizeof(lv_img_decoder_built_in_data_t);
     }
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         /*The variables should have valid data*/
@@ -361,7 +379,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
     lv_img_cf_t cf = dsc->header.cf;
     /*Process true color formats*/
-    if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+    if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT ||
+       cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
         if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
             /*In case of uncompressed formats the image stored in the ROM/RAM.
              *So simply give its pointer*/
@@ -400,6 +419,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             lv_img_decoder_built_in_close(decoder, dsc);
             return LV_RES_INV;
         }
+        dsc->decoded_size = sizeof(lv_img_decoder_built_in_data_t) + palette_size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
 
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
@@ -430,6 +450,12 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             cf == LV_IMG_CF_ALPHA_8BIT) {
         return LV_RES_OK; /*Nothing to process*/
     }
+    /*Compressed images. Allocate the buffer of the decompressed lines*/
+    else if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE || cf == LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4) {
+        lv_res_t res = compressed_open(dsc);
+        if(res != LV_RES_OK) lv_img_decoder_built_in_close(decoder, dsc);
+        return res;
+    }
     /*Unknown format. Can't decode it.*/
     else {
         /*Free the potentially allocated memories*/
@@ -459,7 +485,7 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
     lv_res_t res = LV_RES_INV;
 
     if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ||
-       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
         /*For TRUE_COLOR images read line required only for files.
          *For variables the image data was returned in `open`*/
         if(dsc->src_type == LV_IMG_SRC_FILE) {
@@ -474,6 +500,9 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
             dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
     }
+    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4) {
+        res = lv_img_decoder_built_in_line_compressed(dsc, x, y, len, buf);
+    }
     else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
@@ -498,6 +527,8 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
         }
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
+        if(user_data->pixels) lv_mem_free(user_data->pixels);
+        if(user_data->block_ofs) lv_mem_free(user_data->block_ofs);
 
         lv_mem_free(user_data);
         dsc->user_data = NULL;
@@ -702,3 +733,301 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
+
+static lv_res_t lv_img_decoder_built_in_line_compressed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                        lv_coord_t len, uint8_t * buf)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(user_data == NULL || user_data->pixels == NULL) return LV_RES_INV;
+
+    uint32_t block_id = y / user_data->block_lines;
+    if(user_data->block_act != (int32_t)block_id) {
+        user_data->block_act = -1;
+        if(compressed_block_decode(dsc, block_id, user_data->pixels) != LV_RES_OK) return LV_RES_INV;
+        user_data->block_act = block_id;
+    }
+
+    uint32_t line = y - block_id * user_data->block_lines;
+    const uint8_t * px = user_data->pixels + (line * dsc->header.w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_memcpy(buf, px, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    return LV_RES_OK;
+}
+
+/**
+ * Check the header of a compressed image and allocate the buffer of the decompressed pixels.
+ * With `LV_IMG_DECOMPRESS_FULL` decompress the whole image and set it as `img_data`.
+ * @param dsc pointer to decoder descriptor. The file is already opened.
+ * @return LV_RES_OK: ok; LV_RES_INV: invalid image or out of memory
+ */
+static lv_res_t compressed_open(lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        LV_ASSERT_MALLOC(dsc->user_data);
+        if(dsc->user_data == NULL) {
+            LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+            return LV_RES_INV;
+        }
+        lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+    }
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    user_data->block_act = -1;
+
+    uint8_t head[COMPRESSED_HEADER_SIZE];
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        uint32_t br = 0;
+        lv_fs_seek(&user_data->f, sizeof(lv_img_header_t), LV_FS_SEEK_SET);
+        lv_fs_res_t res = lv_fs_read(&user_data->f, head, sizeof(head), &br);
+        if(res != LV_FS_RES_OK || br != sizeof(head)) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            return LV_RES_INV;
+        }
+    }
+    else {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        if(img_dsc->data_size < COMPRESSED_HEADER_SIZE) {
+            LV_LOG_WARN("Compressed image: too small data_size");
+            return LV_RES_INV;
+        }
+        lv_memcpy_small(head, img_dsc->data, sizeof(head));
+    }
+
+    user_data->block_lines = head[0] | (head[1] << 8);
+    if(user_data->block_lines == 0 || dsc->header.w == 0 || dsc->header.h == 0) {
+        LV_LOG_WARN("Compressed image: invalid header");
+        return LV_RES_INV;
+    }
+
+    uint32_t block_cnt = (dsc->header.h + user_data->block_lines - 1) / user_data->block_lines;
+    uint32_t ofs_size = (block_cnt + 1) * sizeof(uint32_t);
+    const uint8_t * block_ofs;
+    uint32_t blocks_size;
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        /*Keep the offsets in RAM to not read them for every block*/
+        user_data->block_ofs = lv_mem_alloc(ofs_size);
+        LV_ASSERT_MALLOC(user_data->block_ofs);
+        if(user_data->block_ofs == NULL) {
+            LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+            return LV_RES_INV;
+        }
+        uint32_t br = 0;
+        lv_fs_res_t res = lv_fs_read(&user_data->f, user_data->block_ofs, ofs_size, &br);
+        if(res != LV_FS_RES_OK || br != ofs_size) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            return LV_RES_INV;
+        }
+        block_ofs = user_data->block_ofs;
+        blocks_size = UINT32_MAX;   /*A block beyond the end of the file fails to be read*/
+    }
+    else {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        if(img_dsc->data_size < COMPRESSED_HEADER_SIZE + ofs_size) {
+            LV_LOG_WARN("Compressed image: too small data_size");
+            return LV_RES_INV;
+        }
+        block_ofs = img_dsc->data + COMPRESSED_HEADER_SIZE;
+        blocks_size = img_dsc->data_size - COMPRESSED_HEADER_SIZE - ofs_size;
+    }
+
+    /*The blocks are decoded by their offsets without checking them again*/
+    uint32_t i;
+    uint32_t ofs_prev = 0;
+    for(i = 0; i <= block_cnt; i++) {
+        uint32_t ofs = get_u32(block_ofs + i * 4);
+        if(ofs < ofs_prev || ofs > blocks_size) {
+            LV_LOG_WARN("Compressed image: invalid block offset");
+            return LV_RES_INV;
+        }
+        ofs_prev = ofs;
+    }
+
+#if LV_IMG_DECOMPRESS_FULL
+    uint32_t lines = dsc->header.h;
+#else
+    uint32_t lines = user_data->block_lines < dsc->header.h ? user_data->block_lines : dsc->header.h;
+#endif
+    uint32_t pixels_size = (uint32_t)dsc->header.w * lines * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    user_data->pixels = lv_mem_alloc(pixels_size);
+    LV_ASSERT_MALLOC(user_data->pixels);
+    if(user_data->pixels == NULL) {
+        LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+        return LV_RES_INV;
+    }
+    dsc->decoded_size = sizeof(lv_img_decoder_built_in_data_t) + pixels_size;
+    if(user_data->block_ofs) dsc->decoded_size += ofs_size;
+
+#if LV_IMG_DECOMPRESS_FULL
+    uint32_t block_size = (uint32_t)dsc->header.w * user_data->block_lines * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    for(i = 0; i < block_cnt; i++) {
+        if(compressed_block_decode(dsc, i, user_data->pixels + i * block_size) != LV_RES_OK) return LV_RES_INV;
+    }
+    dsc->img_data = user_data->pixels;
+#endif
+
+    return LV_RES_OK;
+}
+
+/**
+ * Decompress the lines of a block of a compressed image.
+ * @param dsc pointer to decoder descriptor
+ * @param block_id index of the block
+ * @param out store the pixels here (`w * block_lines` pixels, less in the last block)
+ * @return LV_RES_OK: ok; LV_RES_INV: invalid data or read error
+ */
+static lv_res_t compressed_block_decode(lv_img_decoder_dsc_t * dsc, uint32_t block_id, uint8_t * out)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint32_t block_cnt = (dsc->header.h + user_data->block_lines - 1) / user_data->block_lines;
+    uint32_t ofs_size = (block_cnt + 1) * sizeof(uint32_t);
+    uint32_t lines = dsc->header.h - block_id * user_data->block_lines;
+    if(lines > user_data->block_lines) lines = user_data->block_lines;
+    uint32_t out_size = (uint32_t)dsc->header.w * lines * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    const uint8_t * block_ofs;
+    if(dsc->src_type == LV_IMG_SRC_FILE) block_ofs = user_data->block_ofs;
+    else block_ofs = ((lv_img_dsc_t *)dsc->src)->data + COMPRESSED_HEADER_SIZE;
+    /*The offsets were checked in `open`*/
+    uint32_t start = get_u32(block_ofs + block_id * 4);
+    uint32_t end = get_u32(block_ofs + block_id * 4 + 4);
+
+    const uint8_t * in;
+    uint8_t * fs_buf = NULL;
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        fs_buf = lv_mem_buf_get(end - start);
+        if(fs_buf == NULL) return LV_RES_INV;
+        uint32_t br = 0;
+        lv_fs_res_t res = lv_fs_seek(&user_data->f, sizeof(lv_img_header_t) + COMPRESSED_HEADER_SIZE + ofs_size + start,
+                                     LV_FS_SEEK_SET);
+        if(res == LV_FS_RES_OK) res = lv_fs_read(&user_data->f, fs_buf, end - start, &br);
+        if(res != LV_FS_RES_OK || br != end - start) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
+        in = fs_buf;
+    }
+    else {
+        in = block_ofs + ofs_size + start;
+    }
+
+    bool ok;
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE) ok = rle_decompress(in, end - start, out, out_size);
+    else ok = lz4_decompress(in, end - start, out, out_size);
+
+    if(fs_buf) lv_mem_buf_release(fs_buf);
+
+    if(!ok) {
+        LV_LOG_WARN("Compressed image: invalid data");
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+
+/**
+ * Decompress run-length encoded pixels.
+ * A control byte is followed by `(ctrl & 0x7F) + 1` different pixels if the MSB is 0,
+ * or by one pixel which is repeated `(ctrl & 0x7F) + 1` times if the MSB is 1.
+ * @return true: exactly `out_size` bytes were decompressed
+ */
+static bool rle_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size)
+{
+    const uint8_t * in_end = in + in_size;
+    uint8_t * out_end = out + out_size;
+    while(in < in_end) {
+        uint8_t ctrl = *in;
+        in++;
+        uint32_t cnt = (ctrl & 0x7F) + 1;
+        uint32_t bytes = cnt * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        if(bytes > (uint32_t)(out_end - out)) return false;
+
+        if(ctrl & 0x80) {
+            if(LV_IMG_PX_SIZE_ALPHA_BYTE > in_end - in) return false;
+            uint32_t i;
+            for(i = 0; i < cnt; i++) {
+                lv_memcpy_small(out, in, LV_IMG_PX_SIZE_ALPHA_BYTE);
+                out += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            in += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+        else {
+            if(bytes > (uint32_t)(in_end - in)) return false;
+            lv_memcpy(out, in, bytes);
+            out += bytes;
+            in += bytes;
+        }
+    }
+
+    return out == out_end;
+}
+
+/**
+ * Decompress data in the LZ4 block format: sequences of a token, literals and a match.
+ * The upper 4 bits of the token are the number of literals, the lower 4 bits are the length of the match - 4.
+ * 15 means that bytes are added to the length until a byte is not 255.
+ * The literals are followed by the offset of the match (uint16_t, little endian) except in the last sequence.
+ * @return true: exactly `out_size` bytes were decompressed
+ */
+static bool lz4_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size)
+{
+    const uint8_t * in_end = in + in_size;
+    uint8_t * out_start = out;
+    uint8_t * out_end = out + out_size;
+    while(in < in_end) {
+        uint8_t token = *in;
+        in++;
+
+        uint32_t len = token >> 4;
+        if(len == 15) {
+            uint8_t b;
+            do {
+                if(in == in_end) return false;
+                b = *in;
+                in++;
+                len += b;
+            } while(b == 255);
+        }
+        if(len > (uint32_t)(in_end - in) || len > (uint32_t)(out_end - out)) return false;
+        lv_memcpy(out, in, len);
+        out += len;
+        in += len;
+
+        /*The last sequence has only literals*/
+        if(in == in_end) break;
+
+        if(in_end - in < 2) return false;
+        uint32_t ofs = in[0] | (in[1] << 8);
+        in += 2;
+        if(ofs == 0 || ofs > (uint32_t)(out - out_start)) return false;
+
+        len = (token & 0x0F) + 4;
+        if((token & 0x0F) == 15) {
+            uint8_t b;
+            do {
+                if(in == in_end) return false;
+                b = *in;
+                in++;
+                len += b;
+            } while(b == 255);
+        }
+        if(len > (uint32_t)(out_end - out)) return false;
+
+        const uint8_t * match = out - ofs;
+        if(ofs >= len) {
+            lv_memcpy(out, match, len);
+            out += len;
+        }
+        else {
+            /*Overlapping match: repeat the last `ofs` bytes*/
+            uint32_t i;
+            for(i = 0; i < len; i++) out[i] = match[i];
+            out += len;
+        }
+    }
+
+    return out == out_end;
+}
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
@@ -123,6 +123,11 @@ typedef struct _lv_img_decoder_dsc_t {
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
 
+    /** Memory allocated by the decoder for the opened image (e.g. the decoded pixels). [bytes]
+     *  Used by `lv_img_cache` to keep the cached images in `LV_IMG_CACHE_MEM_SIZE`.
+     *  If not set `lv_img_cache` assumes that `img_data` was allocated if it's not the data of the source*/
+    uint32_t decoded_size;
+
     /**A text to display instead of the image when the image can't be opened.
      * Can be set in `open` function or set NULL.*/
     const char * error_msg;
@@ -75,9 +75,6 @@ lv_res_t lv_draw_sdl_img_core(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t
             else {
                 texture = upload_img_texture(renderer, dsc);
             }
-#if LV_IMG_CACHE_DEF_SIZE == 0
-            lv_img_decoder_close(dsc);
-#endif
         }
         if(texture && cdsc) {
             lv_img_header_t * header = SDL_malloc(sizeof(lv_img_header_t));
@@ -87,6 +84,7 @@ lv_res_t lv_draw_sdl_img_core(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t
         else {
             lv_draw_sdl_texture_cache_put(ctx, key, key_size, NULL);
         }
+        if(cdsc) _lv_img_cache_cleanup(cdsc);
     }
     SDL_free(key);
     if(!texture) {
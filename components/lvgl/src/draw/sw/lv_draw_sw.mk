@@ -1,6 +1,7 @@
 CSRCS += lv_draw_sw.c
 CSRCS += lv_draw_sw_arc.c
 CSRCS += lv_draw_sw_blend.c
+CSRCS += lv_draw_sw_blend_kernels.c
 CSRCS += lv_draw_sw_img.c
 CSRCS += lv_draw_sw_letter.c
 CSRCS += lv_draw_sw_line.c
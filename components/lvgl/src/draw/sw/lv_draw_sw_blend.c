@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -38,6 +39,11 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
 LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
 
+#if LV_DRAW_SW_BLEND_KERNELS
+LV_ATTRIBUTE_FAST_MEM static void map_premult(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                              lv_coord_t dest_stride, const uint8_t * src_buf, lv_coord_t src_stride, lv_opa_t opa);
+#endif
+
 #if LV_DRAW_COMPLEX
 static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                         const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -102,7 +108,9 @@ void lv_draw_sw_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * d
 
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
+    LV_PROF_BEGIN(prof);
     ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    LV_PROF_END(LV_PROF_BLEND, prof);
 }
 
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
@@ -134,6 +142,15 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
         src_stride = 0;
     }
 
+#if LV_DRAW_SW_BLEND_KERNELS
+    const uint8_t * src_premult = dsc->src_premult;
+    if(src_premult) {
+        src_stride = lv_area_get_width(dsc->blend_area);
+        src_premult += (src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1)) *
+                       LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+#endif
+
     lv_coord_t mask_stride;
     if(mask) {
         mask_stride = lv_area_get_width(dsc->mask_area);
@@ -154,6 +171,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
             map_set_px(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride);
         }
     }
+#if LV_DRAW_SW_BLEND_KERNELS
+    else if(src_premult) {
+        map_premult(dest_buf, &blend_area, dest_stride, src_premult, src_stride, dsc->opa);
+    }
+#endif
     else if(dsc->src_buf == NULL) {
         if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
             fill_normal(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
@@ -219,7 +241,9 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
+#if LV_DRAW_SW_BLEND_KERNELS == 0
     int32_t x;
+#endif
     int32_t y;
 
     /*No mask*/
@@ -232,6 +256,14 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
+#if LV_DRAW_SW_BLEND_KERNELS
+            LV_UNUSED(disp);
+            const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_get_kernels();
+            for(y = 0; y < h; y++) {
+                kernels->fill_opa(dest_buf, w, color, opa);
+                dest_buf += dest_stride;
+            }
+#else
             lv_color_t last_dest_color = lv_color_black();
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -261,10 +293,20 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
                 }
                 dest_buf += dest_stride;
             }
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
         }
     }
     /*Masked*/
     else {
+#if LV_DRAW_SW_BLEND_KERNELS
+        LV_UNUSED(disp);
+        const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_get_kernels();
+        for(y = 0; y < h; y++) {
+            kernels->fill_mask(dest_buf, w, color, mask, opa);
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+#else
 #if LV_COLOR_DEPTH == 16
         uint32_t c32 = color.full + ((uint32_t)color.full << 16);
 #endif
@@ -357,6 +399,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
                 mask += (mask_stride - w);
             }
         }
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
     }
 }
 
@@ -474,7 +517,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
+#if LV_DRAW_SW_BLEND_KERNELS == 0
     int32_t x;
+#endif
     int32_t y;
 
 #if LV_COLOR_SCREEN_TRANSP
@@ -491,6 +536,14 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
             }
         }
         else {
+#if LV_DRAW_SW_BLEND_KERNELS
+            const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_get_kernels();
+            for(y = 0; y < h; y++) {
+                kernels->map_opa(dest_buf, src_buf, w, opa);
+                dest_buf += dest_stride;
+                src_buf += src_stride;
+            }
+#else
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
 #if LV_COLOR_SCREEN_TRANSP
@@ -507,10 +560,20 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
         }
     }
     /*Masked*/
     else {
+#if LV_DRAW_SW_BLEND_KERNELS
+        const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_get_kernels();
+        for(y = 0; y < h; y++) {
+            kernels->map_mask(dest_buf, src_buf, w, mask, opa);
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+            mask += mask_stride;
+        }
+#else
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             int32_t x_end4 = w - 4;
@@ -594,8 +657,28 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
                 mask += mask_stride;
             }
         }
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
     }
 }
+#if LV_DRAW_SW_BLEND_KERNELS
+LV_ATTRIBUTE_FAST_MEM static void map_premult(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                              lv_coord_t dest_stride, const uint8_t * src_buf, lv_coord_t src_stride, lv_opa_t opa)
+{
+    const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_get_kernels();
+    void (*map_premult_cb)(lv_color_t *, const uint8_t *, int32_t, lv_opa_t) = kernels->map_premult;
+    if(map_premult_cb == NULL) map_premult_cb = lv_draw_sw_blend_kernels_swar.map_premult;
+
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        map_premult_cb(dest_buf, src_buf, w, opa);
+        dest_buf += dest_stride;
+        src_buf += src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+#endif
+
 #if LV_DRAW_COMPLEX
 static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                         const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
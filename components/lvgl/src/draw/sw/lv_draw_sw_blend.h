@@ -22,6 +22,27 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*The normal blending of 16 and 32 bit colors uses the line blending functions of `lv_draw_sw_blend_kernels_t`*/
+#if LV_COLOR_DEPTH == 16 || (LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP == 0)
+#define LV_DRAW_SW_BLEND_KERNELS 1
+#else
+#define LV_DRAW_SW_BLEND_KERNELS 0
+#endif
+
+/*The vector instructions used by `lv_draw_sw_blend_kernels_simd`*/
+#if LV_DRAW_SW_BLEND_KERNELS && LV_USE_DRAW_SW_SIMD && defined(__SSE2__)
+#define LV_DRAW_SW_BLEND_SSE2 1
+#define LV_DRAW_SW_BLEND_NEON 0
+#elif LV_DRAW_SW_BLEND_KERNELS && LV_USE_DRAW_SW_SIMD && defined(__ARM_NEON)
+#define LV_DRAW_SW_BLEND_SSE2 0
+#define LV_DRAW_SW_BLEND_NEON 1
+#else
+#define LV_DRAW_SW_BLEND_SSE2 0
+#define LV_DRAW_SW_BLEND_NEON 0
+#endif
+
+#define LV_DRAW_SW_BLEND_SIMD (LV_DRAW_SW_BLEND_SSE2 || LV_DRAW_SW_BLEND_NEON)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -36,10 +57,42 @@ typedef struct {
     const lv_area_t * mask_area;    /**< The area of `mask_buf` with absolute coordinates*/
     lv_opa_t opa;                   /**< The overall opacity*/
     lv_blend_mode_t blend_mode;     /**< E.g. LV_BLEND_MODE_ADDITIVE*/
+#if LV_DRAW_SW_BLEND_KERNELS
+    const uint8_t * src_premult;    /**< Pixels of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` image to blend instead of
+                                     * `src_buf`. Only `lv_draw_sw_blend_basic()` supports it and only without
+                                     * `mask`, `set_px_cb` and with `LV_BLEND_MODE_NORMAL`*/
+#endif
 } lv_draw_sw_blend_dsc_t;
 
 struct _lv_draw_ctx_t;
 
+#if LV_DRAW_SW_BLEND_KERNELS
+/**
+ * Functions to blend one line of pixels in `LV_BLEND_MODE_NORMAL`.
+ * `mask` and `opa` give the opacity of the pixels the same way as in `lv_draw_sw_blend_dsc_t`.
+ * They all have to give the same result as the `basic` ones.
+ */
+typedef struct {
+    const char * name;
+
+    /** Mix `color` to `w` pixels of `dest` with `opa`. `opa` is smaller than `LV_OPA_MAX`.*/
+    void (*fill_opa)(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa);
+
+    /** Mix `color` to `w` pixels of `dest` with the opacity of the mask and `opa`*/
+    void (*fill_mask)(lv_color_t * dest, int32_t w, lv_color_t color, const lv_opa_t * mask, lv_opa_t opa);
+
+    /** Mix `w` pixels of `src` to `dest` with `opa`. `opa` is smaller than `LV_OPA_MAX`.*/
+    void (*map_opa)(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa);
+
+    /** Mix `w` pixels of `src` to `dest` with the opacity of the mask and `opa`*/
+    void (*map_mask)(lv_color_t * dest, const lv_color_t * src, int32_t w, const lv_opa_t * mask, lv_opa_t opa);
+
+    /** Blend `w` pixels of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` image to `dest` as `src + dest * (255 - alpha)`
+     * (scaled by `opa` if it's smaller than `LV_OPA_MAX`). Can be NULL to use the `swar` one.*/
+    void (*map_premult)(lv_color_t * dest, const uint8_t * src, int32_t w, lv_opa_t opa);
+} lv_draw_sw_blend_kernels_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -58,6 +111,46 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 
+#if LV_DRAW_SW_BLEND_KERNELS
+
+/**
+ * Select the fastest line blending functions available on the CPU. Called by `lv_init()`.
+ */
+void _lv_draw_sw_blend_kernels_init(void);
+
+/**
+ * Set the line blending functions used by `lv_draw_sw_blend_basic()`, e.g. to use a platform specific
+ * implementation (like the PIE instructions of the ESP32-S3).
+ * Should be called when nothing is being rendered.
+ * @param kernels   pointer to a static kernel set or NULL to select the default again
+ */
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels);
+
+/**
+ * Get the line blending functions used by `lv_draw_sw_blend_basic()`
+ * @return          pointer to the current kernel set
+ */
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void);
+
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
+
+/**********************
+ * GLOBAL VARIABLES
+ **********************/
+
+#if LV_DRAW_SW_BLEND_KERNELS
+/*Mixes the pixels one by one with `lv_color_mix()`*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_basic;
+
+/*Mixes more color channels (and pixels) in one integer*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_swar;
+
+#if LV_DRAW_SW_BLEND_SIMD
+/*Uses SSE2 or NEON instructions*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_simd;
+#endif
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
+
 /**********************
  *      MACROS
  **********************/
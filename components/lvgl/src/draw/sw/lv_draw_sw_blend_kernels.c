@@ -0,0 +1,1046 @@
+/**
+ * @file lv_draw_sw_blend_kernels.c
+ * Line blending functions of the normal blend mode for 16 and 32 bit colors.
+ * All of them give the same result as `lv_color_mix()`, they just mix more channels or pixels at once.
+ * `map_premult` blends pre-multiplied pixels instead: `src + dest * (255 - alpha) / 255` rounded down.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend.h"
+
+#if LV_DRAW_SW_BLEND_KERNELS
+
+#include "../lv_img_buf.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_mem.h"
+
+#if LV_DRAW_SW_BLEND_SSE2
+    #include <emmintrin.h>
+#elif LV_DRAW_SW_BLEND_NEON
+    #include <arm_neon.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The rounding offset of `lv_color_mix()` in both half-words*/
+#define OFS_X2      ((uint32_t)LV_COLOR_MIX_ROUND_OFS * 0x00010001U)
+
+/*Divide the two half-words of `x` by 255. The same as `LV_UDIV255` for values < 65535.*/
+#define DIV255_X2(x)    ((((x) + 0x00010001U + (((x) >> 8) & 0x00FF00FFU)) >> 8) & 0x00FF00FFU)
+
+/*The alpha byte of the `i`th pixel of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` line*/
+#define PREMULT_A(src, i)   ((src)[(i) * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1])
+
+#if LV_COLOR_DEPTH == 16
+/*Convert between `lv_color_t` and RGB565*/
+#if LV_COLOR_16_SWAP
+    #define SWAP16(c)       ((uint16_t)(((c) >> 8) | ((c) << 8)))
+    #define SWAP16_X2(c)    ((((c) >> 8) & 0x00FF00FFU) | (((c) << 8) & 0xFF00FF00U))
+#else
+    #define SWAP16(c)       (c)
+    #define SWAP16_X2(c)    (c)
+#endif
+
+/*Red and blue of an RGB565 color in the two half-words*/
+#define RB565(c)    ((((c) & 0xF800U) << 5) | ((c) & 0x1FU))
+#define G565(c)     (((c) >> 5) & 0x3FU)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_basic(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_basic(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                  const lv_opa_t * mask, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_opa_basic(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_mask_basic(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                 const lv_opa_t * mask, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_premult_basic(lv_color_t * dest, const uint8_t * src, int32_t w, lv_opa_t opa);
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_swar(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_swar(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_mask_swar(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_premult_swar(lv_color_t * dest, const uint8_t * src, int32_t w, lv_opa_t opa);
+
+#if LV_DRAW_SW_BLEND_SIMD
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_simd(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_simd(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_opa_simd(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void map_mask_simd(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_draw_sw_blend_kernels_t * kernels_act = &lv_draw_sw_blend_kernels_swar;
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_basic = {
+    .name = "basic",
+    .fill_opa = fill_opa_basic,
+    .fill_mask = fill_mask_basic,
+    .map_opa = map_opa_basic,
+    .map_mask = map_mask_basic,
+    .map_premult = map_premult_basic,
+};
+
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_swar = {
+    .name = "swar",
+    .fill_opa = fill_opa_swar,
+    .fill_mask = fill_mask_swar,
+    .map_opa = map_opa_swar,
+    .map_mask = map_mask_swar,
+    .map_premult = map_premult_swar,
+};
+
+#if LV_DRAW_SW_BLEND_SIMD
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_simd = {
+#if LV_DRAW_SW_BLEND_SSE2
+    .name = "sse2",
+#else
+    .name = "neon",
+#endif
+    .fill_opa = fill_opa_simd,
+    .fill_mask = fill_mask_simd,
+    .map_opa = map_opa_simd,
+    .map_mask = map_mask_simd,
+    .map_premult = map_premult_swar,    /*Reading the 3 byte pixels is slower than blending them*/
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_draw_sw_blend_kernels_init(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    kernels_act = &lv_draw_sw_blend_kernels_simd;
+#else
+    kernels_act = &lv_draw_sw_blend_kernels_swar;
+#endif
+}
+
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels)
+{
+    if(kernels) kernels_act = kernels;
+    else _lv_draw_sw_blend_kernels_init();
+}
+
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void)
+{
+    return kernels_act;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The opacity of a pixel in `fill_mask` (see `fill_normal()`)*/
+static inline lv_opa_t fill_mask_opa(lv_opa_t mask, lv_opa_t opa)
+{
+    if(opa >= LV_OPA_MAX) return mask;
+    return mask == LV_OPA_COVER ? opa : (lv_opa_t)(((uint32_t)mask * opa) >> 8);
+}
+
+/*The opacity of a pixel in `map_mask` (see `map_normal()`)*/
+static inline lv_opa_t map_mask_opa(lv_opa_t mask, lv_opa_t opa)
+{
+    if(opa > LV_OPA_MAX) return mask;
+    return mask >= LV_OPA_MAX ? opa : (lv_opa_t)(((uint32_t)mask * opa) >> 8);
+}
+
+/*Get a pixel of an `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` image without the alpha byte*/
+static inline uint32_t premult_get_px(const uint8_t * px)
+{
+#if LV_COLOR_DEPTH == 16
+    return px[0] | ((uint32_t)px[1] << 8);
+#else
+    return 0xFF000000U | px[0] | ((uint32_t)px[1] << 8) | ((uint32_t)px[2] << 16);
+#endif
+}
+
+/*The inverse opacity of the background of a pre-multiplied pixel scaled by `opa`.
+ *The opacity is rounded up to keep `src * opa / 255 + dest * (255 - opa_act) / 255` in range.*/
+static inline uint32_t premult_opa_inv(lv_opa_t a, lv_opa_t opa)
+{
+    return 255 - LV_UDIV255((uint32_t)a * opa + 254);
+}
+
+/*=====================
+ * Basic
+ *====================*/
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_basic(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
+
+    /*Buffer the result color to avoid recalculating the same color*/
+    lv_color_t last_dest_color = dest[0];
+    lv_color_t last_res_color = lv_color_mix_premult(color_premult, dest[0], opa_inv);
+
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        if(last_dest_color.full != dest[x].full) {
+            last_dest_color = dest[x];
+            last_res_color = lv_color_mix_premult(color_premult, dest[x], opa_inv);
+        }
+        dest[x] = last_res_color;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_basic(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                  const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t opa_tmp = fill_mask_opa(mask[x], opa);
+        if(opa_tmp == LV_OPA_TRANSP) continue;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = color;
+        else dest[x] = lv_color_mix(color, dest[x], opa_tmp);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_basic(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        dest[x] = lv_color_mix(src[x], dest[x], opa);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_basic(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t opa_tmp = map_mask_opa(mask[x], opa);
+        if(opa_tmp == LV_OPA_TRANSP) continue;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = src[x];
+        else dest[x] = lv_color_mix(src[x], dest[x], opa_tmp);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_premult_basic(lv_color_t * dest, const uint8_t * src, int32_t w, lv_opa_t opa)
+{
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    int32_t x;
+    for(x = 0; x < w; x++, src += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+        lv_opa_t a = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        if(a == LV_OPA_TRANSP) continue;
+
+        lv_color_t c;
+        c.full = premult_get_px(src);
+        if(a == LV_OPA_COVER && opa == LV_OPA_COVER) {
+            dest[x] = c;
+            continue;
+        }
+
+        /*With `opa == LV_OPA_COVER` it's `src + dest * (255 - a) / 255`*/
+        /*Mix every channel before setting any: with `LV_COLOR_16_SWAP` setting green reads it again*/
+        uint32_t a_inv = premult_opa_inv(a, opa);
+        uint32_t r = LV_UDIV255((uint32_t)LV_COLOR_GET_R(c) * opa + LV_COLOR_GET_R(dest[x]) * a_inv);
+        uint32_t g = LV_UDIV255((uint32_t)LV_COLOR_GET_G(c) * opa + LV_COLOR_GET_G(dest[x]) * a_inv);
+        uint32_t b = LV_UDIV255((uint32_t)LV_COLOR_GET_B(c) * opa + LV_COLOR_GET_B(dest[x]) * a_inv);
+        LV_COLOR_SET_R(dest[x], r);
+        LV_COLOR_SET_G(dest[x], g);
+        LV_COLOR_SET_B(dest[x], b);
+        LV_COLOR_SET_A(dest[x], 0xFF);
+    }
+}
+
+/*=====================
+ * SWAR
+ *====================*/
+
+#if LV_COLOR_DEPTH == 16
+
+/*Mix two RGB565 colors like `lv_color_mix()` with 8 bit channels does. Red and blue are mixed together.*/
+static inline uint32_t mix565(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    uint32_t mix_inv = 255 - mix;
+    uint32_t rb = RB565(fg) * mix + RB565(bg) * mix_inv + OFS_X2;
+    uint32_t g = G565(fg) * mix + G565(bg) * mix_inv + LV_COLOR_MIX_ROUND_OFS;
+    rb = DIV255_X2(rb);
+    g = DIV255_X2(g);
+    return ((rb >> 5) & 0xF800U) | (g << 5) | (rb & 0x1FU);
+}
+
+/*Multiply the channels of the two RGB565 colors in the half-words of `c2` with `mix`*/
+static inline void premult565_x2(uint32_t c2, uint32_t mix, uint32_t * premult)
+{
+    premult[0] = ((c2 >> 11) & 0x001F001FU) * mix + OFS_X2;
+    premult[1] = ((c2 >> 5) & 0x003F003FU) * mix + OFS_X2;
+    premult[2] = (c2 & 0x001F001FU) * mix + OFS_X2;
+}
+
+/*Mix the two RGB565 colors in the half-words of `bg2` to pre-multiplied colors with 8 bit precision*/
+static inline uint32_t mix565_premult_x2(const uint32_t * premult, uint32_t bg2, uint32_t mix_inv)
+{
+    uint32_t r = premult[0] + ((bg2 >> 11) & 0x001F001FU) * mix_inv;
+    uint32_t g = premult[1] + ((bg2 >> 5) & 0x003F003FU) * mix_inv;
+    uint32_t b = premult[2] + (bg2 & 0x001F001FU) * mix_inv;
+    return (DIV255_X2(r) << 11) | (DIV255_X2(g) << 5) | DIV255_X2(b);
+}
+
+#if LV_COLOR_16_SWAP == 0
+/*Mix the two RGB565 colors in the half-words with 5 bit precision like `lv_color_mix()` does it*/
+static inline uint32_t mix565_5bit_x2(uint32_t fg2, uint32_t bg2, uint32_t mix)
+{
+    mix = (mix + 4) >> 3;
+    uint32_t mix_inv = 32 - mix;
+    uint32_t r = ((((fg2 >> 11) & 0x001F001FU) * mix + ((bg2 >> 11) & 0x001F001FU) * mix_inv) >> 5) & 0x001F001FU;
+    uint32_t g = ((((fg2 >> 5) & 0x003F003FU) * mix + ((bg2 >> 5) & 0x003F003FU) * mix_inv) >> 5) & 0x003F003FU;
+    uint32_t b = (((fg2 & 0x001F001FU) * mix + (bg2 & 0x001F001FU) * mix_inv) >> 5) & 0x001F001FU;
+    return (r << 11) | (g << 5) | b;
+}
+#endif
+
+static inline uint32_t get_px_x2(const lv_color_t * buf)
+{
+    return buf[0].full | ((uint32_t)buf[1].full << 16);
+}
+
+static inline void set_px_x2(lv_color_t * buf, uint32_t c2)
+{
+    buf[0].full = (uint16_t)c2;
+    buf[1].full = (uint16_t)(c2 >> 16);
+}
+
+#elif LV_COLOR_DEPTH == 32
+
+/*Mix an ARGB8888 color to pre-multiplied colors. Red and blue are mixed together.*/
+static inline uint32_t mix32_premult(uint32_t premult_rb, uint32_t premult_g, uint32_t bg, uint32_t mix_inv)
+{
+    uint32_t rb = premult_rb + (bg & 0x00FF00FFU) * mix_inv;
+    uint32_t g = premult_g + ((bg >> 8) & 0xFFU) * mix_inv;
+    return 0xFF000000U | DIV255_X2(rb) | (DIV255_X2(g) << 8);
+}
+
+static inline uint32_t mix32(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    return mix32_premult((fg & 0x00FF00FFU) * mix + OFS_X2, ((fg >> 8) & 0xFFU) * mix + LV_COLOR_MIX_ROUND_OFS,
+                         bg, 255 - mix);
+}
+
+#endif
+
+/*Mix two colors exactly like `lv_color_mix()`*/
+static inline lv_color_t mix_px(lv_color_t fg, lv_color_t bg, lv_opa_t mix)
+{
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    /*It already mixes the channels in one integer*/
+    return lv_color_mix(fg, bg, mix);
+#else
+    lv_color_t ret;
+#if LV_COLOR_DEPTH == 16
+    ret.full = SWAP16(mix565(SWAP16(fg.full), SWAP16(bg.full), mix));
+#else
+    ret.full = mix32(fg.full, bg.full, mix);
+#endif
+    return ret;
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_swar(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    uint32_t opa_inv = 255 - opa;
+    int32_t x = 0;
+
+#if LV_COLOR_DEPTH == 16
+    /*Mix 2 pixels at once and reuse the result for the same background pixels*/
+    uint32_t c = SWAP16(color.full);
+    uint32_t premult[3];
+    premult565_x2(c | (c << 16), opa, premult);
+
+    uint32_t last_dest = 0;
+    uint32_t last_res = SWAP16_X2(mix565_premult_x2(premult, 0, opa_inv));
+    for(; x < w - 1; x += 2) {
+        uint32_t d = get_px_x2(&dest[x]);
+        if(d != last_dest) {
+            last_dest = d;
+            last_res = SWAP16_X2(mix565_premult_x2(premult, SWAP16_X2(d), opa_inv));
+        }
+        set_px_x2(&dest[x], last_res);
+    }
+
+    if(x < w) {
+        dest[x].full = (uint16_t)SWAP16_X2(mix565_premult_x2(premult, SWAP16_X2((uint32_t)dest[x].full), opa_inv));
+    }
+#else
+    uint32_t premult_rb = (color.full & 0x00FF00FFU) * opa + OFS_X2;
+    uint32_t premult_g = ((color.full >> 8) & 0xFFU) * opa + LV_COLOR_MIX_ROUND_OFS;
+
+    uint32_t last_dest = dest[0].full;
+    uint32_t last_res = mix32_premult(premult_rb, premult_g, last_dest, opa_inv);
+    for(; x < w; x++) {
+        if(dest[x].full != last_dest) {
+            last_dest = dest[x].full;
+            last_res = mix32_premult(premult_rb, premult_g, last_dest, opa_inv);
+        }
+        dest[x].full = last_res;
+    }
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_swar(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t opa_tmp = fill_mask_opa(mask[x], opa);
+        if(opa_tmp == LV_OPA_TRANSP) continue;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = color;
+        else dest[x] = mix_px(color, dest[x], opa_tmp);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    int32_t x = 0;
+
+#if LV_COLOR_DEPTH == 16
+    /*Mix 2 pixels at once*/
+#if LV_COLOR_16_SWAP
+    uint32_t opa_inv = 255 - opa;
+    for(; x < w - 1; x += 2) {
+        uint32_t premult[3];
+        premult565_x2(SWAP16_X2(get_px_x2(&src[x])), opa, premult);
+        set_px_x2(&dest[x], SWAP16_X2(mix565_premult_x2(premult, SWAP16_X2(get_px_x2(&dest[x])), opa_inv)));
+    }
+#else
+    for(; x < w - 1; x += 2) {
+        set_px_x2(&dest[x], mix565_5bit_x2(get_px_x2(&src[x]), get_px_x2(&dest[x]), opa));
+    }
+#endif
+#endif
+
+    for(; x < w; x++) {
+        dest[x] = mix_px(src[x], dest[x], opa);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_swar(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t opa_tmp = map_mask_opa(mask[x], opa);
+        if(opa_tmp == LV_OPA_TRANSP) continue;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = src[x];
+        else dest[x] = mix_px(src[x], dest[x], opa_tmp);
+    }
+}
+
+/*Blend a pre-multiplied pixel to `dest` with `a_inv = 255 - alpha`*/
+static inline uint32_t premult_px(uint32_t src, uint32_t dest, uint32_t a_inv)
+{
+#if LV_COLOR_DEPTH == 16
+    /*The channels can be simply added as their sum is in range*/
+    dest = SWAP16(dest);
+    uint32_t rb = DIV255_X2(RB565(dest) * a_inv);
+    uint32_t g = DIV255_X2(G565(dest) * a_inv);
+    return SWAP16(((rb >> 5) & 0xF800U) + (g << 5) + (rb & 0x1FU) + SWAP16(src));
+#else
+    uint32_t rb = DIV255_X2((dest & 0x00FF00FFU) * a_inv);
+    uint32_t g = DIV255_X2(((dest >> 8) & 0xFFU) * a_inv);
+    return (rb | (g << 8)) + src;
+#endif
+}
+
+/*Blend a pre-multiplied pixel to `dest` with `opa` and `a_inv = 255 - alpha * opa / 255`*/
+static inline uint32_t premult_px_opa(uint32_t src, uint32_t dest, uint32_t opa, uint32_t a_inv)
+{
+#if LV_COLOR_DEPTH == 16
+    src = SWAP16(src);
+    dest = SWAP16(dest);
+    uint32_t rb = DIV255_X2(RB565(src) * opa + RB565(dest) * a_inv);
+    uint32_t g = DIV255_X2(G565(src) * opa + G565(dest) * a_inv);
+    return SWAP16(((rb >> 5) & 0xF800U) | (g << 5) | (rb & 0x1FU));
+#else
+    uint32_t rb = DIV255_X2((src & 0x00FF00FFU) * opa + (dest & 0x00FF00FFU) * a_inv);
+    uint32_t g = DIV255_X2(((src >> 8) & 0xFFU) * opa + ((dest >> 8) & 0xFFU) * a_inv);
+    return 0xFF000000U | rb | (g << 8);
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_premult_swar(lv_color_t * dest, const uint8_t * src, int32_t w, lv_opa_t opa)
+{
+    int32_t x = 0;
+
+    if(opa <= LV_OPA_MAX) {
+        /*The same as `premult_opa_inv(LV_OPA_COVER, opa)`*/
+        uint32_t opa_inv = 255 - opa;
+        for(; x < w; x++) {
+            lv_opa_t a = PREMULT_A(src, x);
+            if(a == LV_OPA_TRANSP) continue;
+            uint32_t a_inv = a == LV_OPA_COVER ? opa_inv : premult_opa_inv(a, opa);
+            uint32_t c = premult_get_px(&src[x * LV_IMG_PX_SIZE_ALPHA_BYTE]);
+            dest[x].full = premult_px_opa(c, dest[x].full, opa, a_inv);
+        }
+        return;
+    }
+
+    while(x < w) {
+        /*Skip the transparent pixels*/
+        while(x < w && PREMULT_A(src, x) == LV_OPA_TRANSP) x++;
+
+        /*Copy the opaque pixels*/
+        while(x < w && PREMULT_A(src, x) == LV_OPA_COVER) {
+            dest[x].full = premult_get_px(&src[x * LV_IMG_PX_SIZE_ALPHA_BYTE]);
+            x++;
+        }
+
+        /*Blend the semi-transparent pixels*/
+        while(x < w) {
+            lv_opa_t a = PREMULT_A(src, x);
+            if(a == LV_OPA_TRANSP || a == LV_OPA_COVER) break;
+            dest[x].full = premult_px(premult_get_px(&src[x * LV_IMG_PX_SIZE_ALPHA_BYTE]), dest[x].full, 255 - a);
+            x++;
+        }
+    }
+}
+
+/*=====================
+ * SIMD
+ *====================*/
+
+#if LV_DRAW_SW_BLEND_SIMD
+
+/*8 mask values are processed at once*/
+static inline uint64_t get_mask_x8(const lv_opa_t * mask)
+{
+    uint64_t m;
+    lv_memcpy_small(&m, mask, sizeof(m));
+    return m;
+}
+
+#endif
+
+#if LV_DRAW_SW_BLEND_SSE2
+
+/*Divide the 16 bit lanes by 255. The same as `LV_UDIV255` for values < 65535.*/
+static inline __m128i div255_sse2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(x, 8))), 8);
+}
+
+/*Get the opacity of 8 pixels in 16 bit lanes*/
+static inline __m128i fill_mask_opa_sse2(const lv_opa_t * mask, lv_opa_t opa)
+{
+    __m128i m = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+    if(opa >= LV_OPA_MAX) return m;
+
+    __m128i opa_v = _mm_set1_epi16(opa);
+    __m128i scaled = _mm_srli_epi16(_mm_mullo_epi16(m, opa_v), 8);
+    __m128i cover = _mm_cmpeq_epi16(m, _mm_set1_epi16(LV_OPA_COVER));
+    return _mm_or_si128(_mm_and_si128(cover, opa_v), _mm_andnot_si128(cover, scaled));
+}
+
+static inline __m128i map_mask_opa_sse2(const lv_opa_t * mask, lv_opa_t opa)
+{
+    __m128i m = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+    if(opa > LV_OPA_MAX) return m;
+
+    __m128i opa_v = _mm_set1_epi16(opa);
+    __m128i scaled = _mm_srli_epi16(_mm_mullo_epi16(m, opa_v), 8);
+    __m128i cover = _mm_cmpgt_epi16(m, _mm_set1_epi16(LV_OPA_MAX - 1));
+    return _mm_or_si128(_mm_and_si128(cover, opa_v), _mm_andnot_si128(cover, scaled));
+}
+
+#if LV_COLOR_DEPTH == 16
+
+static inline __m128i swap_sse2(__m128i c)
+{
+#if LV_COLOR_16_SWAP
+    return _mm_or_si128(_mm_srli_epi16(c, 8), _mm_slli_epi16(c, 8));
+#else
+    return c;
+#endif
+}
+
+/*Mix 8 RGB565 colors with the opacities in the 16 bit lanes of `mix` with 8 bit precision*/
+static inline __m128i mix565_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+    __m128i ofs = _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+    __m128i mask6 = _mm_set1_epi16(0x3F);
+    __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), mix_inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), mask6), mix),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), mask6), mix_inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, mask5), mix),
+                              _mm_mullo_epi16(_mm_and_si128(bg, mask5), mix_inv));
+
+    r = div255_sse2(_mm_add_epi16(r, ofs));
+    g = div255_sse2(_mm_add_epi16(g, ofs));
+    b = div255_sse2(_mm_add_epi16(b, ofs));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+/*Mix like `lv_color_mix()`*/
+static inline __m128i mix_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+#if LV_COLOR_16_SWAP
+    return swap_sse2(mix565_sse2(swap_sse2(fg), swap_sse2(bg), mix));
+#else
+    /*5 bit precision*/
+    __m128i mix5 = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+    __m128i mix5_inv = _mm_sub_epi16(_mm_set1_epi16(32), mix5);
+    __m128i mask6 = _mm_set1_epi16(0x3F);
+    __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix5),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), mix5_inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), mask6), mix5),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), mask6), mix5_inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, mask5), mix5),
+                              _mm_mullo_epi16(_mm_and_si128(bg, mask5), mix5_inv));
+
+    r = _mm_srli_epi16(r, 5);
+    g = _mm_and_si128(_mm_srli_epi16(g, 5), mask6);
+    b = _mm_and_si128(_mm_srli_epi16(b, 5), mask5);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_simd(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    __m128i fg = _mm_set1_epi16((short)SWAP16(color.full));
+    __m128i mix = _mm_set1_epi16(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], swap_sse2(mix565_sse2(fg, swap_sse2(bg), mix)));
+    }
+    if(x < w) fill_opa_swar(&dest[x], w - x, color, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_simd(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    __m128i fg = _mm_set1_epi16((short)color.full);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        if(m == UINT64_MAX && opa >= LV_OPA_MAX) {
+            _mm_storeu_si128((__m128i *)&dest[x], fg);
+            continue;
+        }
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_sse2(fg, bg, fill_mask_opa_sse2(&mask[x], opa)));
+    }
+    if(x < w) fill_mask_swar(&dest[x], w - x, color, &mask[x], opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_simd(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    __m128i mix = _mm_set1_epi16(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        __m128i fg = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_sse2(fg, bg, mix));
+    }
+    if(x < w) map_opa_swar(&dest[x], &src[x], w - x, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_simd(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        __m128i fg = _mm_loadu_si128((const __m128i *)&src[x]);
+        if(m == UINT64_MAX && opa > LV_OPA_MAX) {
+            _mm_storeu_si128((__m128i *)&dest[x], fg);
+            continue;
+        }
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_sse2(fg, bg, map_mask_opa_sse2(&mask[x], opa)));
+    }
+    if(x < w) map_mask_swar(&dest[x], &src[x], w - x, mask + x, opa);
+}
+
+#else /*LV_COLOR_DEPTH == 32*/
+
+/*Mix 4 ARGB8888 colors with the opacities in the 32 bit lanes of `mix` like `lv_color_mix()`*/
+static inline __m128i mix_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i ofs = _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+
+    /*The opacity of every channel of 2 pixels*/
+    __m128i mix16 = _mm_or_si128(mix, _mm_slli_epi32(mix, 16));
+    __m128i mix_lo = _mm_unpacklo_epi32(mix16, mix16);
+    __m128i mix_hi = _mm_unpackhi_epi32(mix16, mix16);
+    __m128i mix_max = _mm_set1_epi16(255);
+
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(mix_max, mix_lo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(mix_max, mix_hi)));
+    lo = div255_sse2(_mm_add_epi16(lo, ofs));
+    hi = div255_sse2(_mm_add_epi16(hi, ofs));
+
+    return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32((int)0xFF000000));
+}
+
+/*Mix like the masked kernels: keep `bg` with 0 and use `fg` with 255 opacity*/
+static inline __m128i mix_masked_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i res = mix_sse2(fg, bg, mix);
+    __m128i transp = _mm_cmpeq_epi32(mix, _mm_setzero_si128());
+    __m128i cover = _mm_cmpeq_epi32(mix, _mm_set1_epi32(LV_OPA_COVER));
+    res = _mm_andnot_si128(_mm_or_si128(transp, cover), res);
+    return _mm_or_si128(res, _mm_or_si128(_mm_and_si128(transp, bg), _mm_and_si128(cover, fg)));
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_simd(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    __m128i fg = _mm_set1_epi32((int)color.full);
+    __m128i mix = _mm_set1_epi32(opa);
+    int32_t x;
+    for(x = 0; x < w - 3; x += 4) {
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_sse2(fg, bg, mix));
+    }
+    if(x < w) fill_opa_swar(&dest[x], w - x, color, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_simd(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    __m128i fg = _mm_set1_epi32((int)color.full);
+    __m128i zero = _mm_setzero_si128();
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        if(m == UINT64_MAX && opa >= LV_OPA_MAX) {
+            _mm_storeu_si128((__m128i *)&dest[x], fg);
+            _mm_storeu_si128((__m128i *)&dest[x + 4], fg);
+            continue;
+        }
+        __m128i mix = fill_mask_opa_sse2(&mask[x], opa);
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_masked_sse2(fg, bg, _mm_unpacklo_epi16(mix, zero)));
+        bg = _mm_loadu_si128((const __m128i *)&dest[x + 4]);
+        _mm_storeu_si128((__m128i *)&dest[x + 4], mix_masked_sse2(fg, bg, _mm_unpackhi_epi16(mix, zero)));
+    }
+    if(x < w) fill_mask_swar(&dest[x], w - x, color, &mask[x], opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_simd(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    __m128i mix = _mm_set1_epi32(opa);
+    int32_t x;
+    for(x = 0; x < w - 3; x += 4) {
+        __m128i fg = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_sse2(fg, bg, mix));
+    }
+    if(x < w) map_opa_swar(&dest[x], &src[x], w - x, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_simd(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa)
+{
+    __m128i zero = _mm_setzero_si128();
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        __m128i fg_lo = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i fg_hi = _mm_loadu_si128((const __m128i *)&src[x + 4]);
+        if(m == UINT64_MAX && opa > LV_OPA_MAX) {
+            _mm_storeu_si128((__m128i *)&dest[x], fg_lo);
+            _mm_storeu_si128((__m128i *)&dest[x + 4], fg_hi);
+            continue;
+        }
+        __m128i mix = map_mask_opa_sse2(&mask[x], opa);
+        __m128i bg = _mm_loadu_si128((const __m128i *)&dest[x]);
+        _mm_storeu_si128((__m128i *)&dest[x], mix_masked_sse2(fg_lo, bg, _mm_unpacklo_epi16(mix, zero)));
+        bg = _mm_loadu_si128((const __m128i *)&dest[x + 4]);
+        _mm_storeu_si128((__m128i *)&dest[x + 4], mix_masked_sse2(fg_hi, bg, _mm_unpackhi_epi16(mix, zero)));
+    }
+    if(x < w) map_mask_swar(&dest[x], &src[x], w - x, &mask[x], opa);
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+#elif LV_DRAW_SW_BLEND_NEON
+
+/*Divide the 16 bit lanes by 255. The same as `LV_UDIV255` for values < 65535.*/
+static inline uint16x8_t div255_neon(uint16x8_t x)
+{
+    return vshrq_n_u16(vaddq_u16(x, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(x, 8))), 8);
+}
+
+/*Get the opacity of 8 pixels*/
+static inline uint8x8_t fill_mask_opa_neon(const lv_opa_t * mask, lv_opa_t opa)
+{
+    uint8x8_t m = vld1_u8(mask);
+    if(opa >= LV_OPA_MAX) return m;
+
+    uint8x8_t opa_v = vdup_n_u8(opa);
+    uint8x8_t scaled = vshrn_n_u16(vmull_u8(m, opa_v), 8);
+    return vbsl_u8(vceq_u8(m, vdup_n_u8(LV_OPA_COVER)), opa_v, scaled);
+}
+
+static inline uint8x8_t map_mask_opa_neon(const lv_opa_t * mask, lv_opa_t opa)
+{
+    uint8x8_t m = vld1_u8(mask);
+    if(opa > LV_OPA_MAX) return m;
+
+    uint8x8_t opa_v = vdup_n_u8(opa);
+    uint8x8_t scaled = vshrn_n_u16(vmull_u8(m, opa_v), 8);
+    return vbsl_u8(vcge_u8(m, vdup_n_u8(LV_OPA_MAX)), opa_v, scaled);
+}
+
+#if LV_COLOR_DEPTH == 16
+
+static inline uint16x8_t swap_neon(uint16x8_t c)
+{
+#if LV_COLOR_16_SWAP
+    return vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(c)));
+#else
+    return c;
+#endif
+}
+
+/*Mix 8 RGB565 colors with the opacities in the 16 bit lanes of `mix` with 8 bit precision*/
+static inline uint16x8_t mix565_neon(uint16x8_t fg, uint16x8_t bg, uint16x8_t mix)
+{
+    uint16x8_t mix_inv = vsubq_u16(vdupq_n_u16(255), mix);
+    uint16x8_t ofs = vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS);
+    uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t mask5 = vdupq_n_u16(0x1F);
+
+    uint16x8_t r = vmlaq_u16(vmlaq_u16(ofs, vshrq_n_u16(fg, 11), mix), vshrq_n_u16(bg, 11), mix_inv);
+    uint16x8_t g = vmlaq_u16(vmlaq_u16(ofs, vandq_u16(vshrq_n_u16(fg, 5), mask6), mix),
+                             vandq_u16(vshrq_n_u16(bg, 5), mask6), mix_inv);
+    uint16x8_t b = vmlaq_u16(vmlaq_u16(ofs, vandq_u16(fg, mask5), mix), vandq_u16(bg, mask5), mix_inv);
+
+    r = div255_neon(r);
+    g = div255_neon(g);
+    b = div255_neon(b);
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+}
+
+/*Mix like `lv_color_mix()`*/
+static inline uint16x8_t mix_neon(uint16x8_t fg, uint16x8_t bg, uint16x8_t mix)
+{
+#if LV_COLOR_16_SWAP
+    return swap_neon(mix565_neon(swap_neon(fg), swap_neon(bg), mix));
+#else
+    /*5 bit precision*/
+    uint16x8_t mix5 = vshrq_n_u16(vaddq_u16(mix, vdupq_n_u16(4)), 3);
+    uint16x8_t mix5_inv = vsubq_u16(vdupq_n_u16(32), mix5);
+    uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t mask5 = vdupq_n_u16(0x1F);
+
+    uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(fg, 11), mix5), vshrq_n_u16(bg, 11), mix5_inv);
+    uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(fg, 5), mask6), mix5),
+                             vandq_u16(vshrq_n_u16(bg, 5), mask6), mix5_inv);
+    uint16x8_t b = vmlaq_u16(vmulq_u16(vandq_u16(fg, mask5), mix5), vandq_u16(bg, mask5), mix5_inv);
+
+    r = vshrq_n_u16(r, 5);
+    g = vandq_u16(vshrq_n_u16(g, 5), mask6);
+    b = vandq_u16(vshrq_n_u16(b, 5), mask5);
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_simd(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    uint16x8_t fg = vdupq_n_u16(SWAP16(color.full));
+    uint16x8_t mix = vdupq_n_u16(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint16_t * d = (uint16_t *)&dest[x];
+        vst1q_u16(d, swap_neon(mix565_neon(fg, swap_neon(vld1q_u16(d)), mix)));
+    }
+    if(x < w) fill_opa_swar(&dest[x], w - x, color, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_simd(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    uint16x8_t fg = vdupq_n_u16(color.full);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        uint16_t * d = (uint16_t *)&dest[x];
+        if(m == UINT64_MAX && opa >= LV_OPA_MAX) {
+            vst1q_u16(d, fg);
+            continue;
+        }
+        vst1q_u16(d, mix_neon(fg, vld1q_u16(d), vmovl_u8(fill_mask_opa_neon(&mask[x], opa))));
+    }
+    if(x < w) fill_mask_swar(&dest[x], w - x, color, &mask[x], opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_simd(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    uint16x8_t mix = vdupq_n_u16(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint16_t * d = (uint16_t *)&dest[x];
+        vst1q_u16(d, mix_neon(vld1q_u16((const uint16_t *)&src[x]), vld1q_u16(d), mix));
+    }
+    if(x < w) map_opa_swar(&dest[x], &src[x], w - x, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_simd(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        uint16_t * d = (uint16_t *)&dest[x];
+        uint16x8_t fg = vld1q_u16((const uint16_t *)&src[x]);
+        if(m == UINT64_MAX && opa > LV_OPA_MAX) {
+            vst1q_u16(d, fg);
+            continue;
+        }
+        vst1q_u16(d, mix_neon(fg, vld1q_u16(d), vmovl_u8(map_mask_opa_neon(&mask[x], opa))));
+    }
+    if(x < w) map_mask_swar(&dest[x], &src[x], w - x, &mask[x], opa);
+}
+
+#else /*LV_COLOR_DEPTH == 32*/
+
+/*Mix the channels of 8 pixels like `lv_color_mix()`*/
+static inline uint8x8_t mix_ch_neon(uint8x8_t fg, uint8x8_t bg, uint8x8_t mix, uint8x8_t mix_inv)
+{
+    uint16x8_t res = vmlal_u8(vmlal_u8(vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS), fg, mix), bg, mix_inv);
+    return vmovn_u16(div255_neon(res));
+}
+
+/*Mix 8 ARGB8888 colors. The blue, green, red and alpha channels are in separate vectors.*/
+static inline uint8x8x4_t mix_neon(uint8x8x4_t fg, uint8x8x4_t bg, uint8x8_t mix)
+{
+    uint8x8_t mix_inv = vsub_u8(vdup_n_u8(255), mix);
+    uint8x8x4_t res;
+    res.val[0] = mix_ch_neon(fg.val[0], bg.val[0], mix, mix_inv);
+    res.val[1] = mix_ch_neon(fg.val[1], bg.val[1], mix, mix_inv);
+    res.val[2] = mix_ch_neon(fg.val[2], bg.val[2], mix, mix_inv);
+    res.val[3] = vdup_n_u8(0xFF);
+    return res;
+}
+
+/*Mix like the masked kernels: keep `bg` with 0 and use `fg` with 255 opacity*/
+static inline uint8x8x4_t mix_masked_neon(uint8x8x4_t fg, uint8x8x4_t bg, uint8x8_t mix)
+{
+    uint8x8x4_t res = mix_neon(fg, bg, mix);
+    uint8x8_t transp = vceq_u8(mix, vdup_n_u8(LV_OPA_TRANSP));
+    uint8x8_t cover = vceq_u8(mix, vdup_n_u8(LV_OPA_COVER));
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        res.val[i] = vbsl_u8(transp, bg.val[i], vbsl_u8(cover, fg.val[i], res.val[i]));
+    }
+    return res;
+}
+
+static inline uint8x8x4_t dup_color_neon(lv_color_t color)
+{
+    uint8x8x4_t c;
+    c.val[0] = vdup_n_u8(color.ch.blue);
+    c.val[1] = vdup_n_u8(color.ch.green);
+    c.val[2] = vdup_n_u8(color.ch.red);
+    c.val[3] = vdup_n_u8(color.ch.alpha);
+    return c;
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_opa_simd(lv_color_t * dest, int32_t w, lv_color_t color, lv_opa_t opa)
+{
+    uint8x8x4_t fg = dup_color_neon(color);
+    uint8x8_t mix = vdup_n_u8(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint8_t * d = (uint8_t *)&dest[x];
+        vst4_u8(d, mix_neon(fg, vld4_u8(d), mix));
+    }
+    if(x < w) fill_opa_swar(&dest[x], w - x, color, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void fill_mask_simd(lv_color_t * dest, int32_t w, lv_color_t color,
+                                                 const lv_opa_t * mask, lv_opa_t opa)
+{
+    uint8x8x4_t fg = dup_color_neon(color);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        uint8_t * d = (uint8_t *)&dest[x];
+        if(m == UINT64_MAX && opa >= LV_OPA_MAX) {
+            vst4_u8(d, fg);
+            continue;
+        }
+        vst4_u8(d, mix_masked_neon(fg, vld4_u8(d), fill_mask_opa_neon(&mask[x], opa)));
+    }
+    if(x < w) fill_mask_swar(&dest[x], w - x, color, &mask[x], opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_opa_simd(lv_color_t * dest, const lv_color_t * src, int32_t w, lv_opa_t opa)
+{
+    uint8x8_t mix = vdup_n_u8(opa);
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint8_t * d = (uint8_t *)&dest[x];
+        vst4_u8(d, mix_neon(vld4_u8((const uint8_t *)&src[x]), vld4_u8(d), mix));
+    }
+    if(x < w) map_opa_swar(&dest[x], &src[x], w - x, opa);
+}
+
+LV_ATTRIBUTE_FAST_MEM static void map_mask_simd(lv_color_t * dest, const lv_color_t * src, int32_t w,
+                                                const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < w - 7; x += 8) {
+        uint64_t m = get_mask_x8(&mask[x]);
+        if(m == 0) continue;
+        uint8_t * d = (uint8_t *)&dest[x];
+        if(m == UINT64_MAX && opa > LV_OPA_MAX) {
+            lv_memcpy_small(d, &src[x], 8 * sizeof(lv_color_t));
+            continue;
+        }
+        vst4_u8(d, mix_masked_neon(vld4_u8((const uint8_t *)&src[x]), vld4_u8(d), map_mask_opa_neon(&mask[x], opa)));
+    }
+    if(x < w) map_mask_swar(&dest[x], &src[x], w - x, &mask[x], opa);
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+#endif /*LV_DRAW_SW_BLEND_NEON*/
+
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
@@ -59,11 +59,27 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
         blend_dsc.src_buf = (const lv_color_t *)src_buf;
         lv_draw_sw_blend(draw_ctx, &blend_dsc);
     }
+#if LV_DRAW_SW_BLEND_KERNELS
+    /*Pre-multiplied images are blended directly by the SW blender without an other mask*/
+    else if(!mask_any && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE &&
+            cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT && draw_dsc->recolor_opa == LV_OPA_TRANSP &&
+            draw_dsc->blend_mode == LV_BLEND_MODE_NORMAL &&
+            ((lv_draw_sw_ctx_t *)draw_ctx)->blend == lv_draw_sw_blend_basic &&
+            _lv_refr_get_disp_refreshing()->driver->set_px_cb == NULL) {
+        blend_dsc.blend_area = coords;
+        blend_dsc.src_premult = src_buf;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+#endif
     /*In the other cases every pixel need to be checked one-by-one*/
     else {
         //#if LV_DRAW_COMPLEX
+        /*Pre-multiplied pixels are restored to be handled like the others*/
+        bool premult = cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT;
+        bool has_alpha = cf == LV_IMG_CF_TRUE_COLOR_ALPHA || premult;
+
         /*The pixel size in byte is different if an alpha byte is added too*/
-        uint8_t px_size_byte = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+        uint8_t px_size_byte = has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
 
         /*Go to the first displayed pixel of the map*/
         int32_t src_stride = lv_area_get_width(coords);
@@ -86,7 +102,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
 
         bool transform = draw_dsc->angle != 0 || draw_dsc->zoom != LV_IMG_ZOOM_NONE ? true : false;
         /*Simple ARGB image. Handle it as special case because it's very common*/
-        if(!mask_any && !transform && cf == LV_IMG_CF_TRUE_COLOR_ALPHA && draw_dsc->recolor_opa == LV_OPA_TRANSP) {
+        if(!mask_any && !transform && has_alpha && draw_dsc->recolor_opa == LV_OPA_TRANSP) {
             uint32_t hor_res = (uint32_t) lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
             uint32_t mask_buf_size = lv_area_get_size(&draw_area) > (uint32_t) hor_res ? hor_res : lv_area_get_size(&draw_area);
             lv_color_t * src_buf_rgb = lv_mem_buf_get(mask_buf_size * sizeof(lv_color_t));
@@ -115,6 +131,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
 #elif LV_COLOR_DEPTH == 32
                         src_buf_rgb[px_i].full =  *((uint32_t *)map_px);
 #endif
+                        if(premult) src_buf_rgb[px_i] = _lv_img_buf_unpremult_color(src_buf_rgb[px_i], px_opa);
                     }
 #if LV_COLOR_DEPTH == 32
                     src_buf_rgb[px_i].ch.alpha = 0xFF;
@@ -205,28 +222,31 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
                 int32_t rot_x = blend_area.x1 - coords->x1;
 #endif
 
-                for(x = 0; x < draw_area_w; x++, px_i++, map_px += px_size_byte) {
-
 #if LV_DRAW_COMPLEX
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
+                /*Transform the whole line at once*/
+                if(transform) {
+                    _lv_img_buf_transform_line(&trans_dsc, rot_x, rot_y + y, draw_area_w, &src_buf_rgb[px_i],
+                                               &mask_buf[px_i]);
+                    if(premult) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            src_buf_rgb[px_i + x] = _lv_img_buf_unpremult_color(src_buf_rgb[px_i + x],
+                                                                                mask_buf[px_i + x]);
                         }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                    }
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            src_buf_rgb[px_i + x] = lv_color_mix_premult(recolor_premult, src_buf_rgb[px_i + x],
+                                                                         recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                /*No transform*/
+                else
 #endif
-                    {
-                        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+                {
+                    for(x = 0; x < draw_area_w; x++, px_i++, map_px += px_size_byte) {
+                        if(has_alpha) {
                             lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
                             mask_buf[px_i] = px_opa;
                             if(px_opa == 0) {
@@ -260,12 +280,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
                             }
                         }
 
-                    }
-                    if(draw_dsc->recolor_opa != 0) {
-                        c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
-                    }
+                        if(premult) {
+                            c = _lv_img_buf_unpremult_color(c, mask_buf[px_i]);
+                        }
+
+                        if(draw_dsc->recolor_opa != 0) {
+                            c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
+                        }
 
-                    src_buf_rgb[px_i].full = c.full;
+                        src_buf_rgb[px_i].full = c.full;
+                    }
                 }
 #if LV_DRAW_COMPLEX
                 /*Apply the masks if any*/
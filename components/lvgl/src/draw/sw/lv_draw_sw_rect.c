@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_txt_ap.h"
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_thread.h"
 #include "../../misc/lv_assert.h"
 
 /*********************
@@ -54,6 +55,7 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
  *  STATIC VARIABLES
  **********************/
 #if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
+    /*Not thread local as it can be large. Only the main thread uses it.*/
     static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
     static int32_t sh_cache_size = -1;
     static int32_t sh_cache_r = -1;
@@ -438,7 +440,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    bool use_cache = true;
+#if LV_USE_PARALLEL_RENDER
+    if(lv_thread_is_worker()) use_cache = false;
+#endif
+    if(use_cache && sh_cache_size == corner_size && sh_cache_r == r_sh) {
         /*Use the cache if available*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
         lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
@@ -449,7 +455,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
         /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
+        if(use_cache && (uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
             lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
             sh_cache_size = corner_size;
             sh_cache_r = r_sh;
@@ -891,8 +897,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
         lv_draw_mask_free_param(&mask_rout_param);
         lv_draw_mask_remove_id(mask_rout_id);
     }
-    lv_mem_buf_release(sh_buf);
     lv_mem_buf_release(mask_buf);
+    lv_mem_buf_release(sh_buf);
 }
 
 /**
@@ -346,14 +346,14 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                 t->grow_item_cnt++;
                 t->track_fix_main_size += item_gap;
                 if(t->grow_dsc_calc) {
-                    grow_dsc_t * new_dsc = lv_mem_buf_get(sizeof(grow_dsc_t) * (t->grow_item_cnt));
-                    LV_ASSERT_MALLOC(new_dsc);
-                    if(new_dsc == NULL) return item_id;
-
-                    if(t->grow_dsc) {
-                        lv_memcpy(new_dsc, t->grow_dsc, sizeof(grow_dsc_t) * (t->grow_item_cnt - 1));
-                        lv_mem_buf_release(t->grow_dsc);
+                    if(t->grow_dsc == NULL) {
+                        /*Enough for all the remaining items to not grow it (the buffers can't be reallocated)*/
+                        uint32_t item_cnt = f->rev ? (uint32_t)item_start_id + 1 : cont->spec_attr->child_cnt - item_start_id;
+                        t->grow_dsc = lv_mem_buf_get(sizeof(grow_dsc_t) * item_cnt);
+                        LV_ASSERT_MALLOC(t->grow_dsc);
+                        if(t->grow_dsc == NULL) return item_id;
                     }
+                    grow_dsc_t * new_dsc = t->grow_dsc;
                     new_dsc[t->grow_item_cnt - 1].item = item;
                     new_dsc[t->grow_item_cnt - 1].min_size = f->row ? lv_obj_get_style_min_width(item,
                                                                                                  LV_PART_MAIN) : lv_obj_get_style_min_height(item, LV_PART_MAIN);
@@ -361,7 +361,6 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                                                                                                  LV_PART_MAIN) : lv_obj_get_style_max_height(item, LV_PART_MAIN);
                     new_dsc[t->grow_item_cnt - 1].grow_value = grow_value;
                     new_dsc[t->grow_item_cnt - 1].clamped = 0;
-                    t->grow_dsc = new_dsc;
                 }
             }
             else {
@@ -2,6 +2,7 @@
 #include "../../../misc/lv_log.h"
 #include "../../../misc/lv_mem.h"
 #include "../../../misc/lv_color.h"
+#include "../../../draw/lv_img_buf.h"
 #if LV_USE_GIF
 
 #include <stdlib.h>
@@ -9,25 +10,24 @@
 #include <stdbool.h>
 
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
-#define MAX(A, B) ((A) > (B) ? (A) : (B))
 
-typedef struct Entry {
-    uint16_t length;
-    uint16_t prefix;
-    uint8_t  suffix;
-} Entry;
+/* Max. number of LZW codes */
+#define LZW_CODE_MAX 0x1000
 
-typedef struct Table {
-    int bulk;
-    int nentries;
-    Entry *entries;
-} Table;
+/* Size of the LZW code table and buffers for `cnt` codes:
+ * the prefixes (uint16_t) and suffixes of the codes, the stack of a string and a sub-block */
+#define LZW_SIZE(cnt) ((cnt) * 4 + 0x100)
 
 static gd_GIF *  gif_open(gd_GIF * gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
 static void f_gif_close(gd_GIF * gif);
+static void discard_sub_blocks(gd_GIF *gif);
+static int read_sub_block(gd_GIF *gif, uint8_t size, uint8_t *buf, const uint8_t **data);
+static int lzw_code_cnt(int clear, uint32_t px_cnt);
+static bool scan_opaque(gd_GIF *gif);
+static void palette_convert(gd_GIF *gif);
 
 static uint16_t
 read_num(gd_GIF * gif)
@@ -71,8 +71,13 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     uint16_t width, height, depth;
     uint8_t fdsz, bgidx, aspect;
     int i;
-    uint8_t *bgcolor;
     int gct_sz;
+    uint8_t opaque;
+    uint8_t px_size;
+    uint32_t lzw_size = 0;
+#if LV_GIF_CACHE_DECODE_DATA
+    int code_cnt;
+#endif
     gd_GIF *gif = malloc(sizeof(gd_GIF));
 
     /* Header */
@@ -106,55 +111,62 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     f_gif_read(gif_base, &bgidx, 1);
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
-    /* Create gd_GIF Structure. */
-#if LV_COLOR_DEPTH == 32
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 5 * width * height);
-#elif LV_COLOR_DEPTH == 16
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 4 * width * height);
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 3 * width * height);
+    /* Without transparent pixels the canvas doesn't need alpha channel. */
+    i = f_gif_seek(gif_base, 0, LV_FS_SEEK_CUR);
+    f_gif_seek(gif_base, 3 * gct_sz, LV_FS_SEEK_CUR);
+    opaque = scan_opaque(gif_base);
+    f_gif_seek(gif_base, i, LV_FS_SEEK_SET);
+    px_size = opaque ? LV_COLOR_SIZE / 8 : LV_IMG_PX_SIZE_ALPHA_BYTE;
+#if LV_GIF_CACHE_DECODE_DATA
+    /* Enough codes for any frame, as a frame is not larger than the canvas. */
+    code_cnt = lzw_code_cnt(0x100, (uint32_t) width * height);
+    lzw_size = LZW_SIZE(code_cnt);
 #endif
+    /* Create gd_GIF Structure. The converted palette, the LZW code table (if it's cached),
+     * the canvas and the color indices of the frame follow it. */
+    gif = lv_mem_alloc(sizeof(gd_GIF) + 0x100 * sizeof(lv_color_t) + lzw_size + (px_size + 1) * width * height);
 
     if (!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
+#if LV_GIF_CACHE_DECODE_DATA
+    gif->lzw_code_cnt = code_cnt;
+#endif
     gif->width  = width;
     gif->height = height;
     gif->depth  = depth;
+    gif->opaque = opaque;
+    gif->px_size = px_size;
+    gif->rendered = 0;
+    gif->dw = gif->dh = 0;
     /* Read GCT */
     gif->gct.size = gct_sz;
     f_gif_read(gif, gif->gct.colors, 3 * gif->gct.size);
     gif->palette = &gif->gct;
+    gif->colors = (lv_color_t *) &gif[1];
+    gif->colors_palette = NULL;
+    palette_convert(gif);
     gif->bgindex = bgidx;
-    gif->canvas = (uint8_t *) &gif[1];
-#if LV_COLOR_DEPTH == 32
-    gif->frame = &gif->canvas[4 * width * height];
-#elif LV_COLOR_DEPTH == 16
-    gif->frame = &gif->canvas[3 * width * height];
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif->frame = &gif->canvas[2 * width * height];
+#if LV_GIF_CACHE_DECODE_DATA
+    gif->lzw = (uint8_t *) &gif->colors[0x100];
 #endif
+    gif->canvas = (uint8_t *) &gif->colors[0x100] + lzw_size;
+    gif->frame = &gif->canvas[px_size * width * height];
     if (gif->bgindex)
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
-    bgcolor = &gif->palette->colors[gif->bgindex*3];
+    uint8_t *bgcolor = &gif->palette->colors[gif->bgindex*3];
 
-    if (bgcolor[0] || bgcolor[1] || bgcolor [2])
+    /* Start with the background color if it's not black (or there is no alpha channel), else transparent */
+    if (opaque || bgcolor[0] || bgcolor[1] || bgcolor [2]) {
+        lv_color_t c = gif->colors[gif->bgindex];
+        uint8_t *px = gif->canvas;
         for (i = 0; i < gif->width * gif->height; i++) {
-#if LV_COLOR_DEPTH == 32
-            gif->canvas[i*4 + 0] = *(bgcolor + 2);
-            gif->canvas[i*4 + 1] = *(bgcolor + 1);
-            gif->canvas[i*4 + 2] = *(bgcolor + 0);
-            gif->canvas[i*4 + 3] = 0xff;
-#elif LV_COLOR_DEPTH == 16
-            lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-            gif->canvas[i*3 + 0] = c.full & 0xff;
-            gif->canvas[i*3 + 1] = (c.full >> 8) & 0xff;
-            gif->canvas[i*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-            lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-            gif->canvas[i*2 + 0] = c.full;
-            gif->canvas[i*2 + 1] = 0xff;
-#endif
+            memcpy(px, &c, LV_COLOR_SIZE / 8);
+            if (!opaque) px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = 0xff;
+            px += px_size;
         }
+    } else {
+        memset(gif->canvas, 0, px_size * width * height);
+    }
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     goto ok;
 fail:
@@ -174,6 +186,78 @@ discard_sub_blocks(gd_GIF *gif)
     } while (size);
 }
 
+/* Read a sub-block of `size` bytes and the size of the next one. Return the size of the next sub-block.
+ * `*data` points to the data: to `buf` when reading from a file, else directly into the GIF. */
+static int
+read_sub_block(gd_GIF *gif, uint8_t size, uint8_t *buf, const uint8_t **data)
+{
+    if (gif->is_file) {
+        f_gif_read(gif, buf, size + 1);
+        *data = buf;
+    } else {
+        *data = (const uint8_t *) &gif->data[gif->f_rw_p];
+        gif->f_rw_p += size + 1;
+    }
+    return (*data)[size];
+}
+
+/* Return true if no frame has transparent pixels. */
+static bool
+scan_opaque(gd_GIF *gif)
+{
+    uint8_t sep, label, flags;
+
+    while (1) {
+        f_gif_read(gif, &sep, 1);
+        if (sep == ';')
+            return true;
+        if (sep == '!') {
+            f_gif_read(gif, &label, 1);
+            if (label == 0xF9) {
+                /* Block size, packed fields */
+                f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+                f_gif_read(gif, &flags, 1);
+                if (flags & 1)
+                    return false;
+                /* Delay, transparent index and block terminator. */
+                f_gif_seek(gif, 4, LV_FS_SEEK_CUR);
+            } else
+                discard_sub_blocks(gif);
+        } else if (sep == ',') {
+            /* Position and size, then the flags of the LCT. */
+            f_gif_seek(gif, 8, LV_FS_SEEK_CUR);
+            f_gif_read(gif, &flags, 1);
+            if (flags & 0x80)
+                f_gif_seek(gif, 3 * (1 << ((flags & 0x07) + 1)), LV_FS_SEEK_CUR);
+            /* LZW minimum code size and the image data. */
+            f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+            discard_sub_blocks(gif);
+        } else
+            return false;
+    }
+}
+
+/* Convert the current palette to lv_color_t, if it wasn't converted yet. */
+static void
+palette_convert(gd_GIF *gif)
+{
+    int i;
+    uint8_t *color;
+
+    if (gif->palette == gif->colors_palette && gif->palette == &gif->gct)
+        return;
+    for (i = 0; i < gif->palette->size; i++) {
+        color = &gif->palette->colors[i*3];
+#if LV_COLOR_DEPTH == 1
+        uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
+        gif->colors[i].full = b > 128 ? 1 : 0;
+#else
+        gif->colors[i] = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+#endif
+    }
+    gif->colors_palette = gif->palette;
+}
+
 static void
 read_plain_text_ext(gd_GIF *gif)
 {
@@ -282,73 +366,6 @@ read_ext(gd_GIF *gif)
     }
 }
 
-static Table *
-new_table(int key_size)
-{
-    int key;
-    int init_bulk = MAX(1 << (key_size + 1), 0x100);
-    Table *table = lv_mem_alloc(sizeof(*table) + sizeof(Entry) * init_bulk);
-    if (table) {
-        table->bulk = init_bulk;
-        table->nentries = (1 << key_size) + 2;
-        table->entries = (Entry *) &table[1];
-        for (key = 0; key < (1 << key_size); key++)
-            table->entries[key] = (Entry) {1, 0xFFF, key};
-    }
-    return table;
-}
-
-/* Add table entry. Return value:
- *  0 on success
- *  +1 if key size must be incremented after this addition
- *  -1 if could not realloc table */
-static int
-add_entry(Table **tablep, uint16_t length, uint16_t prefix, uint8_t suffix)
-{
-    Table *table = *tablep;
-    if (table->nentries == table->bulk) {
-        table->bulk *= 2;
-        table = lv_mem_realloc(table, sizeof(*table) + sizeof(Entry) * table->bulk);
-        if (!table) return -1;
-        table->entries = (Entry *) &table[1];
-        *tablep = table;
-    }
-    table->entries[table->nentries] = (Entry) {length, prefix, suffix};
-    table->nentries++;
-    if ((table->nentries & (table->nentries - 1)) == 0)
-        return 1;
-    return 0;
-}
-
-static uint16_t
-get_key(gd_GIF *gif, int key_size, uint8_t *sub_len, uint8_t *shift, uint8_t *byte)
-{
-    int bits_read;
-    int rpad;
-    int frag_size;
-    uint16_t key;
-
-    key = 0;
-    for (bits_read = 0; bits_read < key_size; bits_read += frag_size) {
-        rpad = (*shift + bits_read) % 8;
-        if (rpad == 0) {
-            /* Update byte. */
-            if (*sub_len == 0) {
-                f_gif_read(gif, sub_len, 1); /* Must be nonzero! */
-                if (*sub_len == 0) return 0x1000;
-            }
-            f_gif_read(gif, byte, 1);
-            (*sub_len)--;
-        }
-        frag_size = MIN(key_size - bits_read, 8 - rpad);
-        key |= ((uint16_t) ((*byte) >> rpad)) << bits_read;
-    }
-    /* Clear extra bits to the left. */
-    key &= (1 << key_size) - 1;
-    *shift = (*shift + key_size) % 8;
-    return key;
-}
-
 /* Compute output index of y-th input line, in frame of height h. */
 static int
 interlaced_line_index(int h, int y)
@@ -371,82 +388,167 @@ interlaced_line_index(int h, int y)
     return y * 2 + 1;
 }
 
+/* Number of LZW codes to allocate for a frame. Every code adds at most one code to the table. */
+static int
+lzw_code_cnt(int clear, uint32_t px_cnt)
+{
+    return (int) MIN((uint32_t) LZW_CODE_MAX, clear + 2 + px_cnt);
+}
+
+/* Start of the `y`-th input line of the frame in `gif->frame`. */
+static uint8_t *
+frame_line(gd_GIF *gif, int y, int interlace)
+{
+    if (interlace)
+        y = interlaced_line_index((int) gif->fh, y);
+    return &gif->frame[(gif->fy + y) * gif->width + gif->fx];
+}
+
 /* Decompress image pixels.
  * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table). */
 static int
 read_image_data(gd_GIF *gif, int interlace)
 {
-    uint8_t sub_len, shift, byte;
-    int init_key_size, key_size, table_is_full=0;
-    int frm_off, frm_size, str_len=0, i, p, x, y;
-    uint16_t key, clear, stop;
-    int ret;
-    Table *table;
-    Entry entry = {0};
-    size_t start, end;
-
-    f_gif_read(gif, &byte, 1);
-    key_size = (int) byte;
-    start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    discard_sub_blocks(gif);
-    end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    f_gif_seek(gif, start, LV_FS_SEEK_SET);
-    clear = 1 << key_size;
+    uint8_t min_key_size, sub_len;
+    const uint8_t *src, *src_end;
+    uint32_t bits;
+    int bit_cnt, key_size, key_mask;
+    int key, clear, stop, next, prev, first, code_cnt;
+    int x, y, len, n;
+    uint8_t *lzw, *suffix, *stack, *block, *sp, *line;
+    uint16_t *prefix;
+
+    f_gif_read(gif, &min_key_size, 1);
+    if (min_key_size < 1 || min_key_size > 8) {
+        LV_LOG_WARN("invalid LZW minimum code size: %d\n", min_key_size);
+        discard_sub_blocks(gif);
+        return 0;
+    }
+    clear = 1 << min_key_size;
     stop = clear + 1;
-    table = new_table(key_size);
-    key_size++;
-    init_key_size = key_size;
-    sub_len = shift = 0;
-    key = get_key(gif, key_size, &sub_len, &shift, &byte); /* clear code */
-    frm_off = 0;
-    ret = 0;
-    frm_size = gif->fw*gif->fh;
-    while (frm_off < frm_size) {
+#if LV_GIF_CACHE_DECODE_DATA
+    lzw = gif->lzw;
+    code_cnt = gif->lzw_code_cnt;
+#else
+    code_cnt = lzw_code_cnt(clear, (uint32_t) gif->fw * gif->fh);
+    lzw = lv_mem_alloc(LZW_SIZE(code_cnt));
+    if (!lzw) {
+        discard_sub_blocks(gif);
+        return -1;
+    }
+#endif
+    prefix = (uint16_t *) lzw;
+    suffix = (uint8_t *) &prefix[code_cnt];
+    stack = &suffix[code_cnt];
+    block = &stack[code_cnt];
+
+    /* The codes are read from the sub-blocks through a bit reservoir. */
+    f_gif_read(gif, &sub_len, 1);
+    src = src_end = NULL;
+    bits = 0;
+    bit_cnt = 0;
+    key_size = min_key_size + 1;
+    key_mask = (1 << key_size) - 1;
+    next = clear + 2;
+    prev = -1;
+    first = 0;
+    x = y = 0;
+    line = frame_line(gif, 0, interlace);
+    while (y < gif->fh) {
+        while (bit_cnt < key_size) {
+            if (src == src_end) {
+                if (sub_len == 0)
+                    goto end;
+                n = sub_len;
+                sub_len = read_sub_block(gif, sub_len, block, &src);
+                src_end = src + n;
+            }
+            bits |= (uint32_t) *src++ << bit_cnt;
+            bit_cnt += 8;
+        }
+        key = bits & key_mask;
+        bits >>= key_size;
+        bit_cnt -= key_size;
+
         if (key == clear) {
-            key_size = init_key_size;
-            table->nentries = (1 << (key_size - 1)) + 2;
-            table_is_full = 0;
-        } else if (!table_is_full) {
-            ret = add_entry(&table, str_len + 1, key, entry.suffix);
-            if (ret == -1) {
-                lv_mem_free(table);
-                return -1;
+            key_size = min_key_size + 1;
+            key_mask = (1 << key_size) - 1;
+            next = clear + 2;
+            prev = -1;
+            continue;
+        }
+        if (key == stop)
+            break;
+
+        /* Decode the string of the key backwards onto the stack. */
+        sp = &stack[code_cnt];
+        if (prev < 0) {
+            if (key > clear)
+                break;
+            *--sp = key;
+            first = key;
+        } else {
+            int code = key;
+            if (key == next) {
+                /* The string of the previous key and its first character. */
+                *--sp = first;
+                code = prev;
+            } else if (key > next) {
+                break;
+            }
+            while (code >= clear) {
+                *--sp = suffix[code];
+                code = prefix[code];
             }
-            if (table->nentries == 0x1000) {
-                ret = 0;
-                table_is_full = 1;
+            *--sp = code;
+            first = code;
+            if (next < code_cnt) {
+                prefix[next] = prev;
+                suffix[next] = first;
+                next++;
+                if (next == key_mask + 1 && key_size < 12) {
+                    key_size++;
+                    key_mask = (1 << key_size) - 1;
+                }
             }
         }
-        key = get_key(gif, key_size, &sub_len, &shift, &byte);
-        if (key == clear) continue;
-        if (key == stop || key == 0x1000) break;
-        if (ret == 1) key_size++;
-        entry = table->entries[key];
-        str_len = entry.length;
-        for (i = 0; i < str_len; i++) {
-            p = frm_off + entry.length - 1;
-            x = p % gif->fw;
-            y = p / gif->fw;
-            if (interlace)
-                y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
-            if (entry.prefix == 0xFFF)
-                break;
-            else
-                entry = table->entries[entry.prefix];
+        prev = key;
+
+        /* Copy the string to the frame. */
+        len = &stack[code_cnt] - sp;
+        while (len) {
+            n = MIN(len, gif->fw - x);
+            if (n == 1) {
+                line[x] = *sp;
+            } else {
+                memcpy(&line[x], sp, n);
+            }
+            sp += n;
+            len -= n;
+            x += n;
+            if (x == gif->fw) {
+                x = 0;
+                if (++y == gif->fh)
+                    break;
+                line = frame_line(gif, y, interlace);
+            }
         }
-        frm_off += str_len;
-        if (key < table->nentries - 1 && !table_is_full)
-            table->entries[table->nentries - 1].suffix = entry.suffix;
     }
-    lv_mem_free(table);
-    if (key == stop) f_gif_read(gif, &sub_len, 1); /* Must be zero! */
-    f_gif_seek(gif, end, LV_FS_SEEK_SET);
+end:
+#if !LV_GIF_CACHE_DECODE_DATA
+    lv_mem_free(lzw);
+#endif
+    /* Skip the rest of the image data. */
+    if (sub_len) {
+        f_gif_seek(gif, sub_len, LV_FS_SEEK_CUR);
+        discard_sub_blocks(gif);
+    }
     return 0;
 }
 
 /* Read image.
- * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table). */
+ * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table)
+ * or if the frame is empty or doesn't fit on the canvas. */
 static int
 read_image(gd_GIF *gif)
 {
@@ -469,6 +571,19 @@ read_image(gd_GIF *gif)
         gif->palette = &gif->lct;
     } else
         gif->palette = &gif->gct;
+    /* The frame is decoded and rendered in place, so it must lie on the canvas. */
+    if (gif->fw == 0 || gif->fh == 0 ||
+        (uint32_t) gif->fx + gif->fw > gif->width ||
+        (uint32_t) gif->fy + gif->fh > gif->height) {
+        LV_LOG_WARN("invalid frame: %d;%d %dx%d on a %dx%d canvas\n",
+                    gif->fx, gif->fy, gif->fw, gif->fh, gif->width, gif->height);
+        gif->fx = gif->fy = gif->fw = gif->fh = 0;
+        /* Skip the LZW minimum code size and the image data. */
+        f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+        discard_sub_blocks(gif);
+        return -1;
+    }
+    palette_convert(gif);
     /* Image Data. */
     return read_image_data(gif, interlace);
 }
@@ -476,83 +591,74 @@ read_image(gd_GIF *gif)
 static void
 render_frame_rect(gd_GIF *gif, uint8_t *buffer)
 {
-    int i, j, k;
-    uint8_t index, *color;
-    i = gif->fy * gif->width + gif->fx;
+    int j, k;
+    uint8_t index;
+    const lv_color_t *colors = gif->colors;
+    int tindex = gif->gce.transparency ? gif->gce.tindex : -1;
+    const uint8_t *src = &gif->frame[gif->fy * gif->width + gif->fx];
+    uint8_t *dst = &buffer[(gif->fy * gif->width + gif->fx) * gif->px_size];
+
     for (j = 0; j < gif->fh; j++) {
-        for (k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
-            color = &gif->palette->colors[index*3];
-            if (!gif->gce.transparency || index != gif->gce.tindex) {
-#if LV_COLOR_DEPTH == 32
-                buffer[(i+k)*4 + 0] = *(color + 2);
-                buffer[(i+k)*4 + 1] = *(color + 1);
-                buffer[(i+k)*4 + 2] = *(color + 0);
-                buffer[(i+k)*4 + 3] = 0xFF;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*3 + 0] = c.full & 0xff;
-                buffer[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                buffer[(i+k)*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*2 + 0] = c.full;
-                buffer[(i+k)*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
-                buffer[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                buffer[(i+k)*2 + 1] = 0xff;
-#endif
+        if (gif->opaque) {
+            lv_color_t *dst_c = (lv_color_t *) dst;
+            for (k = 0; k < gif->fw; k++) {
+                index = src[k];
+                if (index != tindex) dst_c[k] = colors[index];
+            }
+        } else {
+            uint8_t *px = dst;
+            for (k = 0; k < gif->fw; k++) {
+                index = src[k];
+                if (index != tindex) {
+                    memcpy(px, &colors[index], LV_COLOR_SIZE / 8);
+                    px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = 0xff;
+                }
+                px += LV_IMG_PX_SIZE_ALPHA_BYTE;
             }
         }
-        i += gif->width;
+        src += gif->width;
+        dst += gif->width * gif->px_size;
     }
 }
 
 static void
 dispose(gd_GIF *gif)
 {
-    int i, j, k;
-    uint8_t *bgcolor;
+    int j, k;
+    uint8_t *dst, *px;
+    lv_color_t c;
+
+    gif->dw = gif->dh = 0;
     switch (gif->gce.disposal) {
     case 2: /* Restore to background color. */
-        bgcolor = &gif->palette->colors[gif->bgindex*3];
+        c = gif->colors[gif->bgindex];
 
         uint8_t opa = 0xff;
         if(gif->gce.transparency) opa = 0x00;
 
-        i = gif->fy * gif->width + gif->fx;
+        dst = &gif->canvas[(gif->fy * gif->width + gif->fx) * gif->px_size];
         for (j = 0; j < gif->fh; j++) {
+            px = dst;
             for (k = 0; k < gif->fw; k++) {
-#if LV_COLOR_DEPTH == 32
-                gif->canvas[(i+k)*4 + 0] = *(bgcolor + 2);
-                gif->canvas[(i+k)*4 + 1] = *(bgcolor + 1);
-                gif->canvas[(i+k)*4 + 2] = *(bgcolor + 0);
-                gif->canvas[(i+k)*4 + 3] = opa;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*3 + 0] = c.full & 0xff;
-                gif->canvas[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                gif->canvas[(i+k)*3 + 2] = opa;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = c.full;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(bgcolor + 0)) | (*(bgcolor + 1)) | (*(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#endif
+                memcpy(px, &c, LV_COLOR_SIZE / 8);
+                if (!gif->opaque) px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+                px += gif->px_size;
             }
-            i += gif->width;
+            dst += gif->width * gif->px_size;
         }
+        gif->dx = gif->fx;
+        gif->dy = gif->fy;
+        gif->dw = gif->fw;
+        gif->dh = gif->fh;
         break;
     case 3: /* Restore to previous, i.e., don't update canvas.*/
         break;
     default:
         /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        if (!gif->rendered)
+            render_frame_rect(gif, gif->canvas);
     }
+    gif->rendered = 0;
 }
 
 /* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
@@ -589,6 +695,9 @@ gd_render_frame(gd_GIF *gif, uint8_t *buffer)
 //    }
 //    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
     render_frame_rect(gif, buffer);
+    /* Don't render it again when it's disposed. */
+    if (buffer == gif->canvas)
+        gif->rendered = 1;
 }
 
 void
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_color.h"
 
 #if LV_USE_GIF
 
@@ -41,7 +42,17 @@ typedef struct gd_GIF {
     void (*comment)(struct gd_GIF *gif);
     void (*application)(struct gd_GIF *gif, char id[8], char auth[3]);
     uint16_t fx, fy, fw, fh;
+    uint16_t dx, dy, dw, dh;    /* Area changed by the last dispose */
     uint8_t bgindex;
+    uint8_t opaque;             /* No transparent pixels, the canvas has no alpha channel */
+    uint8_t px_size;            /* Bytes per pixel in the canvas */
+    uint8_t rendered;           /* The current frame is already rendered on the canvas */
+    gd_Palette *colors_palette; /* The palette converted to `colors` */
+    lv_color_t *colors;         /* 0x100 colors */
+#if LV_GIF_CACHE_DECODE_DATA
+    uint8_t *lzw;               /* LZW code table and buffers of the decoder */
+    int lzw_code_cnt;           /* Number of codes in `lzw` */
+#endif
     uint8_t *canvas, *frame;
 } gd_GIF;
 
@@ -81,7 +81,7 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
    gifobj->imgdsc.data = gifobj->gif->canvas;
    gifobj->imgdsc.header.always_zero = 0;
-   gifobj->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+   gifobj->imgdsc.header.cf = gifobj->gif->opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
    gifobj->imgdsc.header.h = gifobj->gif->height;
    gifobj->imgdsc.header.w = gifobj->gif->width;
    gifobj->last_call = lv_tick_get();
@@ -144,11 +144,25 @@ static void next_frame_task_cb(lv_timer_t * t)
             gd_rewind(gifobj->gif);
         }
     }
+    else if(has_next < 0) {
+        /*The frame couldn't be decoded, keep the current image*/
+        return;
+    }
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+
+    /*Only the new frame and the area cleared by disposing the previous frame have changed*/
+    gd_GIF * gif = gifobj->gif;
+    lv_area_t inv_area;
+    lv_area_set(&inv_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(gif->dw && gif->dh) {
+        lv_area_t dispose_area;
+        lv_area_set(&dispose_area, gif->dx, gif->dy, gif->dx + gif->dw - 1, gif->dy + gif->dh - 1);
+        _lv_area_join(&inv_area, &inv_area, &dispose_area);
+    }
+    lv_img_invalidate_src_area(obj, &inv_area);
 }
 
 #endif /*LV_USE_GIF*/
@@ -10,6 +10,7 @@
 #if LV_USE_PNG
 
 #include "lv_png.h"
+#include "lv_png_stream.h"
 #include "lodepng.h"
 #include <stdlib.h>
 
@@ -26,12 +27,16 @@
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t stream_opened(lv_img_decoder_dsc_t * dsc, lv_png_stream_t * stream);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static bool stream_en = LV_PNG_STREAM;
 
 /**********************
  *      MACROS
@@ -49,9 +54,21 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
+/**
+ * Decode the PNG images row by row when they are drawn or decode the whole images when they are opened.
+ * Affects only the images opened later. The default is `LV_PNG_STREAM`.
+ * @param en true: decode row by row; false: decode the whole images
+ * @note the images decoded row by row can't be rotated or zoomed
+ */
+void lv_png_set_stream(bool en)
+{
+    stream_en = en;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -129,6 +146,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
         if(!strcmp(&fn[strlen(fn) - 3], "png")) {              /*Check the extension*/
 
+            /*Interlaced images are decoded as a whole*/
+            if(stream_en) {
+                lv_png_stream_t * stream = _lv_png_stream_open_file(fn);
+                if(stream) return stream_opened(dsc, stream);
+            }
+
             /*Load the PNG file into buffer. It's still compressed (not decoded)*/
             unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
             size_t png_data_size;          /*Size of `png_data` in bytes*/
@@ -154,14 +177,21 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
             /*Convert the image to the system's color depth*/
             convert_color_depth(img_data,  png_width * png_height);
             dsc->img_data = img_data;
+            dsc->decoded_size = png_width * png_height * 4;
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
     }
     /*If it's a PNG file in a  C array...*/
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
-        uint32_t png_width;             /*No used, just required by he decoder*/
-        uint32_t png_height;            /*No used, just required by he decoder*/
+
+        if(stream_en) {
+            lv_png_stream_t * stream = _lv_png_stream_open_data(img_dsc->data, img_dsc->data_size);
+            if(stream) return stream_opened(dsc, stream);
+        }
+
+        uint32_t png_width;             /*Will be the width of the decoded image*/
+        uint32_t png_height;            /*Will be the width of the decoded image*/
 
         /*Decode the image in ARGB8888 */
         error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
@@ -174,24 +204,55 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         convert_color_depth(img_data,  png_width * png_height);
 
         dsc->img_data = img_data;
+        dsc->decoded_size = png_width * png_height * 4;
         return LV_RES_OK;     /*Return with its pointer*/
     }
 
     return LV_RES_INV;    /*If not returned earlier then it failed*/
 }
 
+/**
+ * Decode a row of a streamed PNG image
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder); /*Unused*/
+    if(dsc->user_data == NULL) return LV_RES_INV;
+
+    return _lv_png_stream_read_line(dsc->user_data, x, y, len, buf);
+}
+
 /**
  * Free the allocated resources
  */
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder); /*Unused*/
+    if(dsc->user_data) {
+        _lv_png_stream_close(dsc->user_data);
+        dsc->user_data = NULL;
+    }
     if(dsc->img_data) {
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
 }
 
+/**
+ * Use an opened stream to read the rows of the image with `decoder_read_line()`
+ * @param dsc the decoder descriptor of the image
+ * @param stream the opened stream
+ * @return LV_RES_OK
+ */
+static lv_res_t stream_opened(lv_img_decoder_dsc_t * dsc, lv_png_stream_t * stream)
+{
+    dsc->user_data = stream;
+    dsc->img_data = NULL;
+    dsc->decoded_size = _lv_png_stream_get_mem_size(stream);
+    return LV_RES_OK;
+}
+
 /**
  * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
  * @param img the ARGB888 image
@@ -224,7 +285,7 @@ static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
     lv_color_t c;
     uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
+        c = lv_color_make(img_argb[i].ch.blue, img_argb[i].ch.green, img_argb[i].ch.red);
         img[i * 2 + 1] = img_argb[i].ch.alpha;
         img[i * 2 + 0] = c.full;
     }
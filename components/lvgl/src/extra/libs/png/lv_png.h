@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "../../../lv_conf_internal.h"
+#include <stdbool.h>
 #if LV_USE_PNG
 
 /*********************
@@ -33,6 +34,14 @@ extern "C" {
  */
 void lv_png_init(void);
 
+/**
+ * Decode the PNG images row by row when they are drawn or decode the whole images when they are opened.
+ * Affects only the images opened later. The default is `LV_PNG_STREAM`.
+ * @param en true: decode row by row; false: decode the whole images
+ * @note the images decoded row by row can't be rotated or zoomed
+ */
+void lv_png_set_stream(bool en);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,900 @@
+/**
+ * @file lv_png_stream.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_PNG
+
+#include "lv_png_stream.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Length of the Huffman codes decoded with one table look up. The longer codes are decoded bit by bit.*/
+#define HUFF_FAST_BITS  9
+#define HUFF_FAST_MASK  ((1 << HUFF_FAST_BITS) - 1)
+
+/*The files are read in blocks of this size*/
+#define FILE_BUF_SIZE   512
+
+#define PALETTE_MAX     256
+
+#define CHUNK_TYPE(a, b, c, d)  (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+#define CHUNK_IHDR      CHUNK_TYPE('I', 'H', 'D', 'R')
+#define CHUNK_PLTE      CHUNK_TYPE('P', 'L', 'T', 'E')
+#define CHUNK_TRNS      CHUNK_TYPE('t', 'R', 'N', 'S')
+#define CHUNK_IDAT      CHUNK_TYPE('I', 'D', 'A', 'T')
+#define CHUNK_IEND      CHUNK_TYPE('I', 'E', 'N', 'D')
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    BLOCK_NONE,     /*Read the header of the next block*/
+    BLOCK_STORED,   /*Copy `stored_left` bytes*/
+    BLOCK_HUFF,     /*Decode the literals and the matches until the end of block code*/
+} block_t;
+
+typedef struct {
+    uint16_t count[16];         /*Number of codes of every length*/
+    uint16_t symbol[288];       /*The symbols in the order of their codes*/
+    uint16_t fast[1 << HUFF_FAST_BITS]; /*`symbol << 4 | length` of the codes not longer than HUFF_FAST_BITS
+                                         *indexed by the next bits of the stream. 0: longer code*/
+} huff_t;
+
+struct _lv_png_stream_t {
+    /*Input*/
+    const uint8_t * in;         /*The C array or `file_buf`*/
+    uint32_t in_len;            /*Number of bytes in `in`*/
+    uint32_t in_pos;            /*The next byte to read from `in`*/
+    lv_fs_file_t file;
+    uint8_t * file_buf;         /*NULL if the image is a C array*/
+    uint32_t file_pos;          /*Position of `in` in the file*/
+    uint32_t idat_pos;          /*Position of the data of the first IDAT chunk*/
+    uint32_t idat_len;          /*Length of the first IDAT chunk*/
+    uint32_t chunk_left;        /*Bytes left from the current IDAT chunk*/
+    bool idat_end;              /*There are no more IDAT chunks*/
+    bool err;                   /*Invalid or truncated data*/
+
+    /*Image*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t bit_depth;
+    uint8_t color_type;
+    uint8_t px_bytes;           /*Bytes per pixel, but at least 1. The filters use the bytes this far on the left.*/
+    uint32_t row_bytes;         /*Size of a row without the filter type byte*/
+    uint8_t * palette;          /*RGBA colors of the palette or NULL*/
+    uint16_t palette_cnt;
+    uint16_t trns[3];           /*The transparent gray level or RGB color*/
+    bool has_trns;
+
+    /*Inflater*/
+    uint32_t bit_buf;
+    uint8_t bit_cnt;
+    uint8_t window_bits;        /*log2 of the window size in the zlib header*/
+    bool final;                 /*The current block is the last one*/
+    bool fixed;                 /*`lit` and `dist` are the fixed codes*/
+    block_t block;
+    uint16_t stored_left;
+    uint16_t copy_len;          /*Bytes left from the current match*/
+    uint16_t copy_dist;
+    uint8_t * window;           /*The last inflated bytes for the matches*/
+    uint32_t window_mask;
+    uint32_t out_cnt;           /*Number of inflated bytes*/
+    huff_t lit;
+    huff_t dist;                /*Also the code length codes of the dynamic blocks*/
+
+    /*Rows*/
+    uint8_t * rows[2];          /*The current and the previous row with their filter type byte*/
+    uint8_t cur;                /*Index of the current row in `rows`*/
+    int32_t y;                  /*The current row. -1: no rows are decoded yet*/
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_png_stream_t * stream_open(lv_png_stream_t * s);
+static bool stream_start(lv_png_stream_t * s);
+static bool parse_chunks(lv_png_stream_t * s);
+static bool in_fill(lv_png_stream_t * s);
+static bool in_read(lv_png_stream_t * s, uint8_t * buf, uint32_t len);
+static bool in_read_u32(lv_png_stream_t * s, uint32_t * v);
+static bool in_seek(lv_png_stream_t * s, uint32_t pos);
+static inline bool idat_byte(lv_png_stream_t * s, uint8_t * b);
+static bool huff_build(huff_t * h, const uint8_t * lens, uint32_t n);
+static bool block_fixed(lv_png_stream_t * s);
+static bool block_dynamic(lv_png_stream_t * s);
+static bool inflate_out(lv_png_stream_t * s, uint8_t * dst, uint32_t len);
+static bool row_next(lv_png_stream_t * s);
+static void row_convert(lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t clen_order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_png_stream_t * _lv_png_stream_open_data(const uint8_t * data, uint32_t size)
+{
+    lv_png_stream_t * s = lv_mem_alloc(sizeof(lv_png_stream_t));
+    if(s == NULL) return NULL;
+    lv_memset_00(s, sizeof(lv_png_stream_t));
+
+    s->in = data;
+    s->in_len = size;
+    return stream_open(s);
+}
+
+lv_png_stream_t * _lv_png_stream_open_file(const char * fn)
+{
+    lv_png_stream_t * s = lv_mem_alloc(sizeof(lv_png_stream_t));
+    if(s == NULL) return NULL;
+    lv_memset_00(s, sizeof(lv_png_stream_t));
+
+    if(lv_fs_open(&s->file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_mem_free(s);
+        return NULL;
+    }
+
+    s->file_buf = lv_mem_alloc(FILE_BUF_SIZE);
+    if(s->file_buf == NULL) {
+        lv_fs_close(&s->file);
+        lv_mem_free(s);
+        return NULL;
+    }
+    s->in = s->file_buf;
+    return stream_open(s);
+}
+
+lv_res_t _lv_png_stream_read_line(lv_png_stream_t * s, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    if(x < 0 || y < 0 || len < 0 || (uint32_t)x + len > s->w || (uint32_t)y >= s->h) return LV_RES_INV;
+
+    if(y < s->y) {
+        if(!stream_start(s)) return LV_RES_INV;
+    }
+
+    while(s->y < y) {
+        if(!row_next(s)) {
+            /*Start again with the next read*/
+            s->y = s->h;
+            return LV_RES_INV;
+        }
+    }
+
+    row_convert(s, x, len, buf);
+    return LV_RES_OK;
+}
+
+uint32_t _lv_png_stream_get_mem_size(const lv_png_stream_t * s)
+{
+    uint32_t size = sizeof(lv_png_stream_t);
+    size += s->window_mask + 1;
+    size += 2 * (s->row_bytes + 1);
+    if(s->palette) size += PALETTE_MAX * 4;
+    if(s->file_buf) size += FILE_BUF_SIZE;
+    return size;
+}
+
+void _lv_png_stream_close(lv_png_stream_t * s)
+{
+    if(s->file_buf) {
+        lv_fs_close(&s->file);
+        lv_mem_free(s->file_buf);
+    }
+    if(s->palette) lv_mem_free(s->palette);
+    if(s->window) lv_mem_free(s->window);
+    if(s->rows[0]) lv_mem_free(s->rows[0]);
+    lv_mem_free(s);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Read the chunks before the image data and allocate the buffers
+ * @param s pointer to a stream with its input set
+ * @return `s` or NULL on error (`s` is closed)
+ */
+static lv_png_stream_t * stream_open(lv_png_stream_t * s)
+{
+    if(!parse_chunks(s) || !stream_start(s)) {
+        _lv_png_stream_close(s);
+        return NULL;
+    }
+
+    /*The matches can't reach further back than the start of the image data
+     *so the window needn't be larger than the image data*/
+    uint64_t raw_size = (uint64_t)s->h * (s->row_bytes + 1);
+    uint32_t window_size = (uint32_t)1 << s->window_bits;
+    while(window_size > 256 && window_size / 2 >= raw_size) window_size /= 2;
+
+    s->window = lv_mem_alloc(window_size);
+    s->rows[0] = lv_mem_alloc(2 * (s->row_bytes + 1));
+    if(s->window == NULL || s->rows[0] == NULL) {
+        _lv_png_stream_close(s);
+        return NULL;
+    }
+    s->window_mask = window_size - 1;
+    s->rows[1] = s->rows[0] + s->row_bytes + 1;
+
+    /*The previous row of the first row is 0*/
+    lv_memset_00(s->rows[0], 2 * (s->row_bytes + 1));
+    return s;
+}
+
+/**
+ * Go to the beginning of the image data and read the zlib header
+ * @param s pointer to a stream
+ * @return true: ready to read the first row; false: invalid zlib header
+ */
+static bool stream_start(lv_png_stream_t * s)
+{
+    if(!in_seek(s, s->idat_pos)) return false;
+    s->chunk_left = s->idat_len;
+    s->idat_end = false;
+    s->err = false;
+    s->bit_buf = 0;
+    s->bit_cnt = 0;
+    s->final = false;
+    s->block = BLOCK_NONE;
+    s->copy_len = 0;
+    s->out_cnt = 0;
+    s->y = -1;
+    if(s->rows[0]) lv_memset_00(s->rows[s->cur], s->row_bytes + 1);
+
+    uint8_t cmf;
+    uint8_t flg;
+    if(!idat_byte(s, &cmf) || !idat_byte(s, &flg)) return false;
+
+    /*Deflate, no preset dictionary and valid check bits*/
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || (flg & 0x20) || ((cmf << 8) | flg) % 31) return false;
+    s->window_bits = (cmf >> 4) + 8;
+    return true;
+}
+
+/**
+ * Read the header, the palette and the transparency of the image until the first IDAT chunk
+ * @param s pointer to a stream
+ * @return true: the image can be streamed; false: invalid or interlaced image
+ */
+static bool parse_chunks(lv_png_stream_t * s)
+{
+    uint8_t buf[13];
+    if(!in_read(s, buf, 8) || memcmp(buf, png_signature, 8)) return false;
+
+    while(1) {
+        uint32_t len;
+        uint32_t type;
+        if(!in_read_u32(s, &len) || !in_read_u32(s, &type)) return false;
+        uint32_t pos = s->file_pos + s->in_pos;
+
+        if(type == CHUNK_IHDR) {
+            if(len != 13 || !in_read(s, buf, 13)) return false;
+            s->w = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+            s->h = ((uint32_t)buf[4] << 24) | ((uint32_t)buf[5] << 16) | ((uint32_t)buf[6] << 8) | buf[7];
+            s->bit_depth = buf[8];
+            s->color_type = buf[9];
+            /*Compression and filter method 0, not interlaced*/
+            if(buf[10] != 0 || buf[11] != 0 || buf[12] != 0) return false;
+            if(s->w == 0 || s->h == 0 || s->w > LV_COORD_MAX || s->h > LV_COORD_MAX) return false;
+
+            uint8_t channels;
+            switch(s->color_type) {
+                case 0:
+                    channels = 1;
+                    if(s->bit_depth != 1 && s->bit_depth != 2 && s->bit_depth != 4 && s->bit_depth != 8 &&
+                       s->bit_depth != 16) return false;
+                    break;
+                case 3:
+                    channels = 1;
+                    if(s->bit_depth != 1 && s->bit_depth != 2 && s->bit_depth != 4 && s->bit_depth != 8) return false;
+                    break;
+                case 2:
+                case 4:
+                case 6:
+                    channels = s->color_type == 2 ? 3 : (s->color_type == 4 ? 2 : 4);
+                    if(s->bit_depth != 8 && s->bit_depth != 16) return false;
+                    break;
+                default:
+                    return false;
+            }
+
+            uint32_t px_bits = (uint32_t)channels * s->bit_depth;
+            uint64_t row_bytes = ((uint64_t)s->w * px_bits + 7) / 8;
+            if(row_bytes * s->h >= UINT32_MAX) return false;
+            s->row_bytes = (uint32_t)row_bytes;
+            s->px_bytes = px_bits < 8 ? 1 : px_bits / 8;
+        }
+        else if(type == CHUNK_PLTE) {
+            if(len % 3 || len / 3 > PALETTE_MAX || s->palette) return false;
+            s->palette = lv_mem_alloc(PALETTE_MAX * 4);
+            if(s->palette == NULL) return false;
+            s->palette_cnt = len / 3;
+            uint32_t i;
+            for(i = 0; i < s->palette_cnt; i++) {
+                if(!in_read(s, &s->palette[i * 4], 3)) return false;
+                s->palette[i * 4 + 3] = 0xFF;
+            }
+        }
+        else if(type == CHUNK_TRNS) {
+            if(s->color_type == 3) {
+                uint32_t i;
+                for(i = 0; i < len && i < s->palette_cnt; i++) {
+                    if(!in_read(s, &s->palette[i * 4 + 3], 1)) return false;
+                }
+            }
+            else if((s->color_type == 0 && len == 2) || (s->color_type == 2 && len == 6)) {
+                uint32_t i;
+                for(i = 0; i < len / 2; i++) {
+                    if(!in_read(s, buf, 2)) return false;
+                    s->trns[i] = ((uint16_t)buf[0] << 8) | buf[1];
+                }
+                s->has_trns = true;
+            }
+        }
+        else if(type == CHUNK_IDAT) {
+            if(s->w == 0 || (s->color_type == 3 && s->palette == NULL)) return false;
+            s->idat_pos = pos;
+            s->idat_len = len;
+            return true;
+        }
+        else if(type == CHUNK_IEND) {
+            return false;
+        }
+
+        /*Skip the rest of the chunk and its CRC*/
+        if(!in_seek(s, pos + len + 4)) return false;
+    }
+}
+
+/**
+ * Read the next block of the file into `in`
+ * @param s pointer to a stream
+ * @return false: end of the data
+ */
+static bool in_fill(lv_png_stream_t * s)
+{
+    if(s->file_buf == NULL) return false;
+
+    s->file_pos += s->in_len;
+    uint32_t rn = 0;
+    lv_fs_read(&s->file, s->file_buf, FILE_BUF_SIZE, &rn);
+    s->in_len = rn;
+    s->in_pos = 0;
+    return rn > 0;
+}
+
+static inline bool in_byte(lv_png_stream_t * s, uint8_t * b)
+{
+    if(s->in_pos == s->in_len && !in_fill(s)) return false;
+    *b = s->in[s->in_pos++];
+    return true;
+}
+
+static bool in_read(lv_png_stream_t * s, uint8_t * buf, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        if(!in_byte(s, &buf[i])) return false;
+    }
+    return true;
+}
+
+/*Read a big endian 32 bit value*/
+static bool in_read_u32(lv_png_stream_t * s, uint32_t * v)
+{
+    uint8_t buf[4];
+    if(!in_read(s, buf, 4)) return false;
+    *v = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+    return true;
+}
+
+static bool in_seek(lv_png_stream_t * s, uint32_t pos)
+{
+    if(pos >= s->file_pos && pos - s->file_pos <= s->in_len) {
+        s->in_pos = pos - s->file_pos;
+        return true;
+    }
+
+    if(s->file_buf == NULL) return false;
+    if(lv_fs_seek(&s->file, pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    s->file_pos = pos;
+    s->in_len = 0;
+    s->in_pos = 0;
+    return true;
+}
+
+/**
+ * Get the next byte of the image data. Continue with the next IDAT chunk at the end of the current one.
+ * @param s pointer to a stream
+ * @param b store the byte here
+ * @return false: end of the image data
+ */
+static inline bool idat_byte(lv_png_stream_t * s, uint8_t * b)
+{
+    while(s->chunk_left == 0) {
+        if(s->idat_end) return false;
+
+        /*Skip the CRC and read the header of the next chunk*/
+        uint8_t crc[4];
+        uint32_t len;
+        uint32_t type;
+        if(!in_read(s, crc, 4) || !in_read_u32(s, &len) || !in_read_u32(s, &type) || type != CHUNK_IDAT) {
+            s->idat_end = true;
+            return false;
+        }
+        s->chunk_left = len;
+    }
+
+    if(!in_byte(s, b)) {
+        s->idat_end = true;
+        return false;
+    }
+    s->chunk_left--;
+    return true;
+}
+
+/*Have at least `n` bits in `bit_buf` if the data doesn't end sooner*/
+static inline void bits_fill(lv_png_stream_t * s, uint8_t n)
+{
+    while(s->bit_cnt < n) {
+        uint8_t b;
+        if(!idat_byte(s, &b)) return;
+        s->bit_buf |= (uint32_t)b << s->bit_cnt;
+        s->bit_cnt += 8;
+    }
+}
+
+/*Read `n` (max. 16) bits. Set `err` if the data ends.*/
+static inline uint32_t bits_get(lv_png_stream_t * s, uint8_t n)
+{
+    bits_fill(s, n);
+    if(s->bit_cnt < n) {
+        s->err = true;
+        return 0;
+    }
+
+    uint32_t v = s->bit_buf & (((uint32_t)1 << n) - 1);
+    s->bit_buf >>= n;
+    s->bit_cnt -= n;
+    return v;
+}
+
+/**
+ * Build the decoding tables of canonical Huffman codes
+ * @param h store the tables here
+ * @param lens length of the code of every symbol (0: unused symbol)
+ * @param n number of symbols
+ * @return false: the lengths are invalid
+ */
+static bool huff_build(huff_t * h, const uint8_t * lens, uint32_t n)
+{
+    uint16_t offs[16];
+    uint32_t i;
+
+    lv_memset_00(h->count, sizeof(h->count));
+    for(i = 0; i < n; i++) h->count[lens[i]]++;
+    h->count[0] = 0;
+
+    /*More codes than possible with the lengths*/
+    int32_t left = 1;
+    for(i = 1; i < 16; i++) {
+        left = (left << 1) - h->count[i];
+        if(left < 0) return false;
+    }
+
+    offs[1] = 0;
+    for(i = 1; i < 15; i++) offs[i + 1] = offs[i] + h->count[i];
+    for(i = 0; i < n; i++) {
+        if(lens[i]) h->symbol[offs[lens[i]]++] = i;
+    }
+
+    /*The codes are stored from their MSB but the bits of the stream are read from the LSB
+     *so the short codes are reversed to index the fast table*/
+    lv_memset_00(h->fast, sizeof(h->fast));
+    uint32_t code = 0;
+    uint32_t idx = 0;
+    uint32_t len;
+    for(len = 1; len <= HUFF_FAST_BITS; len++) {
+        for(i = 0; i < h->count[len]; i++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+
+            uint16_t e = (h->symbol[idx] << 4) | len;
+            for(; rev < (1 << HUFF_FAST_BITS); rev += 1 << len) h->fast[rev] = e;
+            code++;
+            idx++;
+        }
+        code <<= 1;
+    }
+
+    return true;
+}
+
+/**
+ * Decode a symbol
+ * @param s pointer to a stream
+ * @param h the code to use
+ * @return the symbol or -1 on error
+ */
+static inline int32_t huff_decode(lv_png_stream_t * s, const huff_t * h)
+{
+    bits_fill(s, HUFF_FAST_BITS);
+    uint16_t e = h->fast[s->bit_buf & HUFF_FAST_MASK];
+    uint8_t len = e & 0x0F;
+    if(len && len <= s->bit_cnt) {
+        s->bit_buf >>= len;
+        s->bit_cnt -= len;
+        return e >> 4;
+    }
+
+    /*Long code (or the end of the data): read it bit by bit*/
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    for(len = 1; len < 16; len++) {
+        code |= bits_get(s, 1);
+        if(s->err) return -1;
+        int32_t count = h->count[len];
+        if(code - count < first) return h->symbol[index + (code - first)];
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    s->err = true;
+    return -1;
+}
+
+static bool block_fixed(lv_png_stream_t * s)
+{
+    if(s->fixed) return true;
+
+    uint8_t lens[288];
+    uint32_t i;
+    for(i = 0; i < 144; i++) lens[i] = 8;
+    for(; i < 256; i++) lens[i] = 9;
+    for(; i < 280; i++) lens[i] = 7;
+    for(; i < 288; i++) lens[i] = 8;
+    huff_build(&s->lit, lens, 288);
+
+    for(i = 0; i < 30; i++) lens[i] = 5;
+    huff_build(&s->dist, lens, 30);
+
+    s->fixed = true;
+    return true;
+}
+
+static bool block_dynamic(lv_png_stream_t * s)
+{
+    uint8_t lens[286 + 30];
+    uint32_t nlen = bits_get(s, 5) + 257;
+    uint32_t ndist = bits_get(s, 5) + 1;
+    uint32_t ncode = bits_get(s, 4) + 4;
+    if(s->err || nlen > 286 || ndist > 30) return false;
+
+    s->fixed = false;
+
+    /*Decode the code lengths with the code length code built in `dist`*/
+    uint32_t i;
+    lv_memset_00(lens, 19);
+    for(i = 0; i < ncode; i++) lens[clen_order[i]] = bits_get(s, 3);
+    if(s->err || !huff_build(&s->dist, lens, 19)) return false;
+
+    i = 0;
+    while(i < nlen + ndist) {
+        int32_t sym = huff_decode(s, &s->dist);
+        if(sym < 0) return false;
+
+        if(sym < 16) {
+            lens[i++] = sym;
+            continue;
+        }
+
+        uint8_t len = 0;
+        uint32_t rep;
+        if(sym == 16) {
+            if(i == 0) return false;
+            len = lens[i - 1];
+            rep = 3 + bits_get(s, 2);
+        }
+        else if(sym == 17) rep = 3 + bits_get(s, 3);
+        else rep = 11 + bits_get(s, 7);
+
+        if(s->err || i + rep > nlen + ndist) return false;
+        while(rep--) lens[i++] = len;
+    }
+
+    /*No end of block code*/
+    if(lens[256] == 0) return false;
+
+    return huff_build(&s->lit, lens, nlen) && huff_build(&s->dist, lens + nlen, ndist);
+}
+
+/**
+ * Inflate the next bytes of the image data
+ * @param s pointer to a stream
+ * @param dst store the bytes here
+ * @param len number of bytes to inflate
+ * @return false: invalid or truncated data
+ */
+static bool inflate_out(lv_png_stream_t * s, uint8_t * dst, uint32_t len)
+{
+    uint8_t * window = s->window;
+    uint32_t mask = s->window_mask;
+
+    while(len) {
+        if(s->err) return false;
+
+        if(s->copy_len) {
+            uint32_t n = LV_MIN(len, s->copy_len);
+            uint32_t src = s->out_cnt - s->copy_dist;
+            s->copy_len -= n;
+            len -= n;
+            while(n--) {
+                uint8_t b = window[src++ & mask];
+                window[s->out_cnt++ & mask] = b;
+                *dst++ = b;
+            }
+        }
+        else if(s->block == BLOCK_HUFF) {
+            int32_t sym = huff_decode(s, &s->lit);
+            if(sym < 0) return false;
+
+            if(sym < 256) {
+                window[s->out_cnt++ & mask] = sym;
+                *dst++ = sym;
+                len--;
+            }
+            else if(sym == 256) {
+                s->block = BLOCK_NONE;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return false;
+                s->copy_len = len_base[sym] + bits_get(s, len_extra[sym]);
+
+                int32_t d = huff_decode(s, &s->dist);
+                if(d < 0 || d >= 30) return false;
+                s->copy_dist = dist_base[d] + bits_get(s, dist_extra[d]);
+                if(s->copy_dist > s->out_cnt || s->copy_dist > mask + 1) return false;
+            }
+        }
+        else if(s->block == BLOCK_STORED) {
+            if(s->stored_left == 0) {
+                s->block = BLOCK_NONE;
+                continue;
+            }
+
+            uint32_t n = LV_MIN(len, s->stored_left);
+            s->stored_left -= n;
+            len -= n;
+            while(n--) {
+                uint8_t b = bits_get(s, 8);
+                window[s->out_cnt++ & mask] = b;
+                *dst++ = b;
+            }
+        }
+        else {
+            /*The last block is finished but more data is required*/
+            if(s->final) return false;
+
+            s->final = bits_get(s, 1);
+            uint32_t type = bits_get(s, 2);
+            if(type == 0) {
+                /*Skip to the byte boundary*/
+                bits_get(s, s->bit_cnt & 0x7);
+                uint32_t stored_len = bits_get(s, 16);
+                uint32_t stored_nlen = bits_get(s, 16);
+                if(s->err || (stored_len ^ 0xFFFF) != stored_nlen) return false;
+                s->stored_left = stored_len;
+                s->block = BLOCK_STORED;
+            }
+            else if(type == 1) {
+                if(!block_fixed(s)) return false;
+                s->block = BLOCK_HUFF;
+            }
+            else if(type == 2) {
+                if(!block_dynamic(s)) return false;
+                s->block = BLOCK_HUFF;
+            }
+            else {
+                return false;
+            }
+        }
+    }
+
+    return !s->err;
+}
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+    int16_t pa = LV_ABS((int16_t)b - c);
+    int16_t pb = LV_ABS((int16_t)a - c);
+    int16_t pc = LV_ABS((int16_t)a + b - 2 * c);
+    if(pa <= pb && pa <= pc) return a;
+    if(pb <= pc) return b;
+    return c;
+}
+
+/**
+ * Inflate and unfilter the next row
+ * @param s pointer to a stream
+ * @return false: invalid or truncated data
+ */
+static bool row_next(lv_png_stream_t * s)
+{
+    const uint8_t * prev = s->rows[s->cur] + 1;
+    s->cur ^= 1;
+    uint8_t * row = s->rows[s->cur];
+    if(!inflate_out(s, row, s->row_bytes + 1)) return false;
+
+    uint8_t * cur = row + 1;
+    uint32_t n = s->row_bytes;
+    uint32_t bpp = s->px_bytes;
+    uint32_t i;
+    switch(row[0]) {
+        case 0:
+            break;
+        case 1:
+            for(i = bpp; i < n; i++) cur[i] += cur[i - bpp];
+            break;
+        case 2:
+            for(i = 0; i < n; i++) cur[i] += prev[i];
+            break;
+        case 3:
+            for(i = 0; i < bpp; i++) cur[i] += prev[i] >> 1;
+            for(; i < n; i++) cur[i] += (cur[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4:
+            for(i = 0; i < bpp; i++) cur[i] += prev[i];
+            for(; i < n; i++) cur[i] += paeth(cur[i - bpp], prev[i], prev[i - bpp]);
+            break;
+        default:
+            return false;
+    }
+
+    s->y++;
+    return true;
+}
+
+/*Write a pixel in the format of `LV_IMG_CF_TRUE_COLOR_ALPHA`*/
+static inline uint8_t * px_write(uint8_t * buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    lv_color_t c = lv_color_make(r, g, b);
+#if LV_COLOR_DEPTH == 32
+    buf[0] = c.ch.blue;
+    buf[1] = c.ch.green;
+    buf[2] = c.ch.red;
+    buf[3] = a;
+#elif LV_COLOR_DEPTH == 16
+    buf[0] = c.full & 0xFF;
+    buf[1] = c.full >> 8;
+    buf[2] = a;
+#else
+    buf[0] = c.full;
+    buf[1] = a;
+#endif
+    return buf + LV_IMG_PX_SIZE_ALPHA_BYTE;
+}
+
+/*Get the `x`th sample of a row with less than 8 bits per pixel*/
+static inline uint8_t sample_get(const uint8_t * row, uint32_t x, uint8_t bit_depth)
+{
+    uint32_t bit = x * bit_depth;
+    return (row[bit >> 3] >> (8 - bit_depth - (bit & 0x7))) & ((1 << bit_depth) - 1);
+}
+
+/**
+ * Convert the pixels of the current row to `LV_IMG_CF_TRUE_COLOR_ALPHA`
+ * @param s pointer to a stream
+ * @param x the first pixel to convert
+ * @param len number of pixels to convert
+ * @param buf store the pixels here
+ */
+static void row_convert(lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    const uint8_t * row = s->rows[s->cur] + 1;
+    uint32_t x_end = x + len;
+    uint8_t depth = s->bit_depth;
+    const uint8_t * p;
+
+    switch(s->color_type) {
+        case 0:
+            for(; x < x_end; x++) {
+                uint16_t v;
+                uint8_t gray;
+                if(depth == 16) {
+                    v = ((uint16_t)row[x * 2] << 8) | row[x * 2 + 1];
+                    gray = row[x * 2];
+                }
+                else if(depth == 8) {
+                    v = row[x];
+                    gray = v;
+                }
+                else {
+                    v = sample_get(row, x, depth);
+                    gray = v * (255 / ((1 << depth) - 1));
+                }
+                uint8_t a = s->has_trns && v == s->trns[0] ? 0x00 : 0xFF;
+                buf = px_write(buf, gray, gray, gray, a);
+            }
+            break;
+        case 2:
+            if(depth == 8) {
+                for(p = &row[x * 3]; x < x_end; x++, p += 3) {
+                    uint8_t a = s->has_trns && p[0] == s->trns[0] && p[1] == s->trns[1] && p[2] == s->trns[2] ? 0x00 : 0xFF;
+                    buf = px_write(buf, p[0], p[1], p[2], a);
+                }
+            }
+            else {
+                for(p = &row[x * 6]; x < x_end; x++, p += 6) {
+                    uint8_t a = 0xFF;
+                    if(s->has_trns && (((uint16_t)p[0] << 8) | p[1]) == s->trns[0] &&
+                       (((uint16_t)p[2] << 8) | p[3]) == s->trns[1] && (((uint16_t)p[4] << 8) | p[5]) == s->trns[2]) a = 0x00;
+                    buf = px_write(buf, p[0], p[2], p[4], a);
+                }
+            }
+            break;
+        case 3:
+            for(; x < x_end; x++) {
+                uint8_t i = depth == 8 ? row[x] : sample_get(row, x, depth);
+                if(i < s->palette_cnt) {
+                    p = &s->palette[i * 4];
+                    buf = px_write(buf, p[0], p[1], p[2], p[3]);
+                }
+                else {
+                    buf = px_write(buf, 0, 0, 0, 0xFF);
+                }
+            }
+            break;
+        case 4:
+            if(depth == 8) {
+                for(p = &row[x * 2]; x < x_end; x++, p += 2) buf = px_write(buf, p[0], p[0], p[0], p[1]);
+            }
+            else {
+                for(p = &row[x * 4]; x < x_end; x++, p += 4) buf = px_write(buf, p[0], p[0], p[0], p[2]);
+            }
+            break;
+        case 6:
+            if(depth == 8) {
+                for(p = &row[x * 4]; x < x_end; x++, p += 4) buf = px_write(buf, p[0], p[1], p[2], p[3]);
+            }
+            else {
+                for(p = &row[x * 8]; x < x_end; x++, p += 8) buf = px_write(buf, p[0], p[2], p[4], p[6]);
+            }
+            break;
+    }
+}
+
+#endif /*LV_USE_PNG*/
@@ -0,0 +1,91 @@
+/**
+ * @file lv_png_stream.h
+ * Decode PNG images row by row: inflate and unfilter only the rows which are read
+ * and keep only the current and the previous row and the window of the inflater.
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#if LV_USE_PNG
+
+#include "../../../misc/lv_types.h"
+#include "../../../misc/lv_area.h"
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_png_stream_t;
+typedef struct _lv_png_stream_t lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Open a PNG image stored in the memory
+ * @param data the PNG file's content
+ * @param size size of `data` in bytes
+ * @return the opened stream or NULL if the image is invalid, interlaced or out of memory
+ */
+lv_png_stream_t * _lv_png_stream_open_data(const uint8_t * data, uint32_t size);
+
+/**
+ * Open a PNG file
+ * @param fn path to the file
+ * @return the opened stream or NULL if the file can't be read, the image is invalid, interlaced or out of memory
+ */
+lv_png_stream_t * _lv_png_stream_open_file(const char * fn);
+
+/**
+ * Read the pixels of a row in `LV_IMG_CF_TRUE_COLOR_ALPHA` format.
+ * The rows after the last read row are decoded until `y`. The image is decoded again from the beginning
+ * if `y` is before the last read row.
+ * @param stream pointer to an opened stream
+ * @param x the first pixel to read
+ * @param y the row to read
+ * @param len number of pixels to read
+ * @param buf store the pixels here (`len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes)
+ * @return LV_RES_OK: no error; LV_RES_INV: the image data is invalid
+ */
+lv_res_t _lv_png_stream_read_line(lv_png_stream_t * stream, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                  uint8_t * buf);
+
+/**
+ * Get the memory allocated for a stream
+ * @param stream pointer to an opened stream
+ * @return the allocated memory in bytes
+ */
+uint32_t _lv_png_stream_get_mem_size(const lv_png_stream_t * stream);
+
+/**
+ * Close a stream and free its memory
+ * @param stream pointer to an opened stream
+ */
+void _lv_png_stream_close(lv_png_stream_t * stream);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PNG*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
@@ -51,6 +51,11 @@
 #include "tjpgd.h"
 #include "lv_sjpg.h"
 #include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_thread.h"
+
+#if LV_SJPG_DECODE_AHEAD && LV_USE_PARALLEL_RENDER == 0
+    #error "LV_SJPG_DECODE_AHEAD requires LV_USE_PARALLEL_RENDER"
+#endif
 
 /*********************
  *      DEFINES
@@ -65,6 +70,15 @@
 #define SJPEG_BLOCK_WIDTH_OFFSET        20
 #define SJPEG_FRAME_INFO_ARRAY_OFFSET   22
 
+/*The fragment cache is shared by the images drawn on the render threads*/
+#if LV_USE_PARALLEL_RENDER
+    #define FRAG_LOCK()     lv_mutex_lock(&frag_mutex)
+    #define FRAG_UNLOCK()   lv_mutex_unlock(&frag_mutex)
+#else
+    #define FRAG_LOCK()
+    #define FRAG_UNLOCK()
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -77,7 +91,7 @@ enum io_source_type {
 typedef struct {
     enum io_source_type type;
     lv_fs_file_t lv_file;
-    uint8_t * img_cache_buff;
+    uint8_t * img_cache_buff;           //The fragment being decoded (`lv_color_t` pixels)
     int img_cache_x_res;
     int img_cache_y_res;
     uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
@@ -96,12 +110,40 @@ typedef struct {
     int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    struct _frag_t * frag_cur;          //The fragment of `sjpeg_cache_frame_index`. It's not evicted while it's used.
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
 } SJPEG;
 
+/*A decoded fragment in the fragment cache*/
+typedef struct _frag_t {
+    const void * src;                   /*The data of a variable or the `SJPEG` of a file. NULL if invalidated*/
+    int frame_index;
+    uint32_t size;                      /*Memory of `buf` in bytes*/
+    lv_color_t * buf;                   /*`sjpeg_x_res * sjpeg_single_frame_height` pixels*/
+    uint16_t use_cnt;                   /*Number of opened images drawing from this fragment*/
+    uint8_t pending : 1;                /*It's being decoded by the decode ahead thread*/
+    uint8_t ahead : 1;                  /*It was decoded in advance and wasn't used yet*/
+} frag_t;
+
+#if LV_SJPG_DECODE_AHEAD
+/*The thread decoding the next fragment of an SJPG variable*/
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t start;
+    lv_thread_sync_t done;
+    JDEC jd;
+    uint8_t workb[TJPGD_WORKBUFF_SIZE];
+    io_source_t io;
+    frag_t * frag;                      /*The fragment given to the thread or NULL if it's idle*/
+    int32_t finished;                   /*Set by the thread when `frag` is decoded*/
+    bool ok;
+    bool inited;
+    bool en;
+} decode_ahead_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -114,10 +156,34 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static lv_color_t * frag_get(SJPEG * sjpeg, int frame_index);
+static void frag_release(SJPEG * sjpeg);
+static const void * frag_src(SJPEG * sjpeg);
+static frag_t * frag_find(const void * src, int frame_index);
+static frag_t * frag_alloc(const void * src, int frame_index, uint32_t size);
+static void frag_free(frag_t * frag);
+static bool frag_evict(void);
+static void frag_shrink(uint32_t size);
+static void frag_io_init(SJPEG * sjpeg, int frame_index, io_source_t * io);
+static bool frag_decode(frag_t * frag, JDEC * jd, uint8_t * workb, io_source_t * io);
+#if LV_SJPG_DECODE_AHEAD
+    static void ahead_start(SJPEG * sjpeg, int frame_index);
+    static void ahead_finish(void);
+    static void ahead_thread_cb(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_ll_t frag_ll;                 /*The decoded fragments, the most recently used first*/
+static uint32_t frag_cache_size;
+static lv_sjpg_cache_stats_t frag_stats;
+#if LV_USE_PARALLEL_RENDER
+    static lv_mutex_t frag_mutex;
+#endif
+#if LV_SJPG_DECODE_AHEAD
+    static decode_ahead_t ahead;
+#endif
 
 /**********************
  *      MACROS
@@ -133,7 +199,79 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+
+    _lv_ll_init(&frag_ll, sizeof(frag_t));
+    frag_cache_size = LV_SJPG_CACHE_SIZE;
+    lv_memset_00(&frag_stats, sizeof(frag_stats));
+#if LV_USE_PARALLEL_RENDER
+    lv_mutex_init(&frag_mutex);
+#endif
+#if LV_SJPG_DECODE_AHEAD
+    ahead.en = true;
+#endif
+}
+
+void lv_sjpg_cache_set_size(uint32_t size)
+{
+    FRAG_LOCK();
+    frag_cache_size = size;
+    frag_shrink(0);
+    FRAG_UNLOCK();
+}
+
+void lv_sjpg_cache_invalidate_src(const void * src)
+{
+    const void * data = NULL;
+    if(src) {
+        if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return;
+        data = ((const lv_img_dsc_t *)src)->data;
+    }
+
+    FRAG_LOCK();
+#if LV_SJPG_DECODE_AHEAD
+    if(ahead.frag && (data == NULL || ahead.frag->src == data)) ahead_finish();
+#endif
+
+    frag_t * frag = _lv_ll_get_head(&frag_ll);
+    while(frag) {
+        frag_t * next = _lv_ll_get_next(&frag_ll, frag);
+        /*Only the fragments of variables are kept after closing the images*/
+        if(frag->src && (data == NULL || frag->src == data)) {
+            /*The opened images can still draw their current fragment but it won't be found anymore*/
+            if(frag->use_cnt == 0) frag_free(frag);
+            else frag->src = NULL;
+        }
+        frag = next;
+    }
+    FRAG_UNLOCK();
+}
+
+void lv_sjpg_cache_get_stats(lv_sjpg_cache_stats_t * stats)
+{
+    FRAG_LOCK();
+    *stats = frag_stats;
+    FRAG_UNLOCK();
+}
+
+void lv_sjpg_cache_reset_stats(void)
+{
+    FRAG_LOCK();
+    frag_stats.hit_cnt = 0;
+    frag_stats.miss_cnt = 0;
+    frag_stats.ahead_cnt = 0;
+    frag_stats.evict_cnt = 0;
+    FRAG_UNLOCK();
+}
+
+#if LV_SJPG_DECODE_AHEAD
+void lv_sjpg_set_decode_ahead(bool en)
+{
+    FRAG_LOCK();
+    if(!en && ahead.frag) ahead_finish();
+    ahead.en = en;
+    FRAG_UNLOCK();
 }
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
@@ -279,20 +417,33 @@ end:
     return LV_RES_INV;
 }
 
+/*Store the decoded pixels in the fragment as `lv_color_t`*/
 static int img_data_cb(JDEC * jd, void * data, JRECT * rect)
 {
     io_source_t * io = jd->device;
-    uint8_t * cache = io->img_cache_buff;
+    lv_color_t * cache = (lv_color_t *)io->img_cache_buff;
     const int xres = io->img_cache_x_res;
-    uint8_t * buf = data;
-    const int INPUT_PIXEL_SIZE = 3;
     const int row_width = rect->right - rect->left + 1; // Row width in pixels.
-    const int row_size = row_width * INPUT_PIXEL_SIZE;  // Row size (bytes).
 
     for(int y = rect->top; y <= rect->bottom; y++) {
-        int row_offset = y * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
-        memcpy(cache + row_offset, buf, row_size);
-        buf += row_size;
+        lv_color_t * dest = cache + y * xres + rect->left;
+#if LV_COLOR_DEPTH == 16
+        /*TJpgDec outputs RGB565 in the native byte order (JD_FORMAT 1)*/
+        const uint16_t * src = data;
+#if LV_COLOR_16_SWAP
+        for(int x = 0; x < row_width; x++) dest[x].full = (uint16_t)((src[x] >> 8) | (src[x] << 8));
+#else
+        lv_memcpy(dest, src, row_width * sizeof(lv_color_t));
+#endif
+        data = (uint8_t *)data + row_width * 2;
+#else
+        const uint8_t * src = data;
+        for(int x = 0; x < row_width; x++) {
+            dest[x] = lv_color_make(src[0], src[1], src[2]);
+            src += 3;
+        }
+        data = (uint8_t *)data + row_width * 3;
+#endif
     }
 
     return 1;
@@ -394,13 +545,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+            sjpeg->frag_cur = NULL;
+            sjpeg->io.img_cache_buff = NULL;
             sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
@@ -458,14 +604,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[0] = img_frame_base;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+                sjpeg->frag_cur = NULL;
+                sjpeg->io.img_cache_buff = NULL;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -577,13 +717,8 @@ end:
                 }
 
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+                sjpeg->frag_cur = NULL;
+                sjpeg->io.img_cache_buff = NULL;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -665,14 +800,8 @@ end:
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+                sjpeg->frag_cur = NULL;
+                sjpeg->io.img_cache_buff = NULL;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -721,143 +850,24 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
 
-#elif  LV_COLOR_DEPTH == 8
+    FRAG_LOCK();
+    /*If line not from the current fragment, get it from the cache or decode it*/
+    lv_color_t * cache;
+    if(sjpeg_req_frame_index == sjpeg->sjpeg_cache_frame_index) cache = sjpeg->frag_cur->buf;
+    else cache = frag_get(sjpeg, sjpeg_req_frame_index);
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+    if(cache) {
+        cache += (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res + x;
+        lv_memcpy(buf, cache, len * sizeof(lv_color_t));
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
-#else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
-#else
-#error Unsupported LV_COLOR_DEPTH
-
+    FRAG_UNLOCK();
 
-#endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
+    return cache ? LV_RES_OK : LV_RES_INV;
 }
 
 /**
@@ -872,6 +882,10 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
     SJPEG * sjpeg = (SJPEG *) dsc->user_data;
     if(!sjpeg) return;
 
+    FRAG_LOCK();
+    frag_release(sjpeg);
+    FRAG_UNLOCK();
+
     switch(dsc->src_type) {
         case LV_IMG_SRC_FILE:
             if(sjpeg->io.lv_file.file_d) {
@@ -897,7 +911,6 @@ static int is_jpg(const uint8_t * raw_data)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
@@ -912,4 +925,248 @@ static void lv_sjpg_cleanup(SJPEG * sjpeg)
     lv_mem_free(sjpeg);
 }
 
+/**
+ * Get the pixels of a fragment from the cache or decode them. Called with the fragment cache locked.
+ * @param sjpeg         the image
+ * @param frame_index   index of the fragment
+ * @return              the pixels of the fragment or NULL on error
+ */
+static lv_color_t * frag_get(SJPEG * sjpeg, int frame_index)
+{
+    const void * src = frag_src(sjpeg);
+
+#if LV_SJPG_DECODE_AHEAD
+    /*Wait for the fragment if it's being decoded in advance*/
+    if(ahead.frag && ahead.frag->src == src && ahead.frag->frame_index == frame_index) ahead_finish();
+#endif
+
+    frag_t * frag = frag_find(src, frame_index);
+    if(frag) {
+        if(frag->ahead) frag_stats.ahead_cnt++;
+        else frag_stats.hit_cnt++;
+        frag->ahead = 0;
+        _lv_ll_move_before(&frag_ll, frag, _lv_ll_get_head(&frag_ll));
+    }
+    else {
+        uint32_t size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * sizeof(lv_color_t);
+        frag = frag_alloc(src, frame_index, size);
+        if(frag == NULL) return NULL;
+        frag_io_init(sjpeg, frame_index, &sjpeg->io);
+        if(frag_decode(frag, sjpeg->tjpeg_jd, sjpeg->workb, &sjpeg->io) == false) {
+            frag_free(frag);
+            return NULL;
+        }
+        frag_stats.miss_cnt++;
+    }
+
+    /*The previous fragment of the image can be freed now if it doesn't fit*/
+    if(sjpeg->frag_cur) sjpeg->frag_cur->use_cnt--;
+    frag->use_cnt++;
+    sjpeg->frag_cur = frag;
+    sjpeg->sjpeg_cache_frame_index = frame_index;
+    frag_shrink(0);
+
+#if LV_SJPG_DECODE_AHEAD
+    ahead_start(sjpeg, frame_index + 1);
+#endif
+
+    return frag->buf;
+}
+
+/*Called when the image is closed. The fragments of the variables are kept, the fragments of the files are freed.*/
+static void frag_release(SJPEG * sjpeg)
+{
+    if(sjpeg->frag_cur) sjpeg->frag_cur->use_cnt--;
+    sjpeg->frag_cur = NULL;
+    sjpeg->sjpeg_cache_frame_index = -1;
+
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        frag_shrink(0);
+        return;
+    }
+
+    frag_t * frag = _lv_ll_get_head(&frag_ll);
+    while(frag) {
+        frag_t * next = _lv_ll_get_next(&frag_ll, frag);
+        if(frag->src == sjpeg) frag_free(frag);
+        frag = next;
+    }
+}
+
+/*The key of the fragments of an image: the data of the variables and the `SJPEG` of the opened files*/
+static const void * frag_src(SJPEG * sjpeg)
+{
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) return sjpeg->sjpeg_data;
+    else return sjpeg;
+}
+
+static frag_t * frag_find(const void * src, int frame_index)
+{
+    frag_t * frag;
+    _LV_LL_READ(&frag_ll, frag) {
+        if(frag->src == src && frag->frame_index == frame_index && !frag->pending) return frag;
+    }
+    return NULL;
+}
+
+/*Allocate a fragment as the most recently used one and free the least recently used ones if it doesn't fit*/
+static frag_t * frag_alloc(const void * src, int frame_index, uint32_t size)
+{
+    frag_shrink(size);
+
+    /*Free the other fragments if there is not enough memory*/
+    lv_color_t * buf = lv_mem_alloc(size);
+    while(buf == NULL && frag_evict()) {
+        buf = lv_mem_alloc(size);
+    }
+    if(buf == NULL) return NULL;
+
+    frag_t * frag = _lv_ll_ins_head(&frag_ll);
+    if(frag == NULL) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+    lv_memset_00(frag, sizeof(frag_t));
+    frag->src = src;
+    frag->frame_index = frame_index;
+    frag->size = size;
+    frag->buf = buf;
+
+    frag_stats.entry_cnt++;
+    frag_stats.mem_used += size;
+    return frag;
+}
+
+static void frag_free(frag_t * frag)
+{
+    frag_stats.entry_cnt--;
+    frag_stats.mem_used -= frag->size;
+    lv_mem_free(frag->buf);
+    _lv_ll_remove(&frag_ll, frag);
+    lv_mem_free(frag);
+}
+
+/*Free the least recently used fragment which is not used by an opened image.
+ *Return false if there was no such fragment.*/
+static bool frag_evict(void)
+{
+    frag_t * frag;
+    _LV_LL_READ_BACK(&frag_ll, frag) {
+        if(!frag->pending && frag->use_cnt == 0) {
+            frag_free(frag);
+            frag_stats.evict_cnt++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*Free fragments until `size` more bytes fit in the cache*/
+static void frag_shrink(uint32_t size)
+{
+    while(frag_stats.mem_used + size > frag_cache_size) {
+        if(frag_evict() == false) break;
+    }
+}
+
+/*Set up `io` to read the fragment of the image*/
+static void frag_io_init(SJPEG * sjpeg, int frame_index, io_source_t * io)
+{
+    if(io->type == SJPEG_IO_SOURCE_C_ARRAY) {
+        io->raw_sjpg_data = sjpeg->frame_base_array[frame_index];
+        if(frame_index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(io->raw_sjpg_data - sjpeg->sjpeg_data);
+            io->raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+        }
+        else {
+            io->raw_sjpg_data_size = (uint32_t)(sjpeg->frame_base_array[frame_index + 1] - io->raw_sjpg_data);
+        }
+        io->raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        io->raw_sjpg_data_next_read_pos = sjpeg->frame_base_offset[frame_index];
+        lv_fs_seek(&io->lv_file, io->raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+    io->img_cache_x_res = sjpeg->sjpeg_x_res;
+}
+
+/*Decode a fragment into its buffer from an `io` set up by `frag_io_init()`*/
+static bool frag_decode(frag_t * frag, JDEC * jd, uint8_t * workb, io_source_t * io)
+{
+    io->img_cache_buff = (uint8_t *)frag->buf;
+
+    JRESULT rc = jd_prepare(jd, input_func, workb, (size_t)TJPGD_WORKBUFF_SIZE, io);
+    if(rc != JDR_OK) return false;
+    rc = jd_decomp(jd, img_data_cb, 0);
+    return rc == JDR_OK;
+}
+
+#if LV_SJPG_DECODE_AHEAD
+
+/*Give the fragment to the decode ahead thread if it's idle. Only the fragments of variables are decoded
+ *in advance because the file drivers can't be used on more threads.*/
+static void ahead_start(SJPEG * sjpeg, int frame_index)
+{
+    if(!ahead.en || sjpeg->io.type != SJPEG_IO_SOURCE_C_ARRAY) return;
+    if(frame_index >= sjpeg->sjpeg_total_frames) return;
+
+    if(ahead.frag) {
+        if(!LV_ATOMIC_LOAD_ACQ(&ahead.finished)) return;
+        ahead_finish();
+    }
+
+    const void * src = frag_src(sjpeg);
+    if(frag_find(src, frame_index)) return;
+
+    if(!ahead.inited) {
+        if(lv_thread_sync_init(&ahead.start) != LV_RES_OK ||
+           lv_thread_sync_init(&ahead.done) != LV_RES_OK ||
+           lv_thread_init(&ahead.thread, ahead_thread_cb, LV_PARALLEL_RENDER_STACK_SIZE, NULL) != LV_RES_OK) {
+            LV_LOG_WARN("Couldn't start the decode ahead thread");
+            ahead.en = false;
+            return;
+        }
+        ahead.inited = true;
+    }
+
+    uint32_t size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * sizeof(lv_color_t);
+    frag_t * frag = frag_alloc(src, frame_index, size);
+    if(frag == NULL) return;
+    frag->pending = 1;
+    frag->ahead = 1;
+
+    /*The thread reads only the data of the variable so the image can be closed in the meantime*/
+    ahead.io = sjpeg->io;
+    frag_io_init(sjpeg, frame_index, &ahead.io);
+    ahead.frag = frag;
+    LV_ATOMIC_STORE(&ahead.finished, 0);
+    lv_thread_sync_signal(&ahead.start);
+}
+
+/*Wait for the decode ahead thread and add its fragment to the cache*/
+static void ahead_finish(void)
+{
+    lv_thread_sync_wait(&ahead.done);
+
+    frag_t * frag = ahead.frag;
+    ahead.frag = NULL;
+    frag->pending = 0;
+    if(!ahead.ok) frag_free(frag);
+}
+
+static void ahead_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        lv_thread_sync_wait(&ahead.start);
+        ahead.ok = frag_decode(ahead.frag, &ahead.jd, ahead.workb, &ahead.io);
+        LV_ATOMIC_STORE_REL(&ahead.finished, 1);
+        lv_thread_sync_signal(&ahead.done);
+    }
+}
+
+#endif /*LV_SJPG_DECODE_AHEAD*/
+
 #endif /*LV_USE_SJPG*/
@@ -24,12 +24,58 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Counters of the fragment cache. Can be used to tune `LV_SJPG_CACHE_SIZE`.
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of fragments found in the cache when the drawn lines moved to them*/
+    uint32_t miss_cnt;      /**< Number of fragments decoded when they were needed*/
+    uint32_t ahead_cnt;     /**< Number of fragments decoded in advance by `LV_SJPG_DECODE_AHEAD` and used*/
+    uint32_t evict_cnt;     /**< Number of fragments freed to stay below the cache size*/
+    uint32_t entry_cnt;     /**< Number of currently decoded fragments*/
+    uint32_t mem_used;      /**< Memory of the currently decoded fragments [bytes]*/
+} lv_sjpg_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_split_jpeg_init(void);
 
+/**
+ * Set the memory of the decoded fragments of all JPG and SJPG images (`LV_SJPG_CACHE_SIZE` by default).
+ * The least recently used fragments are freed right away if they don't fit.
+ * @param size      the size in bytes. 0: keep only the current fragment of the opened images.
+ */
+void lv_sjpg_cache_set_size(uint32_t size);
+
+/**
+ * Free the decoded fragments of an SJPG or JPG variable. The fragments of the variables are kept after the image
+ * is closed (until they are evicted), so it has to be called if the data of a variable is changed or freed.
+ * @param src       pointer to the `lv_img_dsc_t` of the image or NULL to free the fragments of all variables
+ */
+void lv_sjpg_cache_invalidate_src(const void * src);
+
+/**
+ * Get the counters of the fragment cache
+ * @param stats     store the counters here
+ */
+void lv_sjpg_cache_get_stats(lv_sjpg_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, decode ahead and eviction counters of the fragment cache
+ */
+void lv_sjpg_cache_reset_stats(void);
+
+#if LV_SJPG_DECODE_AHEAD
+/**
+ * Enable or disable decoding the next fragment of the SJPG variables on an other thread.
+ * It's enabled by default with `LV_SJPG_DECODE_AHEAD`.
+ * @param en        true: enable; false: disable
+ */
+void lv_sjpg_set_decode_ahead(bool en);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -34,6 +34,9 @@
 
 void lv_extra_init(void)
 {
+#if LV_USE_LAYER_CACHE
+    _lv_layer_cache_init();
+#endif
 #if LV_USE_FLEX
     lv_flex_init();
 #endif
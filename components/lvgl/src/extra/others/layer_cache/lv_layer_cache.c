@@ -0,0 +1,363 @@
+/**
+ * @file lv_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_layer_cache.h"
+#if LV_USE_LAYER_CACHE
+
+#include "../snapshot/lv_snapshot.h"
+#include "../../../core/lv_disp.h"
+#include "../../../draw/lv_draw_img.h"
+#include "../../../misc/lv_ll.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The layers are rendered as ARGB images as the objects can be transparent and anti-aliased.
+ *Layers without transparent pixels are converted to `LV_IMG_CF_TRUE_COLOR` afterwards.*/
+#define LAYER_CF    LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _lv_layer_cache_entry_t {
+    lv_obj_t * obj;
+    lv_img_dsc_t img;       /*The rendered layer. Its `data` is kept to render the layer again with the same size*/
+    uint32_t buf_size;      /*Size of `img.data` in bytes. 0: no buffer*/
+    uint32_t last_used;     /*`prepare_cnt` when the layer was visible in an invalidated area*/
+    uint8_t valid : 1;      /*`img` shows the current state of the layer*/
+} layer_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void layer_render(layer_entry_t * entry);
+static bool layer_make_room(layer_entry_t * entry, uint32_t size);
+static void layer_free_buf(layer_entry_t * entry);
+static void layer_get_area(const lv_obj_t * obj, lv_area_t * area);
+static bool layer_is_shown(const lv_obj_t * obj);
+static bool layer_is_invalidated(lv_disp_t * disp, const lv_obj_t * obj);
+static bool layer_remove_alpha(lv_img_dsc_t * img);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_ll_t layer_ll;
+static uint32_t layer_cnt;
+static uint32_t cache_size = LV_LAYER_CACHE_SIZE;
+static uint32_t mem_used;
+static uint32_t prepare_cnt;
+static bool rendering;      /*Draw the objects normally while a layer is rendered*/
+static uint32_t render_cnt;
+static uint32_t evict_cnt;
+static uint32_t skip_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_layer_cache_init(void)
+{
+    _lv_ll_init(&layer_ll, sizeof(layer_entry_t));
+}
+
+void lv_layer_cache_set_size(uint32_t size)
+{
+    layer_entry_t * entry;
+    _LV_LL_READ(&layer_ll, entry) {
+        layer_free_buf(entry);
+    }
+
+    cache_size = size;
+}
+
+uint32_t lv_layer_cache_get_size(void)
+{
+    return cache_size;
+}
+
+void lv_layer_cache_invalidate(lv_obj_t * obj)
+{
+    if(obj) {
+        if(obj->layer_cache) obj->layer_cache->valid = 0;
+        return;
+    }
+
+    layer_entry_t * entry;
+    _LV_LL_READ(&layer_ll, entry) {
+        entry->valid = 0;
+    }
+}
+
+void lv_layer_cache_get_stats(lv_layer_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_layer_cache_stats_t));
+    stats->render_cnt = render_cnt;
+    stats->evict_cnt = evict_cnt;
+    stats->skip_cnt = skip_cnt;
+    stats->layer_cnt = layer_cnt;
+    stats->mem_used = mem_used;
+
+    layer_entry_t * entry;
+    _LV_LL_READ(&layer_ll, entry) {
+        if(entry->valid) stats->cached_cnt++;
+    }
+}
+
+void lv_layer_cache_reset_stats(void)
+{
+    render_cnt = 0;
+    evict_cnt = 0;
+    skip_cnt = 0;
+}
+
+void _lv_layer_cache_update_obj(lv_obj_t * obj)
+{
+    bool en = lv_obj_has_flag(obj, LV_OBJ_FLAG_LAYER_CACHE);
+    if(en && obj->layer_cache == NULL) {
+        layer_entry_t * entry = _lv_ll_ins_tail(&layer_ll);
+        LV_ASSERT_MALLOC(entry);
+        if(entry == NULL) return;   /*Drawn normally*/
+
+        lv_memset_00(entry, sizeof(layer_entry_t));
+        entry->obj = obj;
+        obj->layer_cache = entry;
+        layer_cnt++;
+    }
+    else if(!en && obj->layer_cache) {
+        _lv_layer_cache_remove_obj(obj);
+    }
+}
+
+void _lv_layer_cache_remove_obj(lv_obj_t * obj)
+{
+    layer_entry_t * entry = obj->layer_cache;
+    if(entry == NULL) return;
+
+    layer_free_buf(entry);
+    _lv_ll_remove(&layer_ll, entry);
+    lv_mem_free(entry);
+    obj->layer_cache = NULL;
+    layer_cnt--;
+}
+
+void _lv_layer_cache_obj_changed(const lv_obj_t * obj)
+{
+    if(layer_cnt == 0) return;
+
+    /*The object is part of the layers of all of its parents with a cache*/
+    while(obj) {
+        if(obj->layer_cache) obj->layer_cache->valid = 0;
+        obj = obj->parent;
+    }
+}
+
+void _lv_layer_cache_prepare(lv_disp_t * disp)
+{
+    if(layer_cnt == 0) return;
+
+    prepare_cnt++;
+
+    /*Mark all visible layers as used first, so they are not evicted by each other*/
+    layer_entry_t * entry;
+    _LV_LL_READ(&layer_ll, entry) {
+        if(layer_is_invalidated(disp, entry->obj)) entry->last_used = prepare_cnt;
+    }
+
+    _LV_LL_READ(&layer_ll, entry) {
+        if(entry->last_used != prepare_cnt) continue;
+        if(_lv_layer_cache_is_ready(entry->obj)) continue;
+        layer_render(entry);
+    }
+}
+
+bool _lv_layer_cache_is_ready(const lv_obj_t * obj)
+{
+    layer_entry_t * entry = obj->layer_cache;
+    if(entry == NULL || !entry->valid || rendering) return false;
+
+    /*The size should be changed only with invalidation but be sure not to draw a wrong image*/
+    lv_area_t area;
+    layer_get_area(obj, &area);
+    return entry->img.header.w == lv_area_get_width(&area) && entry->img.header.h == lv_area_get_height(&area);
+}
+
+bool _lv_layer_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_obj_t * obj)
+{
+    if(!_lv_layer_cache_is_ready(obj)) return false;
+
+    lv_area_t area;
+    layer_get_area(obj, &area);
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    lv_img_dsc_t * img = &obj->layer_cache->img;
+    lv_draw_img_decoded(draw_ctx, &dsc, &area, img->data, img->header.cf);
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void layer_render(layer_entry_t * entry)
+{
+    entry->valid = 0;
+
+    uint32_t size = lv_snapshot_buf_size_needed(entry->obj, LAYER_CF);
+    if(size == 0 || !layer_make_room(entry, size)) {
+        skip_cnt++;
+        return;
+    }
+
+    if(entry->buf_size == 0) {
+        void * buf = lv_mem_alloc(size);
+        if(buf == NULL) {
+            skip_cnt++;
+            return;
+        }
+        entry->img.data = buf;
+        entry->buf_size = size;
+        mem_used += size;
+    }
+
+    void * buf = (void *)entry->img.data;
+    rendering = true;
+    lv_res_t res = lv_snapshot_take_to_buf(entry->obj, LAYER_CF, &entry->img, buf, entry->buf_size);
+    rendering = false;
+    if(res != LV_RES_OK) {
+        entry->img.data = buf;
+        layer_free_buf(entry);
+        skip_cnt++;
+        return;
+    }
+
+    /*Opaque layers need less memory*/
+    if(layer_remove_alpha(&entry->img) && entry->img.data_size < entry->buf_size) {
+        buf = lv_mem_realloc(buf, entry->img.data_size);
+        if(buf) {
+            mem_used -= entry->buf_size - entry->img.data_size;
+            entry->buf_size = entry->img.data_size;
+            entry->img.data = buf;
+        }
+    }
+
+    entry->valid = 1;
+    render_cnt++;
+}
+
+/**
+ * Free the buffers of the least recently used layers until a layer's image fits in the cache
+ * @param entry the layer to render
+ * @param size the size of the layer's image in bytes
+ * @return true: the image fits; false: the image doesn't fit even if all other layers are evicted
+ */
+static bool layer_make_room(layer_entry_t * entry, uint32_t size)
+{
+    /*The buffer of the layer can be reused only with the same size*/
+    if(entry->buf_size != size) layer_free_buf(entry);
+    if(size > cache_size) return false;
+
+    while(mem_used - entry->buf_size + size > cache_size) {
+        /*Drop the outdated images first. The layers visible in the current refresh are kept.*/
+        layer_entry_t * victim = NULL;
+        layer_entry_t * e;
+        _LV_LL_READ(&layer_ll, e) {
+            if(e == entry || e->buf_size == 0 || e->last_used == prepare_cnt) continue;
+            if(victim == NULL || (!e->valid && victim->valid) ||
+               (e->valid == victim->valid && e->last_used < victim->last_used)) {
+                victim = e;
+            }
+        }
+
+        if(victim == NULL) return false;
+        if(victim->valid) evict_cnt++;
+        victim->valid = 0;
+        layer_free_buf(victim);
+    }
+
+    return true;
+}
+
+static void layer_free_buf(layer_entry_t * entry)
+{
+    if(entry->buf_size) {
+        lv_mem_free((void *)entry->img.data);
+        mem_used -= entry->buf_size;
+    }
+
+    entry->img.data = NULL;
+    entry->buf_size = 0;
+    entry->valid = 0;
+}
+
+/*The area of the image: the object with its extra draw size, as in `lv_snapshot`*/
+static void layer_get_area(const lv_obj_t * obj, lv_area_t * area)
+{
+    lv_obj_get_coords(obj, area);
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(area, ext_size, ext_size);
+}
+
+static bool layer_is_shown(const lv_obj_t * obj)
+{
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+        obj = obj->parent;
+    }
+    return true;
+}
+
+/*Check if a layer will be drawn in the current refresh of a display*/
+static bool layer_is_invalidated(lv_disp_t * disp, const lv_obj_t * obj)
+{
+    if(lv_obj_get_disp(obj) != disp) return false;
+    if(!layer_is_shown(obj)) return false;
+
+    /*Clip to the parents and check if it's on an active screen*/
+    lv_area_t area;
+    layer_get_area(obj, &area);
+    if(!lv_obj_area_is_visible(obj, &area)) return false;
+
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_on(&area, &disp->inv_areas[i])) return true;
+    }
+    return false;
+}
+
+/**
+ * Convert an image to `LV_IMG_CF_TRUE_COLOR` if all of its pixels are opaque to draw it without blending
+ * @param img pointer to a rendered layer
+ * @return true: the image was converted; false: the image has transparent pixels
+ */
+static bool layer_remove_alpha(lv_img_dsc_t * img)
+{
+    uint8_t * px = (uint8_t *)img->data;
+    uint32_t px_cnt = (uint32_t)img->header.w * img->header.h;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        if(px[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] != LV_OPA_COVER) return false;
+    }
+
+    /*Copy byte by byte as the pixels overlap*/
+    uint8_t * dest = px;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t b;
+        for(b = 0; b < sizeof(lv_color_t); b++) *dest++ = px[i * LV_IMG_PX_SIZE_ALPHA_BYTE + b];
+    }
+
+    img->header.cf = LV_IMG_CF_TRUE_COLOR;
+    img->data_size = px_cnt * sizeof(lv_color_t);
+    return true;
+}
+
+#endif /*LV_USE_LAYER_CACHE*/
@@ -0,0 +1,139 @@
+/**
+ * @file lv_layer_cache.h
+ * Render the objects with `LV_OBJ_FLAG_LAYER_CACHE` and their children once into an image
+ * and draw the image instead of the objects until something changes in them.
+ */
+
+#ifndef LV_LAYER_CACHE_H
+#define LV_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../core/lv_obj.h"
+
+#if LV_USE_LAYER_CACHE
+
+#if LV_USE_SNAPSHOT == 0
+#error "lv_layer_cache: lv_snapshot is required. Enable it in lv_conf.h (LV_USE_SNAPSHOT  1)"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_layer_cache_entry_t;
+
+/**
+ * Counters of the layer cache. Can be used to tune `LV_LAYER_CACHE_SIZE`.
+ */
+typedef struct {
+    uint32_t render_cnt;    /**< Number of times a layer was rendered because it wasn't cached or has changed*/
+    uint32_t evict_cnt;     /**< Number of cached layers dropped to make room for other layers*/
+    uint32_t skip_cnt;      /**< Number of times a layer didn't fit in the cache and was drawn normally*/
+    uint32_t layer_cnt;     /**< Number of objects with `LV_OBJ_FLAG_LAYER_CACHE`*/
+    uint32_t cached_cnt;    /**< Number of currently cached layers*/
+    uint32_t mem_used;      /**< Memory used by the currently cached layers [bytes]*/
+} lv_layer_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the memory budget of the cached layers. The cached layers are dropped.
+ * Layers which don't fit are drawn normally.
+ * @param mem_size memory of the images of the layers in bytes
+ */
+void lv_layer_cache_set_size(uint32_t mem_size);
+
+/**
+ * Get the memory budget of the cached layers
+ * @return the memory of the images of the layers in bytes
+ */
+uint32_t lv_layer_cache_get_size(void);
+
+/**
+ * Drop the cached image of a layer. It's rendered again when it's drawn next time.
+ * Needed only if the layer changes without being invalidated, e.g. in a draw event.
+ * @param obj pointer to an object with `LV_OBJ_FLAG_LAYER_CACHE` or NULL to drop all layers
+ */
+void lv_layer_cache_invalidate(lv_obj_t * obj);
+
+/**
+ * Get the counters of the layer cache
+ * @param stats store the counters here
+ */
+void lv_layer_cache_get_stats(lv_layer_cache_stats_t * stats);
+
+/**
+ * Reset the render, eviction and skip counters of the layer cache
+ */
+void lv_layer_cache_reset_stats(void);
+
+/**
+ * Initialize the layer cache. Called by `lv_init()`.
+ */
+void _lv_layer_cache_init(void);
+
+/**
+ * Add an object to or remove it from the layer cache according to its `LV_OBJ_FLAG_LAYER_CACHE` flag.
+ * Called when the flag is added or cleared.
+ * @param obj pointer to an object
+ */
+void _lv_layer_cache_update_obj(lv_obj_t * obj);
+
+/**
+ * Remove an object from the layer cache and free its image. Called when the object is deleted.
+ * @param obj pointer to an object
+ */
+void _lv_layer_cache_remove_obj(lv_obj_t * obj);
+
+/**
+ * Drop the cached layers which contain an object. Called when the object is invalidated.
+ * @param obj pointer to an object
+ */
+void _lv_layer_cache_obj_changed(const lv_obj_t * obj);
+
+/**
+ * Render the layers which are visible in the invalidated areas of a display and are not cached yet.
+ * Called before the areas are drawn, so the layers are only read while drawing (also by the helper threads).
+ * @param disp pointer to the display being refreshed
+ */
+void _lv_layer_cache_prepare(lv_disp_t * disp);
+
+/**
+ * Check if an object is drawn from the layer cache
+ * @param obj pointer to an object
+ * @return true: the cached image of `obj` will be drawn instead of `obj` and its children
+ */
+bool _lv_layer_cache_is_ready(const lv_obj_t * obj);
+
+/**
+ * Draw the cached image of an object
+ * @param draw_ctx pointer to a draw context. The image is clipped to its `clip_area`.
+ * @param obj pointer to an object
+ * @return true: the image was drawn; false: the object has no cached image, draw it normally
+ */
+bool _lv_layer_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_LAYER_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_LAYER_CACHE_H*/
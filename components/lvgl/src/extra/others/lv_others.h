@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "snapshot/lv_snapshot.h"
 #include "monkey/lv_monkey.h"
+#include "layer_cache/lv_layer_cache.h"
 
 /*********************
  *      DEFINES
@@ -47,6 +47,7 @@ uint32_t lv_snapshot_buf_size_needed(lv_obj_t * obj, lv_img_cf_t cf)
 {
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
         case LV_IMG_CF_ALPHA_4BIT:
@@ -86,6 +87,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
 
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
         case LV_IMG_CF_ALPHA_4BIT:
@@ -118,7 +120,9 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     /*In lack of a better idea use the resolution of the object's display*/
     driver.hor_res = lv_disp_get_hor_res(obj_disp);
     driver.ver_res = lv_disp_get_hor_res(obj_disp);
-    lv_disp_drv_use_generic_set_px_cb(&driver, cf);
+    /*Pre-multiplied snapshots are rendered as normal ARGB images and converted at the end*/
+    bool premult = cf == LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT;
+    lv_disp_drv_use_generic_set_px_cb(&driver, premult ? LV_IMG_CF_TRUE_COLOR_ALPHA : cf);
 
     lv_disp_t fake_disp;
     lv_memset_00(&fake_disp, sizeof(lv_disp_t));
@@ -147,6 +151,10 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     dsc->header.w = w;
     dsc->header.h = h;
     dsc->header.cf = cf;
+    if(premult) {
+        dsc->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        lv_img_buf_premultiply(dsc);
+    }
     return LV_RES_OK;
 }
 
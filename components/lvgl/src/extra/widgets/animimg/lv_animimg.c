@@ -38,12 +38,16 @@
  **********************/
 static void index_change(lv_obj_t * obj, int32_t index);
 static void lv_animimg_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_animimg_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void delta_free(lv_obj_t * obj);
+static void delta_frame_show(lv_obj_t * obj, int32_t id);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_animimg_class = {
     .constructor_cb = lv_animimg_constructor,
+    .destructor_cb = lv_animimg_destructor,
     .instance_size = sizeof(lv_animimg_t),
     .base_class = &lv_img_class
 };
@@ -68,11 +72,50 @@ void lv_animimg_set_src(lv_obj_t * obj,  lv_img_dsc_t * dsc[], uint8_t num)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_animimg_t * animimg = (lv_animimg_t *)obj;
+    if(animimg->delta) {
+        delta_free(obj);
+        /*Don't draw the freed frame buffer*/
+        lv_img_set_src(obj, num ? dsc[0] : NULL);
+    }
     animimg->dsc = dsc;
     animimg->pic_count = num;
     lv_anim_set_values(&animimg->anim, 0, num);
 }
 
+void lv_animimg_set_delta_src(lv_obj_t * obj, const lv_animimg_delta_dsc_t * dsc)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(dsc);
+    lv_animimg_t * animimg = (lv_animimg_t *)obj;
+
+    /*Only the formats with whole bytes per pixel*/
+    uint32_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
+    if(dsc->frame_cnt == 0 || px_size == 0 || (px_size & 0x7) || !dsc->frames[0].keyframe) {
+        LV_LOG_WARN("lv_animimg_set_delta_src: unsupported sequence");
+        return;
+    }
+
+    uint32_t buf_size = (uint32_t)dsc->header.w * dsc->header.h * (px_size >> 3);
+    if(animimg->delta == NULL || animimg->frame_dsc.data_size != buf_size) {
+        delta_free(obj);
+        uint8_t * buf = lv_mem_alloc(buf_size);
+        LV_ASSERT_MALLOC(buf);
+        if(buf == NULL) return;
+        animimg->frame_dsc.data = buf;
+        animimg->frame_dsc.data_size = buf_size;
+    }
+
+    animimg->delta = dsc;
+    animimg->dsc = NULL;
+    animimg->pic_count = dsc->frame_cnt;
+    animimg->frame_dsc.header = dsc->header;
+    animimg->frame_act = -1;
+    lv_anim_set_values(&animimg->anim, 0, dsc->frame_cnt);
+
+    delta_frame_show(obj, 0);
+    lv_img_set_src(obj, &animimg->frame_dsc);
+}
+
 void lv_animimg_start(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -103,6 +146,70 @@ void lv_animimg_set_repeat_count(lv_obj_t * obj, uint16_t count)
  * Getter functions
  *====================*/
 
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_animimg_delta_decode(const lv_animimg_delta_dsc_t * dsc, uint32_t id, uint8_t * buf)
+{
+    const lv_animimg_delta_frame_t * frame = &dsc->frames[id];
+    uint32_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t stride = dsc->header.w * px_size;
+
+    lv_area_t area;
+    if(frame->keyframe) lv_area_set(&area, 0, 0, dsc->header.w - 1, dsc->header.h - 1);
+    else lv_area_set(&area, frame->x, frame->y, frame->x + frame->w - 1, frame->y + frame->h - 1);
+
+    uint32_t w = lv_area_get_width(&area);
+    uint32_t h = lv_area_get_height(&area);
+    if(w == 0 || h == 0) return;
+
+    const uint8_t * src = dsc->data + frame->data_ofs;
+    uint8_t * row = buf + area.y1 * stride + area.x1 * px_size;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    while(y < h) {
+        uint32_t op = src[0] >> 6;
+        uint32_t cnt = src[0] & 0x3F;
+        src++;
+        if(cnt == 0) {
+            cnt = src[0] | (src[1] << 8);
+            src += 2;
+        }
+
+        /*The operations continue in the next row*/
+        while(cnt && y < h) {
+            uint32_t n = LV_MIN(cnt, w - x);
+            uint32_t n_bytes = n * px_size;
+            uint8_t * dst = row + x * px_size;
+            if(op == LV_ANIMIMG_DELTA_OP_COPY) {
+                lv_memcpy(dst, src, n_bytes);
+                src += n_bytes;
+            }
+            else if(op == LV_ANIMIMG_DELTA_OP_FILL) {
+                /*Double the filled part in every step*/
+                uint32_t filled = px_size;
+                lv_memcpy(dst, src, px_size);
+                while(filled < n_bytes) {
+                    uint32_t c = LV_MIN(filled, n_bytes - filled);
+                    lv_memcpy(dst + filled, dst, c);
+                    filled += c;
+                }
+            }
+
+            cnt -= n;
+            x += n;
+            if(x == w) {
+                x = 0;
+                y++;
+                row += stride;
+            }
+        }
+
+        if(op == LV_ANIMIMG_DELTA_OP_FILL) src += px_size;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -116,6 +223,9 @@ static void lv_animimg_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
 
     animimg->dsc = NULL;
     animimg->pic_count = -1;
+    animimg->delta = NULL;
+    lv_memset_00(&animimg->frame_dsc, sizeof(animimg->frame_dsc));
+    animimg->frame_act = -1;
     //initial animation
     lv_anim_init(&animimg->anim);
     lv_anim_set_var(&animimg->anim, obj);
@@ -125,6 +235,12 @@ static void lv_animimg_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
     lv_anim_set_repeat_count(&animimg->anim, LV_ANIM_REPEAT_INFINITE);
 }
 
+static void lv_animimg_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    delta_free(obj);
+}
+
 static void index_change(lv_obj_t * obj, int32_t index)
 {
     lv_coord_t idx;
@@ -132,7 +248,69 @@ static void index_change(lv_obj_t * obj, int32_t index)
 
     idx = index % animimg->pic_count;
 
-    lv_img_set_src(obj, animimg->dsc[idx]);
+    if(animimg->delta) delta_frame_show(obj, idx);
+    else lv_img_set_src(obj, animimg->dsc[idx]);
+}
+
+static void delta_free(lv_obj_t * obj)
+{
+    lv_animimg_t * animimg = (lv_animimg_t *)obj;
+    if(animimg->delta == NULL) return;
+
+    lv_img_cache_invalidate_src(&animimg->frame_dsc);
+    lv_mem_free((void *)animimg->frame_dsc.data);
+    lv_memset_00(&animimg->frame_dsc, sizeof(animimg->frame_dsc));
+    animimg->delta = NULL;
+    animimg->frame_act = -1;
+}
+
+/**
+ * Decode a frame of the delta compressed source and invalidate the changed area.
+ * Normally only the next frame needs to be decoded. Else the frames are decoded from the previous keyframe.
+ */
+static void delta_frame_show(lv_obj_t * obj, int32_t id)
+{
+    lv_animimg_t * animimg = (lv_animimg_t *)obj;
+    const lv_animimg_delta_dsc_t * delta = animimg->delta;
+    int32_t act = animimg->frame_act;
+    if(id == act) return;
+
+    int32_t keyframe = id;
+    while(keyframe > 0 && !delta->frames[keyframe].keyframe) keyframe--;
+
+    int32_t start;
+    bool inv_all = false;
+    if(act >= keyframe && act < id) start = act + 1;
+    else if(act >= 0 && (act + 1) % delta->frame_cnt == id) start = id;
+    else {
+        start = keyframe;
+        inv_all = true;
+    }
+
+    uint8_t * buf = (uint8_t *)animimg->frame_dsc.data;
+    lv_area_t inv_area = {0};
+    bool inv_empty = true;
+    int32_t i;
+    for(i = start; i <= id; i++) {
+        lv_animimg_delta_decode(delta, i, buf);
+
+        const lv_animimg_delta_frame_t * frame = &delta->frames[i];
+        if(frame->w == 0 || frame->h == 0) continue;
+        lv_area_t a;
+        lv_area_set(&a, frame->x, frame->y, frame->x + frame->w - 1, frame->y + frame->h - 1);
+        if(inv_empty) lv_area_copy(&inv_area, &a);
+        else _lv_area_join(&inv_area, &inv_area, &a);
+        inv_empty = false;
+    }
+    animimg->frame_act = id;
+
+    /*Not shown yet*/
+    if(act < 0) return;
+
+    lv_img_cache_invalidate_src(&animimg->frame_dsc);
+
+    if(inv_all) lv_obj_invalidate(obj);
+    else if(!inv_empty) lv_img_invalidate_src_area(obj, &inv_area);
 }
 
 #endif
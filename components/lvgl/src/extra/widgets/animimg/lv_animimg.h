@@ -26,19 +26,49 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Operations of the delta compressed frames. An operation is a byte: `op << 6 | count`.
+ *If `count` is 0 the real count is in the next 2 bytes (little endian)*/
+#define LV_ANIMIMG_DELTA_OP_COPY    0   /*`count` pixels follow*/
+#define LV_ANIMIMG_DELTA_OP_FILL    1   /*One pixel follows, repeat it `count` times*/
+#define LV_ANIMIMG_DELTA_OP_SKIP    2   /*Keep `count` pixels of the previous frame*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 extern const lv_obj_class_t lv_animimg_class;
 
+/*A frame of a delta compressed image sequence*/
+typedef struct {
+    uint32_t data_ofs;  /*Start of the frame's operations in `data`*/
+    uint16_t x;         /*The area changed since the previous frame (the last frame for the first)*/
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint8_t keyframe;   /*1: the operations draw the whole image; 0: only the changed area on the previous frame*/
+} lv_animimg_delta_frame_t;
+
+/*Image sequence stored as keyframes and the changes of the other frames.
+ *Created from `lv_img_dsc_t`s by `scripts/animimg_delta_conv.py`*/
+typedef struct {
+    lv_img_header_t header;     /*Size and color format of the frames*/
+    uint16_t frame_cnt;
+    const lv_animimg_delta_frame_t * frames;
+    uint32_t data_size;
+    const uint8_t * data;
+} lv_animimg_delta_dsc_t;
+
 /*Data of image*/
 typedef struct {
     lv_img_t img;
     lv_anim_t anim;
     /*picture sequence */
     lv_img_dsc_t ** dsc;
-    int8_t  pic_count;
+    int16_t  pic_count;
+    /*delta compressed sequence*/
+    const lv_animimg_delta_dsc_t * delta;
+    lv_img_dsc_t frame_dsc;     /*The frame decoded from `delta`*/
+    int16_t frame_act;          /*Index of the frame in `frame_dsc`. -1: none*/
 } lv_animimg_t;
 
 
@@ -71,6 +101,14 @@ lv_obj_t * lv_animimg_create(lv_obj_t * parent);
  */
 void lv_animimg_set_src(lv_obj_t * img,  lv_img_dsc_t * dsc[], uint8_t num);
 
+/**
+ * Set a delta compressed image sequence as source.
+ * The frames are decoded into a buffer allocated for the object and only the changed area is redrawn.
+ * @param obj pointer to an animation image object
+ * @param dsc pointer to a sequence created by `scripts/animimg_delta_conv.py`. Only the pointer is saved.
+ */
+void lv_animimg_set_delta_src(lv_obj_t * obj, const lv_animimg_delta_dsc_t * dsc);
+
 /**
  * Startup the image animation.
  * @param obj pointer to an animation image object
@@ -94,6 +132,19 @@ void lv_animimg_set_repeat_count(lv_obj_t * img, uint16_t count);
  * Getter functions
  *====================*/
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Decode a frame of a delta compressed sequence.
+ * @param dsc pointer to a delta compressed sequence
+ * @param id index of the frame
+ * @param buf the pixels of the frames with `dsc->header.w * dsc->header.h` pixels.
+ *            It has to contain the previous frame, except if `id` is a keyframe.
+ */
+void lv_animimg_delta_decode(const lv_animimg_delta_dsc_t * dsc, uint32_t id, uint8_t * buf);
+
 #endif /*LV_USE_ANIMIMG*/
 
 #ifdef __cplusplus
@@ -23979,12 +23979,48 @@ static const uint16_t unicode_list_0[] = {
     0x9f79, 0xfeec, 0xfefa
 };
 
+/*Number of `unicode_list_0` elements below every 256 code points*/
+static const uint16_t unicode_list_index_0[] = {
+    0, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12,
+    13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13,
+    14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 21, 55,
+    65, 67, 89, 97, 119, 127, 130, 136,
+    143, 150, 162, 162, 182, 198, 208, 224,
+    237, 240, 242, 251, 253, 254, 268, 277,
+    290, 301, 305, 305, 308, 333, 352, 368,
+    377, 380, 384, 388, 393, 398, 403, 415,
+    416, 418, 423, 427, 428, 428, 428, 433,
+    436, 441, 445, 455, 464, 471, 473, 477,
+    477, 480, 483, 483, 486, 487, 493, 493,
+    503, 521, 526, 526, 526, 532, 540, 556,
+    562, 566, 569, 573, 573, 574, 574, 583,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 585,
+    585, 585, 585, 585, 585, 585, 585, 587
+};
+
 /*Collect the unicode lists and glyph_id offsets*/
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
         .range_start = 32, .range_length = 65275, .glyph_id_start = 1,
-        .unicode_list = unicode_list_0, .glyph_id_ofs_list = NULL, .list_length = 587, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+        .unicode_list = unicode_list_0, .glyph_id_ofs_list = NULL, .list_length = 587, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY, .unicode_list_index = unicode_list_index_0
     }
 };
 
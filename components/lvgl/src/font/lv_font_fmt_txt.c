@@ -14,10 +14,22 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*The glyph ID cache's tag of larger letters doesn't fit into 16 bits. (Unicode ends at 0x10FFFF anyway)*/
+#define GLYPH_ID_CACHE_LETTER_MAX   0x10FFFF
+
+/*The render threads share the decompressed glyph bitmap cache*/
+#if LV_USE_FONT_COMPRESSED && LV_USE_PARALLEL_RENDER
+    #define BITMAP_CACHE_LOCK()     lv_mutex_lock(&bitmap_cache_mutex)
+    #define BITMAP_CACHE_UNLOCK()   lv_mutex_unlock(&bitmap_cache_mutex)
+#else
+    #define BITMAP_CACHE_LOCK()
+    #define BITMAP_CACHE_UNLOCK()
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +40,22 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_USE_FONT_COMPRESSED
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint32_t frame;         /*`bitmap_cache_frame` when the bitmap was used last. It's not dropped in the same frame*/
+    uint32_t size;          /*Memory used by the entry [bytes]*/
+    uint8_t * bitmap;
+} bitmap_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int32_t unicode_list_search(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
@@ -44,18 +67,29 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+    static const uint8_t * bitmap_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t buf_size);
+    static void bitmap_cache_drop(bitmap_cache_entry_t * entry);
+    static void bitmap_cache_shrink(uint32_t size, bool keep_frame);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static LV_THREAD_LOCAL uint32_t rle_rdp;
+    static LV_THREAD_LOCAL const uint8_t * rle_in;
+    static LV_THREAD_LOCAL uint8_t rle_bpp;
+    static LV_THREAD_LOCAL uint8_t rle_prev_v;
+    static LV_THREAD_LOCAL uint8_t rle_cnt;
+    static LV_THREAD_LOCAL rle_state_t rle_state;
+
+    static uint32_t bitmap_cache_size = LV_FONT_BITMAP_CACHE_SIZE;
+    static uint32_t bitmap_cache_frame;     /*Incremented at the end of every refresh*/
+    static lv_font_fmt_txt_bitmap_cache_stats_t bitmap_cache_stats;
+#if LV_USE_PARALLEL_RENDER
+    static lv_mutex_t bitmap_cache_mutex;
+    static bool bitmap_cache_mutex_inited;
+#endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -92,7 +126,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
+        static LV_THREAD_LOCAL size_t last_buf_size = 0;
         if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
@@ -115,6 +149,10 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+        const uint8_t * bitmap = bitmap_cache_get(fdsc, gid, buf_size);
+        if(bitmap) return bitmap;
+
+        /*Not cached: decompress into the buffer of the thread*/
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MALLOC(tmp);
@@ -199,9 +237,72 @@ void _lv_font_clean_up_fmt_txt(void)
         lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
         LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
     }
+
+    /*The cached bitmaps used in this refresh can be dropped from now*/
+#if LV_USE_PARALLEL_RENDER
+    if(lv_thread_is_worker()) return;
+#endif
+    BITMAP_CACHE_LOCK();
+    bitmap_cache_frame++;
+    BITMAP_CACHE_UNLOCK();
 #endif
 }
 
+void _lv_font_fmt_txt_init(void)
+{
+#if LV_USE_FONT_COMPRESSED
+#if LV_USE_PARALLEL_RENDER
+    if(!bitmap_cache_mutex_inited) {
+        lv_mutex_init(&bitmap_cache_mutex);
+        bitmap_cache_mutex_inited = true;
+    }
+#endif
+    _lv_ll_init(&LV_GC_ROOT(_lv_font_bitmap_cache_ll), sizeof(bitmap_cache_entry_t));
+    lv_memset_00(&bitmap_cache_stats, sizeof(bitmap_cache_stats));
+    bitmap_cache_size = LV_FONT_BITMAP_CACHE_SIZE;
+#endif
+}
+
+#if LV_USE_FONT_COMPRESSED
+
+void lv_font_fmt_txt_set_bitmap_cache_size(uint32_t size)
+{
+    BITMAP_CACHE_LOCK();
+    bitmap_cache_size = size;
+    bitmap_cache_shrink(size, false);
+    BITMAP_CACHE_UNLOCK();
+}
+
+void lv_font_fmt_txt_drop_bitmap_cache(const lv_font_t * font)
+{
+    BITMAP_CACHE_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_bitmap_cache_ll);
+    bitmap_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        bitmap_cache_entry_t * next = _lv_ll_get_next(ll, entry);
+        if(font == NULL || entry->fdsc == font->dsc) bitmap_cache_drop(entry);
+        entry = next;
+    }
+    BITMAP_CACHE_UNLOCK();
+}
+
+void lv_font_fmt_txt_get_bitmap_cache_stats(lv_font_fmt_txt_bitmap_cache_stats_t * stats)
+{
+    BITMAP_CACHE_LOCK();
+    *stats = bitmap_cache_stats;
+    BITMAP_CACHE_UNLOCK();
+}
+
+void lv_font_fmt_txt_reset_bitmap_cache_stats(void)
+{
+    BITMAP_CACHE_LOCK();
+    bitmap_cache_stats.hit_cnt = 0;
+    bitmap_cache_stats.miss_cnt = 0;
+    BITMAP_CACHE_UNLOCK();
+}
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,56 +313,81 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    /*The last letter is shared by the threads so only the main thread uses it*/
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+    lv_font_fmt_txt_glyph_cache_t * last_cache = cache;
+#if LV_USE_PARALLEL_RENDER
+    if(lv_thread_is_worker()) last_cache = NULL;
+#endif
+
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    if(last_cache && letter == last_cache->last_letter) return last_cache->last_glyph_id;
+
+#if LV_FONT_GLYPH_ID_CACHE_SIZE
+    /*The entries are single words so every thread can use the glyph ID cache*/
+    uint32_t * id_entry = NULL;
+    uint32_t id_tag = 0;
+    if(cache && letter <= GLYPH_ID_CACHE_LETTER_MAX) {
+        id_entry = &cache->glyph_ids[letter & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1)];
+        id_tag = (letter / LV_FONT_GLYPH_ID_CACHE_SIZE + 1) << 16;
+        uint32_t e = LV_ATOMIC_LOAD(id_entry);
+        if((e & 0xFFFF0000) == id_tag) {
+            if(last_cache) {
+                last_cache->last_letter = letter;
+                last_cache->last_glyph_id = e & 0xFFFF;
+            }
+            return e & 0xFFFF;
+        }
+    }
+#endif
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
 
         /*Relative code point*/
-        uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        uint32_t rcp = letter - cmap->range_start;
+        if(rcp > cmap->range_length) continue;
         uint32_t glyph_id = 0;
-        if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
-            glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
+        bool sparse = false;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            glyph_id = cmap->glyph_id_start + rcp;
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
-            const uint8_t * gid_ofs_8 = fdsc->cmaps[i].glyph_id_ofs_list;
-            glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+            glyph_id = cmap->glyph_id_start + gid_ofs_8[rcp];
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint16_t key = rcp;
-            uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                             sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + ofs;
-            }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            int32_t ofs = unicode_list_search(cmap, rcp);
+            if(ofs >= 0) glyph_id = cmap->glyph_id_start + ofs;
+            sparse = true;
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint16_t key = rcp;
-            uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                             sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
-                const uint16_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            int32_t ofs = unicode_list_search(cmap, rcp);
+            if(ofs >= 0) {
+                const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+                glyph_id = cmap->glyph_id_start + gid_ofs_16[ofs];
             }
+            sparse = true;
         }
 
         /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
+        if(last_cache) {
+            last_cache->last_letter = letter;
+            last_cache->last_glyph_id = glyph_id;
         }
+#if LV_FONT_GLYPH_ID_CACHE_SIZE
+        /*The other character maps are cheap to look up, don't evict the sparse ones for them*/
+        if(sparse && id_entry && glyph_id <= 0xFFFF) LV_ATOMIC_STORE(id_entry, id_tag | glyph_id);
+#else
+        LV_UNUSED(sparse);
+#endif
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    if(last_cache) {
+        last_cache->last_letter = letter;
+        last_cache->last_glyph_id = 0;
     }
     return 0;
 
@@ -399,8 +525,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
         }
     }
 
-    lv_mem_buf_release(line_buf1);
     lv_mem_buf_release(line_buf2);
+    lv_mem_buf_release(line_buf1);
 }
 
 /**
@@ -573,8 +699,128 @@ static inline uint8_t rle_next(void)
 
     return ret;
 }
+
+/**
+ * Get a decompressed glyph bitmap from the cache or decompress it into the cache.
+ * The bitmaps used in the current frame are not dropped, so they are valid until the end of the refresh.
+ * @param fdsc      pointer to the descriptor of a compressed font
+ * @param gid       ID of the glyph
+ * @param buf_size  size of the decompressed bitmap in bytes
+ * @return          the decompressed bitmap or NULL if it doesn't fit into the cache
+ */
+static const uint8_t * bitmap_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t buf_size)
+{
+    BITMAP_CACHE_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_bitmap_cache_ll);
+    bitmap_cache_entry_t * entry;
+    _LV_LL_READ(ll, entry) {
+        if(entry->gid == gid && entry->fdsc == fdsc) break;
+    }
+
+    if(entry) {
+        /*Keep the list in the order of use*/
+        bitmap_cache_entry_t * head = _lv_ll_get_head(ll);
+        if(entry != head) _lv_ll_move_before(ll, entry, head);
+        entry->frame = bitmap_cache_frame;
+        bitmap_cache_stats.hit_cnt++;
+        BITMAP_CACHE_UNLOCK();
+        return entry->bitmap;
+    }
+
+    bitmap_cache_stats.miss_cnt++;
+
+    uint32_t entry_size = buf_size + sizeof(bitmap_cache_entry_t);
+    if(entry_size > bitmap_cache_size) {
+        BITMAP_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    bitmap_cache_shrink(bitmap_cache_size - entry_size, true);
+    if(bitmap_cache_stats.mem_used + entry_size > bitmap_cache_size) {
+        /*All the cached bitmaps are used in this frame*/
+        BITMAP_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    uint8_t * bitmap = lv_mem_alloc(buf_size);
+    entry = bitmap ? _lv_ll_ins_head(ll) : NULL;
+    if(entry == NULL) {
+        if(bitmap) lv_mem_free(bitmap);
+        BITMAP_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+
+    entry->fdsc = fdsc;
+    entry->gid = gid;
+    entry->frame = bitmap_cache_frame;
+    entry->size = entry_size;
+    entry->bitmap = bitmap;
+    bitmap_cache_stats.mem_used += entry_size;
+    bitmap_cache_stats.entry_cnt++;
+
+    BITMAP_CACHE_UNLOCK();
+    return bitmap;
+}
+
+/**
+ * Remove an entry from the bitmap cache. The cache has to be locked.
+ * @param entry pointer to a cache entry
+ */
+static void bitmap_cache_drop(bitmap_cache_entry_t * entry)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_bitmap_cache_ll);
+    bitmap_cache_stats.mem_used -= entry->size;
+    bitmap_cache_stats.entry_cnt--;
+    lv_mem_free(entry->bitmap);
+    _lv_ll_remove(ll, entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Drop the least recently used bitmaps until the cache uses at most `size` bytes. The cache has to be locked.
+ * @param size          the memory to keep [bytes]
+ * @param keep_frame    true: don't drop the bitmaps used in the current frame
+ */
+static void bitmap_cache_shrink(uint32_t size, bool keep_frame)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_bitmap_cache_ll);
+    while(bitmap_cache_stats.mem_used > size) {
+        bitmap_cache_entry_t * tail = _lv_ll_get_tail(ll);
+        if(tail == NULL) break;
+        if(keep_frame && tail->frame == bitmap_cache_frame) break;
+        bitmap_cache_drop(tail);
+    }
+}
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+/**
+ * Search a relative code point in the `unicode_list` of a sparse character map.
+ * Only the bucket of `rcp` is searched if the character map has `unicode_list_index`.
+ * @param cmap  pointer to a sparse character map
+ * @param rcp   the relative code point, at most `cmap->range_length`
+ * @return      index of `rcp` in `unicode_list` or -1 if not found
+ */
+static int32_t unicode_list_search(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp)
+{
+    const uint16_t * list = cmap->unicode_list;
+    uint32_t len = cmap->list_length;
+    if(cmap->unicode_list_index) {
+        uint32_t b = rcp >> LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT;
+        list += cmap->unicode_list_index[b];
+        len = cmap->unicode_list_index[b + 1] - cmap->unicode_list_index[b];
+    }
+
+    uint16_t key = rcp;
+    const uint16_t * p = _lv_utils_bsearch(&key, list, len, sizeof(list[0]), unicode_list_compare);
+    if(p == NULL) return -1;
+
+    return p - cmap->unicode_list;
+}
+
 /** Code Comparator.
  *
  *  Compares the value of both input arguments.
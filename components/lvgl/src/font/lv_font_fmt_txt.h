@@ -21,6 +21,14 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*The code points of a `unicode_list_index` bucket: `rcp >> LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT` is the bucket's index*/
+#define LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT    8
+
+#if LV_FONT_GLYPH_ID_CACHE_SIZE
+#if LV_FONT_GLYPH_ID_CACHE_SIZE < 32 || (LV_FONT_GLYPH_ID_CACHE_SIZE & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1))
+#error "LV_FONT_GLYPH_ID_CACHE_SIZE must be a power of 2 and at least 32"
+#endif
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -110,6 +118,14 @@ typedef struct {
 
     /** Type of this character map*/
     lv_font_fmt_txt_cmap_type_t type;
+
+    /** Optional index of a sparse `unicode_list` to speed up the search. Can be NULL.
+     * The code points are grouped into buckets of `1 << LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT` and
+     * `unicode_list_index[b]` is the number of `unicode_list` elements below the `b`th bucket.
+     * It has `(range_length >> LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT) + 2` elements,
+     * so the `b`th bucket is `unicode_list[unicode_list_index[b] ... unicode_list_index[b + 1] - 1]`.
+     * `scripts/font_cmap_index.py` adds it to the fonts converted by `lv_font_conv`.*/
+    const uint16_t * unicode_list_index;
 } lv_font_fmt_txt_cmap_t;
 
 /** A simple mapping of kern values from pairs*/
@@ -154,8 +170,23 @@ typedef enum {
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#if LV_FONT_GLYPH_ID_CACHE_SIZE
+    /*Direct mapped cache of the code points found in sparse character maps.
+     *An entry is `(letter / LV_FONT_GLYPH_ID_CACHE_SIZE + 1) << 16 | glyph_id` at `letter % LV_FONT_GLYPH_ID_CACHE_SIZE`.
+     *0: empty*/
+    uint32_t glyph_ids[LV_FONT_GLYPH_ID_CACHE_SIZE];
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
+#if LV_USE_FONT_COMPRESSED
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of bitmaps found in the cache*/
+    uint32_t miss_cnt;      /**< Number of decompressed bitmaps*/
+    uint32_t entry_cnt;     /**< Number of cached bitmaps*/
+    uint32_t mem_used;      /**< Memory used by the cached bitmaps [bytes]*/
+} lv_font_fmt_txt_bitmap_cache_stats_t;
+#endif
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -203,6 +234,8 @@ typedef struct {
 
 /**
  * Used as `get_glyph_bitmap` callback in LittelvGL's native font format if the font is uncompressed.
+ * The decompressed bitmaps of the compressed fonts are valid until the end of the current refresh if they are cached
+ * (see `LV_FONT_BITMAP_CACHE_SIZE`), else only until the next call.
  * @param font pointer to font
  * @param unicode_letter an unicode letter which bitmap should be get
  * @return pointer to the bitmap or NULL if not found
@@ -225,6 +258,39 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Initialize the cache of the decompressed glyph bitmaps. Called by `lv_init()`.
+ */
+void _lv_font_fmt_txt_init(void);
+
+#if LV_USE_FONT_COMPRESSED
+
+/**
+ * Set the memory for the decompressed glyph bitmaps of the compressed fonts.
+ * The least recently used bitmaps are dropped if the cache is larger.
+ * @param size  size of the cache in bytes. 0: decompress the glyphs every time they are drawn
+ */
+void lv_font_fmt_txt_set_bitmap_cache_size(uint32_t size);
+
+/**
+ * Drop the cached bitmaps of a font. It has to be called before freeing a font (`lv_font_free()` does it).
+ * @param font  pointer to a font or NULL to drop the bitmaps of every font
+ */
+void lv_font_fmt_txt_drop_bitmap_cache(const lv_font_t * font);
+
+/**
+ * Get the statistics of the decompressed glyph bitmap cache
+ * @param stats store the statistics here
+ */
+void lv_font_fmt_txt_get_bitmap_cache_stats(lv_font_fmt_txt_bitmap_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the decompressed glyph bitmap cache
+ */
+void lv_font_fmt_txt_reset_bitmap_cache_stats(void);
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**********************
  *      MACROS
  **********************/
@@ -23531,6 +23531,11 @@ static const uint16_t unicode_list_1[] = {
     0x43, 0x45, 0x46, 0x47
 };
 
+/*Number of `unicode_list_1` elements below every 256 code points*/
+static const uint16_t unicode_list_index_1[] = {
+    0, 12
+};
+
 static const uint8_t glyph_id_ofs_list_4[] = {
     0, 0, 0, 1, 2, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0,
@@ -23695,6 +23700,36 @@ static const uint16_t unicode_list_5[] = {
     0xc7b3, 0xce19, 0xce1a, 0xce1d, 0xce22, 0xce23
 };
 
+/*Number of `unicode_list_5` elements below every 256 code points*/
+static const uint16_t unicode_list_index_5[] = {
+    0, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 49, 79,
+    95, 127, 157, 192, 218, 229, 235, 250,
+    262, 291, 297, 331, 352, 359, 386, 414,
+    426, 436, 460, 478, 484, 509, 532, 564,
+    576, 584, 592, 615, 636, 648, 662, 667,
+    672, 677, 691, 695, 699, 721, 730, 739,
+    744, 758, 768, 779, 783, 807, 815, 820,
+    835, 844, 857, 862, 865, 869, 871, 871,
+    878, 892, 922, 932, 946, 955, 960, 976,
+    1006, 1018, 1021, 1024, 1024, 1030, 1051, 1061,
+    1078, 1085, 1091, 1092, 1093, 1093, 1099, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1101, 1101, 1101, 1101, 1101, 1101, 1101, 1101,
+    1144, 1149, 1157, 1158, 1158, 1159, 1159, 1160,
+    1161, 1161, 1161, 1161, 1161, 1161, 1161, 1166
+};
+
 /*Collect the unicode lists and glyph_id offsets*/
 static const lv_font_fmt_txt_cmap_t cmaps[] = {
     {
@@ -23703,7 +23738,7 @@ static const lv_font_fmt_txt_cmap_t cmaps[] = {
     },
     {
         .range_start = 12289, .range_length = 72, .glyph_id_start = 97,
-        .unicode_list = unicode_list_1, .glyph_id_ofs_list = NULL, .list_length = 12, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+        .unicode_list = unicode_list_1, .glyph_id_ofs_list = NULL, .list_length = 12, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY, .unicode_list_index = unicode_list_index_1
     },
     {
         .range_start = 12362, .range_length = 24, .glyph_id_start = 109,
@@ -23719,7 +23754,7 @@ static const lv_font_fmt_txt_cmap_t cmaps[] = {
     },
     {
         .range_start = 12527, .range_length = 52772, .glyph_id_start = 248,
-        .unicode_list = unicode_list_5, .glyph_id_ofs_list = NULL, .list_length = 1166, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+        .unicode_list = unicode_list_5, .glyph_id_ofs_list = NULL, .list_length = 1166, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY, .unicode_list_index = unicode_list_index_5
     }
 };
 
@@ -38,6 +38,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static lv_obj_tree_walk_res_t invalidate_layout_cb(lv_obj_t * obj, void * user_data);
+static void flush_ready_core(lv_disp_drv_t * disp_drv, int32_t idx);
 
 static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x,
                                     lv_coord_t y,
@@ -139,6 +140,31 @@ void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * bu
     draw_buf->buf2    = buf2;
     draw_buf->buf_act = draw_buf->buf1;
     draw_buf->size    = size_in_px_cnt;
+
+    /*Flush only one buffer at a time as the drivers written for two buffers might not queue the flushes*/
+    draw_buf->ring[0] = buf1;
+    draw_buf->ring[1] = buf2;
+    draw_buf->ring_cnt = buf2 ? 2 : 1;
+    draw_buf->flush_max = 1;
+}
+
+void lv_disp_draw_buf_init_ring(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                uint32_t size_in_px_cnt)
+{
+    LV_ASSERT_NULL(bufs);
+    if(buf_cnt > LV_DISP_DRAW_BUF_MAX_NUM) {
+        LV_LOG_WARN("only %d buffers are used (LV_DISP_DRAW_BUF_MAX_NUM)", LV_DISP_DRAW_BUF_MAX_NUM);
+        buf_cnt = LV_DISP_DRAW_BUF_MAX_NUM;
+    }
+
+    lv_disp_draw_buf_init(draw_buf, bufs[0], buf_cnt > 1 ? bufs[1] : NULL, size_in_px_cnt);
+
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) draw_buf->ring[i] = bufs[i];
+    draw_buf->ring_cnt = buf_cnt;
+
+    /*Keep one buffer to render into while the others are flushed*/
+    draw_buf->flush_max = buf_cnt > 1 ? buf_cnt - 1 : 1;
 }
 
 /**
@@ -255,7 +281,6 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
      * so we reset all invalidated areas and invalidate the active screen's new area only.
      */
     lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
-    lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
     disp->inv_p = 0;
     if(disp->act_scr != NULL) lv_obj_invalidate(disp->act_scr);
 
@@ -297,6 +322,16 @@ void lv_disp_remove(lv_disp_t * disp)
         lv_obj_del(disp->screens[0]);
     }
 
+    /*Free the rotation buffers*/
+    lv_disp_draw_buf_t * draw_buf = disp->driver->draw_buf;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(draw_buf->rot_buf[i]) {
+            lv_mem_free(draw_buf->rot_buf[i]);
+            draw_buf->rot_buf[i] = NULL;
+        }
+    }
+
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
     lv_mem_free(disp);
@@ -497,20 +532,54 @@ lv_coord_t lv_disp_get_dpi(const lv_disp_t * disp)
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
-    /*If the screen is transparent initialize it when the flushing is ready*/
-#if LV_COLOR_SCREEN_TRANSP
-    if(disp_drv->screen_transp) {
-        if(disp_drv->clear_cb) {
-            disp_drv->clear_cb(disp_drv, disp_drv->draw_buf->buf_act, disp_drv->draw_buf->size);
+    lv_disp_draw_buf_t * draw_buf = disp_drv->draw_buf;
+
+    /*Complete the oldest flush. The rotation buffers are indexed after the ring.*/
+    int32_t oldest = -1;
+    uint32_t oldest_seq = 0;
+    uint32_t i;
+    for(i = 0; i < draw_buf->ring_cnt; i++) {
+        uint32_t seq = draw_buf->ring_flushing[i];
+        if(seq == 0) continue;
+        if(oldest < 0 || seq < oldest_seq) {
+            oldest = i;
+            oldest_seq = seq;
         }
-        else {
-            lv_memset_00(disp_drv->draw_buf->buf_act, disp_drv->draw_buf->size * sizeof(lv_color32_t));
+    }
+
+    for(i = 0; i < 2; i++) {
+        uint32_t seq = draw_buf->rot_flushing[i];
+        if(seq == 0) continue;
+        if(oldest < 0 || seq < oldest_seq) {
+            oldest = LV_DISP_DRAW_BUF_MAX_NUM + i;
+            oldest_seq = seq;
         }
     }
-#endif
 
-    disp_drv->draw_buf->flushing = 0;
-    disp_drv->draw_buf->flushing_last = 0;
+    flush_ready_core(disp_drv, oldest);
+}
+
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready_buf(lv_disp_drv_t * disp_drv, const void * color_p)
+{
+    lv_disp_draw_buf_t * draw_buf = disp_drv->draw_buf;
+
+    uint32_t i;
+    for(i = 0; i < draw_buf->ring_cnt; i++) {
+        if(draw_buf->ring[i] == color_p && draw_buf->ring_flushing[i]) {
+            flush_ready_core(disp_drv, i);
+            return;
+        }
+    }
+
+    for(i = 0; i < 2; i++) {
+        if(draw_buf->rot_buf[i] == color_p && draw_buf->rot_flushing[i]) {
+            flush_ready_core(disp_drv, LV_DISP_DRAW_BUF_MAX_NUM + i);
+            return;
+        }
+    }
+
+    /*Unknown buffer (e.g. a rotated square is flushed from the middle of a buffer) so the oldest flush is ready*/
+    lv_disp_flush_ready(disp_drv);
 }
 
 /**
@@ -600,6 +669,45 @@ void lv_disp_drv_use_generic_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Mark a buffer of the ring as flushed
+ * @param disp_drv pointer to display driver
+ * @param idx      index of the buffer in the ring, or `LV_DISP_DRAW_BUF_MAX_NUM` + index of a rotation buffer.
+ *                 < 0 if there was no flush in progress.
+ */
+LV_ATTRIBUTE_FLUSH_READY static void flush_ready_core(lv_disp_drv_t * disp_drv, int32_t idx)
+{
+    lv_disp_draw_buf_t * draw_buf = disp_drv->draw_buf;
+
+    if(idx >= LV_DISP_DRAW_BUF_MAX_NUM) {
+        draw_buf->rot_flushing[idx - LV_DISP_DRAW_BUF_MAX_NUM] = 0;
+    }
+    else if(idx >= 0) {
+        /*If the screen is transparent initialize it when the flushing is ready*/
+#if LV_COLOR_SCREEN_TRANSP
+        if(disp_drv->screen_transp) {
+            if(disp_drv->clear_cb) {
+                disp_drv->clear_cb(disp_drv, draw_buf->ring[idx], draw_buf->size);
+            }
+            else {
+                lv_memset_00(draw_buf->ring[idx], draw_buf->size * sizeof(lv_color32_t));
+            }
+        }
+#endif
+        draw_buf->ring_flushing[idx] = 0;
+    }
+
+    uint32_t i;
+    bool any = false;
+    for(i = 0; i < draw_buf->ring_cnt; i++) {
+        if(draw_buf->ring_flushing[i]) any = true;
+    }
+    if(draw_buf->rot_flushing[0] || draw_buf->rot_flushing[1]) any = true;
+
+    if(!any) draw_buf->flushing = 0;
+    draw_buf->flushing_last = 0;
+}
+
 static lv_obj_tree_walk_res_t invalidate_layout_cb(lv_obj_t * obj, void * user_data)
 {
     LV_UNUSED(user_data);
@@ -31,6 +31,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_DISP_DRAW_BUF_MAX_NUM
+#define LV_DISP_DRAW_BUF_MAX_NUM 4 /*Max number of buffers in the ring of a draw buffer*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -60,8 +64,46 @@ typedef struct _lv_disp_draw_buf_t {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+
+    /*The buffers are used in a ring. `buf1` and `buf2` are the first two.*/
+    void * ring[LV_DISP_DRAW_BUF_MAX_NUM];
+    /*Non-zero: the buffer is being flushed. The value is the order of the flush to complete them in order
+     *with `lv_disp_flush_ready`. (Not bit fields as they are cleared from IRQ)*/
+    volatile uint32_t ring_flushing[LV_DISP_DRAW_BUF_MAX_NUM];
+    uint32_t flush_seq;         /*Order of the last started flush*/
+    uint8_t ring_cnt;           /*Number of buffers in the ring*/
+    uint8_t ring_act;           /*Index of `buf_act` in the ring*/
+    uint8_t flush_max;          /*Max number of buffers which can be flushed at the same time*/
+
+    /*Ping-pong buffers of the software rotation. Allocated only while refreshing.*/
+    void * rot_buf[2];
+    volatile uint32_t rot_flushing[2];  /*Like `ring_flushing`*/
 } lv_disp_draw_buf_t;
 
+/**
+ * Counters of waiting for the flushing of the draw buffers
+ */
+typedef struct {
+    uint32_t flush_cnt;     /**< Number of started flushes*/
+    uint32_t wait_cnt;      /**< Number of times the rendering had to wait for a free buffer*/
+    uint32_t wait_time;     /**< Sum of the waiting time in milliseconds*/
+    uint32_t wait_time_max; /**< Longest wait in milliseconds*/
+} lv_disp_flush_stats_t;
+
+/**
+ * Counters of the dirty area handling. Can be used to see how many more pixels
+ * were redrawn than what was really invalidated.
+ */
+typedef struct {
+    uint32_t inv_px;        /**< Sum of the invalidated pixels (overlaps are counted multiple times)*/
+    uint32_t refr_px;       /**< Number of pixels really redrawn*/
+    uint32_t refr_area_cnt; /**< Number of redrawn areas*/
+    uint32_t merge_cnt;     /**< Number of areas merged because it was cheaper to redraw them together*/
+    uint32_t overflow_cnt;  /**< Number of forced merges because the invalidated area buffer was full*/
+    uint32_t culled_cnt;    /**< Number of objects not drawn in the refreshed areas because others covered them*/
+    uint32_t batch_join_cnt; /**< Number of invalidations joined with an earlier one of the same object in the animations*/
+} lv_disp_inv_stats_t;
+
 typedef enum {
     LV_DISP_ROT_NONE = 0,
     LV_DISP_ROT_90,
@@ -177,10 +219,12 @@ uint8_t del_prev  :
     lv_color_t bg_color;            /**< Default display color when screens are transparent*/
     const void * bg_img;            /**< An image source to display as wallpaper*/
 
-    /** Invalidated (marked to redraw) areas*/
+    /** Invalidated (marked to redraw) areas. They are kept merged so they can be redrawn as they are.*/
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint16_t inv_p;
+    uint16_t rendering_in_progress : 1; /**< 1: the current screen rendering is in progress*/
+    lv_disp_inv_stats_t inv_stats;
+    lv_disp_flush_stats_t flush_stats;
 
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
@@ -215,6 +259,20 @@ void lv_disp_drv_init(lv_disp_drv_t * driver);
  */
 void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * buf2, uint32_t size_in_px_cnt);
 
+/**
+ * Initialize a display buffer with a ring of more buffers.
+ * LVGL renders into the next free buffer while the others are being flushed,
+ * so `flush_cb` will be called again before the previous flushes are ready.
+ * The driver has to queue the flushes (e.g. SPI DMA transactions) and call
+ * `lv_disp_flush_ready()` or `lv_disp_flush_ready_buf()` when a buffer was sent.
+ * @param draw_buf pointer `lv_disp_draw_buf_t` variable to initialize
+ * @param bufs     array of `buf_cnt` buffers. Only the buffer pointers are saved, not the array.
+ * @param buf_cnt  number of buffers (1 ... LV_DISP_DRAW_BUF_MAX_NUM)
+ * @param size_in_px_cnt size of each buffer in pixel count.
+ */
+void lv_disp_draw_buf_init_ring(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                uint32_t size_in_px_cnt);
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -327,6 +385,14 @@ lv_disp_rot_t lv_disp_get_rotation(lv_disp_t * disp);
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 
+/**
+ * Tell that the flushing of a given buffer is finished.
+ * Unlike `lv_disp_flush_ready()` it can be called out of the order of the `flush_cb` calls.
+ * @param disp_drv pointer to display driver
+ * @param color_p  the `color_p` parameter of the finished `flush_cb` call
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready_buf(lv_disp_drv_t * disp_drv, const void * color_p);
+
 /**
  * Tell if it's the last area of the refreshing process.
  * Can be called from `flush_cb` to execute some special display refreshing if needed when all areas area flushed.
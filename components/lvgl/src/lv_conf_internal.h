@@ -143,6 +143,27 @@
         //#define LV_MEM_POOL_ALLOC   your_alloc          /* Uncomment if using an external allocator*/
     #endif
 
+    /*Serve the small allocations from free lists of fixed size blocks (slabs) to keep the often created and deleted
+     *objects, styles, animations, timers and texts from fragmenting the pool.
+     *The blocks are reserved from the pool in `lv_mem_init()`. If a class is full the pool is used.*/
+    #ifndef LV_MEM_SLAB
+        #ifdef CONFIG_LV_MEM_SLAB
+            #define LV_MEM_SLAB CONFIG_LV_MEM_SLAB
+        #else
+            #define LV_MEM_SLAB 0
+        #endif
+    #endif
+    #if LV_MEM_SLAB
+        /*{block size [bytes], number of blocks} of the size classes in increasing block size*/
+        #ifndef LV_MEM_SLAB_CLASSES
+            #ifdef CONFIG_LV_MEM_SLAB_CLASSES
+                #define LV_MEM_SLAB_CLASSES CONFIG_LV_MEM_SLAB_CLASSES
+            #else
+                #define LV_MEM_SLAB_CLASSES {{16, 32}, {32, 32}, {48, 32}, {64, 16}, {128, 8}}
+            #endif
+        #endif
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #ifndef LV_MEM_CUSTOM_INCLUDE
         #ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -174,13 +195,14 @@
     #endif
 #endif     /*LV_MEM_CUSTOM*/
 
-/*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
- *You will see an error log message if there wasn't enough buffers. */
-#ifndef LV_MEM_BUF_MAX_NUM
-    #ifdef CONFIG_LV_MEM_BUF_MAX_NUM
-        #define LV_MEM_BUF_MAX_NUM CONFIG_LV_MEM_BUF_MAX_NUM
+/*Size of the scratch arena of each rendering thread for the temporal buffers of `lv_mem_buf_get()` [bytes].
+ *It's allocated once from the heap. The buffers which don't fit are allocated from the heap one by one.
+ *`lv_mem_buf_monitor()` tells the size really needed.*/
+#ifndef LV_MEM_BUF_SIZE
+    #ifdef CONFIG_LV_MEM_BUF_SIZE
+        #define LV_MEM_BUF_SIZE CONFIG_LV_MEM_BUF_SIZE
     #else
-        #define LV_MEM_BUF_MAX_NUM 16
+        #define LV_MEM_BUF_SIZE (2U * 1024U)
     #endif
 #endif
 
@@ -311,6 +333,30 @@
         #define LV_IMG_CACHE_DEF_SIZE 0
     #endif
 #endif
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Memory budget of the cached images in bytes: the memory allocated by the decoders (e.g. the decoded pixels)
+     *and about 100 bytes per image. Images which don't fit are opened for every draw.
+     *0: no limit, only the number of images is limited*/
+    #ifndef LV_IMG_CACHE_MEM_SIZE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+            #define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+        #else
+            #define LV_IMG_CACHE_MEM_SIZE 0
+        #endif
+    #endif
+#endif
+
+/*Decompress the whole image of the compressed color formats (`LV_IMG_CF_TRUE_COLOR_ALPHA_RLE/LZ4`) when it's opened.
+ *It needs `w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes per opened image but the image can be rotated and zoomed
+ *and it's decompressed only once while it's in the image cache.
+ *0: decompress only the lines being drawn (`w * lines per block` pixels per opened image)*/
+#ifndef LV_IMG_DECOMPRESS_FULL
+    #ifdef CONFIG_LV_IMG_DECOMPRESS_FULL
+        #define LV_IMG_DECOMPRESS_FULL CONFIG_LV_IMG_DECOMPRESS_FULL
+    #else
+        #define LV_IMG_DECOMPRESS_FULL 0
+    #endif
+#endif
 
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #ifndef LV_DISP_ROT_MAX_BUF
@@ -321,6 +367,128 @@
     #endif
 #endif
 
+/*Estimated cost of redrawing and flushing one more area (e.g. sending CASET/RASET and setting up the transfer)
+ *expressed in number of pixels. Invalidated areas are merged if redrawing them together is cheaper.
+ *0: merge only if the joined area is smaller than the two areas together*/
+#ifndef LV_INV_AREA_OVERHEAD
+    #ifdef CONFIG_LV_INV_AREA_OVERHEAD
+        #define LV_INV_AREA_OVERHEAD CONFIG_LV_INV_AREA_OVERHEAD
+    #else
+        #define LV_INV_AREA_OVERHEAD 256
+    #endif
+#endif
+
+/*Skip drawing the objects which are fully covered by opaque objects above them.
+ *The results of the cover checks are cached in the objects until they are invalidated.*/
+#ifndef LV_USE_OCCLUSION_CULLING
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_OCCLUSION_CULLING
+            #define LV_USE_OCCLUSION_CULLING CONFIG_LV_USE_OCCLUSION_CULLING
+        #else
+            #define LV_USE_OCCLUSION_CULLING 0
+        #endif
+    #else
+        #define LV_USE_OCCLUSION_CULLING 1
+    #endif
+#endif
+
+/*Cache the style properties found in the styles of the objects (per part and state)
+ *to not search them in every style again and again while drawing.
+ *The cache of an object is cleared when its styles change and freed when it's deleted.*/
+#ifndef LV_USE_OBJ_STYLE_CACHE
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_OBJ_STYLE_CACHE
+            #define LV_USE_OBJ_STYLE_CACHE CONFIG_LV_USE_OBJ_STYLE_CACHE
+        #else
+            #define LV_USE_OBJ_STYLE_CACHE 0
+        #endif
+    #else
+        #define LV_USE_OBJ_STYLE_CACHE 1
+    #endif
+#endif
+#if LV_USE_OBJ_STYLE_CACHE
+    /*Number of cached properties per object. Must be a power of 2. An entry is 8 bytes on 32 bit systems.*/
+    #ifndef LV_OBJ_STYLE_CACHE_SIZE
+        #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+            #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #else
+            #define LV_OBJ_STYLE_CACHE_SIZE 32
+        #endif
+    #endif
+
+    /*Memory used by the caches of all objects together [bytes]. No more caches are allocated above it.
+     *0: no limit*/
+    #ifndef LV_OBJ_STYLE_CACHE_MEM_MAX
+        #ifdef CONFIG_LV_OBJ_STYLE_CACHE_MEM_MAX
+            #define LV_OBJ_STYLE_CACHE_MEM_MAX CONFIG_LV_OBJ_STYLE_CACHE_MEM_MAX
+        #else
+            #define LV_OBJ_STYLE_CACHE_MEM_MAX (4U * 1024U)
+        #endif
+    #endif
+#endif
+
+/*Render the areas in horizontal tiles on more threads (e.g. on both cores of an ESP32).
+ *Everything which is modified while drawing (e.g. the mask list, `lv_mem_buf_get`) is thread local then.
+ *Event callbacks of drawing events have to be thread safe too.*/
+#ifndef LV_USE_PARALLEL_RENDER
+    #ifdef CONFIG_LV_USE_PARALLEL_RENDER
+        #define LV_USE_PARALLEL_RENDER CONFIG_LV_USE_PARALLEL_RENDER
+    #else
+        #define LV_USE_PARALLEL_RENDER 0
+    #endif
+#endif
+#if LV_USE_PARALLEL_RENDER
+    /*Number of additional render threads. The thread calling `lv_timer_handler()` renders a tile too.*/
+    #ifndef LV_PARALLEL_RENDER_WORKERS
+        #ifdef CONFIG_LV_PARALLEL_RENDER_WORKERS
+            #define LV_PARALLEL_RENDER_WORKERS CONFIG_LV_PARALLEL_RENDER_WORKERS
+        #else
+            #define LV_PARALLEL_RENDER_WORKERS 1
+        #endif
+    #endif
+
+    /*Areas lower than twice of this are not split into tiles*/
+    #ifndef LV_PARALLEL_RENDER_MIN_ROWS
+        #ifdef CONFIG_LV_PARALLEL_RENDER_MIN_ROWS
+            #define LV_PARALLEL_RENDER_MIN_ROWS CONFIG_LV_PARALLEL_RENDER_MIN_ROWS
+        #else
+            #define LV_PARALLEL_RENDER_MIN_ROWS 8
+        #endif
+    #endif
+
+    /*Stack size of the render threads in bytes*/
+    #ifndef LV_PARALLEL_RENDER_STACK_SIZE
+        #ifdef CONFIG_LV_PARALLEL_RENDER_STACK_SIZE
+            #define LV_PARALLEL_RENDER_STACK_SIZE CONFIG_LV_PARALLEL_RENDER_STACK_SIZE
+        #else
+            #define LV_PARALLEL_RENDER_STACK_SIZE (8 * 1024)
+        #endif
+    #endif
+
+    /*Thread API to use: LV_OS_PTHREAD or LV_OS_FREERTOS*/
+    #ifndef LV_PARALLEL_RENDER_OS
+        #ifdef CONFIG_LV_PARALLEL_RENDER_OS
+            #define LV_PARALLEL_RENDER_OS CONFIG_LV_PARALLEL_RENDER_OS
+        #else
+            #define LV_PARALLEL_RENDER_OS LV_OS_PTHREAD
+        #endif
+    #endif
+#endif  /*LV_USE_PARALLEL_RENDER*/
+
+/*Blend with SSE2 or NEON instructions if the compiler supports them (with 16 and 32 bit colors).
+ *Otherwise more color channels are mixed in one integer.*/
+#ifndef LV_USE_DRAW_SW_SIMD
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_DRAW_SW_SIMD
+            #define LV_USE_DRAW_SW_SIMD CONFIG_LV_USE_DRAW_SW_SIMD
+        #else
+            #define LV_USE_DRAW_SW_SIMD 0
+        #endif
+    #else
+        #define LV_USE_DRAW_SW_SIMD 1
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -641,6 +809,59 @@
     #endif
 #endif
 
+/*1: Measure the time of the refresh phases and draw operations in the last frames.
+ *See `lv_prof_get_frame()` and `lv_prof_dump()`*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of frames kept in the ring buffer*/
+    #ifndef LV_PROFILER_FRAME_CNT
+        #ifdef CONFIG_LV_PROFILER_FRAME_CNT
+            #define LV_PROFILER_FRAME_CNT CONFIG_LV_PROFILER_FRAME_CNT
+        #else
+            #define LV_PROFILER_FRAME_CNT 16
+        #endif
+    #endif
+
+    /*1: Use a custom counter to measure the time.
+     *Else the CPU cycle counter is used on ESP32, `clock_gettime()` on POSIX systems and `lv_tick_get()` otherwise*/
+    #ifndef LV_PROFILER_TIME_CUSTOM
+        #ifdef CONFIG_LV_PROFILER_TIME_CUSTOM
+            #define LV_PROFILER_TIME_CUSTOM CONFIG_LV_PROFILER_TIME_CUSTOM
+        #else
+            #define LV_PROFILER_TIME_CUSTOM 0
+        #endif
+    #endif
+    #if LV_PROFILER_TIME_CUSTOM
+        #ifndef LV_PROFILER_TIME_CUSTOM_INCLUDE
+            #ifdef CONFIG_LV_PROFILER_TIME_CUSTOM_INCLUDE
+                #define LV_PROFILER_TIME_CUSTOM_INCLUDE CONFIG_LV_PROFILER_TIME_CUSTOM_INCLUDE
+            #else
+                #define LV_PROFILER_TIME_CUSTOM_INCLUDE <stdint.h>      /*Header for the counter function*/
+            #endif
+        #endif
+        #ifndef LV_PROFILER_TIME_CUSTOM_EXPR
+            #ifdef CONFIG_LV_PROFILER_TIME_CUSTOM_EXPR
+                #define LV_PROFILER_TIME_CUSTOM_EXPR CONFIG_LV_PROFILER_TIME_CUSTOM_EXPR
+            #else
+                #define LV_PROFILER_TIME_CUSTOM_EXPR (my_cycle_cnt())   /*Expression evaluating to a free running uint32_t counter*/
+            #endif
+        #endif
+        #ifndef LV_PROFILER_TIME_CUSTOM_FREQ
+            #ifdef CONFIG_LV_PROFILER_TIME_CUSTOM_FREQ
+                #define LV_PROFILER_TIME_CUSTOM_FREQ CONFIG_LV_PROFILER_TIME_CUSTOM_FREQ
+            #else
+                #define LV_PROFILER_TIME_CUSTOM_FREQ 1000000            /*Frequency of the counter in Hz*/
+            #endif
+        #endif
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1075,6 +1296,27 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Memory for the decompressed glyph bitmaps [bytes]. The least recently used glyphs are dropped above it.
+     *0: decompress the glyphs every time they are drawn*/
+    #ifndef LV_FONT_BITMAP_CACHE_SIZE
+        #ifdef CONFIG_LV_FONT_BITMAP_CACHE_SIZE
+            #define LV_FONT_BITMAP_CACHE_SIZE CONFIG_LV_FONT_BITMAP_CACHE_SIZE
+        #else
+            #define LV_FONT_BITMAP_CACHE_SIZE (8U * 1024U)
+        #endif
+    #endif
+#endif
+
+/*Number of code point -> glyph ID pairs cached by the fonts with sparse character maps (e.g. CJK fonts).
+ *Must be a power of 2 and at least 32. It's 4 bytes per entry in the cache of every font. 0: disable*/
+#ifndef LV_FONT_GLYPH_ID_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_GLYPH_ID_CACHE_SIZE
+        #define LV_FONT_GLYPH_ID_CACHE_SIZE CONFIG_LV_FONT_GLYPH_ID_CACHE_SIZE
+    #else
+        #define LV_FONT_GLYPH_ID_CACHE_SIZE 64
+    #endif
+#endif
 
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
@@ -1827,6 +2069,22 @@
         #define LV_USE_PNG 0
     #endif
 #endif
+#if LV_USE_PNG
+    /*1: Decode the rows when they are drawn. Needs the window of the inflater (max. 32 kB) and 2 rows
+     *instead of the whole file and 4 bytes per pixel but the images can't be rotated or zoomed.
+     *Can be changed with `lv_png_set_stream()`*/
+    #ifndef LV_PNG_STREAM
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_PNG_STREAM
+                #define LV_PNG_STREAM CONFIG_LV_PNG_STREAM
+            #else
+                #define LV_PNG_STREAM 0
+            #endif
+        #else
+            #define LV_PNG_STREAM 1
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -1846,6 +2104,28 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Memory of the decoded fragments of all JPG and SJPG images in bytes (allocated with `lv_mem_alloc()`).
+     *The least recently used fragments are freed to stay below it but the fragments read by the opened images are kept.
+     *0: keep only those fragments*/
+    #ifndef LV_SJPG_CACHE_SIZE
+        #ifdef CONFIG_LV_SJPG_CACHE_SIZE
+            #define LV_SJPG_CACHE_SIZE CONFIG_LV_SJPG_CACHE_SIZE
+        #else
+            #define LV_SJPG_CACHE_SIZE (32 * 1024)
+        #endif
+    #endif
+
+    /*1: Decode the next fragment of the SJPG variables in advance on an other thread (e.g. on the other core).
+     *Requires LV_USE_PARALLEL_RENDER*/
+    #ifndef LV_SJPG_DECODE_AHEAD
+        #ifdef CONFIG_LV_SJPG_DECODE_AHEAD
+            #define LV_SJPG_DECODE_AHEAD CONFIG_LV_SJPG_DECODE_AHEAD
+        #else
+            #define LV_SJPG_DECODE_AHEAD 0
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -1855,6 +2135,17 @@
         #define LV_USE_GIF 0
     #endif
 #endif
+#if LV_USE_GIF
+    /*Keep the LZW code table of the GIFs allocated instead of allocating it for every frame.
+     *Up to 16 kB per GIF (4 bytes per pixel for small GIFs)*/
+    #ifndef LV_GIF_CACHE_DECODE_DATA
+        #ifdef CONFIG_LV_GIF_CACHE_DECODE_DATA
+            #define LV_GIF_CACHE_DECODE_DATA CONFIG_LV_GIF_CACHE_DECODE_DATA
+        #else
+            #define LV_GIF_CACHE_DECODE_DATA 0
+        #endif
+    #endif
+#endif
 
 /*QR code library*/
 #ifndef LV_USE_QRCODE
@@ -1967,6 +2258,28 @@
     #endif
 #endif
 
+/*1: Draw the objects with `LV_OBJ_FLAG_LAYER_CACHE` and their children from an image
+ *which is rendered again only if something changes in them. Requires `LV_USE_SNAPSHOT`*/
+#ifndef LV_USE_LAYER_CACHE
+    #ifdef CONFIG_LV_USE_LAYER_CACHE
+        #define LV_USE_LAYER_CACHE CONFIG_LV_USE_LAYER_CACHE
+    #else
+        #define LV_USE_LAYER_CACHE 0
+    #endif
+#endif
+#if LV_USE_LAYER_CACHE
+    /*Memory of the images of the layers in bytes (allocated with `lv_mem_alloc()`).
+     *The least recently drawn layers are dropped to stay below it. The layers which don't fit are drawn normally.
+     *Can be changed with `lv_layer_cache_set_size()`*/
+    #ifndef LV_LAYER_CACHE_SIZE
+        #ifdef CONFIG_LV_LAYER_CACHE_SIZE
+            #define LV_LAYER_CACHE_SIZE CONFIG_LV_LAYER_CACHE_SIZE
+        #else
+            #define LV_LAYER_CACHE_SIZE (16 * 1024)
+        #endif
+    #endif
+#endif
+
 /*==================
 * EXAMPLES
 *==================*/
@@ -177,6 +177,16 @@ extern "C" {
 #  define CONFIG_LV_USE_MEM_MONITOR_POS LV_ALIGN_CENTER
 #endif
 
+/*---------------------
+ * PARALLEL RENDER OS
+ *--------------------*/
+
+#ifdef CONFIG_LV_PARALLEL_RENDER_OS_PTHREAD
+#  define CONFIG_LV_PARALLEL_RENDER_OS LV_OS_PTHREAD
+#elif defined(CONFIG_LV_PARALLEL_RENDER_OS_FREERTOS)
+#  define CONFIG_LV_PARALLEL_RENDER_OS LV_OS_FREERTOS
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
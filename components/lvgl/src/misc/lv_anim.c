@@ -21,24 +21,50 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 
+#define BLOCK_FULL          ((1 << _LV_ANIM_BLOCK_SIZE) - 1)
+#define ANIM_IS_LIVE(b, i)  ((((b)->used & ~(b)->deleted) >> (i)) & 1)
+
+/*The built-in paths are sampled in every 2^PATH_LUT_SHIFT step of `t` and interpolated between them*/
+#define PATH_LUT_SHIFT      4
+#define PATH_LUT_SIZE       ((LV_BEZIER_VAL_MAX >> PATH_LUT_SHIFT) + 1)
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef enum {
+    PATH_LUT_EASE_IN,
+    PATH_LUT_EASE_OUT,
+    PATH_LUT_EASE_IN_OUT,
+    PATH_LUT_OVERSHOOT,
+    PATH_LUT_BOUNCE,
+    _PATH_LUT_NUM,
+} path_lut_id_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
-static void anim_mark_list_change(void);
-static void anim_ready_handler(lv_anim_t * a);
+static void anim_timer_update(void);
+static void anim_ready_handler(_lv_anim_block_t * block, uint32_t id);
+static lv_anim_t * anim_alloc(void);
+static void anim_free(_lv_anim_block_t * block, uint32_t id);
+static void pool_sweep(void);
+static void path_lut_init(void);
+static inline int32_t anim_path_value(const lv_anim_t * a);
+static inline int32_t path_linear(const lv_anim_t * a);
+static inline int32_t path_bezier(const lv_anim_t * a, path_lut_id_t lut_id);
+static int32_t path_bounce(const lv_anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
 static bool anim_run_round;
+static uint32_t anim_cnt;           /*Number of animations which are not deleted*/
+static uint32_t anim_timer_depth;   /*Deleted animations are freed only when `anim_timer()` is not running*/
+static bool anim_del_pending;
 static lv_timer_t * _lv_anim_tmr;
+static int16_t path_lut[_PATH_LUT_NUM][PATH_LUT_SIZE];
 
 /**********************
  *      MACROS
@@ -56,10 +82,14 @@ static lv_timer_t * _lv_anim_tmr;
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    LV_GC_ROOT(_lv_anim_pool) = NULL;
+    anim_cnt = 0;
+    anim_timer_depth = 0;
+    anim_del_pending = false;
+    path_lut_init();
+
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
-    anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
+    anim_timer_update(); /*Turn off the animation timer*/
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -80,14 +110,13 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim timer was suspended and it's last run measure is invalid*/
+    if(anim_cnt == 0) {
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
-    LV_ASSERT_MALLOC(new_anim);
+    /*Add the new animation to the pool*/
+    lv_anim_t * new_anim = anim_alloc();
     if(new_anim == NULL) return NULL;
 
     /*Initialize the animation descriptor*/
@@ -106,9 +135,9 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
-    anim_mark_list_change();
+    /*The new animation has `run_round` of the current round so it won't run if it's created in a callback
+     *of an other animation. (see `anim_timer`)*/
+    anim_timer_update();
 
     TRACE_ANIM("finished");
     return new_anim;
@@ -137,23 +166,24 @@ uint32_t lv_anim_get_playtime(lv_anim_t * a)
 
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
-
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
-            del = true;
+    _lv_anim_block_t * block;
+    for(block = LV_GC_ROOT(_lv_anim_pool); block; block = block->next) {
+        uint32_t i;
+        for(i = 0; i < _LV_ANIM_BLOCK_SIZE; i++) {
+            if(!ANIM_IS_LIVE(block, i)) continue;
+
+            lv_anim_t * a = &block->anims[i];
+            if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+                anim_free(block, i);
+                del = true;
+            }
         }
+    }
 
-        a = a_next;
+    if(del) {
+        if(anim_timer_depth == 0) pool_sweep();
+        anim_timer_update();
     }
 
     return del;
@@ -161,16 +191,30 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
-    anim_mark_list_change();
+    _lv_anim_block_t * block;
+    for(block = LV_GC_ROOT(_lv_anim_pool); block; block = block->next) {
+        uint32_t i;
+        for(i = 0; i < _LV_ANIM_BLOCK_SIZE; i++) {
+            if(ANIM_IS_LIVE(block, i)) anim_free(block, i);
+        }
+    }
+
+    if(anim_timer_depth == 0) pool_sweep();
+    anim_timer_update();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            return a;
+    _lv_anim_block_t * block;
+    for(block = LV_GC_ROOT(_lv_anim_pool); block; block = block->next) {
+        uint32_t i;
+        for(i = 0; i < _LV_ANIM_BLOCK_SIZE; i++) {
+            if(!ANIM_IS_LIVE(block, i)) continue;
+
+            lv_anim_t * a = &block->anims[i];
+            if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+                return a;
+            }
         }
     }
 
@@ -179,11 +223,7 @@ lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return (uint16_t)anim_cnt;
 }
 
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
@@ -205,124 +245,32 @@ void lv_anim_refr_now(void)
 
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    int32_t step = lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
-
-    /*Get the new value which will be proportional to `step`
-     *and the `start` and `end` values*/
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_ANIM_RES_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_linear(a);
 }
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 100, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_bezier(a, PATH_LUT_EASE_IN);
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 900, 950, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_bezier(a, PATH_LUT_EASE_OUT);
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 952, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_bezier(a, PATH_LUT_EASE_IN_OUT);
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 1000, 1300, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_bezier(a, PATH_LUT_OVERSHOOT);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    int32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t diff = (a->end_value - a->start_value);
-
-    /*3 bounces has 5 parts: 3 down and 2 up. One part is t / 5 long*/
-
-    if(t < 408) {
-        /*Go down*/
-        t = (t * 2500) >> LV_BEZIER_VAL_SHIFT; /*[0..1024] range*/
-    }
-    else if(t >= 408 && t < 614) {
-        /*First bounce back*/
-        t -= 408;
-        t    = t * 5; /*to [0..1024] range*/
-        t    = LV_BEZIER_VAL_MAX - t;
-        diff = diff / 20;
-    }
-    else if(t >= 614 && t < 819) {
-        /*Fall back*/
-        t -= 614;
-        t    = t * 5; /*to [0..1024] range*/
-        diff = diff / 20;
-    }
-    else if(t >= 819 && t < 921) {
-        /*Second bounce back*/
-        t -= 819;
-        t    = t * 10; /*to [0..1024] range*/
-        t    = LV_BEZIER_VAL_MAX - t;
-        diff = diff / 40;
-    }
-    else if(t >= 921 && t <= LV_BEZIER_VAL_MAX) {
-        /*Fall back*/
-        t -= 921;
-        t    = t * 10; /*to [0..1024] range*/
-        diff = diff / 40;
-    }
-
-    if(t > LV_BEZIER_VAL_MAX) t = LV_BEZIER_VAL_MAX;
-    if(t < 0) t = 0;
-    int32_t step = lv_bezier3(t, LV_BEZIER_VAL_MAX, 800, 500, 0);
-
-    int32_t new_value;
-    new_value = step * diff;
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value = a->end_value - new_value;
-
-    return new_value;
+    return path_bounce(a);
 }
 
 int32_t lv_anim_path_step(const lv_anim_t * a)
@@ -350,17 +298,25 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
 
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*The animations deleted meanwhile (e.g. in `ready_cb`) are only marked as deleted and freed at the end
+     *so the blocks can be read further without restarting*/
+    anim_timer_depth++;
+
+    /*An object might be changed by more animations (e.g. x and y, or style transitions).
+     *Invalidate it only once with all of its changes.*/
+    _lv_obj_inv_batch_begin();
 
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
+    _lv_anim_block_t * block;
+    for(block = LV_GC_ROOT(_lv_anim_pool); block; block = block->next) {
+        uint32_t i;
+        for(i = 0; i < _LV_ANIM_BLOCK_SIZE; i++) {
+            if(!ANIM_IS_LIVE(block, i)) continue;
 
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            lv_anim_t * a = &block->anims[i];
+
+            /*Skip the animations created in this round*/
+            if(a->run_round == anim_run_round) continue;
+            a->run_round = anim_run_round;
 
             /*The animation will run now for the first time. Call `start_cb`*/
             int32_t new_act_time = a->act_time + elaps;
@@ -372,13 +328,15 @@ static void anim_timer(lv_timer_t * param)
                 }
                 if(a->start_cb) a->start_cb(a);
                 a->start_cb_called = 1;
+
+                /*`start_cb` might delete the animation*/
+                if(!ANIM_IS_LIVE(block, i)) continue;
             }
             a->act_time += elaps;
             if(a->act_time >= 0) {
                 if(a->act_time > a->time) a->act_time = a->time;
 
-                int32_t new_value;
-                new_value = a->path_cb(a);
+                int32_t new_value = anim_path_value(a);
 
                 if(new_value != a->current_value) {
                     a->current_value = new_value;
@@ -386,31 +344,32 @@ static void anim_timer(lv_timer_t * param)
                     if(a->exec_cb) a->exec_cb(a->var, new_value);
                 }
 
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
+                /*If the time is elapsed the animation is ready. `exec_cb` might have deleted it.*/
+                if(a->act_time >= a->time && ANIM_IS_LIVE(block, i)) {
+                    anim_ready_handler(block, i);
                 }
             }
         }
-
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
 
+    _lv_obj_inv_batch_end();
+
+    anim_timer_depth--;
+    if(anim_timer_depth == 0) pool_sweep();
+
     last_timer_run = lv_tick_get();
 }
 
 /**
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
- * @param a pointer to an animation descriptor
+ * @param block     the block of the animation
+ * @param id        index of the animation in the block
  */
-static void anim_ready_handler(lv_anim_t * a)
+static void anim_ready_handler(_lv_anim_block_t * block, uint32_t id)
 {
+    lv_anim_t * a = &block->anims[id];
+
     /*In the end of a forward anim decrement repeat cnt.*/
     if(a->playback_now == 0 && a->repeat_cnt > 0 && a->repeat_cnt != LV_ANIM_REPEAT_INFINITE) {
         a->repeat_cnt--;
@@ -421,15 +380,13 @@ static void anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_time == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Delete the animation from the pool but free it only later.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
+        anim_free(block, id);
+        anim_timer_update();
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
-        lv_mem_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -453,11 +410,220 @@ static void anim_ready_handler(lv_anim_t * a)
     }
 }
 
-static void anim_mark_list_change(void)
+/**
+ * Pause the animation timer if there are no animations, resume it otherwise
+ */
+static void anim_timer_update(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(anim_cnt == 0)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Get a free animation from the pool. Allocate a new block if all are full.
+ * @return      pointer to the animation or NULL on out of memory
+ */
+static lv_anim_t * anim_alloc(void)
+{
+    _lv_anim_block_t * block = LV_GC_ROOT(_lv_anim_pool);
+    while(block && block->used == BLOCK_FULL) block = block->next;
+
+    if(block == NULL) {
+        block = lv_mem_alloc(sizeof(_lv_anim_block_t));
+        LV_ASSERT_MALLOC(block);
+        if(block == NULL) return NULL;
+
+        block->used = 0;
+        block->deleted = 0;
+        block->next = LV_GC_ROOT(_lv_anim_pool);
+        LV_GC_ROOT(_lv_anim_pool) = block;
+    }
+
+    uint32_t i = 0;
+    while((block->used >> i) & 1) i++;
+
+    block->used |= 1 << i;
+    anim_cnt++;
+    return &block->anims[i];
+}
+
+/**
+ * Mark an animation as deleted. It will be freed by `pool_sweep()`.
+ * @param block     the block of the animation
+ * @param id        index of the animation in the block
+ */
+static void anim_free(_lv_anim_block_t * block, uint32_t id)
+{
+    block->deleted |= 1 << id;
+    anim_cnt--;
+    anim_del_pending = true;
+}
+
+/**
+ * Free the deleted animations and the empty blocks
+ */
+static void pool_sweep(void)
+{
+    if(!anim_del_pending) return;
+    anim_del_pending = false;
+
+    _lv_anim_block_t ** next_p = &LV_GC_ROOT(_lv_anim_pool);
+    while(*next_p) {
+        _lv_anim_block_t * block = *next_p;
+        block->used &= ~block->deleted;
+        block->deleted = 0;
+
+        if(block->used == 0) {
+            *next_p = block->next;
+            lv_mem_free(block);
+        }
+        else {
+            next_p = &block->next;
+        }
+    }
+}
+
+/**
+ * Sample the Bezier curves of the built-in paths
+ */
+static void path_lut_init(void)
+{
+    static const uint16_t ctrl_points[_PATH_LUT_NUM][4] = {
+        [PATH_LUT_EASE_IN] = {0, 50, 100, LV_BEZIER_VAL_MAX},
+        [PATH_LUT_EASE_OUT] = {0, 900, 950, LV_BEZIER_VAL_MAX},
+        [PATH_LUT_EASE_IN_OUT] = {0, 50, 952, LV_BEZIER_VAL_MAX},
+        [PATH_LUT_OVERSHOOT] = {0, 1000, 1300, LV_BEZIER_VAL_MAX},
+        [PATH_LUT_BOUNCE] = {LV_BEZIER_VAL_MAX, 800, 500, 0},
+    };
+
+    uint32_t p;
+    for(p = 0; p < _PATH_LUT_NUM; p++) {
+        const uint16_t * c = ctrl_points[p];
+        uint32_t i;
+        for(i = 0; i < PATH_LUT_SIZE; i++) {
+            path_lut[p][i] = (int16_t)lv_bezier3(i << PATH_LUT_SHIFT, c[0], c[1], c[2], c[3]);
+        }
+    }
+}
+
+/**
+ * Get the value of a sampled Bezier curve
+ * @param lut_id    the curve
+ * @param t         time in [0..LV_BEZIER_VAL_MAX] range
+ * @return          the value in [0..LV_BEZIER_VAL_MAX] range (might be larger for overshoot)
+ */
+static inline int32_t path_lut_get(path_lut_id_t lut_id, uint32_t t)
+{
+    const int16_t * lut = path_lut[lut_id];
+    uint32_t i = t >> PATH_LUT_SHIFT;
+    if(i >= PATH_LUT_SIZE - 1) return lut[PATH_LUT_SIZE - 1];
+
+    int32_t rem = t & ((1 << PATH_LUT_SHIFT) - 1);
+    return lut[i] + (((lut[i + 1] - lut[i]) * rem) >> PATH_LUT_SHIFT);
+}
+
+/**
+ * Map the current time of an animation to [0..max] range. The same as `lv_map(a->act_time, 0, a->time, 0, max)`.
+ */
+static inline int32_t anim_step(const lv_anim_t * a, int32_t max)
+{
+    if(a->act_time >= a->time) return max;
+    if(a->act_time <= 0) return 0;
+    return (a->act_time * max) / a->time;
+}
+
+/**
+ * Calculate the current value of an animation. The built-in paths are calculated here without calling `path_cb`.
+ */
+static inline int32_t anim_path_value(const lv_anim_t * a)
+{
+    lv_anim_path_cb_t path_cb = a->path_cb;
+    if(path_cb == lv_anim_path_linear) return path_linear(a);
+    else if(path_cb == lv_anim_path_ease_out) return path_bezier(a, PATH_LUT_EASE_OUT);
+    else if(path_cb == lv_anim_path_ease_in) return path_bezier(a, PATH_LUT_EASE_IN);
+    else if(path_cb == lv_anim_path_ease_in_out) return path_bezier(a, PATH_LUT_EASE_IN_OUT);
+    else if(path_cb == lv_anim_path_overshoot) return path_bezier(a, PATH_LUT_OVERSHOOT);
+    else return path_cb(a);
+}
+
+static inline int32_t path_linear(const lv_anim_t * a)
+{
+    /*Calculate the current step*/
+    int32_t step = anim_step(a, LV_ANIM_RESOLUTION);
+
+    /*Get the new value which will be proportional to `step`
+     *and the `start` and `end` values*/
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_ANIM_RES_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
+static inline int32_t path_bezier(const lv_anim_t * a, path_lut_id_t lut_id)
+{
+    /*Calculate the current step*/
+    uint32_t t = anim_step(a, LV_BEZIER_VAL_MAX);
+    int32_t step = path_lut_get(lut_id, t);
+
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
+static int32_t path_bounce(const lv_anim_t * a)
+{
+    /*Calculate the current step*/
+    int32_t t = anim_step(a, LV_BEZIER_VAL_MAX);
+    int32_t diff = (a->end_value - a->start_value);
+
+    /*3 bounces has 5 parts: 3 down and 2 up. One part is t / 5 long*/
+
+    if(t < 408) {
+        /*Go down*/
+        t = (t * 2500) >> LV_BEZIER_VAL_SHIFT; /*[0..1024] range*/
+    }
+    else if(t >= 408 && t < 614) {
+        /*First bounce back*/
+        t -= 408;
+        t    = t * 5; /*to [0..1024] range*/
+        t    = LV_BEZIER_VAL_MAX - t;
+        diff = diff / 20;
+    }
+    else if(t >= 614 && t < 819) {
+        /*Fall back*/
+        t -= 614;
+        t    = t * 5; /*to [0..1024] range*/
+        diff = diff / 20;
+    }
+    else if(t >= 819 && t < 921) {
+        /*Second bounce back*/
+        t -= 819;
+        t    = t * 10; /*to [0..1024] range*/
+        t    = LV_BEZIER_VAL_MAX - t;
+        diff = diff / 40;
+    }
+    else if(t >= 921 && t <= LV_BEZIER_VAL_MAX) {
+        /*Fall back*/
+        t -= 921;
+        t    = t * 10; /*to [0..1024] range*/
+        diff = diff / 40;
+    }
+
+    if(t > LV_BEZIER_VAL_MAX) t = LV_BEZIER_VAL_MAX;
+    if(t < 0) t = 0;
+    int32_t step = path_lut_get(PATH_LUT_BOUNCE, t);
+
+    int32_t new_value;
+    new_value = step * diff;
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value = a->end_value - new_value;
+
+    return new_value;
+}
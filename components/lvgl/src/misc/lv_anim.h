@@ -26,6 +26,9 @@ extern "C" {
 #define LV_ANIM_REPEAT_INFINITE      0xFFFF
 #define LV_ANIM_PLAYTIME_INFINITE    0xFFFFFFFF
 
+/*Number of animations in a block of the animation pool*/
+#define _LV_ANIM_BLOCK_SIZE          8
+
 LV_EXPORT_CONST_INT(LV_ANIM_REPEAT_INFINITE);
 LV_EXPORT_CONST_INT(LV_ANIM_PLAYTIME_INFINITE);
 
@@ -93,6 +96,18 @@ typedef struct _lv_anim_t {
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
 } lv_anim_t;
 
+/**
+ * A block of the animation pool. The animations are stored in a list of blocks
+ * so they don't move in the memory while running and are next to each other.
+ * Used internally.
+ */
+typedef struct _lv_anim_block_t {
+    struct _lv_anim_block_t * next;
+    uint8_t used;       /**< Bit `i` is set if `anims[i]` stores an animation*/
+    uint8_t deleted;    /**< Bit `i` is set if `anims[i]` is deleted but not freed yet*/
+    lv_anim_t anims[_LV_ANIM_BLOCK_SIZE];
+} _lv_anim_block_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -392,6 +407,7 @@ uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end);
 
 /**
  * Manually refresh the state of the animations.
+ * The invalidations of the animated objects are joined and added to the display at the end.
  * Useful to make the animations running in a blocking process where
  * `lv_timer_handler` can't run for a while.
  * Shouldn't be used directly because it is called in `lv_refr_now()`.
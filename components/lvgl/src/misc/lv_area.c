@@ -143,6 +143,47 @@ bool _lv_area_intersect(lv_area_t * res_p, const lv_area_t * a1_p, const lv_area
     return union_ok;
 }
 
+/**
+ * Get the parts of an area which are not covered by an other area
+ * @param res_p     array of 4 areas to store the result
+ * @param area_p    pointer to an area
+ * @param sub_p     pointer to the area to remove from `area_p`
+ * @return          number of areas stored in `res_p` (0..4).
+ *                  If the areas have no common parts `area_p` is copied to `res_p[0]`.
+ */
+uint32_t _lv_area_diff(lv_area_t res_p[], const lv_area_t * area_p, const lv_area_t * sub_p)
+{
+    lv_area_t com;
+    if(!_lv_area_intersect(&com, area_p, sub_p)) {
+        lv_area_copy(&res_p[0], area_p);
+        return 1;
+    }
+
+    uint32_t cnt = 0;
+
+    /*Full width band above and below the common part*/
+    if(area_p->y1 < com.y1) {
+        lv_area_set(&res_p[cnt], area_p->x1, area_p->y1, area_p->x2, com.y1 - 1);
+        cnt++;
+    }
+    if(area_p->y2 > com.y2) {
+        lv_area_set(&res_p[cnt], area_p->x1, com.y2 + 1, area_p->x2, area_p->y2);
+        cnt++;
+    }
+
+    /*Left and right of the common part*/
+    if(area_p->x1 < com.x1) {
+        lv_area_set(&res_p[cnt], area_p->x1, com.y1, com.x1 - 1, com.y2);
+        cnt++;
+    }
+    if(area_p->x2 > com.x2) {
+        lv_area_set(&res_p[cnt], com.x2 + 1, com.y1, area_p->x2, com.y2);
+        cnt++;
+    }
+
+    return cnt;
+}
+
 /**
  * Join two areas into a third which involves the other two
  * @param res_p pointer to an area, the result will be stored here
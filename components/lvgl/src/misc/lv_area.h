@@ -177,6 +177,16 @@ void lv_area_move(lv_area_t * area, lv_coord_t x_ofs, lv_coord_t y_ofs);
  */
 bool _lv_area_intersect(lv_area_t * res_p, const lv_area_t * a1_p, const lv_area_t * a2_p);
 
+/**
+ * Get the parts of an area which are not covered by an other area
+ * @param res_p     array of 4 areas to store the result
+ * @param area_p    pointer to an area
+ * @param sub_p     pointer to the area to remove from `area_p`
+ * @return          number of areas stored in `res_p` (0..4).
+ *                  If the areas have no common parts `area_p` is copied to `res_p[0]`.
+ */
+uint32_t _lv_area_diff(lv_area_t res_p[], const lv_area_t * area_p, const lv_area_t * sub_p);
+
 /**
  * Join two areas into a third which involves the other two
  * @param res_p pointer to an area, the result will be stored here
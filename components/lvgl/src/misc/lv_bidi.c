@@ -10,6 +10,7 @@
 #include "lv_bidi.h"
 #include "lv_txt.h"
 #include "../misc/lv_mem.h"
+#include "lv_thread.h"
 
 #if LV_USE_BIDI
 
@@ -56,8 +57,8 @@ static uint32_t get_txt_len(const char * txt, uint32_t max_len);
  **********************/
 static const uint8_t bracket_left[] = {"<({["};
 static const uint8_t bracket_right[] = {">)}]"};
-static bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
-static uint8_t br_stack_p;
+static LV_THREAD_LOCAL bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
+static LV_THREAD_LOCAL uint8_t br_stack_p;
 
 /**********************
  *      MACROS
@@ -153,9 +154,9 @@ uint16_t _lv_bidi_get_logical_pos(const char * str_in, char ** bidi_txt, uint32_
 
     if(is_rtl) *is_rtl = IS_RTL_POS(pos_conv_buf[visual_pos]);
 
-    if(bidi_txt == NULL) lv_mem_buf_release(buf);
     uint16_t res = GET_POS(pos_conv_buf[visual_pos]);
     lv_mem_buf_release(pos_conv_buf);
+    if(bidi_txt == NULL) lv_mem_buf_release(buf);
     return res;
 }
 
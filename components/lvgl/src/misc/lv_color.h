@@ -17,6 +17,7 @@ extern "C" {
 #include "lv_assert.h"
 #include "lv_math.h"
 #include "lv_types.h"
+#include "lv_thread.h"
 
 /*Error checking*/
 #if LV_COLOR_DEPTH == 24
@@ -529,10 +530,11 @@ LV_ATTRIBUTE_FAST_MEM static inline void lv_color_mix_with_alpha(lv_color_t bg_c
                                                                  lv_color_t fg_color, lv_opa_t fg_opa,
                                                                  lv_color_t * res_color, lv_opa_t * res_opa)
 {
-    /*Pick the foreground if it's fully opaque or the Background is fully transparent*/
+    /*Pick the foreground if it's fully opaque or the Background is fully transparent.
+     *The result can't be more transparent than the background.*/
     if(fg_opa >= LV_OPA_MAX || bg_opa <= LV_OPA_MIN) {
         res_color->full = fg_color.full;
-        *res_opa = fg_opa;
+        *res_opa = fg_opa > bg_opa ? fg_opa : bg_opa;
     }
     /*Transparent foreground: use the Background*/
     else if(fg_opa <= LV_OPA_MIN) {
@@ -547,12 +549,12 @@ LV_ATTRIBUTE_FAST_MEM static inline void lv_color_mix_with_alpha(lv_color_t bg_c
     /*Both colors have alpha. Expensive calculation need to be applied*/
     else {
         /*Save the parameters and the result. If they will be asked again don't compute again*/
-        static lv_opa_t fg_opa_save     = 0;
-        static lv_opa_t bg_opa_save     = 0;
-        static lv_color_t fg_color_save = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_color_t bg_color_save = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_color_t res_color_saved = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_opa_t res_opa_saved = 0;
+        static LV_THREAD_LOCAL lv_opa_t fg_opa_save     = 0;
+        static LV_THREAD_LOCAL lv_opa_t bg_opa_save     = 0;
+        static LV_THREAD_LOCAL lv_color_t fg_color_save = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_THREAD_LOCAL lv_color_t bg_color_save = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_THREAD_LOCAL lv_color_t res_color_saved = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_THREAD_LOCAL lv_opa_t res_opa_saved = 0;
 
         if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
            bg_color.full != bg_color_save.full) {
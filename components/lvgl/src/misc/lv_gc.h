@@ -18,6 +18,9 @@ extern "C" {
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_timer.h"
+#include "lv_anim.h"
+#include "lv_thread.h"
+#include "lv_lru.h"
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
@@ -45,19 +48,21 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_disp_ll)  /*Linked list of display device*/                            \
     LV_DISPATCH(f, lv_ll_t, _lv_indev_ll) /*Linked list of input device*/                              \
     LV_DISPATCH(f, lv_ll_t, _lv_fsdrv_ll)                                                              \
-    LV_DISPATCH(f, lv_ll_t, _lv_anim_ll)                                                               \
+    LV_DISPATCH(f, _lv_anim_block_t *, _lv_anim_pool) /*Blocks of the running animations*/              \
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH_COND(f, lv_lru_t*, _lv_img_cache_lru, LV_IMG_CACHE_DEF, 1)                             \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)\
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
-    LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH(f, lv_timer_t**, _lv_timer_heap) /*The running timers ordered by their deadline*/      \
+    LV_DISPATCH(f, LV_THREAD_LOCAL lv_mem_buf_arena_t , lv_mem_buf)                                   \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)    \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
-    LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)   \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_font_bitmap_cache_ll, LV_USE_FONT_COMPRESSED, 1)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
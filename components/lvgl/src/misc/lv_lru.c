@@ -10,8 +10,9 @@
 
 #include "lv_lru.h"
 #include "lv_log.h"
+#include "lv_mem.h"
+#include "lv_assert.h"
 
-#include <stdlib.h>
 #include <string.h>
 
 /*********************
@@ -40,11 +41,12 @@ static int lv_lru_cmp_keys(lruc_item * item, const void * key, uint32_t key_leng
 static void lv_lru_remove_item(lv_lru_t * cache, lruc_item * prev, lruc_item * item, uint32_t hash_index);
 
 /**
- * remove the least recently used item
+ * remove the least recently used item, or the one with the smallest `access_count + priority` if there is a priority callback
+ * @return false if there was no item to remove
  *
  * @todo we can optimise this by finding the n lru items, where n = required_space / average_length
  */
-static void lv_lru_remove_lru_item(lv_lru_t * cache);
+static bool lv_lru_remove_lru_item(lv_lru_t * cache);
 
 /** pop an existing item off the free queue, or create a new one */
 static lruc_item * lv_lru_pop_or_create_item(lv_lru_t * cache);
@@ -72,26 +74,29 @@ lv_lru_t * lv_lru_new(size_t cache_size, size_t average_length, lv_lru_free_t *
                       lv_lru_free_t * key_free)
 {
     // create the cache
-    lv_lru_t * cache = (lv_lru_t *) calloc(sizeof(lv_lru_t), 1);
+    lv_lru_t * cache = (lv_lru_t *) lv_mem_alloc(sizeof(lv_lru_t));
     if(!cache) {
         LV_LOG_WARN("LRU Cache unable to create cache object");
         return NULL;
     }
+    lv_memset_00(cache, sizeof(lv_lru_t));
     cache->hash_table_size = cache_size / average_length;
     cache->average_item_length = average_length;
     cache->free_memory = cache_size;
     cache->total_memory = cache_size;
     cache->seed = time(NULL);
-    cache->value_free = value_free ? value_free : free;
-    cache->key_free = key_free ? key_free : free;
+    cache->value_free = value_free ? value_free : lv_mem_free;
+    cache->key_free = key_free ? key_free : lv_mem_free;
+    if(cache->hash_table_size == 0) cache->hash_table_size = 1;
 
     // size the hash table to a guestimate of the number of slots required (assuming a perfect hash)
-    cache->items = (lruc_item **) calloc(sizeof(lruc_item *), cache->hash_table_size);
+    cache->items = (lruc_item **) lv_mem_alloc(sizeof(lruc_item *) * cache->hash_table_size);
     if(!cache->items) {
         LV_LOG_WARN("LRU Cache unable to create cache hash table");
-        free(cache);
+        lv_mem_free(cache);
         return NULL;
     }
+    lv_memset_00(cache->items, sizeof(lruc_item *) * cache->hash_table_size);
     return cache;
 }
 
@@ -111,24 +116,24 @@ lruc_error lv_lru_free(lv_lru_t * cache)
                 cache->value_free(item->value);
                 cache->key_free(item->key);
                 cache->free_memory += item->value_length;
-                free(item);
+                lv_mem_free(item);
                 item = next;
             }
         }
-        free(cache->items);
+        lv_mem_free(cache->items);
     }
 
     if(cache->free_items) {
         item = cache->free_items;
         while(item) {
             next = (lruc_item *) item->next;
-            free(item);
+            lv_mem_free(item);
             item = next;
         }
     }
 
     // free the cache
-    free(cache);
+    lv_mem_free(cache);
 
     return LV_LRU_NO_ERROR;
 }
@@ -141,9 +146,8 @@ lruc_error lv_lru_set(lv_lru_t * cache, const void * key, size_t key_length, voi
     test_for_missing_value();
     test_for_value_too_large();
 
-    // see if the key already exists
+    // if the key already exists remove the old value
     uint32_t hash_index = lv_lru_hash(cache, key, key_length);
-    size_t required = 0;
     lruc_item * item = NULL, *prev = NULL;
     item = cache->items[hash_index];
 
@@ -153,36 +157,33 @@ lruc_error lv_lru_set(lv_lru_t * cache, const void * key, size_t key_length, voi
     }
 
     if(item) {
-        // update the value and value_lengths
-        required = (size_t)(value_length - item->value_length);
-        cache->value_free(item->value);
-        item->value = value;
-        item->value_length = value_length;
-
+        lv_lru_remove_item(cache, prev, item, hash_index);
     }
-    else {
-        // insert a new item
-        item = lv_lru_pop_or_create_item(cache);
-        item->value = value;
-        item->key = malloc(key_length);
-        memcpy(item->key, key, key_length);
-        item->value_length = value_length;
-        item->key_length = key_length;
-        required = (size_t) value_length;
-
-        if(prev)
-            prev->next = item;
-        else
-            cache->items[hash_index] = item;
+
+    // remove as many items as necessary to free enough space.
+    // it's done before inserting the new item to never remove the new item itself
+    while(cache->free_memory < value_length) {
+        if(!lv_lru_remove_lru_item(cache)) return LV_LRU_VALUE_TOO_LARGE;
     }
-    item->access_count = ++cache->access_count;
 
-    // remove as many items as necessary to free enough space
-    if(required > 0 && (size_t) required > cache->free_memory) {
-        while(cache->free_memory < (size_t) required)
-            lv_lru_remove_lru_item(cache);
+    // insert the new item
+    item = lv_lru_pop_or_create_item(cache);
+    if(item == NULL) return LV_LRU_OUT_OF_MEMORY;
+    item->key = lv_mem_alloc(key_length);
+    if(item->key == NULL) {
+        item->next = cache->free_items;
+        cache->free_items = item;
+        return LV_LRU_OUT_OF_MEMORY;
     }
-    cache->free_memory -= required;
+    item->value = value;
+    memcpy(item->key, key, key_length);
+    item->value_length = value_length;
+    item->key_length = key_length;
+    item->next = cache->items[hash_index];
+    cache->items[hash_index] = item;
+
+    item->access_count = ++cache->access_count;
+    cache->free_memory -= value_length;
     return LV_LRU_NO_ERROR;
 }
 
@@ -232,6 +233,43 @@ lruc_error lv_lru_delete(lv_lru_t * cache, const void * key, size_t key_size)
     return LV_LRU_NO_ERROR;
 }
 
+void lv_lru_set_priority_cb(lv_lru_t * cache, lv_lru_priority_cb_t * priority_cb)
+{
+    cache->priority_cb = priority_cb;
+}
+
+lruc_error lv_lru_remove_lru(lv_lru_t * cache)
+{
+    test_for_missing_cache();
+
+    return lv_lru_remove_lru_item(cache) ? LV_LRU_NO_ERROR : LV_LRU_MISSING_VALUE;
+}
+
+lruc_error lv_lru_remove_if(lv_lru_t * cache, lv_lru_filter_cb_t * filter_cb, void * user_data)
+{
+    test_for_missing_cache();
+
+    lruc_item * item = NULL, *prev = NULL, *next = NULL;
+    uint32_t i = 0;
+    for(; i < cache->hash_table_size; i++) {
+        item = cache->items[i];
+        prev = NULL;
+
+        while(item) {
+            next = (lruc_item *) item->next;
+            if(filter_cb(item->value, user_data)) {
+                lv_lru_remove_item(cache, prev, item, i);
+            }
+            else {
+                prev = item;
+            }
+            item = next;
+        }
+    }
+
+    return LV_LRU_NO_ERROR;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -297,7 +335,7 @@ static void lv_lru_remove_item(lv_lru_t * cache, lruc_item * prev, lruc_item * i
     cache->free_items = item;
 }
 
-static void lv_lru_remove_lru_item(lv_lru_t * cache)
+static bool lv_lru_remove_lru_item(lv_lru_t * cache)
 {
     lruc_item * min_item = NULL, *min_prev = NULL;
     lruc_item * item = NULL, *prev = NULL;
@@ -309,19 +347,26 @@ static void lv_lru_remove_lru_item(lv_lru_t * cache)
         prev = NULL;
 
         while(item) {
-            if(item->access_count < min_access_count || (int64_t) min_access_count == -1) {
-                min_access_count = item->access_count;
-                min_item = item;
-                min_prev = prev;
-                min_index = i;
+            uint64_t access_count = item->access_count;
+            uint32_t priority = cache->priority_cb ? cache->priority_cb(item->value) : 0;
+            if(priority != LV_LRU_PINNED) {
+                access_count += priority;
+                if(access_count < min_access_count || min_item == NULL) {
+                    min_access_count = access_count;
+                    min_item = item;
+                    min_prev = prev;
+                    min_index = i;
+                }
             }
             prev = item;
             item = item->next;
         }
     }
 
-    if(min_item)
-        lv_lru_remove_item(cache, min_prev, min_item, min_index);
+    if(min_item == NULL) return false;
+
+    lv_lru_remove_item(cache, min_prev, min_item, min_index);
+    return true;
 }
 
 static lruc_item * lv_lru_pop_or_create_item(lv_lru_t * cache)
@@ -334,7 +379,8 @@ static lruc_item * lv_lru_pop_or_create_item(lv_lru_t * cache)
         memset(item, 0, sizeof(lruc_item));
     }
     else {
-        item = (lruc_item *) calloc(sizeof(lruc_item), 1);
+        item = (lruc_item *) lv_mem_alloc(sizeof(lruc_item));
+        if(item) lv_memset_00(item, sizeof(lruc_item));
     }
 
     return item;
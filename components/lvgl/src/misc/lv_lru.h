@@ -17,6 +17,7 @@ extern "C" {
 #include "../lv_conf_internal.h"
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <time.h>
 
 
@@ -24,6 +25,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Returned by ::lv_lru_priority_cb_t to never remove the item to make room*/
+#define LV_LRU_PINNED   UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,11 +38,29 @@ typedef enum {
     LV_LRU_MISSING_KEY,
     LV_LRU_MISSING_VALUE,
     LV_LRU_LOCK_ERROR,
-    LV_LRU_VALUE_TOO_LARGE
+    LV_LRU_VALUE_TOO_LARGE,
+    LV_LRU_OUT_OF_MEMORY
 } lruc_error;
 
 typedef void (lv_lru_free_t)(void * v);
 
+/**
+ * Tell how valuable an item is when an item has to be removed to make room.
+ * The item with the smallest `access_count + priority` is removed.
+ * @param v     the value of the item
+ * @return      the number of accesses for which the item is kept longer than the others,
+ *              or `LV_LRU_PINNED` to never remove it
+ */
+typedef uint32_t (lv_lru_priority_cb_t)(void * v);
+
+/**
+ * Select the items to remove in ::lv_lru_remove_if
+ * @param v             the value of the item
+ * @param user_data     the `user_data` of `lv_lru_remove_if`
+ * @return              true: remove the item
+ */
+typedef bool (lv_lru_filter_cb_t)(void * v, void * user_data);
+
 typedef struct lruc_item {
     void * value;
     void * key;
@@ -58,6 +80,7 @@ typedef struct {
     time_t seed;
     lv_lru_free_t * value_free;
     lv_lru_free_t * key_free;
+    lv_lru_priority_cb_t * priority_cb;
     lruc_item * free_items;
 } lv_lru_t;
 
@@ -71,12 +94,40 @@ lv_lru_t * lv_lru_new(size_t cache_size, size_t average_length, lv_lru_free_t *
 
 lruc_error lv_lru_free(lv_lru_t * cache);
 
+/**
+ * Store a value. Items are removed to make room for it first, the least recently used ones first.
+ * @return LV_LRU_VALUE_TOO_LARGE: there is no room for the value even without the removable items.
+ *         LV_LRU_OUT_OF_MEMORY: the item or the copy of the key couldn't be allocated.
+ *         On error the value is not stored and not freed, the caller keeps owning it.
+ */
 lruc_error lv_lru_set(lv_lru_t * cache, const void * key, size_t key_length, void * value, size_t value_length);
 
 lruc_error lv_lru_get(lv_lru_t * cache, const void * key, size_t key_size, void ** value);
 
 lruc_error lv_lru_delete(lv_lru_t * cache, const void * key, size_t key_size);
 
+/**
+ * Make the removal of the items to make room depend on their value too, not only on their last access.
+ * @param cache         pointer to a cache
+ * @param priority_cb   tells the priority of an item. NULL: remove the least recently used item.
+ */
+void lv_lru_set_priority_cb(lv_lru_t * cache, lv_lru_priority_cb_t * priority_cb);
+
+/**
+ * Remove the item which would be removed first to make room
+ * @param cache     pointer to a cache
+ * @return          LV_LRU_MISSING_VALUE: there is no item to remove (all of them are pinned)
+ */
+lruc_error lv_lru_remove_lru(lv_lru_t * cache);
+
+/**
+ * Remove the items selected by a callback, even the pinned ones
+ * @param cache         pointer to a cache
+ * @param filter_cb     called with every value, returns true to remove the item
+ * @param user_data     passed to `filter_cb`
+ */
+lruc_error lv_lru_remove_if(lv_lru_t * cache, lv_lru_filter_cb_t * filter_cb, void * user_data);
+
 /**********************
  *      MACROS
  **********************/
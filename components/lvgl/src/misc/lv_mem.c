@@ -39,24 +39,117 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+/*Values of `buf_hdr_t.prev` which are not offsets*/
+#define BUF_NONE            0xFFFFFFFF  /*The first buffer of the arena*/
+#define BUF_HEAP            0xFFFFFFFE  /*The buffer is allocated from the heap*/
+#define BUF_RELEASED        0x80000000  /*Flag in `buf_hdr_t.size`: released but not at the top of the arena yet*/
+
+/*Check the buffers of `lv_mem_buf_get()` on release*/
+#define BUF_CHECK           LV_USE_ASSERT_MEM_INTEGRITY
+#define BUF_MAGIC           0x5ca7c4b1
+#define BUF_GUARD           0xa5c3e1f7
+#if BUF_CHECK
+    #define BUF_GUARD_SIZE  sizeof(uint32_t)
+#else
+    #define BUF_GUARD_SIZE  0
+#endif
+
+/*The TLSF pool is shared by the rendering threads*/
+#if LV_MEM_CUSTOM == 0 && LV_USE_PARALLEL_RENDER
+    #define MEM_LOCK()      lv_mutex_lock(&mem_mutex)
+    #define MEM_UNLOCK()    lv_mutex_unlock(&mem_mutex)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+/*A size class: fixed size blocks in a continuous part of the slab area*/
+typedef struct {
+    uint8_t * start;        /*First block*/
+    uint8_t * end;          /*End of the last block*/
+    void * free_list;       /*The free blocks store the address of the next free block*/
+    uint32_t block_size;
+    uint32_t block_cnt;
+    uint32_t used_cnt;
+    uint32_t max_used_cnt;
+    uint32_t alloc_cnt;
+    uint32_t miss_cnt;
+} mem_slab_t;
+#endif
+
+/*Placed before each buffer of `lv_mem_buf_get()`*/
+typedef struct {
+    uint32_t prev;          /*Offset of the previous buffer's header in the arena, `BUF_NONE` or `BUF_HEAP`*/
+    uint32_t size;          /*Size of the buffer with the header and the guard, `BUF_RELEASED` might be set*/
+#if BUF_CHECK
+    uint32_t magic;         /*`BUF_MAGIC` while not released*/
+    uint32_t req_size;      /*The size asked from `lv_mem_buf_get()`. The guard is after it.*/
+#endif
+} buf_hdr_t;
+
+/*Placed before the header of the buffers allocated from the heap to free them on reset*/
+typedef struct _buf_heap_link_t {
+    struct _buf_heap_link_t * prev;
+    struct _buf_heap_link_t * next;
+} buf_heap_link_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+    static size_t mem_block_size(void * p);
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static void slab_init(void);
+    static void * slab_alloc(size_t size);
+    static void * slab_realloc(void * data_p, size_t new_size);
+    static void slab_free(mem_slab_t * slab, void * p);
+    static mem_slab_t * slab_find(const void * p);
+    static bool slab_check(void);
+#endif
+
+static lv_mem_buf_arena_t * buf_get_arena(void);
+static uint32_t buf_count_unreleased(lv_mem_buf_arena_t * arena);
+static void buf_stat_inc(uint32_t * stat, uint32_t v);
+static void buf_stat_max(uint32_t * stat, uint32_t v);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static lv_tlsf_t tlsf;
+    static uint32_t cur_used;
+    static uint32_t max_used;
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_USE_PARALLEL_RENDER
+    static lv_mutex_t mem_mutex;
+    static bool mem_mutex_inited;
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static const uint32_t slab_dsc[][2] = LV_MEM_SLAB_CLASSES;
+    #define SLAB_CLASS_CNT  (sizeof(slab_dsc) / sizeof(slab_dsc[0]))
+    static mem_slab_t slabs[SLAB_CLASS_CNT];
+    static uint8_t * slab_area_start;
+    static uint8_t * slab_area_end;
+    static bool slab_en = true;
 #endif
 
+static uint32_t buf_init_id;       /*Incremented by `lv_mem_init()` to drop the arenas of the threads*/
+
+/*Counters of the buffers of all threads*/
+static uint32_t buf_max_used;
+static uint32_t buf_overflow_cnt;
+static uint32_t buf_order_err_cnt;
+static uint32_t buf_leak_cnt;
+
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
 /**********************
@@ -85,6 +178,13 @@ void lv_mem_init(void)
 {
 #if LV_MEM_CUSTOM == 0
 
+#if LV_USE_PARALLEL_RENDER
+    if(!mem_mutex_inited) {
+        lv_mutex_init(&mem_mutex);
+        mem_mutex_inited = true;
+    }
+#endif
+
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
@@ -95,9 +195,24 @@ void lv_mem_init(void)
 #endif
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
+#endif
+    cur_used = 0;
+    max_used = 0;
+
+#if LV_MEM_SLAB
+    slab_init();
 #endif
 #endif
 
+    /*The arena of the calling thread. The other threads allocate theirs when they first need it.
+     *The arenas of an earlier init point into the destroyed heap so they are dropped.*/
+    buf_init_id++;
+    buf_get_arena();
+    buf_max_used = 0;
+    buf_overflow_cnt = 0;
+    buf_order_err_cnt = 0;
+    buf_leak_cnt = 0;
+
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
 #endif
@@ -129,7 +244,18 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+#if LV_MEM_SLAB
+    void * alloc = slab_alloc(size);
+    if(alloc == NULL) alloc = lv_tlsf_malloc(tlsf, size);
+#else
     void * alloc = lv_tlsf_malloc(tlsf, size);
+#endif
+    if(alloc) {
+        cur_used += mem_block_size(alloc);
+        if(cur_used > max_used) max_used = cur_used;
+    }
+    MEM_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -164,9 +290,24 @@ void lv_mem_free(void * data)
 
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
-    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
+    lv_memset(data, 0xbb, mem_block_size(data));
 #  endif
+    MEM_LOCK();
+#  if LV_MEM_SLAB
+    mem_slab_t * slab = slab_find(data);
+    if(slab) {
+        cur_used -= slab->block_size;
+        slab_free(slab, data);
+    }
+    else {
+        cur_used -= lv_tlsf_block_size(data);
+        lv_tlsf_free(tlsf, data);
+    }
+#  else
+    cur_used -= lv_tlsf_block_size(data);
     lv_tlsf_free(tlsf, data);
+#  endif
+    MEM_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -191,7 +332,18 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+    size_t old_size = data_p ? mem_block_size(data_p) : 0;
+#if LV_MEM_SLAB
+    void * new_p = slab_realloc(data_p, new_size);
+#else
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+#endif
+    if(new_p) {
+        cur_used += mem_block_size(new_p) - old_size;
+        if(cur_used > max_used) max_used = cur_used;
+    }
+    MEM_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -212,15 +364,30 @@ lv_res_t lv_mem_test(void)
     }
 
 #if LV_MEM_CUSTOM == 0
-    if(lv_tlsf_check(tlsf)) {
+    MEM_LOCK();
+    int tlsf_res = lv_tlsf_check(tlsf);
+    int pool_res = lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf));
+#if LV_MEM_SLAB
+    bool slab_ok = slab_check();
+#endif
+    MEM_UNLOCK();
+
+    if(tlsf_res) {
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
-    if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+    if(pool_res) {
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
+
+#if LV_MEM_SLAB
+    if(!slab_ok) {
+        LV_LOG_WARN("slab failed");
+        return LV_RES_INV;
+    }
+#endif
 #endif
     MEM_TRACE("passed");
     return LV_RES_OK;
@@ -238,12 +405,26 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    uint32_t pool_free_size = mon_p->free_size;
+
+#if LV_MEM_SLAB
+    /*The free blocks of the slabs are available too but they are not part of the fragmentation of the pool*/
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        mon_p->slab_size += slabs[i].block_size * slabs[i].block_cnt;
+        mon_p->slab_free_size += slabs[i].block_size * (slabs[i].block_cnt - slabs[i].used_cnt);
+    }
+    mon_p->free_size += mon_p->slab_free_size;
+#endif
+    MEM_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
+    mon_p->max_used = max_used;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
+    if(pool_free_size > 0) {
+        mon_p->frag_pct = mon_p->free_biggest_size * 100U / pool_free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
     }
     else {
@@ -256,8 +437,81 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
 
 /**
- * Get a temporal buffer with the given size.
+ * Start measuring the `max_used` of `lv_mem_monitor()`, the counters of the slabs and of `lv_mem_buf_monitor()` again
+ * @note The values of `lv_mem_monitor()` and the slabs work only if `LV_MEM_CUSTOM == 0`
+ */
+void lv_mem_reset_max_used(void)
+{
+    LV_ATOMIC_STORE(&buf_max_used, LV_GC_ROOT(lv_mem_buf).used);
+    LV_ATOMIC_STORE(&buf_overflow_cnt, 0);
+    LV_ATOMIC_STORE(&buf_order_err_cnt, 0);
+    LV_ATOMIC_STORE(&buf_leak_cnt, 0);
+
+#if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+    max_used = cur_used;
+#if LV_MEM_SLAB
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        slabs[i].max_used_cnt = slabs[i].used_cnt;
+        slabs[i].alloc_cnt = 0;
+        slabs[i].miss_cnt = 0;
+    }
+#endif
+    MEM_UNLOCK();
+#endif
+}
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+/**
+ * Get the number of size classes of the slab allocator (`LV_MEM_SLAB_CLASSES`)
+ * @return the number of size classes
+ */
+uint32_t lv_mem_slab_get_class_cnt(void)
+{
+    return SLAB_CLASS_CNT;
+}
+
+/**
+ * Give information about a size class of the slab allocator
+ * @param class_id index of the size class, `0 ... lv_mem_slab_get_class_cnt() - 1`
+ * @param mon_p pointer to a lv_mem_slab_monitor_t variable, the result will be stored here
+ */
+void lv_mem_slab_monitor(uint32_t class_id, lv_mem_slab_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_mem_slab_monitor_t));
+    if(class_id >= SLAB_CLASS_CNT) return;
+
+    MEM_LOCK();
+    mem_slab_t * slab = &slabs[class_id];
+    mon_p->block_size = slab->block_size;
+    mon_p->block_cnt = slab->block_cnt;
+    mon_p->used_cnt = slab->used_cnt;
+    mon_p->max_used_cnt = slab->max_used_cnt;
+    mon_p->alloc_cnt = slab->alloc_cnt;
+    mon_p->miss_cnt = slab->miss_cnt;
+    MEM_UNLOCK();
+}
+
+/**
+ * Enable or disable allocating from the slabs. If disabled all allocations use the pool.
+ * The already allocated blocks of the slabs can be freed and reallocated either way.
+ * If the slabs are disabled when `lv_mem_init()` runs, no memory is reserved for them until the next `lv_mem_init()`.
+ * @param en true: enable (default); false: disable
+ */
+void lv_mem_set_slab(bool en)
+{
+    slab_en = en;
+}
+
+#endif /*LV_MEM_SLAB*/
+
+/**
+ * Get a temporal buffer with the given size from the scratch arena of the calling thread.
+ * The buffers should be released in the reverse order of getting them.
  * @param size the required size
+ * @return pointer to the buffer or `NULL` if `size` is 0 or out of memory
  */
 void * lv_mem_buf_get(uint32_t size)
 {
@@ -265,50 +519,48 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
-    /*Try to find a free buffer with suitable size*/
-    int8_t i_guess = -1;
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
-        }
-    }
+    lv_mem_buf_arena_t * arena = buf_get_arena();
+    uint32_t block_size = sizeof(buf_hdr_t) + ((size + BUF_GUARD_SIZE + ALIGN_MASK) & ~ALIGN_MASK);
 
-    if(i_guess >= 0) {
-        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
-        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
-                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
-        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
+    buf_hdr_t * hdr;
+    if(arena->buf && block_size <= LV_MEM_BUF_SIZE - arena->top) {
+        hdr = (buf_hdr_t *)(arena->buf + arena->top);
+        hdr->prev = arena->last;
+        arena->last = arena->top;
+        arena->top += block_size;
+    }
+    else {
+        /*Doesn't fit: allocate from the heap and link it to free it on reset*/
+        buf_heap_link_t * link = lv_mem_alloc(sizeof(buf_heap_link_t) + block_size);
+        LV_ASSERT_MSG(link != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
+        if(link == NULL) return NULL;
+
+        link->prev = NULL;
+        link->next = arena->heap_list;
+        if(link->next) link->next->prev = link;
+        arena->heap_list = link;
+
+        hdr = (buf_hdr_t *)(link + 1);
+        hdr->prev = BUF_HEAP;
+        buf_stat_inc(&buf_overflow_cnt, 1);
+#if BUF_CHECK
+        LV_LOG_WARN("the arena is full, %d bytes are allocated from the heap (increase LV_MEM_BUF_SIZE)", size);
+#endif
     }
 
-    /*Reallocate a free buffer*/
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
-            LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
-            if(buf == NULL) return NULL;
+    hdr->size = block_size;
+#if BUF_CHECK
+    hdr->magic = BUF_MAGIC;
+    hdr->req_size = size;
+    uint32_t guard = BUF_GUARD;
+    lv_memcpy_small((uint8_t *)(hdr + 1) + size, &guard, sizeof(guard));
+#endif
 
-            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
-            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
-            return LV_GC_ROOT(lv_mem_buf[i]).p;
-        }
-    }
+    arena->used += block_size;
+    buf_stat_max(&buf_max_used, arena->used);
 
-    LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
-    LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
-    return NULL;
+    MEM_TRACE("finished (address: %p)", (void *)(hdr + 1));
+    return hdr + 1;
 }
 
 /**
@@ -317,31 +569,91 @@ void * lv_mem_buf_get(uint32_t size)
  */
 void lv_mem_buf_release(void * p)
 {
+    if(p == NULL) return;
+
     MEM_TRACE("begin (address: %p)", p);
 
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
-            return;
-        }
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf);
+    buf_hdr_t * hdr = (buf_hdr_t *)p - 1;
+
+#if BUF_CHECK
+    LV_ASSERT_MSG(hdr->magic == BUF_MAGIC, "Not a buffer of lv_mem_buf_get() or already released");
+    uint32_t guard;
+    lv_memcpy_small(&guard, (uint8_t *)p + hdr->req_size, sizeof(guard));
+    LV_ASSERT_MSG(guard == BUF_GUARD, "Written after the end of a buffer of lv_mem_buf_get()");
+    hdr->magic = 0;
+#endif
+
+    arena->used -= hdr->size;
+
+    if(hdr->prev == BUF_HEAP) {
+        buf_heap_link_t * link = (buf_heap_link_t *)hdr - 1;
+        if(link->prev) link->prev->next = link->next;
+        else arena->heap_list = link->next;
+        if(link->next) link->next->prev = link->prev;
+        lv_mem_free(link);
+        return;
+    }
+
+    uint32_t ofs = (uint32_t)((uint8_t *)hdr - arena->buf);
+    if(ofs != arena->last) {
+        /*Not the last buffer: it's freed when the buffers after it are released*/
+        hdr->size |= BUF_RELEASED;
+        buf_stat_inc(&buf_order_err_cnt, 1);
+#if BUF_CHECK
+        LV_LOG_WARN("%p is not released in the reverse order of getting the buffers", p);
+#endif
+        return;
     }
 
-    LV_LOG_ERROR("p is not a known buffer");
+    /*Pop it and the buffers released before it*/
+    arena->top = ofs;
+    arena->last = hdr->prev;
+    while(arena->last != BUF_NONE) {
+        buf_hdr_t * prev = (buf_hdr_t *)(arena->buf + arena->last);
+        if((prev->size & BUF_RELEASED) == 0) break;
+        arena->top = arena->last;
+        arena->last = prev->prev;
+    }
 }
 
 /**
- * Free all memory buffers
+ * Release all the buffers of the calling thread. The memory of the arena is kept.
+ * The buffers which were not released are counted as leaks.
  */
 void lv_mem_buf_free_all(void)
 {
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
-            LV_GC_ROOT(lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(lv_mem_buf[i]).size = 0;
-        }
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf);
+    if(arena->init_id != buf_init_id || arena->used == 0) return;
+
+    uint32_t leak_cnt = buf_count_unreleased(arena);
+    buf_stat_inc(&buf_leak_cnt, leak_cnt);
+    LV_LOG_WARN("%d buffers of lv_mem_buf_get() were not released", leak_cnt);
+
+    buf_heap_link_t * link = arena->heap_list;
+    while(link) {
+        buf_heap_link_t * next = link->next;
+        lv_mem_free(link);
+        link = next;
     }
+
+    arena->heap_list = NULL;
+    arena->top = 0;
+    arena->last = BUF_NONE;
+    arena->used = 0;
+}
+
+/**
+ * Give information about the scratch buffers of all threads
+ * @param mon_p pointer to a lv_mem_buf_monitor_t variable, the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p)
+{
+    mon_p->size = LV_MEM_BUF_SIZE;
+    mon_p->max_used = LV_ATOMIC_LOAD(&buf_max_used);
+    mon_p->overflow_cnt = LV_ATOMIC_LOAD(&buf_overflow_cnt);
+    mon_p->order_err_cnt = LV_ATOMIC_LOAD(&buf_order_err_cnt);
+    mon_p->leak_cnt = LV_ATOMIC_LOAD(&buf_leak_cnt);
 }
 
 #if LV_MEMCPY_MEMSET_STD == 0
@@ -534,6 +846,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_memset_ff(void * dst, size_t len)
  **********************/
 
 #if LV_MEM_CUSTOM == 0
+/*Size of an allocated block in the pool or in a slab*/
+static size_t mem_block_size(void * p)
+{
+#if LV_MEM_SLAB
+    mem_slab_t * slab = slab_find(p);
+    if(slab) return slab->block_size;
+#endif
+    return lv_tlsf_block_size(p);
+}
+
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
     LV_UNUSED(ptr);
@@ -550,3 +872,186 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+/*Reserve the blocks of the slabs in one piece of the pool and link them into the free lists*/
+static void slab_init(void)
+{
+    lv_memset_00(slabs, sizeof(slabs));
+    slab_area_start = NULL;
+    slab_area_end = NULL;
+    if(!slab_en) return;
+
+    uint32_t total = 0;
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        uint32_t block_size = (slab_dsc[i][0] + ALIGN_MASK) & ~ALIGN_MASK;
+        if(block_size < sizeof(void *)) block_size = sizeof(void *);
+        LV_ASSERT_MSG(i == 0 || block_size > slabs[i - 1].block_size, "LV_MEM_SLAB_CLASSES should be in increasing size");
+        slabs[i].block_size = block_size;
+        slabs[i].block_cnt = slab_dsc[i][1];
+        total += block_size * slabs[i].block_cnt;
+    }
+
+    if(total == 0) return;
+    uint8_t * p = lv_tlsf_malloc(tlsf, total);
+    LV_ASSERT_MSG(p != NULL, "LV_MEM_SLAB_CLASSES doesn't fit into LV_MEM_SIZE");
+    if(p == NULL) {
+        lv_memset_00(slabs, sizeof(slabs));
+        return;
+    }
+
+    slab_area_start = p;
+    slab_area_end = p + total;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        slab->start = p;
+        slab->end = p + slab->block_size * slab->block_cnt;
+
+        /*Link the blocks in order to give out the lower addresses first*/
+        void ** prev_next = &slab->free_list;
+        for(; p < slab->end; p += slab->block_size) {
+            *prev_next = p;
+            prev_next = (void **)p;
+        }
+        *prev_next = NULL;
+    }
+}
+
+/*Allocate from the smallest class which fits. NULL if the size is too large or the class is full*/
+static void * slab_alloc(size_t size)
+{
+    if(!slab_en) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        if(size > slab->block_size) continue;
+
+        void * p = slab->free_list;
+        if(p == NULL) {
+            slab->miss_cnt++;
+            return NULL;
+        }
+
+        slab->free_list = *(void **)p;
+        slab->used_cnt++;
+        if(slab->used_cnt > slab->max_used_cnt) slab->max_used_cnt = slab->used_cnt;
+        slab->alloc_cnt++;
+        return p;
+    }
+
+    return NULL;
+}
+
+static void * slab_realloc(void * data_p, size_t new_size)
+{
+    mem_slab_t * slab = data_p ? slab_find(data_p) : NULL;
+    if(slab == NULL) {
+        if(data_p == NULL) {
+            void * p = slab_alloc(new_size);
+            if(p) return p;
+        }
+
+        /*Keep the blocks of the pool in the pool as TLSF can often resize them in place*/
+        return lv_tlsf_realloc(tlsf, data_p, new_size);
+    }
+
+    if(new_size <= slab->block_size) return data_p;
+
+    void * new_p = slab_alloc(new_size);
+    if(new_p == NULL) new_p = lv_tlsf_malloc(tlsf, new_size);
+    if(new_p == NULL) return NULL;
+
+    lv_memcpy(new_p, data_p, slab->block_size);
+    slab_free(slab, data_p);
+    return new_p;
+}
+
+static void slab_free(mem_slab_t * slab, void * p)
+{
+    *(void **)p = slab->free_list;
+    slab->free_list = p;
+    slab->used_cnt--;
+}
+
+/*Get the class of a block or NULL if it's not in a slab*/
+static mem_slab_t * slab_find(const void * p)
+{
+    const uint8_t * p8 = p;
+    if(p8 < slab_area_start || p8 >= slab_area_end) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        if(p8 < slabs[i].end) return &slabs[i];
+    }
+
+    return NULL;
+}
+
+/*Check that the free lists point to the start of the blocks of their class and match the used counters*/
+static bool slab_check(void)
+{
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        uint32_t free_cnt = 0;
+        uint8_t * p;
+        for(p = slab->free_list; p; p = *(void **)p) {
+            if(p < slab->start || p >= slab->end) return false;
+            if((uint32_t)(p - slab->start) % slab->block_size) return false;
+            free_cnt++;
+            if(free_cnt > slab->block_cnt) return false;
+        }
+
+        if(free_cnt + slab->used_cnt != slab->block_cnt) return false;
+    }
+
+    return true;
+}
+
+#endif /*LV_MEM_SLAB*/
+
+/*Get the arena of the calling thread and allocate its memory on the first call*/
+static lv_mem_buf_arena_t * buf_get_arena(void)
+{
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf);
+    if(arena->init_id != buf_init_id) {
+        lv_memset_00(arena, sizeof(lv_mem_buf_arena_t));
+        /*If it fails all buffers are allocated from the heap*/
+        arena->buf = LV_MEM_BUF_SIZE ? lv_mem_alloc(LV_MEM_BUF_SIZE) : NULL;
+        arena->last = BUF_NONE;
+        arena->init_id = buf_init_id;
+    }
+    return arena;
+}
+
+static uint32_t buf_count_unreleased(lv_mem_buf_arena_t * arena)
+{
+    uint32_t cnt = 0;
+    uint32_t ofs = arena->last;
+    while(ofs != BUF_NONE) {
+        buf_hdr_t * hdr = (buf_hdr_t *)(arena->buf + ofs);
+        if((hdr->size & BUF_RELEASED) == 0) cnt++;
+        ofs = hdr->prev;
+    }
+
+    buf_heap_link_t * link;
+    for(link = arena->heap_list; link; link = link->next) cnt++;
+
+    return cnt;
+}
+
+/*The counters are shared by the render threads*/
+static void buf_stat_inc(uint32_t * stat, uint32_t v)
+{
+    uint32_t old = LV_ATOMIC_LOAD(stat);
+    while(!LV_ATOMIC_CAS(stat, &old, old + v));
+}
+
+static void buf_stat_max(uint32_t * stat, uint32_t v)
+{
+    uint32_t old = LV_ATOMIC_LOAD(stat);
+    while(v > old && !LV_ATOMIC_CAS(stat, &old, v));
+}
@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "lv_types.h"
@@ -35,21 +36,49 @@ extern "C" {
 typedef struct {
     uint32_t total_size; /**< Total heap size*/
     uint32_t free_cnt;
-    uint32_t free_size; /**< Size of available memory*/
+    uint32_t free_size; /**< Size of available memory (with the free blocks of the slabs)*/
     uint32_t free_biggest_size;
     uint32_t used_cnt;
-    uint32_t max_used; /**< Max size of Heap memory used*/
+    uint32_t max_used; /**< Max size of Heap memory used since `lv_mem_init()` or `lv_mem_reset_max_used()`*/
+    uint32_t slab_size; /**< Size of the memory reserved for the slabs (0 if `LV_MEM_SLAB` is disabled)*/
+    uint32_t slab_free_size; /**< Size of the free blocks of the slabs*/
     uint8_t used_pct; /**< Percentage used*/
-    uint8_t frag_pct; /**< Amount of fragmentation*/
+    uint8_t frag_pct; /**< Amount of fragmentation of the pool (without the slabs)*/
 } lv_mem_monitor_t;
 
+/**
+ * Information about a size class of the slab allocator.
+ */
 typedef struct {
-    void * p;
-    uint16_t size;
-    uint8_t used : 1;
-} lv_mem_buf_t;
+    uint32_t block_size;    /**< Size of the blocks [bytes]*/
+    uint32_t block_cnt;     /**< Number of blocks*/
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t max_used_cnt;  /**< Max number of allocated blocks since `lv_mem_init()` or `lv_mem_reset_max_used()`*/
+    uint32_t alloc_cnt;     /**< Number of allocations served from the class*/
+    uint32_t miss_cnt;      /**< Number of allocations which used the pool as all blocks of the class were allocated*/
+} lv_mem_slab_monitor_t;
 
-typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
+/**
+ * Information about the scratch buffers of `lv_mem_buf_get()`.
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the arena of a thread [bytes] (`LV_MEM_BUF_SIZE`)*/
+    uint32_t max_used;      /**< Max size of the buffers used at once by a thread since `lv_mem_init()` or `lv_mem_reset_max_used()`.
+                                 With the headers and the buffers which didn't fit into the arena. `LV_MEM_BUF_SIZE` should be at least this.*/
+    uint32_t overflow_cnt;  /**< Number of buffers allocated from the heap as they didn't fit into the arena*/
+    uint32_t order_err_cnt; /**< Number of buffers not released in the reverse order of getting them*/
+    uint32_t leak_cnt;      /**< Number of buffers not released when the arena was reset*/
+} lv_mem_buf_monitor_t;
+
+/*The scratch arena of a thread. The buffers are stacked from the start of `buf`.*/
+typedef struct {
+    uint8_t * buf;          /*`LV_MEM_BUF_SIZE` bytes or `NULL` if not allocated yet*/
+    void * heap_list;       /*The buffers allocated from the heap as they didn't fit into the arena*/
+    uint32_t top;           /*Offset of the first free byte in `buf`*/
+    uint32_t last;          /*Offset of the last buffer's header in `buf`*/
+    uint32_t used;          /*Size of the buffers in use with the ones in the heap*/
+    uint32_t init_id;       /*The arena is valid only after the same `lv_mem_init()`*/
+} lv_mem_buf_arena_t;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -101,10 +130,43 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Start measuring the `max_used` of `lv_mem_monitor()` and the counters of the slabs again
+ * @note It work only if `LV_MEM_CUSTOM == 0`
+ */
+void lv_mem_reset_max_used(void);
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+/**
+ * Get the number of size classes of the slab allocator (`LV_MEM_SLAB_CLASSES`)
+ * @return the number of size classes
+ */
+uint32_t lv_mem_slab_get_class_cnt(void);
+
+/**
+ * Give information about a size class of the slab allocator
+ * @param class_id index of the size class, `0 ... lv_mem_slab_get_class_cnt() - 1`
+ * @param mon_p pointer to a lv_mem_slab_monitor_t variable, the result will be stored here
+ */
+void lv_mem_slab_monitor(uint32_t class_id, lv_mem_slab_monitor_t * mon_p);
+
+/**
+ * Enable or disable allocating from the slabs. If disabled all allocations use the pool.
+ * The already allocated blocks of the slabs can be freed and reallocated either way.
+ * If the slabs are disabled when `lv_mem_init()` runs, no memory is reserved for them until the next `lv_mem_init()`.
+ * @param en true: enable (default); false: disable
+ */
+void lv_mem_set_slab(bool en);
+
+#endif /*LV_MEM_SLAB*/
+
 
 /**
- * Get a temporal buffer with the given size.
+ * Get a temporal buffer with the given size from the scratch arena of the calling thread.
+ * The buffers should be released in the reverse order of getting them.
  * @param size the required size
+ * @return pointer to the buffer or `NULL` if `size` is 0 or out of memory
  */
 void * lv_mem_buf_get(uint32_t size);
 
@@ -115,10 +177,17 @@ void * lv_mem_buf_get(uint32_t size);
 void lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Release all the buffers of the calling thread. The memory of the arena is kept.
+ * The buffers which were not released are counted as leaks.
  */
 void lv_mem_buf_free_all(void);
 
+/**
+ * Give information about the scratch buffers of all threads
+ * @param mon_p pointer to a lv_mem_buf_monitor_t variable, the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
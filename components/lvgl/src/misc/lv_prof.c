@@ -0,0 +1,156 @@
+/**
+ * @file lv_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_prof.h"
+
+#if LV_USE_PROFILER
+
+#include "lv_mem.h"
+#include "lv_log.h"
+#include "lv_printf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_prof_frame_t frames[LV_PROFILER_FRAME_CNT];
+static uint32_t frame_next;     /*Index of the next frame to write in `frames`*/
+static uint32_t frame_cnt;
+
+static const char * names[_LV_PROF_ID_NUM] = {
+    [LV_PROF_FRAME] = "frame",
+    [LV_PROF_LAYOUT] = "layout",
+    [LV_PROF_RENDER] = "render",
+    [LV_PROF_STYLE] = "style",
+    [LV_PROF_BLEND] = "blend",
+    [LV_PROF_FLUSH] = "flush",
+    [LV_PROF_FLUSH_WAIT] = "flush_wait",
+    [LV_PROF_DRAW_RECT] = "draw_rect",
+    [LV_PROF_DRAW_LETTER] = "draw_letter",
+    [LV_PROF_DRAW_IMG] = "draw_img",
+    [LV_PROF_DRAW_LINE] = "draw_line",
+    [LV_PROF_DRAW_ARC] = "draw_arc",
+    [LV_PROF_DRAW_POLYGON] = "draw_polygon",
+};
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+LV_THREAD_LOCAL lv_prof_frame_t _lv_prof_act;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t lv_prof_get_frame_cnt(void)
+{
+    return frame_cnt;
+}
+
+const lv_prof_frame_t * lv_prof_get_frame(uint32_t idx)
+{
+    if(idx >= frame_cnt) return NULL;
+
+    return &frames[(frame_next + LV_PROFILER_FRAME_CNT - 1 - idx) % LV_PROFILER_FRAME_CNT];
+}
+
+const char * lv_prof_get_name(lv_prof_id_t id)
+{
+    if(id >= _LV_PROF_ID_NUM) return "";
+    return names[id];
+}
+
+uint32_t lv_prof_time_to_us(uint32_t time)
+{
+#if LV_PROF_TIME_FREQ >= 1000000
+    return time / (LV_PROF_TIME_FREQ / 1000000);
+#else
+    return (uint32_t)(((uint64_t)time * 1000000) / LV_PROF_TIME_FREQ);
+#endif
+}
+
+void lv_prof_dump(lv_prof_print_cb_t print_cb)
+{
+    char buf[96];
+    lv_snprintf(buf, sizeof(buf), "%"LV_PRIu32" frames, avg. us / max. us / avg. calls:", frame_cnt);
+    if(print_cb) print_cb(buf);
+    else LV_LOG_USER("%s", buf);
+
+    if(frame_cnt == 0) return;
+
+    uint32_t id;
+    for(id = 0; id < _LV_PROF_ID_NUM; id++) {
+        uint64_t sum = 0;
+        uint32_t max = 0;
+        uint32_t cnt = 0;
+        uint32_t i;
+        for(i = 0; i < frame_cnt; i++) {
+            sum += frames[i].time[id];
+            cnt += frames[i].cnt[id];
+            if(frames[i].time[id] > max) max = frames[i].time[id];
+        }
+
+        lv_snprintf(buf, sizeof(buf), "%-12s %8"LV_PRIu32" %8"LV_PRIu32" %6"LV_PRIu32, names[id],
+                    lv_prof_time_to_us((uint32_t)(sum / frame_cnt)), lv_prof_time_to_us(max), cnt / frame_cnt);
+        if(print_cb) print_cb(buf);
+        else LV_LOG_USER("%s", buf);
+    }
+}
+
+void lv_prof_reset(void)
+{
+    frame_cnt = 0;
+    frame_next = 0;
+}
+
+void _lv_prof_thread_take(lv_prof_frame_t * frame)
+{
+    lv_memcpy_small(frame, &_lv_prof_act, sizeof(lv_prof_frame_t));
+    lv_memset_00(&_lv_prof_act, sizeof(lv_prof_frame_t));
+}
+
+void _lv_prof_merge(const lv_prof_frame_t * frame)
+{
+    uint32_t id;
+    for(id = 0; id < _LV_PROF_ID_NUM; id++) {
+        _lv_prof_act.time[id] += frame->time[id];
+        _lv_prof_act.cnt[id] += frame->cnt[id];
+    }
+}
+
+void _lv_prof_frame_end(bool save)
+{
+    if(save) {
+        lv_memcpy_small(&frames[frame_next], &_lv_prof_act, sizeof(lv_prof_frame_t));
+        frame_next = (frame_next + 1) % LV_PROFILER_FRAME_CNT;
+        if(frame_cnt < LV_PROFILER_FRAME_CNT) frame_cnt++;
+    }
+
+    lv_memset_00(&_lv_prof_act, sizeof(lv_prof_frame_t));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,212 @@
+/**
+ * @file lv_prof.h
+ * Measure the time of the refresh phases and draw operations of the last frames.
+ */
+
+#ifndef LV_PROF_H
+#define LV_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_PROFILER
+
+#include "lv_thread.h"
+
+#if LV_PROFILER_TIME_CUSTOM
+    #include LV_PROFILER_TIME_CUSTOM_INCLUDE
+#elif defined(ESP_PLATFORM)
+    #include "esp_idf_version.h"
+    #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        #include "esp_cpu.h"
+    #else
+        #include "soc/cpu.h"
+    #endif
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <time.h>
+#else
+    #include "../hal/lv_hal_tick.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Frequency of the counter returned by `_lv_prof_time()` in Hz*/
+#if LV_PROFILER_TIME_CUSTOM
+    #define LV_PROF_TIME_FREQ   LV_PROFILER_TIME_CUSTOM_FREQ
+#elif defined(ESP_PLATFORM)
+    #if defined(CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ)
+        #define LV_PROF_TIME_FREQ   (CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000)
+    #elif defined(CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ)
+        #define LV_PROF_TIME_FREQ   (CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000)
+    #else
+        #define LV_PROF_TIME_FREQ   240000000
+    #endif
+#elif defined(__unix__) || defined(__APPLE__)
+    #define LV_PROF_TIME_FREQ   1000000000
+#else
+    #define LV_PROF_TIME_FREQ   1000
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The measured parts of a frame. They can be nested, e.g. `LV_PROF_BLEND` is part of `LV_PROF_DRAW_RECT` too.
+ */
+typedef enum {
+    LV_PROF_FRAME,          /**< The whole refresh of a display*/
+    LV_PROF_LAYOUT,         /**< Updating the layout of the screens before drawing*/
+    LV_PROF_RENDER,         /**< Drawing the objects into the draw buffers*/
+    LV_PROF_STYLE,          /**< Getting style properties*/
+    LV_PROF_BLEND,          /**< Blending into the draw buffer*/
+    LV_PROF_FLUSH,          /**< In `flush_cb` of the display driver*/
+    LV_PROF_FLUSH_WAIT,     /**< Waiting for a buffer to be flushed*/
+    LV_PROF_DRAW_RECT,
+    LV_PROF_DRAW_LETTER,
+    LV_PROF_DRAW_IMG,
+    LV_PROF_DRAW_LINE,
+    LV_PROF_DRAW_ARC,
+    LV_PROF_DRAW_POLYGON,
+    _LV_PROF_ID_NUM
+} lv_prof_id_t;
+
+/**
+ * The measurements of a frame. The time is in the units of the counter, see `lv_prof_time_to_us()`.
+ * With parallel rendering the times of the render threads are added together.
+ */
+typedef struct {
+    uint32_t time[_LV_PROF_ID_NUM];     /**< Sum of the time spent in the measured parts*/
+    uint32_t cnt[_LV_PROF_ID_NUM];      /**< Number of times the measured parts were run*/
+} lv_prof_frame_t;
+
+typedef void (*lv_prof_print_cb_t)(const char * buf);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the number of frames whose measurements are stored. At most `LV_PROFILER_FRAME_CNT`.
+ * @return      number of frames
+ */
+uint32_t lv_prof_get_frame_cnt(void);
+
+/**
+ * Get the measurements of a recent frame
+ * @param idx   0: the last frame, 1: the frame before it, etc.
+ * @return      pointer to the measurements or NULL if `idx` is not smaller than `lv_prof_get_frame_cnt()`
+ */
+const lv_prof_frame_t * lv_prof_get_frame(uint32_t idx);
+
+/**
+ * Get the readable name of a measured part
+ * @param id    ID of the part
+ * @return      name of the part, e.g. "draw_rect"
+ */
+const char * lv_prof_get_name(lv_prof_id_t id);
+
+/**
+ * Convert the time of the measurements to microseconds
+ * @param time  a time from `lv_prof_frame_t`
+ * @return      the time in microseconds
+ */
+uint32_t lv_prof_time_to_us(uint32_t time);
+
+/**
+ * Print the average and maximal time of every part in the stored frames
+ * @param print_cb  function to print a line. NULL: print with `LV_LOG_USER`
+ */
+void lv_prof_dump(lv_prof_print_cb_t print_cb);
+
+/**
+ * Delete the stored frames
+ */
+void lv_prof_reset(void);
+
+/**
+ * Move the measurements of the calling thread to `frame`.
+ * Used by the render threads, their measurements are merged by the main thread with `_lv_prof_merge()`.
+ * @param frame     the measurements are copied here
+ */
+void _lv_prof_thread_take(lv_prof_frame_t * frame);
+
+/**
+ * Add measurements (typically of a render thread) to the current frame of the calling thread
+ * @param frame     the measurements to add
+ */
+void _lv_prof_merge(const lv_prof_frame_t * frame);
+
+/**
+ * Store the measurements of the current frame in the ring buffer and start a new frame
+ * @param save      false: drop the measurements, e.g. if nothing was redrawn
+ */
+void _lv_prof_frame_end(bool save);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/*The measurements of the current frame on the calling thread*/
+extern LV_THREAD_LOCAL lv_prof_frame_t _lv_prof_act;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * Read the free running counter
+ * @return  the counter with `LV_PROF_TIME_FREQ` frequency
+ */
+static inline uint32_t _lv_prof_time(void)
+{
+#if LV_PROFILER_TIME_CUSTOM
+    return LV_PROFILER_TIME_CUSTOM_EXPR;
+#elif defined(ESP_PLATFORM)
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    return (uint32_t)esp_cpu_get_cycle_count();
+#else
+    return esp_cpu_get_ccount();
+#endif
+#elif defined(__unix__) || defined(__APPLE__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000000000 + (uint32_t)ts.tv_nsec;
+#else
+    return lv_tick_get();
+#endif
+}
+
+static inline void _lv_prof_add(lv_prof_id_t id, uint32_t start)
+{
+    _lv_prof_act.time[id] += _lv_prof_time() - start;
+    _lv_prof_act.cnt[id]++;
+}
+
+/*Measure the time between `LV_PROF_BEGIN(t)` and `LV_PROF_END(id, t)` in the same block*/
+#define LV_PROF_BEGIN(t)        uint32_t t = _lv_prof_time()
+#define LV_PROF_END(id, t)      _lv_prof_add(id, t)
+
+#else /*LV_USE_PROFILER*/
+
+#define LV_PROF_BEGIN(t)
+#define LV_PROF_END(id, t)
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROF_H*/
@@ -0,0 +1,186 @@
+/**
+ * @file lv_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thread.h"
+
+#if LV_USE_PARALLEL_RENDER
+
+#include "lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_PARALLEL_RENDER_OS == LV_OS_PTHREAD
+    static void * thread_entry(void * param);
+#else
+    static void thread_entry(void * param);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static LV_THREAD_LOCAL bool is_worker;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_thread_is_worker(void)
+{
+    return is_worker;
+}
+
+#if LV_PARALLEL_RENDER_OS == LV_OS_PTHREAD
+
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data)
+{
+    thread->callback = callback;
+    thread->user_data = user_data;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if(stack_size < PTHREAD_STACK_MIN) stack_size = PTHREAD_STACK_MIN;
+    pthread_attr_setstacksize(&attr, stack_size);
+    int res = pthread_create(&thread->thread, &attr, thread_entry, thread);
+    pthread_attr_destroy(&attr);
+    if(res) {
+        LV_LOG_WARN("pthread_create failed: %d", res);
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_mutex_lock(lv_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+void lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    sync->signaled = false;
+    if(pthread_mutex_init(&sync->mutex, NULL)) return LV_RES_INV;
+    if(pthread_cond_init(&sync->cond, NULL)) return LV_RES_INV;
+    return LV_RES_OK;
+}
+
+void lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    while(!sync->signaled) {
+        pthread_cond_wait(&sync->cond, &sync->mutex);
+    }
+    sync->signaled = false;
+    pthread_mutex_unlock(&sync->mutex);
+}
+
+void lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    sync->signaled = true;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->mutex);
+}
+
+#else /*LV_OS_FREERTOS*/
+
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data)
+{
+    thread->callback = callback;
+    thread->user_data = user_data;
+
+    /*Run with the priority of the creator (typically the GUI task) on any core*/
+    BaseType_t res = xTaskCreate(thread_entry, "lvgl_render", stack_size / sizeof(StackType_t), thread,
+                                 uxTaskPriorityGet(NULL), &thread->task);
+    if(res != pdPASS) {
+        LV_LOG_WARN("xTaskCreate failed");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_mutex_lock(lv_mutex_t * mutex)
+{
+    xSemaphoreTake(*mutex, portMAX_DELAY);
+}
+
+void lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    xSemaphoreGive(*mutex);
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    *sync = xSemaphoreCreateBinary();
+    return *sync ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    xSemaphoreTake(*sync, portMAX_DELAY);
+}
+
+void lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    xSemaphoreGive(*sync);
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_PARALLEL_RENDER_OS == LV_OS_PTHREAD
+static void * thread_entry(void * param)
+{
+    lv_thread_t * thread = param;
+    is_worker = true;
+    thread->callback(thread->user_data);
+    return NULL;
+}
+#else
+static void thread_entry(void * param)
+{
+    lv_thread_t * thread = param;
+    is_worker = true;
+    thread->callback(thread->user_data);
+    vTaskDelete(NULL);
+}
+#endif
+
+#endif /*LV_USE_PARALLEL_RENDER*/
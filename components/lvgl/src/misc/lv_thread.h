@@ -0,0 +1,182 @@
+/**
+ * @file lv_thread.h
+ * Minimal thread, mutex and signal abstraction used by the parallel renderer.
+ */
+
+#ifndef LV_THREAD_H
+#define LV_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_OS_PTHREAD   1
+#define LV_OS_FREERTOS  2
+
+/*Variables which are modified while drawing have to be thread local if the rendering runs on more threads*/
+#if LV_USE_PARALLEL_RENDER
+    #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+        #define LV_THREAD_LOCAL _Thread_local
+    #else
+        #define LV_THREAD_LOCAL __thread
+    #endif
+#else
+    #define LV_THREAD_LOCAL
+#endif
+
+/*Lock-free access of the naturally aligned 32 bit variables and pointers shared by the render threads*/
+#if LV_USE_PARALLEL_RENDER
+    #define LV_ATOMIC_LOAD(p)           __atomic_load_n(p, __ATOMIC_RELAXED)
+    #define LV_ATOMIC_LOAD_ACQ(p)       __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define LV_ATOMIC_STORE(p, v)       __atomic_store_n(p, v, __ATOMIC_RELAXED)
+    #define LV_ATOMIC_STORE_REL(p, v)   __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define LV_ATOMIC_CAS(p, exp, v)    __atomic_compare_exchange_n(p, exp, v, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+    #define LV_ATOMIC_FENCE_ACQ()       __atomic_thread_fence(__ATOMIC_ACQUIRE)
+    #define LV_ATOMIC_FENCE_REL()       __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+    #define LV_ATOMIC_LOAD(p)           (*(p))
+    #define LV_ATOMIC_LOAD_ACQ(p)       (*(p))
+    #define LV_ATOMIC_STORE(p, v)       (*(p) = (v))
+    #define LV_ATOMIC_STORE_REL(p, v)   (*(p) = (v))
+    #define LV_ATOMIC_CAS(p, exp, v)    (*(p) == *(exp) ? (*(p) = (v), true) : false)
+    #define LV_ATOMIC_FENCE_ACQ()
+    #define LV_ATOMIC_FENCE_REL()
+#endif
+
+#if LV_USE_PARALLEL_RENDER
+
+#if LV_PARALLEL_RENDER_OS == LV_OS_PTHREAD
+    #include <pthread.h>
+    #include <limits.h>
+#elif LV_PARALLEL_RENDER_OS == LV_OS_FREERTOS
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/task.h"
+        #include "freertos/semphr.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+        #include "semphr.h"
+    #endif
+#else
+    #error "LV_PARALLEL_RENDER_OS: unknown thread API"
+#endif
+
+#if LV_ENABLE_GC
+    #error "LV_USE_PARALLEL_RENDER can't be used with LV_ENABLE_GC"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef void (*lv_thread_cb_t)(void * user_data);
+
+#if LV_PARALLEL_RENDER_OS == LV_OS_PTHREAD
+typedef struct {
+    pthread_t thread;
+    lv_thread_cb_t callback;
+    void * user_data;
+} lv_thread_t;
+
+typedef pthread_mutex_t lv_mutex_t;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool signaled;
+} lv_thread_sync_t;
+
+#else
+typedef struct {
+    TaskHandle_t task;
+    lv_thread_cb_t callback;
+    void * user_data;
+} lv_thread_t;
+
+typedef SemaphoreHandle_t lv_mutex_t;
+
+typedef SemaphoreHandle_t lv_thread_sync_t;
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a new thread
+ * @param thread        pointer to a thread descriptor to initialize. It must be valid while the thread runs.
+ * @param callback      function to run in the thread
+ * @param stack_size    stack size of the thread in bytes
+ * @param user_data     parameter of `callback`
+ * @return              LV_RES_OK: success; LV_RES_INV: the thread couldn't be created
+ */
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data);
+
+/**
+ * Tell if the calling thread was created by `lv_thread_init`.
+ * @return true: the function was called from an LVGL helper thread
+ */
+bool lv_thread_is_worker(void);
+
+/**
+ * Initialize a mutex
+ * @param mutex pointer to a mutex
+ * @return      LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_mutex_init(lv_mutex_t * mutex);
+
+/**
+ * Lock a mutex. Wait if it's locked by an other thread.
+ * @param mutex pointer to an initialized mutex
+ */
+void lv_mutex_lock(lv_mutex_t * mutex);
+
+/**
+ * Unlock a mutex
+ * @param mutex pointer to a mutex locked by the calling thread
+ */
+void lv_mutex_unlock(lv_mutex_t * mutex);
+
+/**
+ * Initialize a signal which can be waited for by an other thread
+ * @param sync  pointer to a sync variable
+ * @return      LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync);
+
+/**
+ * Wait until `sync` is signaled and clear the signal
+ * @param sync  pointer to an initialized sync variable
+ */
+void lv_thread_sync_wait(lv_thread_sync_t * sync);
+
+/**
+ * Signal `sync` to wake up the thread waiting for it
+ * @param sync  pointer to an initialized sync variable
+ */
+void lv_thread_sync_signal(lv_thread_sync_t * sync);
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_THREAD_H*/
@@ -17,6 +17,13 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_SIZE 8
+
+/*`heap_id` of the paused timers*/
+#define NOT_IN_HEAP 0xFFFFFFFF
+
+/*The deadlines are compared as signed differences so the periods are limited to ~24 days*/
+#define MAX_PERIOD 0x7FFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +32,30 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint32_t timer_deadline(const lv_timer_t * timer);
+static bool timer_before(const lv_timer_t * a, const lv_timer_t * b);
+static void heap_set(uint32_t id, lv_timer_t * timer);
+static void heap_sift_up(uint32_t id);
+static void heap_sift_down(uint32_t id);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void wakeup(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static bool handler_running;
+static uint32_t handler_run_id;
+static uint32_t timer_cnt;
+static uint32_t heap_cnt;   /*Number of running timers in `_lv_timer_heap`*/
+static uint32_t heap_size;  /*Number of timers which fit into `_lv_timer_heap`*/
+static lv_timer_wakeup_cb_t wakeup_cb;
+static void * wakeup_user_data;
 
 /**********************
  *      MACROS
@@ -55,6 +76,10 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_cnt = 0;
+    heap_cnt = 0;
+    heap_size = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -69,17 +94,15 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
     TIMER_TRACE("begin");
 
     /*Avoid concurrent running of the timer handler*/
-    static bool already_running = false;
-    if(already_running) {
+    if(handler_running) {
         TIMER_TRACE("already running, concurrent calls are not allow, returning");
         return 1;
     }
-    already_running = true;
 
     if(lv_timer_run == false) {
-        already_running = false; /*Release mutex*/
         return 1;
     }
+    handler_running = true;
 
     static uint32_t idle_period_start = 0;
     static uint32_t busy_time         = 0;
@@ -95,41 +118,19 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*Run the timers in the order of their deadline until the first one which is not ready.
+     *The timers can be created, deleted or changed by the callbacks as the heap is always up to date.
+     *A timer runs only once in a call even if it's ready again (e.g. period = 0).*/
+    handler_run_id++;
+    while(heap_cnt > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(timer->run_id == handler_run_id) break;
+        if(lv_timer_time_remaining(timer) != 0) break;
+        lv_timer_exec(timer);
     }
 
+    uint32_t time_till_next = lv_timer_get_time_till_next();
+
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -139,7 +140,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         idle_period_start = lv_tick_get();
     }
 
-    already_running = false; /*Release the mutex*/
+    handler_running = false;
 
     TIMER_TRACE("finished (%d ms until the next timer call)", time_till_next);
     return time_till_next;
@@ -166,6 +167,16 @@ lv_timer_t * lv_timer_create_basic(void)
  */
 lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * user_data)
 {
+    /*Be sure that all the timers fit into the heap so resuming a timer never allocates*/
+    if(heap_size <= timer_cnt) {
+        uint32_t new_size = heap_size ? heap_size * 2 : HEAP_MIN_SIZE;
+        lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return NULL;
+        LV_GC_ROOT(_lv_timer_heap) = new_heap;
+        heap_size = new_size;
+    }
+
     lv_timer_t * new_timer = NULL;
 
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
@@ -178,8 +189,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->run_id = handler_run_id - 1;
+    timer_cnt++;
 
-    timer_created = true;
+    heap_insert(new_timer);
+    wakeup(new_timer);
 
     return new_timer;
 }
@@ -200,8 +214,12 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    if(!timer->paused) heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    timer_cnt--;
+
+    /*Let `lv_timer_exec()` know that its timer was deleted by the callback*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -212,12 +230,19 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+    if(timer->paused) return;
+
+    heap_remove(timer);
     timer->paused = true;
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
+
     timer->paused = false;
+    heap_insert(timer);
+    wakeup(timer);
 }
 
 /**
@@ -228,6 +253,10 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    if(!timer->paused) {
+        heap_update(timer);
+        wakeup(timer);
+    }
 }
 
 /**
@@ -236,7 +265,11 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
  */
 void lv_timer_ready(lv_timer_t * timer)
 {
-    timer->last_run = lv_tick_get() - timer->period - 1;
+    timer->last_run = lv_tick_get() - LV_MIN(timer->period, MAX_PERIOD) - 1;
+    if(!timer->paused) {
+        heap_update(timer);
+        wakeup(timer);
+    }
 }
 
 /**
@@ -247,6 +280,9 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+
+    /*The stopped timers are deleted by the next `lv_timer_handler()` (but not in their own callback)*/
+    if(repeat_count == 0 && LV_GC_ROOT(_lv_timer_act) != timer) lv_timer_ready(timer);
 }
 
 /**
@@ -257,6 +293,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    if(!timer->paused) heap_update(timer);
 }
 
 /**
@@ -266,6 +303,7 @@ void lv_timer_reset(lv_timer_t * timer)
 void lv_timer_enable(bool en)
 {
     lv_timer_run = en;
+    if(en && wakeup_cb) wakeup_cb(wakeup_user_data);
 }
 
 /**
@@ -277,6 +315,31 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time until the next timer needs to run. Same as the return value of `lv_timer_handler()`.
+ * @return the time in ms, 0 if a timer is ready or `LV_NO_TIMER_READY` if no timer is running
+ */
+uint32_t lv_timer_get_time_till_next(void)
+{
+    if(heap_cnt == 0) return LV_NO_TIMER_READY;
+    return lv_timer_time_remaining(LV_GC_ROOT(_lv_timer_heap)[0]);
+}
+
+/**
+ * Set a callback to call when a timer might need to run earlier than `lv_timer_handler()` told last time.
+ * It happens when a timer is created, resumed (e.g. the refresh timer of a display on invalidation),
+ * made ready or gets a closer deadline outside of `lv_timer_handler()`.
+ * It lets the task of `lv_timer_handler()` sleep until the returned time and be woken up only if needed.
+ * @param cb the callback. It's called by the task which uses LVGL so it should only signal the task of
+ *           `lv_timer_handler()`. `NULL` to not use it.
+ * @param user_data custom parameter of `cb`
+ */
+void lv_timer_set_wakeup_cb(lv_timer_wakeup_cb_t cb, void * user_data)
+{
+    wakeup_cb = cb;
+    wakeup_user_data = user_data;
+}
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -293,37 +356,32 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
- * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
+ * Execute a ready timer and delete it if its repeat count is over
+ * @param timer pointer to lv_timer. It's the first in the heap.
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted by the callback `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->run_id = handler_run_id;
+    heap_sift_down(0);
+
+    LV_GC_ROOT(_lv_timer_act) = timer;
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself*/
+        LV_GC_ROOT(_lv_timer_act) = NULL;
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
-
-    return exec;
 }
 
 /**
@@ -333,9 +391,94 @@ static bool lv_timer_exec(lv_timer_t * timer)
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 {
-    /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
-    if(elp >= timer->period)
-        return 0;
-    return timer->period - elp;
+    int32_t remaining = (int32_t)(timer_deadline(timer) - lv_tick_get());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+static uint32_t timer_deadline(const lv_timer_t * timer)
+{
+    return timer->last_run + LV_MIN(timer->period, MAX_PERIOD);
+}
+
+/*Tell whether `a` needs to run before `b`*/
+static bool timer_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)(timer_deadline(a) - timer_deadline(b));
+    if(diff != 0) return diff < 0;
+
+    /*On the same deadline the timers which have already run in this call of the handler are the last*/
+    return a->run_id != handler_run_id && b->run_id == handler_run_id;
+}
+
+static void heap_set(uint32_t id, lv_timer_t * timer)
+{
+    LV_GC_ROOT(_lv_timer_heap)[id] = timer;
+    timer->heap_id = id;
+}
+
+static void heap_sift_up(uint32_t id)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[id];
+    while(id > 0) {
+        uint32_t parent = (id - 1) / 2;
+        if(!timer_before(timer, heap[parent])) break;
+        heap_set(id, heap[parent]);
+        id = parent;
+    }
+    heap_set(id, timer);
+}
+
+static void heap_sift_down(uint32_t id)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[id];
+    while(1) {
+        uint32_t child = id * 2 + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && timer_before(heap[child + 1], heap[child])) child++;
+        if(!timer_before(heap[child], timer)) break;
+        heap_set(id, heap[child]);
+        id = child;
+    }
+    heap_set(id, timer);
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    /*A long ago ready timer is the same as a just ready one but keeps the deadlines comparable*/
+    if(lv_timer_time_remaining(timer) == 0) timer->last_run = lv_tick_get() - LV_MIN(timer->period, MAX_PERIOD);
+
+    heap_set(heap_cnt, timer);
+    heap_cnt++;
+    heap_sift_up(timer->heap_id);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t id = timer->heap_id;
+    timer->heap_id = NOT_IN_HEAP;
+    heap_cnt--;
+    if(id == heap_cnt) return;
+
+    /*Move the last timer to the place of the removed one*/
+    heap_set(id, LV_GC_ROOT(_lv_timer_heap)[heap_cnt]);
+    heap_update(LV_GC_ROOT(_lv_timer_heap)[id]);
+}
+
+/*Move a timer to its place after its deadline has changed*/
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t id = timer->heap_id;
+    heap_sift_up(id);
+    if(timer->heap_id == id) heap_sift_down(id);
+}
+
+/*Tell the task of the handler that it might need to run earlier*/
+static void wakeup(lv_timer_t * timer)
+{
+    if(wakeup_cb == NULL || handler_running) return;
+
+    /*Only the first timer matters*/
+    if(timer->heap_id == 0) wakeup_cb(wakeup_user_data);
 }
@@ -38,7 +38,13 @@ struct _lv_timer_t;
 typedef void (*lv_timer_cb_t)(struct _lv_timer_t *);
 
 /**
- * Descriptor of a lv_timer
+ * Called when a timer might need to run earlier than `lv_timer_handler()` told last time.
+ */
+typedef void (*lv_timer_wakeup_cb_t)(void * user_data);
+
+/**
+ * Descriptor of a lv_timer.
+ * Change it only with the `lv_timer_...()` functions as the timers are ordered by `last_run + period`.
  */
 typedef struct _lv_timer_t {
     uint32_t period; /**< How often the timer should run*/
@@ -46,6 +52,8 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t heap_id; /**< Index in the heap of the running timers (internal)*/
+    uint32_t run_id; /**< ID of the `lv_timer_handler()` call which ran the timer last time (internal)*/
     uint32_t paused : 1;
 } lv_timer_t;
 
@@ -146,6 +154,23 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time until the next timer needs to run. Same as the return value of `lv_timer_handler()`.
+ * @return the time in ms, 0 if a timer is ready or `LV_NO_TIMER_READY` if no timer is running
+ */
+uint32_t lv_timer_get_time_till_next(void);
+
+/**
+ * Set a callback to call when a timer might need to run earlier than `lv_timer_handler()` told last time.
+ * It happens when a timer is created, resumed (e.g. the refresh timer of a display on invalidation),
+ * made ready or gets a closer deadline outside of `lv_timer_handler()`.
+ * It lets the task of `lv_timer_handler()` sleep until the returned time and be woken up only if needed.
+ * @param cb the callback. It's called by the task which uses LVGL so it should only signal the task of
+ *           `lv_timer_handler()`. `NULL` to not use it.
+ * @param user_data custom parameter of `cb`
+ */
+void lv_timer_set_wakeup_cb(lv_timer_wakeup_cb_t cb, void * user_data);
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -906,12 +906,9 @@ static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
     lv_obj_t * list_obj = dropdown->list;
-    lv_state_t state_ori = list_obj->state;
 
-    if(state != list_obj->state) {
-        list_obj->state = state;
-        list_obj->skip_trans = 1;
-    }
+    /*Don't change the list's state as an other render thread might draw it too*/
+    if(state != list_obj->state) _lv_obj_style_set_state_override(list_obj, state);
 
     /*Draw a rectangle under the selected item*/
     const lv_font_t * font    = lv_obj_get_style_text_font(list_obj, LV_PART_SELECTED);
@@ -934,8 +931,7 @@ static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t
     lv_obj_init_draw_rect_dsc(list_obj,  LV_PART_SELECTED, &sel_rect);
     lv_draw_rect(draw_ctx, &sel_rect, &rect_area);
 
-    list_obj->state = state_ori;
-    list_obj->skip_trans = 0;
+    _lv_obj_style_set_state_override(NULL, LV_STATE_DEFAULT);
 }
 
 static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state)
@@ -944,12 +940,8 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
     lv_obj_t * list_obj = dropdown->list;
-    lv_state_t state_orig = list_obj->state;
 
-    if(state != list_obj->state) {
-        list_obj->state =  state;
-        list_obj->skip_trans = 1;
-    }
+    if(state != list_obj->state) _lv_obj_style_set_state_override(list_obj, state);
 
     lv_draw_label_dsc_t label_dsc;
     lv_draw_label_dsc_init(&label_dsc);
@@ -959,7 +951,10 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
                                                             LV_PART_SELECTED);  /*Line space should come from the list*/
 
     lv_obj_t * label = get_label(dropdown_obj);
-    if(label == NULL) return;
+    if(label == NULL) {
+        _lv_obj_style_set_state_override(NULL, LV_STATE_DEFAULT);
+        return;
+    }
 
     lv_coord_t font_h        = lv_font_get_line_height(label_dsc.font);
 
@@ -980,8 +975,7 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
         lv_draw_label(draw_ctx, &label_dsc, &label->coords, lv_label_get_text(label), NULL);
         draw_ctx->clip_area = clip_area_ori;
     }
-    list_obj->state = state_orig;
-    list_obj->skip_trans = 0;
+    _lv_obj_style_set_state_override(NULL, LV_STATE_DEFAULT);
 }
 
 
@@ -378,6 +378,32 @@ lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj)
     return img->obj_size_mode;
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_img_invalidate_src_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+
+    /*The image is drawn from the top left corner of the content area if it's not transformed and not tiled*/
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    if(img->zoom != LV_IMG_ZOOM_NONE || img->angle != 0 || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN) != LV_IMG_ZOOM_NONE ||
+       lv_obj_get_style_transform_angle(obj, LV_PART_MAIN) != 0 ||
+       lv_area_get_width(&content) > img->w || lv_area_get_height(&content) > img->h) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t inv_area;
+    lv_area_copy(&inv_area, area);
+    lv_area_move(&inv_area, content.x1, content.y1);
+    lv_obj_invalidate_area(obj, &inv_area);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -567,7 +593,7 @@ static void draw_img(lv_event_t * e)
         int32_t zoom_final = lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN);
         zoom_final = (zoom_final * img->zoom) >> 8;
 
-        const lv_area_t * clip_area = lv_event_get_param(e);
+        const lv_area_t * clip_area = info->area;
         if(zoom_final == LV_IMG_ZOOM_NONE) {
             if(_lv_area_is_in(clip_area, &obj->coords, 0) == false) {
                 info->res = LV_COVER_RES_NOT_COVER;
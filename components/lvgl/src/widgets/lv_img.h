@@ -211,6 +211,18 @@ bool lv_img_get_antialias(lv_obj_t * obj);
  */
 lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj);
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Invalidate an area of the image source, e.g. if the pixels of an `lv_img_dsc_t` were changed.
+ * Only the area is redrawn if the image is drawn once and not transformed, else the whole object.
+ * @param obj       pointer to an image object
+ * @param area      the changed area relative to the top left corner of the image
+ */
+void lv_img_invalidate_src_area(lv_obj_t * obj, const lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
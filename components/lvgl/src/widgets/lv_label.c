@@ -17,6 +17,7 @@
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_txt_ap.h"
 #include "../misc/lv_printf.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -835,6 +836,10 @@ static void draw_main(lv_event_t * e)
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
 
+#if LV_USE_PARALLEL_RENDER
+    /*The hint is updated while drawing so the helper threads can't use it*/
+    if(lv_thread_is_worker()) hint = NULL;
+#endif
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
@@ -612,9 +612,8 @@ static void draw_main(lv_event_t * e)
     lv_coord_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
     lv_coord_t cell_bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_ITEMS);
 
-    lv_state_t state_ori = obj->state;
-    obj->state = LV_STATE_DEFAULT;
-    obj->skip_trans = 1;
+    /*Don't change the object's state as an other render thread might draw it too*/
+    _lv_obj_style_set_state_override(obj, LV_STATE_DEFAULT);
     lv_draw_rect_dsc_t rect_dsc_def;
     lv_draw_rect_dsc_t rect_dsc_act; /*Passed to the event to modify it*/
     lv_draw_rect_dsc_init(&rect_dsc_def);
@@ -624,8 +623,7 @@ static void draw_main(lv_event_t * e)
     lv_draw_label_dsc_t label_dsc_act;  /*Passed to the event to modify it*/
     lv_draw_label_dsc_init(&label_dsc_def);
     lv_obj_init_draw_label_dsc(obj, LV_PART_ITEMS, &label_dsc_def);
-    obj->state = state_ori;
-    obj->skip_trans = 0;
+    _lv_obj_style_set_state_override(NULL, LV_STATE_DEFAULT);
 
     uint16_t col;
     uint16_t row;
@@ -723,14 +721,12 @@ static void draw_main(lv_event_t * e)
             }
             /*In other cases get the styles directly without caching them*/
             else {
-                obj->state = cell_state;
-                obj->skip_trans = 1;
+                _lv_obj_style_set_state_override(obj, cell_state);
                 lv_draw_rect_dsc_init(&rect_dsc_act);
                 lv_draw_label_dsc_init(&label_dsc_act);
                 lv_obj_init_draw_rect_dsc(obj, LV_PART_ITEMS, &rect_dsc_act);
                 lv_obj_init_draw_label_dsc(obj, LV_PART_ITEMS, &label_dsc_act);
-                obj->state = state_ori;
-                obj->skip_trans = 0;
+                _lv_obj_style_set_state_override(NULL, LV_STATE_DEFAULT);
             }
 
             part_draw_dsc.draw_area = &cell_area_border;
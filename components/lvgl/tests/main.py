@@ -23,6 +23,12 @@ test_options = {
     'OPTIONS_TEST': 'Test config, 32 bit color depth',
 }
 
+# Executable tests which depend on the color format, so they are run with
+# these build-only configs too.
+build_only_tests = {
+    'OPTIONS_16BIT_SWAP': ['test_img_premult'],
+}
+
 
 def is_valid_option_name(option_name):
     return option_name in build_only_options or option_name in test_options
@@ -110,8 +116,10 @@ def build_tests(options_name, build_type, clean):
                            '--parallel', str(os.cpu_count())])
 
 
-def run_tests(options_name):
-    '''Run the tests for the given options name.'''
+def run_tests(options_name, test_names=None):
+    '''Run the tests for the given options name.
+
+    When test_names is given only those tests are run.'''
 
     print()
     print()
@@ -121,8 +129,10 @@ def run_tests(options_name):
     print('=' * len(label), flush=True)
 
     os.chdir(get_build_dir(options_name))
-    subprocess.check_call(
-        ['ctest', '--parallel', str(os.cpu_count()), '--output-on-failure'])
+    cmd = ['ctest', '--parallel', str(os.cpu_count()), '--output-on-failure']
+    if test_names:
+        cmd.extend(['-R', '^(%s)$' % '|'.join(test_names)])
+    subprocess.check_call(cmd)
 
 
 def generate_code_coverage_report():
@@ -197,11 +207,13 @@ if __name__ == "__main__":
         is_test = options_name in test_options
         build_type = 'Debug'
         build_tests(options_name, build_type, args.clean)
-        if is_test:
-            try:
+        try:
+            if is_test:
                 run_tests(options_name)
-            except subprocess.CalledProcessError as e:
-                sys.exit(e.returncode)
+            elif options_name in build_only_tests:
+                run_tests(options_name, build_only_tests[options_name])
+        except subprocess.CalledProcessError as e:
+            sys.exit(e.returncode)
 
     if args.report:
         generate_code_coverage_report()
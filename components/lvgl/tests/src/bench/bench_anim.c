@@ -0,0 +1,255 @@
+/**
+ * @file bench_anim.c
+ * Run 500 animations at once and measure the time of handling them in a frame.
+ * Every scenario prints one JSON line:
+ * {"bench":"anim","scenario":"objects","anims":500,"frames":200,"anim_ns_per_anim":45.6,"ms_per_anim_tick":0.023,
+ *  "ms_per_frame":1.234,"inv_per_frame":12.3,"batch_join_per_frame":45.6,"refr_px_per_frame":12345,
+ *  "refr_areas_per_frame":12.3}
+ *
+ * Scenarios:
+ * - "values": the animations set integers with all built-in paths. Only the animation engine is measured.
+ * - "objects": 100 small objects animated by 5 animations each (x, y, width, height, opacity)
+ *   on a 320x240 display. "ms_per_frame" includes the layout update and the rendering too.
+ *   "inv_per_frame": number of areas added to the display, in the animations and in the layout update too.
+ *   "batch_join_per_frame": number of invalidations joined with an other one of the same object in the animations.
+ *   "refr_areas_per_frame": number of areas redrawn after joining the invalidated areas.
+ *   It needs a larger `LV_MEM_SIZE` than 64 kB.
+ *
+ * The animations repeat forever with play back so all of them run in every frame.
+ *
+ * Usage: bench_anim [frames]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define ANIM_NUM        500
+#define OBJ_NUM         (ANIM_NUM / 5)
+
+/*Period of the animation timer*/
+#define FRAME_MS        16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf[BENCH_BUF_PX];
+static int32_t values[ANIM_NUM];
+static uint32_t inv_cnt;
+static bool oom;
+
+static const lv_anim_path_cb_t paths[] = {
+    lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out, lv_anim_path_ease_in_out,
+    lv_anim_path_overshoot, lv_anim_path_bounce
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+/*Count the invalidated areas*/
+static void rounder_cb(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(area);
+    inv_cnt++;
+}
+
+static lv_disp_t * create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.rounder_cb = rounder_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    lv_disp_t * disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+
+    /*Don't refresh by the timer, only when the benchmark says*/
+    lv_timer_pause(disp->refr_timer);
+    return disp;
+}
+
+static void value_exec_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+}
+
+static void x_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_x(var, v);
+}
+
+static void y_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_y(var, v);
+}
+
+static void width_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_width(var, v);
+}
+
+static void height_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_height(var, v);
+}
+
+static void opa_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_style_opa(var, v, 0);
+}
+
+static void anim_start(void * var, lv_anim_exec_xcb_t exec_cb, int32_t start, int32_t end, uint32_t i)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, start, end);
+    lv_anim_set_time(&a, 300 + (i * 37) % 700);
+    lv_anim_set_playback_time(&a, 300 + (i * 53) % 700);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_path_cb(&a, paths[i % (sizeof(paths) / sizeof(paths[0]))]);
+    lv_anim_start(&a);
+}
+
+static void create_values(void)
+{
+    uint32_t i;
+    for(i = 0; i < ANIM_NUM; i++) {
+        anim_start(&values[i], value_exec_cb, 0, 1000 + i, i);
+    }
+}
+
+static void create_objects(void)
+{
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+#if LV_MEM_CUSTOM == 0
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        if(mon.free_biggest_size < 2048) {
+            oom = true;
+            return;
+        }
+#endif
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(i % 19), 0);
+        lv_obj_set_size(obj, 10, 10);
+
+        int32_t x = (i * 29) % (BENCH_HOR_RES - 40);
+        int32_t y = (i * 17) % (BENCH_VER_RES - 40);
+        anim_start(obj, x_exec_cb, x, x + 20, i * 5);
+        anim_start(obj, y_exec_cb, y, y + 20, i * 5 + 1);
+        anim_start(obj, width_exec_cb, 10, 20, i * 5 + 2);
+        anim_start(obj, height_exec_cb, 10, 20, i * 5 + 3);
+        anim_start(obj, opa_exec_cb, LV_OPA_30, LV_OPA_COVER, i * 5 + 4);
+    }
+}
+
+static void bench(lv_disp_t * disp, const char * scenario, void (*create_cb)(void), uint32_t frames)
+{
+    oom = false;
+    create_cb();
+    if(oom) {
+        printf("{\"bench\":\"anim\",\"scenario\":\"%s\",\"skipped\":\"out of memory\"}\n", scenario);
+        lv_anim_del_all();
+        lv_obj_clean(lv_scr_act());
+        return;
+    }
+    _lv_disp_refr_timer(disp->refr_timer);
+
+    uint32_t anim_cnt = lv_anim_count_running();
+    lv_disp_inv_stats_t stats;
+    lv_refr_reset_inv_stats(disp);
+    inv_cnt = 0;
+
+    uint64_t t_anim = 0;
+    uint64_t t_frame = 0;
+    uint32_t i;
+    for(i = 0; i < frames; i++) {
+        lv_tick_inc(FRAME_MS);
+
+        uint64_t t_start = now_ns();
+        lv_anim_refr_now();
+        uint64_t t_refr = now_ns();
+        _lv_disp_refr_timer(disp->refr_timer);
+        uint64_t t_end = now_ns();
+
+        t_anim += t_refr - t_start;
+        t_frame += t_end - t_start;
+    }
+
+    lv_refr_get_inv_stats(disp, &stats);
+    printf("{\"bench\":\"anim\",\"scenario\":\"%s\",\"anims\":%u,\"frames\":%u,\"anim_ns_per_anim\":%.1f,"
+           "\"ms_per_anim_tick\":%.4f,\"ms_per_frame\":%.4f,\"inv_per_frame\":%.1f,\"batch_join_per_frame\":%.1f,"
+           "\"refr_px_per_frame\":%u,\"refr_areas_per_frame\":%.1f}\n",
+           scenario, anim_cnt, frames, (double)t_anim / frames / anim_cnt,
+           (double)t_anim / frames / 1000000, (double)t_frame / frames / 1000000,
+           (double)inv_cnt / frames, (double)stats.batch_join_cnt / frames,
+           (unsigned)(stats.refr_px / frames), (double)stats.refr_area_cnt / frames);
+
+    lv_anim_del_all();
+    lv_obj_clean(lv_scr_act());
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    if(frames == 0) frames = 1;
+
+    lv_init();
+    lv_disp_t * disp = create_disp();
+
+    bench(disp, "values", create_values, frames);
+    bench(disp, "objects", create_objects, frames);
+
+    lv_deinit();
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file bench_animimg.c
+ * Compare the 18 frames of `SPACE_1` ... `SPACE_18` as `lv_img_dsc_t`s and as a delta compressed sequence (`space_anim`).
+ * Every format prints one JSON line:
+ * {"bench":"animimg","format":"delta","flash_bytes":75931,"decode_us":45.2,"frame_us":512.3,"redraw_px":14160}
+ *
+ * The formats:
+ * - "img_dsc": `lv_animimg_set_src()` with an `lv_img_dsc_t` for every frame
+ * - "delta":   `lv_animimg_set_delta_src()` with `space_anim` created by `scripts/animimg_delta_conv.py`
+ *
+ * "flash_bytes" is the size of the pixels (and of the frame table of "delta").
+ * "decode_us" is the average time of decoding a frame into the frame buffer.
+ * "frame_us" is the average time of changing to the next frame and redrawing the screen.
+ * "redraw_px" is the average number of invalidated pixels per frame.
+ *
+ * Usage: bench_animimg [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_ANIMIMG
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define FRAME_CNT       18
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    FORMAT_IMG_DSC,
+    FORMAT_DELTA,
+    _FORMAT_NUM
+} format_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(SPACE_1)
+LV_IMG_DECLARE(SPACE_2)
+LV_IMG_DECLARE(SPACE_3)
+LV_IMG_DECLARE(SPACE_4)
+LV_IMG_DECLARE(SPACE_5)
+LV_IMG_DECLARE(SPACE_6)
+LV_IMG_DECLARE(SPACE_7)
+LV_IMG_DECLARE(SPACE_8)
+LV_IMG_DECLARE(SPACE_9)
+LV_IMG_DECLARE(SPACE_10)
+LV_IMG_DECLARE(SPACE_11)
+LV_IMG_DECLARE(SPACE_12)
+LV_IMG_DECLARE(SPACE_13)
+LV_IMG_DECLARE(SPACE_14)
+LV_IMG_DECLARE(SPACE_15)
+LV_IMG_DECLARE(SPACE_16)
+LV_IMG_DECLARE(SPACE_17)
+LV_IMG_DECLARE(SPACE_18)
+
+extern const lv_animimg_delta_dsc_t space_anim;
+
+static const lv_img_dsc_t * frames[FRAME_CNT] = {
+    &SPACE_1, &SPACE_2, &SPACE_3, &SPACE_4, &SPACE_5, &SPACE_6, &SPACE_7, &SPACE_8, &SPACE_9,
+    &SPACE_10, &SPACE_11, &SPACE_12, &SPACE_13, &SPACE_14, &SPACE_15, &SPACE_16, &SPACE_17, &SPACE_18,
+};
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+
+static const char * format_names[_FORMAT_NUM] = {"img_dsc", "delta"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*Return the average time of decoding a frame in ns*/
+static double decode_run(uint32_t iterations)
+{
+    uint8_t * frame_buf = malloc(SPACE_1.data_size);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations * FRAME_CNT; i++) {
+        lv_animimg_delta_decode(&space_anim, i % FRAME_CNT, frame_buf);
+    }
+    t = now_ns() - t;
+
+    free(frame_buf);
+    return (double)t / (iterations * FRAME_CNT);
+}
+
+/*Return the average time of showing the next frame and redrawing the screen in ns*/
+static double frame_run(lv_obj_t * animimg, uint32_t iterations, uint32_t * redraw_px)
+{
+    lv_animimg_t * a = (lv_animimg_t *)animimg;
+    lv_refr_now(disp);
+    lv_refr_reset_inv_stats(disp);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations * FRAME_CNT; i++) {
+        /*As the animation would do it*/
+        a->anim.exec_cb(animimg, (i + 1) % FRAME_CNT);
+        lv_refr_now(disp);
+    }
+    t = now_ns() - t;
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(disp, &stats);
+    *redraw_px = stats.inv_px / (iterations * FRAME_CNT);
+    return (double)t / (iterations * FRAME_CNT);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    uint32_t f;
+    for(f = 0; f < _FORMAT_NUM; f++) {
+        lv_obj_t * animimg = lv_animimg_create(lv_scr_act());
+        lv_obj_center(animimg);
+
+        uint32_t flash_bytes = 0;
+        double decode_ns = 0;
+        if(f == FORMAT_IMG_DSC) {
+            lv_animimg_set_src(animimg, (lv_img_dsc_t **)frames, FRAME_CNT);
+            uint32_t i;
+            for(i = 0; i < FRAME_CNT; i++) flash_bytes += frames[i]->data_size;
+        }
+        else {
+            lv_animimg_set_delta_src(animimg, &space_anim);
+            flash_bytes = space_anim.data_size + space_anim.frame_cnt * sizeof(lv_animimg_delta_frame_t);
+            decode_ns = decode_run(iterations);
+        }
+
+        uint32_t redraw_px;
+        double frame_ns = frame_run(animimg, iterations, &redraw_px);
+
+        printf("{\"bench\":\"animimg\",\"format\":\"%s\",\"flash_bytes\":%u,\"decode_us\":%.1f,\"frame_us\":%.1f,"
+               "\"redraw_px\":%u}\n",
+               format_names[f], (unsigned)flash_bytes, decode_ns / 1000.0, frame_ns / 1000.0, (unsigned)redraw_px);
+
+        lv_obj_del(animimg);
+    }
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"animimg\",\"skipped\":\"LV_USE_ANIMIMG is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_ANIMIMG*/
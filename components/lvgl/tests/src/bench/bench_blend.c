@@ -0,0 +1,207 @@
+/**
+ * @file bench_blend.c
+ * Compare the line blending functions of the normal blend mode (`lv_draw_sw_blend_kernels_t`).
+ * Every kernel set blends the same draw buffer in every case and prints one JSON line:
+ * {"bench":"blend","depth":16,"swap":1,"case":"map_mask","kernels":"swar","mpx_per_s":123.4,"speedup":2.10,
+ *  "exact":true}
+ *
+ * "speedup" is relative to the "basic" kernels which mix the pixels one by one with `lv_color_mix()`.
+ * "exact" tells if the result is the same as with the "basic" kernels.
+ *
+ * The cases:
+ * - "opaque":      fill with a mask which is fully covering or transparent in long runs (e.g. the inner part of a shape)
+ * - "fill_opa":    semi-transparent fill without mask
+ * - "fill_mask":   anti-aliased fill (a circle mask)
+ * - "map_opa":     image with opacity
+ * - "map_mask":    image with alpha channel (the alpha channel is the mask)
+ *
+ * Usage: bench_blend [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if LV_DRAW_SW_BLEND_KERNELS
+
+/*********************
+ *      DEFINES
+ *********************/
+/*A draw buffer of the application: 320 x 40 pixels*/
+#define BENCH_W     320
+#define BENCH_H     40
+#define BENCH_PX    (BENCH_W * BENCH_H)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    CASE_OPAQUE,
+    CASE_FILL_OPA,
+    CASE_FILL_MASK,
+    CASE_MAP_OPA,
+    CASE_MAP_MASK,
+    _CASE_NUM
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t dest_ori[BENCH_PX];
+static lv_color_t dest[BENCH_PX];
+static lv_color_t dest_ref[BENCH_PX];
+static lv_color_t src[BENCH_PX];
+static lv_opa_t mask_circle[BENCH_PX];
+static lv_opa_t mask_runs[BENCH_PX];
+
+static const char * case_names[_CASE_NUM] = {"opaque", "fill_opa", "fill_mask", "map_opa", "map_mask"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*A background with flat areas (where the last mixed color can be reused) and an image-like part*/
+static void init_data(void)
+{
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < BENCH_H; y++) {
+        for(x = 0; x < BENCH_W; x++) {
+            uint32_t i = y * BENCH_W + x;
+            if(x < BENCH_W / 2) dest_ori[i] = x < BENCH_W / 4 ? lv_color_hex(0x202830) : lv_color_hex(0xe0e0e0);
+            else dest_ori[i] = lv_color_make(lv_rand(0, 255), lv_rand(0, 255), lv_rand(0, 255));
+
+            src[i] = lv_color_make((x * 255) / BENCH_W, lv_rand(0, 255), (y * 255) / BENCH_H);
+
+            /*Anti-aliased edge of a circle centered below the buffer*/
+            int32_t dx = x - BENCH_W / 2;
+            int32_t dy = y - BENCH_H * 4;
+            lv_sqrt_res_t r;
+            lv_sqrt(dx * dx + dy * dy, &r, 0x800);
+            int32_t d = r.i - BENCH_H * 4 + BENCH_H / 2;
+            mask_circle[i] = d <= -4 ? LV_OPA_COVER : (d >= 4 ? LV_OPA_TRANSP : (lv_opa_t)((4 - d) * 255 / 8));
+
+            mask_runs[i] = (x / 64) % 2 ? LV_OPA_COVER : LV_OPA_TRANSP;
+        }
+    }
+}
+
+static void blend(const lv_draw_sw_blend_kernels_t * kernels, bench_case_t c)
+{
+    lv_color_t color = lv_color_hex(0x3080c0);
+    int32_t y;
+    for(y = 0; y < BENCH_H; y++) {
+        lv_color_t * d = &dest[y * BENCH_W];
+        const lv_color_t * s = &src[y * BENCH_W];
+        switch(c) {
+            case CASE_OPAQUE:
+                kernels->fill_mask(d, BENCH_W, color, &mask_runs[y * BENCH_W], LV_OPA_COVER);
+                break;
+            case CASE_FILL_OPA:
+                kernels->fill_opa(d, BENCH_W, color, LV_OPA_60);
+                break;
+            case CASE_FILL_MASK:
+                kernels->fill_mask(d, BENCH_W, color, &mask_circle[y * BENCH_W], LV_OPA_COVER);
+                break;
+            case CASE_MAP_OPA:
+                kernels->map_opa(d, s, BENCH_W, LV_OPA_60);
+                break;
+            case CASE_MAP_MASK:
+                kernels->map_mask(d, s, BENCH_W, &mask_circle[y * BENCH_W], LV_OPA_COVER);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/*Return the time of blending the buffer once in ns*/
+static double run(const lv_draw_sw_blend_kernels_t * kernels, bench_case_t c, uint32_t iterations)
+{
+    uint64_t ns = 0;
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_memcpy(dest, dest_ori, sizeof(dest));
+        uint64_t t = now_ns();
+        blend(kernels, c);
+        ns += now_ns() - t;
+    }
+    return (double)ns / iterations;
+}
+
+static void bench(const lv_draw_sw_blend_kernels_t * kernels, bench_case_t c, uint32_t iterations)
+{
+    double basic_ns = run(&lv_draw_sw_blend_kernels_basic, c, iterations);
+    lv_memcpy(dest_ref, dest, sizeof(dest));
+
+    double ns = run(kernels, c, iterations);
+    bool exact = memcmp(dest_ref, dest, sizeof(dest)) == 0;
+
+    printf("{\"bench\":\"blend\",\"depth\":%d,\"swap\":%d,\"case\":\"%s\",\"kernels\":\"%s\",\"mpx_per_s\":%.1f,"
+           "\"speedup\":%.2f,\"exact\":%s}\n",
+           LV_COLOR_DEPTH, LV_COLOR_16_SWAP, case_names[c], kernels->name, BENCH_PX * 1000.0 / ns, basic_ns / ns,
+           exact ? "true" : "false");
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    init_data();
+
+    const lv_draw_sw_blend_kernels_t * kernels[] = {
+        &lv_draw_sw_blend_kernels_basic,
+        &lv_draw_sw_blend_kernels_swar,
+#if LV_DRAW_SW_BLEND_SIMD
+        &lv_draw_sw_blend_kernels_simd,
+#endif
+    };
+
+    bool exact = true;
+    uint32_t c;
+    for(c = 0; c < _CASE_NUM; c++) {
+        uint32_t k;
+        for(k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+            bench(kernels[k], c, iterations);
+            exact = exact && memcmp(dest_ref, dest, sizeof(dest)) == 0;
+        }
+    }
+
+    return exact ? 0 : 1;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"blend\",\"skipped\":\"the blend kernels are used only with 16 and 32 bit colors\"}\n");
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_BLEND_KERNELS*/
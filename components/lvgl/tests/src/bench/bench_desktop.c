@@ -0,0 +1,393 @@
+/**
+ * @file bench_desktop.c
+ * Render the weather desktop of `main/main.c` without a display and measure the cost of the typical updates.
+ * Every scenario prints one JSON line:
+ * {"bench":"desktop","scenario":"clock_tick","frames":100,"fps":1234.5,"ms_per_frame":0.810,"px_per_frame":7680,
+ *  "px_per_s":9480960,"flushes_per_frame":1.0,"prims":{"rect":{"calls":200,"us":120.5},...,"other":{"us":300.2}}}
+ *
+ * The time of the draw primitives is inclusive, e.g. an image drawn as a rectangle's background is counted in "rect" too.
+ * "other" is the frame time not spent in the primitives (layout, invalidation, flushing, GIF decoding, etc).
+ *
+ * The "gif_frame" scenario runs only if `LV_USE_GIF` is enabled, e.g. with the `OPTIONS_16BIT_SWAP` build
+ * which also has the color format of the application.
+ *
+ * Usage: bench_desktop [frames]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Same resolution and draw buffers as the application: 2 buffers of 40 lines*/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+/*Larger than the delay of any GIF frame to step exactly one frame in every iteration*/
+#define GIF_STEP_MS     1000
+
+#define SCROLL_STEP     10
+
+#if LV_FONT_MONTSERRAT_16
+    #define FONT_SMALL  &lv_font_montserrat_16
+#else
+    #define FONT_SMALL  LV_FONT_DEFAULT
+#endif
+
+#if LV_FONT_MONTSERRAT_20
+    #define FONT_SYMBOL &lv_font_montserrat_20
+#else
+    #define FONT_SYMBOL LV_FONT_DEFAULT
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    PRIM_RECT,
+    PRIM_BG,
+    PRIM_LETTER,
+    PRIM_IMG,
+    PRIM_IMG_DECODED,
+    PRIM_LINE,
+    PRIM_ARC,
+    PRIM_POLYGON,
+    _PRIM_NUM
+} prim_t;
+
+typedef struct {
+    uint32_t calls;
+    uint64_t ns;
+} prim_stat_t;
+
+typedef void (*scenario_cb_t)(uint32_t i);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void frame_clock_tick(uint32_t i);
+#if LV_USE_GIF
+static void frame_gif(uint32_t i);
+#endif
+static void frame_full_redraw(uint32_t i);
+static void frame_scroll(uint32_t i);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_HOR_RES * BENCH_VER_RES];
+static lv_color_t buf1[BENCH_BUF_PX];
+static lv_color_t buf2[BENCH_BUF_PX];
+
+static lv_disp_t * disp;
+static lv_obj_t * time_label;
+
+static prim_stat_t prim_stats[_PRIM_NUM];
+static const char * prim_names[_PRIM_NUM] = {"rect", "bg", "letter", "img", "img_decoded", "line", "arc", "polygon"};
+
+/*The original draw functions of the software renderer*/
+static lv_draw_ctx_t ori;
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void prim_add(prim_t prim, uint64_t t_start)
+{
+    prim_stats[prim].calls++;
+    prim_stats[prim].ns += now_ns() - t_start;
+}
+
+static void draw_rect_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    uint64_t t = now_ns();
+    ori.draw_rect(draw_ctx, dsc, coords);
+    prim_add(PRIM_RECT, t);
+}
+
+static void draw_bg_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    uint64_t t = now_ns();
+    ori.draw_bg(draw_ctx, dsc, coords);
+    prim_add(PRIM_BG, t);
+}
+
+static void draw_letter_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                             uint32_t letter)
+{
+    uint64_t t = now_ns();
+    ori.draw_letter(draw_ctx, dsc, pos_p, letter);
+    prim_add(PRIM_LETTER, t);
+}
+
+static lv_res_t draw_img_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                              const void * src)
+{
+    uint64_t t = now_ns();
+    lv_res_t res = ori.draw_img(draw_ctx, dsc, coords, src);
+    prim_add(PRIM_IMG, t);
+    return res;
+}
+
+static void draw_img_decoded_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                                  const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    uint64_t t = now_ns();
+    ori.draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+    prim_add(PRIM_IMG_DECODED, t);
+}
+
+static void draw_line_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                           const lv_point_t * point2)
+{
+    uint64_t t = now_ns();
+    ori.draw_line(draw_ctx, dsc, point1, point2);
+    prim_add(PRIM_LINE, t);
+}
+
+static void draw_arc_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                          uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    uint64_t t = now_ns();
+    ori.draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+    prim_add(PRIM_ARC, t);
+}
+
+static void draw_polygon_wrap(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                              uint16_t point_cnt)
+{
+    uint64_t t = now_ns();
+    ori.draw_polygon(draw_ctx, dsc, points, point_cnt);
+    prim_add(PRIM_POLYGON, t);
+}
+
+/*Replace only the functions which are set to keep the fallbacks of `lv_draw_...()` working*/
+static void wrap_draw_ctx(lv_draw_ctx_t * draw_ctx)
+{
+    ori = *draw_ctx;
+    if(draw_ctx->draw_rect) draw_ctx->draw_rect = draw_rect_wrap;
+    if(draw_ctx->draw_bg) draw_ctx->draw_bg = draw_bg_wrap;
+    if(draw_ctx->draw_letter) draw_ctx->draw_letter = draw_letter_wrap;
+    if(draw_ctx->draw_img) draw_ctx->draw_img = draw_img_wrap;
+    if(draw_ctx->draw_img_decoded) draw_ctx->draw_img_decoded = draw_img_decoded_wrap;
+    if(draw_ctx->draw_line) draw_ctx->draw_line = draw_line_wrap;
+    if(draw_ctx->draw_arc) draw_ctx->draw_arc = draw_arc_wrap;
+    if(draw_ctx->draw_polygon) draw_ctx->draw_polygon = draw_polygon_wrap;
+}
+
+/*Copy to a frame buffer to have a realistic memory traffic*/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+
+    wrap_draw_ctx(drv.draw_ctx);
+}
+
+/*The same objects and styles as `create_demo_application()` in `main/main.c`*/
+static void create_desktop(void)
+{
+    LV_FONT_DECLARE(SEG_Font_60);
+    LV_FONT_DECLARE(city_30);
+    LV_IMG_DECLARE(sunny);
+
+    lv_obj_t * scr = lv_scr_act();
+
+#if LV_USE_GIF
+    LV_IMG_DECLARE(hit);
+    lv_obj_t * gif = lv_gif_create(scr);
+    lv_gif_set_src(gif, &hit);
+    lv_obj_align(gif, LV_ALIGN_BOTTOM_LEFT, 3, -8);
+#endif
+
+    static lv_point_t line_points[4][2] = {
+        {{5, 20}, {235, 20}},
+        {{65, 20}, {65, 100}},
+        {{5, 100}, {235, 100}},
+        {{5, 180}, {235, 180}},
+    };
+    static lv_style_t line_style;
+    lv_style_init(&line_style);
+    lv_style_set_line_width(&line_style, 1);
+    lv_style_set_line_color(&line_style, lv_color_black());
+    lv_style_set_line_rounded(&line_style, true);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * line = lv_line_create(scr);
+        lv_line_set_points(line, line_points[i], 2);
+        lv_obj_add_style(line, &line_style, 0);
+    }
+
+    lv_obj_t * weather_img = lv_img_create(scr);
+    lv_img_set_src(weather_img, &sunny);
+    lv_obj_align(weather_img, LV_ALIGN_TOP_MID, -20, 30);
+
+    lv_obj_t * temp_range_label = lv_label_create(scr);
+    lv_obj_align(temp_range_label, LV_ALIGN_TOP_MID, -16, 75);
+    lv_label_set_recolor(temp_range_label, true);
+    lv_obj_set_style_text_font(temp_range_label, FONT_SMALL, 0);
+    lv_label_set_text(temp_range_label, "#111111 10~20°C#");
+
+    lv_obj_t * symbol_home = lv_label_create(scr);
+    lv_obj_set_pos(symbol_home, 5, 45);
+    lv_label_set_recolor(symbol_home, true);
+    lv_obj_set_style_text_font(symbol_home, FONT_SYMBOL, 0);
+    lv_label_set_text(symbol_home, "#000000 "LV_SYMBOL_HOME"#");
+
+    lv_obj_t * city_label = lv_label_create(scr);
+    lv_obj_align_to(city_label, symbol_home, LV_ALIGN_OUT_RIGHT_TOP, 2, -20);
+    lv_label_set_recolor(city_label, true);
+    lv_obj_set_style_text_font(city_label, &city_30, 0);
+    lv_label_set_text(city_label, "#0000ff 佛#\n#0000ff 山#");
+
+    lv_obj_t * date_label = lv_label_create(scr);
+    lv_obj_align(date_label, LV_ALIGN_TOP_MID, 0, 1);
+    lv_obj_set_style_text_font(date_label, FONT_SMALL, 0);
+    lv_obj_set_style_text_color(date_label, lv_color_black(), 0);
+    lv_label_set_text(date_label, "2021-12-24");
+
+    time_label = lv_label_create(scr);
+    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, 20);
+    lv_obj_set_style_text_font(time_label, &SEG_Font_60, 0);
+    lv_obj_set_style_text_color(time_label, lv_color_make(255, 0, 0), 0);
+    lv_label_set_text(time_label, "12:34");
+}
+
+/*The colon of the clock blinks every 500 ms*/
+static void frame_clock_tick(uint32_t i)
+{
+    lv_label_set_text(time_label, i & 1 ? "12:34" : "12 34");
+    lv_refr_now(disp);
+}
+
+#if LV_USE_GIF
+/*Step the time with `lv_tick_inc` as the tick interrupt does and let the GIF's timer show the next frame*/
+static void frame_gif(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_tick_inc(GIF_STEP_MS);
+    lv_timer_handler();
+    lv_refr_now(disp);
+}
+#endif
+
+static void frame_full_redraw(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+}
+
+/*Scroll the screen up and down to move every object*/
+static void frame_scroll(uint32_t i)
+{
+    lv_obj_scroll_by(lv_scr_act(), 0, i & 1 ? SCROLL_STEP : -SCROLL_STEP, LV_ANIM_OFF);
+    lv_refr_now(disp);
+}
+
+static void bench(const char * name, scenario_cb_t frame_cb, uint32_t frames)
+{
+    /*Warm up the caches and get a stable state*/
+    frame_cb(0);
+    frame_cb(1);
+
+    lv_memset_00(prim_stats, sizeof(prim_stats));
+    lv_refr_reset_inv_stats(disp);
+    lv_refr_reset_flush_stats(disp);
+    lv_mem_reset_max_used();
+
+    uint64_t t_start = now_ns();
+    uint32_t i;
+    for(i = 0; i < frames; i++) frame_cb(i);
+    uint64_t t = now_ns() - t_start;
+
+    lv_disp_inv_stats_t inv_stats;
+    lv_refr_get_inv_stats(disp, &inv_stats);
+    lv_disp_flush_stats_t flush_stats;
+    lv_refr_get_flush_stats(disp, &flush_stats);
+    lv_mem_buf_monitor_t buf_mon;
+    lv_mem_buf_monitor(&buf_mon);
+
+    double t_s = (double)t / 1e9;
+    printf("{\"bench\":\"desktop\",\"scenario\":\"%s\",\"frames\":%u,\"fps\":%.1f,\"ms_per_frame\":%.3f,"
+           "\"px_per_frame\":%u,\"px_per_s\":%.0f,\"flushes_per_frame\":%.1f,\"mem_buf\":{\"max_used\":%u,\"overflow_cnt\":%u},\"prims\":{",
+           name, (unsigned)frames, frames / t_s, t_s * 1000.0 / frames,
+           (unsigned)(inv_stats.refr_px / frames), inv_stats.refr_px / t_s,
+           (double)flush_stats.flush_cnt / frames,
+           (unsigned)buf_mon.max_used, (unsigned)buf_mon.overflow_cnt);
+
+    uint64_t prim_ns = 0;
+    uint32_t p;
+    for(p = 0; p < _PRIM_NUM; p++) {
+        printf("\"%s\":{\"calls\":%u,\"us\":%.1f},", prim_names[p], (unsigned)prim_stats[p].calls,
+               (double)prim_stats[p].ns / 1000.0);
+        prim_ns += prim_stats[p].ns;
+    }
+    /*The primitives can be nested so it's only an estimation*/
+    uint64_t other_ns = t > prim_ns ? t - prim_ns : 0;
+    printf("\"other\":{\"us\":%.1f}}}\n", (double)other_ns / 1000.0);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    if(frames == 0) frames = 1;
+
+    lv_init();
+
+#if LV_USE_PARALLEL_RENDER
+    /*The counters of the draw functions are not thread safe*/
+    lv_refr_set_parallel_render(false);
+#endif
+
+    create_disp();
+    create_desktop();
+
+    bench("clock_tick", frame_clock_tick, frames);
+#if LV_USE_GIF
+    bench("gif_frame", frame_gif, frames);
+#endif
+    bench("full_redraw", frame_full_redraw, frames);
+    bench("scroll", frame_scroll, frames);
+
+    return 0;
+}
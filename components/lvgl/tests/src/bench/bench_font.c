@@ -0,0 +1,228 @@
+/**
+ * @file bench_font.c
+ * Measure and draw CJK strings with the large sparse fonts and compare the ways of finding the glyphs.
+ * Every font, case and lookup method prints one JSON line:
+ * {"bench":"font","font":"city_30","case":"measure","lookup":"cache","us":35.2,"speedup":2.10}
+ *
+ * The lookup methods:
+ * - "none":    binary search in the whole `unicode_list` of the character maps without any cache
+ * - "index":   binary search only in the bucket of the letter with the `unicode_list_index` of the font
+ * - "cache":   the font as it's built: `unicode_list_index` and the glyph ID cache (`LV_FONT_GLYPH_ID_CACHE_SIZE`)
+ *
+ * "speedup" is relative to "none".
+ *
+ * The cases:
+ * - "measure": `lv_txt_get_size()` of a string of 200 random CJK letters of the font with line breaks at 320 px
+ * - "draw":    redraw a 320x240 screen with a label showing the same string (only its visible lines are drawn)
+ *
+ * Usage: bench_font [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define CMAP_MAX        8
+#define TEXT_GLYPHS     200
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    LOOKUP_NONE,
+    LOOKUP_INDEX,
+    LOOKUP_CACHE,
+    _LOOKUP_NUM
+} lookup_t;
+
+typedef enum {
+    CASE_MEASURE,
+    CASE_DRAW,
+    _CASE_NUM
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+static lv_obj_t * label;
+
+/*A copy of the font with the lookup method under test*/
+static lv_font_fmt_txt_cmap_t bench_cmaps[CMAP_MAX];
+static lv_font_fmt_txt_dsc_t bench_dsc;
+static lv_font_t bench_font;
+
+static char text[TEXT_GLYPHS * 4 + 1];
+static uint32_t letters[1024];
+
+static const char * lookup_names[_LOOKUP_NUM] = {"none", "index", "cache"};
+static const char * case_names[_CASE_NUM] = {"measure", "draw"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, BENCH_HOR_RES);
+}
+
+static const lv_font_t * bench_font_create(const lv_font_t * font, lookup_t lookup)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num && i < CMAP_MAX; i++) {
+        bench_cmaps[i] = dsc->cmaps[i];
+        if(lookup == LOOKUP_NONE) bench_cmaps[i].unicode_list_index = NULL;
+    }
+
+    bench_dsc = *dsc;
+    bench_dsc.cmaps = bench_cmaps;
+    if(lookup != LOOKUP_CACHE) bench_dsc.cache = NULL;
+    else lv_memset_00(bench_dsc.cache, sizeof(lv_font_fmt_txt_glyph_cache_t));
+
+    bench_font = *font;
+    bench_font.dsc = &bench_dsc;
+    return &bench_font;
+}
+
+/*Random CJK letters (from U+4E00) of the font as UTF-8*/
+static void text_create(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    uint32_t letter_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        if(cmap->unicode_list == NULL) continue;
+
+        uint32_t j;
+        for(j = 0; j < cmap->list_length && letter_cnt < sizeof(letters) / sizeof(letters[0]); j++) {
+            uint32_t letter = cmap->range_start + cmap->unicode_list[j];
+            if(letter >= 0x4E00 && letter <= 0xFFFF) letters[letter_cnt++] = letter;
+        }
+    }
+
+    uint32_t len = 0;
+    for(i = 0; i < TEXT_GLYPHS && letter_cnt; i++) {
+        uint32_t letter = letters[lv_rand(0, letter_cnt - 1)];
+        text[len++] = 0xE0 | (letter >> 12);
+        text[len++] = 0x80 | ((letter >> 6) & 0x3F);
+        text[len++] = 0x80 | (letter & 0x3F);
+    }
+    text[len] = '\0';
+}
+
+/*Return the time of one iteration in ns*/
+static double run(const lv_font_t * font, bench_case_t c, uint32_t iterations)
+{
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text_static(label, c == CASE_DRAW ? text : "");
+    lv_refr_now(disp);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        if(c == CASE_MEASURE) {
+            lv_point_t size;
+            lv_txt_get_size(&size, text, font, 0, 0, BENCH_HOR_RES, LV_TEXT_FLAG_NONE);
+        }
+        else {
+            lv_obj_invalidate(lv_scr_act());
+            lv_refr_now(disp);
+        }
+    }
+    return (double)(now_ns() - t) / iterations;
+}
+
+static void bench(const char * font_name, const lv_font_t * font, uint32_t iterations)
+{
+    text_create(font);
+
+    uint32_t c;
+    for(c = 0; c < _CASE_NUM; c++) {
+        double none_ns = 0;
+        uint32_t l;
+        for(l = 0; l < _LOOKUP_NUM; l++) {
+            double ns = run(bench_font_create(font, l), c, iterations);
+            if(l == LOOKUP_NONE) none_ns = ns;
+
+            printf("{\"bench\":\"font\",\"font\":\"%s\",\"case\":\"%s\",\"lookup\":\"%s\",\"us\":%.1f,"
+                   "\"speedup\":%.2f}\n",
+                   font_name, case_names[c], lookup_names[l], ns / 1000.0, none_ns / ns);
+        }
+    }
+
+    /*Don't keep a pointer to the copy of the font*/
+    lv_obj_set_style_text_font(label, LV_FONT_DEFAULT, 0);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    LV_FONT_DECLARE(city_30);
+
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    bench("city_30", &city_30, iterations);
+#if LV_FONT_SIMSUN_16_CJK
+    bench("simsun_16_cjk", &lv_font_simsun_16_cjk, iterations);
+#endif
+
+    return 0;
+}
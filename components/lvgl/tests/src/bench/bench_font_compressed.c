@@ -0,0 +1,281 @@
+/**
+ * @file bench_font_compressed.c
+ * Compare the draw speed and the bitmap size of a compressed font and the same font without compression.
+ * Every bitmap format prints one JSON line:
+ * {"bench":"font_compressed","font":"montserrat_28_compressed","format":"compressed_cache","bitmap_bytes":23456,
+ *  "us":1234.5,"slowdown":1.05,"hit_ratio":0.98}
+ *
+ * The formats:
+ * - "plain":               the glyphs decompressed into a plain font in RAM, as `lv_font_conv --no-compress` would create
+ * - "compressed":          the compressed font without the bitmap cache (decompressed every time they are drawn)
+ * - "compressed_cache":    the compressed font with the bitmap cache of `LV_FONT_BITMAP_CACHE_SIZE` bytes
+ *
+ * "bitmap_bytes" is the size of the bitmaps in flash. It's an estimation with the compressed format
+ * (the size of the last glyph is not known so its decompressed size is used).
+ * "us" is the time of redrawing a 320x240 screen with a label of text. "slowdown" is relative to "plain".
+ *
+ * Usage: bench_font_compressed [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define GLYPH_MAX       1024
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    FORMAT_PLAIN,
+    FORMAT_COMPRESSED,
+    FORMAT_COMPRESSED_CACHE,
+    _FORMAT_NUM
+} format_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+static lv_obj_t * label;
+
+/*The plain copy of the font*/
+static lv_font_fmt_txt_glyph_dsc_t plain_glyph_dsc[GLYPH_MAX];
+static lv_font_fmt_txt_dsc_t plain_dsc;
+static lv_font_t plain_font;
+
+static const char * format_names[_FORMAT_NUM] = {"plain", "compressed", "compressed_cache"};
+
+static const char * text =
+    "The quick brown fox jumps over the lazy dog. 0123456789 "
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. "
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.";
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, BENCH_HOR_RES);
+    lv_label_set_text_static(label, text);
+}
+
+/*Size of a decompressed bitmap. 3 bpp is stored as 4 bpp*/
+static uint32_t bitmap_size(const lv_font_fmt_txt_dsc_t * dsc, uint32_t gid)
+{
+    uint32_t bpp = dsc->bpp == 3 ? 4 : dsc->bpp;
+    return (dsc->glyph_dsc[gid].box_w * dsc->glyph_dsc[gid].box_h * bpp + 7) / 8;
+}
+
+/*Call `cb` with every letter and its glyph ID*/
+static void glyphs_iterate(const lv_font_fmt_txt_dsc_t * dsc, void (*cb)(uint32_t letter, uint32_t gid))
+{
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        const uint8_t * ofs_8 = cmap->glyph_id_ofs_list;
+        const uint16_t * ofs_16 = cmap->glyph_id_ofs_list;
+        uint32_t j;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                for(j = 0; j < cmap->range_length; j++) cb(cmap->range_start + j, cmap->glyph_id_start + j);
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+                for(j = 0; j < cmap->range_length; j++) cb(cmap->range_start + j, cmap->glyph_id_start + ofs_8[j]);
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                for(j = 0; j < cmap->list_length; j++) cb(cmap->range_start + cmap->unicode_list[j], cmap->glyph_id_start + j);
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+                for(j = 0; j < cmap->list_length; j++) {
+                    cb(cmap->range_start + cmap->unicode_list[j], cmap->glyph_id_start + ofs_16[j]);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static const lv_font_t * src_font;
+static uint8_t * plain_bitmaps;
+static uint32_t plain_size;
+static uint32_t glyph_cnt;
+static uint32_t last_bitmap_index;
+static uint32_t last_gid;
+
+static void glyph_measure_cb(uint32_t letter, uint32_t gid)
+{
+    LV_UNUSED(letter);
+    const lv_font_fmt_txt_dsc_t * dsc = src_font->dsc;
+    if(gid >= GLYPH_MAX) return;
+    if(gid + 1 > glyph_cnt) glyph_cnt = gid + 1;
+    if(dsc->glyph_dsc[gid].bitmap_index >= last_bitmap_index) {
+        last_bitmap_index = dsc->glyph_dsc[gid].bitmap_index;
+        last_gid = gid;
+    }
+}
+
+static void glyph_copy_cb(uint32_t letter, uint32_t gid)
+{
+    if(gid >= GLYPH_MAX) return;
+    uint32_t size = bitmap_size(src_font->dsc, gid);
+    const uint8_t * bitmap = size ? lv_font_get_glyph_bitmap(src_font, letter) : NULL;
+    plain_glyph_dsc[gid].bitmap_index = plain_size;
+    if(bitmap) lv_memcpy(&plain_bitmaps[plain_size], bitmap, size);
+    plain_size += size;
+}
+
+/*Decompress every glyph into a plain font. Return the estimated size of the compressed bitmaps*/
+static uint32_t plain_font_create(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    src_font = font;
+    glyph_cnt = 0;
+    last_bitmap_index = 0;
+    last_gid = 0;
+    glyphs_iterate(dsc, glyph_measure_cb);
+
+    uint32_t i;
+    uint32_t total = 0;
+    for(i = 0; i < glyph_cnt; i++) {
+        plain_glyph_dsc[i] = dsc->glyph_dsc[i];
+        total += bitmap_size(dsc, i);
+    }
+    plain_bitmaps = malloc(total);
+    plain_size = 0;
+
+    lv_font_fmt_txt_set_bitmap_cache_size(0);
+    glyphs_iterate(dsc, glyph_copy_cb);
+    lv_font_fmt_txt_set_bitmap_cache_size(LV_FONT_BITMAP_CACHE_SIZE);
+
+    plain_dsc = *dsc;
+    plain_dsc.glyph_bitmap = plain_bitmaps;
+    plain_dsc.glyph_dsc = plain_glyph_dsc;
+    plain_dsc.bitmap_format = LV_FONT_FMT_TXT_PLAIN;
+    plain_font = *font;
+    plain_font.dsc = &plain_dsc;
+
+    return last_bitmap_index + bitmap_size(dsc, last_gid);
+}
+
+/*Return the time of one redraw in ns*/
+static double run(const lv_font_t * font, uint32_t iterations)
+{
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    lv_font_fmt_txt_reset_bitmap_cache_stats();
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+    }
+    return (double)(now_ns() - t) / iterations;
+}
+
+static void bench(const char * font_name, const lv_font_t * font, uint32_t iterations)
+{
+    uint32_t compressed_size = plain_font_create(font);
+
+    double plain_ns = 0;
+    uint32_t f;
+    for(f = 0; f < _FORMAT_NUM; f++) {
+        lv_font_fmt_txt_set_bitmap_cache_size(f == FORMAT_COMPRESSED ? 0 : LV_FONT_BITMAP_CACHE_SIZE);
+        double ns = run(f == FORMAT_PLAIN ? &plain_font : font, iterations);
+        if(f == FORMAT_PLAIN) plain_ns = ns;
+
+        lv_font_fmt_txt_bitmap_cache_stats_t stats;
+        lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+        uint32_t lookups = stats.hit_cnt + stats.miss_cnt;
+
+        printf("{\"bench\":\"font_compressed\",\"font\":\"%s\",\"format\":\"%s\",\"bitmap_bytes\":%u,\"us\":%.1f,"
+               "\"slowdown\":%.2f,\"hit_ratio\":%.2f}\n",
+               font_name, format_names[f], (unsigned)(f == FORMAT_PLAIN ? plain_size : compressed_size), ns / 1000.0,
+               ns / plain_ns, lookups ? (double)stats.hit_cnt / lookups : 0.0);
+    }
+
+    lv_obj_set_style_text_font(label, LV_FONT_DEFAULT, 0);
+    free(plain_bitmaps);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    bench("montserrat_28_compressed", &lv_font_montserrat_28_compressed, iterations);
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"font_compressed\",\"skipped\":\"LV_USE_FONT_COMPRESSED and LV_FONT_MONTSERRAT_28_COMPRESSED "
+           "are required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED*/
@@ -0,0 +1,278 @@
+/**
+ * @file bench_gif.c
+ * Compare playing the `hit` GIF of the desktop the old way and with the current GIF decoder.
+ * Every GIF and mode prints one JSON line:
+ * {"bench":"gif","gif":"hit","mode":"fast","render_us":12.3,"frame_us":45.6,"redraw_px":884,"speedup":2.10}
+ *
+ * The modes:
+ * - "basic":   the frame is drawn on an ARGB canvas with `lv_color_make()` on every pixel
+ *              and the whole image is invalidated (as `lv_gif` worked before)
+ * - "fast":    `lv_gif` with the palette converted once per frame, opaque canvas for GIFs without transparency,
+ *              and only the changed area invalidated
+ *
+ * The GIFs:
+ * - "hit":         `hit` (has transparent pixels)
+ * - "hit_opaque":  `hit` with the transparency flag of the frames cleared
+ *
+ * "render_us" is the average time of decoding the next frame and drawing it on the canvas.
+ * "frame_us" is the same plus redrawing the screen. "speedup" compares "frame_us" to "basic".
+ * "redraw_px" is the average number of invalidated pixels per frame.
+ *
+ * Usage: bench_gif [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_GIF
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    MODE_BASIC,
+    MODE_FAST,
+    _MODE_NUM
+} gif_mode_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(hit)
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+
+static uint8_t hit_opaque_map[16 * 1024];
+static lv_img_dsc_t hit_opaque;
+
+/*The ARGB canvas of "basic"*/
+static uint8_t * basic_canvas;
+static lv_img_dsc_t basic_dsc;
+
+static const char * mode_names[_MODE_NUM] = {"basic", "fast"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+static void hit_opaque_create(void)
+{
+    lv_memcpy(hit_opaque_map, hit.data, hit.data_size);
+
+    /*Clear the transparency flag of the graphic control extensions*/
+    uint32_t i;
+    for(i = 0; i + 3 < hit.data_size; i++) {
+        if(hit_opaque_map[i] == 0x21 && hit_opaque_map[i + 1] == 0xF9 && hit_opaque_map[i + 2] == 0x04) {
+            hit_opaque_map[i + 3] &= ~0x01;
+        }
+    }
+
+    hit_opaque = hit;
+    hit_opaque.data = hit_opaque_map;
+}
+
+/*Draw the frame on the ARGB canvas as `render_frame_rect()` did before*/
+static void basic_render(gd_GIF * gif)
+{
+    uint32_t i = gif->fy * gif->width + gif->fx;
+    int j, k;
+    for(j = 0; j < gif->fh; j++) {
+        for(k = 0; k < gif->fw; k++) {
+            uint8_t index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
+            uint8_t * color = &gif->palette->colors[index * 3];
+            if(!gif->gce.transparency || index != gif->gce.tindex) {
+                lv_color_t c = lv_color_make(color[0], color[1], color[2]);
+                uint8_t * px = &basic_canvas[(i + k) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+                lv_memcpy(px, &c, LV_COLOR_SIZE / 8);
+                px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = 0xff;
+            }
+        }
+        i += gif->width;
+    }
+}
+
+static void basic_next_frame(lv_obj_t * img, gd_GIF * gif)
+{
+    if(gd_get_frame(gif) == 0) {
+        gd_rewind(gif);
+        gd_get_frame(gif);
+    }
+    basic_render(gif);
+
+    if(img) {
+        lv_img_cache_invalidate_src(&basic_dsc);
+        lv_obj_invalidate(img);
+    }
+}
+
+static void fast_next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    lv_tick_inc(gifobj->gif->gce.delay * 10);
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+/*Return the average time of decoding and drawing a frame on the canvas in ns*/
+static double render_run(gif_mode_t mode, const lv_img_dsc_t * src, uint32_t iterations)
+{
+    gd_GIF * gif = gd_open_gif_data(src->data);
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        if(mode == MODE_BASIC) {
+            basic_next_frame(NULL, gif);
+        }
+        else {
+            if(gd_get_frame(gif) == 0) {
+                gd_rewind(gif);
+                gd_get_frame(gif);
+            }
+            gd_render_frame(gif, gif->canvas);
+        }
+    }
+    t = now_ns() - t;
+    gd_close_gif(gif);
+    return (double)t / iterations;
+}
+
+/*Return the average time of showing the next frame and redrawing the screen in ns*/
+static double frame_run(gif_mode_t mode, const lv_img_dsc_t * src, uint32_t iterations, uint32_t * redraw_px)
+{
+    lv_obj_t * obj;
+    gd_GIF * gif = NULL;
+    if(mode == MODE_BASIC) {
+        gif = gd_open_gif_data(src->data);
+        basic_dsc.header.always_zero = 0;
+        basic_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        basic_dsc.header.w = gif->width;
+        basic_dsc.header.h = gif->height;
+        basic_dsc.data_size = gif->width * gif->height * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        basic_dsc.data = basic_canvas;
+        obj = lv_img_create(lv_scr_act());
+        lv_img_set_src(obj, &basic_dsc);
+    }
+    else {
+        obj = lv_gif_create(lv_scr_act());
+        lv_gif_set_src(obj, src);
+    }
+    /*At the bottom left corner as on the desktop*/
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_LEFT, 10, -10);
+
+    lv_refr_now(disp);
+    lv_refr_reset_inv_stats(disp);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        if(mode == MODE_BASIC) basic_next_frame(obj, gif);
+        else fast_next_frame(obj);
+        lv_refr_now(disp);
+    }
+    t = now_ns() - t;
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(disp, &stats);
+    *redraw_px = stats.inv_px / iterations;
+
+    lv_obj_del(obj);
+    if(gif) gd_close_gif(gif);
+    return (double)t / iterations;
+}
+
+static void bench(const char * name, const lv_img_dsc_t * src, uint32_t iterations)
+{
+    double basic_ns = 0;
+    uint32_t m;
+    for(m = 0; m < _MODE_NUM; m++) {
+        double render_ns = render_run(m, src, iterations);
+        uint32_t redraw_px;
+        double frame_ns = frame_run(m, src, iterations, &redraw_px);
+        if(m == MODE_BASIC) basic_ns = frame_ns;
+
+        printf("{\"bench\":\"gif\",\"gif\":\"%s\",\"mode\":\"%s\",\"render_us\":%.2f,\"frame_us\":%.2f,"
+               "\"redraw_px\":%u,\"speedup\":%.2f}\n",
+               name, mode_names[m], render_ns / 1000.0, frame_ns / 1000.0, (unsigned)redraw_px, basic_ns / frame_ns);
+    }
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+    hit_opaque_create();
+    basic_canvas = calloc(1, 256 * 256 * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    bench("hit", &hit, iterations);
+    bench("hit_opaque", &hit_opaque, iterations);
+
+    free(basic_canvas);
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"gif\",\"skipped\":\"LV_USE_GIF is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_GIF*/
@@ -0,0 +1,137 @@
+/**
+ * @file bench_gif_decode.c
+ * Measure the LZW decoding of GIF frames (`gd_get_frame()`) on a corpus of GIFs.
+ * Every GIF prints one JSON line:
+ * {"bench":"gif_decode","gif":"noise_8bit","bytes":123456,"frames":4,"frame_us":1234.5,"mpx_per_s":25.3}
+ *
+ * The corpus:
+ * - "hit":                 the GIF of the desktop (50x50)
+ * - "bulb":                the GIF of the examples (60x80)
+ * - "noise_8bit":          320x240 random pixels with 256 colors (the code table is cleared often)
+ * - "noise_8bit_no_clear": the same but the full code table is used until the end of the frame
+ * - "runs_4bit":           320x240 runs of 16 colors (long strings)
+ * - "runs_2bit_interlaced":320x240 interlaced runs of 4 colors with local color tables
+ *
+ * "bytes" is the size of the GIF (0 if it's not known).
+ * "frame_us" is the average time of decoding a frame. "mpx_per_s" is the decoded frame area in megapixels per second.
+ * The canvas is not drawn. The synthetic GIFs need about 400 kB of LVGL's heap (e.g. `OPTIONS_TEST`).
+ *
+ * Usage: bench_gif_decode [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include "../lv_test_gif.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_GIF
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    lv_test_gif_dsc_t dsc;
+} synthetic_gif_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(hit)
+LV_IMG_DECLARE(img_bulb_gif)
+
+static const synthetic_gif_t synthetic[] = {
+    {"noise_8bit", {.w = 320, .h = 240, .frame_cnt = 4, .min_code_size = 8, .noise = true, .seed = 1}},
+    {"noise_8bit_no_clear", {.w = 320, .h = 240, .frame_cnt = 4, .min_code_size = 8, .noise = true, .no_clear = true, .seed = 2}},
+    {"runs_4bit", {.w = 320, .h = 240, .frame_cnt = 8, .min_code_size = 4, .seed = 3}},
+    {"runs_2bit_interlaced", {.w = 320, .h = 240, .frame_cnt = 8, .min_code_size = 2, .interlace = true, .lct = true, .seed = 4}},
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void bench(const char * name, const void * data, uint32_t size, uint32_t iterations)
+{
+    gd_GIF * gif = gd_open_gif_data(data);
+    if(gif == NULL) {
+        printf("{\"bench\":\"gif_decode\",\"gif\":\"%s\",\"error\":\"can't open\"}\n", name);
+        return;
+    }
+
+    uint32_t frame_cnt = 0;
+    uint64_t px_cnt = 0;
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        gd_rewind(gif);
+        while(gd_get_frame(gif) == 1) {
+            frame_cnt++;
+            px_cnt += (uint32_t)gif->fw * gif->fh;
+        }
+    }
+    t = now_ns() - t;
+    gd_close_gif(gif);
+
+    printf("{\"bench\":\"gif_decode\",\"gif\":\"%s\",\"bytes\":%u,\"frames\":%u,\"frame_us\":%.1f,\"mpx_per_s\":%.1f}\n",
+           name, (unsigned)size, (unsigned)(frame_cnt / iterations), (double)t / frame_cnt / 1000.0,
+           (double)px_cnt * 1000.0 / t);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+
+    bench("hit", hit.data, hit.data_size, iterations * 10);
+    bench("bulb", img_bulb_gif.data, 0, iterations);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(synthetic) / sizeof(synthetic[0]); i++) {
+        uint32_t size;
+        uint8_t * data = lv_test_gif_create(&synthetic[i].dsc, &size);
+        bench(synthetic[i].name, data, size, iterations);
+        free(data);
+    }
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"gif_decode\",\"skipped\":\"LV_USE_GIF is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_GIF*/
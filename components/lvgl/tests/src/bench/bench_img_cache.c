@@ -0,0 +1,311 @@
+/**
+ * @file bench_img_cache.c
+ * Compare the old image cache (linear search, `life` aging of every entry, entry count limit) with the current one
+ * (hash lookup, LRU with `time_to_open` priority, byte budget) on a mix of large slow images and small icons.
+ * Every mode prints one JSON line:
+ * {"bench":"img_cache","mode":"lru_bytes","entries":128,"budget_kb":572,"hit_ns":55.1,"miss_ns":390.2,"hit_ratio":0.923,
+ *  "decode_ms":54278,"avg_kb":528,"peak_kb":680}
+ *
+ * The modes:
+ * - "linear":      the old cache with 32 and 128 entries
+ * - "lru":         the current cache with the same number of entries and no byte budget
+ * - "lru_bytes":   the current cache with 128 entries and a byte budget of the memory used by "linear" with 32 entries
+ *                  on average
+ *
+ * The images are opened by a decoder which only reports their decoded size and time to open.
+ * There are 8 screens with a background (150 kB, 30 ms) and 12 icons (2 kB, 2 ms) each and 4 icons shared by every screen.
+ * Every frame opens the images of a screen. After 5 frames an other screen is shown, the first screens more often.
+ * "hit_ns" and "miss_ns" are the average time of opening an image through the cache when it's cached
+ * and when it's not (without the decoding which would take milliseconds).
+ * "decode_ms" is the sum of the reported time to open of the misses: the time the decoding would take.
+ * "avg_kb" and "peak_kb" are the average and the most memory used by the decoded cached images.
+ *
+ * Usage: bench_img_cache [frames]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SCREEN_CNT      8
+#define SCREEN_ICON_CNT 12      /*Icons of a screen besides the shared ones*/
+#define SHARED_ICON_CNT 4       /*Icons on every screen (e.g. status bar)*/
+#define IMG_CNT         (SCREEN_CNT * (1 + SCREEN_ICON_CNT) + SHARED_ICON_CNT)
+#define BG_SIZE         (150 * 1024)
+#define ICON_SIZE       (2 * 1024)
+#define FRAMES_ON_SCREEN    5
+
+/*As the old cache*/
+#define LINEAR_AGING        1
+#define LINEAR_LIFE_GAIN    1
+#define LINEAR_LIFE_LIMIT   1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    MODE_LINEAR,
+    MODE_LRU,
+    MODE_LRU_BYTES,
+    _MODE_NUM
+} cache_mode_t;
+
+typedef struct {
+    uint32_t decoded_size;
+    uint32_t time_to_open;
+} bench_img_t;
+
+typedef struct {
+    lv_img_decoder_dsc_t dec_dsc;
+    int32_t life;
+} linear_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static bench_img_t imgs[IMG_CNT];
+static lv_img_dsc_t srcs[IMG_CNT];
+static uint16_t * sequence;
+
+static linear_entry_t * linear_cache;
+static uint32_t linear_cnt;
+static uint32_t decoded_mem;
+static uint32_t decoded_mem_peak;
+static uint32_t decode_ms;
+
+static const char * mode_names[_MODE_NUM] = {"linear", "lru", "lru_bytes"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return LV_RES_INV;
+    const lv_img_dsc_t * img = src;
+    if(img->header.cf != LV_IMG_CF_RAW) return LV_RES_INV;
+
+    *header = img->header;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    const bench_img_t * img = (const bench_img_t *)((const lv_img_dsc_t *)dsc->src)->data;
+    dsc->img_data = (const uint8_t *)img;
+    dsc->decoded_size = img->decoded_size;
+    dsc->time_to_open = img->time_to_open;
+
+    decode_ms += img->time_to_open;
+    decoded_mem += img->decoded_size;
+    if(decoded_mem > decoded_mem_peak) decoded_mem_peak = decoded_mem;
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    decoded_mem -= dsc->decoded_size;
+}
+
+/*`_lv_img_cache_open()` as it worked before*/
+static linear_entry_t * linear_open(const void * src, lv_color_t color, int32_t frame_id, bool * hit)
+{
+    linear_entry_t * cache = linear_cache;
+    uint32_t i;
+    for(i = 0; i < linear_cnt; i++) {
+        if(cache[i].life > INT32_MIN + LINEAR_AGING) cache[i].life -= LINEAR_AGING;
+    }
+
+    for(i = 0; i < linear_cnt; i++) {
+        if(color.full == cache[i].dec_dsc.color.full && frame_id == cache[i].dec_dsc.frame_id &&
+           src == cache[i].dec_dsc.src) {
+            linear_entry_t * cached_src = &cache[i];
+            cached_src->life += cached_src->dec_dsc.time_to_open * LINEAR_LIFE_GAIN;
+            if(cached_src->life > LINEAR_LIFE_LIMIT) cached_src->life = LINEAR_LIFE_LIMIT;
+            *hit = true;
+            return cached_src;
+        }
+    }
+
+    *hit = false;
+    linear_entry_t * cached_src = &cache[0];
+    for(i = 1; i < linear_cnt; i++) {
+        if(cache[i].life < cached_src->life) cached_src = &cache[i];
+    }
+
+    if(cached_src->dec_dsc.src) lv_img_decoder_close(&cached_src->dec_dsc);
+    lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
+    cached_src->life = 0;
+    return cached_src;
+}
+
+static void linear_clean(void)
+{
+    uint32_t i;
+    for(i = 0; i < linear_cnt; i++) {
+        if(linear_cache[i].dec_dsc.src) lv_img_decoder_close(&linear_cache[i].dec_dsc);
+    }
+    free(linear_cache);
+}
+
+/*Create the images and the order of opening them. Return the number of opens.*/
+static uint32_t imgs_create(uint32_t frames)
+{
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        /*The first image of every screen is the background*/
+        bool bg = i < SCREEN_CNT * (1 + SCREEN_ICON_CNT) && i % (1 + SCREEN_ICON_CNT) == 0;
+        imgs[i].decoded_size = bg ? BG_SIZE : ICON_SIZE;
+        imgs[i].time_to_open = bg ? 30 : 2;
+        srcs[i].header.cf = LV_IMG_CF_RAW;
+        srcs[i].header.w = 1;
+        srcs[i].header.h = 1;
+        srcs[i].data = (const uint8_t *)&imgs[i];
+        srcs[i].data_size = sizeof(bench_img_t);
+    }
+
+    uint32_t opens = 0;
+    sequence = malloc(frames * (1 + SCREEN_ICON_CNT + SHARED_ICON_CNT) * sizeof(uint16_t));
+    uint32_t seed = 1;
+    uint32_t screen = 0;
+    uint32_t f;
+    for(f = 0; f < frames; f++) {
+        /*Skewed to the first screens*/
+        if(f % FRAMES_ON_SCREEN == 0) {
+            seed = seed * 1103515245 + 12345;
+            uint32_t r = (seed >> 16) & 0x7FFF;
+            screen = (r * r / 0x8000) * SCREEN_CNT / 0x8000;
+        }
+
+        for(i = 0; i < 1 + SCREEN_ICON_CNT; i++) sequence[opens++] = screen * (1 + SCREEN_ICON_CNT) + i;
+        for(i = 0; i < SHARED_ICON_CNT; i++) sequence[opens++] = SCREEN_CNT * (1 + SCREEN_ICON_CNT) + i;
+    }
+
+    return opens;
+}
+
+/*Return the average memory of the decoded cached images*/
+static uint32_t bench(cache_mode_t mode, uint32_t entries, uint32_t budget, uint32_t opens)
+{
+    if(mode == MODE_LINEAR) {
+        linear_cnt = entries;
+        linear_cache = calloc(entries, sizeof(linear_entry_t));
+    }
+    else {
+        lv_img_cache_set_mem_size(budget);
+        lv_img_cache_set_size(entries);
+    }
+
+    decode_ms = 0;
+    decoded_mem_peak = 0;
+    uint64_t mem_sum = 0;
+    uint32_t hit_cnt = 0;
+    uint64_t hit_ns = 0;
+    uint64_t miss_ns = 0;
+    uint32_t i;
+    for(i = 0; i < opens; i++) {
+        const void * src = &srcs[sequence[i]];
+        bool hit;
+        uint64_t t = now_ns();
+        if(mode == MODE_LINEAR) {
+            linear_open(src, lv_color_black(), 0, &hit);
+        }
+        else {
+            uint32_t decode_ms_prev = decode_ms;
+            _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, lv_color_black(), 0);
+            _lv_img_cache_cleanup(entry);
+            hit = decode_ms == decode_ms_prev;
+        }
+        t = now_ns() - t;
+        if(hit) {
+            hit_cnt++;
+            hit_ns += t;
+        }
+        else {
+            miss_ns += t;
+        }
+        mem_sum += decoded_mem;
+    }
+
+    if(mode == MODE_LINEAR) {
+        linear_clean();
+    }
+    else {
+        lv_img_cache_invalidate_src(NULL);
+        lv_img_cache_reset_stats();
+    }
+
+    printf("{\"bench\":\"img_cache\",\"mode\":\"%s\",\"entries\":%u,\"budget_kb\":%u,\"hit_ns\":%.1f,"
+           "\"miss_ns\":%.1f,\"hit_ratio\":%.3f,\"decode_ms\":%u,\"avg_kb\":%u,\"peak_kb\":%u}\n",
+           mode_names[mode], (unsigned)entries, (unsigned)(mode == MODE_LRU_BYTES ? budget / 1024 : 0),
+           hit_cnt ? (double)hit_ns / hit_cnt : 0.0, hit_cnt < opens ? (double)miss_ns / (opens - hit_cnt) : 0.0,
+           (double)hit_cnt / opens, (unsigned)decode_ms,
+           (unsigned)(mem_sum / opens / 1024), (unsigned)(decoded_mem_peak / 1024));
+
+    return (uint32_t)(mem_sum / opens);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 10000;
+    if(frames == 0) frames = 1;
+
+    lv_init();
+
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoder_info);
+    lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_close_cb(dec, decoder_close);
+
+    uint32_t opens = imgs_create(frames);
+
+    uint32_t budget = bench(MODE_LINEAR, 32, 0, opens);
+    bench(MODE_LRU, 32, 0, opens);
+    bench(MODE_LINEAR, 128, 0, opens);
+    bench(MODE_LRU, 128, 0, opens);
+    bench(MODE_LRU_BYTES, 128, budget, opens);
+
+    free(sequence);
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"img_cache\",\"skipped\":\"LV_IMG_CACHE_DEF_SIZE > 0 is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_IMG_CACHE_DEF_SIZE*/
@@ -0,0 +1,214 @@
+/**
+ * @file bench_img_compress.c
+ * Compare the weather icons (`sunny`, `cloud`, `cloudd`, `rain`) as `LV_IMG_CF_TRUE_COLOR_ALPHA`
+ * and compressed to `LV_IMG_CF_TRUE_COLOR_ALPHA_RLE/LZ4` the same way as `scripts/img_compress_conv.py` does.
+ * Every image, format and cache setting prints one JSON line, every format a total:
+ * {"bench":"img_compress","img":"sunny","cf":"lz4","decompress":"lines","cache":1,"flash_bytes":2216,"ratio":0.439,
+ *  "decompress_us":10.5,"draw_us":30.2,"slowdown":1.25}
+ *
+ * "decompress" is "full" with `LV_IMG_DECOMPRESS_FULL` and "lines" without it.
+ * "cache" tells if the image cache was enabled (only with `LV_IMG_CACHE_DEF_SIZE > 0`).
+ * "flash_bytes" is the size of the pixels for the current color depth, "ratio" is relative to the raw image.
+ * "decompress_us" is the time of opening the image and reading all its lines with the decoder.
+ * "draw_us" is the average time of redrawing the image (invalidating it and refreshing the screen)
+ * and "slowdown" is relative to the raw image with the same cache setting.
+ * Use a build with `LV_COLOR_DEPTH 16` and `LV_COLOR_16_SWAP 1` (e.g. `OPTIONS_16BIT_SWAP`) to have the same
+ * color format as the application.
+ *
+ * Usage: bench_img_compress [iterations] [lines per block]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include "../lv_test_img.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define IMG_CNT         4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    FORMAT_RAW,
+    FORMAT_RLE,
+    FORMAT_LZ4,
+    _FORMAT_NUM
+} format_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(sunny)
+LV_IMG_DECLARE(cloud)
+LV_IMG_DECLARE(cloudd)
+LV_IMG_DECLARE(rain)
+
+static const lv_img_dsc_t * imgs[IMG_CNT] = {&sunny, &cloud, &cloudd, &rain};
+static const char * img_names[IMG_CNT] = {"sunny", "cloud", "cloudd", "rain"};
+static const char * format_names[_FORMAT_NUM] = {"raw", "rle", "lz4"};
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*Return the average time of opening the image and reading all its lines in ns*/
+static double decompress_run(const lv_img_dsc_t * img, uint32_t iterations)
+{
+    uint8_t * line = malloc(img->header.w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_img_decoder_dsc_t dsc;
+        lv_img_decoder_open(&dsc, img, lv_color_black(), 0);
+        if(dsc.img_data == NULL) {
+            lv_coord_t y;
+            for(y = 0; y < img->header.h; y++) lv_img_decoder_read_line(&dsc, 0, y, img->header.w, line);
+        }
+        lv_img_decoder_close(&dsc);
+    }
+    t = now_ns() - t;
+
+    free(line);
+    return (double)t / iterations;
+}
+
+/*Return the average time of redrawing the image in ns*/
+static double draw_run(const lv_img_dsc_t * img, uint32_t iterations)
+{
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_img_set_src(obj, img);
+    lv_obj_center(obj);
+    lv_refr_now(disp);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(disp);
+    }
+    t = now_ns() - t;
+
+    lv_obj_del(obj);
+    return (double)t / iterations;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+    uint32_t lines = argc > 2 ? (uint32_t)atoi(argv[2]) : 8;
+    if(lines == 0) lines = 1;
+
+    lv_init();
+    create_disp();
+
+    lv_img_dsc_t * compressed[IMG_CNT][_FORMAT_NUM];
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        compressed[i][FORMAT_RAW] = NULL;
+        compressed[i][FORMAT_RLE] = lv_test_img_compress(imgs[i], LV_IMG_CF_TRUE_COLOR_ALPHA_RLE, lines);
+        compressed[i][FORMAT_LZ4] = lv_test_img_compress(imgs[i], LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, lines);
+    }
+
+    const char * decompress = LV_IMG_DECOMPRESS_FULL ? "full" : "lines";
+    uint32_t cache_cnt = LV_IMG_CACHE_DEF_SIZE ? 2 : 1;
+    uint32_t cache;
+    for(cache = 0; cache < cache_cnt; cache++) {
+#if LV_IMG_CACHE_DEF_SIZE
+        lv_img_cache_set_size(cache ? LV_IMG_CACHE_DEF_SIZE : 0);
+#endif
+        uint32_t flash_total[_FORMAT_NUM] = {0};
+        double draw_total[_FORMAT_NUM] = {0};
+        for(i = 0; i < IMG_CNT; i++) {
+            double raw_draw_ns = 0;
+            uint32_t f;
+            for(f = 0; f < _FORMAT_NUM; f++) {
+                const lv_img_dsc_t * img = f == FORMAT_RAW ? imgs[i] : compressed[i][f];
+                double decompress_ns = f == FORMAT_RAW ? 0 : decompress_run(img, iterations);
+                double draw_ns = draw_run(img, iterations);
+                if(f == FORMAT_RAW) raw_draw_ns = draw_ns;
+                flash_total[f] += img->data_size;
+                draw_total[f] += draw_ns;
+
+                printf("{\"bench\":\"img_compress\",\"img\":\"%s\",\"cf\":\"%s\",\"decompress\":\"%s\",\"cache\":%u,"
+                       "\"flash_bytes\":%u,\"ratio\":%.3f,\"decompress_us\":%.1f,\"draw_us\":%.1f,\"slowdown\":%.2f}\n",
+                       img_names[i], format_names[f], decompress, (unsigned)cache, (unsigned)img->data_size,
+                       (double)img->data_size / imgs[i]->data_size, decompress_ns / 1000.0, draw_ns / 1000.0,
+                       draw_ns / raw_draw_ns);
+            }
+        }
+
+        uint32_t f;
+        for(f = 0; f < _FORMAT_NUM; f++) {
+            printf("{\"bench\":\"img_compress\",\"img\":\"all\",\"cf\":\"%s\",\"decompress\":\"%s\",\"cache\":%u,"
+                   "\"flash_bytes\":%u,\"ratio\":%.3f,\"draw_us\":%.1f,\"slowdown\":%.2f}\n",
+                   format_names[f], decompress, (unsigned)cache, (unsigned)flash_total[f],
+                   (double)flash_total[f] / flash_total[FORMAT_RAW], draw_total[f] / 1000.0,
+                   draw_total[f] / draw_total[FORMAT_RAW]);
+        }
+    }
+
+    for(i = 0; i < IMG_CNT; i++) {
+        lv_test_img_free(compressed[i][FORMAT_RLE]);
+        lv_test_img_free(compressed[i][FORMAT_LZ4]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file bench_img_premult.c
+ * Compare drawing the images of the application as `LV_IMG_CF_TRUE_COLOR_ALPHA` and pre-multiplied
+ * to `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT` (the same way as `scripts/img_premult_conv.py` does).
+ * The animation frames (`SPACE_1` ... `SPACE_18`) and the weather icons (`sunny`, `cloud`, `cloudd`, `rain`)
+ * are measured separately because all pixels of the frames are opaque while the icons have many transparent
+ * and semi-transparent pixels.
+ * Every group, opacity and blend kernel set prints one JSON line:
+ * {"bench":"img_premult","imgs":"space","opa":255,"kernels":"swar","px":265680,"straight_us":850.2,"premult_us":420.7,
+ *  "speedup":2.02}
+ *
+ * "px" is the number of pixels drawn in one round, "straight_us" and "premult_us" are the average time of
+ * redrawing all the images of the group (invalidating them and refreshing the screen) once.
+ * "kernels" is the `lv_draw_sw_blend_kernels_t` set used for both formats. The ESP32 uses "swar".
+ * Use a build with `LV_COLOR_DEPTH 16` and `LV_COLOR_16_SWAP 1` (e.g. `OPTIONS_16BIT_SWAP`) to have the same
+ * color format as the application.
+ *
+ * Usage: bench_img_premult [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include "../lv_test_img.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+#define SPACE_CNT       18
+#define ICON_CNT        4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(SPACE_1)
+LV_IMG_DECLARE(SPACE_2)
+LV_IMG_DECLARE(SPACE_3)
+LV_IMG_DECLARE(SPACE_4)
+LV_IMG_DECLARE(SPACE_5)
+LV_IMG_DECLARE(SPACE_6)
+LV_IMG_DECLARE(SPACE_7)
+LV_IMG_DECLARE(SPACE_8)
+LV_IMG_DECLARE(SPACE_9)
+LV_IMG_DECLARE(SPACE_10)
+LV_IMG_DECLARE(SPACE_11)
+LV_IMG_DECLARE(SPACE_12)
+LV_IMG_DECLARE(SPACE_13)
+LV_IMG_DECLARE(SPACE_14)
+LV_IMG_DECLARE(SPACE_15)
+LV_IMG_DECLARE(SPACE_16)
+LV_IMG_DECLARE(SPACE_17)
+LV_IMG_DECLARE(SPACE_18)
+LV_IMG_DECLARE(sunny)
+LV_IMG_DECLARE(cloud)
+LV_IMG_DECLARE(cloudd)
+LV_IMG_DECLARE(rain)
+
+static const lv_img_dsc_t * space_imgs[SPACE_CNT] = {
+    &SPACE_1, &SPACE_2, &SPACE_3, &SPACE_4, &SPACE_5, &SPACE_6, &SPACE_7, &SPACE_8, &SPACE_9,
+    &SPACE_10, &SPACE_11, &SPACE_12, &SPACE_13, &SPACE_14, &SPACE_15, &SPACE_16, &SPACE_17, &SPACE_18
+};
+static const lv_img_dsc_t * icon_imgs[ICON_CNT] = {&sunny, &cloud, &cloudd, &rain};
+
+static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_60};
+
+#if LV_DRAW_SW_BLEND_KERNELS
+static const lv_draw_sw_blend_kernels_t * kernels[] = {
+    &lv_draw_sw_blend_kernels_swar,
+#if LV_DRAW_SW_BLEND_SIMD
+    &lv_draw_sw_blend_kernels_simd,
+#endif
+};
+#endif
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*Return the average time of redrawing all the images once in ns*/
+static double draw_run(const lv_img_dsc_t ** imgs, uint32_t cnt, lv_opa_t opa, uint32_t iterations)
+{
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_obj_set_style_img_opa(obj, opa, 0);
+
+    uint64_t t = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_img_set_src(obj, imgs[i]);
+        lv_obj_center(obj);
+        lv_refr_now(disp);
+
+        uint64_t t_img = now_ns();
+        uint32_t j;
+        for(j = 0; j < iterations; j++) {
+            lv_obj_invalidate(obj);
+            lv_refr_now(disp);
+        }
+        t += now_ns() - t_img;
+    }
+
+    lv_obj_del(obj);
+    return (double)t / iterations;
+}
+
+static void bench_group(const char * name, const lv_img_dsc_t ** imgs, uint32_t cnt, uint32_t iterations)
+{
+    const lv_img_dsc_t ** premult = malloc(cnt * sizeof(premult[0]));
+    uint32_t px = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        premult[i] = lv_test_img_premultiply(imgs[i]);
+        px += imgs[i]->header.w * imgs[i]->header.h;
+    }
+
+#if LV_DRAW_SW_BLEND_KERNELS
+    uint32_t kernel_cnt = sizeof(kernels) / sizeof(kernels[0]);
+#else
+    uint32_t kernel_cnt = 1;
+#endif
+    uint32_t k;
+    for(k = 0; k < kernel_cnt; k++) {
+#if LV_DRAW_SW_BLEND_KERNELS
+        lv_draw_sw_blend_set_kernels(kernels[k]);
+        const char * kernel_name = kernels[k]->name;
+#else
+        const char * kernel_name = "none";
+#endif
+        uint32_t o;
+        for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+            double straight_ns = draw_run(imgs, cnt, opas[o], iterations);
+            double premult_ns = draw_run(premult, cnt, opas[o], iterations);
+
+            printf("{\"bench\":\"img_premult\",\"imgs\":\"%s\",\"opa\":%u,\"kernels\":\"%s\",\"px\":%u,"
+                   "\"straight_us\":%.1f,\"premult_us\":%.1f,\"speedup\":%.2f}\n",
+                   name, (unsigned)opas[o], kernel_name, (unsigned)px, straight_ns / 1000.0, premult_ns / 1000.0,
+                   straight_ns / premult_ns);
+        }
+    }
+
+    for(i = 0; i < cnt; i++) lv_test_img_free((lv_img_dsc_t *)premult[i]);
+    free(premult);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    bench_group("space", space_imgs, SPACE_CNT, iterations);
+    bench_group("icons", icon_imgs, ICON_CNT, iterations);
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file bench_img_transform.c
+ * Compare transforming the weather icon `sunny` pixel by pixel (`_lv_img_buf_transform()`, as the image drawing did
+ * before) and line by line (`_lv_img_buf_transform_line()`) with some angles and zooms.
+ * Every case prints one JSON line:
+ * {"bench":"img_transform","angle":450,"zoom":256,"aa":1,"px":3364,"per_pixel_ns":25.3,"line_ns":8.1,"speedup":3.12,
+ *  "draw_us":120.5}
+ *
+ * "per_pixel_ns" and "line_ns" are the average time of transforming a pixel of the transformed area.
+ * "draw_us" is the time of redrawing an `lv_img` with the same transformation (with the line by line transformation).
+ * The cases with 90 degree steps and integer zoom without anti-aliasing use the exact (copying) path.
+ *
+ * Usage: bench_img_transform [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_DRAW_COMPLEX
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    int16_t angle;
+    uint16_t zoom;
+    bool antialias;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(sunny)
+
+static const bench_case_t cases[] = {
+    {450, 256, true},
+    {450, 256, false},
+    {123, 300, true},
+    {0, 384, true},
+    {900, 256, true},
+    {2700, 256, false},
+    {0, 512, false},
+};
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+static lv_color_t cbuf[BENCH_HOR_RES];
+static lv_opa_t abuf[BENCH_HOR_RES];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*Transform the area line by line or pixel by pixel and return the time in ns*/
+static uint64_t transform_run(lv_img_transform_dsc_t * dsc, const lv_area_t * area, bool line, uint32_t iterations)
+{
+    lv_coord_t len = lv_area_get_width(area);
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_coord_t y;
+        for(y = area->y1; y <= area->y2; y++) {
+            if(line) {
+                _lv_img_buf_transform_line(dsc, area->x1, y, len, cbuf, abuf);
+            }
+            else {
+                lv_coord_t x;
+                for(x = 0; x < len; x++) {
+                    if(_lv_img_buf_transform(dsc, area->x1 + x, y)) {
+                        abuf[x] = dsc->res.opa;
+                        cbuf[x] = dsc->res.color;
+                    }
+                    else {
+                        abuf[x] = LV_OPA_TRANSP;
+                    }
+                }
+            }
+        }
+    }
+    return now_ns() - t;
+}
+
+/*Return the average time of redrawing the transformed image in ns*/
+static double draw_run(const bench_case_t * c, uint32_t iterations)
+{
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_img_set_src(obj, &sunny);
+    lv_img_set_angle(obj, c->angle);
+    lv_img_set_zoom(obj, c->zoom);
+    lv_img_set_antialias(obj, c->antialias);
+    lv_obj_center(obj);
+    lv_refr_now(disp);
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(disp);
+    }
+    t = now_ns() - t;
+
+    lv_obj_del(obj);
+    return (double)t / iterations;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const bench_case_t * c = &cases[i];
+        lv_img_transform_dsc_t dsc;
+        lv_memset_00(&dsc, sizeof(dsc));
+        dsc.cfg.src = sunny.data;
+        dsc.cfg.src_w = sunny.header.w;
+        dsc.cfg.src_h = sunny.header.h;
+        dsc.cfg.cf = sunny.header.cf;
+        dsc.cfg.angle = c->angle;
+        dsc.cfg.zoom = c->zoom;
+        dsc.cfg.pivot_x = sunny.header.w / 2;
+        dsc.cfg.pivot_y = sunny.header.h / 2;
+        dsc.cfg.antialias = c->antialias;
+        _lv_img_buf_transform_init(&dsc);
+
+        lv_area_t area;
+        lv_point_t pivot = {dsc.cfg.pivot_x, dsc.cfg.pivot_y};
+        _lv_img_buf_get_transformed_area(&area, sunny.header.w, sunny.header.h, c->angle, c->zoom, &pivot);
+        uint32_t px = lv_area_get_size(&area);
+
+        uint64_t per_pixel_ns = transform_run(&dsc, &area, false, iterations);
+        uint64_t line_ns = transform_run(&dsc, &area, true, iterations);
+        double draw_ns = draw_run(c, iterations);
+
+        printf("{\"bench\":\"img_transform\",\"angle\":%d,\"zoom\":%u,\"aa\":%d,\"px\":%u,\"per_pixel_ns\":%.1f,"
+               "\"line_ns\":%.1f,\"speedup\":%.2f,\"draw_us\":%.1f}\n",
+               c->angle, (unsigned)c->zoom, c->antialias, (unsigned)px,
+               (double)per_pixel_ns / iterations / px, (double)line_ns / iterations / px,
+               (double)per_pixel_ns / line_ns, draw_ns / 1000.0);
+    }
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"img_transform\",\"skipped\":\"LV_DRAW_COMPLEX is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_DRAW_COMPLEX*/
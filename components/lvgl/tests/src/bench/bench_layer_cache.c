@@ -0,0 +1,330 @@
+/**
+ * @file bench_layer_cache.c
+ * Compare redrawing the static parts of the weather desktop normally and from the layer cache (`LV_OBJ_FLAG_LAYER_CACHE`).
+ * The static parts are the home symbol with the city label and the line grid of `API_desktop_Line()`.
+ * Every layer setup and scenario prints one JSON line:
+ * {"bench":"layer_cache","layers":"city","scenario":"full_redraw","frames":200,"ms_per_frame":0.236,"speedup":1.30,
+ *  "renders_per_frame":0.00,"skipped":0,"mem_kb":15.0}
+ *
+ * Layer setups:
+ * - "none": the objects are drawn normally, as in `bench_desktop`
+ * - "city": the home symbol and the city label are on a transparent layer
+ * - "city_opaque": the same on a layer with the background color of the screen, which is cached without alpha channel
+ * - "all_opaque": the line grid is also on an opaque layer
+ *
+ * Scenarios:
+ * - "full_redraw": the screen is invalidated in every frame
+ * - "clock_tick": the colon of the clock blinks
+ * - "scroll": the screen is scrolled up and down, so the layers are moved but not changed
+ * - "city_change": the city label is changed in every frame, so its layer is rendered again (the worst case)
+ *
+ * "speedup" is relative to "none" in the same scenario. "renders_per_frame" is the number of layers rendered per frame,
+ * "skipped" the number of times a layer didn't fit in the cache and "mem_kb" the memory of the cached layers.
+ * The grid needs about 87 kB with 16 bit colors so use more `LV_MEM_SIZE` than the 64 kB of `OPTIONS_16BIT_SWAP`,
+ * e.g. add `-DLV_MEM_SIZE=1048576` to its options for a local build.
+ *
+ * Usage: bench_layer_cache [frames] [cache_kb]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_LAYER_CACHE
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Same resolution and draw buffers as the application: 4 buffers with the memory of 2 x 40 lines*/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_NUM   4
+#define BENCH_BUF_PX    ((BENCH_HOR_RES * 40 * 2) / BENCH_BUF_NUM)
+
+#define SCROLL_STEP     10
+
+#if LV_FONT_MONTSERRAT_16
+    #define FONT_SMALL  &lv_font_montserrat_16
+#else
+    #define FONT_SMALL  LV_FONT_DEFAULT
+#endif
+
+#if LV_FONT_MONTSERRAT_20
+    #define FONT_SYMBOL &lv_font_montserrat_20
+#else
+    #define FONT_SYMBOL LV_FONT_DEFAULT
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    LAYERS_NONE,
+    LAYERS_CITY,
+    LAYERS_CITY_OPAQUE,
+    LAYERS_ALL_OPAQUE,
+    _LAYERS_NUM
+} layers_t;
+
+typedef void (*scenario_cb_t)(uint32_t i);
+
+typedef struct {
+    const char * name;
+    scenario_cb_t frame_cb;
+} scenario_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void frame_full_redraw(uint32_t i);
+static void frame_clock_tick(uint32_t i);
+static void frame_scroll(uint32_t i);
+static void frame_city_change(uint32_t i);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_HOR_RES * BENCH_VER_RES];
+static lv_color_t bufs[BENCH_BUF_NUM][BENCH_BUF_PX];
+
+static lv_disp_t * disp;
+static lv_obj_t * time_label;
+static lv_obj_t * city_label;
+
+static const char * layers_names[_LAYERS_NUM] = {"none", "city", "city_opaque", "all_opaque"};
+
+static const scenario_t scenarios[] = {
+    {"full_redraw", frame_full_redraw},
+    {"clock_tick", frame_clock_tick},
+    {"scroll", frame_scroll},
+    {"city_change", frame_city_change},
+};
+
+#define SCENARIO_NUM    (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*Copy to a frame buffer to have a realistic memory traffic*/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    void * buf_p[BENCH_BUF_NUM];
+    uint32_t i;
+    for(i = 0; i < BENCH_BUF_NUM; i++) buf_p[i] = bufs[i];
+    lv_disp_draw_buf_init_ring(&draw_buf, buf_p, BENCH_BUF_NUM, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*A container for the static objects. Without layers it's a plain transparent container.*/
+static lv_obj_t * create_layer(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, bool cache,
+                               bool opaque)
+{
+    lv_obj_t * layer = lv_obj_create(parent);
+    lv_obj_remove_style_all(layer);
+    lv_obj_clear_flag(layer, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_pos(layer, x, y);
+    lv_obj_set_size(layer, w, h);
+    if(opaque) {
+        lv_obj_set_style_bg_color(layer, lv_obj_get_style_bg_color(parent, LV_PART_MAIN), 0);
+        lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, 0);
+    }
+    if(cache) lv_obj_add_flag(layer, LV_OBJ_FLAG_LAYER_CACHE);
+    return layer;
+}
+
+/*The objects of `bench_desktop` with the static ones in containers*/
+static void create_desktop(layers_t layers)
+{
+    LV_FONT_DECLARE(SEG_Font_60);
+    LV_FONT_DECLARE(city_30);
+    LV_IMG_DECLARE(sunny);
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_clean(scr);
+    lv_obj_scroll_to(scr, 0, 0, LV_ANIM_OFF);
+
+    bool opaque = layers == LAYERS_CITY_OPAQUE || layers == LAYERS_ALL_OPAQUE;
+
+    /*The line grid of `API_desktop_Line()`. The points are relative to the screen as the layer is in the corner.*/
+    lv_obj_t * grid = create_layer(scr, 0, 0, 240, 185, layers == LAYERS_ALL_OPAQUE, opaque);
+    static lv_point_t line_points[4][2] = {
+        {{5, 20}, {235, 20}},
+        {{65, 20}, {65, 100}},
+        {{5, 100}, {235, 100}},
+        {{5, 180}, {235, 180}},
+    };
+    static lv_style_t line_style;
+    lv_style_init(&line_style);
+    lv_style_set_line_width(&line_style, 1);
+    lv_style_set_line_color(&line_style, lv_color_black());
+    lv_style_set_line_rounded(&line_style, true);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * line = lv_line_create(grid);
+        lv_line_set_points(line, line_points[i], 2);
+        lv_obj_add_style(line, &line_style, 0);
+    }
+
+    /*The home symbol and the city in the left cell of the grid*/
+    lv_obj_t * city = create_layer(scr, 0, 21, 65, 79, layers != LAYERS_NONE, opaque);
+    lv_obj_t * symbol_home = lv_label_create(city);
+    lv_obj_set_pos(symbol_home, 5, 24);
+    lv_label_set_recolor(symbol_home, true);
+    lv_obj_set_style_text_font(symbol_home, FONT_SYMBOL, 0);
+    lv_label_set_text(symbol_home, "#000000 "LV_SYMBOL_HOME"#");
+
+    city_label = lv_label_create(city);
+    lv_obj_align_to(city_label, symbol_home, LV_ALIGN_OUT_RIGHT_TOP, 2, -20);
+    lv_label_set_recolor(city_label, true);
+    lv_obj_set_style_text_font(city_label, &city_30, 0);
+    lv_label_set_text(city_label, "#0000ff 佛#\n#0000ff 山#");
+
+    lv_obj_t * weather_img = lv_img_create(scr);
+    lv_img_set_src(weather_img, &sunny);
+    lv_obj_align(weather_img, LV_ALIGN_TOP_MID, -20, 30);
+
+    lv_obj_t * temp_range_label = lv_label_create(scr);
+    lv_obj_align(temp_range_label, LV_ALIGN_TOP_MID, -16, 75);
+    lv_label_set_recolor(temp_range_label, true);
+    lv_obj_set_style_text_font(temp_range_label, FONT_SMALL, 0);
+    lv_label_set_text(temp_range_label, "#111111 10~20°C#");
+
+    lv_obj_t * date_label = lv_label_create(scr);
+    lv_obj_align(date_label, LV_ALIGN_TOP_MID, 0, 1);
+    lv_obj_set_style_text_font(date_label, FONT_SMALL, 0);
+    lv_obj_set_style_text_color(date_label, lv_color_black(), 0);
+    lv_label_set_text(date_label, "2021-12-24");
+
+    time_label = lv_label_create(scr);
+    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, 20);
+    lv_obj_set_style_text_font(time_label, &SEG_Font_60, 0);
+    lv_obj_set_style_text_color(time_label, lv_color_make(255, 0, 0), 0);
+    lv_label_set_text(time_label, "12:34");
+}
+
+static void frame_full_redraw(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+}
+
+/*The colon of the clock blinks every 500 ms*/
+static void frame_clock_tick(uint32_t i)
+{
+    lv_label_set_text(time_label, i & 1 ? "12:34" : "12 34");
+    lv_refr_now(disp);
+}
+
+/*Scroll the screen up and down to move every object*/
+static void frame_scroll(uint32_t i)
+{
+    lv_obj_scroll_by(lv_scr_act(), 0, i & 1 ? SCROLL_STEP : -SCROLL_STEP, LV_ANIM_OFF);
+    lv_refr_now(disp);
+}
+
+static void frame_city_change(uint32_t i)
+{
+    lv_label_set_text(city_label, i & 1 ? "#0000ff 佛#\n#0000ff 山#" : "#0000ff 广#\n#0000ff 州#");
+    lv_refr_now(disp);
+}
+
+static double bench(layers_t layers, const scenario_t * scenario, uint32_t frames, double ns_none)
+{
+    create_desktop(layers);
+
+    /*Warm up the caches and get a stable state*/
+    scenario->frame_cb(0);
+    scenario->frame_cb(1);
+    lv_layer_cache_reset_stats();
+
+    uint64_t t_start = now_ns();
+    uint32_t i;
+    for(i = 0; i < frames; i++) scenario->frame_cb(i);
+    double ns = (double)(now_ns() - t_start) / frames;
+
+    lv_layer_cache_stats_t stats;
+    lv_layer_cache_get_stats(&stats);
+
+    printf("{\"bench\":\"layer_cache\",\"layers\":\"%s\",\"scenario\":\"%s\",\"frames\":%u,\"ms_per_frame\":%.3f,"
+           "\"speedup\":%.2f,\"renders_per_frame\":%.2f,\"skipped\":%u,\"mem_kb\":%.1f}\n",
+           layers_names[layers], scenario->name, (unsigned)frames, ns / 1000000.0,
+           ns_none > 0 ? ns_none / ns : 1.0, (double)stats.render_cnt / frames, (unsigned)stats.skip_cnt,
+           stats.mem_used / 1024.0);
+
+    return ns;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    if(frames == 0) frames = 1;
+    uint32_t cache_kb = argc > 2 ? (uint32_t)atoi(argv[2]) : 256;
+
+    lv_init();
+
+    create_disp();
+    lv_layer_cache_set_size(cache_kb * 1024);
+
+    uint32_t s;
+    for(s = 0; s < SCENARIO_NUM; s++) {
+        double ns_none = bench(LAYERS_NONE, &scenarios[s], frames, 0);
+        layers_t layers;
+        for(layers = LAYERS_CITY; layers < _LAYERS_NUM; layers++) {
+            bench(layers, &scenarios[s], frames, ns_none);
+        }
+    }
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"layer_cache\",\"skipped\":\"LV_USE_LAYER_CACHE is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_LAYER_CACHE*/
@@ -0,0 +1,347 @@
+/**
+ * @file bench_mem.c
+ * Create and delete objects, styles, animations, timers and texts for a long time the way a desktop with popups does,
+ * and compare the heap with and without the slab allocator (`LV_MEM_SLAB`).
+ * Every mode prints one JSON line:
+ * {"bench":"mem","mode":"slab","rounds":20000,"mem_size":65536,"ms_per_round":0.012,"frag_pct":12,"frag_pct_max":40,
+ *  "free_biggest_min":1234,"free_cnt":5,"max_used":23456,"alloc_ns":45.6,"free_ns":30.1,"oom":0,
+ *  "classes":[{"size":16,"cnt":32,"max_used":30,"alloc":1234,"miss":0},...]}
+ *
+ * "frag_pct", "free_cnt": fragmentation of the pool at the end, while the popups of the last round are still open.
+ * "frag_pct_max", "free_biggest_min": the worst values sampled during the whole run.
+ * "alloc_ns", "free_ns": time of an allocation and a free of the typical small sizes in the heap left by the churn.
+ * "oom": number of popups which couldn't be created as the memory ran out.
+ * "classes": the counters of the size classes of the slabs (`lv_mem_slab_monitor()`) during the churn.
+ *
+ * Every mode starts from a freshly initialized heap (`lv_deinit()`, `lv_init()`). In the "pool" mode the slabs are disabled
+ * before `lv_init()` so no memory is reserved for them.
+ *
+ * Usage: bench_mem [rounds]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_MEM_CUSTOM == 0
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+
+/*At most this many popups are open at once*/
+#define POPUP_MAX       4
+
+/*Sample the fragmentation in every N rounds*/
+#define SAMPLE_PERIOD   16
+
+/*Number of blocks allocated at once in the latency measurement*/
+#define LAT_BATCH       32
+#define LAT_REPEAT      2000
+
+/*Print the counters of this many size classes at most*/
+#define SLAB_CLASS_MAX  16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * obj;
+    uint32_t close_round;
+} popup_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_obj_t * clock_label;
+static lv_obj_t * date_label;
+static popup_t popups[POPUP_MAX];
+static uint32_t rnd_state;
+static uint32_t oom_cnt;
+
+/*The typical sizes of the allocations: objects, their special attributes, styles and event lists, animations and
+ *timers in linked lists, short texts*/
+static const size_t lat_sizes[] = {
+    sizeof(lv_obj_t), sizeof(_lv_obj_spec_attr_t), sizeof(lv_anim_t) + 2 * sizeof(void *),
+    sizeof(lv_timer_t) + 2 * sizeof(void *), 2 * sizeof(void *), 3 * sizeof(void *), 6, 12, 24
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*The same pseudo random sequence in every mode*/
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    lv_disp_t * disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+static void create_desktop(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+
+    clock_label = lv_label_create(scr);
+    lv_obj_set_style_text_color(clock_label, lv_color_white(), 0);
+    lv_obj_align(clock_label, LV_ALIGN_TOP_MID, 0, 10);
+
+    date_label = lv_label_create(scr);
+    lv_obj_set_style_text_color(date_label, lv_color_white(), 0);
+    lv_obj_align(date_label, LV_ALIGN_TOP_MID, 0, 40);
+}
+
+static void popup_timer_cb(lv_timer_t * t)
+{
+    lv_obj_t * label = t->user_data;
+    lv_label_set_text_fmt(label, "%d %%", (int)rnd(100));
+}
+
+static void popup_fade_anim_cb(void * var, int32_t v)
+{
+    lv_obj_set_style_opa(var, v, 0);
+}
+
+static void popup_del_event_cb(lv_event_t * e)
+{
+    lv_timer_del(lv_event_get_user_data(e));
+}
+
+/*A panel with local styles, a list of labels and buttons with texts of random length, a fade in animation
+ *and a timer updating one of the labels*/
+static lv_obj_t * popup_create(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if(mon.free_biggest_size < 2048) {
+        oom_cnt++;
+        return NULL;
+    }
+
+    lv_obj_t * panel = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(panel, 100 + rnd(120), 80 + rnd(100));
+    lv_obj_set_pos(panel, rnd(100), rnd(80));
+    lv_obj_set_style_bg_color(panel, lv_color_hex(0x203040 + rnd(0x40)), 0);
+    lv_obj_set_style_radius(panel, rnd(10), 0);
+    lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+
+    static const char * words[] = {"Rain", "Sunny", "Wind 12 km/h", "Humidity", "Tomorrow", "Cloudy with some sun"};
+    uint32_t cnt = 2 + rnd(5);
+    uint32_t i;
+    lv_obj_t * label = NULL;
+    for(i = 0; i < cnt; i++) {
+        if(rnd(3) == 0) {
+            lv_obj_t * btn = lv_btn_create(panel);
+            label = lv_label_create(btn);
+        }
+        else {
+            label = lv_label_create(panel);
+        }
+        lv_label_set_text_fmt(label, "%s %d", words[rnd(6)], (int)rnd(1000));
+    }
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, panel);
+    lv_anim_set_values(&a, LV_OPA_TRANSP, LV_OPA_COVER);
+    lv_anim_set_exec_cb(&a, popup_fade_anim_cb);
+    lv_anim_set_time(&a, 100 + rnd(200));
+    lv_anim_start(&a);
+
+    lv_timer_t * t = lv_timer_create(popup_timer_cb, 50 + rnd(100), label);
+    lv_obj_add_event_cb(panel, popup_del_event_cb, LV_EVENT_DELETE, t);
+
+    return panel;
+}
+
+static void round_run(uint32_t round)
+{
+    /*The clock is updated in every round, the date rarely*/
+    lv_label_set_text_fmt(clock_label, "%02d:%02d:%02d", (int)(round / 3600) % 24, (int)(round / 60) % 60,
+                          (int)round % 60);
+    if(round % 100 == 0) lv_label_set_text_fmt(date_label, "Day %d", (int)(round / 100));
+
+    uint32_t i;
+    for(i = 0; i < POPUP_MAX; i++) {
+        if(popups[i].obj && popups[i].close_round <= round) {
+            lv_obj_del(popups[i].obj);
+            popups[i].obj = NULL;
+        }
+    }
+
+    if(rnd(8) == 0) {
+        for(i = 0; i < POPUP_MAX; i++) {
+            if(popups[i].obj == NULL) {
+                popups[i].obj = popup_create();
+                popups[i].close_round = round + 5 + rnd(60);
+                break;
+            }
+        }
+    }
+
+    lv_tick_inc(30);
+    lv_timer_handler();
+}
+
+/*Allocate and free batches of the typical small sizes in random order*/
+static void measure_latency(double * alloc_ns, double * free_ns)
+{
+    void * p[LAT_BATCH];
+    uint32_t order[LAT_BATCH];
+    uint64_t t_alloc = 0;
+    uint64_t t_free = 0;
+    uint32_t r;
+    for(r = 0; r < LAT_REPEAT; r++) {
+        uint32_t i;
+        uint64_t t = now_ns();
+        for(i = 0; i < LAT_BATCH; i++) {
+            p[i] = lv_mem_alloc(lat_sizes[(i + r) % (sizeof(lat_sizes) / sizeof(lat_sizes[0]))]);
+        }
+        t_alloc += now_ns() - t;
+
+        for(i = 0; i < LAT_BATCH; i++) order[i] = i;
+        for(i = LAT_BATCH - 1; i > 0; i--) {
+            uint32_t j = rnd(i + 1);
+            uint32_t tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+
+        t = now_ns();
+        for(i = 0; i < LAT_BATCH; i++) lv_mem_free(p[order[i]]);
+        t_free += now_ns() - t;
+    }
+
+    *alloc_ns = (double)t_alloc / (LAT_REPEAT * LAT_BATCH);
+    *free_ns = (double)t_free / (LAT_REPEAT * LAT_BATCH);
+}
+
+static void bench(const char * mode, bool slab, uint32_t rounds)
+{
+#if LV_MEM_SLAB
+    lv_mem_set_slab(slab);
+#else
+    LV_UNUSED(slab);
+#endif
+    lv_init();
+    create_disp();
+    create_desktop();
+
+    rnd_state = 1;
+    oom_cnt = 0;
+    lv_memset_00(popups, sizeof(popups));
+
+    uint32_t frag_max = 0;
+    uint32_t biggest_min = UINT32_MAX;
+    lv_mem_monitor_t mon;
+
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < rounds; i++) {
+        round_run(i);
+        if(i % SAMPLE_PERIOD == 0) {
+            lv_mem_monitor(&mon);
+            if(mon.frag_pct > frag_max) frag_max = mon.frag_pct;
+            if(mon.free_biggest_size < biggest_min) biggest_min = mon.free_biggest_size;
+        }
+    }
+    t = now_ns() - t;
+
+    lv_mem_monitor(&mon);
+#if LV_MEM_SLAB
+    lv_mem_slab_monitor_t slab_mon[SLAB_CLASS_MAX];
+    uint32_t class_cnt = slab ? LV_MIN(lv_mem_slab_get_class_cnt(), SLAB_CLASS_MAX) : 0;
+    for(i = 0; i < class_cnt; i++) lv_mem_slab_monitor(i, &slab_mon[i]);
+#endif
+
+    double alloc_ns;
+    double free_ns;
+    measure_latency(&alloc_ns, &free_ns);
+
+    printf("{\"bench\":\"mem\",\"mode\":\"%s\",\"rounds\":%u,\"mem_size\":%u,\"ms_per_round\":%.4f,"
+           "\"frag_pct\":%u,\"frag_pct_max\":%u,\"free_biggest_min\":%u,\"free_cnt\":%u,\"max_used\":%u,"
+           "\"alloc_ns\":%.1f,\"free_ns\":%.1f,\"oom\":%u,\"classes\":[",
+           mode, rounds, (unsigned)LV_MEM_SIZE, (double)t / 1000000 / rounds,
+           mon.frag_pct, frag_max, biggest_min, mon.free_cnt, mon.max_used, alloc_ns, free_ns, oom_cnt);
+
+#if LV_MEM_SLAB
+    for(i = 0; i < class_cnt; i++) {
+        printf("%s{\"size\":%u,\"cnt\":%u,\"max_used\":%u,\"alloc\":%u,\"miss\":%u}", i ? "," : "",
+               slab_mon[i].block_size, slab_mon[i].block_cnt, slab_mon[i].max_used_cnt, slab_mon[i].alloc_cnt,
+               slab_mon[i].miss_cnt);
+    }
+#endif
+    printf("]}\n");
+
+    lv_deinit();
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t rounds = argc > 1 ? (uint32_t)atoi(argv[1]) : 20000;
+    if(rounds == 0) rounds = 1;
+
+    bench("pool", false, rounds);
+#if LV_MEM_SLAB
+    bench("slab", true, rounds);
+#else
+    printf("{\"bench\":\"mem\",\"mode\":\"slab\",\"skipped\":\"LV_MEM_SLAB is disabled\"}\n");
+#endif
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"mem\",\"skipped\":\"LV_MEM_CUSTOM is enabled\"}\n");
+    return 0;
+}
+
+#endif /*LV_MEM_CUSTOM == 0*/
@@ -0,0 +1,215 @@
+/**
+ * @file bench_png.c
+ * Compare decoding a PNG image row by row (`lv_png_set_stream(true)`) and as a whole (`lv_png_set_stream(false)`).
+ * The image is a 240x240 PNG encoded by lodepng from the tiled `SPACE_1` frame.
+ * Every mode and image cache setting prints one JSON line:
+ * {"bench":"png","mode":"stream","img_cache":0,"w":240,"h":240,"png_kb":4.4,"decode_us":289.6,"peak_kb":36.8,
+ *  "decoded_kb":36.8,"frame_us":766.6,"frame_peak_kb":38.3}
+ *
+ * "decode_us" is the average time of opening the image and reading all its rows, "peak_kb" is the largest heap
+ * memory (`lv_mem_monitor()`'s `max_used`) allocated meanwhile and "decoded_kb" is the memory kept while the image
+ * is open (the `decoded_size` charged to the image cache). "frame_us" and "frame_peak_kb" are the same for
+ * refreshing a 320x240 screen with the image in 40 lines high parts. Without the image cache the image is opened
+ * again for every part. With the image cache the rows are decoded again in every frame in stream mode.
+ * The PNG is encoded with `lv_mem_alloc()` and the whole image needs 4 bytes per pixel, so use more `LV_MEM_SIZE`
+ * than the 64 kB of `OPTIONS_16BIT_SWAP`, e.g. add `-DLV_MEM_SIZE=1048576` to its options for a local build.
+ *
+ * Usage: bench_png [iterations]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include "../lv_test_img.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_PNG
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+#define BENCH_IMG_SIZE  240
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(SPACE_1)
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+static lv_img_dsc_t * img;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+/*Start measuring the peak heap usage and return the current usage*/
+static uint32_t peak_start(void)
+{
+    lv_mem_reset_max_used();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.max_used;
+}
+
+static uint32_t peak_get(uint32_t used)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.max_used - used;
+}
+
+/*Open the image and read all its rows. Return false on error.*/
+static bool decode_all(uint8_t * line, uint32_t * decoded_size)
+{
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, img, lv_color_black(), 0) != LV_RES_OK) return false;
+
+    bool ok = true;
+    if(dsc.img_data == NULL) {
+        lv_coord_t y;
+        for(y = 0; y < img->header.h && ok; y++) {
+            ok = lv_img_decoder_read_line(&dsc, 0, y, img->header.w, line) == LV_RES_OK;
+        }
+    }
+    *decoded_size = dsc.decoded_size;
+    lv_img_decoder_close(&dsc);
+    return ok;
+}
+
+static void bench_mode(bool stream, uint16_t img_cache, lv_obj_t * obj, uint32_t iterations)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_size(img_cache);
+#else
+    if(img_cache) return;
+#endif
+    lv_png_set_stream(stream);
+    lv_img_cache_invalidate_src(NULL);
+
+    uint8_t * line = malloc(img->header.w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    uint32_t decoded_size = 0;
+    uint32_t used = peak_start();
+    uint64_t t = now_ns();
+    uint32_t i;
+    for(i = 0; i < iterations; i++) {
+        if(!decode_all(line, &decoded_size)) {
+            printf("{\"bench\":\"png\",\"mode\":\"%s\",\"error\":\"can't decode the image\"}\n", stream ? "stream" : "whole");
+            free(line);
+            return;
+        }
+    }
+    double decode_ns = (double)(now_ns() - t) / iterations;
+    uint32_t peak = peak_get(used);
+    free(line);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(disp);
+    used = peak_start();
+    t = now_ns();
+    for(i = 0; i < iterations; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(disp);
+    }
+    double frame_ns = (double)(now_ns() - t) / iterations;
+    uint32_t frame_peak = peak_get(used);
+    lv_img_cache_invalidate_src(NULL);
+
+    printf("{\"bench\":\"png\",\"mode\":\"%s\",\"img_cache\":%u,\"w\":%d,\"h\":%d,\"png_kb\":%.1f,\"decode_us\":%.1f,"
+           "\"peak_kb\":%.1f,\"decoded_kb\":%.1f,\"frame_us\":%.1f,\"frame_peak_kb\":%.1f}\n",
+           stream ? "stream" : "whole", (unsigned)img_cache, (int)img->header.w, (int)img->header.h,
+           img->data_size / 1024.0, decode_ns / 1000.0, peak / 1024.0, decoded_size / 1024.0, frame_ns / 1000.0,
+           frame_peak / 1024.0);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 20;
+    if(iterations == 0) iterations = 1;
+
+    lv_init();
+    create_disp();
+
+    img = lv_test_img_png(&SPACE_1, BENCH_IMG_SIZE, BENCH_IMG_SIZE, 0);
+    if(img == NULL) {
+        printf("{\"bench\":\"png\",\"skipped\":\"the PNG can't be encoded, LV_MEM_SIZE is too small\"}\n");
+        return 0;
+    }
+
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_img_set_src(obj, img);
+    lv_obj_center(obj);
+
+    bench_mode(true, 0, obj, iterations);
+    bench_mode(false, 0, obj, iterations);
+    bench_mode(true, 1, obj, iterations);
+    bench_mode(false, 1, obj, iterations);
+
+    lv_obj_del(obj);
+    lv_img_cache_invalidate_src(NULL);
+    lv_test_img_free(img);
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"png\",\"skipped\":\"LV_USE_PNG is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_PNG*/
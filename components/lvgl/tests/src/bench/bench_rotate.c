@@ -0,0 +1,134 @@
+/**
+ * @file bench_rotate.c
+ * Measure the throughput of the software rotation.
+ * Every rotation renders the same full screen a few times and prints one JSON line:
+ * {"bench":"rotate","rot":90,"frames":100,"ms_per_frame":1.234,"mpx_per_s":56.78,"flushes_per_frame":12.0}
+ *
+ * Usage: bench_rotate [frames]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Logical resolution, same as the ST7789 panel in landscape*/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_ROWS  40
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_HOR_RES * BENCH_VER_RES];
+static lv_color_t buf1[BENCH_HOR_RES * BENCH_BUF_ROWS];
+static lv_color_t buf2[BENCH_HOR_RES * BENCH_BUF_ROWS];
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Copy to a frame buffer to have a realistic memory traffic*/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x3060a0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * btn = lv_btn_create(scr);
+    lv_obj_set_size(btn, 120, 50);
+    lv_obj_align(btn, LV_ALIGN_TOP_LEFT, 10, 10);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Rotate");
+    lv_obj_center(label);
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 120, 120);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    lv_arc_set_value(arc, 60);
+}
+
+static void bench(lv_disp_rot_t rot, uint32_t frames)
+{
+    static const uint16_t degrees[] = {0, 90, 180, 270};
+    bool swap = rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270;
+
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, BENCH_HOR_RES * BENCH_BUF_ROWS);
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = swap ? BENCH_VER_RES : BENCH_HOR_RES;
+    drv.ver_res = swap ? BENCH_HOR_RES : BENCH_VER_RES;
+    drv.sw_rotate = 1;
+    drv.rotated = rot;
+    lv_disp_t * disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+
+    create_ui();
+
+    /*Warm up the caches*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    lv_refr_reset_flush_stats(disp);
+    double t_start = now_s();
+    uint32_t i;
+    for(i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+    }
+    double t = now_s() - t_start;
+    lv_disp_flush_stats_t flush_stats;
+    lv_refr_get_flush_stats(disp, &flush_stats);
+
+    printf("{\"bench\":\"rotate\",\"rot\":%d,\"frames\":%u,\"ms_per_frame\":%.3f,\"mpx_per_s\":%.2f,\"flushes_per_frame\":%.1f}\n",
+           degrees[rot], (unsigned)frames, t * 1000.0 / frames,
+           (double)BENCH_HOR_RES * BENCH_VER_RES * frames / t / 1e6, (double)flush_stats.flush_cnt / frames);
+
+    lv_disp_remove(disp);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    if(frames == 0) frames = 1;
+
+    lv_init();
+
+    bench(LV_DISP_ROT_NONE, frames);
+    bench(LV_DISP_ROT_90, frames);
+    bench(LV_DISP_ROT_180, frames);
+    bench(LV_DISP_ROT_270, frames);
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file bench_sjpg.c
+ * Scroll a tall SJPG image (`examples/libs/sjpg/small_image.sjpg` repeated to 320x1920, 16 lines per fragment)
+ * on a 320x240 display and measure the frames with some fragment cache sizes, with and without decoding ahead
+ * and with and without the image cache (without it the image is opened and closed for every drawn area).
+ * Every case prints one JSON line:
+ * {"bench":"sjpg","img_cache":0,"cache_kb":170,"ahead":1,"frames":200,"idle_us":2000,"frame_us":2100.5,
+ *  "decodes_per_frame":0.1,"ahead_per_frame":0.9,"hit_rate":0.98,"speedup":8.12}
+ *
+ * "cache_kb" is the size of the fragment cache (`lv_sjpg_cache_set_size()`), "frame_us" is the average time
+ * of a frame (scrolling by `BENCH_STEP` pixels and refreshing the screen). There is "idle_us" sleep between the
+ * frames (not measured) like between the refreshes of an application. The fragments are decoded in advance
+ * in this time. "decodes_per_frame" is the number of fragments decoded while drawing and "ahead_per_frame" is
+ * the number of used fragments decoded in advance on the other thread. "speedup" is compared to the case without
+ * fragment cache and decoding ahead.
+ * The fragments are allocated with `lv_mem_alloc()`, so the larger cache sizes need more `LV_MEM_SIZE` than
+ * the 64 kB of `OPTIONS_16BIT_SWAP`. E.g. add `-DLV_MEM_SIZE=1048576`, `-DLV_USE_PARALLEL_RENDER=1` and
+ * `-DLV_SJPG_DECODE_AHEAD=1` to its options for a local build.
+ *
+ * Usage: bench_sjpg [frames] [idle_us]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include "../lv_test_img.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if LV_USE_SJPG
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   320
+#define BENCH_VER_RES   240
+#define BENCH_BUF_PX    (BENCH_HOR_RES * 40)
+#define BENCH_REPEAT    8
+#define BENCH_STEP      8
+#define BENCH_FRAG_SIZE (BENCH_HOR_RES * 16 * sizeof(lv_color_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t cache_size;
+    bool ahead;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const bench_case_t cases[] = {
+    {0, false},
+    {LV_SJPG_CACHE_SIZE, false},
+    /*The fragments of the screen and one more*/
+    {(BENCH_VER_RES / 16 + 2) * BENCH_FRAG_SIZE, false},
+#if LV_SJPG_DECODE_AHEAD
+    {0, true},
+    {LV_SJPG_CACHE_SIZE, true},
+    {(BENCH_VER_RES / 16 + 2) * BENCH_FRAG_SIZE, true},
+#endif
+};
+
+static lv_color_t buf[BENCH_BUF_PX];
+static lv_disp_t * disp;
+static lv_img_dsc_t * img;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_disp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BENCH_BUF_PX);
+
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = BENCH_HOR_RES;
+    drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+}
+
+static void sleep_us(uint32_t us)
+{
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+/*Return the average time of scrolling and refreshing the screen in ns*/
+static double scroll_run(lv_obj_t * cont, uint32_t frames, uint32_t idle_us)
+{
+    lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    lv_sjpg_cache_reset_stats();
+
+    lv_coord_t y_max = img->header.h - BENCH_VER_RES;
+    lv_coord_t y = 0;
+    uint64_t t = 0;
+    uint32_t i;
+    for(i = 0; i < frames; i++) {
+        if(idle_us) sleep_us(idle_us);
+
+        uint64_t t_frame = now_ns();
+        y += BENCH_STEP;
+        if(y > y_max) y = 0;
+        lv_obj_scroll_to_y(cont, y, LV_ANIM_OFF);
+        lv_refr_now(disp);
+        t += now_ns() - t_frame;
+    }
+    return (double)t / frames;
+}
+
+static void bench_img_cache(uint16_t img_cache, lv_obj_t * cont, uint32_t frames, uint32_t idle_us)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_size(img_cache);
+#else
+    if(img_cache) return;
+#endif
+
+    double base_ns = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const bench_case_t * c = &cases[i];
+        lv_img_cache_invalidate_src(NULL);
+        lv_sjpg_cache_invalidate_src(NULL);
+        lv_sjpg_cache_set_size(c->cache_size);
+#if LV_SJPG_DECODE_AHEAD
+        lv_sjpg_set_decode_ahead(c->ahead);
+#endif
+
+        double frame_ns = scroll_run(cont, frames, idle_us);
+        if(i == 0) base_ns = frame_ns;
+
+        lv_sjpg_cache_stats_t stats;
+        lv_sjpg_cache_get_stats(&stats);
+        uint32_t used = stats.hit_cnt + stats.miss_cnt + stats.ahead_cnt;
+        printf("{\"bench\":\"sjpg\",\"img_cache\":%u,\"cache_kb\":%u,\"ahead\":%d,\"frames\":%u,\"idle_us\":%u,"
+               "\"frame_us\":%.1f,\"decodes_per_frame\":%.2f,\"ahead_per_frame\":%.2f,\"hit_rate\":%.2f,\"speedup\":%.2f}\n",
+               (unsigned)img_cache, (unsigned)(c->cache_size / 1024), c->ahead, (unsigned)frames, (unsigned)idle_us,
+               frame_ns / 1000.0, (double)stats.miss_cnt / frames, (double)stats.ahead_cnt / frames,
+               used ? (double)(stats.hit_cnt + stats.ahead_cnt) / used : 0.0, base_ns / frame_ns);
+    }
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    if(frames == 0) frames = 1;
+    uint32_t idle_us = argc > 2 ? (uint32_t)atoi(argv[2]) : 2000;
+
+    lv_init();
+    create_disp();
+
+    img = lv_test_img_sjpg(BENCH_REPEAT);
+    if(img == NULL) {
+        printf("{\"bench\":\"sjpg\",\"skipped\":\"small_image.sjpg is not found\"}\n");
+        return 0;
+    }
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, BENCH_HOR_RES, BENCH_VER_RES);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_style_radius(cont, 0, 0);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_t * obj = lv_img_create(cont);
+    lv_img_set_src(obj, img);
+
+    bench_img_cache(0, cont, frames, idle_us);
+    bench_img_cache(1, cont, frames, idle_us);
+
+    lv_obj_del(cont);
+    lv_img_cache_invalidate_src(NULL);
+    lv_sjpg_cache_invalidate_src(NULL);
+    lv_test_img_free(img);
+
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("{\"bench\":\"sjpg\",\"skipped\":\"LV_USE_SJPG is required\"}\n");
+    return 0;
+}
+
+#endif /*LV_USE_SJPG*/
@@ -0,0 +1,191 @@
+/**
+ * @file bench_timer.c
+ * Run hundreds of timers with different periods for a long simulated time and measure the cost of `lv_timer_handler()`.
+ * Every timer count and mode prints one JSON line:
+ * {"bench":"timer","mode":"sleep","timers":200,"sim_ms":20000,"calls":1234,"runs":5678,"churn":123,
+ *  "ns_per_call":456.7,"ns_per_run":123.4,"late_ms_max":0}
+ *
+ * Modes:
+ * - "poll": `lv_timer_handler()` is called in every millisecond, the way a port with a fixed delay does.
+ *   Most calls find no ready timer.
+ * - "sleep": the time is stepped forward by the return value of `lv_timer_handler()`, the way a port which
+ *   sleeps until the next timer does. Every call runs at least one timer.
+ *
+ * Some callbacks change the timers the way the widgets do: change the period, pause and resume an other timer,
+ * or delete an other timer and create a new one ("churn").
+ * "late_ms_max": the most a timer ran later than its deadline.
+ *
+ * Only the API available before the timers were ordered by deadline is used, so the results can be compared with
+ * the previous implementation.
+ *
+ * Usage: bench_timer [sim_ms]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TIMER_MAX       500
+
+/*Period of the timers between these values [ms]*/
+#define PERIOD_MIN      5
+#define PERIOD_MAX      1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t deadline;
+    uint32_t slot;
+} timer_data_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_timer_t * timers[TIMER_MAX];
+static timer_data_t timer_data[TIMER_MAX];
+static uint32_t timer_cnt;
+static uint32_t rnd_state;
+static uint32_t run_cnt;
+static uint32_t churn_cnt;
+static uint32_t late_max;
+
+static const uint32_t timer_cnts[] = {10, 50, 200, 500};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*The same pseudo random sequence in every mode*/
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
+
+static void timer_cb(lv_timer_t * t);
+
+static void timer_start(uint32_t slot)
+{
+    uint32_t period = PERIOD_MIN + rnd(PERIOD_MAX - PERIOD_MIN);
+    timer_data[slot].slot = slot;
+    timer_data[slot].deadline = lv_tick_get() + period;
+    timers[slot] = lv_timer_create(timer_cb, period, &timer_data[slot]);
+}
+
+static void timer_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    uint32_t late = lv_tick_elaps(d->deadline);
+    if(late < 0x80000000 && late > late_max) late_max = late;
+    run_cnt++;
+
+    uint32_t other = rnd(timer_cnt);
+    switch(rnd(32)) {
+        case 0:
+            lv_timer_set_period(t, PERIOD_MIN + rnd(PERIOD_MAX - PERIOD_MIN));
+            churn_cnt++;
+            break;
+        case 1:
+            if(other != d->slot) {
+                /*`lv_timer_pause()` and `lv_timer_resume()` keep the time of the last run*/
+                lv_timer_pause(timers[other]);
+                lv_timer_resume(timers[other]);
+                churn_cnt++;
+            }
+            break;
+        case 2:
+            if(other != d->slot) {
+                lv_timer_del(timers[other]);
+                timer_start(other);
+                churn_cnt++;
+            }
+            break;
+        default:
+            break;
+    }
+
+    d->deadline = lv_tick_get() + t->period;
+}
+
+static void bench(const char * mode, bool sleep, uint32_t cnt, uint32_t sim_ms)
+{
+    rnd_state = 1;
+    run_cnt = 0;
+    churn_cnt = 0;
+    late_max = 0;
+    timer_cnt = cnt;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        timer_start(i);
+        if(timers[i] == NULL) {
+            printf("{\"bench\":\"timer\",\"mode\":\"%s\",\"timers\":%u,\"skipped\":\"out of memory\"}\n", mode, cnt);
+            while(i) lv_timer_del(timers[--i]);
+            return;
+        }
+    }
+
+    uint32_t call_cnt = 0;
+    uint32_t elapsed = 0;
+    uint32_t step = 1;
+    uint64_t t_sum = 0;
+    while(elapsed < sim_ms) {
+        lv_tick_inc(step);
+        elapsed += step;
+
+        uint64_t t_start = now_ns();
+        uint32_t next = lv_timer_handler();
+        t_sum += now_ns() - t_start;
+        call_cnt++;
+
+        if(sleep) step = next == LV_NO_TIMER_READY ? sim_ms : LV_MAX(next, 1);
+    }
+
+    printf("{\"bench\":\"timer\",\"mode\":\"%s\",\"timers\":%u,\"sim_ms\":%u,\"calls\":%u,\"runs\":%u,\"churn\":%u,"
+           "\"ns_per_call\":%.1f,\"ns_per_run\":%.1f,\"late_ms_max\":%u}\n",
+           mode, cnt, sim_ms, call_cnt, run_cnt, churn_cnt,
+           (double)t_sum / call_cnt, run_cnt ? (double)t_sum / run_cnt : 0.0, late_max);
+
+    for(i = 0; i < cnt; i++) lv_timer_del(timers[i]);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t sim_ms = argc > 1 ? (uint32_t)atoi(argv[1]) : 20000;
+    if(sim_ms == 0) sim_ms = 1;
+
+    lv_init();
+
+    uint32_t i;
+    for(i = 0; i < sizeof(timer_cnts) / sizeof(timer_cnts[0]); i++) {
+        bench("poll", false, timer_cnts[i], sim_ms);
+        bench("sleep", true, timer_cnts[i], sim_ms);
+    }
+
+    lv_deinit();
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+#if LV_BUILD_TEST
+#include <stdlib.h>
+#include <string.h>
+
+#include "lv_test_gif.h"
+
+#define HASH_SIZE   8191
+#define CODE_MAX    4095
+
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t cap;
+    uint8_t block[255];
+    uint32_t block_len;
+    uint32_t bits;
+    uint32_t bit_cnt;
+} writer_t;
+
+static uint32_t rand_next(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void put_byte(writer_t * w, uint8_t b)
+{
+    if(w->size == w->cap) {
+        w->cap = w->cap * 2 + 1024;
+        w->data = realloc(w->data, w->cap);
+    }
+    w->data[w->size++] = b;
+}
+
+static void put_u16(writer_t * w, uint16_t v)
+{
+    put_byte(w, v & 0xFF);
+    put_byte(w, v >> 8);
+}
+
+static void put_palette(writer_t * w, uint32_t color_cnt, uint32_t * seed)
+{
+    uint32_t i;
+    for(i = 0; i < color_cnt * 3; i++) put_byte(w, rand_next(seed) & 0xFF);
+}
+
+static void block_flush(writer_t * w)
+{
+    if(w->block_len == 0) return;
+    put_byte(w, w->block_len);
+    uint32_t i;
+    for(i = 0; i < w->block_len; i++) put_byte(w, w->block[i]);
+    w->block_len = 0;
+}
+
+static void code_put(writer_t * w, uint32_t code, uint32_t code_size)
+{
+    w->bits |= code << w->bit_cnt;
+    w->bit_cnt += code_size;
+    while(w->bit_cnt >= 8) {
+        w->block[w->block_len++] = w->bits & 0xFF;
+        if(w->block_len == sizeof(w->block)) block_flush(w);
+        w->bits >>= 8;
+        w->bit_cnt -= 8;
+    }
+}
+
+static void lzw_encode(writer_t * w, const uint8_t * px, uint32_t px_cnt, uint8_t min_code_size, bool no_clear)
+{
+    static int32_t keys[HASH_SIZE];
+    static uint16_t codes[HASH_SIZE];
+
+    uint32_t clear = 1 << min_code_size;
+    uint32_t code_size = min_code_size + 1;
+    uint32_t code_max = clear + 1;
+    memset(keys, 0xFF, sizeof(keys));
+
+    put_byte(w, min_code_size);
+    code_put(w, clear, code_size);
+
+    uint32_t cur = px[0];
+    uint32_t i;
+    for(i = 1; i < px_cnt; i++) {
+        int32_t key = (cur << 8) | px[i];
+        uint32_t h = key % HASH_SIZE;
+        while(keys[h] != -1 && keys[h] != key) h = (h + 1) % HASH_SIZE;
+        if(keys[h] == key) {
+            cur = codes[h];
+            continue;
+        }
+
+        code_put(w, cur, code_size);
+        if(code_max < CODE_MAX) {
+            keys[h] = key;
+            codes[h] = ++code_max;
+            if(code_max >= (1U << code_size)) code_size++;
+        }
+        else if(!no_clear) {
+            code_put(w, clear, code_size);
+            memset(keys, 0xFF, sizeof(keys));
+            code_size = min_code_size + 1;
+            code_max = clear + 1;
+        }
+        cur = px[i];
+    }
+    code_put(w, cur, code_size);
+    code_put(w, clear + 1, code_size);
+
+    if(w->bit_cnt) code_put(w, 0, 8 - w->bit_cnt);
+    block_flush(w);
+    put_byte(w, 0);
+}
+
+uint8_t * lv_test_gif_create(const lv_test_gif_dsc_t * dsc, uint32_t * size)
+{
+    writer_t w;
+    memset(&w, 0, sizeof(w));
+    uint32_t seed = dsc->seed;
+    uint32_t color_cnt = 1 << dsc->min_code_size;
+    uint8_t table_flags = dsc->min_code_size - 1;
+
+    const char * sig = "GIF89a";
+    while(*sig) put_byte(&w, *sig++);
+    put_u16(&w, dsc->w);
+    put_u16(&w, dsc->h);
+    put_byte(&w, 0x80 | (table_flags << 4) | table_flags);
+    put_byte(&w, 0);    /*Background color index*/
+    put_byte(&w, 0);    /*Aspect ratio*/
+    put_palette(&w, color_cnt, &seed);
+
+    /*Loop forever*/
+    const char * netscape = "\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00";
+    uint32_t i;
+    for(i = 0; i < 19; i++) put_byte(&w, netscape[i]);
+
+    uint8_t * px = malloc(dsc->w * dsc->h);
+    uint16_t f;
+    for(f = 0; f < dsc->frame_cnt; f++) {
+        uint16_t fx = 0, fy = 0, fw = dsc->w, fh = dsc->h;
+        if(f > 0) {
+            fx = (f * 7) % (dsc->w / 2 + 1);
+            fy = (f * 5) % (dsc->h / 2 + 1);
+            fw = dsc->w - fx - (fx && (f & 1) ? 1 : 0);
+            fh = dsc->h - fy - (fy && (f & 2) ? 1 : 0);
+        }
+
+        /*Graphic control extension with every disposal method and sometimes a transparent color*/
+        put_byte(&w, 0x21);
+        put_byte(&w, 0xF9);
+        put_byte(&w, 4);
+        put_byte(&w, ((f % 3) << 2) | (f % 4 == 3 ? 1 : 0));
+        put_u16(&w, 5);
+        put_byte(&w, f % color_cnt);
+        put_byte(&w, 0);
+
+        put_byte(&w, 0x2C);
+        put_u16(&w, fx);
+        put_u16(&w, fy);
+        put_u16(&w, fw);
+        put_u16(&w, fh);
+        put_byte(&w, (dsc->interlace ? 0x40 : 0) | (dsc->lct ? 0x80 | table_flags : 0));
+        if(dsc->lct) put_palette(&w, color_cnt, &seed);
+
+        /*The rows in the order they are stored*/
+        static const uint8_t pass_start[] = {0, 4, 2, 1};
+        static const uint8_t pass_step[] = {8, 8, 4, 2};
+        uint32_t px_cnt = 0;
+        uint32_t pass;
+        for(pass = 0; pass < 4; pass++) {
+            uint32_t y = dsc->interlace ? pass_start[pass] : (pass == 0 ? 0 : fh);
+            uint32_t step = dsc->interlace ? pass_step[pass] : 1;
+            for(; y < fh; y += step) {
+                uint32_t x;
+                for(x = 0; x < fw; x++) {
+                    uint32_t v;
+                    if(dsc->noise) v = rand_next(&seed);
+                    else v = x / (1 + (y + f) % 7) + y / 3 + f;
+                    px[px_cnt++] = v & (color_cnt - 1);
+                }
+            }
+        }
+
+        lzw_encode(&w, px, px_cnt, dsc->min_code_size, dsc->no_clear);
+    }
+    free(px);
+
+    put_byte(&w, 0x3B);
+    *size = w.size;
+    return w.data;
+}
+
+#endif
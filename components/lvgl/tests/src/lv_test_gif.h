@@ -0,0 +1,35 @@
+#ifndef LV_TEST_GIF_H
+#define LV_TEST_GIF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint16_t w;
+    uint16_t h;
+    uint16_t frame_cnt;
+    uint8_t min_code_size;  /*2..8, the frames have `1 << min_code_size` colors*/
+    bool interlace;
+    bool lct;               /*Local color table in every frame*/
+    bool no_clear;          /*Keep using the full code table instead of sending a clear code*/
+    bool noise;             /*Random pixels instead of runs of the same color*/
+    uint32_t seed;
+} lv_test_gif_dsc_t;
+
+/**
+ * Create an animated GIF in memory. The first frame covers the whole image, the others only a part of it.
+ * @param dsc       describes the GIF
+ * @param size      the size of the GIF in bytes
+ * @return          the GIF. Free it with `free()`
+ */
+uint8_t * lv_test_gif_create(const lv_test_gif_dsc_t * dsc, uint32_t * size);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEST_GIF_H*/
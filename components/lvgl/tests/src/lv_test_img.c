@@ -0,0 +1,342 @@
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lv_test_img.h"
+#if LV_USE_PNG
+    #include "../../src/extra/libs/png/lodepng.h"
+#endif
+
+#define RLE_CNT_MAX     128
+#define LZ4_MIN_MATCH   4
+#define LZ4_OFS_MAX     0xFFFF
+#define LZ4_HASH_BITS   12
+#define LZ4_CHAIN_MAX   16
+
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t cap;
+} writer_t;
+
+static void put_byte(writer_t * w, uint8_t b)
+{
+    if(w->size == w->cap) {
+        w->cap = w->cap * 2 + 1024;
+        w->data = realloc(w->data, w->cap);
+    }
+    w->data[w->size++] = b;
+}
+
+static void put_bytes(writer_t * w, const uint8_t * src, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) put_byte(w, src[i]);
+}
+
+static void put_u32_at(writer_t * w, uint32_t pos, uint32_t v)
+{
+    w->data[pos] = v & 0xFF;
+    w->data[pos + 1] = (v >> 8) & 0xFF;
+    w->data[pos + 2] = (v >> 16) & 0xFF;
+    w->data[pos + 3] = v >> 24;
+}
+
+static void rle_encode(writer_t * w, const uint8_t * data, uint32_t px_cnt)
+{
+    const uint32_t px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t i = 0;
+    uint32_t lit = 0;
+    while(i <= px_cnt) {
+        uint32_t n = 1;
+        if(i < px_cnt) {
+            while(i + n < px_cnt && n < RLE_CNT_MAX &&
+                  memcmp(data + (i + n) * px_size, data + i * px_size, px_size) == 0) n++;
+        }
+
+        /*Flush the literals before a run and at the end*/
+        if(i == px_cnt || n >= 2) {
+            uint32_t start = i - lit;
+            while(lit) {
+                uint32_t cnt = lit < RLE_CNT_MAX ? lit : RLE_CNT_MAX;
+                put_byte(w, cnt - 1);
+                put_bytes(w, data + start * px_size, cnt * px_size);
+                start += cnt;
+                lit -= cnt;
+            }
+        }
+        if(i == px_cnt) break;
+
+        if(n >= 2) {
+            put_byte(w, 0x80 | (n - 1));
+            put_bytes(w, data + i * px_size, px_size);
+            i += n;
+        }
+        else {
+            lit++;
+            i++;
+        }
+    }
+}
+
+static uint32_t lz4_hash(const uint8_t * p)
+{
+    uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    return (v * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+static void lz4_len_add(writer_t * w, uint32_t n)
+{
+    while(n >= 255) {
+        put_byte(w, 255);
+        n -= 255;
+    }
+    put_byte(w, n);
+}
+
+static void lz4_seq_add(writer_t * w, const uint8_t * lit, uint32_t lit_len, uint32_t match_len, uint32_t ofs)
+{
+    uint8_t token = (lit_len < 15 ? lit_len : 15) << 4;
+    if(match_len) token |= match_len - LZ4_MIN_MATCH < 15 ? match_len - LZ4_MIN_MATCH : 15;
+    put_byte(w, token);
+    if(lit_len >= 15) lz4_len_add(w, lit_len - 15);
+    put_bytes(w, lit, lit_len);
+    if(match_len) {
+        put_byte(w, ofs & 0xFF);
+        put_byte(w, ofs >> 8);
+        if(match_len - LZ4_MIN_MATCH >= 15) lz4_len_add(w, match_len - LZ4_MIN_MATCH - 15);
+    }
+}
+
+/*Greedy LZ4 block: the longest of the last LZ4_CHAIN_MAX positions with the same hash*/
+static void lz4_encode(writer_t * w, const uint8_t * data, uint32_t n)
+{
+    int32_t * head = malloc((1 << LZ4_HASH_BITS) * sizeof(int32_t));
+    int32_t * prev = malloc(n * sizeof(int32_t) + 1);
+    uint32_t i;
+    for(i = 0; i < (1 << LZ4_HASH_BITS); i++) head[i] = -1;
+
+    uint32_t anchor = 0;
+    i = 0;
+    while(i + LZ4_MIN_MATCH <= n) {
+        uint32_t best_len = 0;
+        uint32_t best_ofs = 0;
+        uint32_t h = lz4_hash(data + i);
+        int32_t c = head[h];
+        uint32_t steps = 0;
+        while(c >= 0 && steps < LZ4_CHAIN_MAX && i - c <= LZ4_OFS_MAX) {
+            uint32_t l = 0;
+            while(i + l < n && data[c + l] == data[i + l]) l++;
+            if(l > best_len) {
+                best_len = l;
+                best_ofs = i - c;
+            }
+            c = prev[c];
+            steps++;
+        }
+
+        prev[i] = head[h];
+        head[h] = i;
+        if(best_len >= LZ4_MIN_MATCH) {
+            lz4_seq_add(w, data + anchor, i - anchor, best_len, best_ofs);
+            uint32_t j;
+            for(j = i + 1; j < i + best_len && j + LZ4_MIN_MATCH <= n; j++) {
+                h = lz4_hash(data + j);
+                prev[j] = head[h];
+                head[h] = j;
+            }
+            i += best_len;
+            anchor = i;
+        }
+        else {
+            i++;
+        }
+    }
+
+    lz4_seq_add(w, data + anchor, n - anchor, 0, 0);
+    free(head);
+    free(prev);
+}
+
+lv_img_dsc_t * lv_test_img_compress(const lv_img_dsc_t * img, lv_img_cf_t cf, uint32_t lines)
+{
+    uint32_t w = img->header.w;
+    uint32_t h = img->header.h;
+    uint32_t block_cnt = (h + lines - 1) / lines;
+    uint32_t ofs_start = 4;
+    uint32_t blocks_start = ofs_start + (block_cnt + 1) * 4;
+
+    writer_t wr = {0};
+    put_byte(&wr, lines & 0xFF);
+    put_byte(&wr, lines >> 8);
+    put_byte(&wr, 0);
+    put_byte(&wr, 0);
+    uint32_t i;
+    for(i = 0; i < (block_cnt + 1) * 4; i++) put_byte(&wr, 0);
+
+    for(i = 0; i < block_cnt; i++) {
+        put_u32_at(&wr, ofs_start + i * 4, wr.size - blocks_start);
+        uint32_t block_lines = h - i * lines < lines ? h - i * lines : lines;
+        const uint8_t * px = img->data + i * lines * w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE) rle_encode(&wr, px, w * block_lines);
+        else lz4_encode(&wr, px, w * block_lines * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    }
+    put_u32_at(&wr, ofs_start + block_cnt * 4, wr.size - blocks_start);
+
+    lv_img_dsc_t * dsc = calloc(1, sizeof(lv_img_dsc_t));
+    dsc->header.w = w;
+    dsc->header.h = h;
+    dsc->header.cf = cf;
+    dsc->data = wr.data;
+    dsc->data_size = wr.size;
+    return dsc;
+}
+
+lv_img_dsc_t * lv_test_img_premultiply(const lv_img_dsc_t * img)
+{
+    lv_img_dsc_t * dsc = calloc(1, sizeof(lv_img_dsc_t));
+    *dsc = *img;
+    uint8_t * data = malloc(img->data_size);
+    memcpy(data, img->data, img->data_size);
+    dsc->data = data;
+    lv_img_buf_premultiply(dsc);
+    return dsc;
+}
+
+lv_img_dsc_t * lv_test_img_sjpg(uint32_t repeat)
+{
+    /*The path is relative to this file so it works from any directory*/
+    char path[512];
+    const char * dir_end = strrchr(__FILE__, '/');
+    int dir_len = dir_end ? (int)(dir_end - __FILE__) : 1;
+    snprintf(path, sizeof(path), "%.*s/../../examples/libs/sjpg/small_image.sjpg", dir_len, dir_end ? __FILE__ : ".");
+
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    uint32_t size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * src = malloc(size);
+    bool ok = fread(src, 1, size, f) == size;
+    fclose(f);
+    if(!ok) {
+        free(src);
+        return NULL;
+    }
+
+    /*Header: "_SJPG__\0", "V1.00\0", width, height, fragment count, fragment height, fragment sizes (all u16)*/
+    const uint32_t hdr_size = 22;
+    uint32_t w = src[14] | (src[15] << 8);
+    uint32_t h = src[16] | (src[17] << 8);
+    uint32_t frag_cnt = src[18] | (src[19] << 8);
+    uint32_t table_size = frag_cnt * 2;
+    uint32_t frags_size = size - hdr_size - table_size;
+
+    writer_t wr = {0};
+    put_bytes(&wr, src, hdr_size);
+    wr.data[16] = (h * repeat) & 0xFF;
+    wr.data[17] = (h * repeat) >> 8;
+    wr.data[18] = (frag_cnt * repeat) & 0xFF;
+    wr.data[19] = (frag_cnt * repeat) >> 8;
+    uint32_t i;
+    for(i = 0; i < repeat; i++) put_bytes(&wr, src + hdr_size, table_size);
+    for(i = 0; i < repeat; i++) put_bytes(&wr, src + hdr_size + table_size, frags_size);
+    free(src);
+
+    lv_img_dsc_t * dsc = calloc(1, sizeof(lv_img_dsc_t));
+    dsc->header.w = w;
+    dsc->header.h = h * repeat;
+    dsc->header.cf = LV_IMG_CF_RAW;
+    dsc->data = wr.data;
+    dsc->data_size = wr.size;
+    return dsc;
+}
+
+#if LV_USE_PNG
+static void put_u32_be(writer_t * w, uint32_t v)
+{
+    put_byte(w, v >> 24);
+    put_byte(w, (v >> 16) & 0xFF);
+    put_byte(w, (v >> 8) & 0xFF);
+    put_byte(w, v & 0xFF);
+}
+
+static void png_chunk_add(writer_t * w, const uint8_t * type, const uint8_t * data, uint32_t len)
+{
+    put_u32_be(w, len);
+    uint32_t start = w->size;
+    put_bytes(w, type, 4);
+    put_bytes(w, data, len);
+    put_u32_be(w, lodepng_crc32(w->data + start, len + 4));
+}
+
+lv_img_dsc_t * lv_test_img_png_split(const uint8_t * png, uint32_t size, uint32_t idat_size)
+{
+    writer_t wr = {0};
+    put_bytes(&wr, png, 8);
+
+    const uint8_t * chunk = png + 8;
+    while(chunk + 12 <= png + size) {
+        uint32_t len = lodepng_chunk_length(chunk);
+        const uint8_t * data = chunk + 8;
+        if(idat_size && lodepng_chunk_type_equals(chunk, "IDAT")) {
+            uint32_t ofs;
+            for(ofs = 0; ofs < len; ofs += idat_size) {
+                png_chunk_add(&wr, chunk + 4, data + ofs, len - ofs < idat_size ? len - ofs : idat_size);
+            }
+        }
+        else {
+            put_bytes(&wr, chunk, len + 12);
+        }
+        chunk += len + 12;
+    }
+
+    lv_img_dsc_t * dsc = calloc(1, sizeof(lv_img_dsc_t));
+    dsc->header.w = (png[18] << 8) | png[19];
+    dsc->header.h = (png[22] << 8) | png[23];
+    dsc->header.cf = LV_IMG_CF_RAW_ALPHA;
+    dsc->data = wr.data;
+    dsc->data_size = wr.size;
+    return dsc;
+}
+
+lv_img_dsc_t * lv_test_img_png(const lv_img_dsc_t * img, uint32_t w, uint32_t h, uint32_t idat_size)
+{
+    uint8_t * rgba = malloc(w * h * 4);
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_coord_t img_x = x % img->header.w;
+            lv_coord_t img_y = y % img->header.h;
+            lv_color32_t c;
+            c.full = lv_color_to32(lv_img_buf_get_px_color((lv_img_dsc_t *)img, img_x, img_y, lv_color_black()));
+            uint8_t * px = &rgba[(y * w + x) * 4];
+            px[0] = c.ch.red;
+            px[1] = c.ch.green;
+            px[2] = c.ch.blue;
+            px[3] = lv_img_cf_has_alpha(img->header.cf) ? lv_img_buf_get_px_alpha((lv_img_dsc_t *)img, img_x, img_y) : 0xFF;
+        }
+    }
+
+    /*lodepng allocates with `lv_mem_alloc()`*/
+    uint8_t * png;
+    size_t png_size;
+    unsigned error = lodepng_encode32(&png, &png_size, rgba, w, h);
+    free(rgba);
+    if(error) return NULL;
+
+    lv_img_dsc_t * dsc = lv_test_img_png_split(png, png_size, idat_size);
+    lv_mem_free(png);
+    return dsc;
+}
+#endif
+
+void lv_test_img_free(lv_img_dsc_t * img)
+{
+    free((void *)img->data);
+    free(img);
+}
+
+#endif
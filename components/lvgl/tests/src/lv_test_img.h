@@ -0,0 +1,70 @@
+#ifndef LV_TEST_IMG_H
+#define LV_TEST_IMG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "../../lvgl.h"
+
+/**
+ * Compress an `LV_IMG_CF_TRUE_COLOR_ALPHA` image the same way as `scripts/img_compress_conv.py`.
+ * @param img       the image to compress
+ * @param cf        `LV_IMG_CF_TRUE_COLOR_ALPHA_RLE` or `LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4`
+ * @param lines     lines per block
+ * @return          the compressed image. Free it with `lv_test_img_free()`
+ */
+lv_img_dsc_t * lv_test_img_compress(const lv_img_dsc_t * img, lv_img_cf_t cf, uint32_t lines);
+
+/**
+ * Copy an `LV_IMG_CF_TRUE_COLOR_ALPHA` image to RAM and convert it to `LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT`
+ * the same way as `scripts/img_premult_conv.py`.
+ * @param img       the image to convert
+ * @return          the converted image. Free it with `lv_test_img_free()`
+ */
+lv_img_dsc_t * lv_test_img_premultiply(const lv_img_dsc_t * img);
+
+/**
+ * Load `examples/libs/sjpg/small_image.sjpg` (320x240, 16 lines per fragment) to RAM
+ * and repeat its fragments vertically to create a taller SJPG image.
+ * @param repeat    how many times to repeat the image (1: the original image)
+ * @return          an `LV_IMG_CF_RAW` image with the SJPG data or NULL if the file is not found.
+ *                  Free it with `lv_test_img_free()`
+ */
+lv_img_dsc_t * lv_test_img_sjpg(uint32_t repeat);
+
+#if LV_USE_PNG
+/**
+ * Copy a PNG file to a new image and split its image data to IDAT chunks of the given size.
+ * @param png       the PNG file's content
+ * @param size      size of `png` in bytes
+ * @param idat_size maximal length of the IDAT chunks (0: keep the chunks)
+ * @return          an `LV_IMG_CF_RAW_ALPHA` image with the PNG data. Free it with `lv_test_img_free()`
+ */
+lv_img_dsc_t * lv_test_img_png_split(const uint8_t * png, uint32_t size, uint32_t idat_size);
+
+/**
+ * Tile an image to the given size and encode it to PNG with lodepng.
+ * @param img       the image to encode
+ * @param w         width of the PNG image
+ * @param h         height of the PNG image
+ * @param idat_size maximal length of the IDAT chunks (0: one IDAT chunk)
+ * @return          an `LV_IMG_CF_RAW_ALPHA` image with the PNG data or NULL if it can't be encoded.
+ *                  Free it with `lv_test_img_free()`
+ */
+lv_img_dsc_t * lv_test_img_png(const lv_img_dsc_t * img, uint32_t w, uint32_t h, uint32_t idat_size);
+#endif
+
+/**
+ * Free an image created by `lv_test_img_compress()`, `lv_test_img_premultiply()`, `lv_test_img_sjpg()`
+ * or `lv_test_img_png...()`
+ * @param img       the image to free
+ */
+void lv_test_img_free(lv_img_dsc_t * img);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEST_IMG_H*/
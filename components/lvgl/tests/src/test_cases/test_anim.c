@@ -0,0 +1,280 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static int32_t values[200];
+static uint32_t ready_cnt;
+static lv_anim_t * ready_anim;
+static int32_t * to_delete;
+static bool start_in_ready;
+
+void setUp(void)
+{
+    lv_memset_00(values, sizeof(values));
+    ready_cnt = 0;
+    ready_anim = NULL;
+    to_delete = NULL;
+    start_in_ready = false;
+}
+
+void tearDown(void)
+{
+    lv_anim_del_all();
+    lv_obj_clean(lv_scr_act());
+}
+
+static void exec_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+}
+
+static void del_self_exec_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+    if(v >= 50) lv_anim_del(var, del_self_exec_cb);
+}
+
+static void x_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_x(var, v);
+}
+
+static void y_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_y(var, v);
+}
+
+static void ready_cb(lv_anim_t * a)
+{
+    ready_cnt++;
+    ready_anim = a;
+
+    /*Already deleted*/
+    TEST_ASSERT_NULL(lv_anim_get(a->var, a->exec_cb));
+
+    if(to_delete) lv_anim_del(to_delete, exec_cb);
+    if(start_in_ready) {
+        lv_anim_t a2;
+        lv_anim_init(&a2);
+        lv_anim_set_var(&a2, &values[2]);
+        lv_anim_set_exec_cb(&a2, exec_cb);
+        lv_anim_set_values(&a2, 0, 100);
+        lv_anim_set_time(&a2, 100);
+        lv_anim_set_early_apply(&a2, false);
+        lv_anim_start(&a2);
+    }
+}
+
+static lv_anim_t * start(int32_t * var, int32_t end, uint32_t time, lv_anim_path_cb_t path_cb)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, end);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_path_cb(&a, path_cb);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    return lv_anim_start(&a);
+}
+
+static void step(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    lv_anim_refr_now();
+}
+
+/*The built-in paths follow their Bezier curves*/
+void test_anim_path_values(void)
+{
+    static const struct {
+        lv_anim_path_cb_t path_cb;
+        uint32_t u0, u1, u2, u3;
+    } paths[] = {
+        {lv_anim_path_ease_in, 0, 50, 100, 1024},
+        {lv_anim_path_ease_out, 0, 900, 950, 1024},
+        {lv_anim_path_ease_in_out, 0, 50, 952, 1024},
+        {lv_anim_path_overshoot, 0, 1000, 1300, 1024},
+    };
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    a.start_value = 100;
+    a.end_value = 1124;
+    a.time = 1000;
+
+    uint32_t p;
+    for(p = 0; p < sizeof(paths) / sizeof(paths[0]); p++) {
+        int32_t t;
+        for(t = 0; t <= 1000; t += 10) {
+            a.act_time = t;
+            int32_t v = paths[p].path_cb(&a);
+            uint32_t bt = lv_map(t, 0, 1000, 0, LV_BEZIER_VAL_MAX);
+            int32_t exp = 100 + lv_bezier3(bt, paths[p].u0, paths[p].u1, paths[p].u2, paths[p].u3);
+            TEST_ASSERT_INT32_WITHIN(4, exp, v);
+        }
+
+        a.act_time = 0;
+        TEST_ASSERT_EQUAL(100, paths[p].path_cb(&a));
+        a.act_time = 1000;
+        TEST_ASSERT_EQUAL(1124, paths[p].path_cb(&a));
+    }
+
+    a.act_time = 250;
+    TEST_ASSERT_EQUAL(356, lv_anim_path_linear(&a));
+    a.act_time = 1000;
+    TEST_ASSERT_EQUAL(1124, lv_anim_path_bounce(&a));
+}
+
+void test_anim_run_to_the_end(void)
+{
+    start(&values[0], 100, 100, lv_anim_path_linear);
+    start(&values[1], 200, 200, lv_anim_path_ease_out);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    step(50);
+    TEST_ASSERT_EQUAL(50, values[0]);
+    step(50);
+    TEST_ASSERT_EQUAL(100, values[0]);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    step(100);
+    TEST_ASSERT_EQUAL(200, values[1]);
+    TEST_ASSERT_EQUAL(2, ready_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+/*Deleting and starting animations in the callbacks doesn't restart the others*/
+void test_anim_change_in_callback(void)
+{
+    start(&values[0], 100, 100, lv_anim_path_linear);
+    start(&values[1], 100, 200, lv_anim_path_linear);
+    start(&values[3], 100, 100, lv_anim_path_linear);
+
+    /*The first ready animation deletes `values[1]`'s and starts `values[2]`'s*/
+    to_delete = &values[1];
+    start_in_ready = true;
+    step(100);
+    TEST_ASSERT_EQUAL(2, ready_cnt);
+    TEST_ASSERT_EQUAL(100, values[0]);
+    TEST_ASSERT_EQUAL(100, values[3]);
+    TEST_ASSERT_NULL(lv_anim_get(&values[1], exec_cb));
+    int32_t v1 = values[1];
+
+    /*Started in this round so it starts running only in the next*/
+    TEST_ASSERT_NOT_NULL(lv_anim_get(&values[2], exec_cb));
+    TEST_ASSERT_EQUAL(0, values[2]);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    to_delete = NULL;
+    start_in_ready = false;
+    step(50);
+    TEST_ASSERT_EQUAL(50, values[2]);
+    TEST_ASSERT_EQUAL(v1, values[1]);
+}
+
+void test_anim_del_in_exec_cb(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &values[0]);
+    lv_anim_set_exec_cb(&a, del_self_exec_cb);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_start(&a);
+
+    step(60);
+    TEST_ASSERT_EQUAL(59, values[0]);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+
+    /*The ready callback isn't called for deleted animations*/
+    step(60);
+    TEST_ASSERT_EQUAL(59, values[0]);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+}
+
+void test_anim_playback_repeat(void)
+{
+    lv_anim_t * a = start(&values[0], 100, 100, lv_anim_path_linear);
+    lv_anim_set_playback_time(a, 100);
+    lv_anim_set_repeat_count(a, 2);
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        step(100);
+        TEST_ASSERT_EQUAL(100, values[0]);
+        step(100);
+        TEST_ASSERT_EQUAL(0, values[0]);
+    }
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL_PTR(a, ready_anim);
+}
+
+/*Many animations are stored in more blocks which are freed when the animations are ready*/
+void test_anim_many(void)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+#endif
+
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        TEST_ASSERT_NOT_NULL(start(&values[i], i, 10 + i, i % 2 ? lv_anim_path_ease_in_out : lv_anim_path_linear));
+    }
+    TEST_ASSERT_EQUAL(200, lv_anim_count_running());
+
+    /*Delete every third in the middle*/
+    step(50);
+    for(i = 0; i < 200; i += 3) lv_anim_del(&values[i], exec_cb);
+
+    while(lv_anim_count_running()) step(10);
+    for(i = 0; i < 200; i++) {
+        if(i % 3) TEST_ASSERT_EQUAL(i, values[i]);
+    }
+
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(mon1.free_size, mon2.free_size);
+#endif
+}
+
+/*An object changed by 2 animations is invalidated only once. It's moved later by the layout update.*/
+void test_anim_inv_batch(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 50, 50);
+    lv_obj_set_style_border_width(obj, 0, 0);
+    lv_obj_set_style_shadow_width(obj, 0, 0);
+    lv_obj_set_style_outline_width(obj, 0, 0);
+    lv_refr_now(NULL);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, x_exec_cb);
+    lv_anim_start(&a);
+    lv_anim_set_exec_cb(&a, y_exec_cb);
+    lv_anim_start(&a);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_refr_reset_inv_stats(disp);
+    step(10);
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(disp, &stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.batch_join_cnt);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_EQUAL(0, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL(0, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL(49, disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL(49, disp->inv_areas[0].y2);
+}
+
+#endif
@@ -0,0 +1,178 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+#define FRAME_CNT   18
+
+LV_IMG_DECLARE(SPACE_1)
+LV_IMG_DECLARE(SPACE_2)
+LV_IMG_DECLARE(SPACE_3)
+LV_IMG_DECLARE(SPACE_4)
+LV_IMG_DECLARE(SPACE_5)
+LV_IMG_DECLARE(SPACE_6)
+LV_IMG_DECLARE(SPACE_7)
+LV_IMG_DECLARE(SPACE_8)
+LV_IMG_DECLARE(SPACE_9)
+LV_IMG_DECLARE(SPACE_10)
+LV_IMG_DECLARE(SPACE_11)
+LV_IMG_DECLARE(SPACE_12)
+LV_IMG_DECLARE(SPACE_13)
+LV_IMG_DECLARE(SPACE_14)
+LV_IMG_DECLARE(SPACE_15)
+LV_IMG_DECLARE(SPACE_16)
+LV_IMG_DECLARE(SPACE_17)
+LV_IMG_DECLARE(SPACE_18)
+
+static const lv_img_dsc_t * frames[FRAME_CNT] = {
+    &SPACE_1, &SPACE_2, &SPACE_3, &SPACE_4, &SPACE_5, &SPACE_6, &SPACE_7, &SPACE_8, &SPACE_9,
+    &SPACE_10, &SPACE_11, &SPACE_12, &SPACE_13, &SPACE_14, &SPACE_15, &SPACE_16, &SPACE_17, &SPACE_18,
+};
+
+#if LV_USE_ANIMIMG
+extern const lv_animimg_delta_dsc_t space_anim;
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+/*Go to a frame as the animation would*/
+static void frame_set(lv_obj_t * animimg, int32_t id)
+{
+    lv_animimg_t * a = (lv_animimg_t *)animimg;
+    a->anim.exec_cb(animimg, id);
+}
+
+/*`test_fb` has the whole screen only if the whole screen is redrawn*/
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Render the screen with the original image of the frame instead of the animation image*/
+static void ref_render(lv_obj_t * animimg, int32_t id)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, frames[id]);
+    lv_obj_set_pos(img, lv_obj_get_x(animimg), lv_obj_get_y(animimg));
+    lv_obj_add_flag(animimg, LV_OBJ_FLAG_HIDDEN);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_obj_del(img);
+    lv_obj_clear_flag(animimg, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void assert_frame(lv_obj_t * animimg, int32_t id)
+{
+    ref_render(animimg, id);
+    frame_set(animimg, id);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+#endif
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_animimg_delta_decode(void)
+{
+#if LV_USE_ANIMIMG
+    static uint8_t buf[120 * 123 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    TEST_ASSERT_EQUAL(FRAME_CNT, space_anim.frame_cnt);
+    TEST_ASSERT_EQUAL(sizeof(buf), frames[0]->data_size);
+
+    /*Twice to decode the first frame on the last*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t i;
+        for(i = 0; i < FRAME_CNT; i++) {
+            lv_animimg_delta_decode(&space_anim, i, buf);
+            TEST_ASSERT_EQUAL_MEMORY(frames[i]->data, buf, sizeof(buf));
+        }
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_animimg_delta_same_screen(void)
+{
+#if LV_USE_ANIMIMG
+    lv_obj_t * animimg = lv_animimg_create(lv_scr_act());
+    lv_obj_set_pos(animimg, 30, 20);
+    lv_animimg_set_delta_src(animimg, &space_anim);
+    lv_refr_now(NULL);
+
+    /*Forward, repeat, and seeking back*/
+    uint32_t i;
+    for(i = 1; i < FRAME_CNT; i++) assert_frame(animimg, i);
+    assert_frame(animimg, 0);
+    assert_frame(animimg, 5);
+    assert_frame(animimg, 2);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_animimg_delta_invalidate_changed_area(void)
+{
+#if LV_USE_ANIMIMG
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * animimg = lv_animimg_create(lv_scr_act());
+    lv_obj_set_pos(animimg, 30, 20);
+    lv_animimg_set_delta_src(animimg, &space_anim);
+    lv_refr_now(NULL);
+
+    const lv_animimg_delta_frame_t * frame = &space_anim.frames[9];
+    lv_area_t area;
+    lv_area_set(&area, 30 + frame->x, 20 + frame->y, 30 + frame->x + frame->w - 1, 20 + frame->y + frame->h - 1);
+    TEST_ASSERT_LESS_THAN(space_anim.header.w, frame->w);
+
+    frame_set(animimg, 8);
+    lv_refr_now(NULL);
+    frame_set(animimg, 9);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_EQUAL_MEMORY(&area, &disp->inv_areas[0], sizeof(lv_area_t));
+    lv_refr_now(NULL);
+
+    /*The whole image is redrawn if it's zoomed*/
+    lv_img_set_zoom(animimg, 512);
+    lv_refr_now(NULL);
+    frame_set(animimg, 10);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    lv_obj_get_coords(animimg, &area);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&area, &disp->inv_areas[0], 0));
+    lv_refr_now(NULL);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_animimg_delta_set_src(void)
+{
+#if LV_USE_ANIMIMG
+    lv_obj_t * animimg = lv_animimg_create(lv_scr_act());
+    lv_animimg_set_delta_src(animimg, &space_anim);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(120, lv_obj_get_width(animimg));
+    TEST_ASSERT_EQUAL(123, lv_obj_get_height(animimg));
+
+    /*Back to the normal image sequence frees the frame buffer*/
+    lv_animimg_set_src(animimg, (lv_img_dsc_t **)frames, FRAME_CNT);
+    ref_render(animimg, 0);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
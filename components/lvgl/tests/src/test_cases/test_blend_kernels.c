@@ -0,0 +1,172 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define LINE_MAX_W  67
+#define SCREEN_PX   (800 * 480)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_DRAW_SW_BLEND_KERNELS
+    lv_draw_sw_blend_set_kernels(NULL);
+#endif
+}
+
+#if LV_DRAW_SW_BLEND_KERNELS
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[SCREEN_PX];
+
+static lv_color_t src[LINE_MAX_W];
+static lv_color_t dest_ref[LINE_MAX_W];
+static lv_color_t dest_act[LINE_MAX_W];
+static lv_opa_t mask[LINE_MAX_W];
+
+static const lv_opa_t opa_values[] = {LV_OPA_MIN + 1, 17, LV_OPA_50, 200, LV_OPA_MAX - 1, LV_OPA_MAX, 254, LV_OPA_COVER};
+
+static lv_color_t rand_color(void)
+{
+    return lv_color_make(lv_rand(0, 255), lv_rand(0, 255), lv_rand(0, 255));
+}
+
+/*Random values with runs of fully transparent and fully covering parts*/
+static void fill_line(int32_t w)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        src[x] = rand_color();
+        dest_ref[x] = rand_color();
+        dest_act[x] = dest_ref[x];
+
+        uint32_t part = (x / 8) % 4;
+        if(part == 0) mask[x] = LV_OPA_TRANSP;
+        else if(part == 1) mask[x] = LV_OPA_COVER;
+        else if(part == 2) mask[x] = lv_rand(0, 1) ? LV_OPA_COVER : lv_rand(LV_OPA_MAX, 255);
+        else mask[x] = lv_rand(0, 255);
+    }
+}
+
+static void assert_same_as_basic(const lv_draw_sw_blend_kernels_t * kernels)
+{
+    const lv_draw_sw_blend_kernels_t * basic = &lv_draw_sw_blend_kernels_basic;
+    int32_t w;
+    uint32_t i;
+    for(w = 1; w <= LINE_MAX_W; w++) {
+        for(i = 0; i < sizeof(opa_values) / sizeof(opa_values[0]); i++) {
+            lv_opa_t opa = opa_values[i];
+            lv_color_t color = rand_color();
+
+            if(opa < LV_OPA_MAX) {
+                fill_line(w);
+                basic->fill_opa(dest_ref, w, color, opa);
+                kernels->fill_opa(dest_act, w, color, opa);
+                TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_act, w * sizeof(lv_color_t));
+
+                fill_line(w);
+                basic->map_opa(dest_ref, src, w, opa);
+                kernels->map_opa(dest_act, src, w, opa);
+                TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_act, w * sizeof(lv_color_t));
+            }
+
+            fill_line(w);
+            basic->fill_mask(dest_ref, w, color, mask, opa);
+            kernels->fill_mask(dest_act, w, color, mask, opa);
+            TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_act, w * sizeof(lv_color_t));
+
+            fill_line(w);
+            basic->map_mask(dest_ref, src, w, mask, opa);
+            kernels->map_mask(dest_act, src, w, mask, opa);
+            TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_act, w * sizeof(lv_color_t));
+        }
+    }
+}
+
+/*Everything is blended: transparent, masked, opaque fills and images*/
+static void create_ui(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_set_size(btn, 200, 100);
+    lv_obj_set_style_bg_opa(btn, LV_OPA_70, 0);
+    lv_obj_set_style_shadow_width(btn, 30, 0);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Blend");
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+
+    lv_obj_t * rect = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(rect, 300, 50);
+    lv_obj_set_size(rect, 200, 200);
+    lv_obj_set_style_radius(rect, 40, 0);
+    lv_obj_set_style_bg_grad_color(rect, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_dir(rect, LV_GRAD_DIR_HOR, 0);
+    lv_obj_set_style_opa(rect, LV_OPA_60, 0);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void test_blend_kernels_swar(void)
+{
+#if LV_DRAW_SW_BLEND_KERNELS
+    assert_same_as_basic(&lv_draw_sw_blend_kernels_swar);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_blend_kernels_simd(void)
+{
+#if LV_DRAW_SW_BLEND_KERNELS && LV_DRAW_SW_BLEND_SIMD
+    assert_same_as_basic(&lv_draw_sw_blend_kernels_simd);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_blend_kernels_default_is_the_fastest(void)
+{
+#if LV_DRAW_SW_BLEND_KERNELS
+#if LV_DRAW_SW_BLEND_SIMD
+    TEST_ASSERT_EQUAL_PTR(&lv_draw_sw_blend_kernels_simd, lv_draw_sw_blend_get_kernels());
+#else
+    TEST_ASSERT_EQUAL_PTR(&lv_draw_sw_blend_kernels_swar, lv_draw_sw_blend_get_kernels());
+#endif
+
+    lv_draw_sw_blend_set_kernels(&lv_draw_sw_blend_kernels_basic);
+    TEST_ASSERT_EQUAL_PTR(&lv_draw_sw_blend_kernels_basic, lv_draw_sw_blend_get_kernels());
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_blend_kernels_same_screen(void)
+{
+#if LV_DRAW_SW_BLEND_KERNELS
+    create_ui();
+
+    lv_draw_sw_blend_set_kernels(&lv_draw_sw_blend_kernels_basic);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_draw_sw_blend_set_kernels(NULL);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,196 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define RING_HOR_RES    100
+#define RING_VER_RES    100
+#define RING_BUF_ROWS   10
+#define RING_BUF_CNT    3
+
+typedef struct {
+    lv_area_t area;
+    lv_color_t * color_p;
+} pending_flush_t;
+
+static lv_color_t ring_bufs[RING_BUF_CNT][RING_HOR_RES * RING_BUF_ROWS];
+static lv_color_t ring_fb[RING_HOR_RES * RING_VER_RES];
+static lv_color_t ref_fb[RING_HOR_RES * RING_VER_RES];
+
+static pending_flush_t pending[LV_DISP_DRAW_BUF_MAX_NUM];
+static uint32_t pending_cnt;
+static uint32_t pending_max;
+static bool complete_newest_first;
+static bool complete_in_flush_cb;
+
+static lv_disp_drv_t ring_drv;
+static lv_disp_draw_buf_t ring_draw_buf;
+static lv_disp_t * ring_disp;
+static lv_disp_t * default_disp;
+
+/*Simulate the DMA: copy the buffer to the frame buffer only when the flush is completed*/
+static void complete_flush(uint32_t idx)
+{
+    pending_flush_t * p = &pending[idx];
+    lv_coord_t w = lv_area_get_width(&p->area);
+    lv_coord_t y;
+    for(y = p->area.y1; y <= p->area.y2; y++) {
+        lv_memcpy(&ring_fb[y * RING_HOR_RES + p->area.x1], &p->color_p[(y - p->area.y1) * w], w * sizeof(lv_color_t));
+    }
+
+    if(complete_newest_first) lv_disp_flush_ready_buf(&ring_drv, p->color_p);
+    else lv_disp_flush_ready(&ring_drv);
+
+    uint32_t i;
+    for(i = idx; i + 1 < pending_cnt; i++) pending[i] = pending[i + 1];
+    pending_cnt--;
+}
+
+static void ring_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(drv);
+    TEST_ASSERT_LESS_THAN(LV_DISP_DRAW_BUF_MAX_NUM, pending_cnt);
+    pending[pending_cnt].area = *area;
+    pending[pending_cnt].color_p = color_p;
+    pending_cnt++;
+    if(pending_cnt > pending_max) pending_max = pending_cnt;
+
+    if(complete_in_flush_cb) complete_flush(pending_cnt - 1);
+}
+
+static void ring_wait_cb(lv_disp_drv_t * drv)
+{
+    LV_UNUSED(drv);
+    if(pending_cnt == 0) return;
+    complete_flush(complete_newest_first ? pending_cnt - 1 : 0);
+}
+
+static void create_disp(uint32_t buf_cnt)
+{
+    void * bufs[RING_BUF_CNT];
+    uint32_t i;
+    for(i = 0; i < RING_BUF_CNT; i++) bufs[i] = ring_bufs[i];
+
+    lv_disp_draw_buf_init_ring(&ring_draw_buf, bufs, buf_cnt, RING_HOR_RES * RING_BUF_ROWS);
+
+    lv_disp_drv_init(&ring_drv);
+    ring_drv.draw_buf = &ring_draw_buf;
+    ring_drv.flush_cb = ring_flush_cb;
+    ring_drv.wait_cb = ring_wait_cb;
+    ring_drv.hor_res = RING_HOR_RES;
+    ring_drv.ver_res = RING_VER_RES;
+    ring_disp = lv_disp_drv_register(&ring_drv);
+
+    lv_disp_set_default(ring_disp);
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x102030), 0);
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 60, 70);
+    lv_obj_center(obj);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Ring");
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(ring_disp);
+    while(pending_cnt) ring_wait_cb(&ring_drv);
+}
+
+void setUp(void)
+{
+    default_disp = lv_disp_get_default();
+    pending_cnt = 0;
+    pending_max = 0;
+    complete_newest_first = false;
+    complete_in_flush_cb = false;
+    lv_memset_00(ring_fb, sizeof(ring_fb));
+}
+
+void tearDown(void)
+{
+    lv_disp_remove(ring_disp);
+    lv_disp_set_default(default_disp);
+}
+
+void test_draw_buf_ring_init(void)
+{
+    create_disp(RING_BUF_CNT);
+
+    TEST_ASSERT_EQUAL(RING_BUF_CNT, ring_draw_buf.ring_cnt);
+    TEST_ASSERT_EQUAL(RING_BUF_CNT - 1, ring_draw_buf.flush_max);
+    TEST_ASSERT_EQUAL_PTR(ring_bufs[0], ring_draw_buf.buf1);
+    TEST_ASSERT_EQUAL_PTR(ring_bufs[1], ring_draw_buf.buf2);
+    TEST_ASSERT_EQUAL_PTR(ring_bufs[0], ring_draw_buf.buf_act);
+}
+
+void test_draw_buf_ring_queues_flushes(void)
+{
+    create_disp(RING_BUF_CNT);
+    lv_refr_reset_flush_stats(ring_disp);
+
+    render();
+
+    lv_disp_flush_stats_t stats;
+    lv_refr_get_flush_stats(ring_disp, &stats);
+    TEST_ASSERT_EQUAL(RING_VER_RES / RING_BUF_ROWS, stats.flush_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.wait_cnt);
+
+    /*Two buffers were flushed while rendering into the third one*/
+    TEST_ASSERT_EQUAL(RING_BUF_CNT - 1, pending_max);
+}
+
+void test_draw_buf_ring_same_as_single_buffer(void)
+{
+    create_disp(1);
+    complete_in_flush_cb = true;
+    render();
+    TEST_ASSERT_EQUAL(1, pending_max);
+    lv_memcpy(ref_fb, ring_fb, sizeof(ref_fb));
+    lv_disp_remove(ring_disp);
+
+    /*A buffer must not be rendered again while it's waiting to be flushed*/
+    complete_in_flush_cb = false;
+    lv_memset_00(ring_fb, sizeof(ring_fb));
+    create_disp(RING_BUF_CNT);
+    render();
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, ring_fb, sizeof(ref_fb));
+}
+
+void test_draw_buf_ring_out_of_order_ready(void)
+{
+    create_disp(1);
+    complete_in_flush_cb = true;
+    render();
+    lv_memcpy(ref_fb, ring_fb, sizeof(ref_fb));
+    lv_disp_remove(ring_disp);
+
+    /*Complete the last flush first*/
+    complete_in_flush_cb = false;
+    complete_newest_first = true;
+    lv_memset_00(ring_fb, sizeof(ring_fb));
+    create_disp(RING_BUF_CNT);
+    render();
+
+    TEST_ASSERT_EQUAL(0, ring_draw_buf.flushing);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, ring_fb, sizeof(ref_fb));
+}
+
+void test_draw_buf_double_buffer_flushes_one_at_a_time(void)
+{
+    void * bufs[2] = {ring_bufs[0], ring_bufs[1]};
+    create_disp(RING_BUF_CNT);
+    lv_disp_draw_buf_init(&ring_draw_buf, bufs[0], bufs[1], RING_HOR_RES * RING_BUF_ROWS);
+
+    render();
+
+    TEST_ASSERT_EQUAL(1, ring_draw_buf.flush_max);
+    TEST_ASSERT_EQUAL(1, pending_max);
+}
+
+#endif
@@ -0,0 +1,199 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_FONT_COMPRESSED
+    lv_font_fmt_txt_set_bitmap_cache_size(LV_FONT_BITMAP_CACHE_SIZE);
+#endif
+}
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+
+#define FONT        (&lv_font_montserrat_28_compressed)
+#define BITMAP_MAX  (64 * 64 / 2)
+#define CACHE_SIZE  (8U * 1024U)  /*LV_FONT_BITMAP_CACHE_SIZE can be 0*/
+
+static uint8_t ref_bitmaps[128][BITMAP_MAX];
+
+/*The decompressed bitmaps are 4 bpp even with 3 bpp fonts*/
+static uint32_t bitmap_size(uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(FONT, &g, letter, 0)) return 0;
+    uint32_t size = (g.box_w * g.box_h + 1) / 2;
+    TEST_ASSERT_LESS_OR_EQUAL(BITMAP_MAX, size);
+    return size;
+}
+
+/*Decompress the ASCII letters without the cache*/
+static void ref_bitmaps_create(void)
+{
+    lv_font_fmt_txt_set_bitmap_cache_size(0);
+
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(FONT, letter);
+        if(bitmap) lv_memcpy(ref_bitmaps[letter], bitmap, bitmap_size(letter));
+    }
+
+    lv_font_fmt_txt_set_bitmap_cache_size(CACHE_SIZE);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void test_font_bitmap_cache_hit(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    lv_font_fmt_txt_bitmap_cache_stats_t stats;
+    lv_font_fmt_txt_set_bitmap_cache_size(CACHE_SIZE);
+    lv_font_fmt_txt_drop_bitmap_cache(NULL);
+    lv_font_fmt_txt_reset_bitmap_cache_stats();
+
+    const uint8_t * bitmap1 = lv_font_get_glyph_bitmap(FONT, 'A');
+    const uint8_t * bitmap2 = lv_font_get_glyph_bitmap(FONT, 'A');
+    TEST_ASSERT_NOT_NULL(bitmap1);
+    TEST_ASSERT_EQUAL_PTR(bitmap1, bitmap2);
+
+    lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(bitmap_size('A'), stats.mem_used);
+
+    lv_font_fmt_txt_drop_bitmap_cache(FONT);
+    lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_bitmap_cache_same_bitmaps(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    ref_bitmaps_create();
+
+    /*The first round decompresses into the cache, the second reads the cached bitmaps*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t letter;
+        for(letter = 0x21; letter < 0x7F; letter++) {
+            const uint8_t * bitmap = lv_font_get_glyph_bitmap(FONT, letter);
+            if(bitmap) TEST_ASSERT_EQUAL_MEMORY(ref_bitmaps[letter], bitmap, bitmap_size(letter));
+        }
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_bitmap_cache_valid_in_frame(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    ref_bitmaps_create();
+
+    const uint32_t cache_size = 2048;
+    lv_font_fmt_txt_bitmap_cache_stats_t stats;
+    lv_font_fmt_txt_set_bitmap_cache_size(cache_size);
+    lv_font_fmt_txt_drop_bitmap_cache(NULL);
+
+    /*Get more bitmaps than the cache can hold. The cached ones have to be valid until the end of the frame,
+     *the others are decompressed into a temporary buffer*/
+    const uint8_t * bitmaps[128];
+    bool cached[128];
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+        uint32_t entry_cnt = stats.entry_cnt;
+        bitmaps[letter] = lv_font_get_glyph_bitmap(FONT, letter);
+        TEST_ASSERT_NOT_NULL(bitmaps[letter]);
+        TEST_ASSERT_EQUAL_MEMORY(ref_bitmaps[letter], bitmaps[letter], bitmap_size(letter));
+
+        lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+        cached[letter] = stats.entry_cnt > entry_cnt;
+        TEST_ASSERT_LESS_OR_EQUAL(cache_size, stats.mem_used);
+    }
+
+    TEST_ASSERT_TRUE(cached[0x21]);
+    TEST_ASSERT_FALSE(cached[0x7E]);
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        if(cached[letter]) TEST_ASSERT_EQUAL_MEMORY(ref_bitmaps[letter], bitmaps[letter], bitmap_size(letter));
+    }
+
+    /*In the next frame the bitmaps of the previous frame are dropped for the new letters*/
+    _lv_font_clean_up_fmt_txt();
+    lv_font_fmt_txt_reset_bitmap_cache_stats();
+    for(letter = 0x7E; letter >= 0x21; letter--) {
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(FONT, letter);
+        TEST_ASSERT_EQUAL_MEMORY(ref_bitmaps[letter], bitmap, bitmap_size(letter));
+    }
+    lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(cache_size, stats.mem_used);
+
+    lv_font_get_glyph_bitmap(FONT, 0x7E);
+    lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hit_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_bitmap_cache_same_screen(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    static lv_color_t ref_fb[SCREEN_PX];
+    extern lv_color_t test_fb[];
+    lv_font_fmt_txt_bitmap_cache_stats_t stats;
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 780);
+    lv_obj_set_style_text_font(label, FONT, 0);
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog. 0123456789\n"
+                      "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. !?#%&@\n"
+                      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.");
+
+    lv_font_fmt_txt_set_bitmap_cache_size(0);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*With parallel rendering the render threads share the cache*/
+    lv_font_fmt_txt_set_bitmap_cache_size(CACHE_SIZE);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_font_fmt_txt_reset_bitmap_cache_stats();
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_font_fmt_txt_get_bitmap_cache_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(CACHE_SIZE, stats.mem_used);
+
+    /*A smaller cache than the glyphs of a frame*/
+    lv_font_fmt_txt_set_bitmap_cache_size(1024);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
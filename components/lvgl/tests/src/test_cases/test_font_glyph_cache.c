@@ -0,0 +1,223 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+#define CMAP_MAX    8
+#define TEXT_MAX    (200 * 4 + 1)
+
+LV_FONT_DECLARE(city_30)
+
+static lv_font_fmt_txt_cmap_t ref_cmaps[CMAP_MAX];
+static lv_font_fmt_txt_dsc_t ref_dsc;
+static lv_font_t ref_font;
+
+/*The same font without cache and character map index*/
+static const lv_font_t * ref_font_create(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    TEST_ASSERT_LESS_OR_EQUAL(CMAP_MAX, dsc->cmap_num);
+
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        ref_cmaps[i] = dsc->cmaps[i];
+        ref_cmaps[i].unicode_list_index = NULL;
+    }
+
+    ref_dsc = *dsc;
+    ref_dsc.cmaps = ref_cmaps;
+    ref_dsc.cache = NULL;
+
+    ref_font = *font;
+    ref_font.dsc = &ref_dsc;
+    return &ref_font;
+}
+
+static void cache_clear(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    lv_memset_00(dsc->cache, sizeof(lv_font_fmt_txt_glyph_cache_t));
+}
+
+/*The CJK letters of the font (from U+4E00) as UTF-8*/
+static void cjk_text_create(const lv_font_t * font, char * buf, uint32_t letter_max)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    uint32_t len = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num && letter_max; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        if(cmap->unicode_list == NULL) continue;
+
+        uint32_t j;
+        for(j = 0; j < cmap->list_length && letter_max; j++) {
+            uint32_t letter = cmap->range_start + cmap->unicode_list[j];
+            if(letter < 0x4E00 || letter > 0xFFFF) continue;
+
+            buf[len++] = 0xE0 | (letter >> 12);
+            buf[len++] = 0x80 | ((letter >> 6) & 0x3F);
+            buf[len++] = 0x80 | (letter & 0x3F);
+            letter_max--;
+            /*Break the lines between the words*/
+            if(letter_max % 10 == 0) buf[len++] = ' ';
+        }
+    }
+    buf[len] = '\0';
+}
+
+static void assert_same_glyphs(const lv_font_t * font)
+{
+    const lv_font_t * ref = ref_font_create(font);
+
+    /*In the second round the glyph IDs come from the cache*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t letter;
+        for(letter = 1; letter < 0x10000; letter++) {
+            lv_font_glyph_dsc_t dsc;
+            lv_font_glyph_dsc_t dsc_ref;
+            lv_memset_00(&dsc, sizeof(dsc));
+            lv_memset_00(&dsc_ref, sizeof(dsc_ref));
+            bool found = lv_font_get_glyph_dsc(font, &dsc, letter, 0);
+            bool found_ref = lv_font_get_glyph_dsc(ref, &dsc_ref, letter, 0);
+            TEST_ASSERT_EQUAL(found_ref, found);
+            if(found) {
+                TEST_ASSERT_EQUAL(dsc_ref.adv_w, dsc.adv_w);
+                TEST_ASSERT_EQUAL(dsc_ref.box_w, dsc.box_w);
+                TEST_ASSERT_EQUAL(dsc_ref.box_h, dsc.box_h);
+                TEST_ASSERT_EQUAL(dsc_ref.ofs_x, dsc.ofs_x);
+                TEST_ASSERT_EQUAL(dsc_ref.ofs_y, dsc.ofs_y);
+                TEST_ASSERT_EQUAL_PTR(lv_font_get_glyph_bitmap(ref, letter), lv_font_get_glyph_bitmap(font, letter));
+            }
+        }
+    }
+}
+
+static void assert_index_valid(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    uint32_t indexed = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        if(cmap->unicode_list_index == NULL) continue;
+        indexed++;
+
+        uint32_t bucket_num = (cmap->range_length >> LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT) + 1;
+        uint32_t b;
+        for(b = 0; b <= bucket_num; b++) {
+            uint32_t below = 0;
+            while(below < cmap->list_length &&
+                  cmap->unicode_list[below] < (b << LV_FONT_FMT_TXT_CMAP_INDEX_SHIFT)) below++;
+            TEST_ASSERT_EQUAL(below, cmap->unicode_list_index[b]);
+        }
+        TEST_ASSERT_EQUAL(cmap->list_length, cmap->unicode_list_index[bucket_num]);
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, indexed);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_font_glyph_cache_same_glyphs_city_30(void)
+{
+    cache_clear(&city_30);
+    assert_same_glyphs(&city_30);
+}
+
+void test_font_glyph_cache_same_glyphs_simsun_16_cjk(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    cache_clear(&lv_font_simsun_16_cjk);
+    assert_same_glyphs(&lv_font_simsun_16_cjk);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_glyph_cache_cmap_index(void)
+{
+    assert_index_valid(&city_30);
+#if LV_FONT_SIMSUN_16_CJK
+    assert_index_valid(&lv_font_simsun_16_cjk);
+#endif
+}
+
+void test_font_glyph_cache_entry(void)
+{
+#if LV_FONT_GLYPH_ID_CACHE_SIZE
+    const lv_font_fmt_txt_dsc_t * dsc = city_30.dsc;
+    lv_font_fmt_txt_glyph_cache_t * cache = dsc->cache;
+    cache_clear(&city_30);
+
+    /*Two CJK letters with the same place in the cache*/
+    uint32_t letter1 = 0;
+    uint32_t letter2 = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmaps[0].list_length && letter2 == 0; i++) {
+        uint32_t letter = dsc->cmaps[0].range_start + dsc->cmaps[0].unicode_list[i];
+        if(letter < 0x4E00) continue;
+        if(letter1 == 0) letter1 = letter;
+        else if((letter & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1)) == (letter1 & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1))) letter2 = letter;
+    }
+    TEST_ASSERT_NOT_EQUAL(0, letter2);
+
+    uint32_t * entry = &cache->glyph_ids[letter1 & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1)];
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(&city_30, &g, letter1, 0);
+    TEST_ASSERT_EQUAL_HEX32(letter1 / LV_FONT_GLYPH_ID_CACHE_SIZE + 1, *entry >> 16);
+    uint32_t gid1 = *entry & 0xFFFF;
+    TEST_ASSERT_NOT_EQUAL(0, gid1);
+
+    lv_font_get_glyph_dsc(&city_30, &g, letter2, 0);
+    TEST_ASSERT_EQUAL_HEX32(letter2 / LV_FONT_GLYPH_ID_CACHE_SIZE + 1, *entry >> 16);
+    TEST_ASSERT_NOT_EQUAL(gid1, *entry & 0xFFFF);
+
+    /*The ASCII letters are in the same sparse character map so they are cached too*/
+    lv_font_get_glyph_dsc(&city_30, &g, '0', 0);
+    TEST_ASSERT_EQUAL_HEX32('0' / LV_FONT_GLYPH_ID_CACHE_SIZE + 1,
+                            cache->glyph_ids['0' & (LV_FONT_GLYPH_ID_CACHE_SIZE - 1)] >> 16);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_glyph_cache_same_screen(void)
+{
+    static lv_color_t ref_fb[SCREEN_PX];
+    static char text[TEXT_MAX];
+    extern lv_color_t test_fb[];
+
+    cjk_text_create(&city_30, text, 200);
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 780);
+    lv_label_set_text(label, text);
+
+    /*Render the reference without cache*/
+    lv_obj_set_style_text_font(label, ref_font_create(&city_30), 0);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*With parallel rendering the render threads use the cache too*/
+    cache_clear(&city_30);
+    lv_obj_set_style_text_font(label, &city_30, 0);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Again from the cache*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#endif
@@ -0,0 +1,356 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../lv_test_gif.h"
+#include <stdlib.h>
+
+#define HOR_RES     100
+#define VER_RES     80
+#define GIF_SIZE    50
+
+LV_IMG_DECLARE(hit)
+LV_IMG_DECLARE(img_bulb_gif)
+
+#if LV_USE_GIF
+/*A display which keeps the flushed areas at their places*/
+static lv_color_t disp_buf[HOR_RES * VER_RES];
+static lv_color_t screen[HOR_RES * VER_RES];
+static lv_color_t screen_full[HOR_RES * VER_RES];
+static lv_disp_t * disp;
+static lv_disp_t * disp_ori;
+
+/*`hit` without transparent pixels*/
+static uint8_t hit_opaque_map[16 * 1024];
+static lv_img_dsc_t hit_opaque;
+
+/*The canvas rendered like before converting the palette only once*/
+static uint8_t ref_canvas[GIF_SIZE * GIF_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t y;
+    lv_coord_t w = lv_area_get_width(area);
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void hit_opaque_create(void)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(hit_opaque_map), hit.data_size);
+    lv_memcpy(hit_opaque_map, hit.data, hit.data_size);
+
+    /*Clear the transparency flag of the graphic control extensions*/
+    uint32_t gce_cnt = 0;
+    uint32_t i;
+    for(i = 0; i + 3 < hit.data_size; i++) {
+        if(hit_opaque_map[i] == 0x21 && hit_opaque_map[i + 1] == 0xF9 && hit_opaque_map[i + 2] == 0x04) {
+            hit_opaque_map[i + 3] &= ~0x01;
+            gce_cnt++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0, gce_cnt);
+
+    hit_opaque = hit;
+    hit_opaque.data = hit_opaque_map;
+}
+
+/*Draw the frame on the reference canvas pixel by pixel with the palette of the GIF*/
+static void ref_canvas_update(gd_GIF * gif)
+{
+    uint32_t x;
+    uint32_t y;
+    for(y = gif->fy; y < (uint32_t)gif->fy + gif->fh; y++) {
+        for(x = gif->fx; x < (uint32_t)gif->fx + gif->fw; x++) {
+            uint8_t index = gif->frame[y * gif->width + x];
+            if(gif->gce.transparency && index == gif->gce.tindex) continue;
+            uint8_t * c = &gif->palette->colors[index * 3];
+            lv_color_t color = lv_color_make(c[0], c[1], c[2]);
+            uint8_t * px = &ref_canvas[(y * gif->width + x) * gif->px_size];
+            lv_memcpy(px, &color, LV_COLOR_SIZE / 8);
+            if(!gif->opaque) px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = 0xFF;
+        }
+    }
+}
+
+/*A file system driver with the GIF of `mem_file` as every file*/
+static const uint8_t * mem_file;
+static uint32_t mem_file_size;
+static uint32_t mem_file_pos;
+
+static void * mem_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(path);
+    LV_UNUSED(mode);
+    mem_file_pos = 0;
+    return &mem_file_pos;
+}
+
+static lv_fs_res_t mem_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t mem_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    if(btr > mem_file_size - mem_file_pos) btr = mem_file_size - mem_file_pos;
+    lv_memcpy(buf, &mem_file[mem_file_pos], btr);
+    mem_file_pos += btr;
+    if(br) *br = btr;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t mem_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    if(whence == LV_FS_SEEK_SET) mem_file_pos = pos;
+    else if(whence == LV_FS_SEEK_CUR) mem_file_pos += pos;
+    else mem_file_pos = mem_file_size + pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t mem_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    *pos_p = mem_file_pos;
+    return LV_FS_RES_OK;
+}
+
+static void mem_fs_init(void)
+{
+    static lv_fs_drv_t drv;
+    if(drv.letter) return;
+    lv_fs_drv_init(&drv);
+    drv.letter = 'M';
+    drv.open_cb = mem_open_cb;
+    drv.close_cb = mem_close_cb;
+    drv.read_cb = mem_read_cb;
+    drv.seek_cb = mem_seek_cb;
+    drv.tell_cb = mem_tell_cb;
+    lv_fs_drv_register(&drv);
+}
+
+/*Hash the color indices and the area of every frame until the end of the animation*/
+static uint32_t frames_hash(gd_GIF * gif, uint32_t * frame_cnt)
+{
+    TEST_ASSERT_NOT_NULL(gif);
+
+    uint32_t hash = 2166136261U;
+    *frame_cnt = 0;
+    while(gd_get_frame(gif) == 1) {
+        uint16_t area[4] = {gif->fx, gif->fy, gif->fw, gif->fh};
+        const uint8_t * bytes = (const uint8_t *)area;
+        uint32_t i;
+        for(i = 0; i < sizeof(area); i++) hash = (hash ^ bytes[i]) * 16777619U;
+        for(i = 0; i < (uint32_t)gif->width * gif->height; i++) hash = (hash ^ gif->frame[i]) * 16777619U;
+        (*frame_cnt)++;
+    }
+
+    gd_close_gif(gif);
+    return hash;
+}
+
+static void next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    lv_tick_inc(gifobj->gif->gce.delay * 10);
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+static void assert_same_canvas(const void * src, bool opaque)
+{
+    lv_obj_t * obj = lv_gif_create(lv_scr_act());
+    lv_gif_set_src(obj, src);
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    gd_GIF * gif = gifobj->gif;
+    TEST_ASSERT_EQUAL(opaque, gif->opaque);
+    TEST_ASSERT_EQUAL(opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA, gifobj->imgdsc.header.cf);
+
+    uint32_t canvas_size = GIF_SIZE * GIF_SIZE * gif->px_size;
+    lv_memcpy(ref_canvas, gif->canvas, canvas_size);
+
+    /*All the frames twice*/
+    uint32_t i;
+    for(i = 0; i < 52; i++) {
+        next_frame(obj);
+        ref_canvas_update(gif);
+        TEST_ASSERT_EQUAL_MEMORY(ref_canvas, gif->canvas, canvas_size);
+    }
+
+    lv_obj_del(obj);
+}
+#endif
+
+void setUp(void)
+{
+#if LV_USE_GIF
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+    lv_disp_draw_buf_init(&draw_buf, disp_buf, NULL, HOR_RES * VER_RES);
+    lv_disp_drv_init(&drv);
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    drv.hor_res = HOR_RES;
+    drv.ver_res = VER_RES;
+
+    disp_ori = lv_disp_get_default();
+    disp = lv_disp_drv_register(&drv);
+    lv_disp_set_default(disp);
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_GIF
+    lv_disp_remove(disp);
+    lv_disp_set_default(disp_ori);
+#endif
+}
+
+void test_gif_same_canvas(void)
+{
+#if LV_USE_GIF
+    assert_same_canvas(&hit, false);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_gif_same_canvas_opaque(void)
+{
+#if LV_USE_GIF
+    hit_opaque_create();
+    assert_same_canvas(&hit_opaque, true);
+#else
+    TEST_PASS();
+#endif
+}
+
+/*The hashes are the frames of the LZW decoder which read the codes bit by bit*/
+void test_gif_decode_corpus(void)
+{
+#if LV_USE_GIF
+    static const struct {
+        lv_test_gif_dsc_t dsc;
+        uint32_t hash;
+    } corpus[] = {
+        {{.w = 160, .h = 120, .frame_cnt = 4, .min_code_size = 8, .noise = true, .seed = 1}, 0x325B290B},
+        {{.w = 160, .h = 120, .frame_cnt = 3, .min_code_size = 8, .noise = true, .no_clear = true, .seed = 2}, 0xCBD12178},
+        {{.w = 97, .h = 61, .frame_cnt = 5, .min_code_size = 2, .interlace = true, .lct = true, .seed = 3}, 0x59313650},
+        {{.w = 200, .h = 150, .frame_cnt = 6, .min_code_size = 5, .no_clear = true, .seed = 4}, 0xF830654C},
+        {{.w = 64, .h = 48, .frame_cnt = 4, .min_code_size = 4, .noise = true, .interlace = true, .lct = true, .seed = 5}, 0x46C17153},
+        {{.w = 1, .h = 1, .frame_cnt = 2, .min_code_size = 2, .seed = 6}, 0x346A211A},
+    };
+
+    mem_fs_init();
+
+    uint32_t frame_cnt;
+    TEST_ASSERT_EQUAL_HEX32(0x90D6E08D, frames_hash(gd_open_gif_data(hit.data), &frame_cnt));
+    TEST_ASSERT_EQUAL(26, frame_cnt);
+    TEST_ASSERT_EQUAL_HEX32(0x11713DBE, frames_hash(gd_open_gif_data(img_bulb_gif.data), &frame_cnt));
+    TEST_ASSERT_EQUAL(113, frame_cnt);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+        uint32_t size;
+        uint8_t * data = lv_test_gif_create(&corpus[i].dsc, &size);
+        TEST_ASSERT_EQUAL_HEX32(corpus[i].hash, frames_hash(gd_open_gif_data(data), &frame_cnt));
+        TEST_ASSERT_EQUAL(corpus[i].dsc.frame_cnt, frame_cnt);
+
+        /*The sub-blocks are read differently from files*/
+        mem_file = data;
+        mem_file_size = size;
+        TEST_ASSERT_EQUAL_HEX32(corpus[i].hash, frames_hash(gd_open_gif_file("M:corpus.gif"), &frame_cnt));
+        free(data);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_gif_invalid_frame_area(void)
+{
+#if LV_USE_GIF
+    /*A 4x4 GIF whose frames are empty or don't fit on the canvas, except the last one*/
+#define FRAME(x, y, w, h) ',', x & 0xFF, x >> 8, y & 0xFF, y >> 8, w & 0xFF, w >> 8, h & 0xFF, h >> 8, 0x00, \
+        0x02, 0x02, 0x4C, 0x01, 0x00    /*clear, 1, stop*/
+    static const uint8_t data[] = {
+        'G', 'I', 'F', '8', '9', 'a', 0x04, 0x00, 0x04, 0x00, 0x80, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+        FRAME(0, 0, 0, 4),
+        FRAME(1, 0, 4, 0),
+        FRAME(2, 2, 3, 3),
+        FRAME(0, 1, 1, 4),
+        FRAME(0xFFFF, 0, 2, 1),
+        FRAME(3, 3, 1, 1),
+        ';'
+    };
+#undef FRAME
+
+    gd_GIF * gif = gd_open_gif_data(data);
+    TEST_ASSERT_NOT_NULL(gif);
+    uint8_t frame_ori[16];
+    lv_memcpy(frame_ori, gif->frame, sizeof(frame_ori));
+
+    /*The invalid frames are skipped without touching the frame*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(-1, gd_get_frame(gif));
+        TEST_ASSERT_EQUAL(0, gif->fw);
+        TEST_ASSERT_EQUAL(0, gif->fh);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(frame_ori, gif->frame, sizeof(frame_ori));
+
+    TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    TEST_ASSERT_EQUAL(3, gif->fx);
+    TEST_ASSERT_EQUAL(3, gif->fy);
+    TEST_ASSERT_EQUAL(1, gif->frame[15]);
+    TEST_ASSERT_EQUAL(0, gd_get_frame(gif));
+    gd_close_gif(gif);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_gif_invalidate_frame_area(void)
+{
+#if LV_USE_GIF
+    lv_obj_t * obj = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(obj, 20, 10);
+    lv_gif_set_src(obj, &hit);
+    lv_refr_now(disp);
+
+    gd_GIF * gif = ((lv_gif_t *)obj)->gif;
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        next_frame(obj);
+
+        /*Only the area of the frame*/
+        TEST_ASSERT_EQUAL(1, disp->inv_p);
+        lv_area_t area;
+        lv_area_set(&area, 20 + gif->fx, 10 + gif->fy, 20 + gif->fx + gif->fw - 1, 10 + gif->fy + gif->fh - 1);
+        TEST_ASSERT_EQUAL_MEMORY(&area, &disp->inv_areas[0], sizeof(lv_area_t));
+
+        /*The same as redrawing the whole screen*/
+        lv_refr_now(disp);
+        lv_memcpy(screen_full, screen, sizeof(screen));
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+        TEST_ASSERT_EQUAL_MEMORY(screen_full, screen, sizeof(screen));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
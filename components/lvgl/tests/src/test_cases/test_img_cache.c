@@ -0,0 +1,409 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_lru.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+#define IMG_SIZE    1000
+
+/*Tells the test decoder what to report*/
+typedef struct {
+    uint32_t decoded_size;
+    uint32_t time_to_open;
+} test_img_t;
+
+static lv_img_decoder_t * decoder;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+static lv_color_t pixels[4 * 4];
+
+static const test_img_t cheap = {IMG_SIZE, 1};
+static const test_img_t slow = {IMG_SIZE, 100};
+static const test_img_t huge = {IMG_SIZE * 100, 1};
+
+#define TEST_IMG(name, t) static const lv_img_dsc_t name = {.header.cf = LV_IMG_CF_RAW, .header.w = 4, .header.h = 4, .data = (const uint8_t *)&t, .data_size = sizeof(t)}
+TEST_IMG(img_a, cheap);
+TEST_IMG(img_b, cheap);
+TEST_IMG(img_c, cheap);
+TEST_IMG(img_d, cheap);
+TEST_IMG(img_slow, slow);
+TEST_IMG(img_huge, huge);
+
+static lv_res_t decoder_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return LV_RES_INV;
+    const lv_img_dsc_t * img = src;
+    if(img->header.cf != LV_IMG_CF_RAW) return LV_RES_INV;
+
+    *header = img->header;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    const test_img_t * t = (const test_img_t *)((const lv_img_dsc_t *)dsc->src)->data;
+    dsc->img_data = (const uint8_t *)pixels;
+    dsc->decoded_size = t->decoded_size;
+    dsc->time_to_open = t->time_to_open;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    LV_UNUSED(dsc);
+    close_cnt++;
+}
+
+/*Open and release an image as the drawing does and tell if it was found in the cache*/
+static bool img_hit(const void * src, lv_color_t color, int32_t frame_id)
+{
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    uint32_t hit_cnt = stats.hit_cnt;
+
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, color, frame_id);
+    TEST_ASSERT_NOT_NULL(entry);
+    _lv_img_cache_cleanup(entry);
+
+    lv_img_cache_get_stats(&stats);
+    return stats.hit_cnt != hit_cnt;
+}
+
+static bool hit(const void * src)
+{
+    return img_hit(src, lv_color_black(), 0);
+}
+
+/*The memory charged for an image of `IMG_SIZE` bytes*/
+static uint32_t entry_mem_size(void)
+{
+    lv_img_cache_stats_t stats;
+    lv_img_cache_invalidate_src(NULL);
+    hit(&img_a);
+    lv_img_cache_get_stats(&stats);
+    lv_img_cache_invalidate_src(NULL);
+    return stats.mem_used;
+}
+
+/*Make room for 2 images of `IMG_SIZE` bytes and reset the counters*/
+static void set_two_img_budget(void)
+{
+    uint32_t mem_size = entry_mem_size();
+    lv_img_cache_set_mem_size(mem_size * 2 + mem_size / 2);
+    lv_img_cache_reset_stats();
+    open_cnt = 0;
+    close_cnt = 0;
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, decoder_info);
+    lv_img_decoder_set_open_cb(decoder, decoder_open);
+    lv_img_decoder_set_close_cb(decoder, decoder_close);
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_reset_stats();
+    open_cnt = 0;
+    close_cnt = 0;
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_mem_size(LV_IMG_CACHE_MEM_SIZE);
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_decoder_delete(decoder);
+#endif
+}
+
+void test_img_cache_hit(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+
+    _lv_img_cache_entry_t * entry1 = _lv_img_cache_open(&img_a, lv_color_black(), 0);
+    _lv_img_cache_cleanup(entry1);
+    _lv_img_cache_entry_t * entry2 = _lv_img_cache_open(&img_a, lv_color_black(), 0);
+    _lv_img_cache_cleanup(entry2);
+    TEST_ASSERT_NOT_NULL(entry1);
+    TEST_ASSERT_EQUAL_PTR(entry1, entry2);
+    TEST_ASSERT_EQUAL(IMG_SIZE, entry1->dec_dsc.decoded_size);
+
+    /*Other frames and colors are cached separately*/
+    TEST_ASSERT_FALSE(img_hit(&img_a, lv_color_black(), 1));
+    TEST_ASSERT_FALSE(img_hit(&img_a, lv_color_white(), 0));
+    TEST_ASSERT_TRUE(img_hit(&img_a, lv_color_white(), 0));
+    TEST_ASSERT_FALSE(hit(&img_b));
+
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(4, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(4, stats.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * IMG_SIZE, stats.mem_used);
+    TEST_ASSERT_EQUAL(4, open_cnt);
+    TEST_ASSERT_EQUAL(0, close_cnt);
+
+    lv_img_cache_reset_stats();
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(4, stats.entry_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_mem_budget(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+    uint32_t mem_size = entry_mem_size();
+    set_two_img_budget();
+
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_FALSE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_c));
+
+    /*The least recently used image was closed*/
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(2 * mem_size, stats.mem_used);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+
+    TEST_ASSERT_TRUE(hit(&img_c));
+    TEST_ASSERT_TRUE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_TRUE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_c));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_entry_cnt(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+    lv_img_cache_set_mem_size(0);
+    lv_img_cache_set_size(2);
+
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_FALSE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_huge));
+
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_TRUE(hit(&img_huge));
+    TEST_ASSERT_TRUE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_a));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_keep_slow_img(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    set_two_img_budget();
+
+    /*The slow image is the least recently used but it's kept*/
+    TEST_ASSERT_FALSE(hit(&img_slow));
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_FALSE(hit(&img_b));
+    TEST_ASSERT_TRUE(hit(&img_slow));
+    TEST_ASSERT_FALSE(hit(&img_a));
+
+    /*Until it's not used while more images are opened than its time to open*/
+    uint32_t i;
+    for(i = 0; i < slow.time_to_open / 2; i++) {
+        TEST_ASSERT_FALSE(hit(i % 2 ? &img_c : &img_d));
+    }
+    TEST_ASSERT_TRUE(hit(&img_slow));
+
+    for(i = 0; i < slow.time_to_open + 10; i++) {
+        hit(i % 2 ? &img_c : &img_d);
+    }
+    TEST_ASSERT_FALSE(hit(&img_slow));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_pin(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    set_two_img_budget();
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin(&img_a, lv_color_black(), 0));
+    TEST_ASSERT_FALSE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_c));
+    TEST_ASSERT_FALSE(hit(&img_d));
+    TEST_ASSERT_TRUE(hit(&img_a));
+
+    /*Only the pinned images are cached: the others are opened for every draw*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin(&img_b, lv_color_black(), 0));
+    uint32_t close_prev = close_cnt;
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(&img_c, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_TRUE(entry->temp);
+    _lv_img_cache_cleanup(entry);
+    TEST_ASSERT_EQUAL(close_prev + 1, close_cnt);
+    TEST_ASSERT_TRUE(hit(&img_a));
+    TEST_ASSERT_TRUE(hit(&img_b));
+
+    /*Pins are counted*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin(&img_a, lv_color_black(), 0));
+    lv_img_cache_unpin(&img_a, lv_color_black(), 0);
+    lv_img_cache_unpin(&img_b, lv_color_black(), 0);
+    TEST_ASSERT_FALSE(hit(&img_c));
+    TEST_ASSERT_TRUE(hit(&img_a));
+    TEST_ASSERT_FALSE(hit(&img_b));
+
+    lv_img_cache_unpin(&img_a, lv_color_black(), 0);
+    TEST_ASSERT_FALSE(hit(&img_c));
+    TEST_ASSERT_FALSE(hit(&img_d));
+    TEST_ASSERT_FALSE(hit(&img_a));
+
+    /*An image larger than the budget can't be pinned*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_cache_pin(&img_huge, lv_color_black(), 0));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_too_large(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+    set_two_img_budget();
+
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_FALSE(hit(&img_b));
+    TEST_ASSERT_FALSE(hit(&img_huge));
+    TEST_ASSERT_FALSE(hit(&img_huge));
+    TEST_ASSERT_EQUAL(2, close_cnt);
+
+    /*The cached images were not closed for nothing*/
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_TRUE(hit(&img_a));
+    TEST_ASSERT_TRUE(hit(&img_b));
+#else
+    TEST_PASS();
+#endif
+}
+
+#if LV_IMG_CACHE_DEF_SIZE && LV_MEM_CUSTOM == 0
+static uint32_t lru_free_cnt;
+
+static void lru_value_free(void * v)
+{
+    LV_UNUSED(v);
+    lru_free_cnt++;
+}
+#endif
+
+void test_img_cache_lru_out_of_memory(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE && LV_MEM_CUSTOM == 0
+    static uint32_t value;
+    lv_lru_t * lru = lv_lru_new(1000, 10, lru_value_free, lv_mem_free);
+    TEST_ASSERT_NOT_NULL(lru);
+    lru_free_cnt = 0;
+
+    /*Use up the memory*/
+    static void * fill[512];
+    uint32_t fill_cnt = 0;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t size = mon.free_biggest_size;
+    while(size > 0 && fill_cnt < sizeof(fill) / sizeof(fill[0])) {
+        void * p = lv_mem_alloc(size);
+        if(p) fill[fill_cnt++] = p;
+        else size /= 2;
+    }
+
+    /*The value is neither stored nor freed*/
+    TEST_ASSERT_EQUAL(LV_LRU_OUT_OF_MEMORY, lv_lru_set(lru, "key", 4, &value, 10));
+    TEST_ASSERT_EQUAL(0, lru_free_cnt);
+
+    while(fill_cnt) lv_mem_free(fill[--fill_cnt]);
+
+    void * v;
+    lv_lru_get(lru, "key", 4, &v);
+    TEST_ASSERT_NULL(v);
+    TEST_ASSERT_EQUAL(LV_LRU_NO_ERROR, lv_lru_set(lru, "key", 4, &value, 10));
+    lv_lru_get(lru, "key", 4, &v);
+    TEST_ASSERT_EQUAL_PTR(&value, v);
+
+    lv_lru_free(lru);
+    TEST_ASSERT_EQUAL(1, lru_free_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_invalidate(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+
+    hit(&img_a);
+    img_hit(&img_a, lv_color_black(), 1);
+    hit(&img_b);
+
+    /*Every frame and color of the image*/
+    lv_img_cache_invalidate_src(&img_a);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(2, close_cnt);
+    TEST_ASSERT_FALSE(hit(&img_a));
+    TEST_ASSERT_TRUE(hit(&img_b));
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+    TEST_ASSERT_EQUAL(open_cnt, close_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_cache_draw(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_stats_t stats;
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_a);
+    lv_refr_now(NULL);
+
+    lv_img_cache_reset_stats();
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, open_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
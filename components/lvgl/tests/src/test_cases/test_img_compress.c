@@ -0,0 +1,351 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_img.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+
+#define SCREEN_PX   (800 * 480)
+#define PX_SIZE     LV_IMG_PX_SIZE_ALPHA_BYTE
+#define BIN_PATH    "/tmp/lv_test_img_compress.bin"
+
+LV_IMG_DECLARE(sunny)
+LV_IMG_DECLARE(cloud)
+LV_IMG_DECLARE(cloudd)
+LV_IMG_DECLARE(rain)
+
+static const lv_img_dsc_t * weather[] = {&sunny, &cloud, &cloudd, &rain};
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+/*4 different pixels*/
+static uint8_t px_a[PX_SIZE];
+static uint8_t px_b[PX_SIZE];
+static uint8_t px_c[PX_SIZE];
+static uint8_t px_d[PX_SIZE];
+
+static void put_px(uint8_t ** p, const uint8_t * px)
+{
+    lv_memcpy(*p, px, PX_SIZE);
+    *p += PX_SIZE;
+}
+
+static void put_u32(uint8_t ** p, uint32_t v)
+{
+    (*p)[0] = v & 0xFF;
+    (*p)[1] = (v >> 8) & 0xFF;
+    (*p)[2] = (v >> 16) & 0xFF;
+    (*p)[3] = v >> 24;
+    *p += 4;
+}
+
+/*Compare every line of a compressed image with the original. Read the lines backwards to switch blocks*/
+static void assert_lines(const lv_img_dsc_t * ori, const lv_img_dsc_t * img)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+
+    uint32_t line_size = ori->header.w * PX_SIZE;
+#if LV_IMG_DECOMPRESS_FULL
+    TEST_ASSERT_NOT_NULL(dsc.img_data);
+    TEST_ASSERT_EQUAL_MEMORY(ori->data, dsc.img_data, line_size * ori->header.h);
+#else
+    TEST_ASSERT_NULL(dsc.img_data);
+    static uint8_t buf[1024];
+    int32_t y;
+    for(y = ori->header.h - 1; y >= 0; y--) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, ori->header.w, buf));
+        TEST_ASSERT_EQUAL_MEMORY(ori->data + y * line_size, buf, line_size);
+
+        /*A part of the line*/
+        lv_coord_t x = y % ori->header.w;
+        lv_coord_t len = ori->header.w - x;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, x, y, len, buf));
+        TEST_ASSERT_EQUAL_MEMORY(ori->data + y * line_size + x * PX_SIZE, buf, len * PX_SIZE);
+    }
+#endif
+    TEST_ASSERT_GREATER_THAN(0, dsc.decoded_size);
+    lv_img_decoder_close(&dsc);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static lv_res_t open_and_read(const void * src)
+{
+    lv_img_decoder_dsc_t dsc;
+    lv_res_t res = lv_img_decoder_open(&dsc, src, lv_color_black(), 0);
+    if(res != LV_RES_OK) return res;
+
+    if(dsc.img_data == NULL) {
+        static uint8_t buf[1024];
+        lv_coord_t y;
+        for(y = 0; y < dsc.header.h && res == LV_RES_OK; y++) {
+            res = lv_img_decoder_read_line(&dsc, 0, y, dsc.header.w, buf);
+        }
+    }
+    lv_img_decoder_close(&dsc);
+    return res;
+}
+
+void setUp(void)
+{
+    lv_memset(px_a, 0x11, PX_SIZE);
+    lv_memset(px_b, 0x22, PX_SIZE);
+    lv_memset(px_c, 0x33, PX_SIZE);
+    lv_memset(px_d, 0x44, PX_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*A 3x2 image with 1 line per block: A A B / C C C*/
+void test_img_compress_rle_format(void)
+{
+    static uint8_t data[64];
+    uint8_t * p = data;
+    put_u32(&p, 1);
+    put_u32(&p, 0);
+    put_u32(&p, 2 + 2 * PX_SIZE);
+    put_u32(&p, 3 + 3 * PX_SIZE);
+    *p++ = 0x81;    /*2 times*/
+    put_px(&p, px_a);
+    *p++ = 0x00;    /*1 pixel*/
+    put_px(&p, px_b);
+    *p++ = 0x82;    /*3 times*/
+    put_px(&p, px_c);
+
+    lv_img_dsc_t img = {.header.w = 3, .header.h = 2, .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA_RLE,
+                        .data = data, .data_size = p - data
+                       };
+
+    static uint8_t ori_data[6 * PX_SIZE];
+    p = ori_data;
+    put_px(&p, px_a);
+    put_px(&p, px_a);
+    put_px(&p, px_b);
+    put_px(&p, px_c);
+    put_px(&p, px_c);
+    put_px(&p, px_c);
+    lv_img_dsc_t ori = {.header.w = 3, .header.h = 2, .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA, .data = ori_data};
+
+    assert_lines(&ori, &img);
+}
+
+/*A 4x2 image in one block with overlapping matches: A A A A / B C B C*/
+void test_img_compress_lz4_format(void)
+{
+    static uint8_t data[64];
+    uint8_t * p = data;
+    put_u32(&p, 2);
+    put_u32(&p, 0);
+    uint8_t * end = p;
+    put_u32(&p, 0);
+    uint8_t * block = p;
+    *p++ = (PX_SIZE << 4) | (3 * PX_SIZE - 4);  /*1 pixel of literals, the match is 3 pixels*/
+    put_px(&p, px_a);
+    *p++ = PX_SIZE;                             /*Offset: 1 pixel*/
+    *p++ = 0;
+    *p++ = (2 * PX_SIZE) << 4 | (2 * PX_SIZE - 4);  /*2 pixels of literals, the match is 2 pixels*/
+    put_px(&p, px_b);
+    put_px(&p, px_c);
+    *p++ = 2 * PX_SIZE;                         /*Offset: 2 pixels*/
+    *p++ = 0;
+    put_u32(&end, p - block);
+
+    lv_img_dsc_t img = {.header.w = 4, .header.h = 2, .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4,
+                        .data = data, .data_size = p - data
+                       };
+
+    static uint8_t ori_data[8 * PX_SIZE];
+    p = ori_data;
+    put_px(&p, px_a);
+    put_px(&p, px_a);
+    put_px(&p, px_a);
+    put_px(&p, px_a);
+    put_px(&p, px_b);
+    put_px(&p, px_c);
+    put_px(&p, px_b);
+    put_px(&p, px_c);
+    lv_img_dsc_t ori = {.header.w = 4, .header.h = 2, .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA, .data = ori_data};
+
+    assert_lines(&ori, &img);
+    LV_UNUSED(px_d);
+}
+
+void test_img_compress_weather_icons(void)
+{
+    const uint32_t lines[] = {1, 8, 64};
+    uint32_t i;
+    for(i = 0; i < sizeof(weather) / sizeof(weather[0]); i++) {
+        uint32_t l;
+        for(l = 0; l < sizeof(lines) / sizeof(lines[0]); l++) {
+            lv_img_dsc_t * rle = lv_test_img_compress(weather[i], LV_IMG_CF_TRUE_COLOR_ALPHA_RLE, lines[l]);
+            lv_img_dsc_t * lz4 = lv_test_img_compress(weather[i], LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, lines[l]);
+            TEST_ASSERT_LESS_THAN(weather[i]->data_size, rle->data_size);
+            TEST_ASSERT_LESS_THAN(weather[i]->data_size, lz4->data_size);
+
+            assert_lines(weather[i], rle);
+            assert_lines(weather[i], lz4);
+
+            lv_test_img_free(rle);
+            lv_test_img_free(lz4);
+        }
+    }
+}
+
+/*Draw the images clipped by the screen the same as the original*/
+void test_img_compress_draw(void)
+{
+    lv_img_dsc_t * lz4 = lv_test_img_compress(&sunny, LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, 8);
+    lv_img_dsc_t * rle = lv_test_img_compress(&rain, LV_IMG_CF_TRUE_COLOR_ALPHA_RLE, 8);
+
+    lv_obj_t * img1 = lv_img_create(lv_scr_act());
+    lv_obj_t * img2 = lv_img_create(lv_scr_act());
+    lv_obj_t * img3 = lv_img_create(lv_scr_act());
+    lv_obj_set_pos(img1, -10, -13);
+    lv_obj_set_pos(img2, 100, 50);
+    lv_obj_set_pos(img3, 780, 460);
+
+    lv_img_set_src(img1, &sunny);
+    lv_img_set_src(img2, &rain);
+    lv_img_set_src(img3, &sunny);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_img_set_src(img1, lz4);
+    lv_img_set_src(img2, rle);
+    lv_img_set_src(img3, lz4);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_obj_del(img1);
+    lv_obj_del(img2);
+    lv_obj_del(img3);
+    lv_img_cache_invalidate_src(NULL);
+    lv_test_img_free(lz4);
+    lv_test_img_free(rle);
+}
+
+void test_img_compress_file(void)
+{
+    lv_img_dsc_t * lz4 = lv_test_img_compress(&cloud, LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, 8);
+
+    FILE * f = fopen(BIN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint32_t header = LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4 | (cloud.header.w << 10) | (cloud.header.h << 21);
+    fwrite(&header, 4, 1, f);
+    fwrite(lz4->data, 1, lz4->data_size, f);
+    fclose(f);
+
+    lv_img_header_t info;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info("F:" BIN_PATH, &info));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, info.cf);
+    TEST_ASSERT_EQUAL(cloud.header.w, info.w);
+    TEST_ASSERT_EQUAL(cloud.header.h, info.h);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "F:" BIN_PATH, lv_color_black(), 0));
+    uint32_t line_size = cloud.header.w * PX_SIZE;
+    static uint8_t buf[1024];
+    int32_t y;
+    for(y = cloud.header.h - 1; y >= 0; y--) {
+        const uint8_t * line = dsc.img_data ? dsc.img_data + y * line_size : buf;
+        if(dsc.img_data == NULL) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, cloud.header.w, buf));
+        }
+        TEST_ASSERT_EQUAL_MEMORY(cloud.data + y * line_size, line, line_size);
+    }
+    lv_img_decoder_close(&dsc);
+
+    /*Truncated file*/
+    f = fopen(BIN_PATH, "wb");
+    fwrite(&header, 4, 1, f);
+    fwrite(lz4->data, 1, lz4->data_size - 10, f);
+    fclose(f);
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read("F:" BIN_PATH));
+
+    remove(BIN_PATH);
+    lv_test_img_free(lz4);
+}
+
+/*Broken images can't be opened or read but don't write out of the buffers*/
+void test_img_compress_invalid(void)
+{
+    lv_img_dsc_t * rle = lv_test_img_compress(&sunny, LV_IMG_CF_TRUE_COLOR_ALPHA_RLE, 8);
+    lv_img_dsc_t * lz4 = lv_test_img_compress(&sunny, LV_IMG_CF_TRUE_COLOR_ALPHA_LZ4, 8);
+    uint8_t * rle_data = (uint8_t *)rle->data;
+    uint8_t * lz4_data = (uint8_t *)lz4->data;
+    uint32_t ofs_size = ((sunny.header.h + 7) / 8 + 1) * 4;
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, open_and_read(rle));
+    TEST_ASSERT_EQUAL(LV_RES_OK, open_and_read(lz4));
+
+    /*Data missing from the end*/
+    rle->data_size--;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(rle));
+    rle->data_size++;
+
+    /*0 lines per block*/
+    rle_data[0] = 0;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(rle));
+    rle_data[0] = 8;
+
+    /*The first block ends earlier*/
+    rle_data[8]--;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(rle));
+    rle_data[8]++;
+
+    /*The offsets of the blocks are checked before decoding any of them*/
+    lv_img_decoder_dsc_t dsc;
+    uint8_t block_ofs_ori[4];
+    lv_memcpy(block_ofs_ori, &rle_data[8], 4);
+    rle_data[11] = 0x7F;    /*Beyond the end of the data*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dsc, rle, lv_color_black(), 0));
+    lv_memcpy(&rle_data[8], &rle_data[12], 4);
+    rle_data[8]++;          /*After the start of the next block*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dsc, rle, lv_color_black(), 0));
+    lv_memcpy(&rle_data[8], block_ofs_ori, 4);
+    TEST_ASSERT_EQUAL(LV_RES_OK, open_and_read(rle));
+
+    /*Too many pixels in a run*/
+    uint8_t * ctrl = rle_data + 4 + ofs_size;
+    uint8_t ctrl_ori = *ctrl;
+    *ctrl = 0xFF;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(rle));
+    *ctrl = ctrl_ori;
+
+    /*A match before the beginning of the block*/
+    uint8_t * token = lz4_data + 4 + ofs_size;
+    uint32_t lit_len = *token >> 4;
+    TEST_ASSERT_LESS_THAN(15, lit_len);
+    uint8_t * ofs = token + 1 + lit_len;
+    uint8_t ofs_ori = ofs[0];
+    ofs[0] = lit_len + 1;
+    ofs[1] = 0;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(lz4));
+    ofs[0] = 0;
+    TEST_ASSERT_EQUAL(LV_RES_INV, open_and_read(lz4));
+    ofs[0] = ofs_ori;
+    TEST_ASSERT_EQUAL(LV_RES_OK, open_and_read(lz4));
+
+    /*Drawing a broken image doesn't crash*/
+    ofs[0] = 0;
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, lz4);
+    render_screen();
+    lv_obj_del(img);
+    lv_img_cache_invalidate_src(NULL);
+
+    lv_test_img_free(rle);
+    lv_test_img_free(lz4);
+}
+
+#endif
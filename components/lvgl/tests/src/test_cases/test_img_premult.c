@@ -0,0 +1,282 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_img.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+LV_IMG_DECLARE(SPACE_1)
+LV_IMG_DECLARE(sunny)
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+typedef void (*style_cb_t)(lv_obj_t * obj);
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*The largest difference of the channels of the screen and `ref_fb`*/
+static uint32_t fb_diff_max(void)
+{
+    uint32_t diff_max = 0;
+    uint32_t i;
+    for(i = 0; i < SCREEN_PX; i++) {
+        int32_t diff[3];
+        diff[0] = LV_COLOR_GET_R(test_fb[i]) - LV_COLOR_GET_R(ref_fb[i]);
+        diff[1] = LV_COLOR_GET_G(test_fb[i]) - LV_COLOR_GET_G(ref_fb[i]);
+        diff[2] = LV_COLOR_GET_B(test_fb[i]) - LV_COLOR_GET_B(ref_fb[i]);
+        uint32_t c;
+        for(c = 0; c < 3; c++) {
+            uint32_t d = LV_ABS(diff[c]);
+            if(d > diff_max) diff_max = d;
+        }
+    }
+    return diff_max;
+}
+
+/*Draw `img` and its pre-multiplied copy in the same way and compare them*/
+static void assert_draw_close(const lv_img_dsc_t * img, style_cb_t style_cb, uint32_t tolerance)
+{
+    lv_img_dsc_t * premult = lv_test_img_premultiply(img);
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x3070a0), 0);
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 300);
+    lv_obj_set_style_bg_color(cont, lv_color_hex(0xe0c040), 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_t * obj = lv_img_create(cont);
+    lv_obj_set_pos(obj, 40, 30);
+    if(style_cb) style_cb(obj);
+
+    lv_img_set_src(obj, img);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_img_set_src(obj, premult);
+    render_screen();
+    TEST_ASSERT_LESS_OR_EQUAL(tolerance, fb_diff_max());
+
+    lv_obj_del(cont);
+    lv_test_img_free(premult);
+}
+
+static void style_opa(lv_obj_t * obj)
+{
+    lv_obj_set_style_img_opa(obj, LV_OPA_60, 0);
+}
+
+static void style_recolor(lv_obj_t * obj)
+{
+    lv_obj_set_style_img_recolor(obj, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_style_img_recolor_opa(obj, LV_OPA_30, 0);
+}
+
+#if LV_DRAW_COMPLEX
+/*With anti-aliasing the pre-multiplied colors are interpolated weighted by their alpha
+ *so the edges are different from the straight image. Compare the pixels without it.*/
+static void style_transform(lv_obj_t * obj)
+{
+    lv_img_set_angle(obj, 300);
+    lv_img_set_zoom(obj, 300);
+    lv_img_set_antialias(obj, false);
+}
+
+static void style_transform_90(lv_obj_t * obj)
+{
+    lv_img_set_angle(obj, 900);
+}
+
+static void style_mask(lv_obj_t * obj)
+{
+    /*The rounded corners of the parent are masked*/
+    lv_obj_t * cont = lv_obj_get_parent(obj);
+    lv_obj_set_style_radius(cont, 60, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_pos(obj, 0, 0);
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    /*The copies of the images can be allocated to the same address*/
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void test_img_premult_convert(void)
+{
+    lv_img_dsc_t * premult = lv_test_img_premultiply(&sunny);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT, premult->header.cf);
+    TEST_ASSERT_TRUE(lv_img_cf_has_alpha(premult->header.cf));
+    TEST_ASSERT_EQUAL(LV_IMG_PX_SIZE_ALPHA_BYTE * 8, lv_img_cf_get_px_size(premult->header.cf));
+    TEST_ASSERT_EQUAL(sunny.data_size, lv_img_buf_get_img_size(sunny.header.w, sunny.header.h, premult->header.cf));
+
+    /*The alpha bytes are kept, the colors are multiplied by them and can be restored approximately*/
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < sunny.header.h; y++) {
+        for(x = 0; x < sunny.header.w; x++) {
+            lv_opa_t a = lv_img_buf_get_px_alpha((lv_img_dsc_t *)&sunny, x, y);
+            TEST_ASSERT_EQUAL(a, lv_img_buf_get_px_alpha(premult, x, y));
+
+            lv_color_t c = lv_img_buf_get_px_color((lv_img_dsc_t *)&sunny, x, y, lv_color_black());
+            lv_color_t c_pm = lv_img_buf_get_px_color(premult, x, y, lv_color_black());
+            TEST_ASSERT_EQUAL_HEX32(lv_color_to32(_lv_img_buf_premult_color(c, a)), lv_color_to32(c_pm));
+            if(a == LV_OPA_COVER) TEST_ASSERT_EQUAL_HEX32(lv_color_to32(c), lv_color_to32(c_pm));
+            if(a >= LV_OPA_50) {
+                lv_color_t c_res = _lv_img_buf_unpremult_color(c_pm, a);
+                TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_R(c), LV_COLOR_GET_R(c_res));
+                TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_G(c), LV_COLOR_GET_G(c_res));
+                TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_B(c), LV_COLOR_GET_B(c_res));
+            }
+        }
+    }
+
+    /*Only `LV_IMG_CF_TRUE_COLOR_ALPHA` is converted*/
+    lv_img_buf_premultiply(premult);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT, premult->header.cf);
+
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(premult, &header));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT, header.cf);
+
+    lv_test_img_free(premult);
+}
+
+void test_img_premult_kernels(void)
+{
+#if LV_DRAW_SW_BLEND_KERNELS
+    static uint8_t src[256 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    static lv_color_t dest_ref[256];
+    static lv_color_t dest[256];
+
+    const lv_draw_sw_blend_kernels_t * kernels[] = {
+        &lv_draw_sw_blend_kernels_swar,
+#if LV_DRAW_SW_BLEND_SIMD
+        &lv_draw_sw_blend_kernels_simd,
+#endif
+    };
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_MAX + 1, LV_OPA_MAX, 200, 128, 1};
+
+    uint32_t seed = 12345;
+    uint32_t i;
+    for(i = 0; i < sizeof(src); i++) {
+        seed = seed * 1103515245 + 12345;
+        src[i] = seed >> 16;
+    }
+
+    /*Premultiply the random colors and add runs of transparent and opaque pixels*/
+    lv_img_dsc_t img;
+    lv_memset_00(&img, sizeof(img));
+    img.header.w = 256;
+    img.header.h = 1;
+    img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img.data = src;
+    for(i = 40; i < 60; i++) lv_img_buf_set_px_alpha(&img, i, 0, LV_OPA_TRANSP);
+    for(i = 100; i < 130; i++) lv_img_buf_set_px_alpha(&img, i, 0, LV_OPA_COVER);
+    lv_img_buf_premultiply(&img);
+
+    uint32_t k;
+    uint32_t o;
+    for(k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+            for(i = 0; i < 256; i++) {
+                seed = seed * 1103515245 + 12345;
+                dest[i].full = seed >> 8;
+                LV_COLOR_SET_A(dest[i], 0xFF);
+            }
+            lv_memcpy(dest_ref, dest, sizeof(dest));
+
+            /*Odd width to test the last pixel too*/
+            lv_draw_sw_blend_kernels_basic.map_premult(dest_ref, src, 255, opas[o]);
+            kernels[k]->map_premult(dest, src, 255, opas[o]);
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(dest_ref, dest, sizeof(dest), kernels[k]->name);
+        }
+    }
+
+    /*The opaque pixels are copied and the transparent ones are skipped*/
+    lv_memset_00(dest, sizeof(dest));
+    lv_draw_sw_blend_kernels_swar.map_premult(dest, src, 256, LV_OPA_COVER);
+    lv_color_t c = lv_img_buf_get_px_color(&img, 110, 0, lv_color_black());
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(c), lv_color_to32(dest[110]));
+    TEST_ASSERT_EQUAL_HEX32(0, dest[50].full);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_premult_draw(void)
+{
+    /*All pixels of the SPACE frames are opaque so they are copied*/
+    assert_draw_close(&SPACE_1, NULL, 1);
+    assert_draw_close(&sunny, NULL, 1);
+}
+
+void test_img_premult_draw_opa(void)
+{
+    assert_draw_close(&sunny, style_opa, 2);
+}
+
+void test_img_premult_draw_recolor(void)
+{
+    assert_draw_close(&sunny, style_recolor, 2);
+}
+
+void test_img_premult_draw_transform(void)
+{
+#if LV_DRAW_COMPLEX
+    assert_draw_close(&sunny, style_transform, 2);
+    assert_draw_close(&sunny, style_transform_90, 2);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_premult_draw_mask(void)
+{
+#if LV_DRAW_COMPLEX
+    assert_draw_close(&sunny, style_mask, 2);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_premult_snapshot(void)
+{
+#if LV_USE_SNAPSHOT
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 100, 80);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_70, 0);
+    lv_obj_set_style_radius(obj, 20, 0);
+    lv_obj_t * img = lv_img_create(obj);
+    lv_img_set_src(img, &sunny);
+
+    lv_img_dsc_t * snapshot = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_dsc_t * snapshot_pm = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_NOT_NULL(snapshot_pm);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA_PREMULT, snapshot_pm->header.cf);
+
+    lv_img_buf_premultiply(snapshot);
+    uint32_t size = lv_img_buf_get_img_size(snapshot->header.w, snapshot->header.h, snapshot->header.cf);
+    TEST_ASSERT_EQUAL_MEMORY(snapshot->data, snapshot_pm->data, size);
+
+    lv_snapshot_free(snapshot);
+    lv_snapshot_free(snapshot_pm);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
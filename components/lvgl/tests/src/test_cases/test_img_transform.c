@@ -0,0 +1,372 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+#define COLOR_RGB(c)    (lv_color_to32(c) & 0xFFFFFF)
+
+LV_IMG_DECLARE(sunny)
+
+#if LV_DRAW_COMPLEX
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+static const lv_img_cf_t cfs[] = {LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA, LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED,
+                                  LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_ALPHA_8BIT
+                                 };
+
+static lv_color_t cbuf[1024];
+static lv_opa_t abuf[1024];
+
+/*An image with random pixels. Some of them are transparent or chroma keyed.*/
+static lv_img_dsc_t * img_create(lv_img_cf_t cf, lv_coord_t w, lv_coord_t h)
+{
+    lv_img_dsc_t * img = lv_img_buf_alloc(w, h, cf);
+    TEST_ASSERT_NOT_NULL(img);
+
+    uint32_t seed = 12345;
+    uint32_t i;
+    for(i = 0; i < img->data_size; i++) {
+        seed = seed * 1103515245 + 12345;
+        ((uint8_t *)img->data)[i] = seed >> 16;
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA && (x + y) % 3 == 0) lv_img_buf_set_px_alpha(img, x, y, LV_OPA_TRANSP);
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA && (x + y) % 5 == 0) lv_img_buf_set_px_alpha(img, x, y, LV_OPA_COVER);
+            if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && (x * y) % 7 == 0) {
+                lv_img_buf_set_px_color(img, x, y, LV_COLOR_CHROMA_KEY);
+            }
+        }
+    }
+
+    return img;
+}
+
+static void transform_init(lv_img_transform_dsc_t * dsc, const lv_img_dsc_t * img, int16_t angle, uint16_t zoom,
+                           lv_coord_t pivot_x, lv_coord_t pivot_y, bool antialias)
+{
+    lv_memset_00(dsc, sizeof(lv_img_transform_dsc_t));
+    dsc->cfg.src = img->data;
+    dsc->cfg.src_w = img->header.w;
+    dsc->cfg.src_h = img->header.h;
+    dsc->cfg.cf = img->header.cf;
+    dsc->cfg.angle = angle;
+    dsc->cfg.zoom = zoom;
+    dsc->cfg.pivot_x = pivot_x;
+    dsc->cfg.pivot_y = pivot_y;
+    dsc->cfg.color = lv_color_hex(0x204080);
+    dsc->cfg.antialias = antialias;
+    _lv_img_buf_transform_init(dsc);
+}
+
+/*The transformed area of the image with some extra pixels around it*/
+static void transform_area(const lv_img_transform_dsc_t * dsc, lv_area_t * area)
+{
+    lv_point_t pivot = {dsc->cfg.pivot_x, dsc->cfg.pivot_y};
+    _lv_img_buf_get_transformed_area(area, dsc->cfg.src_w, dsc->cfg.src_h, dsc->cfg.angle, dsc->cfg.zoom, &pivot);
+    lv_area_increase(area, 3, 3);
+}
+
+/*Compare the lines with `_lv_img_buf_transform()` of every pixel*/
+static void assert_same_as_per_pixel(lv_img_transform_dsc_t * dsc)
+{
+    lv_area_t area;
+    transform_area(dsc, &area);
+    lv_coord_t len = lv_area_get_width(&area);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(abuf), len);
+
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        _lv_img_buf_transform_line(dsc, area.x1, y, len, cbuf, abuf);
+        lv_coord_t i;
+        for(i = 0; i < len; i++) {
+            bool ret = _lv_img_buf_transform(dsc, area.x1 + i, y);
+            lv_opa_t opa = ret ? dsc->res.opa : LV_OPA_TRANSP;
+            if(opa != abuf[i]) {
+                char msg[128];
+                lv_snprintf(msg, sizeof(msg), "cf %d, angle %d, zoom %d, aa %d, x %d, y %d", dsc->cfg.cf,
+                            dsc->cfg.angle, dsc->cfg.zoom, dsc->cfg.antialias, area.x1 + i, y);
+                TEST_ASSERT_EQUAL_MESSAGE(opa, abuf[i], msg);
+            }
+            if(opa) TEST_ASSERT_EQUAL_HEX32(COLOR_RGB(dsc->res.color), COLOR_RGB(cbuf[i]));
+        }
+    }
+}
+
+static int32_t floor_div(int32_t a, int32_t b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/*Compare the lines with copying the pixels rotated by `angle` and enlarged `zoom / 256` times*/
+static void assert_exact(lv_img_transform_dsc_t * dsc, const lv_img_dsc_t * img)
+{
+    TEST_ASSERT_EQUAL(1, dsc->tmp.exact);
+
+    lv_area_t area;
+    transform_area(dsc, &area);
+    lv_coord_t len = lv_area_get_width(&area);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(abuf), len);
+
+    int32_t zoom = dsc->cfg.zoom / LV_IMG_ZOOM_NONE;
+    lv_color_t chroma_key = LV_COLOR_CHROMA_KEY;
+    uint32_t visible_cnt = 0;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        _lv_img_buf_transform_line(dsc, area.x1, y, len, cbuf, abuf);
+        lv_coord_t i;
+        for(i = 0; i < len; i++) {
+            int32_t xz = floor_div(area.x1 + i - dsc->cfg.pivot_x, zoom);
+            int32_t yz = floor_div(y - dsc->cfg.pivot_y, zoom);
+            int32_t xs;
+            int32_t ys;
+            switch(dsc->cfg.angle) {
+                case 0:
+                    xs = xz;
+                    ys = yz;
+                    break;
+                case 900:
+                    xs = yz;
+                    ys = -xz;
+                    break;
+                case 1800:
+                    xs = -xz;
+                    ys = -yz;
+                    break;
+                default:
+                    xs = -yz;
+                    ys = xz;
+                    break;
+            }
+            xs += dsc->cfg.pivot_x;
+            ys += dsc->cfg.pivot_y;
+
+            lv_opa_t opa = LV_OPA_TRANSP;
+            lv_color_t color = lv_color_black();
+            if(xs >= 0 && xs < img->header.w && ys >= 0 && ys < img->header.h) {
+                lv_img_dsc_t * src = (lv_img_dsc_t *)img;
+                color = lv_img_buf_get_px_color(src, xs, ys, dsc->cfg.color);
+                opa = lv_img_buf_get_px_alpha(src, xs, ys);
+                if(img->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && color.full == chroma_key.full) opa = 0;
+            }
+            TEST_ASSERT_EQUAL(opa, abuf[i]);
+            if(opa) {
+                TEST_ASSERT_EQUAL_HEX32(COLOR_RGB(color), COLOR_RGB(cbuf[i]));
+                visible_cnt++;
+            }
+        }
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, visible_cnt);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw `img` transformed and `ref` (the transformed pixels of `img`) at `x_ref`, `y_ref` relative to `img`*/
+static void assert_draw(const lv_img_dsc_t * img, const lv_img_dsc_t * ref, int16_t angle, uint16_t zoom,
+                        lv_coord_t x_ref, lv_coord_t y_ref)
+{
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_obj_set_pos(obj, 100, 50);
+    lv_obj_set_style_img_recolor(obj, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_style_img_recolor_opa(obj, LV_OPA_30, 0);
+    lv_img_set_src(obj, ref);
+    lv_obj_set_pos(obj, 100 + x_ref, 50 + y_ref);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_img_set_src(obj, img);
+    lv_obj_set_pos(obj, 100, 50);
+    lv_img_set_antialias(obj, false);
+    lv_img_set_angle(obj, angle);
+    lv_img_set_zoom(obj, zoom);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_img_set_antialias(obj, true);
+    if(zoom == LV_IMG_ZOOM_NONE) {
+        render_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+
+    lv_obj_del(obj);
+}
+
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_img_transform_same_as_per_pixel(void)
+{
+#if LV_DRAW_COMPLEX
+    const int16_t angles[] = {0, 1, 123, 450, 899, 901, 1234, 1805, 2001, 2699, 3333};
+    const uint16_t zooms[] = {256, 100, 300, 512};
+
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_img_dsc_t * img = img_create(cfs[c], 23, 17);
+        uint32_t a;
+        for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            uint32_t z;
+            for(z = 0; z < sizeof(zooms) / sizeof(zooms[0]); z++) {
+                uint32_t aa;
+                for(aa = 0; aa < 2; aa++) {
+                    lv_img_transform_dsc_t dsc;
+                    transform_init(&dsc, img, angles[a], zooms[z], 11, 8, aa);
+                    if(dsc.tmp.exact) continue;
+                    assert_same_as_per_pixel(&dsc);
+
+                    transform_init(&dsc, img, angles[a], zooms[z], 0, 20, aa);
+                    assert_same_as_per_pixel(&dsc);
+                }
+            }
+        }
+        lv_img_buf_free(img);
+    }
+
+    lv_img_transform_dsc_t dsc;
+    transform_init(&dsc, &sunny, 300, 256, 20, 20, true);
+    assert_same_as_per_pixel(&dsc);
+    transform_init(&dsc, &sunny, 2345, 200, 10, 30, true);
+    assert_same_as_per_pixel(&dsc);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_transform_exact_rotation(void)
+{
+#if LV_DRAW_COMPLEX
+    const int16_t angles[] = {900, 1800, 2700};
+
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_img_dsc_t * img = img_create(cfs[c], 23, 17);
+        uint32_t a;
+        for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            lv_img_transform_dsc_t dsc;
+            transform_init(&dsc, img, angles[a], 256, 11, 8, true);
+            assert_exact(&dsc, img);
+            transform_init(&dsc, img, angles[a], 256, 3, 20, false);
+            assert_exact(&dsc, img);
+
+            /*The per-pixel transformation is exact too at 90 and 180 degrees without anti-aliasing
+             *(at 270 degrees it's off by one pixel on some lines due to the rounding of sin/cos)*/
+            if(angles[a] != 2700) assert_same_as_per_pixel(&dsc);
+        }
+        lv_img_buf_free(img);
+    }
+
+    /*Negative angles are the same*/
+    lv_img_transform_dsc_t dsc;
+    transform_init(&dsc, &sunny, -900, 256, 20, 20, true);
+    TEST_ASSERT_EQUAL(3, dsc.tmp.exact_rot);
+    dsc.cfg.angle = 2700;
+    assert_exact(&dsc, &sunny);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_img_transform_integer_zoom(void)
+{
+#if LV_DRAW_COMPLEX
+    const int16_t angles[] = {0, 900, 1800, 2700};
+    const uint16_t zooms[] = {512, 768, 1024};
+
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_img_dsc_t * img = img_create(cfs[c], 23, 17);
+        uint32_t a;
+        for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            uint32_t z;
+            for(z = 0; z < sizeof(zooms) / sizeof(zooms[0]); z++) {
+                lv_img_transform_dsc_t dsc;
+                transform_init(&dsc, img, angles[a], zooms[z], 11, 8, false);
+                assert_exact(&dsc, img);
+            }
+        }
+
+        /*Zooming by power of 2 gives the same as the per-pixel transformation*/
+        lv_img_transform_dsc_t dsc;
+        transform_init(&dsc, img, 0, 1024, 5, 2, false);
+        assert_same_as_per_pixel(&dsc);
+
+        /*Not exact with anti-aliasing*/
+        transform_init(&dsc, img, 0, 512, 5, 2, true);
+        TEST_ASSERT_EQUAL(0, dsc.tmp.exact);
+
+        lv_img_buf_free(img);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+/*Draw the weather icon rotated and zoomed the same as the rotated/zoomed copy of its pixels*/
+void test_img_transform_draw(void)
+{
+#if LV_DRAW_COMPLEX
+    /*The pivot is the center of the 41x41 icon so the rotated icon has the same area*/
+    lv_coord_t w = sunny.header.w;
+    lv_coord_t h = sunny.header.h;
+    TEST_ASSERT_EQUAL(w, h);
+    lv_coord_t c = w / 2;
+
+    lv_img_dsc_t * ref = lv_img_buf_alloc(w, h, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_dsc_t * ref2x = lv_img_buf_alloc(w * 2, h * 2, LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    const int16_t angles[] = {900, 1800, 2700};
+    uint32_t a;
+    for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_coord_t xs = angles[a] == 900 ? y : angles[a] == 1800 ? 2 * c - x : 2 * c - y;
+                lv_coord_t ys = angles[a] == 900 ? 2 * c - x : angles[a] == 1800 ? 2 * c - y : x;
+                lv_img_dsc_t * src = (lv_img_dsc_t *)&sunny;
+                lv_img_buf_set_px_color(ref, x, y, lv_img_buf_get_px_color(src, xs, ys, lv_color_black()));
+                lv_img_buf_set_px_alpha(ref, x, y, lv_img_buf_get_px_alpha(src, xs, ys));
+            }
+        }
+        assert_draw(&sunny, ref, angles[a], LV_IMG_ZOOM_NONE, 0, 0);
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h * 2; y++) {
+        for(x = 0; x < w * 2; x++) {
+            lv_img_dsc_t * src = (lv_img_dsc_t *)&sunny;
+            lv_img_buf_set_px_color(ref2x, x, y, lv_img_buf_get_px_color(src, x / 2, y / 2, lv_color_black()));
+            lv_img_buf_set_px_alpha(ref2x, x, y, lv_img_buf_get_px_alpha(src, x / 2, y / 2));
+        }
+    }
+    assert_draw(&sunny, ref2x, 0, 512, -c, -c);
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_buf_free(ref);
+    lv_img_buf_free(ref2x);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,127 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_disp_t * disp;
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    lv_refr_now(disp);
+    lv_refr_reset_inv_stats(disp);
+}
+
+void tearDown(void)
+{
+    _lv_inv_area(disp, NULL);
+}
+
+static void inv(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_area_t a;
+    lv_area_set(&a, x1, y1, x2, y2);
+    _lv_inv_area(disp, &a);
+}
+
+static bool is_covered(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_area_t a;
+    lv_area_set(&a, x1, y1, x2, y2);
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_in(&a, &disp->inv_areas[i], 0)) return true;
+    }
+    return false;
+}
+
+void test_inv_area_overlapping_are_joined(void)
+{
+    inv(10, 10, 109, 109);
+    inv(50, 50, 149, 149);
+
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(is_covered(10, 10, 149, 149));
+}
+
+void test_inv_area_inner_is_dropped(void)
+{
+    inv(10, 10, 109, 109);
+    inv(20, 20, 29, 29);
+
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_EQUAL(10, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL(109, disp->inv_areas[0].x2);
+}
+
+void test_inv_area_outer_absorbs_saved(void)
+{
+    inv(20, 20, 29, 29);
+    inv(200, 20, 209, 29);
+    inv(0, 0, 300, 100);
+
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(is_covered(0, 0, 300, 100));
+}
+
+void test_inv_area_distant_are_kept(void)
+{
+    inv(0, 0, 99, 99);
+    inv(500, 300, 599, 399);
+
+    TEST_ASSERT_EQUAL(2, disp->inv_p);
+}
+
+void test_inv_area_close_are_joined_by_cost(void)
+{
+    /*Two 1 px high lines next to each other: redrawing the gap is cheaper than one more flush*/
+    inv(0, 0, 99, 0);
+    inv(0, 2, 99, 2);
+
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(is_covered(0, 0, 99, 2));
+}
+
+void test_inv_area_overflow_joins_neighbours(void)
+{
+    /*Scatter more small areas than the buffer can hold*/
+    uint32_t i;
+    uint32_t cnt = LV_INV_BUF_SIZE + 8;
+    for(i = 0; i < cnt; i++) {
+        lv_coord_t x = (i % 8) * 100;
+        lv_coord_t y = (i / 8) * 60;
+        inv(x, y, x + 9, y + 9);
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL(LV_INV_BUF_SIZE, disp->inv_p);
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(disp, &stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.overflow_cnt);
+
+    /*Every area is still invalidated, but not the whole screen*/
+    for(i = 0; i < cnt; i++) {
+        lv_coord_t x = (i % 8) * 100;
+        lv_coord_t y = (i / 8) * 60;
+        TEST_ASSERT_TRUE(is_covered(x, y, x + 9, y + 9));
+    }
+    TEST_ASSERT_FALSE(is_covered(0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1));
+}
+
+void test_inv_area_stats(void)
+{
+    inv(0, 0, 99, 99);
+    inv(50, 0, 149, 99);
+    inv(600, 400, 619, 419);
+
+    lv_refr_now(disp);
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(disp, &stats);
+    TEST_ASSERT_EQUAL(100 * 100 + 100 * 100 + 20 * 20, stats.inv_px);
+    TEST_ASSERT_EQUAL(150 * 100 + 20 * 20, stats.refr_px);
+    TEST_ASSERT_EQUAL(2, stats.refr_area_cnt);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+}
+
+#endif
@@ -0,0 +1,302 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+/*Only the top left part is compared as the monitors can be shown at the bottom*/
+#define CMP_W       400
+#define CMP_H       300
+
+/*Enough for all layers of the tests*/
+#define CACHE_SIZE  (512 * 1024)
+
+void setUp(void)
+{
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_set_size(CACHE_SIZE);
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_set_size(LV_LAYER_CACHE_SIZE);
+    lv_layer_cache_reset_stats();
+#endif
+}
+
+#if LV_USE_LAYER_CACHE
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[SCREEN_PX];
+
+static lv_obj_t * create_layer(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_LAYER_CACHE);
+    return obj;
+}
+
+/*Lines and a label on a transparent layer as on the desktop*/
+static lv_obj_t * create_grid(lv_obj_t ** label)
+{
+    static lv_point_t points[3][2] = {{{5, 20}, {235, 20}}, {{65, 20}, {65, 100}}, {{5, 100}, {235, 100}}};
+
+    lv_obj_t * layer = create_layer(10, 10, 240, 110);
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * line = lv_line_create(layer);
+        lv_line_set_points(line, points[i], 2);
+        lv_obj_set_style_line_width(line, 2, 0);
+        lv_obj_set_style_line_rounded(line, true, 0);
+    }
+
+    *label = lv_label_create(layer);
+    lv_obj_set_pos(*label, 80, 40);
+    lv_label_set_text(*label, "Transparent layer");
+    return layer;
+}
+
+/*A button on an opaque layer*/
+static lv_obj_t * create_panel(void)
+{
+    lv_obj_t * layer = create_layer(20, 150, 200, 100);
+    lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(layer, lv_color_hex(0x204060), 0);
+
+    lv_obj_t * btn = lv_btn_create(layer);
+    lv_obj_center(btn);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Opaque");
+    return layer;
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Render the screen without the layer cache as reference*/
+static void render_ref(lv_obj_t * layer1, lv_obj_t * layer2)
+{
+    if(layer1) lv_obj_clear_flag(layer1, LV_OBJ_FLAG_LAYER_CACHE);
+    if(layer2) lv_obj_clear_flag(layer2, LV_OBJ_FLAG_LAYER_CACHE);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    if(layer1) lv_obj_add_flag(layer1, LV_OBJ_FLAG_LAYER_CACHE);
+    if(layer2) lv_obj_add_flag(layer2, LV_OBJ_FLAG_LAYER_CACHE);
+}
+
+/*The anti-aliased pixels are blended twice from the layer so allow a small difference*/
+static void assert_fb_similar(void)
+{
+    uint32_t y;
+    for(y = 0; y < CMP_H; y++) {
+        uint32_t x;
+        for(x = 0; x < CMP_W; x++) {
+            lv_color32_t ref = {.full = lv_color_to32(ref_fb[y * 800 + x])};
+            lv_color32_t act = {.full = lv_color_to32(test_fb[y * 800 + x])};
+            TEST_ASSERT_INT_WITHIN(2, ref.ch.red, act.ch.red);
+            TEST_ASSERT_INT_WITHIN(2, ref.ch.green, act.ch.green);
+            TEST_ASSERT_INT_WITHIN(2, ref.ch.blue, act.ch.blue);
+        }
+    }
+}
+
+static void assert_fb_changed(void)
+{
+    uint32_t y;
+    for(y = 0; y < CMP_H; y++) {
+        if(memcmp(&ref_fb[y * 800], &test_fb[y * 800], CMP_W * sizeof(lv_color_t))) return;
+    }
+    TEST_FAIL_MESSAGE("the screen has not changed");
+}
+
+#endif
+
+void test_layer_cache_same_as_without(void)
+{
+#if LV_USE_LAYER_CACHE
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xe0c080), 0);
+
+    lv_obj_t * label;
+    lv_obj_t * grid = create_grid(&label);
+    lv_obj_t * panel = create_panel();
+    render_ref(grid, panel);
+
+    render_screen();
+    assert_fb_similar();
+
+    lv_layer_cache_stats_t stats;
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.layer_cnt);
+    TEST_ASSERT_EQUAL(2, stats.cached_cnt);
+    TEST_ASSERT_EQUAL(2, stats.render_cnt);
+
+    /*The transparent layer keeps the alpha channel, the opaque one is stored without it*/
+    uint32_t grid_size = lv_area_get_size(&grid->coords) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t panel_size = lv_area_get_size(&panel->coords) * sizeof(lv_color_t);
+    TEST_ASSERT_EQUAL(grid_size + panel_size, stats.mem_used);
+
+    /*Drawn from the cache*/
+    render_screen();
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.render_cnt);
+    assert_fb_similar();
+
+    /*Invalidating only a part of a cached layer draws the cached image too*/
+    lv_area_t a = {30, 20, 100, 60};
+    lv_obj_invalidate_area(lv_scr_act(), &a);
+    lv_refr_now(NULL);
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.render_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_layer_cache_rendered_again_on_change(void)
+{
+#if LV_USE_LAYER_CACHE
+    lv_obj_t * label;
+    lv_obj_t * grid = create_grid(&label);
+    lv_obj_t * panel = create_panel();
+    render_screen();
+    lv_layer_cache_reset_stats();
+
+    /*A child has changed: only its layer is rendered again*/
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_label_set_text(label, "Changed");
+    render_screen();
+    assert_fb_changed();
+
+    lv_layer_cache_stats_t stats;
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.render_cnt);
+
+    render_ref(grid, panel);
+    render_screen();
+    assert_fb_similar();
+
+    /*Style of the layer, size and hidden children*/
+    lv_obj_set_style_bg_color(panel, lv_color_hex(0x806040), 0);
+    lv_obj_set_height(grid, 80);
+    lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    render_ref(grid, panel);
+    lv_layer_cache_reset_stats();
+    render_screen();
+    assert_fb_similar();
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.render_cnt);
+
+    /*Moved layer: rendered again at the new position*/
+    lv_obj_set_pos(panel, 150, 170);
+    render_ref(grid, panel);
+    render_screen();
+    assert_fb_similar();
+
+    /*Cleared flag: drawn normally and the image is freed*/
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_LAYER_CACHE);
+    lv_obj_del(grid);
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.layer_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_layer_cache_budget(void)
+{
+#if LV_USE_LAYER_CACHE
+    lv_obj_t * layer1 = create_panel();
+    lv_obj_t * layer2 = create_panel();
+    lv_obj_set_x(layer2, 250);
+    lv_obj_t * label = lv_label_create(layer1);
+    lv_label_set_text(label, "1");
+
+    /*Room for one layer only*/
+    uint32_t size = lv_snapshot_buf_size_needed(layer1, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_layer_cache_set_size(size);
+
+    /*Both are visible: the first one doesn't fit and is drawn normally*/
+    render_ref(layer1, layer2);
+    render_screen();
+    assert_fb_similar();
+    lv_layer_cache_stats_t stats;
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.cached_cnt);
+    TEST_ASSERT_EQUAL(1, stats.skip_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(size, stats.mem_used);
+
+    TEST_ASSERT_TRUE(_lv_layer_cache_is_ready(layer1));
+
+    /*Only the second is drawn: the first is evicted*/
+    lv_layer_cache_reset_stats();
+    lv_obj_invalidate(layer2);
+    lv_refr_now(NULL);
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.render_cnt);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(1, stats.cached_cnt);
+    TEST_ASSERT_FALSE(_lv_layer_cache_is_ready(layer1));
+    TEST_ASSERT_TRUE(_lv_layer_cache_is_ready(layer2));
+
+    /*Too small for any layer*/
+    lv_layer_cache_set_size(size / 2);
+    render_screen();
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.cached_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+    assert_fb_similar();
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_layer_cache_nested(void)
+{
+#if LV_USE_LAYER_CACHE
+    lv_obj_t * outer = create_layer(0, 0, 300, 280);
+    lv_obj_set_style_bg_opa(outer, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(outer, lv_color_hex(0x4080c0), 0);
+    lv_obj_t * inner = create_panel();
+    lv_obj_set_parent(inner, outer);
+    lv_obj_t * label = lv_label_create(inner);
+    lv_label_set_text(label, "Inner");
+
+    render_ref(outer, inner);
+    render_screen();
+    assert_fb_similar();
+
+    /*A change in the inner layer invalidates the outer one too*/
+    lv_layer_cache_reset_stats();
+    lv_label_set_text(label, "Changed");
+    render_ref(outer, inner);
+    lv_layer_cache_reset_stats();
+    render_screen();
+    assert_fb_similar();
+
+    lv_layer_cache_stats_t stats;
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.render_cnt);
+
+    /*The inner one is not cached again after it's deleted with its parent*/
+    lv_obj_del(outer);
+    lv_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.layer_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
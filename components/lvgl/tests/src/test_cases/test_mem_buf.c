@@ -0,0 +1,149 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_mem_reset_max_used();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_mem_buf_monitor_t get_mon(void)
+{
+    lv_mem_buf_monitor_t mon;
+    lv_mem_buf_monitor(&mon);
+    return mon;
+}
+
+void test_mem_buf_released_in_reverse_order(void)
+{
+    uint8_t * a = lv_mem_buf_get(100);
+    uint8_t * b = lv_mem_buf_get(20);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_TRUE(b >= a + 100);
+    lv_memset(a, 0x11, 100);
+    lv_memset(b, 0x22, 20);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0x11, a, 100);
+
+    lv_mem_buf_release(b);
+    lv_mem_buf_release(a);
+
+    /*The same memory is used again*/
+    TEST_ASSERT_EQUAL_PTR(a, lv_mem_buf_get(50));
+    lv_mem_buf_release(a);
+
+    lv_mem_buf_monitor_t mon = get_mon();
+    TEST_ASSERT_EQUAL(LV_MEM_BUF_SIZE, mon.size);
+    TEST_ASSERT_GREATER_OR_EQUAL(120, mon.max_used);
+    TEST_ASSERT_EQUAL(0, mon.order_err_cnt);
+    TEST_ASSERT_EQUAL(0, mon.overflow_cnt);
+
+    TEST_ASSERT_NULL(lv_mem_buf_get(0));
+    lv_mem_buf_release(NULL);
+}
+
+void test_mem_buf_released_out_of_order(void)
+{
+    uint8_t * a = lv_mem_buf_get(16);
+    uint8_t * b = lv_mem_buf_get(16);
+
+    /*Can't be used again until `b` is released too*/
+    lv_mem_buf_release(a);
+    TEST_ASSERT_EQUAL(1, get_mon().order_err_cnt);
+    uint8_t * c = lv_mem_buf_get(16);
+    TEST_ASSERT_TRUE(c > b);
+
+    lv_mem_buf_release(c);
+    lv_mem_buf_release(b);
+    TEST_ASSERT_EQUAL_PTR(a, lv_mem_buf_get(16));
+    lv_mem_buf_release(a);
+
+    lv_mem_buf_free_all();
+    TEST_ASSERT_EQUAL(0, get_mon().leak_cnt);
+}
+
+void test_mem_buf_overflow(void)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+#endif
+
+    uint8_t * a = lv_mem_buf_get(32);
+    uint8_t * large = lv_mem_buf_get(LV_MEM_BUF_SIZE);
+    TEST_ASSERT_NOT_NULL(large);
+    lv_memset(large, 0x33, LV_MEM_BUF_SIZE);
+    TEST_ASSERT_EQUAL(1, get_mon().overflow_cnt);
+    TEST_ASSERT_GREATER_THAN(LV_MEM_BUF_SIZE, get_mon().max_used);
+
+    /*The arena is still used for the smaller buffers*/
+    uint8_t * b = lv_mem_buf_get(32);
+    TEST_ASSERT_TRUE(b > a && b < a + LV_MEM_BUF_SIZE);
+    TEST_ASSERT_EQUAL(1, get_mon().overflow_cnt);
+
+    lv_mem_buf_release(b);
+    lv_mem_buf_release(large);
+    lv_mem_buf_release(a);
+
+#if LV_MEM_CUSTOM == 0
+    /*The large buffer is freed to the heap*/
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(mon1.free_size, mon2.free_size);
+#endif
+}
+
+void test_mem_buf_free_all(void)
+{
+    uint8_t * a = lv_mem_buf_get(16);
+    lv_mem_buf_get(16);
+    lv_mem_buf_get(LV_MEM_BUF_SIZE);
+
+    lv_mem_buf_free_all();
+    TEST_ASSERT_EQUAL(3, get_mon().leak_cnt);
+
+    TEST_ASSERT_EQUAL_PTR(a, lv_mem_buf_get(16));
+    lv_mem_buf_release(a);
+}
+
+/*All buffers of drawing and of the layouts are released in order*/
+void test_mem_buf_refresh(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_shadow_width(cont, 20, 0);
+
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        if(i % 2) lv_obj_set_flex_grow(btn, 1);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+    }
+
+    lv_obj_t * grid = lv_obj_create(lv_scr_act());
+    static lv_coord_t col_dsc[] = {60, LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+    static lv_coord_t row_dsc[] = {40, 40, LV_GRID_TEMPLATE_LAST};
+    lv_obj_set_grid_dsc_array(grid, col_dsc, row_dsc);
+    lv_obj_set_pos(grid, 350, 0);
+    lv_obj_set_size(grid, 300, 200);
+    lv_obj_t * label = lv_label_create(grid);
+    lv_label_set_text(label, "Grid");
+    lv_obj_set_grid_cell(label, LV_GRID_ALIGN_START, 1, 1, LV_GRID_ALIGN_START, 1, 1);
+
+    lv_refr_now(NULL);
+
+    lv_mem_buf_monitor_t mon = get_mon();
+    TEST_ASSERT_GREATER_THAN(0, mon.max_used);
+    TEST_ASSERT_EQUAL(0, mon.order_err_cnt);
+    TEST_ASSERT_EQUAL(0, mon.leak_cnt);
+}
+
+#endif
@@ -0,0 +1,232 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_set_slab(true);
+    lv_mem_reset_max_used();
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_set_slab(true);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+#endif
+}
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+static lv_mem_slab_monitor_t get_class(uint32_t class_id)
+{
+    lv_mem_slab_monitor_t mon;
+    lv_mem_slab_monitor(class_id, &mon);
+    return mon;
+}
+
+static uint32_t last_class(void)
+{
+    return lv_mem_slab_get_class_cnt() - 1;
+}
+
+#endif
+
+void test_mem_slab_small_alloc_uses_the_smallest_class(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_slab_monitor_t c0 = get_class(0);
+    lv_mem_slab_monitor_t c1 = get_class(1);
+
+    void * p0 = lv_mem_alloc(c0.block_size);
+    void * p1 = lv_mem_alloc(c0.block_size + 1);
+    TEST_ASSERT_EQUAL(c0.used_cnt + 1, get_class(0).used_cnt);
+    TEST_ASSERT_EQUAL(c1.used_cnt + 1, get_class(1).used_cnt);
+    TEST_ASSERT_EQUAL(1, get_class(0).alloc_cnt);
+
+    lv_mem_free(p0);
+    lv_mem_free(p1);
+    TEST_ASSERT_EQUAL(c0.used_cnt, get_class(0).used_cnt);
+    TEST_ASSERT_EQUAL(c1.used_cnt, get_class(1).used_cnt);
+    TEST_ASSERT_EQUAL(c0.used_cnt + 1, get_class(0).max_used_cnt);
+
+    /*Larger than the largest class: allocated from the pool*/
+    lv_mem_slab_monitor_t cl = get_class(last_class());
+    void * p = lv_mem_alloc(cl.block_size + 1);
+    TEST_ASSERT_EQUAL(cl.used_cnt, get_class(last_class()).used_cnt);
+    lv_mem_free(p);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_mem_slab_full_class_uses_the_pool(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_slab_monitor_t c = get_class(last_class());
+    uint32_t cnt = c.block_cnt - c.used_cnt + 1;
+    void * p[64];
+    TEST_ASSERT_LESS_OR_EQUAL(64, cnt);
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        p[i] = lv_mem_alloc(c.block_size);
+        TEST_ASSERT_NOT_NULL(p[i]);
+        lv_memset(p[i], i, c.block_size);
+    }
+
+    c = get_class(last_class());
+    TEST_ASSERT_EQUAL(c.block_cnt, c.used_cnt);
+    TEST_ASSERT_EQUAL(1, c.miss_cnt);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+
+    /*A freed block is used again*/
+    lv_mem_free(p[0]);
+    void * again = lv_mem_alloc(c.block_size);
+    TEST_ASSERT_EQUAL_PTR(p[0], again);
+    p[0] = again;
+    lv_memset(p[0], 0, c.block_size);
+
+    for(i = 0; i < cnt; i++) {
+        uint8_t * d = p[i];
+        TEST_ASSERT_EACH_EQUAL_UINT8((uint8_t)i, d, c.block_size);
+        lv_mem_free(p[i]);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_mem_slab_realloc(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_slab_monitor_t c0 = get_class(0);
+    lv_mem_slab_monitor_t cl = get_class(last_class());
+
+    char * p = lv_mem_alloc(4);
+    lv_memcpy(p, "abc", 4);
+
+    /*Fits into the same block*/
+    TEST_ASSERT_EQUAL_PTR(p, lv_mem_realloc(p, c0.block_size));
+
+    /*Moved to a larger class*/
+    p = lv_mem_realloc(p, c0.block_size + 1);
+    TEST_ASSERT_EQUAL_STRING("abc", p);
+    TEST_ASSERT_EQUAL(c0.used_cnt, get_class(0).used_cnt);
+    TEST_ASSERT_EQUAL(get_class(1).used_cnt, get_class(1).max_used_cnt);
+
+    /*Moved to the pool*/
+    p = lv_mem_realloc(p, cl.block_size + 1);
+    TEST_ASSERT_EQUAL_STRING("abc", p);
+    TEST_ASSERT_EQUAL(get_class(1).max_used_cnt - 1, get_class(1).used_cnt);
+
+    lv_mem_free(p);
+
+    /*Allocating with realloc uses the slabs too*/
+    p = lv_mem_realloc(NULL, 4);
+    TEST_ASSERT_EQUAL(c0.used_cnt + 1, get_class(0).used_cnt);
+    lv_mem_free(p);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_mem_slab_monitor(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    uint32_t slab_size = 0;
+    uint32_t i;
+    for(i = 0; i < lv_mem_slab_get_class_cnt(); i++) {
+        lv_mem_slab_monitor_t c = get_class(i);
+        slab_size += c.block_size * c.block_cnt;
+    }
+
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+    TEST_ASSERT_EQUAL(slab_size, mon1.slab_size);
+
+    /*The free blocks of the slabs are counted as free memory*/
+    void * p = lv_mem_alloc(1);
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(get_class(0).block_size, mon1.slab_free_size - mon2.slab_free_size);
+    TEST_ASSERT_EQUAL(get_class(0).block_size, mon1.free_size - mon2.free_size);
+    TEST_ASSERT_EQUAL(mon1.free_biggest_size, mon2.free_biggest_size);
+
+    lv_mem_free(p);
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(mon1.free_size, mon2.free_size);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_mem_slab_disabled(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    void * in_slab = lv_mem_alloc(1);
+    uint32_t used_cnt = get_class(0).used_cnt;
+
+    lv_mem_set_slab(false);
+    void * in_pool = lv_mem_alloc(1);
+    TEST_ASSERT_EQUAL(used_cnt, get_class(0).used_cnt);
+
+    /*The blocks of the slabs are still freed to the slabs*/
+    lv_mem_free(in_slab);
+    TEST_ASSERT_EQUAL(used_cnt - 1, get_class(0).used_cnt);
+    lv_mem_free(in_pool);
+#else
+    TEST_PASS();
+#endif
+}
+
+/*Long living small allocations between short living large ones split the free memory of the pool*/
+void test_mem_slab_less_fragmentation(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    /*A class with enough free blocks for the small allocations*/
+    uint32_t small_size = 0;
+    uint32_t i;
+    for(i = 0; i < lv_mem_slab_get_class_cnt(); i++) {
+        lv_mem_slab_monitor_t c = get_class(i);
+        if(c.block_cnt - c.used_cnt >= 8) {
+            small_size = c.block_size;
+            break;
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, small_size);
+
+    int32_t new_free_cnt[2];
+    for(i = 0; i < 2; i++) {
+        lv_mem_set_slab(i == 1);
+
+        lv_mem_monitor_t mon1;
+        lv_mem_monitor(&mon1);
+
+        void * large[8];
+        void * small[8];
+        uint32_t j;
+        for(j = 0; j < 8; j++) {
+            large[j] = lv_mem_alloc(1024);
+            small[j] = lv_mem_alloc(small_size);
+        }
+        for(j = 0; j < 8; j++) lv_mem_free(large[j]);
+
+        lv_mem_monitor_t mon2;
+        lv_mem_monitor(&mon2);
+        new_free_cnt[i] = (int32_t)mon2.free_cnt - (int32_t)mon1.free_cnt;
+
+        for(j = 0; j < 8; j++) lv_mem_free(small[j]);
+    }
+
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(7, new_free_cnt[0]);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(1, new_free_cnt[1]);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
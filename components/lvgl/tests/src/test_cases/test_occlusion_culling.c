@@ -0,0 +1,184 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_USE_OCCLUSION_CULLING
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[SCREEN_PX];
+
+static lv_obj_t * covered;
+static lv_obj_t * covered_by_two;
+static lv_obj_t * partly_covered;
+static lv_obj_t * occluder;
+static lv_obj_t * occluder_left;
+static lv_obj_t * occluder_right;
+
+static lv_obj_t * create_rect(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, uint32_t color)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(color), 0);
+    return obj;
+}
+
+static void create_ui(void)
+{
+    /*A button with shadow and label fully behind an opaque rectangle*/
+    covered = lv_btn_create(lv_scr_act());
+    lv_obj_set_pos(covered, 100, 100);
+    lv_obj_set_size(covered, 150, 60);
+    lv_obj_t * label = lv_label_create(covered);
+    lv_label_set_text(label, "Covered");
+
+    /*Partially visible on the right of the occluder*/
+    partly_covered = lv_btn_create(lv_scr_act());
+    lv_obj_set_pos(partly_covered, 300, 100);
+    lv_obj_set_size(partly_covered, 150, 60);
+
+    occluder = create_rect(50, 50, 300, 200, 0x2080c0);
+
+    /*Covered only by the two rectangles together*/
+    covered_by_two = create_rect(520, 300, 200, 100, 0xff0000);
+    occluder_left = create_rect(500, 280, 120, 150, 0x20c080);
+    occluder_right = create_rect(620, 280, 120, 150, 0xc08020);
+}
+
+static void not_cover_event_cb(lv_event_t * e)
+{
+    lv_cover_check_info_t * info = lv_event_get_param(e);
+    info->res = LV_COVER_RES_NOT_COVER;
+}
+
+static uint32_t render_screen(void)
+{
+    lv_refr_reset_inv_stats(NULL);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_inv_stats_t stats;
+    lv_refr_get_inv_stats(NULL, &stats);
+    return stats.culled_cnt;
+}
+
+static void invalidate_occluders(void)
+{
+    lv_obj_invalidate(occluder);
+    lv_obj_invalidate(occluder_left);
+    lv_obj_invalidate(occluder_right);
+}
+
+/*Draw everything by telling that the occluders can't cover anything*/
+static void render_ref(void)
+{
+    /*The cover check is cached so invalidate the objects if the result changes*/
+    lv_obj_add_event_cb(occluder, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    lv_obj_add_event_cb(occluder_left, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    lv_obj_add_event_cb(occluder_right, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    invalidate_occluders();
+
+    uint32_t culled = render_screen();
+    TEST_ASSERT_EQUAL(0, culled);
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_obj_remove_event_cb(occluder, not_cover_event_cb);
+    lv_obj_remove_event_cb(occluder_left, not_cover_event_cb);
+    lv_obj_remove_event_cb(occluder_right, not_cover_event_cb);
+    invalidate_occluders();
+}
+
+#endif
+
+void test_occlusion_culling_same_as_without(void)
+{
+#if LV_USE_OCCLUSION_CULLING
+    create_ui();
+    render_ref();
+
+    uint32_t culled = render_screen();
+    TEST_ASSERT_GREATER_THAN(0, culled);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_occlusion_culling_skips_only_covered(void)
+{
+#if LV_USE_OCCLUSION_CULLING
+    create_ui();
+
+    /*Hide the objects which should be culled. The others should be still culled.*/
+    uint32_t culled_all = render_screen();
+    lv_obj_add_flag(covered, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(covered_by_two, LV_OBJ_FLAG_HIDDEN);
+    uint32_t culled_visible = render_screen();
+    TEST_ASSERT_EQUAL(0, culled_visible);
+    TEST_ASSERT_GREATER_THAN(culled_visible, culled_all);
+
+    /*The partially covered button is still drawn*/
+    lv_obj_add_flag(partly_covered, LV_OBJ_FLAG_HIDDEN);
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+    render_screen();
+    TEST_ASSERT_FALSE(memcmp(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t)) == 0);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_occlusion_culling_cache_is_invalidated(void)
+{
+#if LV_USE_OCCLUSION_CULLING
+    create_ui();
+    render_screen();
+
+    /*A transparent occluder doesn't cover anything*/
+    lv_obj_set_style_bg_opa(occluder, LV_OPA_50, 0);
+    lv_obj_set_style_bg_opa(occluder_left, LV_OPA_50, 0);
+    render_ref();
+    TEST_ASSERT_EQUAL(0, render_screen());
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    /*Opaque again*/
+    lv_obj_set_style_bg_opa(occluder, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_opa(occluder_left, LV_OPA_COVER, 0);
+    TEST_ASSERT_GREATER_THAN(0, render_screen());
+
+    /*Moved away: the covered objects are visible*/
+    lv_obj_set_x(occluder, 400);
+    lv_obj_set_x(occluder_left, 0);
+    render_ref();
+    TEST_ASSERT_EQUAL(0, render_screen());
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    /*Hidden occluder*/
+    lv_obj_set_x(occluder, 50);
+    lv_obj_set_x(occluder_left, 500);
+    TEST_ASSERT_GREATER_THAN(0, render_screen());
+    lv_obj_add_flag(occluder, LV_OBJ_FLAG_HIDDEN);
+    render_ref();
+    uint32_t culled = render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+    TEST_ASSERT_GREATER_THAN(0, culled);    /*Still covered by the two others*/
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,162 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_PARALLEL_RENDER
+    lv_refr_set_parallel_render(true);
+#endif
+}
+
+#if LV_USE_PARALLEL_RENDER
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[SCREEN_PX];
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * btn = lv_btn_create(scr);
+        lv_obj_set_size(btn, 180, 70);
+        lv_obj_set_pos(btn, 20 + (i % 3) * 200, 20 + (i / 3) * 200);
+        lv_obj_set_style_shadow_width(btn, 20 + i * 5, 0);
+        lv_obj_set_style_radius(btn, 10 + i * 4, 0);
+        lv_obj_set_style_bg_grad_dir(btn, LV_GRAD_DIR_VER, 0);
+
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+        lv_obj_center(label);
+    }
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 160, 160);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+    lv_arc_set_value(arc, 70);
+
+    lv_obj_t * label = lv_label_create(scr);
+    lv_obj_set_width(label, 300);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "A long text drawn with a compressed font, spanning more render bands.");
+    lv_obj_align(label, LV_ALIGN_BOTTOM_LEFT, 20, -20);
+}
+
+/*Widgets drawing their items in other states than their own, spanning all render bands*/
+static void create_item_widgets(lv_obj_t ** btnm, lv_obj_t ** table)
+{
+    static const char * map[] = {"A", "B", "C", "\n", "D", "E", "F", "\n", "G", "H", "I", ""};
+    *btnm = lv_btnmatrix_create(lv_scr_act());
+    lv_btnmatrix_set_map(*btnm, map);
+    lv_obj_set_size(*btnm, 360, 440);
+    lv_obj_set_pos(*btnm, 20, 20);
+    lv_btnmatrix_set_btn_ctrl(*btnm, 4, LV_BTNMATRIX_CTRL_CHECKABLE);
+    lv_btnmatrix_set_btn_ctrl(*btnm, 4, LV_BTNMATRIX_CTRL_CHECKED);
+    lv_btnmatrix_set_btn_ctrl(*btnm, 7, LV_BTNMATRIX_CTRL_DISABLED);
+    lv_btnmatrix_set_selected_btn(*btnm, 1);
+    lv_obj_add_state(*btnm, LV_STATE_FOCUSED | LV_STATE_PRESSED);
+
+    *table = lv_table_create(lv_scr_act());
+    lv_obj_set_pos(*table, 420, 20);
+    lv_obj_set_size(*table, 360, 440);
+    uint16_t row;
+    for(row = 0; row < 10; row++) {
+        lv_table_set_cell_value_fmt(*table, row, 0, "Row %d", (int)row);
+        lv_table_set_cell_value(*table, row, 1, "Value");
+    }
+    lv_obj_add_state(*table, LV_STATE_FOCUSED);
+}
+
+#endif
+
+void test_parallel_render_item_states(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    lv_obj_t * btnm;
+    lv_obj_t * table;
+    create_item_widgets(&btnm, &table);
+
+    lv_refr_set_parallel_render(false);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    /*The objects' states are not changed while the bands draw them*/
+    lv_refr_set_parallel_render(true);
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        render_screen();
+        TEST_ASSERT_EQUAL(LV_STATE_FOCUSED | LV_STATE_PRESSED, lv_obj_get_state(btnm));
+        TEST_ASSERT_EQUAL(LV_STATE_FOCUSED, lv_obj_get_state(table));
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_parallel_render_matches_serial(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    create_ui();
+
+    lv_refr_set_parallel_render(false);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_refr_set_parallel_render(true);
+    render_screen();
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_parallel_render_repeated_frames_are_stable(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    create_ui();
+
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        render_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_parallel_render_get_set(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    lv_refr_set_parallel_render(false);
+    TEST_ASSERT_FALSE(lv_refr_get_parallel_render());
+    lv_refr_set_parallel_render(true);
+    TEST_ASSERT_TRUE(lv_refr_get_parallel_render());
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,461 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_img.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PNG
+#include "../../src/extra/libs/png/lodepng.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SCREEN_PX   (800 * 480)
+
+LV_IMG_DECLARE(img_wink_png)
+LV_IMG_DECLARE(SPACE_1)
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+typedef struct {
+    LodePNGColorType color_type;
+    uint8_t bit_depth;
+} png_mode_t;
+
+static const png_mode_t modes[] = {
+    {LCT_GREY, 1}, {LCT_GREY, 2}, {LCT_GREY, 4}, {LCT_GREY, 8}, {LCT_GREY, 16},
+    {LCT_RGB, 8}, {LCT_RGB, 16},
+    {LCT_PALETTE, 1}, {LCT_PALETTE, 2}, {LCT_PALETTE, 4}, {LCT_PALETTE, 8},
+    {LCT_GREY_ALPHA, 8}, {LCT_GREY_ALPHA, 16},
+    {LCT_RGBA, 8}, {LCT_RGBA, 16},
+};
+
+static uint32_t seed;
+
+static uint8_t rnd(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+/*Raw image data in the given mode: noise, gradients and repeated rows for the matches*/
+static uint8_t * raw_create(const png_mode_t * mode, uint32_t w, uint32_t h)
+{
+    LodePNGColorMode cm;
+    lodepng_color_mode_init(&cm);
+    cm.colortype = mode->color_type;
+    cm.bitdepth = mode->bit_depth;
+    size_t size = lodepng_get_raw_size(w, h, &cm);
+    size_t row_size = size / h;
+    uint8_t * raw = calloc(1, size);
+
+    uint32_t y;
+    uint32_t i;
+    for(y = 0; y < h; y++) {
+        uint8_t * row = raw + y * row_size;
+        if(y % 4 == 3) lv_memcpy(row, row - row_size, row_size);
+        else if(y % 4 == 2) for(i = 0; i < row_size; i++) row[i] = i * 3 + y;
+        else for(i = 0; i < row_size; i++) row[i] = rnd();
+    }
+
+    /*No indices out of the palette*/
+    if(mode->color_type == LCT_PALETTE && mode->bit_depth == 8) {
+        for(i = 0; i < size; i++) raw[i] %= 200;
+    }
+    return raw;
+}
+
+/*Encode raw data to PNG without automatic color conversion*/
+static lv_img_dsc_t * png_encode(const uint8_t * raw, const png_mode_t * mode, uint32_t w, uint32_t h,
+                                 uint32_t btype, uint32_t filter, bool interlace, bool key, uint32_t idat_size)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.encoder.auto_convert = 0;
+    state.encoder.zlibsettings.btype = btype;
+    state.encoder.filter_palette_zero = 0;
+    state.encoder.filter_strategy = filter;
+    state.info_png.interlace_method = interlace ? 1 : 0;
+
+    LodePNGColorMode * cms[2] = {&state.info_raw, &state.info_png.color};
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        cms[c]->colortype = mode->color_type;
+        cms[c]->bitdepth = mode->bit_depth;
+        if(mode->color_type == LCT_PALETTE) {
+            uint32_t cnt = mode->bit_depth == 8 ? 200 : 1 << mode->bit_depth;
+            uint32_t i;
+            for(i = 0; i < cnt; i++) {
+                lodepng_palette_add(cms[c], i * 37, 255 - i, i * 91, i % 3 == 0 ? i : 255);
+            }
+        }
+        else if(key && (mode->color_type == LCT_GREY || mode->color_type == LCT_RGB)) {
+            /*The first pixel is transparent*/
+            cms[c]->key_defined = 1;
+            if(mode->bit_depth == 16) {
+                cms[c]->key_r = (raw[0] << 8) | raw[1];
+                cms[c]->key_g = mode->color_type == LCT_RGB ? (unsigned)(raw[2] << 8) | raw[3] : cms[c]->key_r;
+                cms[c]->key_b = mode->color_type == LCT_RGB ? (unsigned)(raw[4] << 8) | raw[5] : cms[c]->key_r;
+            }
+            else if(mode->bit_depth == 8) {
+                cms[c]->key_r = raw[0];
+                cms[c]->key_g = mode->color_type == LCT_RGB ? raw[1] : raw[0];
+                cms[c]->key_b = mode->color_type == LCT_RGB ? raw[2] : raw[0];
+            }
+            else {
+                cms[c]->key_r = raw[0] >> (8 - mode->bit_depth);
+                cms[c]->key_g = cms[c]->key_r;
+                cms[c]->key_b = cms[c]->key_r;
+            }
+        }
+    }
+
+    uint8_t * png;
+    size_t png_size;
+    unsigned error = lodepng_encode(&png, &png_size, raw, w, h, &state);
+    lodepng_state_cleanup(&state);
+    TEST_ASSERT_EQUAL_MESSAGE(0, error, lodepng_error_text(error));
+
+    lv_img_dsc_t * img = lv_test_img_png_split(png, png_size, idat_size);
+    lv_mem_free(png);
+    return img;
+}
+
+/*The pixel of an RGBA8888 image in the format of `LV_IMG_CF_TRUE_COLOR_ALPHA`*/
+static void px_expected(const uint8_t * rgba, uint8_t * px)
+{
+    lv_color_t c = lv_color_make(rgba[0], rgba[1], rgba[2]);
+    lv_memcpy(px, &c, LV_COLOR_SIZE / 8);
+    px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = rgba[3];
+}
+
+/*Read the rows of `img` with the PNG decoder and compare them with lodepng*/
+static void assert_decode(const void * src, const uint8_t * png, uint32_t png_size, bool stream)
+{
+    uint8_t * rgba;
+    unsigned w;
+    unsigned h;
+    unsigned error = lodepng_decode32(&rgba, &w, &h, png, png_size);
+    TEST_ASSERT_EQUAL_MESSAGE(0, error, lodepng_error_text(error));
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(stream, dsc.img_data == NULL);
+
+    uint8_t * line = malloc(w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    uint8_t px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        if(stream) TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, w, line));
+        else lv_memcpy(line, dsc.img_data + y * w * LV_IMG_PX_SIZE_ALPHA_BYTE, w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+        for(x = 0; x < w; x++) {
+            px_expected(&rgba[(y * w + x) * 4], px);
+            TEST_ASSERT_EQUAL_MEMORY(px, &line[x * LV_IMG_PX_SIZE_ALPHA_BYTE], LV_IMG_PX_SIZE_ALPHA_BYTE);
+        }
+    }
+
+    free(line);
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(rgba);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Compare the top left part of the screen with `ref_fb`. The monitors can be at the bottom.*/
+static void assert_fb_equal(void)
+{
+    uint32_t y;
+    for(y = 0; y < 200; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&ref_fb[y * 800], &test_fb[y * 800], 200 * sizeof(lv_color_t));
+    }
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_PNG
+    seed = 12345;
+    lv_png_set_stream(true);
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+#if LV_USE_PNG
+    lv_png_set_stream(LV_PNG_STREAM);
+#endif
+}
+
+void test_png_stream_formats(void)
+{
+#if LV_USE_PNG
+    /*Odd width to have partial bytes at the end of the rows*/
+    const uint32_t w = 37;
+    const uint32_t h = 23;
+    uint32_t m;
+    uint32_t btype;
+    for(m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        uint8_t * raw = raw_create(&modes[m], w, h);
+        for(btype = 0; btype < 3; btype++) {
+            lv_img_dsc_t * img = png_encode(raw, &modes[m], w, h, btype, LFS_MINSUM, false, btype == 2, 0);
+            assert_decode(img, img->data, img->data_size, true);
+            lv_test_img_free(img);
+        }
+        free(raw);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_filters(void)
+{
+#if LV_USE_PNG
+    /*Every filter type with 1 byte per pixel (and less) and more bytes per pixel*/
+    static const png_mode_t filter_modes[] = {{LCT_GREY, 2}, {LCT_GREY, 8}, {LCT_RGB, 16}, {LCT_RGBA, 8}};
+    const uint32_t w = 30;
+    const uint32_t h = 17;
+    uint32_t m;
+    uint32_t filter;
+    for(m = 0; m < sizeof(filter_modes) / sizeof(filter_modes[0]); m++) {
+        uint8_t * raw = raw_create(&filter_modes[m], w, h);
+        for(filter = LFS_ZERO; filter <= LFS_FOUR; filter++) {
+            lv_img_dsc_t * img = png_encode(raw, &filter_modes[m], w, h, 2, filter, false, false, 0);
+            assert_decode(img, img->data, img->data_size, true);
+            lv_test_img_free(img);
+        }
+        free(raw);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_split_idat(void)
+{
+#if LV_USE_PNG
+    static const png_mode_t mode = {LCT_RGBA, 8};
+    uint8_t * raw = raw_create(&mode, 64, 40);
+    lv_img_dsc_t * img = png_encode(raw, &mode, 64, 40, 2, LFS_MINSUM, false, false, 0);
+
+    /*The chunks can end anywhere, even in a code or in the zlib header*/
+    static const uint32_t sizes[] = {1, 2, 7, 100};
+    uint32_t i;
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        lv_img_dsc_t * split = lv_test_img_png_split(img->data, img->data_size, sizes[i]);
+        TEST_ASSERT_GREATER_THAN(img->data_size, split->data_size);
+        assert_decode(split, img->data, img->data_size, true);
+        lv_test_img_free(split);
+    }
+
+    lv_test_img_free(img);
+    free(raw);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_file(void)
+{
+#if LV_USE_PNG
+    /*Longer than the file buffer and split to chunks*/
+    lv_img_dsc_t * img = lv_test_img_png(&SPACE_1, 120, 123, 300);
+    TEST_ASSERT_NOT_NULL(img);
+    TEST_ASSERT_GREATER_THAN(2048, img->data_size);
+
+    FILE * f = fopen("/tmp/lv_test_png_stream.png", "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(img->data, 1, img->data_size, f);
+    fclose(f);
+
+    assert_decode("F:/tmp/lv_test_png_stream.png", img->data, img->data_size, true);
+
+    lv_png_set_stream(false);
+    assert_decode("F:/tmp/lv_test_png_stream.png", img->data, img->data_size, false);
+
+    remove("/tmp/lv_test_png_stream.png");
+    lv_test_img_free(img);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_random_access(void)
+{
+#if LV_USE_PNG
+    const uint32_t w = img_wink_png.header.w;
+    const uint32_t h = img_wink_png.header.h;
+    uint8_t * rgba;
+    unsigned rgba_w;
+    unsigned rgba_h;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32(&rgba, &rgba_w, &rgba_h, img_wink_png.data, img_wink_png.data_size));
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_wink_png, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+
+    /*Going back starts the decoding again. The same row can be read again.*/
+    static const int32_t ys[] = {10, 10, 11, 40, 3, 0, 49, 48, 25};
+    uint8_t line[10 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    uint8_t px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+    uint32_t i;
+    for(i = 0; i < sizeof(ys) / sizeof(ys[0]); i++) {
+        uint32_t x0 = (i * 7) % (w - 10);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, x0, ys[i], 10, line));
+        uint32_t x;
+        for(x = 0; x < 10; x++) {
+            px_expected(&rgba[(ys[i] * w + x0 + x) * 4], px);
+            TEST_ASSERT_EQUAL_MEMORY(px, &line[x * LV_IMG_PX_SIZE_ALPHA_BYTE], LV_IMG_PX_SIZE_ALPHA_BYTE);
+        }
+    }
+
+    /*Out of the image*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, h, 1, line));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, w - 5, 0, 10, line));
+
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(rgba);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_interlaced(void)
+{
+#if LV_USE_PNG
+    /*Interlaced images are decoded as a whole*/
+    static const png_mode_t mode = {LCT_RGBA, 8};
+    uint8_t * raw = raw_create(&mode, 20, 20);
+    lv_img_dsc_t * img = png_encode(raw, &mode, 20, 20, 2, LFS_MINSUM, true, false, 0);
+    assert_decode(img, img->data, img->data_size, false);
+    lv_test_img_free(img);
+    free(raw);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_invalid(void)
+{
+#if LV_USE_PNG
+    lv_img_dsc_t * img = lv_test_img_png(&SPACE_1, 120, 123, 0);
+    TEST_ASSERT_NOT_NULL(img);
+
+    /*Truncated image data: the first rows can be read*/
+    lv_img_dsc_t truncated = *img;
+    truncated.data_size = img->data_size / 2;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &truncated, lv_color_black(), 0));
+    uint8_t line[120 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 0, 120, line));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, 122, 120, line));
+    /*Start again after the error*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 1, 120, line));
+    lv_img_decoder_close(&dsc);
+
+    /*Corrupted compressed data*/
+    uint8_t * data = (uint8_t *)img->data;
+    uint32_t i;
+    for(i = 100; i < img->data_size - 100; i++) data[i] ^= 0x5A;
+    bool ok = true;
+    if(lv_img_decoder_open(&dsc, img, lv_color_black(), 0) == LV_RES_OK) {
+        int32_t y;
+        for(y = 0; y < 123 && ok; y++) ok = lv_img_decoder_read_line(&dsc, 0, y, 120, line) == LV_RES_OK;
+        lv_img_decoder_close(&dsc);
+    }
+    TEST_ASSERT_FALSE(ok);
+
+    lv_test_img_free(img);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_memory(void)
+{
+#if LV_USE_PNG
+    lv_img_dsc_t * img = lv_test_img_png(&SPACE_1, 240, 240, 0);
+    TEST_ASSERT_NOT_NULL(img);
+    uint8_t * line = malloc(240 * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    /*Peak memory of opening the image and reading all the rows*/
+    uint32_t peak[2];
+    uint32_t decoded_size[2];
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_png_set_stream(i == 0);
+        lv_mem_reset_max_used();
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        uint32_t used = mon.max_used;
+
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+        int32_t y;
+        for(y = 0; y < 240 && dsc.img_data == NULL; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, 240, line));
+        }
+        decoded_size[i] = dsc.decoded_size;
+        lv_img_decoder_close(&dsc);
+
+        lv_mem_monitor(&mon);
+        peak[i] = mon.max_used - used;
+    }
+
+    /*The window, 2 rows and the tables instead of 4 bytes per pixel*/
+    TEST_ASSERT_LESS_THAN(32 * 1024 + 2 * 961 + 8 * 1024, decoded_size[0]);
+    TEST_ASSERT_EQUAL(240 * 240 * 4, decoded_size[1]);
+    TEST_ASSERT_LESS_THAN(48 * 1024, peak[0]);
+    TEST_ASSERT_GREATER_THAN(240 * 240 * 4, peak[1]);
+
+    free(line);
+    lv_test_img_free(img);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_png_stream_draw(void)
+{
+#if LV_USE_PNG
+    /*The same screen with row by row and whole decoding*/
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x3070a0), 0);
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_obj_set_pos(obj, 13, 7);
+
+    lv_png_set_stream(false);
+    lv_img_set_src(obj, &img_wink_png);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_png_set_stream(true);
+    lv_img_set_src(obj, &img_wink_png);
+    render_screen();
+    assert_fb_equal();
+
+    /*Several images, redrawn when they are cached*/
+    lv_obj_t * obj2 = lv_img_create(lv_scr_act());
+    lv_obj_set_pos(obj2, 40, 30);
+    lv_img_set_src(obj2, &img_wink_png);
+    render_screen();
+    render_screen();
+    lv_obj_del(obj2);
+    render_screen();
+    assert_fb_equal();
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
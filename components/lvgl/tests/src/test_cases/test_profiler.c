@@ -0,0 +1,151 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_USE_PROFILER
+    lv_prof_reset();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_PARALLEL_RENDER
+    lv_refr_set_parallel_render(true);
+#endif
+}
+
+#if LV_USE_PROFILER
+
+static uint32_t print_cnt;
+
+static void create_ui(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_set_size(btn, 200, 100);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Profiler");
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void print_cb(const char * buf)
+{
+    TEST_ASSERT_NOT_NULL(buf);
+    print_cnt++;
+}
+
+static void test_frame_is_measured(void)
+{
+    create_ui();
+    render_screen();
+
+    TEST_ASSERT_EQUAL(1, lv_prof_get_frame_cnt());
+    const lv_prof_frame_t * frame = lv_prof_get_frame(0);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_NULL(lv_prof_get_frame(1));
+
+    TEST_ASSERT_EQUAL(1, frame->cnt[LV_PROF_FRAME]);
+    TEST_ASSERT_EQUAL(1, frame->cnt[LV_PROF_LAYOUT]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_RENDER]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_FLUSH]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_STYLE]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_BLEND]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_DRAW_RECT]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_DRAW_LETTER]);
+    TEST_ASSERT_GREATER_THAN(0, frame->cnt[LV_PROF_DRAW_ARC]);
+    TEST_ASSERT_EQUAL(0, frame->cnt[LV_PROF_DRAW_LINE]);
+
+    /*The rendering is part of the frame*/
+    TEST_ASSERT_GREATER_OR_EQUAL(frame->time[LV_PROF_RENDER], frame->time[LV_PROF_FRAME]);
+    TEST_ASSERT_GREATER_THAN(0, frame->time[LV_PROF_FRAME]);
+}
+
+#endif
+
+void test_profiler_serial(void)
+{
+#if LV_USE_PROFILER
+#if LV_USE_PARALLEL_RENDER
+    lv_refr_set_parallel_render(false);
+#endif
+    test_frame_is_measured();
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_profiler_parallel(void)
+{
+#if LV_USE_PROFILER && LV_USE_PARALLEL_RENDER
+    /*The measurements of the render threads are merged to the frame*/
+    test_frame_is_measured();
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_profiler_no_frame_without_redraw(void)
+{
+#if LV_USE_PROFILER
+    create_ui();
+    render_screen();
+    lv_prof_reset();
+
+    /*Nothing is invalidated*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, lv_prof_get_frame_cnt());
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_profiler_ring_keeps_last_frames(void)
+{
+#if LV_USE_PROFILER
+    create_ui();
+
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_FRAME_CNT + 3; i++) {
+        render_screen();
+    }
+    TEST_ASSERT_EQUAL(LV_PROFILER_FRAME_CNT, lv_prof_get_frame_cnt());
+    TEST_ASSERT_NOT_NULL(lv_prof_get_frame(LV_PROFILER_FRAME_CNT - 1));
+    TEST_ASSERT_NULL(lv_prof_get_frame(LV_PROFILER_FRAME_CNT));
+
+    lv_prof_reset();
+    TEST_ASSERT_EQUAL(0, lv_prof_get_frame_cnt());
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_profiler_dump(void)
+{
+#if LV_USE_PROFILER
+    create_ui();
+    render_screen();
+
+    /*A header and a line for every measured part*/
+    print_cnt = 0;
+    lv_prof_dump(print_cb);
+    TEST_ASSERT_EQUAL(_LV_PROF_ID_NUM + 1, print_cnt);
+
+    TEST_ASSERT_EQUAL_STRING("draw_letter", lv_prof_get_name(LV_PROF_DRAW_LETTER));
+    TEST_ASSERT_EQUAL(1, lv_prof_time_to_us(LV_PROF_TIME_FREQ / 1000000));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
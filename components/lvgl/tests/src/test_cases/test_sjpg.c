@@ -0,0 +1,336 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_img.h"
+
+#include "unity/unity.h"
+
+#define SJPG_REPEAT     3
+#define SJPG_W          320
+#define SJPG_H          (240 * SJPG_REPEAT)
+#define SJPG_FRAG_H     16
+#define SJPG_FRAG_CNT   (SJPG_H / SJPG_FRAG_H)
+#define SJPG_FRAG_SIZE  (SJPG_W * SJPG_FRAG_H * sizeof(lv_color_t))
+#define SJPG_PATH       "/tmp/lv_test_sjpg.sjpg"
+#define SCREEN_PX       (800 * 480)
+
+#if LV_USE_SJPG
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[SCREEN_PX];
+
+static lv_color_t ref_px[SJPG_W * SJPG_H];
+static lv_color_t line_buf[SJPG_W];
+static lv_img_dsc_t * img;
+
+static void decode_ahead_set(bool en)
+{
+#if LV_SJPG_DECODE_AHEAD
+    lv_sjpg_set_decode_ahead(en);
+#else
+    LV_UNUSED(en);
+#endif
+}
+
+/*Read the lines `y1..y2` of an opened image and compare them to the reference*/
+static void read_lines(lv_img_decoder_dsc_t * dsc, lv_coord_t y1, lv_coord_t y2)
+{
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, SJPG_W, (uint8_t *)line_buf));
+        TEST_ASSERT_EQUAL_MEMORY(&ref_px[y * SJPG_W], line_buf, sizeof(line_buf));
+    }
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Scroll a window of the tall image, draw it in each position and save the last screen to `fb_out`*/
+static void draw_scrolled(lv_color_t * fb_out)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, SJPG_W, 240);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_t * obj = lv_img_create(cont);
+    lv_img_set_src(obj, img);
+
+    lv_coord_t y;
+    for(y = 0; y < SJPG_H - 240; y += 56) {
+        lv_obj_scroll_to_y(cont, y, LV_ANIM_OFF);
+        render_screen();
+    }
+    if(fb_out) lv_memcpy(fb_out, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_obj_del(cont);
+    lv_img_cache_invalidate_src(NULL);
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_USE_SJPG
+    img = lv_test_img_sjpg(SJPG_REPEAT);
+    TEST_ASSERT_NOT_NULL(img);
+
+    /*Decode the reference pixels without the cache*/
+    lv_sjpg_cache_set_size(0);
+    decode_ahead_set(false);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    lv_coord_t y;
+    for(y = 0; y < SJPG_H; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, SJPG_W, (uint8_t *)&ref_px[y * SJPG_W]));
+    }
+    lv_img_decoder_close(&dsc);
+
+    lv_sjpg_cache_invalidate_src(img);
+    lv_sjpg_cache_set_size(LV_SJPG_CACHE_SIZE);
+    lv_sjpg_cache_reset_stats();
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_SJPG
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_sjpg_cache_set_size(LV_SJPG_CACHE_SIZE);
+    decode_ahead_set(true);
+    /*The copies of the images can be allocated to the same address*/
+    lv_sjpg_cache_invalidate_src(NULL);
+    lv_test_img_free(img);
+#endif
+}
+
+void test_sjpg_tall_image(void)
+{
+#if LV_USE_SJPG
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(img, &header));
+    TEST_ASSERT_EQUAL(SJPG_W, header.w);
+    TEST_ASSERT_EQUAL(SJPG_H, header.h);
+
+    /*The image is decoded and its fragments are repeated*/
+    TEST_ASSERT_NOT_EQUAL(ref_px[0].full, ref_px[120 * SJPG_W + 160].full);
+    TEST_ASSERT_EQUAL_MEMORY(&ref_px[0], &ref_px[240 * SJPG_W], 240 * SJPG_W * sizeof(lv_color_t));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_cache_hit(void)
+{
+#if LV_USE_SJPG
+    lv_sjpg_cache_set_size(SJPG_FRAG_CNT * SJPG_FRAG_SIZE);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_H - 1);
+    read_lines(&dsc, 0, SJPG_H - 1);
+
+    /*Every fragment is decoded only once*/
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT * SJPG_FRAG_SIZE, stats.mem_used);
+
+    lv_img_decoder_close(&dsc);
+
+    /*The fragments are kept after closing the image*/
+    lv_sjpg_cache_reset_stats();
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_H - 1);
+    lv_img_decoder_close(&dsc);
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT, stats.hit_cnt);
+
+    /*And freed when the image is invalidated*/
+    lv_sjpg_cache_invalidate_src(img);
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_cache_size_zero(void)
+{
+#if LV_USE_SJPG
+    lv_sjpg_cache_set_size(0);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_H - 1);
+    read_lines(&dsc, 0, SJPG_H - 1);
+
+    /*Only the current fragment is kept*/
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2 * SJPG_FRAG_CNT, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_SIZE, stats.mem_used);
+
+    /*The last fragment is freed too when it's not used anymore*/
+    lv_img_decoder_close(&dsc);
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_cache_lru(void)
+{
+#if LV_USE_SJPG
+    /*The fragments of a 240 px high window and 2 more*/
+    const uint32_t cache_size = (240 / SJPG_FRAG_H + 2) * SJPG_FRAG_SIZE;
+    lv_sjpg_cache_set_size(cache_size);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+
+    /*Scroll down and up like a list and read the visible lines*/
+    lv_sjpg_cache_stats_t stats;
+    lv_coord_t y;
+    for(y = 0; y <= SJPG_H - 240; y += 24) {
+        read_lines(&dsc, y, y + 239);
+        lv_sjpg_cache_get_stats(&stats);
+        TEST_ASSERT_LESS_OR_EQUAL(cache_size, stats.mem_used);
+    }
+    for(y = SJPG_H - 240; y >= 0; y -= 24) {
+        read_lines(&dsc, y, y + 239);
+        lv_sjpg_cache_get_stats(&stats);
+        TEST_ASSERT_LESS_OR_EQUAL(cache_size, stats.mem_used);
+    }
+
+    /*The visible fragments are decoded once while scrolling down, and the evicted ones again while scrolling up*/
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2 * SJPG_FRAG_CNT - (240 / SJPG_FRAG_H + 2), stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.evict_cnt);
+    TEST_ASSERT_GREATER_THAN(stats.miss_cnt, stats.hit_cnt);
+
+    lv_img_decoder_close(&dsc);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_decode_ahead(void)
+{
+#if LV_USE_SJPG && LV_SJPG_DECODE_AHEAD
+    lv_sjpg_set_decode_ahead(true);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_H - 1);
+
+    /*Only the first fragment is decoded when it's read, the others are decoded in advance*/
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(SJPG_FRAG_CNT - 1, stats.ahead_cnt);
+
+    lv_img_decoder_close(&dsc);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_decode_ahead_close(void)
+{
+#if LV_USE_SJPG && LV_SJPG_DECODE_AHEAD
+    lv_sjpg_set_decode_ahead(true);
+
+    /*Start the decoding of the second fragment and close the image while it's pending*/
+    lv_mem_monitor_t m1;
+    lv_mem_monitor(&m1);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, 0);
+    lv_img_decoder_close(&dsc);
+
+    /*The fragment decoded in advance is used when the image is opened again*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, img, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_FRAG_H * 2 - 1);
+    lv_img_decoder_close(&dsc);
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.ahead_cnt);
+
+    /*Invalidate the image while the third fragment is pending*/
+    lv_sjpg_cache_invalidate_src(img);
+
+    lv_mem_monitor_t m2;
+    lv_mem_monitor(&m2);
+    TEST_ASSERT_EQUAL(m1.free_size, m2.free_size);
+
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_file(void)
+{
+#if LV_USE_SJPG
+    FILE * f = fopen(SJPG_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(img->data, 1, img->data_size, f);
+    fclose(f);
+
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info("F:" SJPG_PATH, &header));
+    TEST_ASSERT_EQUAL(SJPG_H, header.h);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "F:" SJPG_PATH, lv_color_black(), 0));
+    read_lines(&dsc, 0, SJPG_H - 1);
+    read_lines(&dsc, 0, SJPG_H - 1);
+
+    /*The files are cached too but not decoded in advance*/
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.ahead_cnt);
+    TEST_ASSERT_EQUAL(2 * SJPG_FRAG_CNT, stats.miss_cnt + stats.hit_cnt);
+
+    /*The fragments of the files are freed with the image*/
+    lv_img_decoder_close(&dsc);
+    lv_sjpg_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    remove(SJPG_PATH);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_sjpg_draw_scrolled(void)
+{
+#if LV_USE_SJPG
+    lv_sjpg_cache_set_size(0);
+    decode_ahead_set(false);
+    draw_scrolled(ref_fb);
+
+    /*The cached and the decoded in advance fragments are drawn the same way*/
+    lv_sjpg_cache_set_size(LV_SJPG_CACHE_SIZE);
+    decode_ahead_set(true);
+    draw_scrolled(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,342 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SCREEN_PX   (800 * 480)
+
+void setUp(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    lv_obj_reset_style_cache_stats();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_OBJ_STYLE_CACHE
+    lv_obj_enable_style_cache(true);
+#endif
+}
+
+#if LV_USE_OBJ_STYLE_CACHE
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[SCREEN_PX];
+
+static lv_style_t style_base;
+static lv_style_t style_pr;
+
+static const lv_style_prop_t props[] = {
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_RADIUS, LV_STYLE_BORDER_WIDTH,
+    LV_STYLE_PAD_TOP, LV_STYLE_TEXT_COLOR, LV_STYLE_WIDTH, LV_STYLE_SHADOW_WIDTH
+};
+
+static void init_styles(void)
+{
+    /*Free the properties of the previous test. The styles are not initialized before the first test.*/
+    static bool inited;
+    if(inited) {
+        lv_style_reset(&style_base);
+        lv_style_reset(&style_pr);
+    }
+    inited = true;
+
+    lv_style_init(&style_base);
+    lv_style_set_bg_color(&style_base, lv_palette_main(LV_PALETTE_BLUE));
+    lv_style_set_bg_opa(&style_base, LV_OPA_COVER);
+    lv_style_set_radius(&style_base, 5);
+
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_palette_main(LV_PALETTE_RED));
+    lv_style_set_border_width(&style_pr, 3);
+}
+
+static lv_obj_t * create_obj(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style_base, 0);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    return obj;
+}
+
+/*Read every property through the cache and without it and compare them.
+ *Called after a style change to see that no stale value was read from the cache.*/
+static void assert_same_as_uncached(lv_obj_t * obj)
+{
+    lv_style_value_t cached[sizeof(props) / sizeof(props[0])];
+    uint32_t i;
+    for(i = 0; i < sizeof(props) / sizeof(props[0]); i++) {
+        cached[i] = lv_obj_get_style_prop(obj, LV_PART_MAIN, props[i]);
+    }
+
+    lv_obj_enable_style_cache(false);
+    for(i = 0; i < sizeof(props) / sizeof(props[0]); i++) {
+        lv_style_value_t v = lv_obj_get_style_prop(obj, LV_PART_MAIN, props[i]);
+        /*Only the bits of the type of the property are defined*/
+        if(props[i] == LV_STYLE_BG_COLOR || props[i] == LV_STYLE_TEXT_COLOR) {
+            TEST_ASSERT_EQUAL_HEX32(v.color.full, cached[i].color.full);
+        }
+        else {
+            TEST_ASSERT_EQUAL_HEX32(v.num, cached[i].num);
+        }
+    }
+    lv_obj_enable_style_cache(true);
+}
+
+/*Fill the cache, so the next reads would be stale if the cache wasn't invalidated*/
+static void warm_up(lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(props) / sizeof(props[0]); i++) {
+        lv_obj_get_style_prop(obj, LV_PART_MAIN, props[i]);
+    }
+}
+
+static void render_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void test_style_cache_hit(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    init_styles();
+    lv_obj_t * obj = create_obj();
+    lv_obj_reset_style_cache_stats();
+
+    lv_color_t c = lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_BLUE), c);
+
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+
+    c = lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_BLUE), c);
+
+    /*Not set properties are cached too*/
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.obj_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.mem_used);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_state_change(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    init_styles();
+    lv_obj_t * obj = create_obj();
+    warm_up(obj);
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    /*The values of both states are cached*/
+    warm_up(obj);
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    warm_up(obj);
+    lv_obj_style_cache_stats_t stats;
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    lv_obj_reset_style_cache_stats();
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    lv_obj_reset_style_cache_stats();
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_invalidate(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    init_styles();
+    lv_obj_t * obj = create_obj();
+
+    /*Local style*/
+    warm_up(obj);
+    lv_obj_set_style_radius(obj, 20, 0);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    warm_up(obj);
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_RADIUS, 0);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    /*Modified shared style*/
+    warm_up(obj);
+    lv_style_set_pad_top(&style_base, 12);
+    lv_obj_report_style_change(&style_base);
+    TEST_ASSERT_EQUAL(12, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    /*Reported while refreshing is disabled*/
+    warm_up(obj);
+    lv_obj_enable_style_refresh(false);
+    lv_style_set_pad_top(&style_base, 14);
+    lv_obj_report_style_change(&style_base);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL(14, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    /*Added and removed styles*/
+    warm_up(obj);
+    lv_obj_remove_style(obj, &style_base, 0);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+
+    warm_up(obj);
+    lv_obj_add_style(obj, &style_base, 0);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_inherit(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    init_styles();
+    lv_obj_t * parent = create_obj();
+    lv_obj_t * obj = create_obj();
+    lv_obj_set_parent(obj, parent);
+
+    /*The inherited value follows the parent even if only the parent's style is changed*/
+    lv_obj_set_style_text_color(parent, lv_palette_main(LV_PALETTE_GREEN), 0);
+    warm_up(obj);
+    lv_obj_set_style_text_color(parent, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_ORANGE), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+    assert_same_as_uncached(obj);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_transition(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    static const lv_style_prop_t trans_props[] = {LV_STYLE_BG_COLOR, LV_STYLE_BORDER_WIDTH, 0};
+    static lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, trans_props, lv_anim_path_linear, 100, 0, NULL);
+
+    init_styles();
+    lv_style_set_transition(&style_pr, &trans);
+    lv_obj_t * obj = create_obj();
+
+    /*Compare with the styles in every step of the transition*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    uint32_t i;
+    for(i = 0; i < 15; i++) {
+        warm_up(obj);
+        lv_tick_inc(10);
+        lv_timer_handler();
+        assert_same_as_uncached(obj);
+    }
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Interrupted transition*/
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    warm_up(obj);
+    lv_tick_inc(30);
+    lv_timer_handler();
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    assert_same_as_uncached(obj);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_mem_limit(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    init_styles();
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_get_style_cache_stats(&stats);
+    uint32_t obj_cnt_ori = stats.obj_cnt;
+
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_obj_t * obj = create_obj();
+        lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    }
+
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(obj_cnt_ori, stats.obj_cnt);
+#if LV_OBJ_STYLE_CACHE_MEM_MAX
+    TEST_ASSERT_LESS_OR_EQUAL(LV_OBJ_STYLE_CACHE_MEM_MAX, stats.mem_used);
+#endif
+
+    /*The objects without cache work too*/
+    lv_obj_t * obj = lv_obj_get_child(lv_scr_act(), -1);
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Freed with the objects*/
+    lv_obj_clean(lv_scr_act());
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(obj_cnt_ori, stats.obj_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_style_cache_same_screen(void)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    /*With parallel rendering the render threads use the caches at the same time*/
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_set_size(btn, 200, 300);
+    lv_obj_set_style_shadow_width(btn, 30, 0);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Style cache\nStyle cache\nStyle cache\nStyle cache");
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+
+    lv_obj_enable_style_cache(false);
+    render_screen();
+    lv_memcpy(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_obj_enable_style_cache(true);
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    /*Now from the cache*/
+    lv_obj_reset_style_cache_stats();
+    render_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, SCREEN_PX * sizeof(lv_color_t));
+
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_get_style_cache_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats.miss_cnt, stats.hit_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,189 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*Logical size of the test screen. Higher than wide to rotate a square and more chunks too.
+ *High enough to need at least 2 chunks with 1 byte pixels too, so both ping-pong buffers are used.*/
+#define ROT_W   48
+#define ROT_H   160
+
+/*Rows of a chunk: one ping-pong buffer is half of `LV_DISP_ROT_MAX_BUF`*/
+#define ROT_CHUNK_ROWS  LV_MIN((LV_DISP_ROT_MAX_BUF / 2 / sizeof(lv_color_t)) / ROT_W, ROT_H)
+
+/*Flushes of a 90 or 270 degree rotated screen: the square in place and the rest in chunks*/
+#define ROT_FLUSH_CNT   (1 + (ROT_H - ROT_W + ROT_CHUNK_ROWS - 1) / ROT_CHUNK_ROWS)
+
+typedef struct {
+    lv_area_t area;
+    lv_color_t * color_p;
+} pending_flush_t;
+
+static lv_color_t draw_buf_px[ROT_W * ROT_H];
+static lv_color_t phys_fb[ROT_W * ROT_H];
+static lv_color_t ref_fb[ROT_W * ROT_H];
+
+static pending_flush_t pending[8];
+static uint32_t pending_cnt;
+static uint32_t flush_cnt;
+
+static lv_disp_drv_t rot_drv;
+static lv_disp_draw_buf_t rot_draw_buf;
+static lv_disp_t * rot_disp;
+static lv_disp_t * default_disp;
+
+/*Copy the pixels only when the flush is ready to see if a buffer was modified while being flushed*/
+static void complete_oldest(void)
+{
+    pending_flush_t * p = &pending[0];
+    lv_coord_t w = lv_area_get_width(&p->area);
+    lv_coord_t y;
+    for(y = p->area.y1; y <= p->area.y2; y++) {
+        lv_memcpy(&phys_fb[y * rot_drv.hor_res + p->area.x1], &p->color_p[(y - p->area.y1) * w],
+                  w * sizeof(lv_color_t));
+    }
+
+    lv_disp_flush_ready_buf(&rot_drv, p->color_p);
+
+    uint32_t i;
+    for(i = 0; i + 1 < pending_cnt; i++) pending[i] = pending[i + 1];
+    pending_cnt--;
+}
+
+static void rot_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(drv);
+    TEST_ASSERT_LESS_THAN(8, pending_cnt);
+    pending[pending_cnt].area = *area;
+    pending[pending_cnt].color_p = color_p;
+    pending_cnt++;
+    flush_cnt++;
+}
+
+static void rot_wait_cb(lv_disp_drv_t * drv)
+{
+    LV_UNUSED(drv);
+    if(pending_cnt) complete_oldest();
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x204060), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0xc0e000), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_HOR, 0);
+
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 30, 50);
+    lv_obj_set_pos(obj, 4, 30);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x0000ff), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+}
+
+static void render_rotated(lv_disp_rot_t rot)
+{
+    bool swap = rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270;
+
+    lv_disp_draw_buf_init(&rot_draw_buf, draw_buf_px, NULL, ROT_W * ROT_H);
+    lv_disp_drv_init(&rot_drv);
+    rot_drv.draw_buf = &rot_draw_buf;
+    rot_drv.flush_cb = rot_flush_cb;
+    rot_drv.wait_cb = rot_wait_cb;
+    rot_drv.hor_res = swap ? ROT_H : ROT_W;
+    rot_drv.ver_res = swap ? ROT_W : ROT_H;
+    rot_drv.sw_rotate = 1;
+    rot_drv.rotated = rot;
+    rot_disp = lv_disp_drv_register(&rot_drv);
+    lv_disp_set_default(rot_disp);
+
+    create_ui();
+
+    pending_cnt = 0;
+    flush_cnt = 0;
+    lv_memset_00(phys_fb, sizeof(phys_fb));
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(rot_disp);
+    while(pending_cnt) complete_oldest();
+}
+
+/*Rotate the reference image as the display would show it*/
+static lv_color_t ref_px_at_phys(lv_disp_rot_t rot, lv_coord_t px, lv_coord_t py)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    switch(rot) {
+        case LV_DISP_ROT_90:
+            x = ROT_W - 1 - py;
+            y = px;
+            break;
+        case LV_DISP_ROT_180:
+            x = ROT_W - 1 - px;
+            y = ROT_H - 1 - py;
+            break;
+        case LV_DISP_ROT_270:
+            x = py;
+            y = ROT_H - 1 - px;
+            break;
+        default:
+            x = px;
+            y = py;
+            break;
+    }
+    return ref_fb[y * ROT_W + x];
+}
+
+static void test_rotation(lv_disp_rot_t rot)
+{
+    render_rotated(LV_DISP_ROT_NONE);
+    lv_memcpy(ref_fb, phys_fb, sizeof(ref_fb));
+    lv_disp_remove(rot_disp);
+
+    render_rotated(rot);
+
+    lv_coord_t px;
+    lv_coord_t py;
+    for(py = 0; py < rot_drv.ver_res; py++) {
+        for(px = 0; px < rot_drv.hor_res; px++) {
+            lv_color_t ref = ref_px_at_phys(rot, px, py);
+            TEST_ASSERT_EQUAL_HEX32(lv_color_to32(ref), lv_color_to32(phys_fb[py * rot_drv.hor_res + px]));
+        }
+    }
+}
+
+void setUp(void)
+{
+    default_disp = lv_disp_get_default();
+}
+
+void tearDown(void)
+{
+    lv_disp_remove(rot_disp);
+    lv_disp_set_default(default_disp);
+}
+
+void test_sw_rotate_90(void)
+{
+    test_rotation(LV_DISP_ROT_90);
+
+    /*A square and at least two chunks in the ping-pong buffers*/
+    TEST_ASSERT_GREATER_OR_EQUAL(3, ROT_FLUSH_CNT);
+    TEST_ASSERT_EQUAL(ROT_FLUSH_CNT, flush_cnt);
+
+    /*The ping-pong buffers are freed after the refresh*/
+    TEST_ASSERT_NULL(rot_drv.draw_buf->rot_buf[0]);
+    TEST_ASSERT_NULL(rot_drv.draw_buf->rot_buf[1]);
+}
+
+void test_sw_rotate_180(void)
+{
+    test_rotation(LV_DISP_ROT_180);
+}
+
+void test_sw_rotate_270(void)
+{
+    test_rotation(LV_DISP_ROT_270);
+    TEST_ASSERT_EQUAL(ROT_FLUSH_CNT, flush_cnt);
+}
+
+#endif
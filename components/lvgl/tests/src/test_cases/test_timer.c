@@ -0,0 +1,287 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define MAX_LOG 64
+
+/*The timers of LVGL (display refresh, input devices, animations) are paused during the tests*/
+static lv_timer_t * paused_timers[16];
+static uint32_t paused_cnt;
+
+static lv_timer_t * log_timers[MAX_LOG];
+static uint32_t log_cnt;
+
+static lv_timer_t * to_delete;
+static lv_timer_t * created;
+static uint32_t wakeup_cnt;
+
+void setUp(void)
+{
+    paused_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(!t->paused && paused_cnt < 16) {
+            lv_timer_pause(t);
+            paused_timers[paused_cnt++] = t;
+        }
+        t = lv_timer_get_next(t);
+    }
+
+    log_cnt = 0;
+    to_delete = NULL;
+    created = NULL;
+    wakeup_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_timer_set_wakeup_cb(NULL, NULL);
+
+    uint32_t i;
+    for(i = 0; i < paused_cnt; i++) lv_timer_resume(paused_timers[i]);
+}
+
+static void log_cb(lv_timer_t * t)
+{
+    if(log_cnt < MAX_LOG) log_timers[log_cnt] = t;
+    log_cnt++;
+}
+
+static void del_cb(lv_timer_t * t)
+{
+    log_cb(t);
+    lv_timer_del(to_delete);
+}
+
+static void create_cb(lv_timer_t * t)
+{
+    log_cb(t);
+    created = lv_timer_create(log_cb, 10, NULL);
+}
+
+static void wakeup_cb(void * user_data)
+{
+    TEST_ASSERT_EQUAL_PTR(&wakeup_cnt, user_data);
+    wakeup_cnt++;
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+static uint32_t timer_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        cnt++;
+        t = lv_timer_get_next(t);
+    }
+    return cnt;
+}
+
+void test_timer_run_in_deadline_order(void)
+{
+    lv_timer_t * t1 = lv_timer_create(log_cb, 30, NULL);
+    lv_timer_t * t2 = lv_timer_create(log_cb, 10, NULL);
+    lv_timer_t * t3 = lv_timer_create(log_cb, 20, NULL);
+
+    TEST_ASSERT_EQUAL(10, lv_timer_get_time_till_next());
+    lv_tick_inc(9);
+    TEST_ASSERT_EQUAL(1, lv_timer_handler());
+    TEST_ASSERT_EQUAL(0, log_cnt);
+
+    lv_tick_inc(21);
+    TEST_ASSERT_EQUAL(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL(3, log_cnt);
+    TEST_ASSERT_EQUAL_PTR(t2, log_timers[0]);
+    TEST_ASSERT_EQUAL_PTR(t3, log_timers[1]);
+    TEST_ASSERT_EQUAL_PTR(t1, log_timers[2]);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    lv_timer_del(t3);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+}
+
+void test_timer_period_0_runs_once_per_call(void)
+{
+    lv_timer_t * t = lv_timer_create(log_cb, 0, NULL);
+
+    TEST_ASSERT_EQUAL(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL(1, log_cnt);
+    TEST_ASSERT_EQUAL(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL(2, log_cnt);
+
+    lv_timer_del(t);
+}
+
+void test_timer_change_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(del_cb, 10, NULL);
+    lv_timer_t * t2 = lv_timer_create(log_cb, 10, NULL);
+    lv_timer_t * t3 = lv_timer_create(create_cb, 10, NULL);
+
+    /*`t1` deletes `t2` before it runs, `t3` creates a new timer*/
+    lv_timer_set_period(t1, 5);
+    to_delete = t2;
+    uint32_t cnt = timer_cnt();
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, log_cnt);
+    TEST_ASSERT_EQUAL_PTR(t1, log_timers[0]);
+    TEST_ASSERT_EQUAL_PTR(t3, log_timers[1]);
+    TEST_ASSERT_NOT_NULL(created);
+    TEST_ASSERT_EQUAL(cnt, timer_cnt());
+
+    /*Deletes itself*/
+    to_delete = t1;
+    lv_timer_pause(t3);
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, log_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t1));
+
+    /*The new timer runs after its period*/
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, log_cnt);
+    TEST_ASSERT_EQUAL_PTR(created, log_timers[3]);
+
+    lv_timer_del(created);
+    lv_timer_del(t3);
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * t1 = lv_timer_create(log_cb, 10, NULL);
+    lv_timer_set_repeat_count(t1, 2);
+    lv_timer_t * t2 = lv_timer_create(log_cb, 100, NULL);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL(2, log_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t1));
+
+    /*Stopped: deleted by the next call without running*/
+    lv_timer_set_repeat_count(t2, 0);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, log_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t2));
+}
+
+void test_timer_pause_ready_reset(void)
+{
+    lv_timer_t * t = lv_timer_create(log_cb, 50, NULL);
+
+    lv_timer_pause(t);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, log_cnt);
+
+    /*Its period has elapsed while paused*/
+    lv_timer_resume(t);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+    TEST_ASSERT_EQUAL(50, lv_timer_handler());
+    TEST_ASSERT_EQUAL(1, log_cnt);
+
+    lv_tick_inc(20);
+    lv_timer_reset(t);
+    TEST_ASSERT_EQUAL(50, lv_timer_get_time_till_next());
+    lv_timer_ready(t);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, log_cnt);
+
+    lv_timer_set_period(t, 10);
+    TEST_ASSERT_EQUAL(10, lv_timer_get_time_till_next());
+
+    lv_timer_del(t);
+}
+
+void test_timer_wakeup_cb(void)
+{
+    lv_timer_set_wakeup_cb(wakeup_cb, &wakeup_cnt);
+
+    lv_timer_t * t1 = lv_timer_create(log_cb, 50, NULL);
+    TEST_ASSERT_EQUAL(1, wakeup_cnt);
+
+    /*Not the first timer: the handler doesn't need to run earlier*/
+    lv_timer_t * t2 = lv_timer_create(log_cb, 100, NULL);
+    TEST_ASSERT_EQUAL(1, wakeup_cnt);
+
+    lv_timer_ready(t2);
+    TEST_ASSERT_EQUAL(2, wakeup_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, log_cnt);
+
+    /*Not called in the handler*/
+    lv_timer_t * t3 = lv_timer_create(create_cb, 0, NULL);
+    TEST_ASSERT_EQUAL(3, wakeup_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, wakeup_cnt);
+
+    /*Invalidation resumes the refresh timer of the display*/
+    lv_timer_t * refr_timer = _lv_disp_get_refr_timer(lv_disp_get_default());
+    lv_timer_pause(refr_timer);
+    lv_obj_invalidate(lv_scr_act());
+    TEST_ASSERT_EQUAL(4, wakeup_cnt);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, wakeup_cnt);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    lv_timer_del(t3);
+    lv_timer_del(created);
+}
+
+/*Many timers with different periods: all of them run as many times as their period allows*/
+void test_timer_many(void)
+{
+    static lv_timer_t * timers[300];
+    static uint32_t periods[300];
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        periods[i] = (i * 37) % 200 + 1;
+        timers[i] = lv_timer_create(log_cb, periods[i], &periods[i]);
+        TEST_ASSERT_NOT_NULL(timers[i]);
+    }
+
+    uint32_t run_cnt = 0;
+    uint32_t t;
+    for(t = 0; t < 1000; t++) {
+        lv_tick_inc(1);
+        log_cnt = 0;
+        uint32_t next = lv_timer_handler();
+        run_cnt += log_cnt;
+
+        /*In the order of the periods as all were created at the same time*/
+        for(i = 1; i < LV_MIN(log_cnt, MAX_LOG); i++) {
+            uint32_t * p1 = log_timers[i - 1]->user_data;
+            uint32_t * p2 = log_timers[i]->user_data;
+            TEST_ASSERT_TRUE(t % *p1 == *p1 - 1 || *p1 <= *p2);
+        }
+        TEST_ASSERT_GREATER_THAN(0, next);
+    }
+
+    uint32_t exp_cnt = 0;
+    for(i = 0; i < 300; i++) {
+        exp_cnt += 1000 / periods[i];
+        lv_timer_del(timers[i]);
+    }
+    TEST_ASSERT_EQUAL(exp_cnt, run_cnt);
+}
+
+#endif
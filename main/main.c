@@ -86,12 +86,14 @@ const char *WIFI_TAG = "WIFI_TAG";
 /*********************
  *      DEFINES
  *********************/
+#define LV_TICK_PERIOD_MS 1
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_tick_task(void *arg);
 static void guiTask(void *pvParameter);
+static void gui_wakeup_cb(void *user_data);
 static void create_demo_application(void);
 
 static void wifi_config(void);
@@ -128,6 +130,8 @@ SemaphoreHandle_t xGuiSemaphore;
 
 //static TaskHandle_t lv_RefreshCity_queue = NULL;
 
+static TaskHandle_t gui_task;
+
 static void guiTask(void *pvParameter) {
 
     (void) pvParameter;
@@ -141,7 +145,9 @@ static void guiTask(void *pvParameter) {
     lv_color_t* buf1 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
     assert(buf1 != NULL);
 
-    /* Use double buffered when not working with monochrome displays */
+    /* Use double buffered when not working with monochrome displays.
+     * Not a ring of more buffers: the ST7789 driver waits for the previous transfer in flush_cb,
+     * so only one transfer can run at a time anyway. */
 #ifndef CONFIG_LV_TFT_DISPLAY_MONOCHROME
     lv_color_t* buf2 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
     assert(buf2 != NULL);
@@ -173,20 +179,32 @@ static void guiTask(void *pvParameter) {
     
     esp_timer_handle_t periodic_timer;
     ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, portTICK_PERIOD_MS));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, LV_TICK_PERIOD_MS * 1000));
+
+    /* Other tasks wake up the GUI task if they make a timer ready earlier,
+     * e.g. by invalidating an object or creating a timer */
+    gui_task = xTaskGetCurrentTaskHandle();
+    lv_timer_set_wakeup_cb(gui_wakeup_cb, NULL);
 
     /* Create the demo application */
 
     while (1) {
         xEventGroupWaitBits(xCreatedEventGroup,Refresh_Screen_Flag,pdFALSE,pdFALSE,portMAX_DELAY);
-            /* Delay 1 tick (assumes FreeRTOS tick is 10ms */
-        vTaskDelay(pdMS_TO_TICKS(50));
 
         /* Try to take the semaphore, call lvgl related function on success */
+        uint32_t till_next = LV_NO_TIMER_READY;
         if (pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY)) {
-            lv_task_handler();
+            till_next = lv_task_handler();
             xSemaphoreGive(xGuiSemaphore);
-       }
+        }
+
+        /* Sleep until the next timer is ready or a wake up. Sleep at least 1 tick to let the other tasks run */
+        TickType_t ticks = portMAX_DELAY;
+        if (till_next != LV_NO_TIMER_READY) {
+            ticks = (till_next + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+            if (ticks == 0) ticks = 1;
+        }
+        ulTaskNotifyTake(pdTRUE, ticks);
     }
 
     /* A task should NEVER return */
@@ -740,6 +758,12 @@ static void create_demo_application(void)
 
 static void lv_tick_task(void *arg) {
     (void) arg;
-    lv_tick_inc(1);
+    lv_tick_inc(LV_TICK_PERIOD_MS);
+
+}
 
+/* Called by LVGL in the task which made a timer ready before the GUI task would wake up */
+static void gui_wakeup_cb(void *user_data) {
+    (void) user_data;
+    xTaskNotifyGive(gui_task);
 }